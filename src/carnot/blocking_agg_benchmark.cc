@@ -26,12 +26,14 @@
 #include <sole.hpp>
 
 #include "src/carnot/carnot.h"
+#include "src/carnot/exec/agg_node.h"
 #include "src/carnot/exec/local_grpc_result_server.h"
 #include "src/carnot/exec/test_utils.h"
 #include "src/carnot/funcs/funcs.h"
 #include "src/carnot/udf/udf.h"
 #include "src/common/base/base.h"
 #include "src/common/benchmark/benchmark.h"
+#include "src/common/testing/test_environment.h"
 #include "src/datagen/datagen.h"
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/column_wrapper.h"
@@ -130,6 +132,25 @@ void BM_Query_Int(benchmark::State& state, std::vector<types::DataType> types,
   BM_Query(state, types, distribution_types, query, num_batches, default_params, default_params);
 }
 
+// Runs the benchmark on the RowTuple hash map group by, to compare against the columnar one.
+// NOLINTNEXTLINE : runtime/references.
+void BM_Query_String_RowTuple(benchmark::State& state, std::vector<types::DataType> types,
+                              std::vector<datagen::DistributionType> distribution_types,
+                              const std::string& query, int64_t num_batches,
+                              const datagen::DistributionParams* dist_vars,
+                              const datagen::DistributionParams* len_vars) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_columnar_group_by, false);
+  BM_Query(state, types, distribution_types, query, num_batches, dist_vars, len_vars);
+}
+
+// NOLINTNEXTLINE : runtime/references.
+void BM_Query_Int_RowTuple(benchmark::State& state, std::vector<types::DataType> types,
+                           std::vector<datagen::DistributionType> distribution_types,
+                           const std::string& query, int64_t num_batches) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_columnar_group_by, false);
+  BM_Query_Int(state, types, distribution_types, query, num_batches);
+}
+
 const std::unique_ptr<const datagen::DistributionParams> sample_selection_params =
     std::make_unique<const datagen::ZipfianParams>(2, 2, 999);
 const std::unique_ptr<const datagen::DistributionParams> sample_length_params =
@@ -198,6 +219,29 @@ BENCHMARK_CAPTURE(BM_Query_Int, eval_group_by_one_exponential_int,
     ->RangeMultiplier(2)
     ->Range(1, 1 << 16);
 
+// Same group by queries on the RowTuple hash map. The two int key group by has no columnar
+// specialization, so it runs on the RowTuple path in either case.
+BENCHMARK_CAPTURE(BM_Query_String_RowTuple, eval_group_by_one_uniform_string_row_tuple,
+                  {types::DataType::STRING, types::DataType::INT64},
+                  {datagen::DistributionType::kZipfian, datagen::DistributionType::kUniform},
+                  kGroupByOneQuery, 20, sample_selection_params.get(), sample_length_params.get())
+    ->RangeMultiplier(2)
+    ->Range(1, 1 << 16);
+
+BENCHMARK_CAPTURE(BM_Query_Int_RowTuple, eval_group_by_one_uniform_int_row_tuple,
+                  {types::DataType::INT64, types::DataType::INT64},
+                  {datagen::DistributionType::kUniform, datagen::DistributionType::kUniform},
+                  kGroupByOneQuery, 20)
+    ->RangeMultiplier(2)
+    ->Range(1, 1 << 16);
+
+BENCHMARK_CAPTURE(BM_Query_Int_RowTuple, eval_group_by_one_exponential_int_row_tuple,
+                  {types::DataType::INT64, types::DataType::INT64},
+                  {datagen::DistributionType::kExponential, datagen::DistributionType::kUniform},
+                  kGroupByOneQuery, 20)
+    ->RangeMultiplier(2)
+    ->Range(1, 1 << 16);
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -26,6 +26,7 @@
 #include "src/carnot/exec/exec_graph.h"
 #include "src/carnot/exec/grpc_router.h"
 #include "src/carnot/funcs/builtins/builtins.h"
+#include "src/carnot/plan_cache.h"
 #include "src/carnot/plan/operators.h"
 #include "src/carnot/plan/plan.h"
 #include "src/carnot/planner/compiler/compiler.h"
@@ -69,6 +70,12 @@ class CarnotImpl final : public Carnot {
   EngineState* GetEngineState() override { return engine_state_.get(); }
 
  private:
+  // Compiles the query into the plan that is executed, without looking it up in the cache.
+  // cacheable is set to whether the plan can be run at another time than time_now, see PlanCache.
+  StatusOr<std::shared_ptr<const planpb::Plan>> CompileQuery(const std::string& query,
+                                                             types::Time64NSValue time_now,
+                                                             bool* cacheable = nullptr);
+
   Status RegisterUDFs(exec::ExecState* exec_state, plan::Plan* plan);
 
   Status RegisterUDFsInPlanFragment(exec::ExecState* exec_state, plan::PlanFragment* pf);
@@ -92,6 +99,7 @@ class CarnotImpl final : public Carnot {
   AgentMetadataCallbackFunc agent_md_callback_;
   planner::compiler::Compiler compiler_;
   std::unique_ptr<EngineState> engine_state_;
+  PlanCache plan_cache_{FLAGS_carnot_plan_cache_size};
 
   std::unique_ptr<std::thread> grpc_server_thread_;
   std::unique_ptr<grpc::Server> grpc_server_;
@@ -121,9 +129,8 @@ Status CarnotImpl::Init(const sole::uuid& agent_id, std::unique_ptr<udf::Registr
   return Status::OK();
 }
 
-Status CarnotImpl::ExecuteQuery(const std::string& query, const sole::uuid& query_id,
-                                types::Time64NSValue time_now, bool analyze) {
-  // Compile the query.
+StatusOr<std::shared_ptr<const planpb::Plan>> CarnotImpl::CompileQuery(
+    const std::string& query, types::Time64NSValue time_now, bool* cacheable) {
   auto compiler_state = engine_state_->CreateLocalExecutionCompilerState(time_now);
   PX_ASSIGN_OR_RETURN(auto logical_plan, compiler_.CompileToIR(query, compiler_state.get()));
   // TOOD(james/nserrino/philkuz): This is a hack to make sure that the distributed rule for limits
@@ -135,7 +142,41 @@ Status CarnotImpl::ExecuteQuery(const std::string& query, const sole::uuid& quer
   auto dest = plan_proto.add_execution_status_destinations();
   dest->set_grpc_address(compiler_state->result_address());
   dest->set_ssl_targetname(compiler_state->result_ssl_targetname());
-  return ExecutePlan(plan_proto, query_id, analyze);
+  if (cacheable != nullptr) {
+    *cacheable = !compiler_state->time_now_in_plan();
+  }
+  return std::make_shared<const planpb::Plan>(std::move(plan_proto));
+}
+
+Status CarnotImpl::ExecuteQuery(const std::string& query, const sole::uuid& query_id,
+                                types::Time64NSValue time_now, bool analyze) {
+  if (!plan_cache_.enabled()) {
+    PX_ASSIGN_OR_RETURN(auto plan, CompileQuery(query, time_now));
+    return ExecutePlan(*plan, query_id, analyze);
+  }
+
+  // The plan depends on the schemas of the tables, so a table that is added or changed makes the
+  // cached plans miss.
+  auto relation_map = table_store()->GetRelationMap();
+  std::string key = plan_cache_.Key(query, *relation_map);
+  auto plan = plan_cache_.Get(key, time_now.val);
+  ExecMetrics* metrics = engine_state_->metrics();
+  if (plan != nullptr) {
+    metrics->plan_cache_hits_counter.Increment();
+    return ExecutePlan(*plan, query_id, analyze);
+  }
+  metrics->plan_cache_misses_counter.Increment();
+
+  auto timer = ElapsedTimer();
+  timer.Start();
+  bool cacheable = false;
+  PX_ASSIGN_OR_RETURN(plan, CompileQuery(query, time_now, &cacheable));
+  timer.Stop();
+  metrics->query_compile_time_seconds.Observe(timer.ElapsedTime_us() / 1e6);
+  if (cacheable) {
+    plan_cache_.Put(key, plan, time_now.val);
+  }
+  return ExecutePlan(*plan, query_id, analyze);
 }
 
 /**
@@ -172,6 +213,7 @@ Status CarnotImpl::RegisterUDFsInPlanFragment(exec::ExecState* exec_state, plan:
         return WalkExpression(exec_state, *filter.expression());
       })
       .OnLimit(no_op)
+      .OnSort(no_op)
       .OnMemorySink(no_op)
       .OnMemorySource(no_op)
       .OnUnion(no_op)
@@ -193,6 +193,59 @@ px.display(df, 'test_output'))pxl";
       types::ToArrow(col1_in2, arrow::default_memory_pool())));
 }
 
+TEST_F(CarnotTest, cached_plan) {
+  auto query = R"pxl(
+import px
+df = px.DataFrame(table='test_table', select=['col1', 'col2'])
+df.res = df.col1 + df.col2
+px.display(df[['res']], 'test_output'))pxl";
+  ASSERT_OK(carnot_->ExecuteQuery(query, sole::uuid4(), 0));
+  auto first_batches = result_server_->query_results("test_output");
+  ASSERT_EQ(3, first_batches.size());
+
+  // The same script, with different trailing whitespace, reuses the compiled plan and gets the
+  // same results.
+  result_server_->ResetQueryResults();
+  ASSERT_OK(carnot_->ExecuteQuery(absl::StrCat(query, "  \n"), sole::uuid4(), 0));
+  auto second_batches = result_server_->query_results("test_output");
+  ASSERT_EQ(first_batches.size(), second_batches.size());
+  for (size_t i = 0; i < first_batches.size(); ++i) {
+    EXPECT_EQ(first_batches[i].DebugString(), second_batches[i].DebugString());
+  }
+
+  // Queries that fail to compile aren't cached, so they compile once the table they read exists.
+  auto late_query = R"pxl(
+import px
+px.display(px.DataFrame(table='late_table'), 'late_output'))pxl";
+  EXPECT_NOT_OK(carnot_->ExecuteQuery(late_query, sole::uuid4(), 0));
+  table_store_->AddTable("late_table", CarnotTestUtils::TestTable());
+  ASSERT_OK(carnot_->ExecuteQuery(late_query, sole::uuid4(), 0));
+  EXPECT_THAT(result_server_->output_tables(), UnorderedElementsAre("test_output", "late_output"));
+}
+
+TEST_F(CarnotTest, cached_plan_binds_relative_times) {
+  auto query = R"pxl(
+import px
+df = px.DataFrame(table='big_test_table', select=['time_'], start_time='-1ms')
+px.display(df, 'range_output'))pxl";
+  auto num_output_rows = [this]() {
+    int64_t num_rows = 0;
+    for (const auto& rb : result_server_->query_results("range_output")) {
+      num_rows += rb.num_rows();
+    }
+    result_server_->ResetQueryResults();
+    return num_rows;
+  };
+  int64_t one_ms = 1000 * 1000;
+
+  // The start time is 2.
+  ASSERT_OK(carnot_->ExecuteQuery(query, sole::uuid4(), one_ms + 2));
+  EXPECT_EQ(7, num_output_rows());
+  // The cached plan is run with a start time of 6, rather than the one it was compiled with.
+  ASSERT_OK(carnot_->ExecuteQuery(query, sole::uuid4(), one_ms + 6));
+  EXPECT_EQ(4, num_output_rows());
+}
+
 TEST_F(CarnotTest, range_test_multiple_rbs) {
   auto query = R"pxl(
 import px
@@ -138,6 +138,7 @@ class EngineState : public NotCopyable {
   }
 
   udf::ModelPool* model_pool() const { return model_pool_.get(); }
+  ExecMetrics* metrics() const { return metrics_.get(); }
 
  private:
   std::unique_ptr<udf::Registry> func_registry_;
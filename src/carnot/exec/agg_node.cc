@@ -35,12 +35,19 @@
 #include "src/shared/types/type_utils.h"
 #include "src/shared/types/types.h"
 
+DEFINE_bool(carnot_columnar_group_by, gflags::BoolFromEnv("PL_CARNOT_COLUMNAR_GROUP_BY", true),
+            "Whether group by aggregates use the columnar group index for the key types it "
+            "supports, rather than a hash map of row tuples.");
+
 namespace px {
 namespace carnot {
 namespace exec {
 
 using SharedArray = std::shared_ptr<arrow::Array>;
 constexpr int64_t kAggCompactionThreshold = 512;
+// The states of the UDAs aren't visible to the node, so the memory of every group is estimated
+// with a fixed size per value on top of its key.
+constexpr int64_t kEstimatedUDABytes = 64;
 
 using table_store::schema::RowBatch;
 using table_store::schema::RowDescriptor;
@@ -78,6 +85,11 @@ void ExtractToColumnWrapper(const std::vector<GroupArgs>& group_args,
   }
 }
 
+// The partition of a group for the partitioned merge. It's picked by the high bits of the hash of
+// the key, since the low bits pick its slot in the hash table of the partition.
+size_t PartitionOfHash(uint64_t hash, size_t num_partitions) {
+  return (hash >> 32) % num_partitions;
+}
 }  // namespace
 
 std::string AggNode::DebugStringImpl() {
@@ -122,16 +134,25 @@ Status AggNode::InitImpl(const plan::Operator& plan_node) {
   // The case of GroupByNone, there will be no groups.
   auto groups_size = plan_node_->groups().size();
   group_data_types_.reserve(groups_size);
-  for (const auto& group : plan_node_->groups()) {
+  for (const auto& [i, group] : Enumerate(plan_node_->groups())) {
     DCHECK(group.idx < input_descriptor_->size());
+    group_cols_.emplace_back(group.idx);
     group_data_types_.emplace_back(input_descriptor_->type(group.idx));
+    serialized_group_cols_.emplace_back(i);
   }
 
+  std::vector<types::DataType> serialized_data_types = group_data_types_;
   auto values_size = plan_node_->values().size();
   for (size_t i = 0; i < values_size; ++i) {
     auto values_idx = i + groups_size;
     DCHECK(values_idx < output_descriptor_->size());
     value_data_types_.emplace_back(output_descriptor_->type(values_idx));
+    serialized_data_types.emplace_back(types::STRING);
+  }
+  serialized_descriptor_ = std::make_unique<RowDescriptor>(serialized_data_types);
+
+  if (FLAGS_carnot_columnar_group_by) {
+    group_index_ = GroupIndex::Create(group_data_types_);
   }
 
   return CreateColumnMapping();
@@ -146,25 +167,44 @@ Status AggNode::OpenImpl(ExecState* exec_state) {
   if (HasNoGroups()) {
     PX_RETURN_IF_ERROR(CreateUDAInfoValues(&udas_no_groups_, exec_state));
   }
-  if (!plan_node_->partial_agg()) {
+  if (!plan_node_->partial_agg() || CanSpill(exec_state)) {
     PX_RETURN_IF_ERROR(CreateUDAInfoValues(&udas_for_deserialize_, exec_state));
   }
   return Status::OK();
 }
 
+bool AggNode::HandlesSelection() const {
+  // Partial aggregates without groups and columnar group bys update the selected rows in place,
+  // the other paths read the batch row by row and get a materialized copy.
+  return group_index_ != nullptr || (HasNoGroups() && plan_node_->partial_agg());
+}
+
 Status AggNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
   if (HasNoGroups()) {
     return AggregateGroupByNone(exec_state, rb);
   }
+  if (group_index_ != nullptr) {
+    return AggregateGroupByColumnar(exec_state, rb);
+  }
   return AggregateGroupByClause(exec_state, rb);
 }
 
-Status AggNode::CloseImpl(ExecState*) {
+Status AggNode::CloseImpl(ExecState* exec_state) {
   udas_no_groups_.clear();
   group_args_chunk_.clear();
   group_args_pool_.Clear();
   udas_pool_.Clear();
-
+  if (group_index_ != nullptr) {
+    group_index_->Clear();
+  }
+  group_udas_.clear();
+  group_partitions_.clear();
+  partition_outputs_.clear();
+
+  spill_partitions_.reset();
+  pending_spilled_output_.reset();
+  exec_state->spill_manager()->Release(reserved_bytes_);
+  reserved_bytes_ = 0;
   return Status::OK();
 }
 
@@ -177,7 +217,24 @@ Status AggNode::ClearAggState(ExecState* exec_state) {
     udas_no_groups_.clear();
     PX_RETURN_IF_ERROR(CreateUDAInfoValues(&udas_no_groups_, exec_state));
   }
-  agg_hash_map_.clear();
+  if (!agg_hash_map_.empty()) {
+    agg_hash_map_.clear();
+    // The pools hold the keys and values of the groups, and the row tuples of group_args_chunk_,
+    // which is grown again by the next batch.
+    group_args_chunk_.clear();
+    group_args_pool_.Clear();
+    udas_pool_.Clear();
+  }
+  if (group_index_ != nullptr) {
+    group_index_->Clear();
+    group_udas_.clear();
+    batch_groups_.clear();
+    batch_group_counts_.clear();
+    batch_group_offsets_.clear();
+  }
+  group_partitions_.clear();
+  exec_state->spill_manager()->Release(reserved_bytes_);
+  reserved_bytes_ = 0;
   return Status::OK();
 }
 
@@ -219,7 +276,8 @@ Status AggNode::AggregateGroupByNone(ExecState* exec_state, const RowBatch& rb)
   return Status::OK();
 }
 
-Status AggNode::ExtractRowTupleForBatch(const RowBatch& rb) {
+Status AggNode::ExtractRowTupleForBatch(const RowBatch& rb,
+                                        const std::vector<int64_t>& group_cols) {
   // Grow the group_args_chunk_ to be the size of the RowBatch.
   size_t num_rows = rb.num_rows();
   if (group_args_chunk_.size() < num_rows) {
@@ -231,12 +289,10 @@ Status AggNode::ExtractRowTupleForBatch(const RowBatch& rb) {
   }
 
   // Scan through all the group args in column order and extract the entire column.
-  for (size_t idx = 0; idx < plan_node_->groups().size(); idx++) {
-    auto grp = plan_node_->groups()[idx];
-    DCHECK(grp.idx < input_descriptor_->size());
+  for (size_t idx = 0; idx < group_cols.size(); idx++) {
     DCHECK(idx < group_data_types_.size());
     auto dt = group_data_types_[idx];
-    auto col = rb.ColumnAt(grp.idx).get();
+    auto col = rb.ColumnAt(group_cols[idx]).get();
 
 #define TYPE_CASE(_dt_) ExtractIntoGroupArgs<_dt_>(&group_args_chunk_, col, idx);
     PX_SWITCH_FOREACH_DATATYPE(dt, TYPE_CASE);
@@ -245,11 +301,8 @@ Status AggNode::ExtractRowTupleForBatch(const RowBatch& rb) {
   return Status::OK();
 }
 
-Status AggNode::HashRowBatch(ExecState* exec_state, const RowBatch& rb) {
-  PX_UNUSED(exec_state);
-  // Loop through all the row and basically store the values into column chunk based on which
-  // group they belong to.
-  for (auto row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+void AggNode::FindOrInsertGroupArgs(ExecState* exec_state, int64_t num_rows) {
+  for (int64_t row_idx = 0; row_idx < num_rows; ++row_idx) {
     auto& ga = group_args_chunk_[row_idx];
     AggHashValue* val = nullptr;
     // Check to see if in hash
@@ -267,6 +320,12 @@ Status AggNode::HashRowBatch(ExecState* exec_state, const RowBatch& rb) {
     }
     ga.av = val;
   }
+}
+
+Status AggNode::HashRowBatch(ExecState* exec_state, const RowBatch& rb) {
+  // Loop through all the row and basically store the values into column chunk based on which
+  // group they belong to.
+  FindOrInsertGroupArgs(exec_state, rb.num_rows());
 
   // Now extract the values in the agg hash value.
   for (size_t i = 0; i < stored_cols_data_types_.size(); ++i) {
@@ -320,8 +379,8 @@ Status AggNode::ResetGroupArgs() {
   return Status::OK();
 }
 
-Status AggNode::ConvertAggHashMapToRowBatch(ExecState* exec_state, RowBatch* output_rb) {
-  PX_UNUSED(exec_state);
+Status AggNode::ConvertAggHashMapToRowBatch(ExecState* exec_state, bool finalize,
+                                            RowBatch* output_rb) {
   DCHECK(output_rb != nullptr);
   std::vector<std::unique_ptr<arrow::ArrayBuilder>> group_builders;
   for (const auto& group_dt : group_data_types_) {
@@ -329,7 +388,8 @@ Status AggNode::ConvertAggHashMapToRowBatch(ExecState* exec_state, RowBatch* out
   }
   std::vector<std::unique_ptr<arrow::ArrayBuilder>> value_builders;
   for (const auto& value_data_type : value_data_types_) {
-    value_builders.push_back(types::MakeArrowBuilder(value_data_type, exec_state->exec_mem_pool()));
+    value_builders.push_back(types::MakeArrowBuilder(finalize ? value_data_type : types::STRING,
+                                                     exec_state->exec_mem_pool()));
   }
 
   // Agg into agg values and emit!
@@ -348,7 +408,7 @@ Status AggNode::ConvertAggHashMapToRowBatch(ExecState* exec_state, RowBatch* out
       PX_RETURN_IF_ERROR(EvaluateAggHashValue(exec_state, val));
     }
 
-    if (plan_node_->finalize_results()) {
+    if (finalize) {
       // Actually Finalize the UDA based on the column wrapper chunks.
       for (size_t i = 0; i < val->udas.size(); ++i) {
         const auto& uda_info = val->udas[i];
@@ -388,23 +448,538 @@ Status AggNode::AggregateGroupByClause(ExecState* exec_state, const RowBatch& rb
   // 3. If the agg values are large then run aggregate and compact.
   // 4. Reset state to prepare for next row batch.
   // 5. If it's the last batch then emit the values.
-  PX_RETURN_IF_ERROR(ExtractRowTupleForBatch(rb));
+  PX_RETURN_IF_ERROR(ExtractRowTupleForBatch(rb, group_cols_));
   PX_RETURN_IF_ERROR(HashRowBatch(exec_state, rb));
   if (plan_node_->partial_agg() && plan_node_->values().size() > 0) {
     PX_RETURN_IF_ERROR(EvaluatePartialAggregates(exec_state, rb.num_rows()));
   }
   PX_RETURN_IF_ERROR(ResetGroupArgs());
   if (ReadyToEmitBatches(rb)) {
-    RowBatch output_rb(*output_descriptor_, agg_hash_map_.size());
-    PX_RETURN_IF_ERROR(ConvertAggHashMapToRowBatch(exec_state, &output_rb));
-    output_rb.set_eow(rb.eow());
-    output_rb.set_eos(rb.eos());
-    PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, output_rb));
+    return EmitGroups(exec_state, rb);
+  }
+  return ReserveOrSpillGroups(exec_state);
+}
+
+Status AggNode::AggregateGroupByColumnar(ExecState* exec_state, const RowBatch& rb) {
+  std::vector<const arrow::Array*> key_cols;
+  key_cols.reserve(group_cols_.size());
+  for (auto col_idx : group_cols_) {
+    key_cols.push_back(rb.ColumnAt(col_idx).get());
+  }
+  if (rb.has_selection()) {
+    group_index_->FindOrInsertSelected(key_cols, rb.selection(), &batch_group_ids_);
+  } else {
+    group_index_->FindOrInsertBatch(key_cols, rb.num_rows(), &batch_group_ids_);
+  }
+  // Create the UDAs of the groups that were first seen in this batch.
+  while (group_udas_.size() < group_index_->num_groups()) {
+    group_udas_.emplace_back();
+    PX_RETURN_IF_ERROR(CreateUDAInfoValues(&group_udas_.back(), exec_state));
+  }
+
+  if (plan_node_->partial_agg()) {
+    PX_RETURN_IF_ERROR(UpdateGroupsColumnar(exec_state, rb));
+  } else {
+    auto groups_size = static_cast<int64_t>(plan_node_->groups().size());
+    for (int64_t row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+      int64_t col_row_idx = rb.has_selection() ? rb.selection()[row_idx] : row_idx;
+      PX_RETURN_IF_ERROR(DeserializeAndMergeRow(&group_udas_[batch_group_ids_[row_idx]], rb,
+                                                col_row_idx, groups_size));
+    }
+  }
+
+  if (ReadyToEmitBatches(rb)) {
+    return EmitGroups(exec_state, rb);
+  }
+  return ReserveOrSpillGroups(exec_state);
+}
+
+void AggNode::ComputeBatchSelections(size_t num_rows, const uint32_t* rows) {
+  // Counting sort of the rows by group id: count the rows of each group, lay the groups out back
+  // to back and then scatter the rows into place.
+  for (auto group_id : batch_groups_) {
+    batch_group_counts_[group_id] = 0;
+  }
+  batch_groups_.clear();
+  batch_group_counts_.resize(group_index_->num_groups(), 0);
+  batch_group_offsets_.resize(group_index_->num_groups(), 0);
+
+  for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+    auto group_id = batch_group_ids_[row_idx];
+    if (batch_group_counts_[group_id]++ == 0) {
+      batch_groups_.push_back(group_id);
+    }
+  }
+  uint32_t offset = 0;
+  for (auto group_id : batch_groups_) {
+    batch_group_offsets_[group_id] = offset;
+    offset += batch_group_counts_[group_id];
+  }
+  batch_selection_.resize(num_rows);
+  for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+    batch_selection_[batch_group_offsets_[batch_group_ids_[row_idx]]++] =
+        rows == nullptr ? row_idx : rows[row_idx];
+  }
+  // The scatter moved every offset to the end of its group.
+  for (auto group_id : batch_groups_) {
+    batch_group_offsets_[group_id] -= batch_group_counts_[group_id];
+  }
+}
+
+Status AggNode::UpdateGroupsColumnar(ExecState* exec_state, const RowBatch& rb) {
+  ComputeBatchSelections(rb.num_rows(), rb.has_selection() ? rb.selection().data() : nullptr);
+
+  // The arguments of every value are resolved once for the batch. Each group then runs its UDAs
+  // over its own rows of those arguments.
+  const auto& values = plan_node_->values();
+  std::vector<SharedArray> constants;
+  std::vector<std::vector<const arrow::Array*>> value_args(values.size());
+  for (const auto& [i, value] : Enumerate(values)) {
+    for (const auto* dep : value->Deps()) {
+      switch (dep->ExpressionType()) {
+        case plan::Expression::kColumn:
+          value_args[i].push_back(
+              rb.ColumnAt(static_cast<const plan::Column*>(dep)->Index()).get());
+          break;
+        case plan::Expression::kConstant:
+          constants.push_back(EvalScalarToArrow(
+              exec_state, *static_cast<const plan::ScalarValue*>(dep), rb.num_column_rows()));
+          value_args[i].push_back(constants.back().get());
+          break;
+        default:
+          return error::InvalidArgument("Invalid expression type in agg: $0",
+                                        magic_enum::enum_name(dep->ExpressionType()));
+      }
+    }
+  }
+
+  for (auto group_id : batch_groups_) {
+    const uint32_t* selection = batch_selection_.data() + batch_group_offsets_[group_id];
+    size_t count = batch_group_counts_[group_id];
+    for (const auto& [i, uda_info] : Enumerate(group_udas_[group_id])) {
+      PX_RETURN_IF_ERROR(uda_info.def->ExecBatchUpdateArrowSelected(
+          uda_info.uda.get(), nullptr /* ctx */, value_args[i], selection, count));
+    }
+  }
+  return Status::OK();
+}
+
+Status AggNode::ConvertGroupIndexToRowBatch(ExecState* exec_state, bool finalize,
+                                            RowBatch* output_rb) {
+  DCHECK(output_rb != nullptr);
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> group_builders;
+  std::vector<arrow::ArrayBuilder*> raw_group_builders;
+  for (const auto& group_dt : group_data_types_) {
+    group_builders.push_back(types::MakeArrowBuilder(group_dt, exec_state->exec_mem_pool()));
+    raw_group_builders.push_back(group_builders.back().get());
+  }
+  PX_RETURN_IF_ERROR(group_index_->AppendKeys(raw_group_builders));
+
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> value_builders;
+  for (const auto& value_data_type : value_data_types_) {
+    value_builders.push_back(types::MakeArrowBuilder(finalize ? value_data_type : types::STRING,
+                                                     exec_state->exec_mem_pool()));
+  }
+  for (const auto& udas : group_udas_) {
+    for (const auto& [i, uda_info] : Enumerate(udas)) {
+      if (finalize) {
+        PX_RETURN_IF_ERROR(uda_info.def->FinalizeArrow(uda_info.uda.get(), function_ctx_.get(),
+                                                       value_builders[i].get()));
+      } else {
+        PX_RETURN_IF_ERROR(uda_info.def->SerializeArrow(uda_info.uda.get(), function_ctx_.get(),
+                                                        value_builders[i].get()));
+      }
+    }
+  }
+
+  for (const auto& builder : group_builders) {
+    SharedArray arr;
+    PX_RETURN_IF_ERROR(builder->Finish(&arr));
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(arr));
+  }
+  for (const auto& builder : value_builders) {
+    SharedArray arr;
+    PX_RETURN_IF_ERROR(builder->Finish(&arr));
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(arr));
+  }
+  return Status::OK();
+}
+
+StatusOr<std::unique_ptr<RowBatch>> AggNode::ConvertGroupsToRowBatch(ExecState* exec_state,
+                                                                     bool finalize) {
+  const auto& desc = finalize ? *output_descriptor_ : *serialized_descriptor_;
+  if (group_index_ != nullptr) {
+    auto output_rb = std::make_unique<RowBatch>(desc, group_index_->num_groups());
+    PX_RETURN_IF_ERROR(ConvertGroupIndexToRowBatch(exec_state, finalize, output_rb.get()));
+    return output_rb;
+  }
+  auto output_rb = std::make_unique<RowBatch>(desc, agg_hash_map_.size());
+  PX_RETURN_IF_ERROR(ConvertAggHashMapToRowBatch(exec_state, finalize, output_rb.get()));
+  return output_rb;
+}
+
+Status AggNode::EmitGroups(ExecState* exec_state, const RowBatch& rb) {
+  if (spill_partitions_ != nullptr) {
+    return EmitSpilledGroups(exec_state, rb);
+  }
+  // The groups that other nodes merged go out first, the groups of this node end the stream.
+  for (const auto& partition_rb : partition_outputs_) {
+    PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, *partition_rb));
+  }
+  partition_outputs_.clear();
+  PX_ASSIGN_OR_RETURN(auto output_rb,
+                      ConvertGroupsToRowBatch(exec_state, plan_node_->finalize_results()));
+  output_rb->set_eow(rb.eow());
+  output_rb->set_eos(rb.eos());
+  PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, *output_rb));
+  return ClearAggState(exec_state);
+}
+
+bool AggNode::CanSpill(ExecState* exec_state) const {
+  // Windowed aggregates emit their groups at the end of every window, so only blocking aggregates
+  // build up state for the whole query.
+  if (HasNoGroups() || plan_node_->windowed() || !exec_state->spill_manager()->enabled()) {
+    return false;
+  }
+  // Spilled groups are written out serialized and merged back in, which only works for the UDAs
+  // that support partial aggregation.
+  return std::all_of(plan_node_->values().begin(), plan_node_->values().end(),
+                     [exec_state](const auto& value) {
+                       return exec_state->GetUDADefinition(value->uda_id())->supports_partial();
+                     });
+}
+
+int64_t AggNode::EstimateGroupsBytes() const {
+  int64_t values_bytes = plan_node_->values().size() * kEstimatedUDABytes;
+  if (group_index_ != nullptr) {
+    return group_index_->bytes() + group_index_->num_groups() * values_bytes;
+  }
+  int64_t group_bytes = sizeof(RowTuple) + sizeof(AggHashValue) + 2 * sizeof(void*) +
+                        group_data_types_.size() * sizeof(types::FixedSizeValueUnion) +
+                        values_bytes;
+  return agg_hash_map_.size() * group_bytes;
+}
+
+bool AggNode::ReserveGroupsBytes(SpillManager* spill_manager) {
+  int64_t bytes = EstimateGroupsBytes();
+  if (bytes <= reserved_bytes_) {
+    return true;
+  }
+  if (!spill_manager->TryReserve(bytes - reserved_bytes_)) {
+    return false;
+  }
+  reserved_bytes_ = bytes;
+  return true;
+}
+
+Status AggNode::ReserveOrSpillGroups(ExecState* exec_state) {
+  if (!CanSpill(exec_state) || ReserveGroupsBytes(exec_state->spill_manager())) {
+    return Status::OK();
+  }
+  if (spill_partitions_ == nullptr) {
+    spill_partitions_ = std::make_unique<SpillPartitions>(exec_state->spill_manager(),
+                                                          serialized_group_cols_, /* depth */ 0);
+  }
+  return SpillGroups(exec_state, spill_partitions_.get());
+}
+
+Status AggNode::SpillGroups(ExecState* exec_state, SpillPartitions* partitions) {
+  PX_ASSIGN_OR_RETURN(auto serialized_rb,
+                      ConvertGroupsToRowBatch(exec_state, /* finalize */ false));
+  PX_RETURN_IF_ERROR(partitions->Add(*serialized_rb));
+  return ClearAggState(exec_state);
+}
+
+Status AggNode::MergeSerializedGroups(ExecState* exec_state, const RowBatch& rb) {
+  auto groups_size = static_cast<int64_t>(plan_node_->groups().size());
+  if (group_index_ != nullptr) {
+    std::vector<const arrow::Array*> key_cols;
+    for (auto col_idx : serialized_group_cols_) {
+      key_cols.push_back(rb.ColumnAt(col_idx).get());
+    }
+    group_index_->FindOrInsertBatch(key_cols, rb.num_rows(), &batch_group_ids_);
+    while (group_udas_.size() < group_index_->num_groups()) {
+      group_udas_.emplace_back();
+      PX_RETURN_IF_ERROR(CreateUDAInfoValues(&group_udas_.back(), exec_state));
+    }
+    for (int64_t row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+      PX_RETURN_IF_ERROR(DeserializeAndMergeRow(&group_udas_[batch_group_ids_[row_idx]], rb,
+                                                row_idx, groups_size));
+    }
+    return Status::OK();
+  }
+  PX_RETURN_IF_ERROR(ExtractRowTupleForBatch(rb, serialized_group_cols_));
+  FindOrInsertGroupArgs(exec_state, rb.num_rows());
+  PX_RETURN_IF_ERROR(DeserializeAndMergeGrouped(group_args_chunk_, rb));
+  return ResetGroupArgs();
+}
+
+Status AggNode::MergeUDAs(std::vector<UDAInfo>* udas, const std::vector<UDAInfo>& other_udas) {
+  DCHECK_EQ(udas->size(), other_udas.size());
+  for (const auto& [i, uda_info] : Enumerate(*udas)) {
+    PX_RETURN_IF_ERROR(
+        uda_info.def->Merge(uda_info.uda.get(), other_udas[i].uda.get(), function_ctx_.get()));
+  }
+  return Status::OK();
+}
+
+Status AggNode::MergeSpilledGroupsFrom(ExecState* exec_state, AggNode* other) {
+  // The groups that other spilled only exist serialized, so all of its groups are moved to the
+  // partitions of this node, and merged with the rest when they are read back at eos.
+  auto other_partitions = std::move(other->spill_partitions_);
+  PX_RETURN_IF_ERROR(other->SpillGroups(exec_state, other_partitions.get()));
+  if (spill_partitions_ == nullptr) {
+    spill_partitions_ = std::make_unique<SpillPartitions>(exec_state->spill_manager(),
+                                                          serialized_group_cols_, /* depth */ 0);
+  }
+  for (size_t i = 0; i < other_partitions->num_partitions(); ++i) {
+    auto* partition = other_partitions->partition(i);
+    if (partition == nullptr) {
+      continue;
+    }
+    while (true) {
+      PX_ASSIGN_OR_RETURN(auto rb, partition->ReadNext());
+      if (rb == nullptr) {
+        break;
+      }
+      PX_RETURN_IF_ERROR(spill_partitions_->Add(*rb));
+    }
+  }
+  return Status::OK();
+}
+
+Status AggNode::MergeGroupsFrom(ExecState* exec_state, AggNode* other) {
+  DCHECK_EQ(plan_node_->values().size(), other->plan_node_->values().size());
+  if (other->spill_partitions_ != nullptr) {
+    return MergeSpilledGroupsFrom(exec_state, other);
+  }
+
+  if (HasNoGroups()) {
+    return MergeUDAs(&udas_no_groups_, other->udas_no_groups_);
+  }
+
+  if (group_index_ != nullptr) {
+    DCHECK(other->group_index_ != nullptr);
+    std::vector<std::unique_ptr<arrow::ArrayBuilder>> key_builders;
+    std::vector<arrow::ArrayBuilder*> raw_key_builders;
+    for (const auto& group_dt : group_data_types_) {
+      key_builders.push_back(types::MakeArrowBuilder(group_dt, exec_state->exec_mem_pool()));
+      raw_key_builders.push_back(key_builders.back().get());
+    }
+    PX_RETURN_IF_ERROR(other->group_index_->AppendKeys(raw_key_builders));
+    std::vector<SharedArray> key_arrays(key_builders.size());
+    std::vector<const arrow::Array*> key_cols;
+    for (const auto& [i, builder] : Enumerate(key_builders)) {
+      PX_RETURN_IF_ERROR(builder->Finish(&key_arrays[i]));
+      key_cols.push_back(key_arrays[i].get());
+    }
+    PX_RETURN_IF_ERROR(
+        MergeColumnarGroups(key_cols, other->group_index_->num_groups(), &other->group_udas_));
+  } else {
+    for (const auto& [other_key, other_val] : other->agg_hash_map_) {
+      PX_RETURN_IF_ERROR(MergeRowTupleGroup(other_key, other_val));
+    }
+  }
+  PX_RETURN_IF_ERROR(other->ClearAggState(exec_state));
+  return ReserveOrSpillGroups(exec_state);
+}
+
+Status AggNode::MergeColumnarGroups(const std::vector<const arrow::Array*>& keys, size_t num_groups,
+                                    std::vector<std::vector<UDAInfo>>* udas) {
+  DCHECK_EQ(num_groups, udas->size());
+  group_index_->FindOrInsertBatch(keys, num_groups, &batch_group_ids_);
+  for (const auto& [other_group_id, other_udas] : Enumerate(*udas)) {
+    uint32_t group_id = batch_group_ids_[other_group_id];
+    if (group_id == group_udas_.size()) {
+      // The new groups get ids in the order of the keys, they take over the UDAs of other.
+      group_udas_.push_back(std::move(other_udas));
+      continue;
+    }
+    PX_RETURN_IF_ERROR(MergeUDAs(&group_udas_[group_id], other_udas));
+  }
+  return Status::OK();
+}
+
+Status AggNode::MergeRowTupleGroup(RowTuple* other_key, AggHashValue* other_val) {
+  auto it = agg_hash_map_.find(other_key);
+  if (it != agg_hash_map_.end()) {
+    return MergeUDAs(&it->second->udas, other_val->udas);
+  }
+  // The keys of other are owned by its pools, so new groups get a copy.
+  RowTuple* key = CreateGroupArgsRowTuple();
+  key->fixed_values = other_key->fixed_values;
+  key->variable_values = other_key->variable_values;
+  auto* val = udas_pool_.Make<AggHashValue>();
+  val->udas = std::move(other_val->udas);
+  for (const auto& dt : stored_cols_data_types_) {
+    val->agg_cols.emplace_back(types::ColumnWrapper::Make(dt, 0));
+  }
+  agg_hash_map_[key] = val;
+  return Status::OK();
+}
+
+Status AggNode::PartitionGroups(ExecState* exec_state, size_t num_partitions) {
+  DCHECK(SupportsPartitionedMerge());
+  group_partitions_.clear();
+  group_partitions_.resize(num_partitions);
+  if (group_index_ == nullptr) {
+    // The groups stay in the hash map until the partition of this node is merged, their keys and
+    // values are owned by the pools of the node either way.
+    for (const auto& [key, val] : agg_hash_map_) {
+      group_partitions_[PartitionOfHash(key->Hash(), num_partitions)].groups.emplace_back(key, val);
+    }
+    return Status::OK();
+  }
+
+  // The columnar groups are taken out of the group index, which is rebuilt by the merge.
+  std::vector<std::vector<uint32_t>> partition_group_ids(num_partitions);
+  for (uint32_t group_id = 0; group_id < group_index_->num_groups(); ++group_id) {
+    partition_group_ids[PartitionOfHash(group_index_->hash(group_id), num_partitions)].push_back(
+        group_id);
+  }
+  for (const auto& [i, group_ids] : Enumerate(partition_group_ids)) {
+    auto& partition = group_partitions_[i];
+    std::vector<std::unique_ptr<arrow::ArrayBuilder>> key_builders;
+    std::vector<arrow::ArrayBuilder*> raw_key_builders;
+    for (const auto& group_dt : group_data_types_) {
+      key_builders.push_back(types::MakeArrowBuilder(group_dt, exec_state->exec_mem_pool()));
+      raw_key_builders.push_back(key_builders.back().get());
+    }
+    PX_RETURN_IF_ERROR(group_index_->AppendKeys(group_ids, raw_key_builders));
+    partition.keys.resize(key_builders.size());
+    for (const auto& [col, builder] : Enumerate(key_builders)) {
+      PX_RETURN_IF_ERROR(builder->Finish(&partition.keys[col]));
+    }
+    partition.udas.reserve(group_ids.size());
+    for (uint32_t group_id : group_ids) {
+      partition.udas.push_back(std::move(group_udas_[group_id]));
+    }
+  }
+  group_index_->Clear();
+  group_udas_.clear();
+  return Status::OK();
+}
+
+Status AggNode::MergePartitionFrom(ExecState*, const std::vector<AggNode*>& nodes,
+                                   size_t partition) {
+  DCHECK(std::find(nodes.begin(), nodes.end(), this) != nodes.end());
+  // The memory of the groups was reserved by the nodes that built them, merging them only shrinks
+  // it, so unlike MergeGroupsFrom this doesn't spill.
+  if (group_index_ != nullptr) {
+    // The index of this node was emptied by PartitionGroups, so its own groups are merged back in
+    // like those of the other nodes.
+    for (AggNode* node : nodes) {
+      auto& node_partition = node->group_partitions_[partition];
+      std::vector<const arrow::Array*> key_cols;
+      for (const auto& key : node_partition.keys) {
+        key_cols.push_back(key.get());
+      }
+      PX_RETURN_IF_ERROR(
+          MergeColumnarGroups(key_cols, node_partition.udas.size(), &node_partition.udas));
+    }
+    return Status::OK();
+  }
+
+  // The keys and values of the groups stay in the pools of their nodes, so the hash map is rebuilt
+  // with the groups of this node in the partition, and the groups of the other nodes merged in.
+  agg_hash_map_.clear();
+  for (const auto& [key, val] : group_partitions_[partition].groups) {
+    agg_hash_map_[key] = val;
+  }
+  for (AggNode* node : nodes) {
+    if (node == this) {
+      continue;
+    }
+    for (const auto& [key, val] : node->group_partitions_[partition].groups) {
+      PX_RETURN_IF_ERROR(MergeRowTupleGroup(key, val));
+    }
+  }
+  return Status::OK();
+}
+
+StatusOr<std::unique_ptr<RowBatch>> AggNode::TakePartitionOutput(ExecState* exec_state) {
+  PX_ASSIGN_OR_RETURN(auto output_rb,
+                      ConvertGroupsToRowBatch(exec_state, plan_node_->finalize_results()));
+  PX_RETURN_IF_ERROR(ClearAggState(exec_state));
+  return output_rb;
+}
+
+Status AggNode::MergeSpilledPartition(ExecState* exec_state, SpillFile* partition, int depth) {
+  auto* spill_manager = exec_state->spill_manager();
+  std::unique_ptr<SpillPartitions> sub_partitions;
+  while (true) {
+    PX_ASSIGN_OR_RETURN(auto rb, partition->ReadNext());
+    if (rb == nullptr) {
+      break;
+    }
+    if (sub_partitions != nullptr) {
+      PX_RETURN_IF_ERROR(sub_partitions->Add(*rb));
+      continue;
+    }
+    PX_RETURN_IF_ERROR(MergeSerializedGroups(exec_state, *rb));
+    if (ReserveGroupsBytes(spill_manager)) {
+      continue;
+    }
+    if (depth >= FLAGS_carnot_spill_max_depth) {
+      LOG_FIRST_N(WARNING, 1) << absl::Substitute(
+          "Spilled aggregate partition exceeds the memory budget after $0 levels of partitioning, "
+          "merging it in memory.",
+          depth + 1);
+      continue;
+    }
+    // Too many groups hash to this partition, so its groups are split with the next hash function.
+    spill_manager->RecordPartitionRecursed();
+    sub_partitions =
+        std::make_unique<SpillPartitions>(spill_manager, serialized_group_cols_, depth + 1);
+    PX_RETURN_IF_ERROR(SpillGroups(exec_state, sub_partitions.get()));
+  }
+
+  if (sub_partitions == nullptr) {
+    PX_ASSIGN_OR_RETURN(auto output_rb,
+                        ConvertGroupsToRowBatch(exec_state, plan_node_->finalize_results()));
     PX_RETURN_IF_ERROR(ClearAggState(exec_state));
+    return SendSpilledOutput(exec_state, std::move(output_rb));
+  }
+  for (size_t i = 0; i < sub_partitions->num_partitions(); ++i) {
+    if (sub_partitions->partition(i) != nullptr) {
+      PX_RETURN_IF_ERROR(
+          MergeSpilledPartition(exec_state, sub_partitions->partition(i), depth + 1));
+    }
   }
   return Status::OK();
 }
 
+Status AggNode::SendSpilledOutput(ExecState* exec_state, std::unique_ptr<RowBatch> output_rb) {
+  // Batches are sent one behind, so that the last one can be marked as eos.
+  if (pending_spilled_output_ != nullptr) {
+    PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, *pending_spilled_output_));
+  }
+  pending_spilled_output_ = std::move(output_rb);
+  return Status::OK();
+}
+
+Status AggNode::EmitSpilledGroups(ExecState* exec_state, const RowBatch& rb) {
+  // The groups still in memory can belong to any of the partitions, so they are spilled as well.
+  auto partitions = std::move(spill_partitions_);
+  PX_RETURN_IF_ERROR(SpillGroups(exec_state, partitions.get()));
+  merging_spilled_groups_ = true;
+  for (size_t i = 0; i < partitions->num_partitions(); ++i) {
+    if (partitions->partition(i) != nullptr) {
+      PX_RETURN_IF_ERROR(
+          MergeSpilledPartition(exec_state, partitions->partition(i), partitions->depth()));
+    }
+  }
+  merging_spilled_groups_ = false;
+
+  auto output_rb = std::move(pending_spilled_output_);
+  if (output_rb == nullptr) {
+    PX_ASSIGN_OR_RETURN(output_rb, RowBatch::WithZeroRows(*output_descriptor_, rb.eow(), rb.eos()));
+  }
+  output_rb->set_eow(rb.eow());
+  output_rb->set_eos(rb.eos());
+  return SendRowBatchToChildren(exec_state, *output_rb);
+}
+
 StatusOr<types::DataType> AggNode::GetTypeOfDep(const plan::ScalarExpression& expr) const {
   // Agg exprs can only be of type col, or  const.
   switch (expr.ExpressionType()) {
@@ -428,7 +1003,7 @@ Status AggNode::EvaluateSingleExpressionNoGroups(ExecState* exec_state, const UD
       [&](const plan::ScalarValue& val,
           const std::vector<StatusOr<SharedArray>>& children) -> std::shared_ptr<arrow::Array> {
         DCHECK_EQ(children.size(), 0ULL);
-        return EvalScalarToArrow(exec_state, val, input_rb.num_rows());
+        return EvalScalarToArrow(exec_state, val, input_rb.num_column_rows());
       });
 
   walker.OnColumn(
@@ -452,8 +1027,14 @@ Status AggNode::EvaluateSingleExpressionNoGroups(ExecState* exec_state, const UD
           }
           raw_children.push_back(child.ValueOrDie().get());
         }
-        PX_RETURN_IF_ERROR(uda_info.def->ExecBatchUpdateArrow(uda_info.uda.get(), nullptr /* ctx */,
-                                                              raw_children));
+        if (input_rb.has_selection()) {
+          PX_RETURN_IF_ERROR(uda_info.def->ExecBatchUpdateArrowSelected(
+              uda_info.uda.get(), nullptr /* ctx */, raw_children, input_rb.selection().data(),
+              input_rb.selection().size()));
+        } else {
+          PX_RETURN_IF_ERROR(uda_info.def->ExecBatchUpdateArrow(
+              uda_info.uda.get(), nullptr /* ctx */, raw_children));
+        }
         // Blocking aggregates don't produce results until all data is seen.
         return {};
       });
@@ -550,7 +1131,7 @@ Status AggNode::CreateColumnMapping() {
 }
 
 AggHashValue* AggNode::CreateAggHashValue(ExecState* exec_state) {
-  auto* val = udas_pool_.Add(new AggHashValue);
+  auto* val = udas_pool_.Make<AggHashValue>();
   PX_CHECK_OK(CreateUDAInfoValues(&(val->udas), exec_state));
   for (const auto& dt : stored_cols_data_types_) {
     val->agg_cols.emplace_back(types::ColumnWrapper::Make(dt, 0));
@@ -568,7 +1149,8 @@ Status AggNode::CreateUDAInfoValues(std::vector<UDAInfo>* val, ExecState* exec_s
 
     // We only init the UDAs if we're doing the partial agg ourself. If another node did the partial
     // agg, then this node will deserialize and merge into these UDAs, so there's no need for init.
-    if (plan_node_->partial_agg()) {
+    // The same goes for the groups merged back from disk, their partials were already initialized.
+    if (plan_node_->partial_agg() && !merging_spilled_groups_) {
       std::vector<std::shared_ptr<types::BaseValueType>> init_args;
       for (const auto& arg : value->init_arguments()) {
         init_args.push_back(arg.ToBaseValueType());
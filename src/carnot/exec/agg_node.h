@@ -27,7 +27,9 @@
 #include "src/carnot/exec/exec_node.h"
 #include "src/carnot/exec/exec_state.h"
 #include "src/carnot/exec/expression_evaluator.h"
+#include "src/carnot/exec/group_index.h"
 #include "src/carnot/exec/row_tuple.h"
+#include "src/carnot/exec/spill.h"
 #include "src/carnot/plan/operators.h"
 #include "src/carnot/plan/scalar_expression.h"
 #include "src/carnot/udf/base.h"
@@ -41,6 +43,8 @@
 #include "src/table_store/schema/row_batch.h"
 #include "src/table_store/table_store.h"
 
+DECLARE_bool(carnot_columnar_group_by);
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -73,9 +77,53 @@ class AggNode : public ProcessingNode {
   AggNode() = default;
   virtual ~AggNode() = default;
 
+  /**
+   * Merges the groups of another AggNode, which runs the same aggregate over a different part of
+   * the input, into the groups of this node. The UDA states are merged (or moved, for new groups)
+   * in process, so they don't have to support partial aggregation. other is left without groups.
+   */
+  Status MergeGroupsFrom(ExecState* exec_state, AggNode* other);
+
+  /**
+   * Whether the groups of the node can be merged with PartitionGroups and MergePartitionFrom,
+   * which requires the node to have groups that are all held in memory.
+   */
+  bool SupportsPartitionedMerge() const { return !HasNoGroups() && spill_partitions_ == nullptr; }
+
+  /**
+   * Splits the groups of the node into num_partitions by the hash of their keys, so that each
+   * partition of the groups of several nodes can be merged by MergePartitionFrom on its own thread.
+   */
+  Status PartitionGroups(ExecState* exec_state, size_t num_partitions);
+
+  /**
+   * Merges one partition of the groups of nodes, which run the same aggregate over different parts
+   * of the input and were all split by PartitionGroups, into this node, which must be one of them.
+   * The node is left with the groups of that partition only. Merges of different partitions, into
+   * different nodes, can run concurrently.
+   */
+  Status MergePartitionFrom(ExecState* exec_state, const std::vector<AggNode*>& nodes,
+                            size_t partition);
+
+  /**
+   * Converts the groups of the node to a row batch of its output and clears them, so that the
+   * node that outputs the results can send it (see AddPartitionOutput).
+   */
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> TakePartitionOutput(
+      ExecState* exec_state);
+
+  /**
+   * Adds the output of the groups that another node merged, which is sent along with the groups
+   * of this node once they are emitted.
+   */
+  void AddPartitionOutput(std::unique_ptr<table_store::schema::RowBatch> rb) {
+    partition_outputs_.push_back(std::move(rb));
+  }
+
  protected:
   Status AggregateGroupByNone(ExecState* exec_state, const table_store::schema::RowBatch& rb);
   Status AggregateGroupByClause(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  Status AggregateGroupByColumnar(ExecState* exec_state, const table_store::schema::RowBatch& rb);
 
   std::string DebugStringImpl() override;
   Status InitImpl(const plan::Operator& plan_node) override;
@@ -84,6 +132,7 @@ class AggNode : public ProcessingNode {
   Status CloseImpl(ExecState* exec_state) override;
   Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
                          size_t parent_index) override;
+  bool HandlesSelection() const override;
 
  private:
   AggHashMap agg_hash_map_;
@@ -108,6 +157,15 @@ class AggNode : public ProcessingNode {
   Status DeserializeAndMergeRow(std::vector<UDAInfo>* udas, const RowBatch& rb, int64_t row_idx,
                                 int64_t groups_size);
 
+  Status MergeUDAs(std::vector<UDAInfo>* udas, const std::vector<UDAInfo>& other_udas);
+  // Merges columnar groups, given by their keys and UDAs, into the group index. The UDAs of the
+  // new groups are moved.
+  Status MergeColumnarGroups(const std::vector<const arrow::Array*>& keys, size_t num_groups,
+                             std::vector<std::vector<UDAInfo>>* udas);
+  // Merges a group of the RowTuple hash map, whose key is owned by another node.
+  Status MergeRowTupleGroup(RowTuple* other_key, AggHashValue* other_val);
+  Status MergeSpilledGroupsFrom(ExecState* exec_state, AggNode* other);
+
   // Store information about aggregate node from the query planner.
   std::unique_ptr<plan::AggregateOperator> plan_node_;
   std::unique_ptr<table_store::schema::RowDescriptor> input_descriptor_;
@@ -136,6 +194,8 @@ class AggNode : public ProcessingNode {
   ObjectPool group_args_pool_{"group_args_pool"};
   ObjectPool udas_pool_{"udas_pool"};
 
+  // The input columns of the groups.
+  std::vector<int64_t> group_cols_;
   std::vector<types::DataType> group_data_types_;
   std::vector<types::DataType> value_data_types_;
 
@@ -143,21 +203,95 @@ class AggNode : public ProcessingNode {
   // This vector holds pointers to the row_tuples which are managed by the group_args_pool_.
 
   std::vector<GroupArgs> group_args_chunk_;
+
+  // Variables specific to the columnar GroupBy Agg, which is used instead of the RowTuple hash map
+  // when the group_index_ supports the types of the groups.
+  std::unique_ptr<GroupIndex> group_index_;
+  // The UDAs of each group, indexed by group id.
+  std::vector<std::vector<UDAInfo>> group_udas_;
+  // The group id of each row of the current batch.
+  std::vector<uint32_t> batch_group_ids_;
+  // The rows of the current batch sorted by group, so that each group gets a selection vector.
+  std::vector<uint32_t> batch_selection_;
+  // Per group: the number of rows in the current batch and where its rows start in the selection.
+  std::vector<uint32_t> batch_group_counts_;
+  std::vector<uint32_t> batch_group_offsets_;
+  // The groups that have rows in the current batch.
+  std::vector<uint32_t> batch_groups_;
   // END: Variables specific to GroupBy Agg.
 
+  // Variables specific to spilling blocking GroupBy Aggs. Once the groups exceed the memory budget
+  // of the query, they are serialized (like a partial agg would output them) and written to disk
+  // partitioned by group. At eos each partition is merged and emitted on its own.
+
+  // The descriptor of the serialized groups: the group columns followed by a string per value.
+  std::unique_ptr<table_store::schema::RowDescriptor> serialized_descriptor_;
+  // The group columns of the serialized groups.
+  std::vector<int64_t> serialized_group_cols_;
+  std::unique_ptr<SpillPartitions> spill_partitions_;
+  // The bytes of the memory budget reserved for the groups currently held in memory.
+  int64_t reserved_bytes_ = 0;
+  // Whether the groups are merged back from disk, rather than built from the input.
+  bool merging_spilled_groups_ = false;
+  // The last output batch of the spilled groups, held until we know whether it's the last one.
+  std::unique_ptr<table_store::schema::RowBatch> pending_spilled_output_;
+  // END: Variables specific to spilling GroupBy Agg.
+
+  // Variables specific to the partitioned merge of GroupBy Aggs.
+  struct GroupPartition {
+    // The groups of the RowTuple hash map, still owned by the pools of the node.
+    std::vector<std::pair<RowTuple*, AggHashValue*>> groups;
+    // The keys and UDAs of the columnar groups, taken out of the group index.
+    std::vector<std::shared_ptr<arrow::Array>> keys;
+    std::vector<std::vector<UDAInfo>> udas;
+  };
+  std::vector<GroupPartition> group_partitions_;
+  // The outputs of the partitions merged by the other nodes, sent before the groups of this node.
+  std::vector<std::unique_ptr<table_store::schema::RowBatch>> partition_outputs_;
+  // END: Variables specific to the partitioned merge of GroupBy Aggs.
+
   // Creates a mapping between plan cols and stored cols (see above comment).
   Status CreateColumnMapping();
 
-  Status ExtractRowTupleForBatch(const table_store::schema::RowBatch& rb);
+  Status ExtractRowTupleForBatch(const table_store::schema::RowBatch& rb,
+                                 const std::vector<int64_t>& group_cols);
   Status HashRowBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb);
   Status EvaluatePartialAggregates(ExecState* exec_state, size_t num_records);
   Status ResetGroupArgs();
-  Status ConvertAggHashMapToRowBatch(ExecState* exec_state,
+  Status ConvertAggHashMapToRowBatch(ExecState* exec_state, bool finalize,
+                                     table_store::schema::RowBatch* output_rb);
+  // Groups the rows of the batch by group id. rows maps the positions in batch_group_ids_ to rows
+  // of the input columns, nullptr if they are the same.
+  void ComputeBatchSelections(size_t num_rows, const uint32_t* rows);
+  Status UpdateGroupsColumnar(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  Status ConvertGroupIndexToRowBatch(ExecState* exec_state, bool finalize,
                                      table_store::schema::RowBatch* output_rb);
+  // Outputs the groups either as the results of the node or serialized, to be merged later.
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> ConvertGroupsToRowBatch(
+      ExecState* exec_state, bool finalize);
+  // Looks up the AggHashValue of each row in group_args_chunk_, creating the missing ones.
+  void FindOrInsertGroupArgs(ExecState* exec_state, int64_t num_rows);
+  Status EmitGroups(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+
+  bool CanSpill(ExecState* exec_state) const;
+  int64_t EstimateGroupsBytes() const;
+  // Grows the reservation of the memory budget to the size of the groups, returns false if that
+  // exceeds the budget.
+  bool ReserveGroupsBytes(SpillManager* spill_manager);
+  // Reserves the memory of the groups, or spills them if that exceeds the budget of the query.
+  Status ReserveOrSpillGroups(ExecState* exec_state);
+  Status SpillGroups(ExecState* exec_state, SpillPartitions* partitions);
+  // Merges a batch of serialized groups into the groups of the node.
+  Status MergeSerializedGroups(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  // Merges all the groups of a partition and outputs them, partitioning again if they don't fit.
+  Status MergeSpilledPartition(ExecState* exec_state, SpillFile* partition, int depth);
+  Status SendSpilledOutput(ExecState* exec_state,
+                           std::unique_ptr<table_store::schema::RowBatch> output_rb);
+  Status EmitSpilledGroups(ExecState* exec_state, const table_store::schema::RowBatch& rb);
 
   AggHashValue* CreateAggHashValue(ExecState* exec_state);
   RowTuple* CreateGroupArgsRowTuple() {
-    return group_args_pool_.Add(new RowTuple(&group_data_types_));
+    return group_args_pool_.Make<RowTuple>(&group_data_types_);
   }
 
   Status CreateUDAInfoValues(std::vector<UDAInfo>* val, ExecState* exec_state);
@@ -19,11 +19,14 @@
 #include "src/carnot/exec/agg_node.h"
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #include <google/protobuf/text_format.h>
 #include <gtest/gtest.h>
 #include <sole.hpp>
 
+#include "src/carnot/exec/spill.h"
 #include "src/carnot/exec/test_utils.h"
 #include "src/carnot/plan/operators.h"
 #include "src/carnot/planpb/plan.pb.h"
@@ -84,6 +87,21 @@ class MinSumWithInitUDA : public udf::UDA {
   types::Int64Value sum_ = 0;
 };
 
+// Like MinSumUDA, but it can't be serialized, so its groups can't be spilled.
+class MinSumNoPartialUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Int64Value arg1, types::Int64Value arg2) {
+    sum_ = sum_.val + std::min(arg1.val, arg2.val);
+  }
+  void Merge(udf::FunctionContext*, const MinSumNoPartialUDA& other) {
+    sum_ = sum_.val + other.sum_.val;
+  }
+  types::Int64Value Finalize(udf::FunctionContext*) { return sum_; }
+
+ protected:
+  types::Int64Value sum_ = 0;
+};
+
 constexpr char kBlockingNoGroupAgg[] = R"(
 op_type: AGGREGATE_OPERATOR
 agg_op {
@@ -137,6 +155,36 @@ agg_op {
   finalize_results: true
 })";
 
+constexpr char kBlockingSingleGroupNoPartialAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum_no_partial"
+    id: 2
+    args {
+      column {
+        node:0
+        index: 0
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  group_names: "g1"
+  value_names: "value1"
+  partial_agg: true
+  finalize_results: true
+})";
+
 constexpr char kBlockingMultipleGroupAgg[] = R"(
 op_type: AGGREGATE_OPERATOR
 agg_op {
@@ -171,6 +219,69 @@ agg_op {
   finalize_results: true
 })";
 
+constexpr char kBlockingStringGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 1
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 2
+      }
+    }
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  group_names: "g1"
+  value_names: "value1"
+  partial_agg: true
+  finalize_results: true
+})";
+
+constexpr char kBlockingUInt128StringGroupAgg[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  windowed: false
+  values {
+    name: "minsum"
+    args {
+      column {
+        node:0
+        index: 2
+      }
+    }
+    args {
+      column {
+        node:0
+        index: 3
+      }
+    }
+  }
+  groups {
+     node: 0
+     index: 0
+  }
+  groups {
+     node: 0
+     index: 1
+  }
+  group_names: "upid"
+  group_names: "g2"
+  value_names: "value1"
+  partial_agg: true
+  finalize_results: true
+})";
+
 constexpr char kWindowedNoGroupAgg[] = R"(
 op_type: AGGREGATE_OPERATOR
 agg_op {
@@ -491,14 +602,20 @@ class AggNodeTest : public ::testing::Test {
     func_registry_ = std::make_unique<udf::Registry>("test");
     EXPECT_TRUE(func_registry_->Register<MinSumUDA>("minsum").ok());
     EXPECT_TRUE(func_registry_->Register<MinSumWithInitUDA>("minsum_w_init").ok());
+    EXPECT_TRUE(func_registry_->Register<MinSumNoPartialUDA>("minsum_no_partial").ok());
+    ResetExecState();
+  }
 
+ protected:
+  // Makes a new exec state, which picks up the current spill flags.
+  void ResetExecState() {
     exec_state_ = MakeTestExecState(func_registry_.get());
     EXPECT_OK(exec_state_->AddUDA(0, "minsum",
                                   std::vector<types::DataType>({types::INT64, types::INT64})));
     EXPECT_OK(exec_state_->AddUDA(1, "minsum_w_init", {types::INT64, types::INT64, types::INT64}));
+    EXPECT_OK(exec_state_->AddUDA(2, "minsum_no_partial", {types::INT64, types::INT64}));
   }
 
- protected:
   std::unique_ptr<ExecState> exec_state_;
   std::unique_ptr<udf::Registry> func_registry_;
 };
@@ -648,6 +765,106 @@ TEST_F(AggNodeTest, multiple_groups_with_string_blocking) {
       .Close();
 }
 
+TEST_F(AggNodeTest, single_group_blocking_row_tuple) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_columnar_group_by, false);
+  auto plan_node = PlanNodeFromPbtxt(kBlockingSingleGroupAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 1, 2, 2})
+                       .AddColumn<types::Int64Value>({2, 3, 3, 1})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, true, true)
+                       .AddColumn<types::Int64Value>({5, 6, 3, 4})
+                       .AddColumn<types::Int64Value>({1, 5, 3, 8})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 6, true, true)
+                          .AddColumn<types::Int64Value>({1, 2, 3, 4, 5, 6})
+                          .AddColumn<types::Int64Value>({2, 3, 3, 4, 1, 5})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, string_group_blocking) {
+  auto plan_node = PlanNodeFromPbtxt(kBlockingStringGroupAgg);
+  RowDescriptor input_rd({types::DataType::STRING, types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::STRING, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::StringValue>({"abc", "def", "abc", ""})
+                       .AddColumn<types::Int64Value>({2, 1, 3, 1})
+                       .AddColumn<types::Int64Value>({2, 5, 3, 1})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, true, true)
+                       .AddColumn<types::StringValue>({"ijk", "abc", "", "def"})
+                       .AddColumn<types::Int64Value>({1, 2, 3, 3})
+                       .AddColumn<types::Int64Value>({1, 3, 3, 8})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 4, true, true)
+                          .AddColumn<types::StringValue>({"abc", "def", "", "ijk"})
+                          .AddColumn<types::Int64Value>({7, 4, 4, 1})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, uint128_string_groups_blocking) {
+  auto plan_node = PlanNodeFromPbtxt(kBlockingUInt128StringGroupAgg);
+  RowDescriptor input_rd({types::DataType::UINT128, types::DataType::STRING,
+                          types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd(
+      {types::DataType::UINT128, types::DataType::STRING, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::UInt128Value>({types::UInt128Value(1, 2),
+                                                        types::UInt128Value(1, 2),
+                                                        types::UInt128Value(2, 1),
+                                                        types::UInt128Value(1, 2)})
+                       .AddColumn<types::StringValue>({"abc", "def", "abc", "abc"})
+                       .AddColumn<types::Int64Value>({2, 1, 3, 1})
+                       .AddColumn<types::Int64Value>({2, 5, 3, 1})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, true, true)
+                       .AddColumn<types::UInt128Value>(
+                           {types::UInt128Value(2, 1), types::UInt128Value(1, 2)})
+                       .AddColumn<types::StringValue>({"abc", "def"})
+                       .AddColumn<types::Int64Value>({4, 3})
+                       .AddColumn<types::Int64Value>({5, 8})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 3, true, true)
+                          .AddColumn<types::UInt128Value>({types::UInt128Value(1, 2),
+                                                           types::UInt128Value(1, 2),
+                                                           types::UInt128Value(2, 1)})
+                          .AddColumn<types::StringValue>({"abc", "def", "abc"})
+                          .AddColumn<types::Int64Value>({3, 4, 7})
+                          .get(),
+                      false)
+      .Close();
+}
+
 TEST_F(AggNodeTest, no_groups_windowed) {
   auto plan_node = PlanNodeFromPbtxt(kWindowedNoGroupAgg);
   RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
@@ -813,6 +1030,298 @@ TEST_F(AggNodeTest, single_group_blocking_init_args) {
       .Close();
 }
 
+TEST_F(AggNodeTest, single_group_blocking_spilled) {
+  // Every batch exceeds the budget, and the single partition never gets smaller, so it's
+  // partitioned again up to the max depth before being merged in memory.
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_memory_budget, 1);
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_partitions, 1);
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_max_depth, 2);
+  ResetExecState();
+  auto plan_node = PlanNodeFromPbtxt(kBlockingSingleGroupInitArgAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 1, 2, 2})
+                       .AddColumn<types::Int64Value>({2, 3, 3, 1})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, true, true)
+                       .AddColumn<types::Int64Value>({5, 6, 3, 4})
+                       .AddColumn<types::Int64Value>({1, 5, 3, 8})
+                       .get(),
+                   0)
+      // The spilled partial aggregates must not add the init arg again when they're merged.
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 6, true, true)
+                          .AddColumn<types::Int64Value>({1, 2, 3, 4, 5, 6})
+                          .AddColumn<types::Int64Value>({12, 13, 13, 14, 11, 15})
+                          .get(),
+                      false)
+      .Close();
+
+  EXPECT_GT(exec_state_->spill_manager()->spilled_bytes(), 0);
+  EXPECT_EQ(2, exec_state_->spill_manager()->partitions_recursed());
+  EXPECT_EQ(0, exec_state_->spill_manager()->reserved_bytes());
+}
+
+TEST_F(AggNodeTest, multiple_groups_with_string_blocking_spilled) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_columnar_group_by, false);
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_memory_budget, 1);
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_partitions, 1);
+  ResetExecState();
+  auto plan_node = PlanNodeFromPbtxt(kBlockingMultipleGroupAgg);
+  RowDescriptor input_rd({types::DataType::STRING, types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd(
+      {types::DataType::STRING, types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::StringValue>({"abc", "def", "abc", "fgh"})
+                       .AddColumn<types::Int64Value>({2, 1, 3, 1})
+                       .AddColumn<types::Int64Value>({2, 5, 3, 1})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, true, true)
+                       .AddColumn<types::StringValue>({"ijk", "abc", "abc", "def"})
+                       .AddColumn<types::Int64Value>({1, 2, 3, 3})
+                       .AddColumn<types::Int64Value>({1, 3, 3, 8})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 6, true, true)
+                          .AddColumn<types::StringValue>({"abc", "def", "abc", "fgh", "ijk", "def"})
+                          .AddColumn<types::Int64Value>({2, 1, 3, 1, 1, 3})
+                          .AddColumn<types::Int64Value>({4, 1, 6, 1, 1, 3})
+                          .get(),
+                      false)
+      .Close();
+
+  EXPECT_GT(exec_state_->spill_manager()->spilled_bytes(), 0);
+}
+
+TEST_F(AggNodeTest, single_group_blocking_not_spilled_without_partial) {
+  // The UDA can't be serialized, so the groups stay in memory even though they are over budget.
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_memory_budget, 1);
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_partitions, 1);
+  ResetExecState();
+  auto plan_node = PlanNodeFromPbtxt(kBlockingSingleGroupNoPartialAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Int64Value>({1, 1, 2, 2})
+                       .AddColumn<types::Int64Value>({2, 3, 3, 1})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, true, true)
+                       .AddColumn<types::Int64Value>({5, 6, 3, 4})
+                       .AddColumn<types::Int64Value>({1, 5, 3, 8})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 6, true, true)
+                          .AddColumn<types::Int64Value>({1, 2, 3, 4, 5, 6})
+                          .AddColumn<types::Int64Value>({2, 3, 3, 4, 1, 5})
+                          .get(),
+                      false)
+      .Close();
+
+  EXPECT_EQ(0, exec_state_->spill_manager()->spilled_bytes());
+}
+
+TEST_F(AggNodeTest, merge_groups_from) {
+  auto plan_node = PlanNodeFromPbtxt(kBlockingSingleGroupAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  auto other = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester.ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                         .AddColumn<types::Int64Value>({1, 1, 2, 2})
+                         .AddColumn<types::Int64Value>({2, 3, 3, 1})
+                         .get(),
+                     0, 0);
+  other.ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                        .AddColumn<types::Int64Value>({5, 6, 3, 2})
+                        .AddColumn<types::Int64Value>({1, 5, 3, 8})
+                        .get(),
+                    0, 0);
+  // Group 2 exists in both nodes, the groups 5, 6 and 3 are new.
+  EXPECT_OK(tester.node()->MergeGroupsFrom(exec_state_.get(), other.node()));
+  other.Close();
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 1, true, true)
+                       .AddColumn<types::Int64Value>({4})
+                       .AddColumn<types::Int64Value>({8})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 6, true, true)
+                          .AddColumn<types::Int64Value>({1, 2, 3, 4, 5, 6})
+                          .AddColumn<types::Int64Value>({2, 5, 3, 4, 1, 5})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, merge_groups_from_row_tuple) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_columnar_group_by, false);
+  auto plan_node = PlanNodeFromPbtxt(kBlockingMultipleGroupAgg);
+  RowDescriptor input_rd({types::DataType::STRING, types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd(
+      {types::DataType::STRING, types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  auto other = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester.ConsumeNext(RowBatchBuilder(input_rd, 3, /*eow*/ false, /*eos*/ false)
+                         .AddColumn<types::StringValue>({"abc", "def", "abc"})
+                         .AddColumn<types::Int64Value>({2, 1, 3})
+                         .AddColumn<types::Int64Value>({2, 5, 3})
+                         .get(),
+                     0, 0);
+  other.ConsumeNext(RowBatchBuilder(input_rd, 3, /*eow*/ false, /*eos*/ false)
+                        .AddColumn<types::StringValue>({"abc", "ijk", "def"})
+                        .AddColumn<types::Int64Value>({2, 1, 3})
+                        .AddColumn<types::Int64Value>({3, 1, 8})
+                        .get(),
+                    0, 0);
+  // The keys of the new groups are copied, so they outlive the other node.
+  EXPECT_OK(tester.node()->MergeGroupsFrom(exec_state_.get(), other.node()));
+  other.Close();
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 0, true, true)
+                       .AddColumn<types::StringValue>({})
+                       .AddColumn<types::Int64Value>({})
+                       .AddColumn<types::Int64Value>({})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 5, true, true)
+                          .AddColumn<types::StringValue>({"abc", "def", "abc", "ijk", "def"})
+                          .AddColumn<types::Int64Value>({2, 1, 3, 1, 3})
+                          .AddColumn<types::Int64Value>({4, 1, 3, 1, 3})
+                          .get(),
+                      false)
+      .Close();
+}
+
+TEST_F(AggNodeTest, merge_partitioned) {
+  auto plan_node = PlanNodeFromPbtxt(kBlockingSingleGroupAgg);
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  auto other = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester.ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                         .AddColumn<types::Int64Value>({1, 1, 2, 2})
+                         .AddColumn<types::Int64Value>({2, 3, 3, 1})
+                         .get(),
+                     0, 0);
+  other.ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                        .AddColumn<types::Int64Value>({5, 6, 3, 2})
+                        .AddColumn<types::Int64Value>({1, 5, 3, 8})
+                        .get(),
+                    0, 0);
+  // Each node merges one partition of the groups of both, the other node's goes to the tester.
+  std::vector<AggNode*> nodes{tester.node(), other.node()};
+  EXPECT_TRUE(tester.node()->SupportsPartitionedMerge());
+  EXPECT_OK(tester.node()->PartitionGroups(exec_state_.get(), 2));
+  EXPECT_OK(other.node()->PartitionGroups(exec_state_.get(), 2));
+  EXPECT_OK(tester.node()->MergePartitionFrom(exec_state_.get(), nodes, 0));
+  EXPECT_OK(other.node()->MergePartitionFrom(exec_state_.get(), nodes, 1));
+  ASSERT_OK_AND_ASSIGN(auto other_output, other.node()->TakePartitionOutput(exec_state_.get()));
+  tester.node()->AddPartitionOutput(std::move(other_output));
+  other.Close();
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 1, true, true)
+                       .AddColumn<types::Int64Value>({4})
+                       .AddColumn<types::Int64Value>({8})
+                       .get(),
+                   0, 2)
+      .ExpectRowBatchesData(RowBatchBuilder(output_rd, 6, true, true)
+                                .AddColumn<types::Int64Value>({1, 2, 3, 4, 5, 6})
+                                .AddColumn<types::Int64Value>({2, 5, 3, 4, 1, 5})
+                                .get(),
+                            2)
+      .Close();
+}
+
+TEST_F(AggNodeTest, merge_partitioned_row_tuple) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_columnar_group_by, false);
+  auto plan_node = PlanNodeFromPbtxt(kBlockingMultipleGroupAgg);
+  RowDescriptor input_rd({types::DataType::STRING, types::DataType::INT64, types::DataType::INT64});
+
+  RowDescriptor output_rd(
+      {types::DataType::STRING, types::DataType::INT64, types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  auto other = exec::ExecNodeTester<AggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+
+  tester.ConsumeNext(RowBatchBuilder(input_rd, 3, /*eow*/ false, /*eos*/ false)
+                         .AddColumn<types::StringValue>({"abc", "def", "abc"})
+                         .AddColumn<types::Int64Value>({2, 1, 3})
+                         .AddColumn<types::Int64Value>({2, 5, 3})
+                         .get(),
+                     0, 0);
+  other.ConsumeNext(RowBatchBuilder(input_rd, 3, /*eow*/ false, /*eos*/ false)
+                        .AddColumn<types::StringValue>({"abc", "ijk", "def"})
+                        .AddColumn<types::Int64Value>({2, 1, 3})
+                        .AddColumn<types::Int64Value>({3, 1, 8})
+                        .get(),
+                    0, 0);
+  std::vector<AggNode*> nodes{tester.node(), other.node()};
+  EXPECT_OK(tester.node()->PartitionGroups(exec_state_.get(), 2));
+  EXPECT_OK(other.node()->PartitionGroups(exec_state_.get(), 2));
+  EXPECT_OK(tester.node()->MergePartitionFrom(exec_state_.get(), nodes, 0));
+  EXPECT_OK(other.node()->MergePartitionFrom(exec_state_.get(), nodes, 1));
+  ASSERT_OK_AND_ASSIGN(auto other_output, other.node()->TakePartitionOutput(exec_state_.get()));
+  tester.node()->AddPartitionOutput(std::move(other_output));
+  // The output of the partition doesn't depend on the other node once it's taken.
+  other.Close();
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 0, true, true)
+                       .AddColumn<types::StringValue>({})
+                       .AddColumn<types::Int64Value>({})
+                       .AddColumn<types::Int64Value>({})
+                       .get(),
+                   0, 2)
+      .ExpectRowBatchesData(RowBatchBuilder(output_rd, 5, true, true)
+                                .AddColumn<types::StringValue>({"abc", "def", "abc", "ijk", "def"})
+                                .AddColumn<types::Int64Value>({2, 1, 3, 1, 3})
+                                .AddColumn<types::Int64Value>({4, 1, 3, 1, 3})
+                                .get(),
+                            2)
+      .Close();
+}
+
 TEST_F(AggNodeTest, no_groups_partial) {
   auto plan_node = PlanNodeFromPbtxt(kPartialNoGroupAgg);
   RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/arena_memory_pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+DEFINE_bool(carnot_query_arena, gflags::BoolFromEnv("PL_CARNOT_QUERY_ARENA", true),
+            "Whether each query allocates its arrow buffers from its own memory arena.");
+DEFINE_int64(carnot_query_arena_chunk_size,
+             gflags::Int64FromEnv("PL_CARNOT_QUERY_ARENA_CHUNK_SIZE", 1024 * 1024),
+             "The size of the chunks that the per query memory arena allocates at once.");
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+namespace {
+
+// Arrow expects buffers to be aligned to 64 bytes.
+constexpr int64_t kAlignment = 64;
+alignas(kAlignment) uint8_t zero_size_area[1];
+
+int64_t RoundUpToAlignment(int64_t size) { return (size + kAlignment - 1) & ~(kAlignment - 1); }
+
+}  // namespace
+
+void ArenaMemoryPoolReleaser::operator()(ArenaMemoryPool* pool) const { pool->Release(); }
+
+ArenaMemoryPool::Ptr ArenaMemoryPool::Create(int64_t chunk_size, arrow::MemoryPool* backing_pool) {
+  return Ptr(new ArenaMemoryPool(RoundUpToAlignment(chunk_size), backing_pool));
+}
+
+ArenaMemoryPool::~ArenaMemoryPool() {
+  DCHECK_EQ(0, refs_.load());
+  absl::MutexLock lock(&chunks_lock_);
+  while (!chunks_.empty()) {
+    FreeChunk(&chunks_.begin()->second);
+  }
+}
+
+void ArenaMemoryPool::Release() { Unref(); }
+
+void ArenaMemoryPool::Unref() {
+  if (refs_.fetch_sub(1) == 1) {
+    delete this;
+  }
+}
+
+ArenaMemoryPool::Shard* ArenaMemoryPool::ThreadShard() {
+  static std::atomic<int> next_shard = 0;
+  thread_local int shard = next_shard.fetch_add(1) % kNumShards;
+  return &shards_[shard];
+}
+
+ArenaMemoryPool::Chunk* ArenaMemoryPool::FindChunk(uint8_t* ptr) {
+  auto addr = reinterpret_cast<uintptr_t>(ptr);
+  auto it = chunks_.upper_bound(addr);
+  if (it == chunks_.begin()) {
+    return nullptr;
+  }
+  --it;
+  auto& chunk = it->second;
+  if (addr >= it->first + chunk.size) {
+    return nullptr;
+  }
+  return &chunk;
+}
+
+void ArenaMemoryPool::FreeChunk(Chunk* chunk) {
+  bytes_reserved_ -= chunk->size;
+  backing_pool_->Free(chunk->data, chunk->size);
+  chunks_.erase(reinterpret_cast<uintptr_t>(chunk->data));
+}
+
+arrow::Status ArenaMemoryPool::NewChunk(Shard* shard) {
+  uint8_t* data = nullptr;
+  ARROW_RETURN_NOT_OK(backing_pool_->Allocate(chunk_size_, &data));
+  bytes_reserved_ += chunk_size_;
+
+  absl::MutexLock lock(&chunks_lock_);
+  if (shard->current != nullptr) {
+    // Frees of the chunk's allocations return it from now on, see Free.
+    shard->current->current = false;
+    if (shard->current->live_allocations == 0) {
+      FreeChunk(shard->current);
+    }
+  }
+  auto& chunk = chunks_[reinterpret_cast<uintptr_t>(data)];
+  chunk.data = data;
+  chunk.size = chunk_size_;
+  chunk.current = true;
+  shard->current = &chunk;
+  return arrow::Status::OK();
+}
+
+void ArenaMemoryPool::UpdateBytesAllocated(int64_t delta) {
+  int64_t allocated = bytes_allocated_.fetch_add(delta) + delta;
+  int64_t max_allocated = max_bytes_allocated_.load();
+  while (allocated > max_allocated &&
+         !max_bytes_allocated_.compare_exchange_weak(max_allocated, allocated)) {
+  }
+}
+
+arrow::Status ArenaMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  if (size < 0) {
+    return arrow::Status::Invalid("negative malloc size");
+  }
+  if (size == 0) {
+    *out = zero_size_area;
+    return arrow::Status::OK();
+  }
+  int64_t aligned_size = RoundUpToAlignment(size);
+  if (aligned_size > chunk_size_ / 4) {
+    // Large allocations would waste too much of a chunk, so they come from the backing pool.
+    ARROW_RETURN_NOT_OK(backing_pool_->Allocate(size, out));
+    bytes_reserved_ += size;
+  } else {
+    Shard* shard = ThreadShard();
+    absl::base_internal::SpinLockHolder lock(&shard->lock);
+    Chunk* chunk = shard->current;
+    if (chunk != nullptr && chunk->used + aligned_size > chunk->size &&
+        chunk->live_allocations == 0) {
+      // Start over from the beginning of the chunk instead of taking a new one.
+      chunk->used = 0;
+      chunk->last_offset = -1;
+    }
+    if (chunk == nullptr || chunk->used + aligned_size > chunk->size) {
+      ARROW_RETURN_NOT_OK(NewChunk(shard));
+      chunk = shard->current;
+    }
+    *out = chunk->data + chunk->used;
+    chunk->last_offset = chunk->used;
+    chunk->used += aligned_size;
+    chunk->live_allocations++;
+  }
+  refs_++;
+  UpdateBytesAllocated(size);
+  return arrow::Status::OK();
+}
+
+arrow::Status ArenaMemoryPool::Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  if (*ptr != zero_size_area && new_size > 0) {
+    // Builders grow the buffer they most recently allocated, from the same thread, which can
+    // usually be done in place.
+    Shard* shard = ThreadShard();
+    absl::base_internal::SpinLockHolder lock(&shard->lock);
+    Chunk* chunk = shard->current;
+    if (chunk != nullptr && chunk->last_offset >= 0 && *ptr == chunk->data + chunk->last_offset &&
+        chunk->last_offset + RoundUpToAlignment(new_size) <= chunk->size) {
+      chunk->used = chunk->last_offset + RoundUpToAlignment(new_size);
+      UpdateBytesAllocated(new_size - old_size);
+      return arrow::Status::OK();
+    }
+  }
+  uint8_t* out = nullptr;
+  ARROW_RETURN_NOT_OK(Allocate(new_size, &out));
+  if (old_size > 0 && new_size > 0) {
+    std::memcpy(out, *ptr, std::min(old_size, new_size));
+  }
+  Free(*ptr, old_size);
+  *ptr = out;
+  return arrow::Status::OK();
+}
+
+void ArenaMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  if (buffer == zero_size_area) {
+    return;
+  }
+  Chunk* empty_chunk = nullptr;
+  {
+    absl::ReaderMutexLock lock(&chunks_lock_);
+    Chunk* chunk = FindChunk(buffer);
+    if (chunk == nullptr) {
+      backing_pool_->Free(buffer, size);
+      bytes_reserved_ -= size;
+    } else if (--chunk->live_allocations == 0 && !chunk->current) {
+      // Nothing allocates from a chunk that isn't current, so this is the last use of it. The
+      // current chunks are reused or returned by their shard instead.
+      empty_chunk = chunk;
+    }
+  }
+  if (empty_chunk != nullptr) {
+    absl::MutexLock lock(&chunks_lock_);
+    FreeChunk(empty_chunk);
+  }
+  UpdateBytesAllocated(-size);
+  Unref();
+}
+
+int64_t ArenaMemoryPool::bytes_allocated() const { return bytes_allocated_; }
+
+int64_t ArenaMemoryPool::max_memory() const { return max_bytes_allocated_; }
+
+int64_t ArenaMemoryPool::bytes_reserved() const { return bytes_reserved_; }
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/memory_pool.h>
+#include <arrow/status.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+
+#include <absl/base/internal/spinlock.h>
+#include <absl/base/thread_annotations.h>
+#include <absl/synchronization/mutex.h>
+
+#include "src/common/base/base.h"
+
+DECLARE_bool(carnot_query_arena);
+DECLARE_int64(carnot_query_arena_chunk_size);
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+class ArenaMemoryPool;
+
+struct ArenaMemoryPoolReleaser {
+  void operator()(ArenaMemoryPool* pool) const;
+};
+
+/**
+ * ArenaMemoryPool is an arrow::MemoryPool for the allocations of a single query. Allocations are
+ * bumped out of large chunks taken from a backing pool, which keeps the many small buffers made
+ * while executing a query from contending on (and fragmenting) the process wide allocator.
+ *
+ * The threads of a query bump their allocations out of different chunks: each thread allocates
+ * from the current chunk of its shard, so only taking a new chunk from the backing pool locks the
+ * whole pool. Frees find the chunk of a buffer under a shared lock.
+ *
+ * Individual frees only update the bookkeeping. A chunk goes back to the backing pool once all of
+ * its allocations are freed and it isn't the chunk being allocated from, and all remaining chunks
+ * are returned when the query releases the pool.
+ *
+ * Buffers made by a query can outlive it (e.g. batches still referenced by the caller when the
+ * query is torn down). So the owner never deletes the pool directly: releasing it deletes the pool
+ * right away if nothing is allocated anymore, and otherwise once the last buffer is freed. Long
+ * lived buffers would pin whole chunks though, so MemorySinks copy their batches out of the arena
+ * before writing them to the table store.
+ */
+class ArenaMemoryPool final : public arrow::MemoryPool {
+ public:
+  using Ptr = std::unique_ptr<ArenaMemoryPool, ArenaMemoryPoolReleaser>;
+
+  /**
+   * Create makes a new pool.
+   * @param chunk_size, the size of the chunks allocated from the backing pool. Allocations larger
+   * than a quarter of a chunk go straight to the backing pool.
+   * @param backing_pool, where the chunks come from.
+   */
+  static Ptr Create(int64_t chunk_size = FLAGS_carnot_query_arena_chunk_size,
+                    arrow::MemoryPool* backing_pool = arrow::default_memory_pool());
+
+  arrow::Status Allocate(int64_t size, uint8_t** out) override;
+  arrow::Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  /**
+   * @return the number of bytes currently allocated out of the pool.
+   */
+  int64_t bytes_allocated() const override;
+
+  /**
+   * @return the largest number of bytes that were allocated out of the pool at any one time.
+   */
+  int64_t max_memory() const override;
+
+  /**
+   * @return the number of bytes currently taken from the backing pool, including the unused space
+   * of the chunks.
+   */
+  int64_t bytes_reserved() const;
+
+ private:
+  friend struct ArenaMemoryPoolReleaser;
+
+  // The number of chunks that are allocated from at the same time. Threads are assigned a shard
+  // round robin, so up to this many threads don't share a chunk.
+  static constexpr int kNumShards = 16;
+
+  struct Chunk {
+    uint8_t* data = nullptr;
+    int64_t size = 0;
+    // Offset of the next allocation in the chunk. Guarded by the lock of the shard that the chunk
+    // is current in, and only ever changed while it is current.
+    int64_t used = 0;
+    // Offset of the last allocation in the chunk, so that it can be grown in place. Guarded like
+    // used.
+    int64_t last_offset = -1;
+    // Number of allocations in the chunk that haven't been freed yet.
+    std::atomic<int64_t> live_allocations = 0;
+    // Whether the chunk is the current chunk of a shard. Guarded by chunks_lock_.
+    bool current = false;
+  };
+
+  struct alignas(64) Shard {
+    absl::base_internal::SpinLock lock;
+    Chunk* current ABSL_GUARDED_BY(lock) = nullptr;
+  };
+
+  ArenaMemoryPool(int64_t chunk_size, arrow::MemoryPool* backing_pool)
+      : chunk_size_(chunk_size), backing_pool_(backing_pool) {}
+  ~ArenaMemoryPool() override;
+
+  // Called by the owner of the pool, see the class comment.
+  void Release();
+  // Drops a reference to the pool, deleting it once the owner released it and all of its
+  // allocations are freed.
+  void Unref();
+
+  Shard* ThreadShard();
+  // Replaces the current chunk of the shard with a new one from the backing pool.
+  arrow::Status NewChunk(Shard* shard) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard->lock);
+  // Returns the chunk containing ptr, or nullptr if ptr was allocated from the backing pool.
+  Chunk* FindChunk(uint8_t* ptr) ABSL_SHARED_LOCKS_REQUIRED(chunks_lock_);
+  void FreeChunk(Chunk* chunk) ABSL_EXCLUSIVE_LOCKS_REQUIRED(chunks_lock_);
+  void UpdateBytesAllocated(int64_t delta);
+
+  const int64_t chunk_size_;
+  arrow::MemoryPool* const backing_pool_;
+
+  Shard shards_[kNumShards];
+
+  mutable absl::Mutex chunks_lock_;
+  // Chunks keyed by their start address.
+  std::map<uintptr_t, Chunk> chunks_ ABSL_GUARDED_BY(chunks_lock_);
+
+  // One reference for each live allocation, and one for the owner until it releases the pool.
+  std::atomic<int64_t> refs_ = 1;
+  std::atomic<int64_t> bytes_allocated_ = 0;
+  std::atomic<int64_t> max_bytes_allocated_ = 0;
+  std::atomic<int64_t> bytes_reserved_ = 0;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
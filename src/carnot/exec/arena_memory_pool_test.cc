@@ -0,0 +1,172 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "src/carnot/exec/arena_memory_pool.h"
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+class ArenaMemoryPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override { pool_ = ArenaMemoryPool::Create(4096, &backing_pool_); }
+
+  arrow::ProxyMemoryPool backing_pool_{arrow::default_memory_pool()};
+  ArenaMemoryPool::Ptr pool_;
+};
+
+TEST_F(ArenaMemoryPoolTest, allocate_and_free) {
+  std::vector<uint8_t*> buffers;
+  for (int i = 0; i < 100; ++i) {
+    uint8_t* buf = nullptr;
+    ASSERT_TRUE(pool_->Allocate(100, &buf).ok());
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(buf) % 64);
+    buffers.push_back(buf);
+  }
+  EXPECT_EQ(100 * 100, pool_->bytes_allocated());
+  // Allocations are bumped out of chunks of 4096 bytes.
+  EXPECT_EQ(backing_pool_.bytes_allocated(), pool_->bytes_reserved());
+  EXPECT_EQ(0, pool_->bytes_reserved() % 4096);
+
+  for (auto* buf : buffers) {
+    pool_->Free(buf, 100);
+  }
+  EXPECT_EQ(0, pool_->bytes_allocated());
+  EXPECT_EQ(100 * 100, pool_->max_memory());
+  // Only the chunk being allocated from is kept around.
+  EXPECT_EQ(4096, pool_->bytes_reserved());
+  EXPECT_EQ(4096, backing_pool_.bytes_allocated());
+}
+
+TEST_F(ArenaMemoryPoolTest, reallocate_in_place) {
+  uint8_t* buf = nullptr;
+  ASSERT_TRUE(pool_->Allocate(64, &buf).ok());
+  buf[0] = 42;
+  uint8_t* orig = buf;
+  ASSERT_TRUE(pool_->Reallocate(64, 512, &buf).ok());
+  EXPECT_EQ(orig, buf);
+  EXPECT_EQ(512, pool_->bytes_allocated());
+
+  // Once another allocation follows it, the buffer has to be moved.
+  uint8_t* other = nullptr;
+  ASSERT_TRUE(pool_->Allocate(64, &other).ok());
+  ASSERT_TRUE(pool_->Reallocate(512, 1024, &buf).ok());
+  EXPECT_NE(orig, buf);
+  EXPECT_EQ(42, buf[0]);
+  EXPECT_EQ(1024 + 64, pool_->bytes_allocated());
+
+  pool_->Free(buf, 1024);
+  pool_->Free(other, 64);
+  EXPECT_EQ(0, pool_->bytes_allocated());
+}
+
+TEST_F(ArenaMemoryPoolTest, large_allocations) {
+  uint8_t* buf = nullptr;
+  ASSERT_TRUE(pool_->Allocate(2000, &buf).ok());
+  EXPECT_EQ(2000, pool_->bytes_reserved());
+  EXPECT_EQ(2000, backing_pool_.bytes_allocated());
+  pool_->Free(buf, 2000);
+  EXPECT_EQ(0, pool_->bytes_reserved());
+  EXPECT_EQ(0, backing_pool_.bytes_allocated());
+}
+
+TEST_F(ArenaMemoryPoolTest, arrow_builder) {
+  arrow::Int64Builder builder(pool_.get());
+  for (int64_t i = 0; i < 10000; ++i) {
+    ASSERT_TRUE(builder.Append(i).ok());
+  }
+  std::shared_ptr<arrow::Array> arr;
+  ASSERT_TRUE(builder.Finish(&arr).ok());
+  EXPECT_EQ(9999, std::static_pointer_cast<arrow::Int64Array>(arr)->Value(9999));
+  EXPECT_GE(pool_->max_memory(), 10000 * static_cast<int64_t>(sizeof(int64_t)));
+  arr.reset();
+  EXPECT_EQ(0, pool_->bytes_allocated());
+}
+
+TEST_F(ArenaMemoryPoolTest, release_with_live_buffers) {
+  uint8_t* small = nullptr;
+  uint8_t* large = nullptr;
+  ASSERT_TRUE(pool_->Allocate(100, &small).ok());
+  ASSERT_TRUE(pool_->Allocate(2000, &large).ok());
+  auto* pool = pool_.get();
+
+  // The buffers outlive the owner of the pool.
+  pool_.reset();
+  EXPECT_EQ(4096 + 2000, backing_pool_.bytes_allocated());
+  pool->Free(small, 100);
+  EXPECT_EQ(4096 + 2000, backing_pool_.bytes_allocated());
+  // The last free deletes the pool, returning all of its memory.
+  pool->Free(large, 2000);
+  EXPECT_EQ(0, backing_pool_.bytes_allocated());
+}
+
+TEST_F(ArenaMemoryPoolTest, release_unused) {
+  uint8_t* buf = nullptr;
+  ASSERT_TRUE(pool_->Allocate(100, &buf).ok());
+  pool_->Free(buf, 100);
+  EXPECT_EQ(4096, backing_pool_.bytes_allocated());
+  pool_.reset();
+  EXPECT_EQ(0, backing_pool_.bytes_allocated());
+}
+
+TEST_F(ArenaMemoryPoolTest, threaded) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumBuffers = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([this, t]() {
+      std::vector<uint8_t*> buffers;
+      for (int i = 0; i < kNumBuffers; ++i) {
+        uint8_t* buf = nullptr;
+        ASSERT_TRUE(pool_->Allocate(100, &buf).ok());
+        std::memset(buf, t, 100);
+        if (i % 2 == 0) {
+          ASSERT_TRUE(pool_->Reallocate(100, 200, &buf).ok());
+          std::memset(buf, t, 200);
+        }
+        buffers.push_back(buf);
+      }
+      // No other thread wrote over the buffers of this one.
+      for (auto [i, buf] : Enumerate(buffers)) {
+        int64_t size = i % 2 == 0 ? 200 : 100;
+        for (int64_t j = 0; j < size; ++j) {
+          ASSERT_EQ(t, buf[j]);
+        }
+        pool_->Free(buf, size);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(0, pool_->bytes_allocated());
+  EXPECT_EQ(backing_pool_.bytes_allocated(), pool_->bytes_reserved());
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/coalesce_node.h"
+
+#include <arrow/array/concatenate.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+
+DEFINE_int64(carnot_coalesce_target_rows,
+             gflags::Int64FromEnv("PL_CARNOT_COALESCE_TARGET_ROWS", 1024),
+             "The number of rows that the batches between a filter and a sink are combined up "
+             "to.");
+DEFINE_int64(carnot_coalesce_target_bytes,
+             gflags::Int64FromEnv("PL_CARNOT_COALESCE_TARGET_BYTES", 256 * 1024),
+             "The number of bytes that the batches between a filter and a sink are combined up "
+             "to.");
+DEFINE_int64(carnot_coalesce_max_delay_ms,
+             gflags::Int64FromEnv("PL_CARNOT_COALESCE_MAX_DELAY_MS", 100),
+             "How long rows between a filter and a sink can be held to be combined with later "
+             "ones.");
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+std::string CoalesceNode::DebugStringImpl() {
+  return absl::Substitute("Exec::CoalesceNode<target_rows=$0, target_bytes=$1>", target_rows_,
+                          target_bytes_);
+}
+
+Status CoalesceNode::InitImpl(const plan::Operator&) { return Status::OK(); }
+
+Status CoalesceNode::PrepareImpl(ExecState*) { return Status::OK(); }
+
+Status CoalesceNode::OpenImpl(ExecState*) { return Status::OK(); }
+
+Status CoalesceNode::CloseImpl(ExecState*) {
+  held_batches_.clear();
+  held_rows_ = 0;
+  held_bytes_ = 0;
+  return Status::OK();
+}
+
+bool CoalesceNode::ShouldFlush(const RowBatch& rb) const {
+  if (rb.eow() || held_rows_ >= target_rows_ || held_bytes_ >= target_bytes_) {
+    return true;
+  }
+  return Expired();
+}
+
+bool CoalesceNode::Expired() const {
+  return held_rows_ > 0 && std::chrono::steady_clock::now() - held_since_ >= max_delay_;
+}
+
+Status CoalesceNode::FlushIfExpired(ExecState* exec_state) {
+  if (!Expired()) {
+    return Status::OK();
+  }
+  return Flush(exec_state, /* eow */ false, /* eos */ false);
+}
+
+Status CoalesceNode::Flush(ExecState* exec_state, bool eow, bool eos) {
+  if (held_batches_.empty()) {
+    PX_ASSIGN_OR_RETURN(auto rb, RowBatch::WithZeroRows(*output_descriptor_, eow, eos));
+    return SendRowBatchToChildren(exec_state, *rb);
+  }
+
+  RowBatch output = held_batches_.front();
+  if (held_batches_.size() > 1) {
+    output = RowBatch(*output_descriptor_, held_rows_);
+    for (int64_t col = 0; col < output.num_columns(); ++col) {
+      arrow::ArrayVector arrays;
+      arrays.reserve(held_batches_.size());
+      for (const auto& rb : held_batches_) {
+        arrays.push_back(rb.ColumnAt(col));
+      }
+      std::shared_ptr<arrow::Array> column;
+      PX_RETURN_IF_ERROR(arrow::Concatenate(arrays, exec_state->exec_mem_pool(), &column));
+      PX_RETURN_IF_ERROR(output.AddColumn(column));
+    }
+  }
+  output.set_eow(eow);
+  output.set_eos(eos);
+
+  held_batches_.clear();
+  held_rows_ = 0;
+  held_bytes_ = 0;
+  return SendOutput(exec_state, output);
+}
+
+Status CoalesceNode::SendOutput(ExecState* exec_state, const RowBatch& rb) {
+  auto* metrics = exec_state->exec_metrics();
+  if (metrics != nullptr && rb.num_rows() > 0) {
+    metrics->coalesced_batch_rows.Observe(rb.num_rows());
+    metrics->coalesced_batch_bytes.Observe(rb.NumBytes());
+  }
+  return SendRowBatchToChildren(exec_state, rb);
+}
+
+Status CoalesceNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  // Batches that are already big enough on their own go through as they are, once the rows that
+  // arrived before them are sent.
+  bool large = rb.num_rows() >= target_rows_ || rb.NumBytes() >= target_bytes_;
+  if (large && !held_batches_.empty()) {
+    PX_RETURN_IF_ERROR(Flush(exec_state, /* eow */ false, /* eos */ false));
+  }
+  if (large) {
+    return SendOutput(exec_state, rb);
+  }
+
+  if (rb.num_rows() > 0) {
+    if (held_batches_.empty()) {
+      held_since_ = std::chrono::steady_clock::now();
+    }
+    held_batches_.push_back(rb);
+    held_rows_ += rb.num_rows();
+    held_bytes_ += rb.NumBytes();
+  }
+  if (!ShouldFlush(rb)) {
+    return Status::OK();
+  }
+  // Empty batches are only forwarded when they end a window.
+  if (held_batches_.empty() && !rb.eow()) {
+    return Status::OK();
+  }
+  return Flush(exec_state, rb.eow(), rb.eos());
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/plan/operators.h"
+#include "src/common/base/base.h"
+#include "src/table_store/schema/row_batch.h"
+
+DECLARE_int64(carnot_coalesce_target_rows);
+DECLARE_int64(carnot_coalesce_target_bytes);
+DECLARE_int64(carnot_coalesce_max_delay_ms);
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * CoalesceNode combines the small row batches of its input into larger ones, so that its children
+ * pay their per-batch overhead less often. It isn't part of the plan: the execution graph inserts
+ * it where selective filters feed a sink.
+ *
+ * Rows are held until they reach the target number of rows or bytes, the end of a window, or until
+ * the oldest held row has waited for the max delay. The delay is checked when a batch arrives, and
+ * by the execution graph through FlushIfExpired whenever it runs its sources or yields for more
+ * data, so held rows are sent even if no more input arrives.
+ */
+class CoalesceNode : public ProcessingNode {
+ public:
+  CoalesceNode(int64_t target_rows, int64_t target_bytes, std::chrono::milliseconds max_delay)
+      : target_rows_(target_rows), target_bytes_(target_bytes), max_delay_(max_delay) {}
+  CoalesceNode()
+      : CoalesceNode(FLAGS_carnot_coalesce_target_rows, FLAGS_carnot_coalesce_target_bytes,
+                     std::chrono::milliseconds(FLAGS_carnot_coalesce_max_delay_ms)) {}
+  virtual ~CoalesceNode() = default;
+
+  /**
+   * FlushIfExpired sends the held rows if the oldest of them has waited for the max delay.
+   */
+  Status FlushIfExpired(ExecState* exec_state);
+
+  /**
+   * FlushDeadline returns when the held rows have to be sent, or std::nullopt if no rows are held.
+   */
+  std::optional<std::chrono::steady_clock::time_point> FlushDeadline() const {
+    if (held_rows_ == 0) {
+      return std::nullopt;
+    }
+    return held_since_ + max_delay_;
+  }
+
+ protected:
+  std::string DebugStringImpl() override;
+  Status InitImpl(const plan::Operator& plan_node) override;
+  Status PrepareImpl(ExecState* exec_state) override;
+  Status OpenImpl(ExecState* exec_state) override;
+  Status CloseImpl(ExecState* exec_state) override;
+  Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                         size_t parent_index) override;
+
+ private:
+  bool ShouldFlush(const table_store::schema::RowBatch& rb) const;
+  bool Expired() const;
+  // Sends the held rows as a single batch, with the eow/eos of the last input batch.
+  Status Flush(ExecState* exec_state, bool eow, bool eos);
+  // Records the size of an output batch in the exec metrics, and sends it to the children.
+  Status SendOutput(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+
+  const int64_t target_rows_;
+  const int64_t target_bytes_;
+  const std::chrono::milliseconds max_delay_;
+
+  std::vector<table_store::schema::RowBatch> held_batches_;
+  int64_t held_rows_ = 0;
+  int64_t held_bytes_ = 0;
+  // When the oldest held batch arrived.
+  std::chrono::steady_clock::time_point held_since_;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/coalesce_node.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/planpb/test_proto.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowDescriptor;
+using types::Int64Value;
+using types::StringValue;
+
+class CoalesceNodeTest : public ::testing::Test {
+ public:
+  CoalesceNodeTest() {
+    auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+    plan_node_ = std::make_unique<plan::GRPCSinkOperator>(1);
+    EXPECT_OK(plan_node_->Init(op_proto.grpc_sink_op()));
+
+    func_registry_ = std::make_unique<udf::Registry>("test_registry");
+    auto table_store = std::make_shared<table_store::TableStore>();
+    exec_state_ = std::make_unique<ExecState>(func_registry_.get(), table_store,
+                                              MockResultSinkStubGenerator, MockMetricsStubGenerator,
+                                              MockTraceStubGenerator, sole::uuid4(), nullptr);
+  }
+
+ protected:
+  std::unique_ptr<plan::GRPCSinkOperator> plan_node_;
+  std::unique_ptr<ExecState> exec_state_;
+  std::unique_ptr<udf::Registry> func_registry_;
+};
+
+TEST_F(CoalesceNodeTest, combines_small_batches) {
+  RowDescriptor rd({types::DataType::INT64, types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<CoalesceNode, plan::GRPCSinkOperator>(
+      *plan_node_, rd, {rd}, exec_state_.get(), /* target_rows */ 4, /* target_bytes */ 1 << 20,
+      std::chrono::hours(1));
+  tester
+      .ConsumeNext(RowBatchBuilder(rd, 2, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({1, 2})
+                       .AddColumn<StringValue>({"a", "b"})
+                       .get(),
+                   0, 0)
+      // Empty batches are dropped.
+      .ConsumeNext(RowBatchBuilder(rd, 0, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({})
+                       .AddColumn<StringValue>({})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(rd, 1, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({3})
+                       .AddColumn<StringValue>({"c"})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(rd, 2, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({4, 5})
+                       .AddColumn<StringValue>({"d", "e"})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(rd, 5, /*eow*/ false, /*eos*/ false)
+                          .AddColumn<Int64Value>({1, 2, 3, 4, 5})
+                          .AddColumn<StringValue>({"a", "b", "c", "d", "e"})
+                          .get())
+      .ConsumeNext(RowBatchBuilder(rd, 1, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({6})
+                       .AddColumn<StringValue>({"f"})
+                       .get(),
+                   0, 0)
+      // The end of the stream sends whatever is held.
+      .ConsumeNext(RowBatchBuilder(rd, 0, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({})
+                       .AddColumn<StringValue>({})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(rd, 1, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Int64Value>({6})
+                          .AddColumn<StringValue>({"f"})
+                          .get())
+      .Close();
+}
+
+TEST_F(CoalesceNodeTest, large_batch_passes_through) {
+  RowDescriptor rd({types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<CoalesceNode, plan::GRPCSinkOperator>(
+      *plan_node_, rd, {rd}, exec_state_.get(), /* target_rows */ 3, /* target_bytes */ 1 << 20,
+      std::chrono::hours(1));
+  tester
+      .ConsumeNext(RowBatchBuilder(rd, 1, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({1})
+                       .get(),
+                   0, 0)
+      // The held row is sent first, so the order of the rows is kept.
+      .ConsumeNext(RowBatchBuilder(rd, 3, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({2, 3, 4})
+                       .get(),
+                   0, 2)
+      .ExpectRowBatch(RowBatchBuilder(rd, 1, /*eow*/ false, /*eos*/ false)
+                          .AddColumn<Int64Value>({1})
+                          .get())
+      .ExpectRowBatch(RowBatchBuilder(rd, 3, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Int64Value>({2, 3, 4})
+                          .get())
+      .Close();
+}
+
+TEST_F(CoalesceNodeTest, max_delay) {
+  RowDescriptor rd({types::DataType::INT64});
+
+  auto tester = exec::ExecNodeTester<CoalesceNode, plan::GRPCSinkOperator>(
+      *plan_node_, rd, {rd}, exec_state_.get(), /* target_rows */ 100, /* target_bytes */ 1 << 20,
+      std::chrono::milliseconds(0));
+  // Without any delay, every batch with rows is sent as soon as it arrives.
+  tester
+      .ConsumeNext(RowBatchBuilder(rd, 1, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({1})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(rd, 1, /*eow*/ false, /*eos*/ false)
+                          .AddColumn<Int64Value>({1})
+                          .get())
+      .Close();
+}
+
+TEST_F(CoalesceNodeTest, max_delay_without_more_input) {
+  RowDescriptor rd({types::DataType::INT64});
+  auto flush_if_expired = [](CoalesceNode* node, ExecState* exec_state) {
+    return node->FlushIfExpired(exec_state);
+  };
+
+  auto tester = exec::ExecNodeTester<CoalesceNode, plan::GRPCSinkOperator>(
+      *plan_node_, rd, {rd}, exec_state_.get(), /* target_rows */ 100, /* target_bytes */ 1 << 20,
+      std::chrono::milliseconds(100));
+  tester
+      .ConsumeNext(RowBatchBuilder(rd, 2, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({1, 2})
+                       .get(),
+                   0, 0)
+      // Nothing is sent before the delay is up.
+      .CallOnNode(flush_if_expired, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  // The held rows go out once the delay is up, even though no other batch arrived.
+  tester.CallOnNode(flush_if_expired)
+      .ExpectRowBatch(RowBatchBuilder(rd, 2, /*eow*/ false, /*eos*/ false)
+                          .AddColumn<Int64Value>({1, 2})
+                          .get())
+      // Nothing is left to send.
+      .CallOnNode(flush_if_expired, 0)
+      .Close();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
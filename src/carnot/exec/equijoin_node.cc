@@ -112,32 +112,49 @@ Status EquijoinNode::InitImpl(const plan::Operator& plan_node) {
     selected_spec.output_col_indices.emplace_back(i);
   }
 
+  std::vector<types::DataType> spilled_build_types = key_data_types_;
+  spilled_build_spec_ = build_spec_;
+  spilled_build_spec_.key_indices.clear();
+  spilled_build_spec_.input_col_indices.clear();
+  for (size_t i = 0; i < key_data_types_.size(); ++i) {
+    spilled_build_spec_.key_indices.emplace_back(i);
+  }
+  for (const auto& dt : build_spec_.input_col_types) {
+    spilled_build_spec_.input_col_indices.emplace_back(spilled_build_types.size());
+    spilled_build_types.emplace_back(dt);
+  }
+  spilled_build_descriptor_ = std::make_unique<RowDescriptor>(spilled_build_types);
+
   return Status::OK();
 }
 
-Status EquijoinNode::InitializeColumnBuilders() {
+Status EquijoinNode::InitializeColumnBuilders(ExecState* exec_state) {
   for (size_t i = 0; i < output_descriptor_->size(); ++i) {
     column_builders_[i] =
-        MakeArrowBuilder(output_descriptor_->type(i), arrow::default_memory_pool());
+        MakeArrowBuilder(output_descriptor_->type(i), exec_state->exec_mem_pool());
     PX_RETURN_IF_ERROR(column_builders_[i]->Reserve(output_rows_per_batch_));
   }
   return Status::OK();
 }
 
-Status EquijoinNode::PrepareImpl(ExecState* /*exec_state*/) {
+Status EquijoinNode::PrepareImpl(ExecState* exec_state) {
   column_builders_.resize(output_descriptor_->size());
-  PX_RETURN_IF_ERROR(InitializeColumnBuilders());
+  PX_RETURN_IF_ERROR(InitializeColumnBuilders(exec_state));
 
   return Status::OK();
 }
 
 Status EquijoinNode::OpenImpl(ExecState* /*exec_state*/) { return Status::OK(); }
 
-Status EquijoinNode::CloseImpl(ExecState* /*exec_state*/) {
+Status EquijoinNode::CloseImpl(ExecState* exec_state) {
   join_keys_chunk_.clear();
   build_buffer_.clear();
   probed_keys_.clear();
   key_values_pool_.Clear();
+  build_partitions_.reset();
+  probe_partitions_.reset();
+  exec_state->spill_manager()->Release(reserved_bytes_);
+  reserved_bytes_ = 0;
   return Status::OK();
 }
 
@@ -151,11 +168,11 @@ void ExtractIntoRowTuples(std::vector<RowTuple*>* row_tuples, arrow::Array* inpu
 }
 
 Status EquijoinNode::ExtractJoinKeysForBatch(const table_store::schema::RowBatch& rb,
-                                             bool is_probe) {
+                                             const TableSpec& spec) {
   // Reset the row tuples
   for (auto& rt : join_keys_chunk_) {
     if (rt == nullptr) {
-      rt = key_values_pool_.Add(new RowTuple(&key_data_types_));
+      rt = key_values_pool_.Make<RowTuple>(&key_data_types_);
     } else {
       rt->Reset();
     }
@@ -167,13 +184,11 @@ Status EquijoinNode::ExtractJoinKeysForBatch(const table_store::schema::RowBatch
     int prev_size = join_keys_chunk_.size();
     join_keys_chunk_.reserve(num_rows);
     for (size_t idx = prev_size; idx < num_rows; ++idx) {
-      auto tuple_ptr = key_values_pool_.Add(new RowTuple(&key_data_types_));
+      auto tuple_ptr = key_values_pool_.Make<RowTuple>(&key_data_types_);
       join_keys_chunk_.emplace_back(tuple_ptr);
     }
   }
 
-  const TableSpec& spec = is_probe ? probe_spec_ : build_spec_;
-
   // Scan through all the group args in column order and extract the entire column.
   for (size_t tuple_col_idx = 0; tuple_col_idx < spec.key_indices.size(); ++tuple_col_idx) {
     auto input_col_idx = spec.key_indices[tuple_col_idx];
@@ -197,14 +212,15 @@ std::vector<types::SharedColumnWrapper>* CreateWrapper(ObjectPool* pool,
   return ptr;
 }
 
-Status EquijoinNode::HashRowBatch(const table_store::schema::RowBatch& rb) {
+Status EquijoinNode::HashRowBatch(const table_store::schema::RowBatch& rb,
+                                  const TableSpec& spec) {
   if (rb.num_rows() > static_cast<int64_t>(build_wrappers_chunk_.size())) {
     build_wrappers_chunk_.resize(rb.num_rows());
   }
   for (auto row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
     if (build_wrappers_chunk_[row_idx] == nullptr) {
       build_wrappers_chunk_[row_idx] =
-          CreateWrapper(&column_values_pool_, build_spec_.input_col_types);
+          CreateWrapper(&column_values_pool_, spec.input_col_types);
     }
   }
 
@@ -215,10 +231,10 @@ Status EquijoinNode::HashRowBatch(const table_store::schema::RowBatch& rb) {
     auto wrappers_ptr = current != nullptr ? current : build_wrappers_chunk_[row_idx];
 
     // Now extract the values into the corresponding column wrappers.
-    for (size_t i = 0; i < build_spec_.input_col_indices.size(); ++i) {
-      const auto& rb_col_idx = build_spec_.input_col_indices[i];
+    for (size_t i = 0; i < spec.input_col_indices.size(); ++i) {
+      const auto& rb_col_idx = spec.input_col_indices[i];
       auto arr = rb.ColumnAt(rb_col_idx).get();
-      const auto& dt = build_spec_.input_col_types[i];
+      const auto& dt = spec.input_col_types[i];
 
 #define TYPE_CASE(_dt_) \
   types::ExtractValueToColumnWrapper<_dt_>(wrappers_ptr->at(i).get(), arr, row_idx);
@@ -272,7 +288,7 @@ Status EquijoinNode::NextOutputBatch(ExecState* exec_state) {
   }
   pending_output_batch_.swap(output_batch);
 
-  return InitializeColumnBuilders();
+  return InitializeColumnBuilders(exec_state);
 }
 
 Status EquijoinNode::FlushChunkedRows(ExecState* exec_state) {
@@ -351,7 +367,7 @@ Status EquijoinNode::DoProbe(ExecState* exec_state, const table_store::schema::R
     probe_eos_ = true;
   }
 
-  PX_RETURN_IF_ERROR(ExtractJoinKeysForBatch(rb, true));
+  PX_RETURN_IF_ERROR(ExtractJoinKeysForBatch(rb, probe_spec_));
 
   if (rb.num_rows() > static_cast<int64_t>(probe_wrappers_chunk_.size())) {
     probe_wrappers_chunk_.resize(rb.num_rows());
@@ -410,15 +426,37 @@ Status EquijoinNode::EmitUnmatchedBuildRows(ExecState* exec_state) {
   return Status::OK();
 }
 
+const JoinRuntimeFilter* EquijoinNode::EnableRuntimeFilter() {
+  DCHECK(CanFilterProbe());
+  if (runtime_filter_ == nullptr) {
+    runtime_filter_ = std::make_unique<JoinRuntimeFilter>();
+  }
+  return runtime_filter_.get();
+}
+
 Status EquijoinNode::ConsumeBuildBatch(ExecState* exec_state,
                                        const table_store::schema::RowBatch& rb) {
   if (rb.eos()) {
     build_eos_ = true;
   }
 
-  PX_RETURN_IF_ERROR(ExtractJoinKeysForBatch(rb, false));
-  PX_RETURN_IF_ERROR(HashRowBatch(rb));
+  if (runtime_filter_ != nullptr) {
+    runtime_filter_->AddBuildKeys(rb, build_spec_.key_indices);
+    if (build_eos_) {
+      PX_RETURN_IF_ERROR(runtime_filter_->Finish());
+    }
+  }
+
+  if (build_partitions_ != nullptr) {
+    PX_ASSIGN_OR_RETURN(auto spilled_rb, ProjectSpilledBuildColumns(rb));
+    PX_RETURN_IF_ERROR(build_partitions_->Add(*spilled_rb));
+  } else {
+    PX_RETURN_IF_ERROR(ExtractJoinKeysForBatch(rb, build_spec_));
+    PX_RETURN_IF_ERROR(HashRowBatch(rb, build_spec_));
+    PX_RETURN_IF_ERROR(ReserveOrSpillBuild(exec_state, rb));
+  }
 
+  // Once spilled, the probe batches were partitioned instead of being queued.
   if (build_eos_) {
     while (probe_batches_.size()) {
       PX_RETURN_IF_ERROR(DoProbe(exec_state, probe_batches_.front()));
@@ -430,6 +468,12 @@ Status EquijoinNode::ConsumeBuildBatch(ExecState* exec_state,
 
 Status EquijoinNode::ConsumeProbeBatch(ExecState* exec_state,
                                        const table_store::schema::RowBatch& rb) {
+  if (probe_partitions_ != nullptr) {
+    if (rb.eos()) {
+      probe_eos_ = true;
+    }
+    return probe_partitions_->Add(rb);
+  }
   if (!build_eos_) {
     probe_batches_.push(rb);
     return Status::OK();
@@ -437,6 +481,175 @@ Status EquijoinNode::ConsumeProbeBatch(ExecState* exec_state,
   return DoProbe(exec_state, rb);
 }
 
+bool EquijoinNode::CanSpill(ExecState* exec_state) const {
+  // Joining the partitions one at a time would reorder the probe rows.
+  return exec_state->spill_manager()->enabled() && !plan_node_->order_by_time();
+}
+
+Status EquijoinNode::ReserveOrSpillBuild(ExecState* exec_state, const RowBatch& rb) {
+  if (!CanSpill(exec_state)) {
+    return Status::OK();
+  }
+  auto* spill_manager = exec_state->spill_manager();
+  // The build buffer holds a copy of the build columns of the batch.
+  int64_t bytes = rb.NumBytes();
+  if (spill_manager->TryReserve(bytes)) {
+    reserved_bytes_ += bytes;
+    return Status::OK();
+  }
+
+  build_partitions_ = std::make_unique<SpillPartitions>(
+      spill_manager, spilled_build_spec_.key_indices, /* depth */ 0);
+  probe_partitions_ =
+      std::make_unique<SpillPartitions>(spill_manager, probe_spec_.key_indices, /* depth */ 0);
+  PX_ASSIGN_OR_RETURN(auto build_rb, BuildBufferToRowBatch(exec_state));
+  PX_RETURN_IF_ERROR(build_partitions_->Add(*build_rb));
+  PX_RETURN_IF_ERROR(ClearBuildState(exec_state));
+  while (!probe_batches_.empty()) {
+    // The probe side may have already finished while the build side was being buffered.
+    if (probe_batches_.front().eos()) {
+      probe_eos_ = true;
+    }
+    PX_RETURN_IF_ERROR(probe_partitions_->Add(probe_batches_.front()));
+    probe_batches_.pop();
+  }
+  return Status::OK();
+}
+
+template <types::DataType DT>
+Status AppendKeyValue(arrow::ArrayBuilder* output_builder, const RowTuple& rt, size_t rt_idx,
+                      size_t num_times) {
+  using ValueType = typename types::DataTypeTraits<DT>::value_type;
+  return table_store::schema::CopyValueRepeated<DT>(
+      output_builder, udf::UnWrap(rt.GetValue<ValueType>(rt_idx)), num_times);
+}
+
+StatusOr<std::unique_ptr<RowBatch>> EquijoinNode::BuildBufferToRowBatch(ExecState* exec_state) {
+  int64_t num_rows = 0;
+  for (const auto& [rt, rows] : build_buffer_rows_) {
+    num_rows += rows;
+  }
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders;
+  for (size_t i = 0; i < spilled_build_descriptor_->size(); ++i) {
+    builders.push_back(
+        MakeArrowBuilder(spilled_build_descriptor_->type(i), exec_state->exec_mem_pool()));
+    PX_RETURN_IF_ERROR(builders.back()->Reserve(num_rows));
+  }
+
+  size_t num_keys = key_data_types_.size();
+  for (const auto& [rt, wrappers] : build_buffer_) {
+    int64_t rows = build_buffer_rows_[rt];
+    for (size_t i = 0; i < num_keys; ++i) {
+#define TYPE_CASE(_dt_) \
+  PX_RETURN_IF_ERROR(AppendKeyValue<_dt_>(builders[i].get(), *rt, i, rows))
+      PX_SWITCH_FOREACH_DATATYPE(key_data_types_[i], TYPE_CASE);
+#undef TYPE_CASE
+    }
+    for (size_t i = 0; i < wrappers->size(); ++i) {
+      auto* builder = builders[num_keys + i].get();
+#define TYPE_CASE(_dt_) \
+  PX_RETURN_IF_ERROR(AppendValuesFromWrapper<_dt_>(builder, wrappers->at(i), 0, rows))
+      PX_SWITCH_FOREACH_DATATYPE(spilled_build_spec_.input_col_types[i], TYPE_CASE);
+#undef TYPE_CASE
+    }
+  }
+  return RowBatch::FromColumnBuilders(*spilled_build_descriptor_, /* eow */ false,
+                                      /* eos */ false, &builders);
+}
+
+StatusOr<std::unique_ptr<RowBatch>> EquijoinNode::ProjectSpilledBuildColumns(const RowBatch& rb) {
+  auto spilled_rb = std::make_unique<RowBatch>(*spilled_build_descriptor_, rb.num_rows());
+  for (auto col_idx : build_spec_.key_indices) {
+    PX_RETURN_IF_ERROR(spilled_rb->AddColumn(rb.ColumnAt(col_idx)));
+  }
+  for (auto col_idx : build_spec_.input_col_indices) {
+    PX_RETURN_IF_ERROR(spilled_rb->AddColumn(rb.ColumnAt(col_idx)));
+  }
+  return spilled_rb;
+}
+
+Status EquijoinNode::ClearBuildState(ExecState* exec_state) {
+  build_buffer_.clear();
+  build_buffer_rows_.clear();
+  probed_keys_.clear();
+  join_keys_chunk_.clear();
+  build_wrappers_chunk_.clear();
+  key_values_pool_.Clear();
+  column_values_pool_.Clear();
+  exec_state->spill_manager()->Release(reserved_bytes_);
+  reserved_bytes_ = 0;
+  return Status::OK();
+}
+
+Status EquijoinNode::JoinSpilledPartition(ExecState* exec_state, SpillFile* build,
+                                          SpillFile* probe, int depth) {
+  auto* spill_manager = exec_state->spill_manager();
+  std::unique_ptr<SpillPartitions> sub_build_partitions;
+  while (build != nullptr) {
+    PX_ASSIGN_OR_RETURN(auto rb, build->ReadNext());
+    if (rb == nullptr) {
+      break;
+    }
+    if (sub_build_partitions != nullptr) {
+      PX_RETURN_IF_ERROR(sub_build_partitions->Add(*rb));
+      continue;
+    }
+    PX_RETURN_IF_ERROR(ExtractJoinKeysForBatch(*rb, spilled_build_spec_));
+    PX_RETURN_IF_ERROR(HashRowBatch(*rb, spilled_build_spec_));
+    int64_t bytes = rb->NumBytes();
+    if (spill_manager->TryReserve(bytes)) {
+      reserved_bytes_ += bytes;
+      continue;
+    }
+    if (depth >= FLAGS_carnot_spill_max_depth) {
+      LOG_FIRST_N(WARNING, 1) << absl::Substitute(
+          "Spilled join partition exceeds the memory budget after $0 levels of partitioning, "
+          "building it in memory.",
+          depth + 1);
+      continue;
+    }
+    // Too many build rows hash to this partition, so it's split with the next hash function.
+    spill_manager->RecordPartitionRecursed();
+    sub_build_partitions = std::make_unique<SpillPartitions>(
+        spill_manager, spilled_build_spec_.key_indices, depth + 1);
+    PX_ASSIGN_OR_RETURN(auto build_rb, BuildBufferToRowBatch(exec_state));
+    PX_RETURN_IF_ERROR(sub_build_partitions->Add(*build_rb));
+    PX_RETURN_IF_ERROR(ClearBuildState(exec_state));
+  }
+
+  if (sub_build_partitions != nullptr) {
+    SpillPartitions sub_probe_partitions(spill_manager, probe_spec_.key_indices, depth + 1);
+    while (probe != nullptr) {
+      PX_ASSIGN_OR_RETURN(auto rb, probe->ReadNext());
+      if (rb == nullptr) {
+        break;
+      }
+      PX_RETURN_IF_ERROR(sub_probe_partitions.Add(*rb));
+    }
+    for (size_t i = 0; i < sub_build_partitions->num_partitions(); ++i) {
+      PX_RETURN_IF_ERROR(JoinSpilledPartition(exec_state, sub_build_partitions->partition(i),
+                                              sub_probe_partitions.partition(i), depth + 1));
+    }
+    return Status::OK();
+  }
+
+  while (probe != nullptr) {
+    PX_ASSIGN_OR_RETURN(auto rb, probe->ReadNext());
+    if (rb == nullptr) {
+      break;
+    }
+    PX_RETURN_IF_ERROR(DoProbe(exec_state, *rb));
+  }
+  if (build_spec_.emit_unmatched_rows) {
+    PX_RETURN_IF_ERROR(EmitUnmatchedBuildRows(exec_state));
+  }
+  // The queued output rows point into the build buffer.
+  if (queued_rows_ > 0) {
+    PX_RETURN_IF_ERROR(FlushChunkedRows(exec_state));
+  }
+  return ClearBuildState(exec_state);
+}
+
 Status EquijoinNode::ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
                                      size_t parent_index) {
   if (IsProbeTable(parent_index)) {
@@ -448,7 +661,14 @@ Status EquijoinNode::ConsumeNextImpl(ExecState* exec_state, const table_store::s
   }
 
   if (build_eos_ && probe_eos_) {
-    if (build_spec_.emit_unmatched_rows) {
+    if (build_partitions_ != nullptr) {
+      // Each partition emits its own unmatched build rows.
+      for (size_t i = 0; i < build_partitions_->num_partitions(); ++i) {
+        PX_RETURN_IF_ERROR(JoinSpilledPartition(exec_state, build_partitions_->partition(i),
+                                                probe_partitions_->partition(i),
+                                                build_partitions_->depth()));
+      }
+    } else if (build_spec_.emit_unmatched_rows) {
       PX_RETURN_IF_ERROR(EmitUnmatchedBuildRows(exec_state));
     }
 
@@ -31,6 +31,8 @@
 #include "src/carnot/exec/exec_node.h"
 #include "src/carnot/exec/exec_state.h"
 #include "src/carnot/exec/row_tuple.h"
+#include "src/carnot/exec/runtime_filter.h"
+#include "src/carnot/exec/spill.h"
 #include "src/carnot/plan/operators.h"
 #include "src/common/base/base.h"
 #include "src/common/base/status.h"
@@ -64,6 +66,24 @@ class EquijoinNode : public ProcessingNode {
   EquijoinNode() = default;
   virtual ~EquijoinNode() = default;
 
+  /**
+   * @return whether the probe rows that don't match any build row can be dropped before they
+   * reach the join, which isn't the case when the join emits them.
+   */
+  bool CanFilterProbe() const { return !probe_spec_.emit_unmatched_rows; }
+  // The index of the probe input among the parents of the join.
+  size_t probe_parent_index() const {
+    return probe_table_ == EquijoinNode::JoinInputTable::kLeftTable ? 0 : 1;
+  }
+  const std::vector<int64_t>& probe_key_indices() const { return probe_spec_.key_indices; }
+
+  /**
+   * Makes the join build a runtime filter of its build keys. Must be called before the join is
+   * opened.
+   * @return the filter, which is finished once the build side is done.
+   */
+  const JoinRuntimeFilter* EnableRuntimeFilter();
+
  protected:
   std::string DebugStringImpl() override;
   Status InitImpl(const plan::Operator& plan_node) override;
@@ -74,11 +94,11 @@ class EquijoinNode : public ProcessingNode {
                          size_t parent_index) override;
 
  private:
-  Status InitializeColumnBuilders();
+  Status InitializeColumnBuilders(ExecState* exec_state);
   bool IsProbeTable(size_t parent_index);
   Status FlushChunkedRows(ExecState* exec_state);
-  Status ExtractJoinKeysForBatch(const table_store::schema::RowBatch& rb, bool is_probe);
-  Status HashRowBatch(const table_store::schema::RowBatch& rb);
+  Status ExtractJoinKeysForBatch(const table_store::schema::RowBatch& rb, const TableSpec& spec);
+  Status HashRowBatch(const table_store::schema::RowBatch& rb, const TableSpec& spec);
 
   Status DoProbe(ExecState* exec_state, const table_store::schema::RowBatch& rb);
   Status MatchBuildValuesAndFlush(ExecState* exec_state,
@@ -90,6 +110,23 @@ class EquijoinNode : public ProcessingNode {
   Status ConsumeBuildBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb);
   Status ConsumeProbeBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb);
 
+  bool CanSpill(ExecState* exec_state) const;
+  // Reserves the memory of a build batch that was added to the build buffer. If that exceeds the
+  // budget of the query, the build buffer is spilled and the join switches to partitioning its
+  // inputs to disk.
+  Status ReserveOrSpillBuild(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  // Outputs the rows of the build buffer in the layout of the spilled build batches.
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> BuildBufferToRowBatch(
+      ExecState* exec_state);
+  // Selects the columns of a build batch that are spilled.
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> ProjectSpilledBuildColumns(
+      const table_store::schema::RowBatch& rb);
+  Status ClearBuildState(ExecState* exec_state);
+  // Joins a build partition with the matching probe partition, either one can be nullptr if it's
+  // empty. Partitions whose build side doesn't fit in memory are partitioned again.
+  Status JoinSpilledPartition(ExecState* exec_state, SpillFile* build, SpillFile* probe,
+                              int depth);
+
   bool build_eos_ = false;
   bool probe_eos_ = false;
   // Note whether the left or the right table is the probe table.
@@ -155,6 +192,21 @@ class EquijoinNode : public ProcessingNode {
   std::unique_ptr<table_store::schema::RowBatch> pending_output_batch_;
 
   std::unique_ptr<plan::JoinOperator> plan_node_;
+
+  // Variables specific to spilling the build side. Once the build buffer exceeds the memory budget
+  // of the query, both inputs are partitioned to disk by the hash of their keys (see spill.h), and
+  // each partition is joined on its own once both inputs are done.
+
+  // The spilled build batches have the key columns followed by the build columns of the output.
+  std::unique_ptr<table_store::schema::RowDescriptor> spilled_build_descriptor_;
+  TableSpec spilled_build_spec_;
+  std::unique_ptr<SpillPartitions> build_partitions_;
+  std::unique_ptr<SpillPartitions> probe_partitions_;
+  // The bytes of the memory budget reserved for the build buffer.
+  int64_t reserved_bytes_ = 0;
+
+  // Only set when the probe side can apply the filter.
+  std::unique_ptr<JoinRuntimeFilter> runtime_filter_;
 };
 
 }  // namespace exec
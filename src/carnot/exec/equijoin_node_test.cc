@@ -24,6 +24,7 @@
 #include <gtest/gtest.h>
 #include <sole.hpp>
 
+#include "src/carnot/exec/spill.h"
 #include "src/carnot/exec/test_utils.h"
 #include "src/carnot/planpb/plan.pb.h"
 #include "src/carnot/planpb/test_proto.h"
@@ -46,18 +47,24 @@ using udf::FunctionContext;
 // 3) non-time ordered full outer join (all batches from build first)
 // 4) non-time ordered no matches inner join
 // 5) non-time ordered many matches per key inner join
+// 6) non-time ordered full outer join that spills its build and probe sides
 
 class JoinNodeTest : public ::testing::Test {
  public:
   JoinNodeTest() {
     func_registry_ = std::make_unique<udf::Registry>("test_registry");
+    ResetExecState();
+  }
+
+ protected:
+  // Makes a new exec state, which picks up the current spill flags.
+  void ResetExecState() {
     auto table_store = std::make_shared<table_store::TableStore>();
     exec_state_ = std::make_unique<ExecState>(func_registry_.get(), table_store,
                                               MockResultSinkStubGenerator, MockMetricsStubGenerator,
                                               MockTraceStubGenerator, sole::uuid4(), nullptr);
   }
 
- protected:
   std::unique_ptr<ExecState> exec_state_;
   std::unique_ptr<udf::Registry> func_registry_;
 };
@@ -686,6 +693,157 @@ TEST_F(JoinNodeTest, unordered_many_matches) {
       .Close();
 }
 
+
+TEST_F(JoinNodeTest, unordered_full_outer_join_spilled) {
+  // Every build batch exceeds the budget, so both sides are written to a single partition, which
+  // is split once more before it's joined in memory.
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_memory_budget, 1);
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_partitions, 1);
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_max_depth, 1);
+  ResetExecState();
+  const char* proto = R"(
+  type: FULL_OUTER
+  equality_conditions {
+    left_column_index: 0
+    right_column_index: 1
+  }
+  output_columns: {
+    parent_index: 0
+    column_index: 1
+  }
+  output_columns: {
+    parent_index: 1
+    column_index: 1
+  }
+  output_columns: {
+    parent_index: 1
+    column_index: 0
+  }
+  column_names: "left_1"
+  column_names: "right_1"
+  column_names: "right_0"
+  rows_per_batch: 5
+)";
+
+  RowDescriptor input_rd_0({types::DataType::TIME64NS, types::DataType::INT64});
+  RowDescriptor input_rd_1({types::DataType::INT64, types::DataType::TIME64NS});
+  RowDescriptor output_rd(
+      {types::DataType::INT64, types::DataType::TIME64NS, types::DataType::INT64});
+
+  auto plan_node = PlanNodeFromPbtxt(proto);
+  auto tester = exec::ExecNodeTester<EquijoinNode, plan::JoinOperator>(
+      *plan_node, output_rd, {input_rd_0, input_rd_1}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_0, 5, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Time64NSValue>({101, 200, 101, 200, 101})
+                       .AddColumn<types::Int64Value>({1, 2, 3, 4, 5})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_0, 5, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Time64NSValue>({200, 200, 200, 300, 300})
+                       .AddColumn<types::Int64Value>({6, 8, 10, 12, 14})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_0, 2, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::Time64NSValue>({400, 500})
+                       .AddColumn<types::Int64Value>({16, 18})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_1, 3, true, true)
+                       .AddColumn<types::Int64Value>({-10, -20, -30})
+                       .AddColumn<types::Time64NSValue>({110, 120, 101})
+                       .get(),
+                   1, 3)
+      .ExpectRowBatchesData(
+          RowBatchBuilder(output_rd, 14, true, true)
+              .AddColumn<types::Int64Value>({0, 0, 1, 3, 5, 2, 4, 6, 8, 10, 12, 14, 16, 18})
+              .AddColumn<types::Time64NSValue>({110, 120, 101, 101, 101, 0, 0, 0, 0, 0, 0, 0, 0, 0})
+              .AddColumn<types::Int64Value>({-10, -20, -30, -30, -30, 0, 0, 0, 0, 0, 0, 0, 0, 0})
+              .get(),
+          3)
+      .Close();
+
+  EXPECT_GT(exec_state_->spill_manager()->spilled_bytes(), 0);
+  EXPECT_EQ(1, exec_state_->spill_manager()->partitions_recursed());
+  EXPECT_EQ(0, exec_state_->spill_manager()->reserved_bytes());
+}
+
+TEST_F(JoinNodeTest, unordered_full_outer_join_spilled_after_probe_eos) {
+  // The probe side ends while the build side is still buffered, so its batches, including its eos,
+  // are only partitioned once the build side spills.
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_memory_budget, 1);
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_partitions, 1);
+  PX_SET_FOR_SCOPE(FLAGS_carnot_spill_max_depth, 1);
+  ResetExecState();
+  const char* proto = R"(
+  type: FULL_OUTER
+  equality_conditions {
+    left_column_index: 0
+    right_column_index: 1
+  }
+  output_columns: {
+    parent_index: 0
+    column_index: 1
+  }
+  output_columns: {
+    parent_index: 1
+    column_index: 1
+  }
+  output_columns: {
+    parent_index: 1
+    column_index: 0
+  }
+  column_names: "left_1"
+  column_names: "right_1"
+  column_names: "right_0"
+  rows_per_batch: 5
+)";
+
+  RowDescriptor input_rd_0({types::DataType::TIME64NS, types::DataType::INT64});
+  RowDescriptor input_rd_1({types::DataType::INT64, types::DataType::TIME64NS});
+  RowDescriptor output_rd(
+      {types::DataType::INT64, types::DataType::TIME64NS, types::DataType::INT64});
+
+  auto plan_node = PlanNodeFromPbtxt(proto);
+  auto tester = exec::ExecNodeTester<EquijoinNode, plan::JoinOperator>(
+      *plan_node, output_rd, {input_rd_0, input_rd_1}, exec_state_.get());
+
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_1, 3, true, true)
+                       .AddColumn<types::Int64Value>({-10, -20, -30})
+                       .AddColumn<types::Time64NSValue>({110, 120, 101})
+                       .get(),
+                   1, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_0, 5, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Time64NSValue>({101, 200, 101, 200, 101})
+                       .AddColumn<types::Int64Value>({1, 2, 3, 4, 5})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_0, 5, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<types::Time64NSValue>({200, 200, 200, 300, 300})
+                       .AddColumn<types::Int64Value>({6, 8, 10, 12, 14})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_0, 2, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::Time64NSValue>({400, 500})
+                       .AddColumn<types::Int64Value>({16, 18})
+                       .get(),
+                   0, 3)
+      .ExpectRowBatchesData(
+          RowBatchBuilder(output_rd, 14, true, true)
+              .AddColumn<types::Int64Value>({0, 0, 1, 3, 5, 2, 4, 6, 8, 10, 12, 14, 16, 18})
+              .AddColumn<types::Time64NSValue>({110, 120, 101, 101, 101, 0, 0, 0, 0, 0, 0, 0, 0, 0})
+              .AddColumn<types::Int64Value>({-10, -20, -30, -30, -30, 0, 0, 0, 0, 0, 0, 0, 0, 0})
+              .get(),
+          3)
+      .Close();
+
+  EXPECT_GT(exec_state_->spill_manager()->spilled_bytes(), 0);
+  EXPECT_EQ(1, exec_state_->spill_manager()->partitions_recursed());
+  EXPECT_EQ(0, exec_state_->spill_manager()->reserved_bytes());
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -19,6 +19,7 @@
 #include "src/carnot/exec/exec_graph.h"
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -35,7 +36,10 @@
 #include "src/carnot/exec/map_node.h"
 #include "src/carnot/exec/memory_sink_node.h"
 #include "src/carnot/exec/memory_source_node.h"
+#include "src/carnot/exec/morsel_pipeline.h"
 #include "src/carnot/exec/otel_export_sink_node.h"
+#include "src/carnot/exec/sort_node.h"
+#include "src/carnot/exec/time_window_agg_node.h"
 #include "src/carnot/exec/udtf_source_node.h"
 #include "src/carnot/exec/union_node.h"
 #include "src/carnot/plan/operators.h"
@@ -43,12 +47,43 @@
 #include "src/common/perf/perf.h"
 #include "src/table_store/table_store.h"
 
+DEFINE_int32(carnot_morsel_exec_threads,
+             gflags::Int32FromEnv("PL_CARNOT_MORSEL_EXEC_THREADS", 1),
+             "The number of threads that run the scan, map, filter and partial aggregate of a "
+             "blocking aggregate over a memory source. 1 disables parallel execution.");
+DEFINE_bool(carnot_morsel_merge_in_process,
+            gflags::BoolFromEnv("PL_CARNOT_MORSEL_MERGE_IN_PROCESS", true),
+            "Whether the aggregates of the morsel pipeline workers are merged in process, instead "
+            "of being serialized and merged like the partial aggregates of other agents.");
+DEFINE_bool(carnot_coalesce_grpc_sink_input,
+            gflags::BoolFromEnv("PL_CARNOT_COALESCE_GRPC_SINK_INPUT", true),
+            "Whether the output of filters is combined into larger batches before it's sent to a "
+            "GRPC sink.");
+
 namespace px {
 namespace carnot {
 namespace exec {
 
 using table_store::schema::RowDescriptor;
 
+namespace {
+
+// The descriptor of the serialized output of a partial aggregate: its groups followed by a string
+// column per value.
+RowDescriptor PartialAggDescriptor(const plan::AggregateOperator& agg,
+                                   const RowDescriptor& input_descriptor) {
+  std::vector<types::DataType> types;
+  for (const auto& group : agg.groups()) {
+    types.push_back(input_descriptor.type(group.idx));
+  }
+  for (size_t i = 0; i < agg.values().size(); ++i) {
+    types.push_back(types::STRING);
+  }
+  return RowDescriptor(types);
+}
+
+}  // namespace
+
 Status ExecutionGraph::Init(table_store::schema::Schema* schema, plan::PlanState* plan_state,
                             ExecState* exec_state, plan::PlanFragment* pf,
                             bool collect_exec_node_stats,
@@ -60,9 +95,24 @@ Status ExecutionGraph::Init(table_store::schema::Schema* schema, plan::PlanState
   collect_exec_node_stats_ = collect_exec_node_stats;
   consecutive_generate_calls_per_source_ = consecutive_generate_calls_per_source;
 
+  morsel_exec_threads_ = std::max(FLAGS_carnot_morsel_exec_threads, 1);
+  morsel_merge_in_process_ = FLAGS_carnot_morsel_merge_in_process;
+
+  std::vector<MorselPipelineSpec> morsel_pipeline_specs;
+  if (morsel_exec_threads_ > 1) {
+    morsel_pipeline_specs = FindMorselPipelines();
+  }
+  for (const auto& spec : morsel_pipeline_specs) {
+    morsel_fed_nodes_.insert(spec.chain_ids.empty() ? spec.agg_id : spec.chain_ids.front());
+    morsel_merge_aggs_.insert(spec.agg_id);
+  }
+  if (FLAGS_carnot_coalesce_grpc_sink_input) {
+    coalesced_nodes_ = FindCoalescedSinks();
+  }
+
   std::unordered_map<int64_t, ExecNode*> nodes;
   std::unordered_map<int64_t, RowDescriptor> descriptors;
-  return plan::PlanFragmentWalker()
+  PX_RETURN_IF_ERROR(plan::PlanFragmentWalker()
       .OnMap([&](auto& node) {
         return OnOperatorImpl<plan::MapOperator, MapNode>(node, &descriptors);
       })
@@ -70,6 +120,12 @@ Status ExecutionGraph::Init(table_store::schema::Schema* schema, plan::PlanState
         return OnOperatorImpl<plan::MemorySinkOperator, MemorySinkNode>(node, &descriptors);
       })
       .OnAggregate([&](auto& node) {
+        if (morsel_merge_aggs_.contains(node.id()) && !morsel_merge_in_process_) {
+          return OnMorselPipelineAggregate(node, &descriptors);
+        }
+        if (node.time_windowed()) {
+          return OnOperatorImpl<plan::AggregateOperator, TimeWindowAggNode>(node, &descriptors);
+        }
         return OnOperatorImpl<plan::AggregateOperator, AggNode>(node, &descriptors);
       })
       .OnMemorySource([&](auto& node) {
@@ -84,6 +140,9 @@ Status ExecutionGraph::Init(table_store::schema::Schema* schema, plan::PlanState
       .OnUnion([&](auto& node) {
         return OnOperatorImpl<plan::UnionOperator, UnionNode>(node, &descriptors);
       })
+      .OnSort([&](auto& node) {
+        return OnOperatorImpl<plan::SortOperator, SortNode>(node, &descriptors);
+      })
       .OnJoin([&](auto& node) {
         return OnOperatorImpl<plan::JoinOperator, EquijoinNode>(node, &descriptors);
       })
@@ -108,7 +167,270 @@ Status ExecutionGraph::Init(table_store::schema::Schema* schema, plan::PlanState
       .OnOTelSink([&](auto& node) {
         return OnOperatorImpl<plan::OTelExportSinkOperator, OTelExportSinkNode>(node, &descriptors);
       })
-      .Walk(pf_);
+      .Walk(pf_));
+
+  for (const auto& spec : morsel_pipeline_specs) {
+    PX_RETURN_IF_ERROR(CreateMorselPipeline(spec, descriptors));
+  }
+  if (FLAGS_carnot_join_runtime_filters) {
+    AddJoinRuntimeFilters();
+  }
+  return Status::OK();
+}
+
+void ExecutionGraph::AddJoinRuntimeFilters() {
+  const auto& dag = pf_->dag();
+  for (const auto& [id, op] : pf_->nodes()) {
+    if (op->op_type() != planpb::JOIN_OPERATOR) {
+      continue;
+    }
+    auto join = static_cast<EquijoinNode*>(nodes_.at(id));
+    if (!join->CanFilterProbe()) {
+      continue;
+    }
+    // Follow the probe side up through the maps and filters that only feed the join, to the
+    // memory source that it reads, keeping track of where the keys come from.
+    int64_t node_id = dag.ParentsOf(id)[join->probe_parent_index()];
+    std::vector<int64_t> key_cols = join->probe_key_indices();
+    while (dag.DependenciesOf(node_id).size() == 1) {
+      const auto& node_op = *pf_->nodes().at(node_id);
+      if (node_op.op_type() == planpb::MEMORY_SOURCE_OPERATOR) {
+        // A streaming source could wait on the build side forever.
+        if (!static_cast<const plan::MemorySourceOperator&>(node_op).streaming() &&
+            !morsel_pipelines_.contains(node_id)) {
+          static_cast<MemorySourceNode*>(nodes_.at(node_id))
+              ->AddRuntimeFilter(join->EnableRuntimeFilter(), key_cols);
+          runtime_filtered_sources_.insert(node_id);
+        }
+        break;
+      }
+      bool keys_pass_through = true;
+      if (node_op.op_type() == planpb::FILTER_OPERATOR) {
+        auto selected_cols =
+            static_cast<plan::FilterOperator*>(pf_->nodes().at(node_id).get())->selected_cols();
+        for (auto& col : key_cols) {
+          col = selected_cols[col];
+        }
+      } else if (node_op.op_type() == planpb::MAP_OPERATOR) {
+        const auto& exprs = static_cast<const plan::MapOperator&>(node_op).expressions();
+        for (auto& col : key_cols) {
+          // Keys that are computed by the map can't be checked at the source.
+          if (exprs[col]->ExpressionType() != plan::Expression::kColumn) {
+            keys_pass_through = false;
+            break;
+          }
+          col = static_cast<const plan::Column*>(exprs[col].get())->Index();
+        }
+      } else {
+        keys_pass_through = false;
+      }
+      if (!keys_pass_through) {
+        break;
+      }
+      node_id = dag.ParentsOf(node_id)[0];
+    }
+  }
+}
+
+absl::flat_hash_set<int64_t> ExecutionGraph::FindCoalescedSinks() const {
+  absl::flat_hash_set<int64_t> sinks;
+  const auto& dag = pf_->dag();
+  for (const auto& [id, op] : pf_->nodes()) {
+    if (op->op_type() != planpb::GRPC_SINK_OPERATOR) {
+      continue;
+    }
+    // Maps don't change the number of rows, so the filter can be behind some of them.
+    int64_t node_id = dag.ParentsOf(id)[0];
+    while (pf_->nodes().at(node_id)->op_type() == planpb::MAP_OPERATOR &&
+           dag.DependenciesOf(node_id).size() == 1) {
+      node_id = dag.ParentsOf(node_id)[0];
+    }
+    if (pf_->nodes().at(node_id)->op_type() == planpb::FILTER_OPERATOR) {
+      sinks.insert(id);
+    }
+  }
+  return sinks;
+}
+
+StatusOr<ExecNode*> ExecutionGraph::AddCoalesceNode(const plan::Operator& sink_op,
+                                                    const RowDescriptor& descriptor,
+                                                    ExecNode* parent) {
+  auto node = pool_.Add(new CoalesceNode());
+  PX_RETURN_IF_ERROR(node->Init(sink_op, descriptor, {descriptor}, collect_exec_node_stats_));
+  parent->AddChild(node, 0);
+  coalesce_nodes_.push_back(node);
+  return node;
+}
+
+bool ExecutionGraph::SupportsMorselExecution(const plan::AggregateOperator& agg) const {
+  // Only aggregates whose partial results can be merged are split across workers. Windowed
+  // aggregates emit on every window, which requires the batches to arrive in order.
+  if (!agg.partial_agg() || agg.windowed() || agg.time_windowed()) {
+    return false;
+  }
+  // Merging in process only uses the Merge of the UDAs. The serialized merge, and the groups that
+  // are spilled to disk, also need them to serialize their state.
+  bool needs_serialize = !morsel_merge_in_process_ || exec_state_->spill_manager()->enabled();
+  for (const auto& value : agg.values()) {
+    auto def = exec_state_->GetUDADefinition(value->uda_id());
+    if (def == nullptr || (needs_serialize && !def->supports_partial())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<ExecutionGraph::MorselPipelineSpec> ExecutionGraph::FindMorselPipelines() const {
+  std::vector<MorselPipelineSpec> specs;
+  const auto& dag = pf_->dag();
+  for (const auto& [id, op] : pf_->nodes()) {
+    if (op->op_type() != planpb::MEMORY_SOURCE_OPERATOR ||
+        static_cast<const plan::MemorySourceOperator*>(op.get())->streaming()) {
+      continue;
+    }
+    MorselPipelineSpec spec{id, {}, -1};
+    int64_t tail = id;
+    while (true) {
+      auto children = dag.DependenciesOf(tail);
+      if (children.size() != 1 || dag.ParentsOf(children[0]).size() != 1) {
+        break;
+      }
+      const auto& child = pf_->nodes().at(children[0]);
+      if (child->op_type() == planpb::MAP_OPERATOR || child->op_type() == planpb::FILTER_OPERATOR) {
+        spec.chain_ids.push_back(child->id());
+        tail = child->id();
+        continue;
+      }
+      if (child->op_type() == planpb::AGGREGATE_OPERATOR &&
+          SupportsMorselExecution(*static_cast<const plan::AggregateOperator*>(child.get()))) {
+        spec.agg_id = child->id();
+      }
+      break;
+    }
+    if (spec.agg_id != -1) {
+      specs.push_back(std::move(spec));
+    }
+  }
+  return specs;
+}
+
+Status ExecutionGraph::OnMorselPipelineAggregate(
+    const plan::AggregateOperator& node, std::unordered_map<int64_t, RowDescriptor>* descriptors) {
+  auto parents = pf_->dag().ParentsOf(node.id());
+  auto input_desc = descriptors->find(parents[0]);
+  if (input_desc == descriptors->end()) {
+    return error::NotFound("Could not find RowDescriptor.");
+  }
+  // The rest of the graph sees the aggregate of the plan.
+  PX_ASSIGN_OR_RETURN(auto output_rel, node.OutputRelation(*schema_, *plan_state_, parents));
+  RowDescriptor output_descriptor(output_rel.col_types());
+  schema_->AddRelation(node.id(), output_rel);
+  descriptors->insert({node.id(), output_descriptor});
+
+  // The node itself merges the serialized partial aggregates of the pipeline workers, which have
+  // the groups as their leading columns.
+  planpb::AggregateOperator merge_pb = node.pb();
+  merge_pb.set_partial_agg(false);
+  for (int i = 0; i < merge_pb.groups_size(); ++i) {
+    merge_pb.mutable_groups(i)->set_index(i);
+  }
+  plan::AggregateOperator merge_op(node.id());
+  PX_RETURN_IF_ERROR(merge_op.Init(merge_pb));
+
+  auto merge_node = pool_.Add(new AggNode());
+  PX_RETURN_IF_ERROR(merge_node->Init(merge_op, output_descriptor,
+                                      {PartialAggDescriptor(node, input_desc->second)},
+                                      collect_exec_node_stats_));
+  AddNode(node.id(), merge_node);
+  return Status::OK();
+}
+
+StatusOr<ExecNode*> ExecutionGraph::CloneMorselChainNode(
+    int64_t id, const std::unordered_map<int64_t, RowDescriptor>& descriptors) {
+  const plan::Operator& op = *pf_->nodes().at(id);
+  ExecNode* node = nullptr;
+  switch (op.op_type()) {
+    case planpb::MAP_OPERATOR:
+      node = pool_.Add(new MapNode());
+      break;
+    case planpb::FILTER_OPERATOR:
+      node = pool_.Add(new FilterNode());
+      break;
+    default:
+      return error::Internal("Operator $0 can't be run by a morsel pipeline.", op.DebugString());
+  }
+  auto parent_id = pf_->dag().ParentsOf(id)[0];
+  PX_RETURN_IF_ERROR(
+      node->Init(op, descriptors.at(id), {descriptors.at(parent_id)}, collect_exec_node_stats_));
+  return node;
+}
+
+Status ExecutionGraph::CreateMorselPipeline(
+    const MorselPipelineSpec& spec, const std::unordered_map<int64_t, RowDescriptor>& descriptors) {
+  auto source = static_cast<MemorySourceNode*>(nodes_.at(spec.source_id));
+  const auto& agg =
+      *static_cast<const plan::AggregateOperator*>(pf_->nodes().at(spec.agg_id).get());
+  const auto& agg_input_desc = descriptors.at(pf_->dag().ParentsOf(spec.agg_id)[0]);
+
+  auto pipeline = std::make_unique<MorselPipeline>(source, descriptors.at(spec.source_id),
+                                                   nodes_.at(spec.agg_id), kMorselsPerFetch,
+                                                   morsel_merge_in_process_);
+  // The workers serialize their partial aggregates so that the merge node can combine them, unless
+  // they are merged in process.
+  planpb::AggregateOperator partial_pb = agg.pb();
+  partial_pb.set_finalize_results(false);
+  plan::AggregateOperator partial_op(spec.agg_id);
+  PX_RETURN_IF_ERROR(partial_op.Init(partial_pb));
+  auto partial_desc = PartialAggDescriptor(agg, agg_input_desc);
+
+  for (int32_t w = 0; w < morsel_exec_threads_; ++w) {
+    // The first worker reuses the nodes of the graph, which are already linked to each other.
+    bool owned = w > 0;
+    std::vector<ExecNode*> worker_nodes;
+    for (int64_t id : spec.chain_ids) {
+      ExecNode* node = nodes_.at(id);
+      if (owned) {
+        PX_ASSIGN_OR_RETURN(node, CloneMorselChainNode(id, descriptors));
+        if (!worker_nodes.empty()) {
+          worker_nodes.back()->AddChild(node, 0);
+        }
+      }
+      worker_nodes.push_back(node);
+    }
+
+    if (morsel_merge_in_process_) {
+      // Every worker runs the aggregate of the plan on its own AggNode. The first worker uses the
+      // one of the graph, which the pipeline merges the others into.
+      ExecNode* agg_node = nodes_.at(spec.agg_id);
+      if (owned) {
+        agg_node = pool_.Add(new AggNode());
+        PX_RETURN_IF_ERROR(agg_node->Init(agg, descriptors.at(spec.agg_id), {agg_input_desc},
+                                          collect_exec_node_stats_));
+        if (!worker_nodes.empty()) {
+          worker_nodes.back()->AddChild(agg_node, 0);
+        }
+      }
+      worker_nodes.push_back(agg_node);
+      pipeline->AddWorker(std::move(worker_nodes), /* sink */ nullptr, owned);
+      continue;
+    }
+
+    auto partial_node = pool_.Add(new AggNode());
+    PX_RETURN_IF_ERROR(partial_node->Init(partial_op, partial_desc, {agg_input_desc},
+                                          collect_exec_node_stats_));
+    if (!worker_nodes.empty()) {
+      worker_nodes.back()->AddChild(partial_node, 0);
+    }
+    worker_nodes.push_back(partial_node);
+
+    auto sink = pool_.Add(new MorselSinkNode());
+    PX_RETURN_IF_ERROR(sink->Init(partial_op, partial_desc, {partial_desc}));
+    partial_node->AddChild(sink, 0);
+
+    pipeline->AddWorker(std::move(worker_nodes), sink, owned);
+  }
+  morsel_pipelines_[spec.source_id] = std::move(pipeline);
+  return Status::OK();
 }
 
 bool ExecutionGraph::YieldWithTimeout() {
@@ -117,7 +439,15 @@ bool ExecutionGraph::YieldWithTimeout() {
     continue_ = false;
     return false;
   }
-  auto timed_out = !(execution_cv_.wait_for(lock, yield_timeout_ms_, [this] { return continue_; }));
+  // Don't sleep past the time that a coalescing stage has to send the rows it holds.
+  auto deadline = std::chrono::steady_clock::now() + yield_timeout_ms_;
+  for (const auto* node : coalesce_nodes_) {
+    auto flush_deadline = node->FlushDeadline();
+    if (flush_deadline.has_value()) {
+      deadline = std::min(deadline, flush_deadline.value());
+    }
+  }
+  auto timed_out = !(execution_cv_.wait_until(lock, deadline, [this] { return continue_; }));
   return timed_out;
 }
 
@@ -174,6 +504,33 @@ Status ExecutionGraph::CheckDownstreamGRPCConnectionsHealth() {
   return Status::OK();
 }
 
+absl::flat_hash_set<SourceNode*> ExecutionGraph::SourcesWaitingForRuntimeFilters(
+    const absl::flat_hash_set<SourceNode*>& running_sources,
+    const absl::flat_hash_map<SourceNode*, int64_t>& source_to_id) const {
+  absl::flat_hash_set<SourceNode*> waiting;
+  if (runtime_filtered_sources_.empty()) {
+    return waiting;
+  }
+  for (SourceNode* source : running_sources) {
+    if (runtime_filtered_sources_.contains(source_to_id.at(source)) &&
+        static_cast<MemorySourceNode*>(source)->RuntimeFiltersPending()) {
+      waiting.insert(source);
+    }
+  }
+  // The build sides can't make progress once every running source waits on them.
+  if (waiting.size() == running_sources.size()) {
+    waiting.clear();
+  }
+  return waiting;
+}
+
+Status ExecutionGraph::FlushExpiredCoalesceNodes() {
+  for (auto* node : coalesce_nodes_) {
+    PX_RETURN_IF_ERROR(node->FlushIfExpired(exec_state_));
+  }
+  return Status::OK();
+}
+
 Status ExecutionGraph::ExecuteSources() {
   absl::flat_hash_set<SourceNode*> running_sources;
 
@@ -191,8 +548,14 @@ Status ExecutionGraph::ExecuteSources() {
   // Run all sources to completion, or exit if the query encounters an error.
   while (running_sources.size()) {
     absl::flat_hash_set<SourceNode*> completed_sources_execute_loop;
+    // Sources that feed the probe side of a join hold off until the join has built its runtime
+    // filter, so that they only send the rows that can match.
+    auto waiting_sources = SourcesWaitingForRuntimeFilters(running_sources, source_to_id);
 
     for (SourceNode* source : running_sources) {
+      if (waiting_sources.contains(source)) {
+        continue;
+      }
       if (grpc_sources_.contains(source_to_id.at(source))) {
         auto s = CheckUpstreamGRPCConnectionHealth(static_cast<GRPCSourceNode*>(source));
         if (!s.ok()) {
@@ -208,11 +571,17 @@ Status ExecutionGraph::ExecuteSources() {
 
       exec_state_->SetCurrentSource(source_to_id[source]);
 
-      for (auto i = 0; i < consecutive_generate_calls_per_source_; ++i) {
-        if (!source->NextBatchReady() || !exec_state_->keep_running()) {
-          break;
+      auto pipeline = morsel_pipelines_.find(source_to_id[source]);
+      if (pipeline != morsel_pipelines_.end()) {
+        // The pipeline scans the whole table in parallel and finishes the source.
+        PX_RETURN_IF_ERROR(pipeline->second->Execute(exec_state_));
+      } else {
+        for (auto i = 0; i < consecutive_generate_calls_per_source_; ++i) {
+          if (!source->NextBatchReady() || !exec_state_->keep_running()) {
+            break;
+          }
+          PX_RETURN_IF_ERROR(source->GenerateNext(exec_state_));
         }
-        PX_RETURN_IF_ERROR(source->GenerateNext(exec_state_));
       }
 
       // keep_running will be set to false when a downstream limit for this particular
@@ -223,6 +592,7 @@ Status ExecutionGraph::ExecuteSources() {
       }
     }
     PX_RETURN_IF_ERROR(CheckDownstreamGRPCConnectionsHealth());
+    PX_RETURN_IF_ERROR(FlushExpiredCoalesceNodes());
 
     // Flush all of the completed sources.
     for (SourceNode* source : completed_sources_execute_loop) {
@@ -237,8 +607,9 @@ Status ExecutionGraph::ExecuteSources() {
     // For all running sources, check to see if any of them have data
     // or if we need to yield for more data.
     bool wait_for_more_data = true;
+    waiting_sources = SourcesWaitingForRuntimeFilters(running_sources, source_to_id);
     for (SourceNode* source : running_sources) {
-      if (source->NextBatchReady()) {
+      if (!waiting_sources.contains(source) && source->NextBatchReady()) {
         wait_for_more_data = false;
         break;
       }
@@ -251,12 +622,13 @@ Status ExecutionGraph::ExecuteSources() {
       timer.Stop();
 
       absl::flat_hash_set<SourceNode*> completed_sources_wait_loop;
+      waiting_sources = SourcesWaitingForRuntimeFilters(running_sources, source_to_id);
 
       // This check is used for Memory sources that are waiting on data, because we don't currently
       // have a mechanism to call Yield() on them while they are waiting.
       // Once we introduce Carnot ETL, we can have the ingest phase of Carnot ETL call yield.
       for (SourceNode* source : running_sources) {
-        if (source->NextBatchReady()) {
+        if (!waiting_sources.contains(source) && source->NextBatchReady()) {
           wait_for_more_data = false;
         }
         // Check the upstream connection health of all running GRPC sources after each yield.
@@ -274,6 +646,9 @@ Status ExecutionGraph::ExecuteSources() {
         }
       }
       PX_RETURN_IF_ERROR(CheckDownstreamGRPCConnectionsHealth());
+      // Rows held by a coalescing stage still go out after the max delay while the sources have
+      // nothing to send.
+      PX_RETURN_IF_ERROR(FlushExpiredCoalesceNodes());
 
       // Flush all of the completed sources after this phase of source deletion.
       for (SourceNode* source : completed_sources_wait_loop) {
@@ -298,14 +673,22 @@ Status ExecutionGraph::Execute() {
   // Get vector of nodes.
   std::vector<ExecNode*> nodes(nodes_.size());
   transform(nodes_.begin(), nodes_.end(), nodes.begin(), [](auto pair) { return pair.second; });
+  // The coalescing stages aren't part of the plan, but they're run like the rest of the nodes.
+  nodes.insert(nodes.end(), coalesce_nodes_.begin(), coalesce_nodes_.end());
 
   for (auto node : nodes) {
     PX_RETURN_IF_ERROR(node->Prepare(exec_state_));
   }
+  for (const auto& [id, pipeline] : morsel_pipelines_) {
+    PX_RETURN_IF_ERROR(pipeline->Prepare(exec_state_));
+  }
 
   for (auto node : nodes) {
     PX_RETURN_IF_ERROR(node->Open(exec_state_));
   }
+  for (const auto& [id, pipeline] : morsel_pipelines_) {
+    PX_RETURN_IF_ERROR(pipeline->Open(exec_state_));
+  }
 
   // We don't PX_RETURN_IF_ERROR here because we want to make sure we close all of our
   // nodes, even if there was an error during execution.
@@ -323,6 +706,16 @@ Status ExecutionGraph::Execute() {
       close_status = s;
     }
   }
+  for (const auto& [id, pipeline] : morsel_pipelines_) {
+    auto s = pipeline->Close(exec_state_);
+    if (!s.ok()) {
+      LOG(ERROR) << absl::Substitute(
+          "Error in ExecutionGraph::Execute() for query $0, could not close morsel pipeline of "
+          "source $1: $2",
+          exec_state_->query_id().str(), id, s.msg());
+      close_status = s;
+    }
+  }
 
   if (!source_status.ok()) {
     return source_status;
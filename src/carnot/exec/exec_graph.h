@@ -29,9 +29,11 @@
 #include <vector>
 
 #include "src/carnot/dag/dag.h"
+#include "src/carnot/exec/coalesce_node.h"
 #include "src/carnot/exec/exec_node.h"
 #include "src/carnot/exec/exec_state.h"
 #include "src/carnot/exec/memory_source_node.h"
+#include "src/carnot/exec/morsel_pipeline.h"
 #include "src/carnot/plan/plan_fragment.h"
 #include "src/carnot/plan/plan_state.h"
 #include "src/common/base/base.h"
@@ -39,6 +41,10 @@
 #include "src/shared/types/types.h"
 #include "src/table_store/table_store.h"
 
+DECLARE_int32(carnot_morsel_exec_threads);
+DECLARE_bool(carnot_morsel_merge_in_process);
+DECLARE_bool(carnot_coalesce_grpc_sink_input);
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -51,6 +57,8 @@ struct ExecutionStats {
 constexpr std::chrono::milliseconds kDefaultYieldTimeoutMS{1000};
 constexpr std::chrono::milliseconds kDefaultUpstreamResultConnectionTimeout{5000};
 constexpr int32_t kDefaultConsecutiveGenerateCallsPerSource = 10;
+// The number of table batches a morsel pipeline worker reads from the source at a time.
+constexpr int64_t kMorselsPerFetch = 2;
 using SystemTimePoint = std::chrono::time_point<std::chrono::system_clock>;
 
 /**
@@ -195,6 +203,11 @@ class ExecutionGraph {
 
     AddNode(node.id(), execNode);
 
+    // The head of a morsel pipeline is fed by the pipeline instead of by its parent.
+    if (morsel_fed_nodes_.contains(node.id())) {
+      return Status::OK();
+    }
+
     // Update parents' children.
     for (size_t i = 0; i < parents.size(); ++i) {
       auto parent = nodes_.find(parents[i]);
@@ -202,12 +215,54 @@ class ExecutionGraph {
       if (parent == nodes_.end()) {
         return error::NotFound("Could not find parent ExecNode.");
       }
-      parent->second->AddChild(execNode, i);
+      ExecNode* parent_node = parent->second;
+      if (coalesced_nodes_.contains(node.id())) {
+        PX_ASSIGN_OR_RETURN(parent_node,
+                            AddCoalesceNode(node, input_descriptors[i], parent_node));
+      }
+      parent_node->AddChild(execNode, i);
     }
     return Status::OK();
   }
 
+  // A MemorySource -> (Map|Filter)* -> partial Agg chain of the plan fragment that is run by a
+  // MorselPipeline.
+  struct MorselPipelineSpec {
+    int64_t source_id;
+    std::vector<int64_t> chain_ids;
+    int64_t agg_id;
+  };
+
+  bool SupportsMorselExecution(const plan::AggregateOperator& agg) const;
+  std::vector<MorselPipelineSpec> FindMorselPipelines() const;
+  Status OnMorselPipelineAggregate(
+      const plan::AggregateOperator& node,
+      std::unordered_map<int64_t, table_store::schema::RowDescriptor>* descriptors);
+  StatusOr<ExecNode*> CloneMorselChainNode(
+      int64_t id,
+      const std::unordered_map<int64_t, table_store::schema::RowDescriptor>& descriptors);
+  Status CreateMorselPipeline(
+      const MorselPipelineSpec& spec,
+      const std::unordered_map<int64_t, table_store::schema::RowDescriptor>& descriptors);
+
+  // The GRPC sinks that are fed by a filter, possibly through maps, whose output is coalesced.
+  absl::flat_hash_set<int64_t> FindCoalescedSinks() const;
+  // Adds a CoalesceNode after parent, which is the node that feeds its input to the sink.
+  StatusOr<ExecNode*> AddCoalesceNode(const plan::Operator& sink_op,
+                                      const table_store::schema::RowDescriptor& descriptor,
+                                      ExecNode* parent);
+
+  // Sets up the runtime filters of the joins whose probe side is a memory source, possibly behind
+  // maps and filters that pass the join keys through.
+  void AddJoinRuntimeFilters();
+  // The running sources that should wait for the runtime filters of joins to be built.
+  absl::flat_hash_set<SourceNode*> SourcesWaitingForRuntimeFilters(
+      const absl::flat_hash_set<SourceNode*>& running_sources,
+      const absl::flat_hash_map<SourceNode*, int64_t>& source_to_id) const;
+
   Status ExecuteSources();
+  // Sends the rows that the coalescing stages have held for longer than their max delay.
+  Status FlushExpiredCoalesceNodes();
 
   ExecState* exec_state_;
   ObjectPool pool_{"exec_graph_pool"};
@@ -219,6 +274,22 @@ class ExecutionGraph {
   absl::flat_hash_set<int64_t> grpc_sinks_;
   std::unordered_map<int64_t, ExecNode*> nodes_;
 
+  // The number of threads that run each morsel pipeline. Pipelines are disabled when this is 1.
+  int32_t morsel_exec_threads_ = 1;
+  // Whether the aggregates of the morsel pipeline workers are merged without serializing them.
+  bool morsel_merge_in_process_ = true;
+  // Nodes that are not fed by their parents in the plan, because a morsel pipeline feeds them.
+  absl::flat_hash_set<int64_t> morsel_fed_nodes_;
+  // The aggregates that merge the results of a morsel pipeline.
+  absl::flat_hash_set<int64_t> morsel_merge_aggs_;
+  // Morsel pipelines, keyed by the id of the source that they scan.
+  absl::flat_hash_map<int64_t, std::unique_ptr<MorselPipeline>> morsel_pipelines_;
+  // The nodes whose input goes through a CoalesceNode, and those CoalesceNodes.
+  absl::flat_hash_set<int64_t> coalesced_nodes_;
+  std::vector<CoalesceNode*> coalesce_nodes_;
+  // Memory sources that apply the runtime filter of a join.
+  absl::flat_hash_set<int64_t> runtime_filtered_sources_;
+
   SystemTimePoint query_start_time_;
 
   // How long to wait for any upstream result to make the initial connection to this query.
@@ -20,6 +20,7 @@
 
 #include <arrow/array.h>
 #include <arrow/memory_pool.h>
+#include <map>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -66,6 +67,21 @@ class MultiplyUDF : public udf::ScalarUDF {
   }
 };
 
+class SumUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Int64Value arg) { sum_ = sum_.val + arg.val; }
+  void Merge(udf::FunctionContext*, const SumUDA& other) { sum_ = sum_.val + other.sum_.val; }
+  types::Int64Value Finalize(udf::FunctionContext*) { return sum_; }
+  types::StringValue Serialize(udf::FunctionContext*) { return absl::StrCat(sum_.val); }
+  Status Deserialize(udf::FunctionContext*, const types::StringValue& serialized) {
+    PX_UNUSED(absl::SimpleAtoi(serialized, &sum_.val));
+    return Status::OK();
+  }
+
+ protected:
+  types::Int64Value sum_ = 0;
+};
+
 class BaseExecGraphTest : public ::testing::Test {
  protected:
   void SetUpExecState() {
@@ -534,6 +550,150 @@ TEST_F(ExecGraphTest, execute_with_two_limits) {
       types::ToArrow(out_in1, arrow::default_memory_pool())));
 }
 
+constexpr char kMorselAggPlanFragment[] = R"(
+  id: 1,
+  dag {
+    nodes {
+      id: 1
+      sorted_children: 2
+    }
+    nodes {
+      id: 2
+      sorted_children: 3
+      sorted_parents: 1
+    }
+    nodes {
+      id: 3
+      sorted_parents: 2
+    }
+  }
+  nodes {
+    id: 1
+    op {
+      op_type: MEMORY_SOURCE_OPERATOR
+      mem_source_op {
+        name: "numbers"
+        column_idxs: 0
+        column_types: INT64
+        column_names: "g"
+        column_idxs: 1
+        column_types: INT64
+        column_names: "v"
+      }
+    }
+  }
+  nodes {
+    id: 2
+    op {
+      op_type: AGGREGATE_OPERATOR
+      agg_op {
+        windowed: false
+        values {
+          name: "sum"
+          id: 0
+          args {
+            column {
+              node: 1
+              index: 1
+            }
+          }
+          args_data_types: INT64
+        }
+        groups {
+          node: 1
+          index: 0
+        }
+        group_names: "g"
+        value_names: "sum"
+        partial_agg: true
+        finalize_results: true
+      }
+    }
+  }
+  nodes {
+    id: 3
+    op {
+      op_type: MEMORY_SINK_OPERATOR
+      mem_sink_op {
+        name: "output"
+        column_types: INT64
+        column_types: INT64
+        column_names: "g"
+        column_names: "sum"
+      }
+    }
+  }
+)";
+
+class MorselPipelineExecGraphTest : public ExecGraphTest,
+                                    public ::testing::WithParamInterface<bool> {};
+
+TEST_P(MorselPipelineExecGraphTest, morsel_pipeline_agg) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_morsel_exec_threads, 4);
+  // Whether the worker aggregates are merged in process or serialized.
+  PX_SET_FOR_SCOPE(FLAGS_carnot_morsel_merge_in_process, GetParam());
+  func_registry_->RegisterOrDie<SumUDA>("sum");
+
+  planpb::PlanFragment pf_pb;
+  ASSERT_TRUE(TextFormat::MergeFromString(kMorselAggPlanFragment, &pf_pb));
+  std::shared_ptr<plan::PlanFragment> plan_fragment = std::make_shared<plan::PlanFragment>(1);
+  ASSERT_OK(plan_fragment->Init(pf_pb));
+
+  auto plan_state = std::make_unique<plan::PlanState>(func_registry_.get());
+  table_store::schema::Relation rel({types::DataType::INT64, types::DataType::INT64}, {"g", "v"});
+  auto schema = std::make_shared<table_store::schema::Schema>();
+  schema->AddRelation(1, rel);
+
+  // Write enough batches for every worker to get some morsels.
+  auto table = Table::Create("numbers", rel);
+  std::map<int64_t, int64_t> expected;
+  for (int64_t batch = 0; batch < 32; ++batch) {
+    std::vector<types::Int64Value> groups;
+    std::vector<types::Int64Value> values;
+    for (int64_t i = 0; i < 10; ++i) {
+      groups.push_back(i % 3);
+      values.push_back(batch * 10 + i);
+      expected[i % 3] += batch * 10 + i;
+    }
+    auto rb = RowBatch(RowDescriptor(rel.col_types()), groups.size());
+    EXPECT_OK(rb.AddColumn(types::ToArrow(groups, arrow::default_memory_pool())));
+    EXPECT_OK(rb.AddColumn(types::ToArrow(values, arrow::default_memory_pool())));
+    EXPECT_OK(table->WriteRowBatch(rb));
+  }
+
+  auto table_store = std::make_shared<table_store::TableStore>();
+  table_store->AddTable("numbers", table);
+  auto exec_state = std::make_unique<ExecState>(
+      func_registry_.get(), table_store, MockResultSinkStubGenerator, MockMetricsStubGenerator,
+      MockTraceStubGenerator, sole::uuid4(), nullptr);
+  EXPECT_OK(exec_state->AddUDA(0, "sum", {types::DataType::INT64}));
+
+  ExecutionGraph e;
+  ASSERT_OK(e.Init(schema.get(), plan_state.get(), exec_state.get(), plan_fragment.get(),
+                   /* collect_exec_node_stats */ true));
+  // The source is scanned by the pipeline, so it doesn't feed the aggregate directly.
+  auto source = e.node(1).ConsumeValueOrDie();
+  EXPECT_EQ(0, source->children().size());
+
+  ASSERT_OK(e.Execute());
+  EXPECT_EQ(320, e.GetStats().rows_processed);
+
+  std::map<int64_t, int64_t> actual;
+  table_store::Table::Cursor cursor(exec_state->table_store()->GetTable("output"));
+  while (!cursor.Done()) {
+    auto rb = cursor.GetNextRowBatch({0, 1}).ConsumeValueOrDie();
+    for (int64_t i = 0; i < rb->num_rows(); ++i) {
+      auto group = types::GetValueFromArrowArray<types::DataType::INT64>(rb->ColumnAt(0).get(), i);
+      auto sum = types::GetValueFromArrowArray<types::DataType::INT64>(rb->ColumnAt(1).get(), i);
+      actual[group] += sum;
+    }
+  }
+  EXPECT_EQ(expected, actual);
+}
+
+INSTANTIATE_TEST_SUITE_P(MorselPipelineExecGraphTestSuite, MorselPipelineExecGraphTest,
+                         ::testing::Bool());
+
 class YieldingExecGraphTest : public BaseExecGraphTest {
  protected:
   void SetUp() { SetUpExecState(); }
@@ -18,6 +18,7 @@
 
 #include "src/carnot/exec/exec_metrics.h"
 #include <prometheus/counter.h>
+#include <prometheus/histogram.h>
 #include <string>
 
 ExecMetrics::ExecMetrics(prometheus::Registry* registry)
@@ -32,4 +33,56 @@ ExecMetrics::ExecMetrics(prometheus::Registry* registry)
               .Name("otlp_timeouts")
               .Help("Total number of timeouts which occurred when exporting data to an OTLP client")
               .Register(*registry)
-              .Add({{"name", "spans"}})) {}
+              .Add({{"name", "spans"}})),
+      query_peak_memory_bytes(
+          prometheus::BuildHistogram()
+              .Name("carnot_query_peak_memory_bytes")
+              .Help("Peak number of bytes allocated by the execution of a query")
+              .Register(*registry)
+              .Add({}, prometheus::Histogram::BucketBoundaries{
+                           64 << 10, 256 << 10, 1 << 20, 4 << 20, 16 << 20, 64 << 20, 256 << 20,
+                           1 << 30, 4.0 * (1 << 30)})),
+      spilled_bytes_counter(prometheus::BuildCounter()
+                                .Name("carnot_spilled_bytes")
+                                .Help("Total number of bytes spilled to disk by query operators")
+                                .Register(*registry)
+                                .Add({})),
+      spill_partitions_recursed_counter(
+          prometheus::BuildCounter()
+              .Name("carnot_spill_partitions_recursed")
+              .Help("Total number of spilled partitions that had to be partitioned again")
+              .Register(*registry)
+              .Add({})),
+      plan_cache_hits_counter(
+          prometheus::BuildCounter()
+              .Name("carnot_plan_cache_lookups")
+              .Help("Total number of queries that looked up their compiled plan in the cache")
+              .Register(*registry)
+              .Add({{"result", "hit"}})),
+      plan_cache_misses_counter(
+          prometheus::BuildCounter()
+              .Name("carnot_plan_cache_lookups")
+              .Help("Total number of queries that looked up their compiled plan in the cache")
+              .Register(*registry)
+              .Add({{"result", "miss"}})),
+      query_compile_time_seconds(
+          prometheus::BuildHistogram()
+              .Name("carnot_query_compile_time_seconds")
+              .Help("Time spent compiling the queries that weren't in the plan cache")
+              .Register(*registry)
+              .Add({}, prometheus::Histogram::BucketBoundaries{0.001, 0.005, 0.01, 0.025, 0.05,
+                                                               0.1, 0.25, 0.5, 1, 2.5})),
+      coalesced_batch_rows(
+          prometheus::BuildHistogram()
+              .Name("carnot_coalesced_batch_rows")
+              .Help("Number of rows of the batches sent by the coalescing stages before sinks")
+              .Register(*registry)
+              .Add({}, prometheus::Histogram::BucketBoundaries{1, 4, 16, 64, 256, 1024, 4096,
+                                                               16384})),
+      coalesced_batch_bytes(
+          prometheus::BuildHistogram()
+              .Name("carnot_coalesced_batch_bytes")
+              .Help("Number of bytes of the batches sent by the coalescing stages before sinks")
+              .Register(*registry)
+              .Add({}, prometheus::Histogram::BucketBoundaries{
+                           256, 1 << 10, 4 << 10, 16 << 10, 64 << 10, 256 << 10, 1 << 20})) {}
@@ -17,6 +17,7 @@
  */
 
 #pragma once
+#include <prometheus/histogram.h>
 #include <prometheus/registry.h>
 #include <string>
 
@@ -27,4 +28,18 @@ struct ExecMetrics {
 
   prometheus::Counter& otlp_metrics_timeout_counter;
   prometheus::Counter& otlp_spans_timeout_counter;
+  // Peak bytes allocated from the memory pool of each query.
+  prometheus::Histogram& query_peak_memory_bytes;
+  // Bytes written to disk by operators that exceeded the memory budget of their query.
+  prometheus::Counter& spilled_bytes_counter;
+  // Spilled partitions that still exceeded the budget and were partitioned again.
+  prometheus::Counter& spill_partitions_recursed_counter;
+  // Queries whose compiled plan was, or wasn't, found in the plan cache.
+  prometheus::Counter& plan_cache_hits_counter;
+  prometheus::Counter& plan_cache_misses_counter;
+  // Time spent compiling the queries that missed the plan cache.
+  prometheus::Histogram& query_compile_time_seconds;
+  // Rows and bytes of the batches output by the coalescing stages in front of sinks.
+  prometheus::Histogram& coalesced_batch_rows;
+  prometheus::Histogram& coalesced_batch_bytes;
 };
@@ -58,6 +58,19 @@ struct ExecNodeStats {
     rows_input += rb.num_rows();
   }
 
+  // Adds the input/output counters of other, e.g. a copy of the same node run by another thread.
+  void AddCounters(const ExecNodeStats& other) {
+    if (!collect_exec_stats) {
+      return;
+    }
+    batches_input += other.batches_input;
+    bytes_input += other.bytes_input;
+    rows_input += other.rows_input;
+    batches_output += other.batches_output;
+    bytes_output += other.bytes_output;
+    rows_output += other.rows_output;
+  }
+
   void ResumeChildTimer() {
     if (!collect_exec_stats) {
       return;
@@ -220,7 +233,13 @@ class ExecNode {
     }
     stats_->AddInputStats(rb);
     stats_->ResumeTotalTimer();
-    PX_RETURN_IF_ERROR(ConsumeNextImpl(exec_state, rb, parent_index));
+    if (rb.has_selection() && !HandlesSelection()) {
+      // This node needs dense data, so the selected rows are copied out here.
+      PX_ASSIGN_OR_RETURN(auto dense_rb, rb.Materialize(exec_state->exec_mem_pool()));
+      PX_RETURN_IF_ERROR(ConsumeNextImpl(exec_state, *dense_rb, parent_index));
+    } else {
+      PX_RETURN_IF_ERROR(ConsumeNextImpl(exec_state, rb, parent_index));
+    }
     stats_->StopTotalTimer();
     return Status::OK();
   }
@@ -313,6 +332,12 @@ class ExecNode {
   virtual Status ConsumeNextImpl(ExecState*, const table_store::schema::RowBatch&, size_t) {
     return error::Unimplemented("Implement in derived class (if sink or processing)");
   }
+
+  /**
+   * Whether ConsumeNextImpl handles row batches with a selection (see RowBatch::SetSelection).
+   * Nodes that don't are given a materialized copy of such batches.
+   */
+  virtual bool HandlesSelection() const { return false; }
   bool is_closed() { return is_closed_; }
 
   std::unique_ptr<table_store::schema::RowDescriptor> output_descriptor_;
@@ -29,8 +29,10 @@
 #include <sole.hpp>
 
 #include "src/carnot/carnotpb/carnot.pb.h"
+#include "src/carnot/exec/arena_memory_pool.h"
 #include "src/carnot/exec/exec_metrics.h"
 #include "src/carnot/exec/grpc_router.h"
+#include "src/carnot/exec/spill.h"
 #include "src/carnot/udf/model_pool.h"
 #include "src/carnot/udf/registry.h"
 #include "src/common/base/base.h"
@@ -82,18 +84,41 @@ class ExecState {
         model_pool_(model_pool),
         grpc_router_(grpc_router),
         add_auth_to_grpc_client_context_func_(add_auth_func),
-        exec_metrics_(exec_metrics) {}
+        exec_metrics_(exec_metrics),
+        spill_manager_(FLAGS_carnot_spill_memory_budget, FLAGS_carnot_spill_dir, exec_metrics) {
+    if (FLAGS_carnot_query_arena) {
+      arena_mem_pool_ = ArenaMemoryPool::Create();
+    }
+  }
 
   ~ExecState() {
     if (grpc_router_ != nullptr) {
       grpc_router_->DeleteQuery(query_id_);
     }
+    if (exec_metrics_ != nullptr) {
+      exec_metrics_->query_peak_memory_bytes.Observe(peak_mem_bytes());
+    }
   }
+
+  /**
+   * The pool that operators allocate the arrow buffers of the query from. When the query arena is
+   * enabled, the memory is returned all at once when the query finishes (see ArenaMemoryPool).
+   */
   arrow::MemoryPool* exec_mem_pool() {
-    // TOOD(zasgar): Make this the correct pool.
+    if (arena_mem_pool_ != nullptr) {
+      return arena_mem_pool_.get();
+    }
     return arrow::default_memory_pool();
   }
 
+  /**
+   * @return the peak number of bytes allocated from exec_mem_pool() by this query, or 0 if the
+   * query arena is disabled.
+   */
+  int64_t peak_mem_bytes() const {
+    return arena_mem_pool_ == nullptr ? 0 : arena_mem_pool_->max_memory();
+  }
+
   udf::Registry* func_registry() { return func_registry_; }
 
   table_store::TableStore* table_store() { return table_store_.get(); }
@@ -158,13 +183,20 @@ class ExecState {
     return raw;
   }
 
-  udf::ScalarUDFDefinition* GetScalarUDFDefinition(int64_t id) { return id_to_scalar_udf_map_[id]; }
+  // Lookups don't insert into the maps, so they are safe to call from parallel pipelines.
+  udf::ScalarUDFDefinition* GetScalarUDFDefinition(int64_t id) {
+    auto it = id_to_scalar_udf_map_.find(id);
+    return it == id_to_scalar_udf_map_.end() ? nullptr : it->second;
+  }
 
   std::map<int64_t, udf::ScalarUDFDefinition*> id_to_scalar_udf_map() {
     return id_to_scalar_udf_map_;
   }
 
-  udf::UDADefinition* GetUDADefinition(int64_t id) { return id_to_uda_map_[id]; }
+  udf::UDADefinition* GetUDADefinition(int64_t id) {
+    auto it = id_to_uda_map_.find(id);
+    return it == id_to_uda_map_.end() ? nullptr : it->second;
+  }
 
   std::unique_ptr<udf::FunctionContext> CreateFunctionContext() {
     auto ctx = std::make_unique<udf::FunctionContext>(metadata_state_, model_pool_);
@@ -202,6 +234,8 @@ class ExecState {
 
   ExecMetrics* exec_metrics() { return exec_metrics_; }
 
+  SpillManager* spill_manager() { return &spill_manager_; }
+
  private:
   udf::Registry* func_registry_;
   std::shared_ptr<table_store::TableStore> table_store_;
@@ -216,6 +250,8 @@ class ExecState {
   GRPCRouter* grpc_router_ = nullptr;
   std::function<void(grpc::ClientContext*)> add_auth_to_grpc_client_context_func_;
   ExecMetrics* exec_metrics_;
+  SpillManager spill_manager_;
+  ArenaMemoryPool::Ptr arena_mem_pool_;
 
   int64_t current_source_ = 0;
   bool current_source_set_ = false;
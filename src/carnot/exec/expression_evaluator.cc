@@ -37,6 +37,11 @@
 #include "src/shared/types/types.h"
 #include "src/shared/types/typespb/wrapper/types_pb_wrapper.h"
 
+DEFINE_bool(carnot_memoize_deterministic_udfs,
+            gflags::BoolFromEnv("PL_CARNOT_MEMOIZE_DETERMINISTIC_UDFS", true),
+            "Whether deterministic UDFs with a single argument, such as the metadata UDFs, are run "
+            "once per distinct value of a batch instead of once per row.");
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -133,15 +138,81 @@ std::shared_ptr<ColumnWrapper> EvalScalarToColumnWrapper(ExecState*, const plan:
   }
 }
 
+namespace {
+
+// Returns a key that's the same for sub-expressions that always evaluate to the same values, and
+// adds the function calls of the expression to funcs_by_key.
+std::string CollectFuncs(
+    const plan::ScalarExpression& expr,
+    absl::flat_hash_map<std::string, std::vector<const plan::ScalarExpression*>>* funcs_by_key) {
+  switch (expr.ExpressionType()) {
+    case plan::Expression::kConstant: {
+      const auto& val = static_cast<const plan::ScalarValue&>(expr);
+      return absl::Substitute("$0:$1", static_cast<int>(val.DataType()), val.DebugString());
+    }
+    case plan::Expression::kColumn:
+      return absl::Substitute("col:$0", static_cast<const plan::Column&>(expr).Index());
+    case plan::Expression::kFunc: {
+      const auto& fn = static_cast<const plan::ScalarFunc&>(expr);
+      std::vector<std::string> init_arg_keys;
+      for (const auto& init_arg : fn.init_arguments()) {
+        init_arg_keys.push_back(CollectFuncs(init_arg, funcs_by_key));
+      }
+      std::vector<std::string> arg_keys;
+      for (const auto& arg : fn.arg_deps()) {
+        arg_keys.push_back(CollectFuncs(*arg, funcs_by_key));
+      }
+      auto key = absl::Substitute("fn:$0[$1]($2)", fn.udf_id(), absl::StrJoin(init_arg_keys, ","),
+                                  absl::StrJoin(arg_keys, ","));
+      (*funcs_by_key)[key].push_back(&expr);
+      return key;
+    }
+    default:
+      return expr.DebugString();
+  }
+}
+
+}  // namespace
+
+void ScalarExpressionEvaluator::FindCommonSubexpressions() {
+  absl::flat_hash_map<std::string, std::vector<const plan::ScalarExpression*>> funcs_by_key;
+  for (const auto& expr : expressions_) {
+    CollectFuncs(*expr, &funcs_by_key);
+  }
+  common_subexpr_slots_.clear();
+  num_common_subexprs_ = 0;
+  for (const auto& [key, funcs] : funcs_by_key) {
+    if (funcs.size() < 2) {
+      continue;
+    }
+    for (const auto* func : funcs) {
+      common_subexpr_slots_[func] = num_common_subexprs_;
+    }
+    ++num_common_subexprs_;
+  }
+}
+
+std::shared_ptr<arrow::Array> ScalarExpressionEvaluator::ConstantArray(
+    ExecState* exec_state, const plan::ScalarValue& val, size_t count) {
+  auto& arr = constant_arrays_[&val];
+  if (arr == nullptr || static_cast<size_t>(arr->length()) < count) {
+    arr = EvalScalarToArrow(exec_state, val, count);
+  }
+  return arr;
+}
+
 Status ScalarExpressionEvaluator::Evaluate(ExecState* exec_state, const RowBatch& input,
                                            RowBatch* output) {
   CHECK(exec_state != nullptr);
   CHECK(output != nullptr);
   CHECK_EQ(static_cast<size_t>(output->num_columns()), expressions_.size());
 
+  // Common sub-expressions are shared between all of the expressions of a batch.
+  ClearBatchResults();
   for (const auto& expression : expressions_) {
     PX_RETURN_IF_ERROR(EvaluateSingleExpression(exec_state, input, *expression, output));
   }
+  ClearBatchResults();
   return Status::OK();
 }
 std::string ScalarExpressionEvaluator::DebugString() {
@@ -180,64 +251,102 @@ Status VectorNativeScalarExpressionEvaluator::Open(ExecState* exec_state) {
   for (auto expr : expressions_) {
     PX_RETURN_IF_ERROR(InitFuncsInExpression(exec_state, expr));
   }
+  FindCommonSubexpressions();
+  ClearBatchResults();
   return Status::OK();
 }
 
 Status VectorNativeScalarExpressionEvaluator::Close(ExecState*) {
-  // Nothing here yet.
+  ClearBatchResults();
+  constant_columns_.clear();
   return Status();
 }
 
+void VectorNativeScalarExpressionEvaluator::ClearBatchResults() {
+  batch_columns_.clear();
+  common_subexpr_results_.assign(num_common_subexprs_, nullptr);
+}
+
+SharedColumnWrapper VectorNativeScalarExpressionEvaluator::ConstantColumn(
+    ExecState* exec_state, const plan::ScalarValue& val, size_t count) {
+  auto& col = constant_columns_[&val];
+  if (col == nullptr || col->Size() < count) {
+    col = EvalScalarToColumnWrapper(exec_state, val, count);
+  }
+  return col;
+}
+
+StatusOr<types::SharedColumnWrapper> VectorNativeScalarExpressionEvaluator::EvaluateExpression(
+    ExecState* exec_state, const RowBatch& input, const plan::ScalarExpression& expr) {
+  size_t num_rows = input.num_column_rows();
+  switch (expr.ExpressionType()) {
+    case plan::Expression::kConstant:
+      // UDFs only read the first num_rows values of their arguments.
+      return ConstantColumn(exec_state, static_cast<const plan::ScalarValue&>(expr), num_rows);
+    case plan::Expression::kColumn: {
+      auto col_idx = static_cast<const plan::Column&>(expr).Index();
+      auto& col = batch_columns_[col_idx];
+      if (col == nullptr) {
+        col = ColumnWrapper::FromArrow(input.ColumnAt(col_idx));
+      }
+      return col;
+    }
+    case plan::Expression::kFunc:
+      break;
+    default:
+      return error::Internal("Unsupported expression: $0", expr.DebugString());
+  }
+
+  auto slot_it = common_subexpr_slots_.find(&expr);
+  if (slot_it != common_subexpr_slots_.end() &&
+      common_subexpr_results_[slot_it->second] != nullptr) {
+    return common_subexpr_results_[slot_it->second];
+  }
+
+  const auto& fn = static_cast<const plan::ScalarFunc&>(expr);
+  std::vector<types::SharedColumnWrapper> children;
+  children.reserve(fn.arg_deps().size());
+  for (const auto& arg : fn.arg_deps()) {
+    PX_ASSIGN_OR_RETURN(auto child, EvaluateExpression(exec_state, input, *arg));
+    children.push_back(std::move(child));
+  }
+
+  auto def = exec_state->GetScalarUDFDefinition(fn.udf_id());
+  auto udf = id_to_udf_map_[fn.udf_id()].get();
+
+  std::vector<const types::ColumnWrapper*> raw_children;
+  raw_children.reserve(children.size());
+  for (const auto& child : children) {
+    raw_children.emplace_back(child.get());
+  }
+  auto output = types::ColumnWrapper::Make(def->exec_return_type(), num_rows);
+  if (def->memoizable() && FLAGS_carnot_memoize_deterministic_udfs) {
+    PX_RETURN_IF_ERROR(
+        def->ExecBatchMemoized(udf, function_ctx_, raw_children, output.get(), num_rows));
+  } else {
+    PX_RETURN_IF_ERROR(def->ExecBatch(udf, function_ctx_, raw_children, output.get(), num_rows));
+  }
+  if (slot_it != common_subexpr_slots_.end()) {
+    common_subexpr_results_[slot_it->second] = output;
+  }
+  return output;
+}
+
 StatusOr<types::SharedColumnWrapper>
 VectorNativeScalarExpressionEvaluator::EvaluateSingleExpression(
     ExecState* exec_state, const RowBatch& input, const plan::ScalarExpression& expr) {
   CHECK(exec_state != nullptr);
   CHECK_GT(input.num_columns(), 0);
 
-  size_t num_rows = input.num_rows();
-
-  // Path for scalar funcs an their dependencies to get evaluated.
-  // The Arrow arrays are converted to type erased column wrappers
-  // and then evaluated.
-  plan::ExpressionWalker<types::SharedColumnWrapper> walker;
-  walker.OnScalarValue(
-      [&](const plan::ScalarValue& val,
-          const std::vector<types::SharedColumnWrapper>& children) -> types::SharedColumnWrapper {
-        DCHECK_EQ(children.size(), 0ULL);
-        return EvalScalarToColumnWrapper(exec_state, val, num_rows);
-      });
-
-  walker.OnColumn(
-      [&](const plan::Column& col,
-          const std::vector<types::SharedColumnWrapper>& children) -> types::SharedColumnWrapper {
-        DCHECK_EQ(children.size(), 0ULL);
-        return ColumnWrapper::FromArrow(input.ColumnAt(col.Index()));
-      });
-
-  walker.OnScalarFunc(
-      [&](const plan::ScalarFunc& fn,
-          const std::vector<types::SharedColumnWrapper>& children) -> types::SharedColumnWrapper {
-        std::vector<types::DataType> arg_types;
-        arg_types.reserve(children.size());
-        for (const auto& child : children) {
-          arg_types.emplace_back(child->data_type());
-        }
-
-        auto def = exec_state->GetScalarUDFDefinition(fn.udf_id());
-        auto udf = id_to_udf_map_[fn.udf_id()].get();
-
-        std::vector<const types::ColumnWrapper*> raw_children;
-        raw_children.reserve(children.size());
-        for (const auto& child : children) {
-          raw_children.emplace_back(child.get());
-        }
-        auto output = types::ColumnWrapper::Make(def->exec_return_type(), num_rows);
-        // TODO(zasgar): need a better way to handle errors.
-        PX_CHECK_OK(def->ExecBatch(udf, function_ctx_, raw_children, output.get(), num_rows));
-        return output;
-      });
-
-  return walker.Walk(expr);
+  // The result has to have exactly one row per input row, unlike the shared constant columns.
+  if (expr.ExpressionType() == plan::Expression::kConstant) {
+    return EvalScalarToColumnWrapper(exec_state, static_cast<const plan::ScalarValue&>(expr),
+                                     input.num_column_rows());
+  }
+  ClearBatchResults();
+  auto result = EvaluateExpression(exec_state, input, expr);
+  ClearBatchResults();
+  return result;
 }
 
 Status VectorNativeScalarExpressionEvaluator::EvaluateSingleExpression(
@@ -247,16 +356,15 @@ Status VectorNativeScalarExpressionEvaluator::EvaluateSingleExpression(
   CHECK(output != nullptr);
   CHECK_GT(input.num_columns(), 0);
 
-  size_t num_rows = input.num_rows();
+  size_t num_rows = input.num_column_rows();
 
   // Since this evaluator uses vectors internally and the inputs/outputs
   // always have to be arrow::arrays, we just evaluate the case where the
-  // expression is a constant/column without using the expression walker.
+  // expression is a constant/column without using the column wrappers.
   // Fast path for just having a constant.
   if (expr.ExpressionType() == plan::Expression::kConstant) {
-    auto scalar_expr = static_cast<const plan::ScalarValue&>(expr);
-    auto arr = EvalScalarToArrow(exec_state, scalar_expr, num_rows);
-    PX_RETURN_IF_ERROR(output->AddColumn(arr));
+    auto arr = ConstantArray(exec_state, static_cast<const plan::ScalarValue&>(expr), num_rows);
+    PX_RETURN_IF_ERROR(output->AddColumn(arr->Slice(0, num_rows)));
     return Status::OK();
   }
 
@@ -268,8 +376,7 @@ Status VectorNativeScalarExpressionEvaluator::EvaluateSingleExpression(
     return Status::OK();
   }
 
-  PX_ASSIGN_OR_RETURN(auto result, VectorNativeScalarExpressionEvaluator::EvaluateSingleExpression(
-                                       exec_state, input, expr));
+  PX_ASSIGN_OR_RETURN(auto result, EvaluateExpression(exec_state, input, expr));
   PX_RETURN_IF_ERROR(output->AddColumn(result->ConvertToArrow(exec_state->exec_mem_pool())));
   return Status::OK();
 }
@@ -282,61 +389,84 @@ Status ArrowNativeScalarExpressionEvaluator::Open(ExecState* exec_state) {
   for (const auto& expr : expressions_) {
     PX_RETURN_IF_ERROR(InitFuncsInExpression(exec_state, expr));
   }
+  FindCommonSubexpressions();
+  ClearBatchResults();
   return Status::OK();
 }
 Status ArrowNativeScalarExpressionEvaluator::Close(ExecState*) {
-  // Nothing here yet.
+  ClearBatchResults();
   return Status();
 }
 
+void ArrowNativeScalarExpressionEvaluator::ClearBatchResults() {
+  common_subexpr_results_.assign(num_common_subexprs_, nullptr);
+}
+
+StatusOr<std::shared_ptr<arrow::Array>> ArrowNativeScalarExpressionEvaluator::EvaluateExpression(
+    ExecState* exec_state, const RowBatch& input, const plan::ScalarExpression& expr) {
+  size_t num_rows = input.num_column_rows();
+  switch (expr.ExpressionType()) {
+    case plan::Expression::kConstant:
+      // UDFs only read the first num_rows values of their arguments.
+      return ConstantArray(exec_state, static_cast<const plan::ScalarValue&>(expr), num_rows);
+    case plan::Expression::kColumn:
+      return input.ColumnAt(static_cast<const plan::Column&>(expr).Index());
+    case plan::Expression::kFunc:
+      break;
+    default:
+      return error::Internal("Unsupported expression: $0", expr.DebugString());
+  }
+
+  auto slot_it = common_subexpr_slots_.find(&expr);
+  if (slot_it != common_subexpr_slots_.end() &&
+      common_subexpr_results_[slot_it->second] != nullptr) {
+    return common_subexpr_results_[slot_it->second];
+  }
+
+  const auto& fn = static_cast<const plan::ScalarFunc&>(expr);
+  std::vector<std::shared_ptr<arrow::Array>> children;
+  children.reserve(fn.arg_deps().size());
+  for (const auto& arg : fn.arg_deps()) {
+    PX_ASSIGN_OR_RETURN(auto child, EvaluateExpression(exec_state, input, *arg));
+    children.push_back(std::move(child));
+  }
+
+  auto def = exec_state->GetScalarUDFDefinition(fn.udf_id());
+  auto udf = id_to_udf_map_[fn.udf_id()].get();
+
+  auto output = MakeArrowBuilder(def->exec_return_type(), exec_state->exec_mem_pool());
+
+  std::vector<arrow::Array*> raw_children;
+  raw_children.reserve(children.size());
+  for (const auto& child : children) {
+    raw_children.push_back(child.get());
+  }
+
+  if (def->memoizable() && FLAGS_carnot_memoize_deterministic_udfs) {
+    PX_RETURN_IF_ERROR(
+        def->ExecBatchArrowMemoized(udf, function_ctx_, raw_children, output.get(), num_rows));
+  } else {
+    PX_RETURN_IF_ERROR(
+        def->ExecBatchArrow(udf, function_ctx_, raw_children, output.get(), num_rows));
+  }
+
+  std::shared_ptr<arrow::Array> output_array;
+  PX_RETURN_IF_ERROR(output->Finish(&output_array));
+  if (slot_it != common_subexpr_slots_.end()) {
+    common_subexpr_results_[slot_it->second] = output_array;
+  }
+  return output_array;
+}
+
 Status exec::ArrowNativeScalarExpressionEvaluator::EvaluateSingleExpression(
     exec::ExecState* exec_state, const RowBatch& input, const plan::ScalarExpression& expr,
     RowBatch* output) {
-  size_t num_rows = input.num_rows();
-  plan::ExpressionWalker<std::shared_ptr<arrow::Array>> walker;
-  walker.OnScalarValue(
-      [&](const plan::ScalarValue& val, const std::vector<std::shared_ptr<arrow::Array>>& children)
-          -> std::shared_ptr<arrow::Array> {
-        DCHECK_EQ(children.size(), 0ULL);
-        return EvalScalarToArrow(exec_state, val, num_rows);
-      });
-
-  walker.OnColumn(
-      [&](const plan::Column& col, const std::vector<std::shared_ptr<arrow::Array>>& children)
-          -> std::shared_ptr<arrow::Array> {
-        DCHECK_EQ(children.size(), 0ULL);
-        return input.ColumnAt(col.Index());
-      });
-
-  walker.OnScalarFunc(
-      [&](const plan::ScalarFunc& fn, const std::vector<std::shared_ptr<arrow::Array>>& children)
-          -> std::shared_ptr<arrow::Array> {
-        std::vector<types::DataType> arg_types;
-        arg_types.reserve(children.size());
-        for (const auto& child : children) {
-          arg_types.emplace_back(ArrowToDataType(child->type_id()));
-        }
-
-        auto def = exec_state->GetScalarUDFDefinition(fn.udf_id());
-        auto udf = id_to_udf_map_[fn.udf_id()].get();
-
-        auto output = MakeArrowBuilder(def->exec_return_type(), arrow::default_memory_pool());
-
-        std::vector<arrow::Array*> raw_children;
-        raw_children.reserve(children.size());
-        for (const auto& child : children) {
-          raw_children.push_back(child.get());
-        }
-
-        PX_CHECK_OK(def->ExecBatchArrow(udf, function_ctx_, raw_children, output.get(), num_rows));
-
-        std::shared_ptr<arrow::Array> output_array;
-        PX_CHECK_OK(output->Finish(&output_array));
-        return output_array;
-      });
-
-  PX_ASSIGN_OR_RETURN(auto result, walker.Walk(expr));
-
+  size_t num_rows = input.num_column_rows();
+  PX_ASSIGN_OR_RETURN(auto result, EvaluateExpression(exec_state, input, expr));
+  // Shared constant arrays can be longer than the batch.
+  if (static_cast<size_t>(result->length()) != num_rows) {
+    result = result->Slice(0, num_rows);
+  }
   PX_RETURN_IF_ERROR(output->AddColumn(result));
   return Status::OK();
 }
@@ -26,6 +26,8 @@
 #include <utility>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "src/carnot/exec/exec_state.h"
 #include "src/carnot/plan/scalar_expression.h"
 #include "src/carnot/udf/base.h"
@@ -34,6 +36,8 @@
 #include "src/shared/types/column_wrapper.h"
 #include "src/table_store/table_store.h"
 
+DECLARE_bool(carnot_memoize_deterministic_udfs);
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -62,7 +66,8 @@ class ExpressionEvaluator {
   virtual Status Open(ExecState* exec_state) = 0;
 
   /**
-   * Evaluate should be called once per row batch.
+   * Evaluate should be called once per row batch. Expressions are evaluated over all the rows of
+   * the input columns, the selection of the input batch (if any) is left for the caller to apply.
    * @param exec_state The execution state.
    * @param input The input RowBatch.
    * @param output A pointer to the output Rowbatch. This function expects a valid output RowBatch.
@@ -123,9 +128,24 @@ class ScalarExpressionEvaluator : public ExpressionEvaluator {
                                           table_store::schema::RowBatch* output) = 0;
   Status InitFuncsInExpression(ExecState* exec_state,
                                std::shared_ptr<const plan::ScalarExpression> expr);
+  // Drops the results that were shared between the expressions of the previous batch.
+  virtual void ClearBatchResults() = 0;
+  // Gives each function call that's in more than one place in the expressions, with the same
+  // arguments, a slot in which its result is shared within a batch.
+  void FindCommonSubexpressions();
+  // Returns an array with at least count copies of the value, which is reused across batches. It
+  // can be longer than count, so it has to be sliced before it's output.
+  std::shared_ptr<arrow::Array> ConstantArray(ExecState* exec_state, const plan::ScalarValue& val,
+                                              size_t count);
+
   plan::ConstScalarExpressionVector expressions_;
   udf::FunctionContext* function_ctx_ = nullptr;
   std::map<int64_t, std::unique_ptr<udf::ScalarUDF>> id_to_udf_map_;
+  absl::flat_hash_map<const plan::ScalarExpression*, size_t> common_subexpr_slots_;
+  size_t num_common_subexprs_ = 0;
+
+ private:
+  absl::flat_hash_map<const plan::ScalarValue*, std::shared_ptr<arrow::Array>> constant_arrays_;
 };
 
 /**
@@ -141,6 +161,9 @@ class VectorNativeScalarExpressionEvaluator : public ScalarExpressionEvaluator {
   Status Open(ExecState* exec_state) override;
   Status Close(ExecState* exec_state) override;
 
+  /**
+   * Evaluates a single expression over a batch, the result has a row for each row of the batch.
+   */
   StatusOr<types::SharedColumnWrapper> EvaluateSingleExpression(
       ExecState* exec_state, const table_store::schema::RowBatch& input,
       const plan::ScalarExpression& expr);
@@ -149,6 +172,21 @@ class VectorNativeScalarExpressionEvaluator : public ScalarExpressionEvaluator {
   Status EvaluateSingleExpression(ExecState* exec_state, const table_store::schema::RowBatch& input,
                                   const plan::ScalarExpression& expr,
                                   table_store::schema::RowBatch* output) override;
+  void ClearBatchResults() override;
+
+ private:
+  // Evaluates a sub-expression. Constants can have more rows than the batch.
+  StatusOr<types::SharedColumnWrapper> EvaluateExpression(
+      ExecState* exec_state, const table_store::schema::RowBatch& input,
+      const plan::ScalarExpression& expr);
+  types::SharedColumnWrapper ConstantColumn(ExecState* exec_state, const plan::ScalarValue& val,
+                                            size_t count);
+
+  // The input columns converted to column wrappers, and the common sub-expressions, of the
+  // current batch.
+  absl::flat_hash_map<int64_t, types::SharedColumnWrapper> batch_columns_;
+  std::vector<types::SharedColumnWrapper> common_subexpr_results_;
+  absl::flat_hash_map<const plan::ScalarValue*, types::SharedColumnWrapper> constant_columns_;
 };
 
 /**
@@ -167,6 +205,15 @@ class ArrowNativeScalarExpressionEvaluator : public ScalarExpressionEvaluator {
   Status EvaluateSingleExpression(ExecState* exec_state, const table_store::schema::RowBatch& input,
                                   const plan::ScalarExpression& expr,
                                   table_store::schema::RowBatch* output) override;
+  void ClearBatchResults() override;
+
+ private:
+  // Evaluates a sub-expression. Constants can have more rows than the batch.
+  StatusOr<std::shared_ptr<arrow::Array>> EvaluateExpression(
+      ExecState* exec_state, const table_store::schema::RowBatch& input,
+      const plan::ScalarExpression& expr);
+
+  std::vector<std::shared_ptr<arrow::Array>> common_subexpr_results_;
 };
 
 }  // namespace exec
@@ -69,9 +69,22 @@ class AddUDF : public ScalarUDF {
   Int64Value Exec(FunctionContext*, Int64Value v1, Int64Value v2) { return v1.val + v2.val; }
 };
 
+// Same as AddUDF, but executes a whole batch at a time.
+class BatchAddUDF : public ScalarUDF {
+ public:
+  Int64Value Exec(FunctionContext*, Int64Value v1, Int64Value v2) { return v1.val + v2.val; }
+  void ExecBatch(FunctionContext*, size_t count, Int64Value* out, const Int64Value* v1,
+                 const Int64Value* v2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = v1[i].val + v2[i].val;
+    }
+  }
+};
+
 // NOLINTNEXTLINE : runtime/references.
 void BM_ScalarExpressionTwoCols(benchmark::State& state,
-                                const ScalarExpressionEvaluatorType& eval_type, const char* pbtxt) {
+                                const ScalarExpressionEvaluatorType& eval_type, const char* pbtxt,
+                                bool exec_batch = false) {
   px::carnot::planpb::ScalarExpression se_pb;
   size_t data_size = state.range(0);
 
@@ -82,7 +95,11 @@ void BM_ScalarExpressionTwoCols(benchmark::State& state,
 
   auto func_registry = std::make_unique<Registry>("test_registry");
   auto table_store = std::make_shared<px::table_store::TableStore>();
-  PX_CHECK_OK(func_registry->Register<AddUDF>("add"));
+  if (exec_batch) {
+    PX_CHECK_OK(func_registry->Register<BatchAddUDF>("add"));
+  } else {
+    PX_CHECK_OK(func_registry->Register<AddUDF>("add"));
+  }
   auto exec_state = std::make_unique<ExecState>(
       func_registry.get(), table_store, MockResultSinkStubGenerator, MockMetricsStubGenerator,
       MockTraceStubGenerator, sole::uuid4(), nullptr);
@@ -112,6 +129,7 @@ void BM_ScalarExpressionTwoCols(benchmark::State& state,
     CHECK_EQ(static_cast<size_t>(output_rb.ColumnAt(0)->length()), data_size);
   }
   state.SetBytesProcessed(int64_t(state.iterations()) * 2 * in1.size() * sizeof(int64_t));
+  state.SetItemsProcessed(int64_t(state.iterations()) * in1.size());
 }
 
 BENCHMARK_CAPTURE(BM_ScalarExpressionTwoCols, eval_col_arrow,
@@ -149,3 +167,14 @@ BENCHMARK_CAPTURE(BM_ScalarExpressionTwoCols, two_cols_simple_add_vector,
                   ScalarExpressionEvaluatorType::kVectorNative, kAddScalarFuncNestedPbtxt)
     ->RangeMultiplier(2)
     ->Range(1, 1 << 16);
+
+BENCHMARK_CAPTURE(BM_ScalarExpressionTwoCols, two_cols_add_nested_vector_exec_batch,
+                  ScalarExpressionEvaluatorType::kVectorNative, kAddScalarFuncNestedPbtxt,
+                  /* exec_batch */ true)
+    ->RangeMultiplier(2)
+    ->Range(1, 1 << 16);
+BENCHMARK_CAPTURE(BM_ScalarExpressionTwoCols, two_cols_simple_add_vector_exec_batch,
+                  ScalarExpressionEvaluatorType::kVectorNative, kAddScalarFuncPbtxt,
+                  /* exec_batch */ true)
+    ->RangeMultiplier(2)
+    ->Range(1, 1 << 16);
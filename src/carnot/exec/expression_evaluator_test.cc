@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 
+#include <absl/strings/substitute.h>
 #include <google/protobuf/text_format.h>
 #include <gtest/gtest.h>
 #include <sole.hpp>
@@ -60,6 +61,29 @@ class AddUDF : public udf::ScalarUDF {
   }
 };
 
+// Counts the rows it's called on, to check that shared sub-expressions are evaluated once.
+class CountingAddUDF : public udf::ScalarUDF {
+ public:
+  types::Int64Value Exec(FunctionContext*, types::Int64Value v1, types::Int64Value v2) {
+    ++num_calls;
+    return v1.val + v2.val;
+  }
+  static int64_t num_calls;
+};
+int64_t CountingAddUDF::num_calls = 0;
+
+// A deterministic UDF that counts its calls, to check that it runs once per distinct value.
+class CountingSuffixUDF : public udf::ScalarUDF {
+ public:
+  types::StringValue Exec(FunctionContext*, types::StringValue str) {
+    ++num_calls;
+    return str + "_suffix";
+  }
+  static constexpr bool Deterministic() { return true; }
+  static int64_t num_calls;
+};
+int64_t CountingSuffixUDF::num_calls = 0;
+
 class InitArgUDF : public udf::ScalarUDF {
  public:
   Status Init(FunctionContext*, types::StringValue str, types::Int64Value i) {
@@ -116,6 +140,8 @@ class ScalarExpressionTest : public ::testing::TestWithParam<ScalarExpressionEva
 
     EXPECT_TRUE(func_registry_->Register<AddUDF>("add").ok());
     EXPECT_TRUE(func_registry_->Register<InitArgUDF>("init_arg").ok());
+    EXPECT_TRUE(func_registry_->Register<CountingAddUDF>("counting_add").ok());
+    EXPECT_TRUE(func_registry_->Register<CountingSuffixUDF>("counting_suffix").ok());
     exec_state_ = std::make_unique<ExecState>(func_registry_.get(), table_store,
                                               MockResultSinkStubGenerator, MockMetricsStubGenerator,
                                               MockTraceStubGenerator, sole::uuid4(), nullptr);
@@ -123,6 +149,10 @@ class ScalarExpressionTest : public ::testing::TestWithParam<ScalarExpressionEva
         0, "add", std::vector<types::DataType>({types::DataType::INT64, types::DataType::INT64})));
     EXPECT_OK(
         exec_state_->AddScalarUDF(1, "init_arg", {types::STRING, types::INT64, types::STRING}));
+    EXPECT_OK(exec_state_->AddScalarUDF(2, "counting_add", {types::INT64, types::INT64}));
+    EXPECT_OK(exec_state_->AddScalarUDF(3, "counting_suffix", {types::STRING}));
+    CountingAddUDF::num_calls = 0;
+    CountingSuffixUDF::num_calls = 0;
 
     std::vector<types::Int64Value> in1 = {1, 2, 3};
     std::vector<types::Int64Value> in2 = {3, 4, 5};
@@ -270,6 +300,133 @@ TEST_P(ScalarExpressionTest, eval_init_arg_udf) {
   EXPECT_EQ("init_arg, 1234, c", casted->GetString(2));
 }
 
+// add(counting_add(col0, col1), <constant>)
+constexpr char kAddCountingAddPbtxt[] = R"pb(
+func {
+  name: "add"
+  id: 0
+  args {
+    func {
+      name: "counting_add"
+      id: 2
+      args {
+        column {
+          node: 0
+          index: 0
+        }
+      }
+      args {
+        column {
+          node: 0
+          index: 1
+        }
+      }
+      args_data_types: INT64
+      args_data_types: INT64
+    }
+  }
+  args {
+    constant {
+      data_type: INT64
+      int64_value: $0
+    }
+  }
+  args_data_types: INT64
+  args_data_types: INT64
+}
+)pb";
+
+TEST_P(ScalarExpressionTest, common_subexpressions) {
+  RowDescriptor rd_output({types::DataType::INT64, types::DataType::INT64});
+  RowBatch output_rb(rd_output, input_rb_->num_rows());
+
+  auto se1 = ScalarExpressionOf(absl::Substitute(kAddCountingAddPbtxt, 10));
+  auto se2 = ScalarExpressionOf(absl::Substitute(kAddCountingAddPbtxt, 20));
+  RunEvaluator({se1, se2}, &output_rb);
+
+  // counting_add(col0, col1) is in both expressions, but only runs once per row.
+  EXPECT_EQ(3, CountingAddUDF::num_calls);
+  auto casted1 = static_cast<arrow::Int64Array*>(output_rb.ColumnAt(0).get());
+  auto casted2 = static_cast<arrow::Int64Array*>(output_rb.ColumnAt(1).get());
+  EXPECT_EQ(14, casted1->Value(0));
+  EXPECT_EQ(26, casted2->Value(1));
+  EXPECT_EQ(28, casted2->Value(2));
+}
+
+TEST_P(ScalarExpressionTest, constants_across_batches) {
+  function_ctx_ = std::make_unique<udf::FunctionContext>(nullptr, nullptr);
+  auto evaluator = ScalarExpressionEvaluator::Create(
+      {ScalarExpressionOf(kAddScalarFuncConstPbtxt), Int64ConstScalarExpr()}, GetParam(),
+      function_ctx_.get());
+  ASSERT_OK(evaluator->Open(exec_state_.get()));
+
+  RowDescriptor rd_output({types::DataType::INT64, types::DataType::INT64});
+  RowBatch output_rb(rd_output, input_rb_->num_rows());
+  ASSERT_OK(evaluator->Evaluate(exec_state_.get(), *input_rb_, &output_rb));
+
+  // A smaller batch reuses the constant of the first batch, and only gets its own rows.
+  RowDescriptor rd_input({types::DataType::INT64});
+  RowBatch small_rb(rd_input, 1);
+  ASSERT_OK(small_rb.AddColumn(ToArrow(std::vector<types::Int64Value>{5},
+                                       arrow::default_memory_pool())));
+  RowBatch small_output_rb(rd_output, 1);
+  ASSERT_OK(evaluator->Evaluate(exec_state_.get(), small_rb, &small_output_rb));
+  ASSERT_OK(evaluator->Close(exec_state_.get()));
+
+  ASSERT_EQ(1, small_output_rb.ColumnAt(0)->length());
+  ASSERT_EQ(1, small_output_rb.ColumnAt(1)->length());
+  EXPECT_EQ(1342, static_cast<arrow::Int64Array*>(small_output_rb.ColumnAt(0).get())->Value(0));
+  EXPECT_EQ(1337, static_cast<arrow::Int64Array*>(small_output_rb.ColumnAt(1).get())->Value(0));
+}
+
+constexpr char kCountingSuffixPbtxt[] = R"pb(
+func {
+  name: "counting_suffix"
+  id: 3
+  args {
+    column {
+      node: 0
+      index: 0
+    }
+  }
+  args_data_types: STRING
+})pb";
+
+TEST_P(ScalarExpressionTest, memoized_deterministic_udf) {
+  RowDescriptor rd({types::DataType::STRING});
+  input_rb_ = std::make_unique<RowBatch>(rd, 6);
+  ASSERT_OK(input_rb_->AddColumn(
+      ToArrow(std::vector<types::StringValue>{"a", "b", "a", "a", "b", "a"},
+              arrow::default_memory_pool())));
+
+  RowBatch output_rb(rd, input_rb_->num_rows());
+  RunEvaluator({ScalarExpressionOf(kCountingSuffixPbtxt)}, &output_rb);
+
+  EXPECT_EQ(2, CountingSuffixUDF::num_calls);
+  auto out = output_rb.ColumnAt(0);
+  ASSERT_EQ(6, out->length());
+  std::vector<std::string> expected = {"a_suffix", "b_suffix", "a_suffix",
+                                       "a_suffix", "b_suffix", "a_suffix"};
+  for (int64_t i = 0; i < out->length(); ++i) {
+    EXPECT_EQ(expected[i], types::GetValueFromArrowArray<types::DataType::STRING>(out.get(), i));
+  }
+}
+
+TEST_P(ScalarExpressionTest, memoization_disabled) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_memoize_deterministic_udfs, false);
+  RowDescriptor rd({types::DataType::STRING});
+  input_rb_ = std::make_unique<RowBatch>(rd, 4);
+  ASSERT_OK(input_rb_->AddColumn(ToArrow(std::vector<types::StringValue>{"a", "a", "a", "b"},
+                                         arrow::default_memory_pool())));
+
+  RowBatch output_rb(rd, input_rb_->num_rows());
+  RunEvaluator({ScalarExpressionOf(kCountingSuffixPbtxt)}, &output_rb);
+
+  EXPECT_EQ(4, CountingSuffixUDF::num_calls);
+  EXPECT_EQ("b_suffix",
+            types::GetValueFromArrowArray<types::DataType::STRING>(output_rb.ColumnAt(0).get(), 3));
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -39,6 +39,13 @@
 #include "src/shared/types/types.h"
 #include "src/shared/types/typespb/wrapper/types_pb_wrapper.h"
 
+DEFINE_double(carnot_filter_selection_min_selectivity,
+              gflags::DoubleFromEnv("PL_CARNOT_FILTER_SELECTION_MIN_SELECTIVITY", 0.25),
+              "Filters that keep at least this fraction of the rows of a batch forward the input "
+              "columns with a selection instead of copying the rows that pass. Below it, copying "
+              "the few remaining rows is cheaper than having the downstream nodes skip over the "
+              "filtered ones. Values above 1 disable selections.");
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -77,11 +84,11 @@ Status FilterNode::CloseImpl(ExecState* exec_state) {
 
 template <types::DataType T>
 Status PredicateCopyValues(const types::BoolValueColumnWrapper& pred, const arrow::Array* input_col,
-                           RowBatch* output_rb) {
+                           arrow::MemoryPool* mem_pool, RowBatch* output_rb) {
   DCHECK_EQ(pred.Size(), static_cast<size_t>(input_col->length()));
   size_t num_output_records = output_rb->num_rows();
   size_t num_input_records = input_col->length();
-  auto output_col_builder_generic = MakeArrowBuilder(T, arrow::default_memory_pool());
+  auto output_col_builder_generic = MakeArrowBuilder(T, mem_pool);
   auto* output_col_builder = static_cast<typename types::DataTypeTraits<T>::arrow_builder_type*>(
       output_col_builder_generic.get());
   PX_RETURN_IF_ERROR(output_col_builder->Reserve(num_output_records));
@@ -98,7 +105,8 @@ Status PredicateCopyValues(const types::BoolValueColumnWrapper& pred, const arro
 
 template <>
 Status PredicateCopyValues<types::STRING>(const types::BoolValueColumnWrapper& pred,
-                                          const arrow::Array* input_col, RowBatch* output_rb) {
+                                          const arrow::Array* input_col,
+                                          arrow::MemoryPool* mem_pool, RowBatch* output_rb) {
   DCHECK_EQ(pred.Size(), static_cast<size_t>(input_col->length()));
   size_t num_output_records = output_rb->num_rows();
   size_t num_input_records = input_col->length();
@@ -106,7 +114,7 @@ Status PredicateCopyValues<types::STRING>(const types::BoolValueColumnWrapper& p
       100;  // This can be an arbritrary number, since we do exponential doubling below.
   size_t total_size = 0;
 
-  auto output_col_builder_generic = MakeArrowBuilder(types::STRING, arrow::default_memory_pool());
+  auto output_col_builder_generic = MakeArrowBuilder(types::STRING, mem_pool);
   auto* output_col_builder = static_cast<types::DataTypeTraits<types::STRING>::arrow_builder_type*>(
       output_col_builder_generic.get());
 
@@ -129,7 +137,44 @@ Status PredicateCopyValues<types::STRING>(const types::BoolValueColumnWrapper& p
   return Status::OK();
 }
 
+std::shared_ptr<std::vector<uint32_t>> FilterNode::SelectRows(
+    const types::BoolValueColumnWrapper& pred, const RowBatch& rb) {
+  auto selection = std::make_shared<std::vector<uint32_t>>();
+  if (rb.has_selection()) {
+    // Only the rows that were already selected can pass.
+    const auto& input_selection = rb.selection();
+    selection->resize(input_selection.size());
+    size_t num_selected = 0;
+    for (uint32_t row : input_selection) {
+      (*selection)[num_selected] = row;
+      num_selected += pred[row].val;
+    }
+    selection->resize(num_selected);
+    return selection;
+  }
+  size_t num_rows = pred.Size();
+  selection->resize(num_rows);
+  size_t num_selected = 0;
+  // Write every row and only advance past the ones that pass, which avoids a branch per row.
+  for (size_t row = 0; row < num_rows; ++row) {
+    (*selection)[num_selected] = row;
+    num_selected += pred[row].val;
+  }
+  selection->resize(num_selected);
+  return selection;
+}
+
 Status FilterNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  if (rb.has_selection() &&
+      plan_node_->expression()->ExpressionType() == plan::Expression::kFunc) {
+    // Gather the selected rows first, so that the predicate UDFs only run over those.
+    PX_ASSIGN_OR_RETURN(auto dense_rb, rb.Materialize(exec_state->exec_mem_pool()));
+    return FilterBatch(exec_state, *dense_rb);
+  }
+  return FilterBatch(exec_state, rb);
+}
+
+Status FilterNode::FilterBatch(ExecState* exec_state, const RowBatch& rb) {
   // Current implementation does not merge across row batches, we should
   // consider this for cases where the filter has really low selectivity.
   PX_ASSIGN_OR_RETURN(auto pred_col, evaluator_->EvaluateSingleExpression(
@@ -142,24 +187,40 @@ Status FilterNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, si
       *static_cast<types::BoolValueColumnWrapper*>(pred_col.get());
   size_t num_pred = pred_col_wrapper.Size();
 
-  DCHECK_EQ(static_cast<size_t>(rb.num_rows()), num_pred);
+  DCHECK_EQ(static_cast<size_t>(rb.num_column_rows()), num_pred);
+  DCHECK_EQ(output_descriptor_->size(), plan_node_->selected_cols().size());
 
-  // Find out how many of them returned true;
-  size_t num_output_records = 0;
-  for (size_t i = 0; i < num_pred; ++i) {
-    if (pred_col_wrapper[i].val) {
-      ++num_output_records;
+  auto selection = SelectRows(pred_col_wrapper, rb);
+  size_t num_output_records = selection->size();
+  // The density is relative to the length of the columns, which the downstream nodes skip over.
+  bool keep_selection =
+      num_output_records >= FLAGS_carnot_filter_selection_min_selectivity * num_pred;
+  if (keep_selection || rb.has_selection()) {
+    // Forward the input columns as is, restricted to the rows that passed.
+    RowBatch selected_rb(*output_descriptor_, rb.num_column_rows());
+    for (auto input_col_idx : plan_node_->selected_cols()) {
+      PX_RETURN_IF_ERROR(selected_rb.AddColumn(rb.ColumnAt(input_col_idx)));
+    }
+    if (num_output_records < num_pred) {
+      selected_rb.SetSelection(std::move(selection));
     }
+    selected_rb.set_eow(rb.eow());
+    selected_rb.set_eos(rb.eos());
+    if (keep_selection) {
+      return SendRowBatchToChildren(exec_state, selected_rb);
+    }
+    // The selection got too sparse, so copy the few remaining rows.
+    PX_ASSIGN_OR_RETURN(auto output_rb, selected_rb.Materialize(exec_state->exec_mem_pool()));
+    return SendRowBatchToChildren(exec_state, *output_rb);
   }
 
   RowBatch output_rb(*output_descriptor_, num_output_records);
-  DCHECK_EQ(output_descriptor_->size(), plan_node_->selected_cols().size());
-
   for (const auto& [output_col_idx, input_col_idx] : Enumerate(plan_node_->selected_cols())) {
     auto input_col = rb.ColumnAt(input_col_idx);
     auto col_type = output_descriptor_->type(output_col_idx);
-#define TYPE_CASE(_dt_) \
-  PX_RETURN_IF_ERROR(PredicateCopyValues<_dt_>(pred_col_wrapper, input_col.get(), &output_rb));
+#define TYPE_CASE(_dt_)                                                           \
+  PX_RETURN_IF_ERROR(PredicateCopyValues<_dt_>(pred_col_wrapper, input_col.get(), \
+                                               exec_state->exec_mem_pool(), &output_rb));
     PX_SWITCH_FOREACH_DATATYPE(col_type, TYPE_CASE);
 #undef TYPE_CASE
   }
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 #include <memory>
 #include <string>
 #include <vector>
@@ -30,8 +31,11 @@
 #include "src/carnot/udf/base.h"
 #include "src/common/base/base.h"
 #include "src/common/base/status.h"
+#include "src/shared/types/column_wrapper.h"
 #include "src/table_store/table_store.h"
 
+DECLARE_double(carnot_filter_selection_min_selectivity);
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -49,8 +53,16 @@ class FilterNode : public ProcessingNode {
   Status CloseImpl(ExecState* exec_state) override;
   Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
                          size_t parent_index) override;
+  bool HandlesSelection() const override { return true; }
 
  private:
+  // Evaluates the predicate over all the column rows of rb and sends the rows that pass.
+  Status FilterBatch(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  // Returns the rows of the input columns that pass the predicate, out of the rows that are
+  // selected in rb.
+  static std::shared_ptr<std::vector<uint32_t>> SelectRows(
+      const types::BoolValueColumnWrapper& pred, const table_store::schema::RowBatch& rb);
+
   std::unique_ptr<VectorNativeScalarExpressionEvaluator> evaluator_;
   std::unique_ptr<plan::FilterOperator> plan_node_;
   std::unique_ptr<udf::FunctionContext> function_ctx_;
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sole.hpp>
+
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/filter_node.h"
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/planpb/test_proto.h"
+#include "src/carnot/udf/registry.h"
+#include "src/carnot/udf/udf.h"
+#include "src/common/base/base.h"
+#include "src/common/testing/test_environment.h"
+#include "src/datagen/datagen.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/table_store.h"
+
+using px::carnot::exec::ExecState;
+using px::carnot::exec::FakePlanNode;
+using px::carnot::exec::FilterNode;
+using px::carnot::exec::MockMetricsStubGenerator;
+using px::carnot::exec::MockResultSinkStubGenerator;
+using px::carnot::exec::MockTraceStubGenerator;
+using px::carnot::udf::FunctionContext;
+using px::carnot::udf::Registry;
+using px::carnot::udf::ScalarUDF;
+using px::table_store::schema::RowBatch;
+using px::table_store::schema::RowDescriptor;
+using px::types::BoolValue;
+using px::types::DataType;
+using px::types::Int64Value;
+using px::types::StringValue;
+using px::types::ToArrow;
+
+class EqUDF : public ScalarUDF {
+ public:
+  BoolValue Exec(FunctionContext*, Int64Value v1, Int64Value v2) { return v1.val == v2.val; }
+};
+
+// Sums the second column of the selected rows, standing in for a partial aggregate downstream of
+// the filter.
+class SumNode : public px::carnot::exec::ProcessingNode {
+ public:
+  int64_t sum() const { return sum_; }
+
+ protected:
+  std::string DebugStringImpl() override { return "SumNode"; }
+  px::Status InitImpl(const px::carnot::plan::Operator&) override { return px::Status::OK(); }
+  px::Status PrepareImpl(ExecState*) override { return px::Status::OK(); }
+  px::Status OpenImpl(ExecState*) override { return px::Status::OK(); }
+  px::Status CloseImpl(ExecState*) override { return px::Status::OK(); }
+  px::Status ConsumeNextImpl(ExecState*, const RowBatch& rb, size_t) override {
+    auto col = static_cast<arrow::Int64Array*>(rb.ColumnAt(1).get());
+    if (!rb.has_selection()) {
+      for (int64_t i = 0; i < col->length(); ++i) {
+        sum_ += col->Value(i);
+      }
+      return px::Status::OK();
+    }
+    for (uint32_t row : rb.selection()) {
+      sum_ += col->Value(row);
+    }
+    return px::Status::OK();
+  }
+  bool HandlesSelection() const override { return true; }
+
+ private:
+  int64_t sum_ = 0;
+};
+
+// Measures filter throughput as a function of selectivity (percent of rows passing), either
+// forwarding the rows that pass as a selection or copying them into a new batch.
+// NOLINTNEXTLINE : runtime/references.
+void BM_FilterSelectivity(benchmark::State& state, bool use_selection) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_filter_selection_min_selectivity, use_selection ? 0.0 : 2.0);
+  size_t num_rows = state.range(0);
+  int64_t selectivity = state.range(1);
+
+  auto func_registry = std::make_unique<Registry>("test_registry");
+  PX_CHECK_OK(func_registry->Register<EqUDF>("eq"));
+  auto table_store = std::make_shared<px::table_store::TableStore>();
+  auto exec_state = std::make_unique<ExecState>(
+      func_registry.get(), table_store, MockResultSinkStubGenerator, MockMetricsStubGenerator,
+      MockTraceStubGenerator, sole::uuid4(), nullptr);
+  PX_CHECK_OK(exec_state->AddScalarUDF(0, "eq", std::vector<DataType>({DataType::INT64,
+                                                                        DataType::INT64})));
+
+  // The filter keeps the rows where the first column equals 1.
+  std::vector<Int64Value> keys(num_rows);
+  for (size_t i = 0; i < num_rows; ++i) {
+    keys[i] = static_cast<int64_t>(i % 100) < selectivity ? 1 : 0;
+  }
+  auto values = px::datagen::CreateLargeData<Int64Value>(num_rows);
+  std::vector<StringValue> strings(num_rows);
+  for (auto& s : strings) {
+    s = px::datagen::RandomString(16);
+  }
+
+  RowDescriptor rd({DataType::INT64, DataType::INT64, DataType::STRING});
+  RowBatch input_rb(rd, num_rows);
+  PX_CHECK_OK(input_rb.AddColumn(ToArrow(keys, arrow::default_memory_pool())));
+  PX_CHECK_OK(input_rb.AddColumn(ToArrow(values, arrow::default_memory_pool())));
+  PX_CHECK_OK(input_rb.AddColumn(ToArrow(strings, arrow::default_memory_pool())));
+
+  auto plan_node = px::carnot::plan::FilterOperator::FromProto(
+      px::carnot::planpb::testutils::CreateTestFilterTwoCols(), /*id*/ 1);
+  FilterNode filter;
+  SumNode sum;
+  filter.AddChild(&sum, 0);
+  PX_CHECK_OK(filter.Init(*plan_node, rd, {rd}));
+  PX_CHECK_OK(filter.Prepare(exec_state.get()));
+  PX_CHECK_OK(filter.Open(exec_state.get()));
+  FakePlanNode fake_plan(2);
+  PX_CHECK_OK(sum.Init(fake_plan, RowDescriptor({}), {rd}));
+  PX_CHECK_OK(sum.Prepare(exec_state.get()));
+  PX_CHECK_OK(sum.Open(exec_state.get()));
+
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    PX_CHECK_OK(filter.ConsumeNext(exec_state.get(), input_rb, 0));
+  }
+  benchmark::DoNotOptimize(sum.sum());
+  PX_CHECK_OK(filter.Close(exec_state.get()));
+  PX_CHECK_OK(sum.Close(exec_state.get()));
+  state.SetItemsProcessed(int64_t(state.iterations()) * num_rows);
+}
+
+void SelectivityArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t num_rows : {1 << 10, 1 << 16}) {
+    for (int64_t selectivity : {1, 5, 10, 25, 50, 75, 100}) {
+      b->Args({num_rows, selectivity});
+    }
+  }
+}
+
+BENCHMARK_CAPTURE(BM_FilterSelectivity, selection, /* use_selection */ true)
+    ->Apply(SelectivityArgs);
+BENCHMARK_CAPTURE(BM_FilterSelectivity, copy, /* use_selection */ false)->Apply(SelectivityArgs);
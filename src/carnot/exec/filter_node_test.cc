@@ -41,8 +41,11 @@ using udf::FunctionContext;
 class EqUDF : public udf::ScalarUDF {
  public:
   types::BoolValue Exec(FunctionContext*, types::Int64Value v1, types::Int64Value v2) {
+    ++num_calls;
     return v1.val == v2.val;
   }
+
+  static inline int64_t num_calls = 0;
 };
 
 class StrEqUDF : public udf::ScalarUDF {
@@ -187,6 +190,88 @@ TEST_F(FilterNodeTest, zero_row_row_batch) {
       .Close();
 }
 
+TEST_F(FilterNodeTest, input_with_selection) {
+  auto op_proto = planpb::testutils::CreateTestFilterTwoCols();
+  plan_node_ = plan::FilterOperator::FromProto(op_proto, /*id*/ 1);
+
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor output_rd(
+      {types::DataType::INT64, types::DataType::INT64, types::DataType::STRING});
+
+  auto input_rb = RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                      .AddColumn<types::Int64Value>({1, 1, 3, 1})
+                      .AddColumn<types::Int64Value>({1, 3, 6, 9})
+                      .AddColumn<types::StringValue>({"ABC", "DEF", "HELLO", "WORLD"})
+                      .get();
+  // The first row would pass the filter, but it was already filtered out upstream.
+  input_rb.SetSelection(std::make_shared<std::vector<uint32_t>>(std::vector<uint32_t>{1, 2, 3}));
+
+  auto tester = exec::ExecNodeTester<FilterNode, plan::FilterOperator>(
+      *plan_node_, output_rd, {input_rd}, exec_state_.get());
+  tester.ConsumeNext(input_rb, 0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, true, true)
+                          .AddColumn<types::Int64Value>({1, 1})
+                          .AddColumn<types::Int64Value>({3, 9})
+                          .AddColumn<types::StringValue>({"DEF", "WORLD"})
+                          .get())
+      .Close();
+}
+
+TEST_F(FilterNodeTest, predicate_only_evaluated_on_selected_rows) {
+  auto op_proto = planpb::testutils::CreateTestFilterTwoCols();
+  plan_node_ = plan::FilterOperator::FromProto(op_proto, /*id*/ 1);
+
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor output_rd(
+      {types::DataType::INT64, types::DataType::INT64, types::DataType::STRING});
+
+  auto input_rb = RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                      .AddColumn<types::Int64Value>({1, 1, 3, 1})
+                      .AddColumn<types::Int64Value>({1, 3, 6, 9})
+                      .AddColumn<types::StringValue>({"ABC", "DEF", "HELLO", "WORLD"})
+                      .get();
+  input_rb.SetSelection(std::make_shared<std::vector<uint32_t>>(std::vector<uint32_t>{2, 3}));
+
+  EqUDF::num_calls = 0;
+  auto tester = exec::ExecNodeTester<FilterNode, plan::FilterOperator>(
+      *plan_node_, output_rd, {input_rd}, exec_state_.get());
+  tester.ConsumeNext(input_rb, 0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, true, true)
+                          .AddColumn<types::Int64Value>({1})
+                          .AddColumn<types::Int64Value>({9})
+                          .AddColumn<types::StringValue>({"WORLD"})
+                          .get())
+      .Close();
+  EXPECT_EQ(2, EqUDF::num_calls);
+}
+
+TEST_F(FilterNodeTest, copy_below_min_selectivity) {
+  // Forces the filter to copy the rows that pass instead of forwarding a selection.
+  PX_SET_FOR_SCOPE(FLAGS_carnot_filter_selection_min_selectivity, 2.0);
+  auto op_proto = planpb::testutils::CreateTestFilterTwoCols();
+  plan_node_ = plan::FilterOperator::FromProto(op_proto, /*id*/ 1);
+
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor output_rd(
+      {types::DataType::INT64, types::DataType::INT64, types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<FilterNode, plan::FilterOperator>(
+      *plan_node_, output_rd, {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::Int64Value>({1, 1, 3, 4})
+                       .AddColumn<types::Int64Value>({1, 3, 6, 9})
+                       .AddColumn<types::StringValue>({"ABC", "DEF", "HELLO", "WORLD"})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, true, true)
+                          .AddColumn<types::Int64Value>({1, 1})
+                          .AddColumn<types::Int64Value>({1, 3})
+                          .AddColumn<types::StringValue>({"ABC", "DEF"})
+                          .get())
+      .Close();
+}
+
 TEST_F(FilterNodeTest, string_pred) {
   auto op_proto = planpb::testutils::CreateTestFilterTwoColsString();
   plan_node_ = plan::FilterOperator::FromProto(op_proto, /*id*/ 1);
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/group_index.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+std::unique_ptr<GroupIndex> GroupIndex::Create(const std::vector<types::DataType>& key_types) {
+  if (key_types.size() == 1) {
+    switch (key_types[0]) {
+      case types::DataType::INT64:
+        return std::make_unique<TypedGroupIndex<Int64GroupKey<types::DataType::INT64>>>();
+      case types::DataType::TIME64NS:
+        return std::make_unique<TypedGroupIndex<Int64GroupKey<types::DataType::TIME64NS>>>();
+      case types::DataType::STRING:
+        return std::make_unique<TypedGroupIndex<StringGroupKey>>();
+      default:
+        return nullptr;
+    }
+  }
+  if (key_types.size() == 2 && key_types[0] == types::DataType::UINT128 &&
+      key_types[1] == types::DataType::STRING) {
+    return std::make_unique<TypedGroupIndex<UInt128StringGroupKey>>();
+  }
+  return nullptr;
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,358 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <farmhash.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <absl/numeric/int128.h>
+
+#include "src/common/base/base.h"
+#include "src/common/base/hash_utils.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * StringArena owns the bytes of the string group keys. Strings are copied into large blocks, so
+ * that a group key doesn't need its own heap allocation.
+ */
+class StringArena {
+ public:
+  std::string_view Add(std::string_view s) {
+    if (s.empty()) {
+      return std::string_view();
+    }
+    if (block_used_ + s.size() > block_size_) {
+      block_size_ = std::max(kBlockSize, s.size());
+      blocks_.push_back(std::make_unique<char[]>(block_size_));
+      block_used_ = 0;
+      bytes_allocated_ += block_size_;
+    }
+    char* dst = blocks_.back().get() + block_used_;
+    std::memcpy(dst, s.data(), s.size());
+    block_used_ += s.size();
+    return std::string_view(dst, s.size());
+  }
+
+  void Clear() {
+    blocks_.clear();
+    block_used_ = 0;
+    block_size_ = 0;
+    bytes_allocated_ = 0;
+  }
+
+  int64_t bytes_allocated() const { return bytes_allocated_; }
+
+ private:
+  static constexpr size_t kBlockSize = 64 * 1024;
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  size_t block_used_ = 0;
+  size_t block_size_ = 0;
+  int64_t bytes_allocated_ = 0;
+};
+
+namespace internal {
+
+// Finalizer of MurmurHash3, good enough to spread integer keys across the table.
+inline uint64_t HashInt64(uint64_t k) {
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+inline uint64_t HashString(std::string_view s) { return ::util::Hash64(s.data(), s.size()); }
+
+}  // namespace internal
+
+/**
+ * Key shapes that the GroupIndex is specialized for. Each one describes how to read the keys of a
+ * batch (and hash them), how to keep a key once it becomes a group and how to write it out.
+ * ReadBatch reads `count` keys, the i-th one from row `row(i)` of the key columns.
+ */
+template <types::DataType DT>
+struct Int64GroupKey {
+  static_assert(DT == types::DataType::INT64 || DT == types::DataType::TIME64NS);
+  using ArrowArrayType = typename types::DataTypeTraits<DT>::arrow_array_type;
+  using ArrowBuilderType = typename types::DataTypeTraits<DT>::arrow_builder_type;
+  using ViewType = int64_t;
+  static constexpr size_t kNumColumns = 1;
+
+  template <typename TRowFn>
+  static void ReadBatch(const std::vector<const arrow::Array*>& cols, int64_t count, TRowFn row,
+                        ViewType* keys, uint64_t* hashes) {
+    const int64_t* values = static_cast<const ArrowArrayType*>(cols[0])->raw_values();
+    for (int64_t i = 0; i < count; ++i) {
+      keys[i] = values[row(i)];
+      hashes[i] = internal::HashInt64(static_cast<uint64_t>(keys[i]));
+    }
+  }
+  static ViewType Store(ViewType key, StringArena*) { return key; }
+  static Status Append(ViewType key, const std::vector<arrow::ArrayBuilder*>& builders) {
+    PX_RETURN_IF_ERROR(static_cast<ArrowBuilderType*>(builders[0])->Append(key));
+    return Status::OK();
+  }
+};
+
+struct StringGroupKey {
+  using ViewType = std::string_view;
+  static constexpr size_t kNumColumns = 1;
+
+  template <typename TRowFn>
+  static void ReadBatch(const std::vector<const arrow::Array*>& cols, int64_t count, TRowFn row,
+                        ViewType* keys, uint64_t* hashes) {
+    for (int64_t i = 0; i < count; ++i) {
+      keys[i] = types::GetStringViewFromArrowArray(cols[0], row(i));
+      hashes[i] = internal::HashString(keys[i]);
+    }
+  }
+  static ViewType Store(ViewType key, StringArena* arena) { return arena->Add(key); }
+  static Status Append(ViewType key, const std::vector<arrow::ArrayBuilder*>& builders) {
+    PX_RETURN_IF_ERROR(static_cast<arrow::StringBuilder*>(builders[0])
+                           ->Append(key.data(), static_cast<int32_t>(key.size())));
+    return Status::OK();
+  }
+};
+
+// The (upid, string) pair is the most common key of the metadata-heavy scripts.
+struct UInt128StringGroupKey {
+  struct ViewType {
+    absl::uint128 id;
+    std::string_view str;
+    bool operator==(const ViewType& other) const { return id == other.id && str == other.str; }
+  };
+  static constexpr size_t kNumColumns = 2;
+
+  template <typename TRowFn>
+  static void ReadBatch(const std::vector<const arrow::Array*>& cols, int64_t count, TRowFn row,
+                        ViewType* keys, uint64_t* hashes) {
+    for (int64_t i = 0; i < count; ++i) {
+      int64_t r = row(i);
+      types::UInt128Value id = types::GetValueFromArrowArray<types::DataType::UINT128>(cols[0], r);
+      keys[i].id = id.val;
+      keys[i].str = types::GetStringViewFromArrowArray(cols[1], r);
+      uint64_t id_hash = ::px::HashCombine(internal::HashInt64(absl::Uint128High64(id.val)),
+                                           internal::HashInt64(absl::Uint128Low64(id.val)));
+      hashes[i] = ::px::HashCombine(id_hash, internal::HashString(keys[i].str));
+    }
+  }
+  static ViewType Store(const ViewType& key, StringArena* arena) {
+    return ViewType{key.id, arena->Add(key.str)};
+  }
+  static Status Append(const ViewType& key, const std::vector<arrow::ArrayBuilder*>& builders) {
+    PX_RETURN_IF_ERROR(static_cast<arrow::UInt128Builder*>(builders[0])->Append(key.id));
+    PX_RETURN_IF_ERROR(static_cast<arrow::StringBuilder*>(builders[1])
+                           ->Append(key.str.data(), static_cast<int32_t>(key.str.size())));
+    return Status::OK();
+  }
+};
+
+/**
+ * GroupIndex maps the group keys of a batch to dense group ids, which are assigned in the order
+ * the groups are first seen. It replaces a hash map of RowTuples for the key shapes it supports:
+ * keys are hashed a whole column at a time, looked up in an open addressing table and stored
+ * inline (strings in an arena) instead of in a heap allocated tuple per row.
+ */
+class GroupIndex {
+ public:
+  virtual ~GroupIndex() = default;
+
+  /**
+   * Creates a GroupIndex specialized for the given key types.
+   * @return the index, or nullptr if the key shape is not supported.
+   */
+  static std::unique_ptr<GroupIndex> Create(const std::vector<types::DataType>& key_types);
+
+  /**
+   * Looks up the group of every row of the key columns, adding the groups that don't exist yet.
+   * @param key_cols The key columns, in the order of the key types.
+   * @param num_rows The number of rows in the key columns.
+   * @param group_ids Output with the group id of every row.
+   */
+  virtual void FindOrInsertBatch(const std::vector<const arrow::Array*>& key_cols,
+                                 int64_t num_rows, std::vector<uint32_t>* group_ids) = 0;
+
+  /**
+   * Same as FindOrInsertBatch, but only for the given rows of the key columns.
+   * @param selection The rows to look up.
+   * @param group_ids Output with the group id of every selected row, in the order of selection.
+   */
+  virtual void FindOrInsertSelected(const std::vector<const arrow::Array*>& key_cols,
+                                    const std::vector<uint32_t>& selection,
+                                    std::vector<uint32_t>* group_ids) = 0;
+
+  /**
+   * Appends the keys of all groups, in group id order, to one builder per key column.
+   */
+  virtual Status AppendKeys(const std::vector<arrow::ArrayBuilder*>& builders) const = 0;
+
+  /**
+   * Appends the keys of the given groups, in the given order, to one builder per key column.
+   */
+  virtual Status AppendKeys(const std::vector<uint32_t>& group_ids,
+                            const std::vector<arrow::ArrayBuilder*>& builders) const = 0;
+
+  // The hash of the key of a group.
+  virtual uint64_t hash(uint32_t group_id) const = 0;
+  virtual size_t num_groups() const = 0;
+  // The number of bytes held by the index.
+  virtual int64_t bytes() const = 0;
+  virtual void Clear() = 0;
+};
+
+template <typename TKey>
+class TypedGroupIndex final : public GroupIndex {
+  using ViewType = typename TKey::ViewType;
+
+ public:
+  TypedGroupIndex() { Clear(); }
+
+  void FindOrInsertBatch(const std::vector<const arrow::Array*>& key_cols, int64_t num_rows,
+                         std::vector<uint32_t>* group_ids) override {
+    FindOrInsertRows(
+        key_cols, num_rows, [](int64_t i) { return i; }, group_ids);
+  }
+
+  void FindOrInsertSelected(const std::vector<const arrow::Array*>& key_cols,
+                            const std::vector<uint32_t>& selection,
+                            std::vector<uint32_t>* group_ids) override {
+    const uint32_t* rows = selection.data();
+    FindOrInsertRows(
+        key_cols, selection.size(), [rows](int64_t i) -> int64_t { return rows[i]; }, group_ids);
+  }
+
+  Status AppendKeys(const std::vector<arrow::ArrayBuilder*>& builders) const override {
+    DCHECK_EQ(builders.size(), TKey::kNumColumns);
+    for (auto* builder : builders) {
+      PX_RETURN_IF_ERROR(builder->Reserve(keys_.size()));
+    }
+    for (const auto& key : keys_) {
+      PX_RETURN_IF_ERROR(TKey::Append(key, builders));
+    }
+    return Status::OK();
+  }
+
+  Status AppendKeys(const std::vector<uint32_t>& group_ids,
+                    const std::vector<arrow::ArrayBuilder*>& builders) const override {
+    DCHECK_EQ(builders.size(), TKey::kNumColumns);
+    for (auto* builder : builders) {
+      PX_RETURN_IF_ERROR(builder->Reserve(group_ids.size()));
+    }
+    for (uint32_t group_id : group_ids) {
+      PX_RETURN_IF_ERROR(TKey::Append(keys_[group_id], builders));
+    }
+    return Status::OK();
+  }
+
+  uint64_t hash(uint32_t group_id) const override { return hashes_[group_id]; }
+  size_t num_groups() const override { return keys_.size(); }
+
+  int64_t bytes() const override {
+    return slots_.capacity() * sizeof(uint32_t) + keys_.capacity() * sizeof(ViewType) +
+           hashes_.capacity() * sizeof(uint64_t) + arena_.bytes_allocated();
+  }
+
+  void Clear() override {
+    slots_.assign(kInitialCapacity, kEmptySlot);
+    keys_.clear();
+    hashes_.clear();
+    arena_.Clear();
+  }
+
+ private:
+  static constexpr size_t kInitialCapacity = 64;
+  static constexpr uint32_t kEmptySlot = 0;
+
+  template <typename TRowFn>
+  void FindOrInsertRows(const std::vector<const arrow::Array*>& key_cols, int64_t count,
+                        TRowFn row, std::vector<uint32_t>* group_ids) {
+    DCHECK_EQ(key_cols.size(), TKey::kNumColumns);
+    batch_keys_.resize(count);
+    batch_hashes_.resize(count);
+    group_ids->resize(count);
+    TKey::ReadBatch(key_cols, count, row, batch_keys_.data(), batch_hashes_.data());
+    for (int64_t i = 0; i < count; ++i) {
+      (*group_ids)[i] = FindOrInsert(batch_keys_[i], batch_hashes_[i]);
+    }
+  }
+
+  uint32_t FindOrInsert(const ViewType& key, uint64_t hash) {
+    size_t mask = slots_.size() - 1;
+    size_t idx = hash & mask;
+    while (slots_[idx] != kEmptySlot) {
+      // Slots hold group id + 1, so that zero can mark an empty slot.
+      uint32_t group_id = slots_[idx] - 1;
+      if (hashes_[group_id] == hash && keys_[group_id] == key) {
+        return group_id;
+      }
+      idx = (idx + 1) & mask;
+    }
+    uint32_t group_id = keys_.size();
+    keys_.push_back(TKey::Store(key, &arena_));
+    hashes_.push_back(hash);
+    slots_[idx] = group_id + 1;
+    // Keep the load factor under 1/2, so that probe sequences stay short.
+    if (2 * keys_.size() > slots_.size()) {
+      Grow();
+    }
+    return group_id;
+  }
+
+  void Grow() {
+    slots_.assign(2 * slots_.size(), kEmptySlot);
+    size_t mask = slots_.size() - 1;
+    for (size_t group_id = 0; group_id < hashes_.size(); ++group_id) {
+      size_t idx = hashes_[group_id] & mask;
+      while (slots_[idx] != kEmptySlot) {
+        idx = (idx + 1) & mask;
+      }
+      slots_[idx] = group_id + 1;
+    }
+  }
+
+  // The open addressing table, its size is always a power of 2.
+  std::vector<uint32_t> slots_;
+  // The key and hash of each group, indexed by group id.
+  std::vector<ViewType> keys_;
+  std::vector<uint64_t> hashes_;
+  StringArena arena_;
+
+  // Scratch space for the keys and hashes of the current batch.
+  std::vector<ViewType> batch_keys_;
+  std::vector<uint64_t> batch_hashes_;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
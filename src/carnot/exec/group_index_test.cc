@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/exec/group_index.h"
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+TEST(GroupIndexTest, unsupported_key_shapes) {
+  EXPECT_EQ(nullptr, GroupIndex::Create({types::DataType::FLOAT64}));
+  EXPECT_EQ(nullptr, GroupIndex::Create({types::DataType::INT64, types::DataType::INT64}));
+  EXPECT_EQ(nullptr, GroupIndex::Create({types::DataType::STRING, types::DataType::UINT128}));
+}
+
+TEST(GroupIndexTest, int64_keys) {
+  auto index = GroupIndex::Create({types::DataType::INT64});
+  ASSERT_NE(nullptr, index);
+
+  // Enough distinct keys to grow the table a few times.
+  std::vector<types::Int64Value> keys;
+  for (int64_t i = 0; i < 1000; ++i) {
+    keys.push_back(i % 300);
+  }
+  auto arr = types::ToArrow(keys, arrow::default_memory_pool());
+  std::vector<uint32_t> group_ids;
+  index->FindOrInsertBatch({arr.get()}, arr->length(), &group_ids);
+
+  EXPECT_EQ(300, index->num_groups());
+  ASSERT_EQ(1000, group_ids.size());
+  for (size_t i = 0; i < group_ids.size(); ++i) {
+    EXPECT_EQ(i % 300, group_ids[i]);
+  }
+
+  auto builder = types::MakeArrowBuilder(types::DataType::INT64, arrow::default_memory_pool());
+  ASSERT_OK(index->AppendKeys({builder.get()}));
+  std::shared_ptr<arrow::Array> out;
+  ASSERT_OK(builder->Finish(&out));
+  EXPECT_TRUE(out->Equals(arr->Slice(0, 300)));
+
+  index->Clear();
+  EXPECT_EQ(0, index->num_groups());
+}
+
+TEST(GroupIndexTest, string_keys_outlive_batch) {
+  auto index = GroupIndex::Create({types::DataType::STRING});
+  ASSERT_NE(nullptr, index);
+
+  std::vector<uint32_t> group_ids;
+  {
+    std::vector<types::StringValue> keys = {"abc", "", "def", "abc"};
+    auto arr = types::ToArrow(keys, arrow::default_memory_pool());
+    index->FindOrInsertBatch({arr.get()}, arr->length(), &group_ids);
+    EXPECT_EQ(std::vector<uint32_t>({0, 1, 2, 0}), group_ids);
+  }
+  // The first batch is gone, the keys must have been copied into the index.
+  std::vector<types::StringValue> keys = {"def", std::string(100 * 1024, 'x'), ""};
+  auto arr = types::ToArrow(keys, arrow::default_memory_pool());
+  index->FindOrInsertBatch({arr.get()}, arr->length(), &group_ids);
+  EXPECT_EQ(std::vector<uint32_t>({2, 3, 1}), group_ids);
+
+  auto builder = types::MakeArrowBuilder(types::DataType::STRING, arrow::default_memory_pool());
+  ASSERT_OK(index->AppendKeys({builder.get()}));
+  std::shared_ptr<arrow::Array> out;
+  ASSERT_OK(builder->Finish(&out));
+  std::vector<types::StringValue> expected = {"abc", "", "def", std::string(100 * 1024, 'x')};
+  EXPECT_TRUE(out->Equals(types::ToArrow(expected, arrow::default_memory_pool())));
+}
+
+TEST(GroupIndexTest, uint128_string_keys) {
+  auto index = GroupIndex::Create({types::DataType::UINT128, types::DataType::STRING});
+  ASSERT_NE(nullptr, index);
+
+  std::vector<types::UInt128Value> upids = {
+      types::UInt128Value(1, 2), types::UInt128Value(1, 2), types::UInt128Value(2, 1),
+      types::UInt128Value(1, 2)};
+  std::vector<types::StringValue> names = {"a", "b", "a", "a"};
+  auto upid_arr = types::ToArrow(upids, arrow::default_memory_pool());
+  auto name_arr = types::ToArrow(names, arrow::default_memory_pool());
+
+  std::vector<uint32_t> group_ids;
+  index->FindOrInsertBatch({upid_arr.get(), name_arr.get()}, 4, &group_ids);
+  EXPECT_EQ(std::vector<uint32_t>({0, 1, 2, 0}), group_ids);
+  EXPECT_EQ(3, index->num_groups());
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
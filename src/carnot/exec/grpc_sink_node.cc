@@ -21,6 +21,7 @@
 #include <chrono>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <absl/strings/substitute.h>
@@ -31,6 +32,11 @@
 #include "src/common/uuid/uuid_utils.h"
 #include "src/table_store/table_store.h"
 
+DEFINE_int32(carnot_grpc_sink_max_inflight_chunks,
+             gflags::Int32FromEnv("PL_CARNOT_GRPC_SINK_MAX_INFLIGHT_CHUNKS", 4),
+             "The number of result chunks that a GRPC sink can have queued or on the wire while "
+             "the query keeps running. 0 writes every chunk before the query continues.");
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -79,6 +85,8 @@ Status GRPCSinkNode::OptionallyCheckConnection(ExecState* exec_state) {
   if (!recheck_connection) {
     return Status::OK();
   }
+  // The check is written directly, once the writer thread is idle.
+  PX_RETURN_IF_ERROR(WaitForWrites());
 
   PX_ASSIGN_OR_RETURN(auto req, RequestWithMetadata(plan_node_.get(), exec_state));
   PX_ASSIGN_OR_RETURN(auto rb,
@@ -117,9 +125,21 @@ Status GRPCSinkNode::StartConnectionWithRetries(ExecState* exec_state, size_t n_
         plan_node_->id(), plan_node_->address(), exec_state->query_id().str());
   }
 
-  stub_ = exec_state->ResultSinkServiceStub(plan_node_->address(), plan_node_->ssl_targetname());
+  // Reconnects can happen on the writer thread, which reuses the stub instead of going through
+  // the exec state.
+  if (stub_ == nullptr) {
+    stub_ = exec_state->ResultSinkServiceStub(plan_node_->address(), plan_node_->ssl_targetname());
+  }
 
-  context_ = std::make_unique<grpc::ClientContext>();
+  {
+    std::lock_guard<std::mutex> lock(context_mutex_);
+    if (context_cancelled_) {
+      cancelled_ = true;
+      return error::Cancelled("GRPCSinkNode $0 of query $1 was closed before its end of stream",
+                              plan_node_->id(), exec_state->query_id().str());
+    }
+    context_ = std::make_unique<grpc::ClientContext>();
+  }
   // When we are sending the results to an external service, such as the query broker,
   // add authentication to the client context.
   if (plan_node_->has_table_name()) {
@@ -183,6 +203,94 @@ Status GRPCSinkNode::TryWriteRequest(ExecState* exec_state,
   return Status::OK();
 }
 
+Status GRPCSinkNode::EnqueueRequest(ExecState* exec_state,
+                                    carnotpb::TransferResultChunkRequest req) {
+  if (max_inflight_chunks_ <= 0) {
+    return TryWriteRequest(exec_state, req);
+  }
+  if (!writer_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      stop_writer_ = false;
+    }
+    writer_thread_ = std::thread(&GRPCSinkNode::RunWriter, this, exec_state);
+  }
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  queue_cv_.wait(lock, [this]() {
+    return !writer_status_.ok() ||
+           queue_.size() + writing_ < static_cast<size_t>(max_inflight_chunks_);
+  });
+  PX_RETURN_IF_ERROR(writer_status_);
+  queue_.push_back(std::move(req));
+  // The connection is in use as far as the connection checks are concerned.
+  last_send_time_ = std::chrono::system_clock::now();
+  queue_cv_.notify_all();
+  return Status::OK();
+}
+
+Status GRPCSinkNode::WaitForWrites() {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  queue_cv_.wait(lock, [this]() { return queue_.empty() && !writing_; });
+  return writer_status_;
+}
+
+void GRPCSinkNode::StopWriterThread() {
+  if (!writer_thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_writer_ = true;
+  }
+  queue_cv_.notify_all();
+  writer_thread_.join();
+}
+
+bool GRPCSinkNode::CancelWriterThread() {
+  if (!writer_thread_.joinable()) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queue_.clear();
+    stop_writer_ = true;
+  }
+  {
+    std::lock_guard<std::mutex> lock(context_mutex_);
+    context_cancelled_ = true;
+    if (context_ != nullptr) {
+      context_->TryCancel();
+    }
+  }
+  queue_cv_.notify_all();
+  writer_thread_.join();
+  return true;
+}
+
+void GRPCSinkNode::RunWriter(ExecState* exec_state) {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  while (true) {
+    queue_cv_.wait(lock, [this]() { return stop_writer_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+    auto req = std::move(queue_.front());
+    queue_.pop_front();
+    writing_ = true;
+    lock.unlock();
+
+    auto s = TryWriteRequest(exec_state, req);
+
+    lock.lock();
+    writing_ = false;
+    if (!s.ok()) {
+      writer_status_ = s;
+      queue_.clear();
+    }
+    queue_cv_.notify_all();
+  }
+}
+
 Status GRPCSinkNode::OpenImpl(ExecState* exec_state) { return StartConnection(exec_state); }
 
 Status GRPCSinkNode::CloseWriter(ExecState* exec_state) {
@@ -200,13 +308,25 @@ Status GRPCSinkNode::CloseWriter(ExecState* exec_state) {
 }
 
 Status GRPCSinkNode::CloseImpl(ExecState* exec_state) {
-  if (sent_eos_ || cancelled_) {
+  if (sent_eos_) {
+    return Status::OK();
+  }
+  // The query is closed before the end of the stream, e.g. because it was cancelled, so the
+  // results that are still queued are dropped rather than written.
+  bool stream_cancelled = CancelWriterThread();
+  if (cancelled_) {
     return Status::OK();
   }
 
   if (writer_ != nullptr) {
     LOG(INFO) << absl::Substitute("Closing GRPCSinkNode $0 in query $1 before receiving EOS",
                                   plan_node_->id(), exec_state->query_id().str());
+    if (stream_cancelled) {
+      // Finish only releases the cancelled stream, its status is always an error.
+      auto s = writer_->Finish();
+      PX_UNUSED(s);
+      return Status::OK();
+    }
     PX_RETURN_IF_ERROR(CloseWriter(exec_state));
   }
 
@@ -299,6 +419,9 @@ Status GRPCSinkNode::SplitAndSendBatch(ExecState* exec_state, const RowBatch& rb
                       rb.Slice(batch_idx, rb.num_rows() - batch_idx));
   output_rb->set_eos(rb.eos());
   output_rb->set_eow(rb.eow());
+  if (rb.watermark().has_value()) {
+    output_rb->set_watermark(*rb.watermark());
+  }
   return ConsumeNextImplNoSplit(exec_state, *output_rb, parent_idx);
 }
 
@@ -311,15 +434,26 @@ Status GRPCSinkNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb,
 
 Status GRPCSinkNode::ConsumeNextImplNoSplit(ExecState* exec_state, const RowBatch& rb, size_t) {
   PX_ASSIGN_OR_RETURN(auto req, RequestWithMetadata(plan_node_.get(), exec_state));
-  // Serialize the RowBatch.
-  PX_RETURN_IF_ERROR(rb.ToProto(req.mutable_query_result()->mutable_row_batch()));
+  // Serialize the RowBatch. The Arrow buffers encoding is only understood by other Carnot
+  // instances.
+  if (plan_node_->has_grpc_source_id() &&
+      plan_node_->row_batch_encoding() == planpb::ROW_BATCH_ENCODING_ARROW_BUFFERS) {
+    PX_RETURN_IF_ERROR(rb.ToArrowBuffersProto(req.mutable_query_result()->mutable_row_batch()));
+  } else {
+    PX_RETURN_IF_ERROR(rb.ToProto(req.mutable_query_result()->mutable_row_batch()));
+  }
 
-  PX_RETURN_IF_ERROR(TryWriteRequest(exec_state, req));
+  PX_RETURN_IF_ERROR(EnqueueRequest(exec_state, std::move(req)));
 
   if (!rb.eos()) {
     return Status::OK();
   }
 
+  StopWriterThread();
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    PX_RETURN_IF_ERROR(writer_status_);
+  }
   PX_RETURN_IF_ERROR(CloseWriter(exec_state));
   sent_eos_ = true;
 
@@ -19,9 +19,14 @@
 #pragma once
 
 #include <stddef.h>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <grpcpp/grpcpp.h>
@@ -35,6 +40,8 @@
 
 #include "src/carnot/carnotpb/carnot.grpc.pb.h"
 
+DECLARE_int32(carnot_grpc_sink_max_inflight_chunks);
+
 namespace px {
 namespace carnot {
 namespace exec {
@@ -51,12 +58,27 @@ constexpr float kBatchSizeFactor = 0.9f;
 // Number of times to retry connecting to grpc before giving up.
 constexpr size_t kGRPCRetries = 3;
 
+/**
+ * GRPCSinkNode sends its input to a GRPCSourceNode of another Carnot instance, or to the query
+ * broker.
+ *
+ * The batches are serialized on the exec thread and written to the stream by a writer thread, so
+ * that exec can produce the next batch while the previous one is on the wire. At most
+ * max_inflight_chunks requests are queued or being written: once they're all used up, the exec
+ * thread waits for the writer, which applies the backpressure of the stream to the query. Errors
+ * of the writer are returned by the next batch, and the end of the stream waits for every write.
+ */
 class GRPCSinkNode : public SinkNode {
  public:
+  GRPCSinkNode(size_t max_batch_size, float batch_size_factor, int32_t max_inflight_chunks)
+      : max_batch_size_(max_batch_size),
+        batch_size_factor_(batch_size_factor),
+        max_inflight_chunks_(max_inflight_chunks) {}
   GRPCSinkNode(size_t max_batch_size, float batch_size_factor)
-      : max_batch_size_(max_batch_size), batch_size_factor_(batch_size_factor) {}
+      : GRPCSinkNode(max_batch_size, batch_size_factor,
+                     FLAGS_carnot_grpc_sink_max_inflight_chunks) {}
   GRPCSinkNode() : GRPCSinkNode(kMaxBatchSize, kBatchSizeFactor) {}
-  virtual ~GRPCSinkNode() = default;
+  virtual ~GRPCSinkNode() { CancelWriterThread(); }
 
   // Used to check the downstream connection after connection_check_timeout_ has elapsed.
   Status OptionallyCheckConnection(ExecState* exec_state);
@@ -64,7 +86,7 @@ class GRPCSinkNode : public SinkNode {
   void testing_set_connection_check_timeout(const std::chrono::milliseconds& timeout) {
     connection_check_timeout_ = timeout;
   }
-  const std::chrono::time_point<std::chrono::system_clock>& testing_last_send_time() const {
+  std::chrono::time_point<std::chrono::system_clock> testing_last_send_time() const {
     return last_send_time_;
   }
 
@@ -90,23 +112,53 @@ class GRPCSinkNode : public SinkNode {
   Status StartConnectionWithRetries(ExecState* exec_state, size_t n_retries);
   Status CancelledByServer(ExecState* exec_state);
   Status TryWriteRequest(ExecState* exec_state, const carnotpb::TransferResultChunkRequest& req);
-
-  bool cancelled_ = false;
-
+  // Hands the request to the writer thread, waiting for a free slot if all of them are in flight.
+  // Writes it on the calling thread when the writes aren't pipelined.
+  Status EnqueueRequest(ExecState* exec_state, carnotpb::TransferResultChunkRequest req);
+  // Waits until every queued request was written, and returns the error of the writer if any.
+  Status WaitForWrites();
+  // Writes the requests that are still queued, then stops the writer thread.
+  void StopWriterThread();
+  // Drops the requests that are still queued and cancels the stream, so that a write in progress
+  // returns, then stops the writer thread. Returns whether the stream was cancelled.
+  bool CancelWriterThread();
+  void RunWriter(ExecState* exec_state);
+
+  std::atomic<bool> cancelled_ = false;
+
+  // Guards replacing the context, which the writer thread does when it reconnects, against
+  // cancelling it from the exec thread.
+  std::mutex context_mutex_;
   std::unique_ptr<grpc::ClientContext> context_;
+  // Set once the stream is cancelled, after which no new connection is started.
+  bool context_cancelled_ = false;
   carnotpb::TransferResultChunkResponse response_;
 
-  carnotpb::ResultSinkService::StubInterface* stub_;
+  carnotpb::ResultSinkService::StubInterface* stub_ = nullptr;
   std::unique_ptr<grpc::ClientWriterInterface<carnotpb::TransferResultChunkRequest>> writer_;
 
   std::unique_ptr<plan::GRPCSinkOperator> plan_node_;
   std::unique_ptr<table_store::schema::RowDescriptor> input_descriptor_;
 
   std::chrono::milliseconds connection_check_timeout_ = kDefaultConnectionCheckTimeoutMS;
-  std::chrono::time_point<std::chrono::system_clock> last_send_time_;
+  // Written by the writer thread too.
+  std::atomic<std::chrono::time_point<std::chrono::system_clock>> last_send_time_{};
 
   size_t max_batch_size_;
   float batch_size_factor_;
+  // The number of requests that can be queued or written at once. 0 writes on the exec thread.
+  int32_t max_inflight_chunks_;
+
+  std::thread writer_thread_;
+  // Guards the queue and the state of the writer thread below.
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<carnotpb::TransferResultChunkRequest> queue_;
+  // Whether the writer thread is writing a request that it took off the queue.
+  bool writing_ = false;
+  bool stop_writer_ = false;
+  // The first error of the writer thread. The requests that are queued after it are dropped.
+  Status writer_status_;
 };
 
 }  // namespace exec
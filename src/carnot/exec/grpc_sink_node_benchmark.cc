@@ -16,6 +16,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <chrono>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -104,3 +106,84 @@ void BM_GRPCSinkNodeSplitting(benchmark::State& state) {
 }
 
 BENCHMARK(BM_GRPCSinkNodeSplitting)->Unit(benchmark::kMillisecond);
+
+// Sends batches to a stream whose writes take write_latency_us each, like the round trip of a
+// remote Kelvin, while exec spends produce_us producing every batch.
+// NOLINTNEXTLINE : runtime/references.
+void BM_GRPCSinkNodeWriteLatency(benchmark::State& state) {
+  auto write_latency = std::chrono::microseconds(state.range(0));
+  int32_t max_inflight_chunks = state.range(1);
+  auto produce_time = std::chrono::microseconds(200);
+  constexpr int kBatchesPerStream = 64;
+
+  auto func_registry = std::make_unique<px::carnot::udf::Registry>("test_registry");
+  auto table_store = std::make_shared<px::table_store::TableStore>();
+
+  auto mock_unique = std::make_unique<::testing::NiceMock<MockResultSinkServiceStub>>();
+  auto mock = mock_unique.get();
+
+  auto exec_state = std::make_unique<px::carnot::exec::ExecState>(
+      func_registry.get(), table_store,
+      [&](const std::string&, const std::string&)
+          -> std::unique_ptr<ResultSinkService::StubInterface> { return std::move(mock_unique); },
+      MockMetricsStubGenerator, MockTraceStubGenerator, sole::uuid4(), nullptr, nullptr,
+      [&](grpc::ClientContext*) {});
+  TransferResultChunkResponse resp;
+  resp.set_success(true);
+  // Every stream gets a new writer, which is owned by the sink node.
+  ON_CALL(*mock, TransferResultChunkRaw(_, _))
+      .WillByDefault(::testing::Invoke([&](grpc::ClientContext*, TransferResultChunkResponse* r) {
+        *r = resp;
+        auto writer =
+            new ::testing::NiceMock<grpc::testing::MockClientWriter<TransferResultChunkRequest>>();
+        ON_CALL(*writer, Write(_, _)).WillByDefault(::testing::Invoke([write_latency](auto&&...) {
+          std::this_thread::sleep_for(write_latency);
+          return true;
+        }));
+        ON_CALL(*writer, WritesDone()).WillByDefault(Return(true));
+        ON_CALL(*writer, Finish()).WillByDefault(Return(grpc::Status::OK));
+        return writer;
+      }));
+
+  auto op_proto = px::carnot::planpb::testutils::CreateTestGRPCSink2PB();
+  auto plan_node = std::make_unique<px::carnot::plan::GRPCSinkOperator>(1);
+  PX_CHECK_OK(plan_node->Init(op_proto.grpc_sink_op()));
+
+  auto num_rows = 1024;
+  RowDescriptor rd({DataType::INT64, DataType::STRING});
+  std::vector<px::types::Int64Value> ints(num_rows, 1);
+  std::vector<px::types::StringValue> strings(num_rows, std::string(64, 'X'));
+  auto rb = px::carnot::exec::RowBatchBuilder(rd, num_rows, /*eow*/ false, /*eos*/ false)
+                .AddColumn<px::types::Int64Value>(ints)
+                .AddColumn<px::types::StringValue>(strings)
+                .get();
+  auto eos_rb = RowBatch::WithZeroRows(rd, /*eow*/ true, /*eos*/ true).ConsumeValueOrDie();
+
+  for (auto _ : state) {
+    px::carnot::exec::GRPCSinkNode node(px::carnot::exec::kMaxBatchSize,
+                                        px::carnot::exec::kBatchSizeFactor, max_inflight_chunks);
+    PX_CHECK_OK(node.Init(*plan_node, rd, {rd}));
+    PX_CHECK_OK(node.Prepare(exec_state.get()));
+    PX_CHECK_OK(node.Open(exec_state.get()));
+    for (int i = 0; i < kBatchesPerStream; ++i) {
+      // Stands in for the rest of the query producing the next batch.
+      auto produce_end = std::chrono::steady_clock::now() + produce_time;
+      while (std::chrono::steady_clock::now() < produce_end) {
+      }
+      PX_CHECK_OK(node.ConsumeNext(exec_state.get(), rb, 0));
+    }
+    PX_CHECK_OK(node.ConsumeNext(exec_state.get(), *eos_rb, 0));
+    PX_CHECK_OK(node.Close(exec_state.get()));
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchesPerStream);
+}
+
+void WriteLatencyArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t write_latency_us : {0, 200, 1000}) {
+    for (int64_t max_inflight_chunks : {0, 1, 4}) {
+      b->Args({write_latency_us, max_inflight_chunks});
+    }
+  }
+}
+
+BENCHMARK(BM_GRPCSinkNodeWriteLatency)->Apply(WriteLatencyArgs)->Unit(benchmark::kMillisecond);
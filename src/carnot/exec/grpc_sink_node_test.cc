@@ -18,9 +18,15 @@
 
 #include "src/carnot/exec/grpc_sink_node.h"
 
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <absl/synchronization/notification.h>
 #include <grpcpp/test/mock_stream.h>
 #include <gtest/gtest.h>
 #include <sole.hpp>
@@ -217,6 +223,46 @@ TEST_F(GRPCSinkNodeTest, internal_result) {
   EXPECT_FALSE(add_metadata_called_);
 }
 
+TEST_F(GRPCSinkNodeTest, internal_result_arrow_buffers) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  op_proto.mutable_grpc_sink_op()->set_row_batch_encoding(
+      planpb::ROW_BATCH_ENCODING_ARROW_BUFFERS);
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  auto s = plan_node->Init(op_proto.grpc_sink_op());
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::STRING});
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::STRING});
+
+  TransferResultChunkResponse resp;
+  resp.set_success(true);
+
+  std::vector<TransferResultChunkRequest> actual_protos(2);
+  auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+  EXPECT_CALL(*writer, Write(_, _))
+      .Times(2)
+      .WillOnce(DoAll(SaveArg<0>(&actual_protos[0]), Return(true)))
+      .WillOnce(DoAll(SaveArg<0>(&actual_protos[1]), Return(true)));
+  EXPECT_CALL(*writer, WritesDone());
+  EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*mock_, TransferResultChunkRaw(_, _))
+      .WillOnce(DoAll(SetArgPointee<1>(resp), Return(writer)));
+
+  auto tester = exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  auto rb = RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+                .AddColumn<types::Int64Value>({2, 3})
+                .AddColumn<types::StringValue>({"ab", "cde"})
+                .get();
+  tester.ConsumeNext(rb, 5, 0);
+  tester.Close();
+
+  const auto& rb_proto = actual_protos[1].query_result().row_batch();
+  EXPECT_EQ(0, rb_proto.cols_size());
+  EXPECT_EQ(2, rb_proto.arrow_cols_size());
+  EXPECT_EQ(0, actual_protos[1].query_result().grpc_source_id());
+  ASSERT_OK_AND_ASSIGN(auto rb_from_proto, RowBatch::FromProto(rb_proto));
+  EXPECT_EQ(rb.DebugString(), rb_from_proto->DebugString());
+}
+
 constexpr char kExpectedExternal0RowResult[] = R"proto(
 address: "localhost:1234"
 query_id {
@@ -763,6 +809,158 @@ TEST_F(GRPCSinkNodeTest, check_connection_after_eos) {
   tester.Close();
 }
 
+TEST_F(GRPCSinkNodeTest, pipelined_writes) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  auto s = plan_node->Init(op_proto.grpc_sink_op());
+  RowDescriptor input_rd({types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  TransferResultChunkResponse resp;
+  resp.set_success(true);
+
+  // The write of the first batch doesn't finish until the second batch was consumed.
+  absl::Notification second_batch_consumed;
+  auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+  EXPECT_CALL(*writer, Write(_, _))
+      .Times(4)
+      .WillOnce(Return(true))  // Initiate result sink
+      .WillOnce(Invoke([&](const TransferResultChunkRequest&, grpc::WriteOptions) {
+        second_batch_consumed.WaitForNotification();
+        return true;
+      }))
+      .WillOnce(Return(true))
+      .WillOnce(Return(true));
+  EXPECT_CALL(*writer, WritesDone()).WillOnce(Return(true));
+  EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*mock_, TransferResultChunkRaw(_, _))
+      .WillOnce(DoAll(SetArgPointee<1>(resp), Return(writer)));
+
+  auto tester = exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get(), kMaxBatchSize, kBatchSizeFactor,
+      /* max_inflight_chunks */ 2);
+  for (auto i = 0; i < 2; ++i) {
+    auto rb = RowBatchBuilder(output_rd, 1, /*eow*/ false, /*eos*/ false)
+                  .AddColumn<types::Int64Value>({i})
+                  .get();
+    tester.ConsumeNext(rb, 5, 0);
+  }
+  second_batch_consumed.Notify();
+  // The end of the stream waits for every write.
+  auto rb = RowBatchBuilder(output_rd, 0, /*eow*/ true, /*eos*/ true)
+                .AddColumn<types::Int64Value>({})
+                .get();
+  tester.ConsumeNext(rb, 5, 0);
+  tester.Close();
+}
+
+TEST_F(GRPCSinkNodeTest, pipelined_write_error) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  auto s = plan_node->Init(op_proto.grpc_sink_op());
+  RowDescriptor input_rd({types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  TransferResultChunkResponse resp;
+  resp.set_success(true);
+
+  auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+  EXPECT_CALL(*writer, Write(_, _))
+      .Times(2)
+      .WillOnce(Return(true))    // Initiate result sink
+      .WillOnce(Return(false));  // The server closed the stream.
+  EXPECT_CALL(*writer, WritesDone()).WillOnce(Return(true));
+  EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*mock_, TransferResultChunkRaw(_, _))
+      .WillOnce(DoAll(SetArgPointee<1>(resp), Return(writer)));
+
+  // With a single chunk in flight, the second batch waits for the write of the first one, and
+  // returns its error.
+  auto tester = exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get(), kMaxBatchSize, kBatchSizeFactor,
+      /* max_inflight_chunks */ 1);
+  auto rb = RowBatchBuilder(output_rd, 1, /*eow*/ false, /*eos*/ false)
+                .AddColumn<types::Int64Value>({1})
+                .get();
+  tester.ConsumeNext(rb, 5, 0);
+  EXPECT_NOT_OK(tester.node()->ConsumeNext(exec_state_.get(), rb, 5));
+  tester.Close();
+}
+
+TEST_F(GRPCSinkNodeTest, close_before_eos_drops_queued_writes) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  auto s = plan_node->Init(op_proto.grpc_sink_op());
+  RowDescriptor input_rd({types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  // The write of the first batch doesn't finish until the node is being closed, so the other
+  // batches are still queued at that point.
+  absl::Notification writing;
+  absl::Notification closing;
+  auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+  EXPECT_CALL(*writer, Write(_, _))
+      .Times(2)
+      .WillOnce(Return(true))  // Initiate result sink
+      .WillOnce(Invoke([&](const TransferResultChunkRequest&, grpc::WriteOptions) {
+        writing.Notify();
+        closing.WaitForNotification();
+        return true;
+      }));
+  EXPECT_CALL(*writer, WritesDone()).Times(0);
+  EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::CANCELLED));
+  EXPECT_CALL(*mock_, TransferResultChunkRaw(_, _)).WillOnce(Return(writer));
+
+  auto tester = exec::ExecNodeTester<GRPCSinkNode, plan::GRPCSinkOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get(), kMaxBatchSize, kBatchSizeFactor,
+      /* max_inflight_chunks */ 3);
+  for (auto i = 0; i < 3; ++i) {
+    auto rb = RowBatchBuilder(output_rd, 1, /*eow*/ false, /*eos*/ false)
+                  .AddColumn<types::Int64Value>({i})
+                  .get();
+    tester.ConsumeNext(rb, 5, 0);
+  }
+  writing.WaitForNotification();
+
+  std::thread unblock_write([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    closing.Notify();
+  });
+  // The queued batches are dropped instead of being written.
+  tester.Close();
+  unblock_write.join();
+}
+
+TEST_F(GRPCSinkNodeTest, constructed_on_dirty_memory) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSink1PB();
+  auto plan_node = std::make_unique<plan::GRPCSinkOperator>(1);
+  auto s = plan_node->Init(op_proto.grpc_sink_op());
+  RowDescriptor input_rd({types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto writer = new grpc::testing::MockClientWriter<TransferResultChunkRequest>();
+  EXPECT_CALL(*writer, Write(_, _)).Times(2).WillRepeatedly(Return(true));
+  EXPECT_CALL(*writer, WritesDone()).WillOnce(Return(true));
+  EXPECT_CALL(*writer, Finish()).WillOnce(Return(grpc::Status::OK));
+  // The stub has to come from the exec state even when the memory of the node wasn't zeroed.
+  EXPECT_CALL(*mock_, TransferResultChunkRaw(_, _)).WillOnce(Return(writer));
+
+  std::aligned_storage_t<sizeof(GRPCSinkNode), alignof(GRPCSinkNode)> storage;
+  std::memset(&storage, 0xff, sizeof(storage));
+  auto* node = new (&storage) GRPCSinkNode();
+
+  exec_state_->SetCurrentSource(1);
+  ASSERT_OK(node->Init(*plan_node, output_rd, {input_rd}));
+  ASSERT_OK(node->Prepare(exec_state_.get()));
+  ASSERT_OK(node->Open(exec_state_.get()));
+  auto rb = RowBatchBuilder(output_rd, 1, /*eow*/ true, /*eos*/ true)
+                .AddColumn<types::Int64Value>({1})
+                .get();
+  ASSERT_OK(node->ConsumeNext(exec_state_.get(), rb, 5));
+  ASSERT_OK(node->Close(exec_state_.get()));
+  node->~GRPCSinkNode();
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
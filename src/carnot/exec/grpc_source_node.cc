@@ -18,6 +18,7 @@
 
 #include "src/carnot/exec/grpc_source_node.h"
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -78,7 +79,11 @@ Status GRPCSourceNode::PopRowBatch() {
         "message.");
   }
 
-  PX_ASSIGN_OR_RETURN(rb_, RowBatch::FromProto(rb_request->query_result().row_batch()));
+  // Batches sent with the Arrow buffers encoding alias the request, so it is shared with them.
+  std::shared_ptr<const carnotpb::TransferResultChunkRequest> request = std::move(rb_request);
+  std::shared_ptr<const table_store::schemapb::RowBatchData> rb_proto(
+      request, &request->query_result().row_batch());
+  PX_ASSIGN_OR_RETURN(rb_, RowBatch::FromProto(std::move(rb_proto)));
   return Status::OK();
 }
 
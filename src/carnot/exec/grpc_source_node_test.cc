@@ -87,6 +87,28 @@ TEST_F(GRPCSourceNodeTest, basic) {
   EXPECT_FALSE(tester.node()->HasBatchesRemaining());
 }
 
+TEST_F(GRPCSourceNodeTest, arrow_buffers_encoding) {
+  auto op_proto = planpb::testutils::CreateTestGRPCSource1PB();
+  std::unique_ptr<plan::Operator> plan_node = plan::GRPCSourceOperator::FromProto(op_proto, 1);
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::STRING});
+
+  auto tester = exec::ExecNodeTester<GRPCSourceNode, plan::GRPCSourceOperator>(
+      *plan_node, output_rd, std::vector<RowDescriptor>({}), exec_state_.get());
+
+  auto rb = RowBatchBuilder(output_rd, 3, /*eow*/ true, /*eos*/ true)
+                .AddColumn<types::Int64Value>({1, 2, 3})
+                .AddColumn<types::StringValue>({"abc", "", "defg"})
+                .get();
+
+  auto rb_wrapper = std::make_unique<carnotpb::TransferResultChunkRequest>();
+  EXPECT_OK(rb.ToArrowBuffersProto(rb_wrapper->mutable_query_result()->mutable_row_batch()));
+  EXPECT_OK(tester.node()->EnqueueRowBatch(std::move(rb_wrapper)));
+
+  EXPECT_TRUE(tester.node()->NextBatchReady());
+  tester.GenerateNextResult().ExpectRowBatch(rb);
+  EXPECT_FALSE(tester.node()->HasBatchesRemaining());
+}
+
 }  // namespace exec
 }  // namespace carnot
 }  // namespace px
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/memory_pool.h>
+#include <benchmark/benchmark.h>
+
+#include "src/carnot/carnotpb/carnot.pb.h"
+#include "src/common/base/base.h"
+#include "src/datagen/datagen.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/schema/row_batch.h"
+
+using px::carnotpb::TransferResultChunkRequest;
+using px::table_store::schema::RowBatch;
+using px::table_store::schema::RowDescriptor;
+using px::types::DataType;
+using px::types::Float64Value;
+using px::types::Int64Value;
+using px::types::StringValue;
+using px::types::Time64NSValue;
+using px::types::ToArrow;
+using px::types::UInt128Value;
+
+// A batch shaped like a typical PEM to Kelvin transfer: a timestamp, a UPID, a few numeric columns
+// and a string column.
+std::unique_ptr<RowBatch> MakeTransferBatch(int64_t num_rows) {
+  RowDescriptor rd({DataType::TIME64NS, DataType::UINT128, DataType::INT64, DataType::FLOAT64,
+                    DataType::STRING});
+  std::vector<Time64NSValue> times(num_rows);
+  std::vector<UInt128Value> upids(num_rows);
+  std::vector<StringValue> strings(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    times[i] = i * 1000;
+    upids[i] = UInt128Value(i % 16, i % 64);
+    strings[i] = px::datagen::RandomString(32);
+  }
+  auto ints = px::datagen::CreateLargeData<Int64Value>(num_rows);
+  auto floats = px::datagen::CreateLargeData<Float64Value>(num_rows);
+
+  auto rb = std::make_unique<RowBatch>(rd, num_rows);
+  PX_CHECK_OK(rb->AddColumn(ToArrow(times, arrow::default_memory_pool())));
+  PX_CHECK_OK(rb->AddColumn(ToArrow(upids, arrow::default_memory_pool())));
+  PX_CHECK_OK(rb->AddColumn(ToArrow(ints, arrow::default_memory_pool())));
+  PX_CHECK_OK(rb->AddColumn(ToArrow(floats, arrow::default_memory_pool())));
+  PX_CHECK_OK(rb->AddColumn(ToArrow(strings, arrow::default_memory_pool())));
+  return rb;
+}
+
+// Measures what a batch costs from the GRPC sink to the GRPC source: encoding it into the request,
+// the wire serialization and parsing done by GRPC, and decoding it back into a row batch.
+// NOLINTNEXTLINE : runtime/references.
+void BM_TransferRowBatch(benchmark::State& state, bool arrow_buffers) {
+  int64_t num_rows = state.range(0);
+  auto rb = MakeTransferBatch(num_rows);
+
+  std::string wire;
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    TransferResultChunkRequest req;
+    auto rb_proto = req.mutable_query_result()->mutable_row_batch();
+    if (arrow_buffers) {
+      PX_CHECK_OK(rb->ToArrowBuffersProto(rb_proto));
+    } else {
+      PX_CHECK_OK(rb->ToProto(rb_proto));
+    }
+    CHECK(req.SerializeToString(&wire));
+
+    auto received = std::make_shared<TransferResultChunkRequest>();
+    CHECK(received->ParseFromString(wire));
+    std::shared_ptr<const px::table_store::schemapb::RowBatchData> received_rb_proto(
+        received, &received->query_result().row_batch());
+    auto received_rb = RowBatch::FromProto(std::move(received_rb_proto)).ConsumeValueOrDie();
+    benchmark::DoNotOptimize(received_rb);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * num_rows);
+  state.SetBytesProcessed(int64_t(state.iterations()) * rb->NumBytes());
+  state.counters["wire_bytes"] = wire.size();
+}
+
+BENCHMARK_CAPTURE(BM_TransferRowBatch, values, /* arrow_buffers */ false)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 16);
+BENCHMARK_CAPTURE(BM_TransferRowBatch, arrow_buffers, /* arrow_buffers */ true)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 16);
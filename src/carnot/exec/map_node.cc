@@ -18,6 +18,7 @@
 
 #include "src/carnot/exec/map_node.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -42,6 +43,9 @@ Status MapNode::InitImpl(const plan::Operator& plan_node) {
   const auto* map_plan_node = static_cast<const plan::MapOperator*>(&plan_node);
   // copy the plan node to local object;
   plan_node_ = std::make_unique<plan::MapOperator>(*map_plan_node);
+  projection_only_ = std::none_of(
+      plan_node_->expressions().begin(), plan_node_->expressions().end(),
+      [](const auto& expr) { return expr->ExpressionType() == plan::Expression::kFunc; });
   return Status::OK();
 }
 Status MapNode::PrepareImpl(ExecState* exec_state) {
@@ -61,8 +65,11 @@ Status MapNode::CloseImpl(ExecState* exec_state) {
   return Status::OK();
 }
 Status MapNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
-  RowBatch output_rb(*output_descriptor_, rb.num_rows());
+  // A batch with a selection only reaches here for projections, which are cheap to evaluate over
+  // all the rows of the input columns, so the output keeps the selection of the input.
+  RowBatch output_rb(*output_descriptor_, rb.num_column_rows());
   PX_RETURN_IF_ERROR(evaluator_->Evaluate(exec_state, rb, &output_rb));
+  output_rb.SetSelection(rb.shared_selection());
   output_rb.set_eow(rb.eow());
   output_rb.set_eos(rb.eos());
   PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, output_rb));
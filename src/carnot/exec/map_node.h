@@ -49,11 +49,15 @@ class MapNode : public ProcessingNode {
   Status CloseImpl(ExecState* exec_state) override;
   Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
                          size_t parent_index) override;
+  bool HandlesSelection() const override { return projection_only_; }
 
  private:
   std::unique_ptr<ExpressionEvaluator> evaluator_;
   std::unique_ptr<plan::MapOperator> plan_node_;
   std::unique_ptr<udf::FunctionContext> function_ctx_;
+  // Whether the expressions only reference columns and constants. UDFs must not run on the
+  // deselected rows of a batch, so any other map gets a materialized copy of its input.
+  bool projection_only_ = false;
 };
 
 }  // namespace exec
@@ -47,8 +47,10 @@ using udf::FunctionContext;
 class AddUDF : public udf::ScalarUDF {
  public:
   types::Int64Value Exec(FunctionContext*, types::Int64Value v1, types::Int64Value v2) {
+    ++num_calls;
     return v1.val + v2.val;
   }
+  static inline int64_t num_calls = 0;
 };
 
 class MapNodeTest : public ::testing::Test {
@@ -131,6 +133,27 @@ TEST_F(MapNodeTest, zero_row_row_batch) {
       .Close();
 }
 
+TEST_F(MapNodeTest, input_with_selection) {
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
+  RowDescriptor output_rd({types::DataType::INT64});
+
+  auto input_rb = RowBatchBuilder(input_rd, 4, /*eow*/ true, /*eos*/ true)
+                      .AddColumn<types::Int64Value>({1, 2, 3, 4})
+                      .AddColumn<types::Int64Value>({1, 3, 6, 9})
+                      .get();
+  input_rb.SetSelection(std::make_shared<std::vector<uint32_t>>(std::vector<uint32_t>{1, 3}));
+
+  AddUDF::num_calls = 0;
+  auto tester = exec::ExecNodeTester<MapNode, plan::MapOperator>(*plan_node_, output_rd, {},
+                                                                 exec_state_.get());
+  tester.ConsumeNext(input_rb, 0)
+      .ExpectRowBatch(
+          RowBatchBuilder(output_rd, 2, true, true).AddColumn<types::Int64Value>({5, 13}).get())
+      .Close();
+  // The UDF only runs on the selected rows.
+  EXPECT_EQ(2, AddUDF::num_calls);
+}
+
 TEST_F(MapNodeTest, child_fail) {
   RowDescriptor input_rd({types::DataType::INT64, types::DataType::INT64});
   RowDescriptor output_rd({types::DataType::INT64});
@@ -18,9 +18,11 @@
 
 #include "src/carnot/exec/memory_sink_node.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include <arrow/array/concatenate.h>
 #include <absl/strings/substitute.h>
 
 #include "src/carnot/planpb/plan.pb.h"
@@ -72,10 +74,33 @@ Status MemorySinkNode::OpenImpl(ExecState*) { return Status::OK(); }
 
 Status MemorySinkNode::CloseImpl(ExecState*) { return Status::OK(); }
 
-Status MemorySinkNode::ConsumeNextImpl(ExecState*, const RowBatch& rb, size_t) {
+StatusOr<std::unique_ptr<RowBatch>> MemorySinkNode::CopyToTablePool(ExecState* exec_state,
+                                                                    const RowBatch& rb) {
+  auto* pool = arrow::default_memory_pool();
+  if (rb.has_selection()) {
+    return rb.Materialize(pool);
+  }
+  auto output_rb = std::make_unique<RowBatch>(rb.desc(), rb.num_rows());
+  output_rb->set_eow(rb.eow());
+  output_rb->set_eos(rb.eos());
+  for (const auto& col : rb.columns()) {
+    if (exec_state->exec_mem_pool() == pool) {
+      PX_RETURN_IF_ERROR(output_rb->AddColumn(col));
+      continue;
+    }
+    std::shared_ptr<arrow::Array> output_col;
+    PX_RETURN_IF_ERROR(arrow::Concatenate({col}, pool, &output_col));
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(output_col));
+  }
+  return output_rb;
+}
+
+Status MemorySinkNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
   DCHECK_EQ(0U, children().size());
   if (rb.num_rows() > 0 || (rb.eow() || rb.eos())) {
-    PX_RETURN_IF_ERROR(table_->WriteRowBatch(rb));
+    // The table outlives the query, so it must not keep the chunks of the query arena alive.
+    PX_ASSIGN_OR_RETURN(auto table_rb, CopyToTablePool(exec_state, rb));
+    PX_RETURN_IF_ERROR(table_->WriteRowBatch(*table_rb));
   }
   return Status::OK();
 }
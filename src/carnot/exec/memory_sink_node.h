@@ -49,8 +49,14 @@ class MemorySinkNode : public SinkNode {
   Status CloseImpl(ExecState* exec_state) override;
   Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
                          size_t parent_index) override;
+  bool HandlesSelection() const override { return true; }
 
  private:
+  // Returns the selected rows of rb, with columns allocated from the default memory pool instead
+  // of the query's pool.
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> CopyToTablePool(
+      ExecState* exec_state, const table_store::schema::RowBatch& rb);
+
   std::unique_ptr<plan::MemorySinkOperator> plan_node_;
   std::unique_ptr<table_store::schema::RowDescriptor> input_descriptor_;
   std::shared_ptr<table_store::Table> table_;
@@ -30,6 +30,7 @@
 #include "src/carnot/exec/test_utils.h"
 #include "src/carnot/planpb/test_proto.h"
 #include "src/carnot/udf/registry.h"
+#include "src/common/testing/testing.h"
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/types.h"
 
@@ -112,6 +113,37 @@ TEST_F(MemorySinkNodeTest, basic) {
   EXPECT_TRUE(batch->ColumnAt(1)->Equals(col2_rb2_arrow));
 }
 
+TEST_F(MemorySinkNodeTest, copies_out_of_query_arena) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_query_arena, true);
+  exec_state_ = std::make_unique<ExecState>(
+      func_registry_.get(), std::make_shared<table_store::TableStore>(),
+      MockResultSinkStubGenerator, MockMetricsStubGenerator, MockTraceStubGenerator,
+      sole::uuid4(), nullptr);
+  auto* arena = exec_state_->exec_mem_pool();
+  ASSERT_NE(arrow::default_memory_pool(), arena);
+
+  RowDescriptor input_rd({types::DataType::INT64, types::DataType::BOOLEAN});
+  RowDescriptor output_rd({});
+  auto tester = exec::ExecNodeTester<MemorySinkNode, plan::MemorySinkOperator>(
+      *plan_node_, output_rd, {input_rd}, exec_state_.get());
+  {
+    RowBatch rb(input_rd, 2);
+    EXPECT_OK(rb.AddColumn(types::ToArrow(std::vector<types::Int64Value>{1, 2}, arena)));
+    EXPECT_OK(rb.AddColumn(types::ToArrow(std::vector<types::BoolValue>{true, false}, arena)));
+    tester.ConsumeNext(rb, false, 0);
+  }
+  // The table holds copies, so none of the query's allocations are still referenced.
+  EXPECT_EQ(0, arena->bytes_allocated());
+
+  table_store::Table::Cursor cursor(exec_state_->table_store()->GetTable("cpu_15s"));
+  ASSERT_OK_AND_ASSIGN(auto batch, cursor.GetNextRowBatch({0, 1}));
+  EXPECT_TRUE(batch->ColumnAt(0)->Equals(
+      types::ToArrow(std::vector<types::Int64Value>{1, 2}, arrow::default_memory_pool())));
+  EXPECT_TRUE(batch->ColumnAt(1)->Equals(
+      types::ToArrow(std::vector<types::BoolValue>{true, false}, arrow::default_memory_pool())));
+  tester.Close();
+}
+
 TEST_F(MemorySinkNodeTest, zero_row_row_batch_not_eos) {
   RowDescriptor input_rd({types::DataType::INT64, types::DataType::BOOLEAN});
   RowDescriptor output_rd({});
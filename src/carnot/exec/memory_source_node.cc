@@ -20,9 +20,13 @@
 #include "src/table_store/table/table.h"
 
 #include <limits>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <absl/numeric/int128.h>
+#include <absl/strings/str_cat.h>
 #include <absl/strings/substitute.h>
 
 #include "src/carnot/planpb/plan.pb.h"
@@ -34,6 +38,64 @@ namespace exec {
 
 using StartSpec = Table::Cursor::StartSpec;
 using StopSpec = Table::Cursor::StopSpec;
+using ColumnPredicate = Table::ColumnPredicate;
+
+namespace {
+
+std::optional<ColumnPredicate> ColumnPredicateFromProto(
+    const planpb::MemorySourceOperator::Predicate& pb) {
+  ColumnPredicate pred;
+  pred.col_idx = pb.column_idx();
+  switch (pb.op()) {
+    case planpb::MemorySourceOperator::Predicate::EQUAL:
+      pred.op = ColumnPredicate::Op::kEqual;
+      break;
+    case planpb::MemorySourceOperator::Predicate::NOT_EQUAL:
+      pred.op = ColumnPredicate::Op::kNotEqual;
+      break;
+    case planpb::MemorySourceOperator::Predicate::LESS_THAN:
+      pred.op = ColumnPredicate::Op::kLessThan;
+      break;
+    case planpb::MemorySourceOperator::Predicate::LESS_THAN_EQUAL:
+      pred.op = ColumnPredicate::Op::kLessThanEqual;
+      break;
+    case planpb::MemorySourceOperator::Predicate::GREATER_THAN:
+      pred.op = ColumnPredicate::Op::kGreaterThan;
+      break;
+    case planpb::MemorySourceOperator::Predicate::GREATER_THAN_EQUAL:
+      pred.op = ColumnPredicate::Op::kGreaterThanEqual;
+      break;
+    default:
+      return std::nullopt;
+  }
+  const auto& value = pb.value();
+  switch (value.data_type()) {
+    case types::DataType::BOOLEAN:
+      pred.value = static_cast<int64_t>(value.bool_value());
+      break;
+    case types::DataType::INT64:
+      pred.value = value.int64_value();
+      break;
+    case types::DataType::TIME64NS:
+      pred.value = value.time64_ns_value();
+      break;
+    case types::DataType::FLOAT64:
+      pred.value = value.float64_value();
+      break;
+    case types::DataType::UINT128:
+      pred.value =
+          absl::MakeUint128(value.uint128_value().high(), value.uint128_value().low());
+      break;
+    case types::DataType::STRING:
+      pred.value = value.string_value();
+      break;
+    default:
+      return std::nullopt;
+  }
+  return pred;
+}
+
+}  // namespace
 
 std::string MemorySourceNode::DebugStringImpl() {
   return absl::Substitute("Exec::MemorySourceNode: <name: $0, output: $1>", plan_node_->TableName(),
@@ -85,13 +147,26 @@ Status MemorySourceNode::OpenImpl(ExecState* exec_state) {
       stop_spec.type = StopSpec::StopType::CurrentEndOfTable;
     }
   }
-  cursor_ = std::make_unique<Table::Cursor>(table_, start_spec, stop_spec);
+  std::vector<ColumnPredicate> predicates;
+  for (const auto& pb : plan_node_->predicates()) {
+    auto pred = ColumnPredicateFromProto(pb);
+    if (pred.has_value()) {
+      predicates.push_back(std::move(pred.value()));
+    }
+  }
+  cursor_ = std::make_unique<Table::Cursor>(table_, start_spec, stop_spec, std::move(predicates));
 
   return Status::OK();
 }
 
 Status MemorySourceNode::CloseImpl(ExecState*) {
   stats()->AddExtraInfo("streaming", streaming_ ? "true" : "false");
+  if (cursor_ != nullptr && !plan_node_->predicates().empty()) {
+    stats()->AddExtraInfo("batches_skipped", absl::StrCat(cursor_->batches_skipped()));
+  }
+  if (!runtime_filters_.empty()) {
+    stats()->AddExtraInfo("runtime_filtered_rows", absl::StrCat(runtime_filtered_rows_));
+  }
   return Status::OK();
 }
 
@@ -113,6 +188,10 @@ StatusOr<std::unique_ptr<RowBatch>> MemorySourceNode::GetNextRowBatch(ExecState*
   rows_processed_ += row_batch->num_rows();
   bytes_processed_ += row_batch->NumBytes();
 
+  for (const auto& spec : runtime_filters_) {
+    runtime_filtered_rows_ += spec.filter->Apply(row_batch.get(), spec.key_cols);
+  }
+
   // If infinite stream is set, we don't send Eow or Eos. Infinite streams therefore never cause
   // HasBatchesRemaining to be false. Instead the outer loop that calls GenerateNext() is
   // responsible for managing whether we continue the stream or end it.
@@ -123,12 +202,40 @@ StatusOr<std::unique_ptr<RowBatch>> MemorySourceNode::GetNextRowBatch(ExecState*
   return row_batch;
 }
 
+StatusOr<std::unique_ptr<RowBatch>> MemorySourceNode::NextMorsel() {
+  DCHECK(table_ != nullptr);
+  DCHECK(!streaming_);
+  Table::ReservedRowBatch reserved;
+  {
+    absl::base_internal::SpinLockHolder lock(&morsel_lock_);
+    if (cursor_->Done()) {
+      return std::unique_ptr<RowBatch>(nullptr);
+    }
+    PX_ASSIGN_OR_RETURN(reserved, cursor_->ReserveNextRowBatch(plan_node_->Columns()));
+  }
+  // The workers decode the cold columns of their morsels in parallel.
+  PX_ASSIGN_OR_RETURN(auto row_batch, reserved.Decode());
+  absl::base_internal::SpinLockHolder lock(&morsel_lock_);
+  rows_processed_ += row_batch->num_rows();
+  bytes_processed_ += row_batch->NumBytes();
+  return row_batch;
+}
+
 Status MemorySourceNode::GenerateNextImpl(ExecState* exec_state) {
   PX_ASSIGN_OR_RETURN(auto row_batch, GetNextRowBatch(exec_state));
   PX_RETURN_IF_ERROR(SendRowBatchToChildren(exec_state, *row_batch));
   return Status::OK();
 }
 
+bool MemorySourceNode::RuntimeFiltersPending() const {
+  for (const auto& spec : runtime_filters_) {
+    if (spec.filter->pending()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool MemorySourceNode::InfiniteStreamNextBatchReady() { return cursor_->NextBatchReady(); }
 
 bool MemorySourceNode::NextBatchReady() {
@@ -21,10 +21,14 @@
 #include <stdint.h>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <absl/base/internal/spinlock.h>
+
 #include "src/carnot/exec/exec_node.h"
 #include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/runtime_filter.h"
 #include "src/carnot/plan/operators.h"
 #include "src/common/base/base.h"
 #include "src/common/base/status.h"
@@ -46,6 +50,27 @@ class MemorySourceNode : public SourceNode {
 
   bool NextBatchReady() override;
 
+  /**
+   * Returns the next batch of the table without sending it to the children of this node, or
+   * nullptr once the cursor is exhausted. Unlike GenerateNext, this is safe to call from several
+   * threads, which is how parallel pipelines split the scan. Only valid for non-streaming sources.
+   */
+  StatusOr<std::unique_ptr<RowBatch>> NextMorsel();
+
+  /**
+   * Adds the runtime filter of a join that this source feeds the probe side of.
+   * @param key_cols The indices of the join keys in the output of this source.
+   */
+  void AddRuntimeFilter(const JoinRuntimeFilter* filter, std::vector<int64_t> key_cols) {
+    runtime_filters_.push_back({filter, std::move(key_cols)});
+  }
+
+  /**
+   * @return whether any of the runtime filters of this source are still being built. The batches
+   * read until then aren't filtered.
+   */
+  bool RuntimeFiltersPending() const;
+
  protected:
   std::string DebugStringImpl() override;
   Status InitImpl(const plan::Operator& plan_node) override;
@@ -61,9 +86,19 @@ class MemorySourceNode : public SourceNode {
   bool streaming_ = false;
 
   std::unique_ptr<Table::Cursor> cursor_;
+  // Serializes access to the cursor and the processed counters in NextMorsel. Only reserving the
+  // next batch holds it, not decoding the batch.
+  absl::base_internal::SpinLock morsel_lock_;
 
   std::unique_ptr<plan::MemorySourceOperator> plan_node_;
   table_store::Table* table_ = nullptr;
+
+  struct RuntimeFilterSpec {
+    const JoinRuntimeFilter* filter;
+    std::vector<int64_t> key_cols;
+  };
+  std::vector<RuntimeFilterSpec> runtime_filters_;
+  int64_t runtime_filtered_rows_ = 0;
 };
 
 }  // namespace exec
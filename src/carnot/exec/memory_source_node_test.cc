@@ -107,6 +107,36 @@ TEST_F(MemorySourceNodeTest, basic) {
   EXPECT_EQ(sizeof(int64_t) * 5, tester.node()->BytesProcessed());
 }
 
+TEST_F(MemorySourceNodeTest, runtime_filter) {
+  auto op_proto = planpb::testutils::CreateTestSource1PB();
+  std::unique_ptr<plan::Operator> plan_node = plan::MemorySourceOperator::FromProto(op_proto, 1);
+  RowDescriptor output_rd({types::DataType::TIME64NS});
+
+  JoinRuntimeFilter filter;
+  filter.AddBuildKeys(RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<types::Time64NSValue>({2, 5})
+                          .get(),
+                      {0});
+
+  auto tester = exec::ExecNodeTester<MemorySourceNode, plan::MemorySourceOperator>(
+      *plan_node, output_rd, std::vector<RowDescriptor>({}), exec_state_.get());
+  tester.node()->AddRuntimeFilter(&filter, {0});
+  EXPECT_TRUE(tester.node()->RuntimeFiltersPending());
+  ASSERT_OK(filter.Finish());
+  EXPECT_FALSE(tester.node()->RuntimeFiltersPending());
+
+  tester.GenerateNextResult().ExpectRowBatch(
+      RowBatchBuilder(output_rd, 1, /*eow*/ false, /*eos*/ false)
+          .AddColumn<types::Time64NSValue>({2})
+          .get());
+  tester.GenerateNextResult().ExpectRowBatch(
+      RowBatchBuilder(output_rd, 1, /*eow*/ true, /*eos*/ true)
+          .AddColumn<types::Time64NSValue>({5})
+          .get());
+  tester.Close();
+  EXPECT_EQ(5, tester.node()->RowsProcessed());
+}
+
 TEST_F(MemorySourceNodeTest, empty_table) {
   auto op_proto = planpb::testutils::CreateTestSource1PB("empty");
   std::unique_ptr<plan::Operator> plan_node = plan::MemorySourceOperator::FromProto(op_proto, 1);
@@ -416,6 +446,31 @@ TEST_F(MemorySourceNodeTest, table_compact_between_open_and_exec) {
   tester.Close();
 }
 
+TEST_F(MemorySourceNodeTest, predicates_skip_cold_batches) {
+  // Compacts the table into the cold batches [1, 2] and [3, 5], leaving [6] hot.
+  EXPECT_OK(cpu_table_->CompactHotToCold(arrow::default_memory_pool()));
+
+  auto op_proto = planpb::testutils::CreateTestSource1PB();
+  auto pred = op_proto.mutable_mem_source_op()->add_predicates();
+  pred->set_column_idx(1);
+  pred->set_op(planpb::MemorySourceOperator::Predicate::GREATER_THAN);
+  pred->mutable_value()->set_data_type(types::DataType::TIME64NS);
+  pred->mutable_value()->set_time64_ns_value(5);
+  std::unique_ptr<plan::Operator> plan_node = plan::MemorySourceOperator::FromProto(op_proto, 1);
+  RowDescriptor output_rd({types::DataType::TIME64NS});
+
+  auto tester = exec::ExecNodeTester<MemorySourceNode, plan::MemorySourceOperator>(
+      *plan_node, output_rd, std::vector<RowDescriptor>({}), exec_state_.get());
+  EXPECT_TRUE(tester.node()->HasBatchesRemaining());
+  tester.GenerateNextResult().ExpectRowBatch(
+      RowBatchBuilder(output_rd, 1, /*eow*/ true, /*eos*/ true)
+          .AddColumn<types::Time64NSValue>({6})
+          .get());
+  EXPECT_FALSE(tester.node()->HasBatchesRemaining());
+  tester.Close();
+  EXPECT_EQ(1, tester.node()->RowsProcessed());
+}
+
 struct MemorySourceTestCase {
   std::string name;
   std::vector<std::vector<int64_t>> initial_time_batches;
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/morsel_pipeline.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+void MorselPipeline::AddWorker(std::vector<ExecNode*> nodes, MorselSinkNode* sink, bool owned) {
+  DCHECK(!nodes.empty());
+  auto worker = std::make_unique<Worker>();
+  worker->nodes = std::move(nodes);
+  worker->sink = sink;
+  worker->owned = owned;
+  workers_.push_back(std::move(worker));
+}
+
+Status MorselPipeline::Prepare(ExecState* exec_state) {
+  return ForEachOwnedNode([exec_state](ExecNode* node) { return node->Prepare(exec_state); });
+}
+
+Status MorselPipeline::Open(ExecState* exec_state) {
+  return ForEachOwnedNode([exec_state](ExecNode* node) { return node->Open(exec_state); });
+}
+
+Status MorselPipeline::Close(ExecState* exec_state) {
+  return ForEachOwnedNode([exec_state](ExecNode* node) { return node->Close(exec_state); });
+}
+
+std::unique_ptr<RowBatch> MorselPipeline::PopMorsel(Worker* worker, bool steal) {
+  absl::base_internal::SpinLockHolder lock(&worker->morsels_lock);
+  if (worker->morsels.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<RowBatch> morsel;
+  // Owners consume their queue in scan order, thieves take the morsels the owner would get to last.
+  if (steal) {
+    morsel = std::move(worker->morsels.back());
+    worker->morsels.pop_back();
+  } else {
+    morsel = std::move(worker->morsels.front());
+    worker->morsels.pop_front();
+  }
+  return morsel;
+}
+
+StatusOr<std::unique_ptr<RowBatch>> MorselPipeline::NextMorsel(size_t worker_idx) {
+  Worker* worker = workers_[worker_idx].get();
+  auto morsel = PopMorsel(worker, /* steal */ false);
+  if (morsel != nullptr) {
+    return morsel;
+  }
+
+  if (!source_exhausted_) {
+    std::vector<std::unique_ptr<RowBatch>> fetched;
+    for (int64_t i = 0; i < morsels_per_fetch_; ++i) {
+      PX_ASSIGN_OR_RETURN(auto next, source_->NextMorsel());
+      if (next == nullptr) {
+        source_exhausted_ = true;
+        break;
+      }
+      fetched.push_back(std::move(next));
+    }
+    if (!fetched.empty()) {
+      absl::base_internal::SpinLockHolder lock(&worker->morsels_lock);
+      for (size_t i = 1; i < fetched.size(); ++i) {
+        worker->morsels.push_back(std::move(fetched[i]));
+      }
+      return std::move(fetched[0]);
+    }
+  }
+
+  // The scan is done, help out the workers that still have queued morsels.
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    morsel = PopMorsel(workers_[(worker_idx + i) % workers_.size()].get(), /* steal */ true);
+    if (morsel != nullptr) {
+      return morsel;
+    }
+  }
+  return std::unique_ptr<RowBatch>(nullptr);
+}
+
+Status MorselPipeline::RunWorker(size_t worker_idx, ExecState* exec_state) {
+  ExecNode* head = workers_[worker_idx]->nodes.front();
+  while (!cancelled_) {
+    PX_ASSIGN_OR_RETURN(auto morsel, NextMorsel(worker_idx));
+    if (morsel == nullptr) {
+      break;
+    }
+    PX_RETURN_IF_ERROR(head->ConsumeNext(exec_state, *morsel, /* parent_index */ 0));
+  }
+  if (merge_in_process_) {
+    // The aggregate of the worker is merged as is, it's only finished once everything is merged.
+    return Status::OK();
+  }
+  // Flush the partial aggregate of this worker.
+  PX_ASSIGN_OR_RETURN(auto eos, RowBatch::WithZeroRows(source_descriptor_, /* eow */ true,
+                                                       /* eos */ true));
+  return head->ConsumeNext(exec_state, *eos, /* parent_index */ 0);
+}
+
+template <typename TFunc>
+Status MorselPipeline::RunOnWorkers(TFunc fn) {
+  std::vector<Status> worker_statuses(workers_.size());
+  std::vector<std::thread> threads;
+  threads.reserve(workers_.size() - 1);
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    threads.emplace_back([i, &fn, &worker_statuses]() { worker_statuses[i] = fn(i); });
+  }
+  worker_statuses[0] = fn(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& s : worker_statuses) {
+    PX_RETURN_IF_ERROR(s);
+  }
+  return Status::OK();
+}
+
+Status MorselPipeline::MergeWorkerAggsPartitioned(ExecState* exec_state,
+                                                  const std::vector<AggNode*>& aggs) {
+  size_t num_partitions = aggs.size();
+  PX_RETURN_IF_ERROR(RunOnWorkers(
+      [&](size_t w) { return aggs[w]->PartitionGroups(exec_state, num_partitions); }));
+  // Worker w merges partition w of every worker into its own aggregate. The partitions are only
+  // finalized once all of them are merged, since until then the other workers read the groups.
+  PX_RETURN_IF_ERROR(RunOnWorkers(
+      [&](size_t w) { return aggs[w]->MergePartitionFrom(exec_state, aggs, w); }));
+  std::vector<std::unique_ptr<RowBatch>> outputs(aggs.size());
+  PX_RETURN_IF_ERROR(RunOnWorkers([&](size_t w) -> Status {
+    // The merge node finalizes its own partition when it outputs the results.
+    if (w == 0) {
+      return Status::OK();
+    }
+    PX_ASSIGN_OR_RETURN(outputs[w], aggs[w]->TakePartitionOutput(exec_state));
+    return Status::OK();
+  }));
+  for (size_t w = 1; w < aggs.size(); ++w) {
+    aggs[0]->AddPartitionOutput(std::move(outputs[w]));
+  }
+  return Status::OK();
+}
+
+Status MorselPipeline::MergeWorkerResults(ExecState* exec_state) {
+  if (merge_in_process_) {
+    // The first worker's aggregate is the merge node. Once the groups of the workers are merged,
+    // the end of the stream is sent down its chain so that it outputs the results.
+    auto merge_agg = static_cast<AggNode*>(merge_node_);
+    std::vector<AggNode*> aggs;
+    for (const auto& worker : workers_) {
+      aggs.push_back(static_cast<AggNode*>(worker->nodes.back()));
+    }
+    if (aggs.size() > 1 && std::all_of(aggs.begin(), aggs.end(), [](AggNode* agg) {
+          return agg->SupportsPartitionedMerge();
+        })) {
+      PX_RETURN_IF_ERROR(MergeWorkerAggsPartitioned(exec_state, aggs));
+    } else {
+      // Without groups there's a single state per worker to merge. Spilled groups are moved to
+      // the partitions on disk of the merge node, which it merges when it reads them back.
+      for (size_t w = 1; w < aggs.size(); ++w) {
+        PX_RETURN_IF_ERROR(merge_agg->MergeGroupsFrom(exec_state, aggs[w]));
+      }
+    }
+    PX_ASSIGN_OR_RETURN(auto eos, RowBatch::WithZeroRows(source_descriptor_, /* eow */ true,
+                                                         /* eos */ true));
+    return workers_[0]->nodes.front()->ConsumeNext(exec_state, *eos, /* parent_index */ 0);
+  }
+
+  std::vector<const RowBatch*> partials;
+  for (const auto& worker : workers_) {
+    for (const auto& rb : worker->sink->batches()) {
+      partials.push_back(&rb);
+    }
+  }
+  if (partials.empty()) {
+    return error::Internal("Morsel pipeline workers did not produce any partial aggregates.");
+  }
+  // Every worker marks its output as the end of the stream. Only the last one is, as far as the
+  // merging aggregate is concerned.
+  for (const auto& [i, partial] : Enumerate(partials)) {
+    RowBatch rb = *partial;
+    bool last = i == partials.size() - 1;
+    rb.set_eow(last);
+    rb.set_eos(last);
+    PX_RETURN_IF_ERROR(merge_node_->ConsumeNext(exec_state, rb, /* parent_index */ 0));
+  }
+  return Status::OK();
+}
+
+void MorselPipeline::FoldWorkerStats() {
+  // The first worker runs the nodes of the execution graph, so the stats of the other workers are
+  // added to those nodes to report the totals of the pipeline. The partial aggregates are skipped,
+  // they don't exist in the plan, unless the workers run the aggregate of the graph.
+  const auto& graph_nodes = workers_[0]->nodes;
+  size_t num_graph_nodes = merge_in_process_ ? graph_nodes.size() : graph_nodes.size() - 1;
+  for (size_t w = 1; w < workers_.size(); ++w) {
+    for (size_t i = 0; i < num_graph_nodes; ++i) {
+      graph_nodes[i]->stats()->AddCounters(*workers_[w]->nodes[i]->stats());
+    }
+  }
+  merge_node_->stats()->AddExtraMetric("morsel_workers", workers_.size());
+}
+
+Status MorselPipeline::Execute(ExecState* exec_state) {
+  DCHECK(!workers_.empty());
+  PX_RETURN_IF_ERROR(RunOnWorkers([this, exec_state](size_t i) {
+    Status s = RunWorker(i, exec_state);
+    if (!s.ok()) {
+      cancelled_ = true;
+    }
+    return s;
+  }));
+
+  PX_RETURN_IF_ERROR(MergeWorkerResults(exec_state));
+  FoldWorkerStats();
+  // The source has no children in the graph, this only marks it as done.
+  return source_->SendEndOfStream(exec_state);
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
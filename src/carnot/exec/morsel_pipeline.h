@@ -0,0 +1,185 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/base/internal/spinlock.h>
+
+#include "src/carnot/exec/agg_node.h"
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/memory_source_node.h"
+#include "src/carnot/plan/operators.h"
+#include "src/common/base/base.h"
+#include "src/table_store/schema/row_batch.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * MorselSinkNode collects the row batches produced by one worker of a MorselPipeline, so that they
+ * can be merged into the rest of the execution graph on the exec thread.
+ */
+class MorselSinkNode : public SinkNode {
+ public:
+  MorselSinkNode() = default;
+  virtual ~MorselSinkNode() = default;
+
+  const std::vector<table_store::schema::RowBatch>& batches() const { return batches_; }
+
+ protected:
+  std::string DebugStringImpl() override { return "Exec::MorselSinkNode"; }
+  Status InitImpl(const plan::Operator&) override { return Status::OK(); }
+  Status PrepareImpl(ExecState*) override { return Status::OK(); }
+  Status OpenImpl(ExecState*) override { return Status::OK(); }
+  Status CloseImpl(ExecState*) override {
+    batches_.clear();
+    return Status::OK();
+  }
+  Status ConsumeNextImpl(ExecState*, const table_store::schema::RowBatch& rb, size_t) override {
+    batches_.push_back(rb);
+    return Status::OK();
+  }
+
+ private:
+  std::vector<table_store::schema::RowBatch> batches_;
+};
+
+/**
+ * A MorselPipeline runs a MemorySource -> (Map|Filter)* -> partial Agg chain of the execution graph
+ * on several threads.
+ *
+ * Each worker owns a private copy of the Map/Filter nodes and a partial AggNode that serializes its
+ * state at the end of the stream. Workers pull morsels (table batches) from the shared source as
+ * soon as they are idle. To amortize the cost of reading from the table, a worker fetches a few
+ * morsels at a time into its own queue; workers that find both their queue and the source empty
+ * steal from the back of the other workers' queues. Once every worker has finished, the serialized
+ * partial aggregates are fed, on the calling thread, into the merging AggNode which remains in the
+ * execution graph, so that everything downstream of the aggregate runs exactly as before.
+ *
+ * When merging in process, the workers run the aggregate of the plan itself, each on its own
+ * AggNode, and the first worker uses the AggNode of the graph. Once every worker has finished, the
+ * groups of the workers are merged with the Merge of their UDAs, which skips serializing and
+ * deserializing every group. The groups are partitioned by the hash of their keys, one partition
+ * per worker, and each worker merges and finalizes one partition on its own thread. The AggNode of
+ * the graph then outputs the finalized partitions along with its own.
+ */
+class MorselPipeline {
+ public:
+  /**
+   * @param source The memory source that is scanned by the workers. Must not have any children in
+   * the execution graph.
+   * @param source_descriptor The output descriptor of the source.
+   * @param merge_node The blocking aggregate that merges the partial results of the workers.
+   * @param morsels_per_fetch The number of morsels a worker reads from the source at a time.
+   * @param merge_in_process Whether the workers end with AggNodes of the plan's aggregate, which
+   * are merged into the merge node (the first worker's aggregate) without serializing them.
+   */
+  MorselPipeline(MemorySourceNode* source, table_store::schema::RowDescriptor source_descriptor,
+                 ExecNode* merge_node, int64_t morsels_per_fetch, bool merge_in_process = false)
+      : source_(source),
+        source_descriptor_(std::move(source_descriptor)),
+        merge_node_(merge_node),
+        morsels_per_fetch_(morsels_per_fetch),
+        merge_in_process_(merge_in_process) {}
+
+  /**
+   * Adds a worker to the pipeline.
+   * @param nodes The chain of nodes run by the worker, starting at the node that consumes the
+   * morsels and ending at its partial aggregate.
+   * @param sink The sink that collects the output of the partial aggregate, null when merging in
+   * process.
+   * @param owned Whether the pipeline is responsible for preparing, opening and closing `nodes`.
+   * This is false for the worker that reuses the nodes of the execution graph.
+   */
+  void AddWorker(std::vector<ExecNode*> nodes, MorselSinkNode* sink, bool owned);
+
+  Status Prepare(ExecState* exec_state);
+  Status Open(ExecState* exec_state);
+  Status Close(ExecState* exec_state);
+
+  /**
+   * Runs the pipeline to completion, merges the results into the merge node and finishes the
+   * source. The first worker runs on the calling thread.
+   */
+  Status Execute(ExecState* exec_state);
+
+  size_t num_workers() const { return workers_.size(); }
+
+ private:
+  struct Worker {
+    std::vector<ExecNode*> nodes;
+    MorselSinkNode* sink = nullptr;
+    bool owned = false;
+
+    absl::base_internal::SpinLock morsels_lock;
+    std::deque<std::unique_ptr<table_store::schema::RowBatch>> morsels
+        ABSL_GUARDED_BY(morsels_lock);
+  };
+
+  Status RunWorker(size_t worker_idx, ExecState* exec_state);
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> NextMorsel(size_t worker_idx);
+  std::unique_ptr<table_store::schema::RowBatch> PopMorsel(Worker* worker, bool steal);
+  Status MergeWorkerResults(ExecState* exec_state);
+  Status MergeWorkerAggsPartitioned(ExecState* exec_state, const std::vector<AggNode*>& aggs);
+  // Runs fn(worker_idx) for every worker, the first one on the calling thread, and waits for all
+  // of them to finish.
+  template <typename TFunc>
+  Status RunOnWorkers(TFunc fn);
+  void FoldWorkerStats();
+
+  // Nodes that are not owned by the pipeline are in the graph, so their lifecycle is handled there.
+  template <typename TFunc>
+  Status ForEachOwnedNode(TFunc fn) {
+    for (const auto& worker : workers_) {
+      if (worker->owned) {
+        for (ExecNode* node : worker->nodes) {
+          PX_RETURN_IF_ERROR(fn(node));
+        }
+      } else if (!merge_in_process_) {
+        // The partial aggregate of the graph worker is not part of the graph.
+        PX_RETURN_IF_ERROR(fn(worker->nodes.back()));
+      }
+      if (worker->sink != nullptr) {
+        PX_RETURN_IF_ERROR(fn(worker->sink));
+      }
+    }
+    return Status::OK();
+  }
+
+  MemorySourceNode* source_;
+  table_store::schema::RowDescriptor source_descriptor_;
+  ExecNode* merge_node_;
+  const int64_t morsels_per_fetch_;
+  const bool merge_in_process_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<bool> source_exhausted_ = false;
+  std::atomic<bool> cancelled_ = false;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
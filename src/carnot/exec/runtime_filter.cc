@@ -0,0 +1,107 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/runtime_filter.h"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+#include "src/carnot/exec/spill.h"
+
+DEFINE_bool(carnot_join_runtime_filters,
+            gflags::BoolFromEnv("PL_CARNOT_JOIN_RUNTIME_FILTERS", true),
+            "Whether hash joins build a bloom filter of their build keys, which the memory source "
+            "of the probe side uses to drop rows that can't match.");
+DEFINE_int64(carnot_join_runtime_filter_max_keys,
+             gflags::Int64FromEnv("PL_CARNOT_JOIN_RUNTIME_FILTER_MAX_KEYS", 1 << 20),
+             "The largest build side, in rows, that a join runtime filter is built for.");
+DEFINE_double(carnot_join_runtime_filter_error_rate,
+              gflags::DoubleFromEnv("PL_CARNOT_JOIN_RUNTIME_FILTER_ERROR_RATE", 0.01),
+              "The false positive rate of join runtime filters.");
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+namespace {
+
+// Runtime filters use their own seed, the spill partitions use the ones from 1 up.
+constexpr uint64_t kRuntimeFilterSeed = 0;
+
+std::string_view HashBytes(const uint64_t& hash) {
+  return std::string_view(reinterpret_cast<const char*>(&hash), sizeof(hash));
+}
+
+}  // namespace
+
+void JoinRuntimeFilter::AddBuildKeys(const RowBatch& rb, const std::vector<int64_t>& key_cols) {
+  DCHECK(pending());
+  num_build_keys_ += rb.num_rows();
+  if (num_build_keys_ > FLAGS_carnot_join_runtime_filter_max_keys) {
+    key_hashes_.clear();
+    key_hashes_.shrink_to_fit();
+    return;
+  }
+  std::vector<uint64_t> hashes;
+  HashKeyColumns(rb, key_cols, kRuntimeFilterSeed, &hashes);
+  key_hashes_.insert(key_hashes_.end(), hashes.begin(), hashes.end());
+}
+
+Status JoinRuntimeFilter::Finish() {
+  if (num_build_keys_ <= FLAGS_carnot_join_runtime_filter_max_keys) {
+    // An empty build side still gets a filter, which drops every row.
+    PX_ASSIGN_OR_RETURN(bloom_filter_,
+                        bloomfilter::XXHash64BloomFilter::Create(
+                            std::max<int64_t>(key_hashes_.size(), 1),
+                            FLAGS_carnot_join_runtime_filter_error_rate));
+    for (const auto& hash : key_hashes_) {
+      bloom_filter_->Insert(HashBytes(hash));
+    }
+  }
+  key_hashes_.clear();
+  key_hashes_.shrink_to_fit();
+  finished_.store(true, std::memory_order_release);
+  return Status::OK();
+}
+
+int64_t JoinRuntimeFilter::Apply(RowBatch* rb, const std::vector<int64_t>& key_cols) const {
+  if (pending() || bloom_filter_ == nullptr || rb->has_selection() || rb->num_rows() == 0) {
+    return 0;
+  }
+  std::vector<uint64_t> hashes;
+  HashKeyColumns(*rb, key_cols, kRuntimeFilterSeed, &hashes);
+  auto selection = std::make_shared<std::vector<uint32_t>>();
+  selection->reserve(hashes.size());
+  for (size_t i = 0; i < hashes.size(); ++i) {
+    if (bloom_filter_->Contains(HashBytes(hashes[i]))) {
+      selection->push_back(i);
+    }
+  }
+  int64_t dropped = rb->num_rows() - selection->size();
+  if (dropped > 0) {
+    rb->SetSelection(std::move(selection));
+  }
+  return dropped;
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "src/common/base/base.h"
+#include "src/shared/bloomfilter/bloomfilter.h"
+#include "src/table_store/schema/row_batch.h"
+
+DECLARE_bool(carnot_join_runtime_filters);
+DECLARE_int64(carnot_join_runtime_filter_max_keys);
+DECLARE_double(carnot_join_runtime_filter_error_rate);
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * JoinRuntimeFilter is a bloom filter of the keys of the build side of a hash join. Once the build
+ * side is done, the filter is applied to the source of the probe side, which drops the probe rows
+ * that can't match anything before they reach the join.
+ *
+ * The filter is built by the join and applied by the source, which are both run by the thread
+ * that executes the plan fragment, but ready() may be checked from any thread.
+ */
+class JoinRuntimeFilter {
+ public:
+  /**
+   * Adds the keys of a build batch to the filter.
+   * @param key_cols The indices of the key columns in the batch.
+   */
+  void AddBuildKeys(const table_store::schema::RowBatch& rb, const std::vector<int64_t>& key_cols);
+
+  /**
+   * Builds the filter from all of the keys that were added. Build sides with more keys than
+   * --carnot_join_runtime_filter_max_keys don't get a filter, since it would drop few rows.
+   */
+  Status Finish();
+
+  /**
+   * @return whether the build side is still being read, so applying the filter would be a no-op.
+   */
+  bool pending() const { return !finished_.load(std::memory_order_acquire); }
+
+  /**
+   * Selects the rows of the batch whose keys may be in the build side, by setting the selection
+   * of the batch. Does nothing until the filter is finished, or for batches that already have a
+   * selection.
+   * @param key_cols The indices of the key columns in the batch, in the order of the build keys.
+   * @return the number of rows that were dropped.
+   */
+  int64_t Apply(table_store::schema::RowBatch* rb, const std::vector<int64_t>& key_cols) const;
+
+  int64_t num_build_keys() const { return num_build_keys_; }
+
+ private:
+  std::vector<uint64_t> key_hashes_;
+  int64_t num_build_keys_ = 0;
+  std::unique_ptr<bloomfilter::XXHash64BloomFilter> bloom_filter_;
+  std::atomic<bool> finished_ = false;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
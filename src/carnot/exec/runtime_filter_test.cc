@@ -0,0 +1,107 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/runtime_filter.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/common/testing/testing.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowDescriptor;
+
+TEST(JoinRuntimeFilterTest, selects_matching_rows) {
+  // The build side has (key, value), the probe side has (value, key).
+  RowDescriptor build_rd({types::DataType::STRING, types::DataType::INT64});
+  RowDescriptor probe_rd({types::DataType::INT64, types::DataType::STRING});
+
+  JoinRuntimeFilter filter;
+  EXPECT_TRUE(filter.pending());
+  filter.AddBuildKeys(RowBatchBuilder(build_rd, 2, /*eow*/ false, /*eos*/ false)
+                          .AddColumn<types::StringValue>({"abc", "def"})
+                          .AddColumn<types::Int64Value>({1, 2})
+                          .get(),
+                      {0});
+
+  auto rb = RowBatchBuilder(probe_rd, 4, /*eow*/ false, /*eos*/ false)
+                .AddColumn<types::Int64Value>({1, 2, 3, 4})
+                .AddColumn<types::StringValue>({"def", "ghi", "abc", "jkl"})
+                .get();
+  // Nothing is filtered until the build side is done.
+  EXPECT_EQ(0, filter.Apply(&rb, {1}));
+  EXPECT_FALSE(rb.has_selection());
+
+  filter.AddBuildKeys(RowBatchBuilder(build_rd, 1, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<types::StringValue>({"abc"})
+                          .AddColumn<types::Int64Value>({3})
+                          .get(),
+                      {0});
+  ASSERT_OK(filter.Finish());
+  EXPECT_FALSE(filter.pending());
+  EXPECT_EQ(3, filter.num_build_keys());
+
+  // Bloom filters can have false positives, but not at this size.
+  EXPECT_EQ(2, filter.Apply(&rb, {1}));
+  ASSERT_TRUE(rb.has_selection());
+  EXPECT_EQ(std::vector<uint32_t>({0, 2}), rb.selection());
+  EXPECT_EQ(2, rb.num_rows());
+}
+
+TEST(JoinRuntimeFilterTest, empty_build_side) {
+  RowDescriptor rd({types::DataType::INT64});
+
+  JoinRuntimeFilter filter;
+  ASSERT_OK(filter.Finish());
+
+  auto rb = RowBatchBuilder(rd, 3, /*eow*/ true, /*eos*/ true)
+                .AddColumn<types::Int64Value>({1, 2, 3})
+                .get();
+  EXPECT_EQ(3, filter.Apply(&rb, {0}));
+  EXPECT_EQ(0, rb.num_rows());
+  EXPECT_TRUE(rb.eos());
+}
+
+TEST(JoinRuntimeFilterTest, too_many_build_keys) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_join_runtime_filter_max_keys, 2);
+  RowDescriptor rd({types::DataType::INT64});
+
+  JoinRuntimeFilter filter;
+  filter.AddBuildKeys(RowBatchBuilder(rd, 3, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<types::Int64Value>({1, 2, 3})
+                          .get(),
+                      {0});
+  ASSERT_OK(filter.Finish());
+  EXPECT_FALSE(filter.pending());
+
+  auto rb = RowBatchBuilder(rd, 2, /*eow*/ false, /*eos*/ false)
+                .AddColumn<types::Int64Value>({4, 5})
+                .get();
+  EXPECT_EQ(0, filter.Apply(&rb, {0}));
+  EXPECT_FALSE(rb.has_selection());
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
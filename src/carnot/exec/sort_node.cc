@@ -0,0 +1,271 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/sort_node.h"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+using table_store::schema::RowDescriptor;
+
+namespace {
+
+// The top-k is compacted once the batches it holds have this many times more rows than the limit.
+constexpr int64_t kCompactionFactor = 4;
+// Top-k's with small limits aren't compacted until they hold at least this many rows.
+constexpr int64_t kMinCompactionRows = 64 * 1024;
+
+template <types::DataType T>
+int CompareValues(const arrow::Array* a, int64_t a_row, const arrow::Array* b, int64_t b_row) {
+  if constexpr (T == types::DataType::STRING) {
+    auto a_val = types::GetStringViewFromArrowArray(a, a_row);
+    auto b_val = types::GetStringViewFromArrowArray(b, b_row);
+    return a_val.compare(b_val);
+  } else {
+    auto a_val = types::GetValueFromArrowArray<T>(a, a_row);
+    auto b_val = types::GetValueFromArrowArray<T>(b, b_row);
+    return (a_val < b_val) ? -1 : (b_val < a_val ? 1 : 0);
+  }
+}
+
+template <types::DataType T, typename TRowRef>
+Status GatherColumn(const std::vector<const arrow::Array*>& input_cols,
+                    const std::vector<TRowRef>& rows, arrow::MemoryPool* mem_pool,
+                    std::shared_ptr<arrow::Array>* output_col) {
+  auto builder = types::MakeArrowBuilder(T, mem_pool);
+  auto* typed_builder =
+      static_cast<typename types::DataTypeTraits<T>::arrow_builder_type*>(builder.get());
+  PX_RETURN_IF_ERROR(typed_builder->Reserve(rows.size()));
+  if constexpr (T == types::DataType::STRING) {
+    int64_t data_size = 0;
+    for (const auto& row : rows) {
+      const auto* str_col = static_cast<const arrow::StringArray*>(input_cols[row.batch_idx]);
+      data_size += str_col->value_length(row.row_idx);
+    }
+    PX_RETURN_IF_ERROR(typed_builder->ReserveData(data_size));
+    for (const auto& row : rows) {
+      auto view = types::GetStringViewFromArrowArray(input_cols[row.batch_idx], row.row_idx);
+      typed_builder->UnsafeAppend(view.data(), static_cast<int32_t>(view.size()));
+    }
+  } else {
+    for (const auto& row : rows) {
+      typed_builder->UnsafeAppend(
+          types::GetValueFromArrowArray<T>(input_cols[row.batch_idx], row.row_idx));
+    }
+  }
+  PX_RETURN_IF_ERROR(typed_builder->Finish(output_col));
+  return Status::OK();
+}
+
+}  // namespace
+
+std::string SortNode::DebugStringImpl() {
+  return absl::Substitute("Exec::SortNode<$0>", plan_node_->DebugString());
+}
+
+Status SortNode::InitImpl(const plan::Operator& plan_node) {
+  CHECK(plan_node.op_type() == planpb::OperatorType::SORT_OPERATOR);
+  const auto* sort_plan_node = static_cast<const plan::SortOperator*>(&plan_node);
+  // copy the plan node to local object;
+  plan_node_ = std::make_unique<plan::SortOperator>(*sort_plan_node);
+
+  if (input_descriptors_.size() != 1) {
+    return error::InvalidArgument("Sort operator expects a single input relation, got $0",
+                                  input_descriptors_.size());
+  }
+  input_descriptor_ = &input_descriptors_[0];
+  for (const auto& sort_col : plan_node_->sort_columns()) {
+    if (sort_col.index < 0 || sort_col.index >= static_cast<int64_t>(input_descriptor_->size())) {
+      return error::InvalidArgument("Sort column $0 is out of range", sort_col.index);
+    }
+#define TYPE_CASE(_dt_) compare_fns_.push_back(&CompareValues<_dt_>);
+    PX_SWITCH_FOREACH_DATATYPE(input_descriptor_->type(sort_col.index), TYPE_CASE);
+#undef TYPE_CASE
+  }
+  return Status::OK();
+}
+
+Status SortNode::PrepareImpl(ExecState* /*exec_state*/) { return Status::OK(); }
+
+Status SortNode::OpenImpl(ExecState* /*exec_state*/) { return Status::OK(); }
+
+Status SortNode::CloseImpl(ExecState* /*exec_state*/) {
+  batches_.clear();
+  batch_refs_.clear();
+  unreferenced_batches_.clear();
+  rows_.clear();
+  held_rows_ = 0;
+  return Status::OK();
+}
+
+bool SortNode::RowLess(const RowRef& a, const RowRef& b) const {
+  const auto& sort_cols = plan_node_->sort_columns();
+  for (size_t i = 0; i < sort_cols.size(); ++i) {
+    int64_t col_idx = sort_cols[i].index;
+    int cmp = compare_fns_[i](batches_[a.batch_idx]->ColumnAt(col_idx).get(), a.row_idx,
+                              batches_[b.batch_idx]->ColumnAt(col_idx).get(), b.row_idx);
+    if (cmp != 0) {
+      return sort_cols[i].descending ? cmp > 0 : cmp < 0;
+    }
+  }
+  return false;
+}
+
+void SortNode::AddRowToTopK(const RowRef& row) {
+  auto less = [this](const RowRef& a, const RowRef& b) { return RowLess(a, b); };
+  if (static_cast<int64_t>(rows_.size()) < plan_node_->limit()) {
+    rows_.push_back(row);
+    ++batch_refs_[row.batch_idx];
+    std::push_heap(rows_.begin(), rows_.end(), less);
+    return;
+  }
+  // The front of the heap is the last row of the top-k, which the new row has to beat. Ties keep
+  // the row that came first.
+  if (!RowLess(row, rows_.front())) {
+    return;
+  }
+  std::pop_heap(rows_.begin(), rows_.end(), less);
+  ReleaseRow(rows_.back());
+  rows_.back() = row;
+  ++batch_refs_[row.batch_idx];
+  std::push_heap(rows_.begin(), rows_.end(), less);
+}
+
+void SortNode::ReleaseRow(const RowRef& row) {
+  // The batch itself is released once the whole input batch has been added, since the rows that
+  // come after this one still need it.
+  if (--batch_refs_[row.batch_idx] == 0) {
+    unreferenced_batches_.push_back(row.batch_idx);
+  }
+}
+
+StatusOr<std::unique_ptr<RowBatch>> SortNode::GatherRows(ExecState* exec_state,
+                                                         const std::vector<RowRef>& rows) const {
+  auto output_rb = std::make_unique<RowBatch>(*input_descriptor_, rows.size());
+  std::vector<const arrow::Array*> input_cols(batches_.size(), nullptr);
+  for (size_t col_idx = 0; col_idx < input_descriptor_->size(); ++col_idx) {
+    for (size_t batch_idx = 0; batch_idx < batches_.size(); ++batch_idx) {
+      input_cols[batch_idx] =
+          batches_[batch_idx] == nullptr ? nullptr : batches_[batch_idx]->ColumnAt(col_idx).get();
+    }
+    std::shared_ptr<arrow::Array> output_col;
+#define TYPE_CASE(_dt_)                                                                  \
+  PX_RETURN_IF_ERROR(                                                                    \
+      GatherColumn<_dt_>(input_cols, rows, exec_state->exec_mem_pool(), &output_col));
+    PX_SWITCH_FOREACH_DATATYPE(input_descriptor_->type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(output_col));
+  }
+  return output_rb;
+}
+
+Status SortNode::CompactTopK(ExecState* exec_state) {
+  PX_ASSIGN_OR_RETURN(std::shared_ptr<const RowBatch> compacted, GatherRows(exec_state, rows_));
+  // The rows keep their places in the heap, they just move to the compacted batch.
+  for (size_t i = 0; i < rows_.size(); ++i) {
+    rows_[i] = RowRef{0, static_cast<uint32_t>(i)};
+  }
+  batches_ = {std::move(compacted)};
+  batch_refs_ = {static_cast<int64_t>(rows_.size())};
+  held_rows_ = rows_.size();
+  return Status::OK();
+}
+
+Status SortNode::EmitSortedRows(ExecState* exec_state, bool eos) {
+  auto less = [this](const RowRef& a, const RowRef& b) { return RowLess(a, b); };
+  if (plan_node_->limit() > 0) {
+    std::sort_heap(rows_.begin(), rows_.end(), less);
+  } else {
+    std::stable_sort(rows_.begin(), rows_.end(), less);
+  }
+
+  std::unique_ptr<RowBatch> output_rb;
+  if (rows_.empty()) {
+    PX_ASSIGN_OR_RETURN(output_rb, RowBatch::WithZeroRows(*output_descriptor_, /*eow*/ true, eos));
+  } else {
+    PX_ASSIGN_OR_RETURN(auto sorted_rb, GatherRows(exec_state, rows_));
+    output_rb = std::make_unique<RowBatch>(*output_descriptor_, sorted_rb->num_rows());
+    for (int64_t input_col_idx : plan_node_->selected_cols()) {
+      PX_RETURN_IF_ERROR(output_rb->AddColumn(sorted_rb->ColumnAt(input_col_idx)));
+    }
+    output_rb->set_eow(true);
+    output_rb->set_eos(eos);
+  }
+
+  batches_.clear();
+  batch_refs_.clear();
+  unreferenced_batches_.clear();
+  rows_.clear();
+  held_rows_ = 0;
+  return SendRowBatchToChildren(exec_state, *output_rb);
+}
+
+Status SortNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb, size_t) {
+  if (rb.num_rows() > 0) {
+    auto batch_idx = static_cast<uint32_t>(batches_.size());
+    batches_.push_back(std::make_shared<const RowBatch>(rb));
+    batch_refs_.push_back(0);
+    held_rows_ += rb.num_rows();
+
+    for (int64_t row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+      RowRef row{batch_idx, static_cast<uint32_t>(row_idx)};
+      if (plan_node_->limit() > 0) {
+        AddRowToTopK(row);
+      } else {
+        rows_.push_back(row);
+        ++batch_refs_[batch_idx];
+      }
+    }
+
+    // Drop the batches that no longer have any rows in the top-k.
+    unreferenced_batches_.push_back(batch_idx);
+    for (uint32_t i : unreferenced_batches_) {
+      if (batches_[i] != nullptr && batch_refs_[i] == 0) {
+        held_rows_ -= batches_[i]->num_rows();
+        batches_[i].reset();
+      }
+    }
+    unreferenced_batches_.clear();
+    if (plan_node_->limit() > 0 &&
+        held_rows_ > std::max(kMinCompactionRows, kCompactionFactor * plan_node_->limit())) {
+      PX_RETURN_IF_ERROR(CompactTopK(exec_state));
+    }
+  }
+
+  if (rb.eow()) {
+    return EmitSortedRows(exec_state, rb.eos());
+  }
+  return Status::OK();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
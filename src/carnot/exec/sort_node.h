@@ -0,0 +1,99 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/array.h>
+
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/plan/operators.h"
+#include "src/common/base/base.h"
+#include "src/common/base/status.h"
+#include "src/table_store/table_store.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * SortNode sorts the rows of each window of its input, and outputs them once the window ends.
+ *
+ * With a limit, it's a top-k: only the first limit rows of the sorted order are kept, in a bounded
+ * heap, so its memory doesn't grow with the input. Running it on each agent and again on the
+ * merged results gives the same rows as running it once.
+ */
+class SortNode : public ProcessingNode {
+ public:
+  SortNode() = default;
+  virtual ~SortNode() = default;
+
+ protected:
+  std::string DebugStringImpl() override;
+  Status InitImpl(const plan::Operator& plan_node) override;
+  Status PrepareImpl(ExecState* exec_state) override;
+  Status OpenImpl(ExecState* exec_state) override;
+  Status CloseImpl(ExecState* exec_state) override;
+  Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                         size_t parent_index) override;
+
+ private:
+  // A row of one of the input batches that are held by the node.
+  struct RowRef {
+    uint32_t batch_idx;
+    uint32_t row_idx;
+  };
+  // Compares the values of a sort column in two rows. Negative if the first one is smaller.
+  using CompareFn = int (*)(const arrow::Array*, int64_t, const arrow::Array*, int64_t);
+
+  bool RowLess(const RowRef& a, const RowRef& b) const;
+  void AddRowToTopK(const RowRef& row);
+  void ReleaseRow(const RowRef& row);
+  // Copies the rows into a new batch, with every input column.
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> GatherRows(
+      ExecState* exec_state, const std::vector<RowRef>& rows) const;
+  // Replaces the batches that hold the top-k rows with a single batch of just those rows.
+  Status CompactTopK(ExecState* exec_state);
+  Status EmitSortedRows(ExecState* exec_state, bool eos);
+
+  std::unique_ptr<plan::SortOperator> plan_node_;
+  const table_store::schema::RowDescriptor* input_descriptor_ = nullptr;
+  std::vector<CompareFn> compare_fns_;
+
+  // The input batches that rows_ refer to. Batches without any rows left in the top-k are
+  // released.
+  std::vector<std::shared_ptr<const table_store::schema::RowBatch>> batches_;
+  // The number of rows of rows_ in each of batches_.
+  std::vector<int64_t> batch_refs_;
+  // The batches whose rows all left the top-k while the current input batch was added.
+  std::vector<uint32_t> unreferenced_batches_;
+  // The number of rows of the batches that are still held.
+  int64_t held_rows_ = 0;
+  // All of the rows without a limit, otherwise a max heap of the first limit rows.
+  std::vector<RowRef> rows_;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
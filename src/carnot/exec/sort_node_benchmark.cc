@@ -0,0 +1,122 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arrow/memory_pool.h>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+#include <google/protobuf/text_format.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/sort_node.h"
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/datagen/datagen.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/table_store.h"
+
+using px::carnot::exec::ExecState;
+using px::carnot::exec::MockMetricsStubGenerator;
+using px::carnot::exec::MockResultSinkStubGenerator;
+using px::carnot::exec::MockTraceStubGenerator;
+using px::carnot::exec::SortNode;
+using px::carnot::udf::Registry;
+using px::table_store::schema::RowBatch;
+using px::table_store::schema::RowDescriptor;
+using px::types::DataType;
+using px::types::Int64Value;
+using px::types::StringValue;
+using px::types::ToArrow;
+
+constexpr char kSortPlanNode[] = R"(
+op_type: SORT_OPERATOR
+sort_op {
+  sort_columns { index: 0 descending: true }
+  limit: $0
+  columns { index: 0 }
+  columns { index: 1 }
+})";
+
+constexpr int64_t kBatchSize = 1024;
+
+// Measures sorting a window of rows by an int column, either keeping only the first limit rows in
+// a bounded heap (a top-k), or sorting all of them, as a merge that gets every row would have to.
+// NOLINTNEXTLINE : runtime/references.
+void BM_SortWindow(benchmark::State& state) {
+  int64_t num_rows = state.range(0);
+  int64_t limit = state.range(1);
+
+  auto func_registry = std::make_unique<Registry>("test_registry");
+  auto table_store = std::make_shared<px::table_store::TableStore>();
+  auto exec_state = std::make_unique<ExecState>(
+      func_registry.get(), table_store, MockResultSinkStubGenerator, MockMetricsStubGenerator,
+      MockTraceStubGenerator, sole::uuid4(), nullptr);
+
+  RowDescriptor rd({DataType::INT64, DataType::STRING});
+  std::vector<RowBatch> input_rbs;
+  for (int64_t offset = 0; offset < num_rows; offset += kBatchSize) {
+    int64_t batch_size = std::min(kBatchSize, num_rows - offset);
+    auto values = px::datagen::CreateLargeData<Int64Value>(batch_size, 0, 1 << 30);
+    std::vector<StringValue> strings(batch_size);
+    for (auto& s : strings) {
+      s = px::datagen::RandomString(16);
+    }
+    RowBatch rb(rd, batch_size);
+    PX_CHECK_OK(rb.AddColumn(ToArrow(values, arrow::default_memory_pool())));
+    PX_CHECK_OK(rb.AddColumn(ToArrow(strings, arrow::default_memory_pool())));
+    bool last = offset + batch_size >= num_rows;
+    rb.set_eow(last);
+    rb.set_eos(last);
+    input_rbs.push_back(std::move(rb));
+  }
+
+  px::carnot::planpb::Operator op_pb;
+  CHECK(google::protobuf::TextFormat::MergeFromString(absl::Substitute(kSortPlanNode, limit),
+                                                      &op_pb));
+  auto plan_node = px::carnot::plan::SortOperator::FromProto(op_pb, 1);
+
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    SortNode sort;
+    PX_CHECK_OK(sort.Init(*plan_node, rd, {rd}));
+    PX_CHECK_OK(sort.Prepare(exec_state.get()));
+    PX_CHECK_OK(sort.Open(exec_state.get()));
+    for (const auto& rb : input_rbs) {
+      PX_CHECK_OK(sort.ConsumeNext(exec_state.get(), rb, 0));
+    }
+    PX_CHECK_OK(sort.Close(exec_state.get()));
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * num_rows);
+}
+
+void SortArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t num_rows : {1 << 14, 1 << 20}) {
+    for (int64_t limit : {0, 10, 1000}) {
+      b->Args({num_rows, limit});
+    }
+  }
+}
+
+BENCHMARK(BM_SortWindow)->Apply(SortArgs);
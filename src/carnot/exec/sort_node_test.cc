@@ -0,0 +1,216 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/sort_node.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/strings/substitute.h>
+#include <google/protobuf/text_format.h>
+#include <gtest/gtest.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowDescriptor;
+using types::Int64Value;
+using types::StringValue;
+
+// Sorts by the first column, then by the second one in descending order.
+constexpr char kSortPlanNode[] = R"(
+op_type: SORT_OPERATOR
+sort_op {
+  sort_columns { index: 0 }
+  sort_columns { index: 1 descending: true }
+  limit: $0
+  columns { index: 0 }
+  columns { index: 1 }
+  columns { index: 2 }
+})";
+
+// Sorts by the string column and only outputs the int columns.
+constexpr char kSortByStringPlanNode[] = R"(
+op_type: SORT_OPERATOR
+sort_op {
+  sort_columns { index: 2 }
+  limit: $0
+  columns { index: 1 }
+  columns { index: 0 }
+})";
+
+std::unique_ptr<plan::Operator> PlanNodeFromPbtxt(const std::string& pbtxt, int64_t limit) {
+  planpb::Operator op_pb;
+  EXPECT_TRUE(
+      google::protobuf::TextFormat::MergeFromString(absl::Substitute(pbtxt, limit), &op_pb));
+  return plan::SortOperator::FromProto(op_pb, 1);
+}
+
+class SortNodeTest : public ::testing::Test {
+ public:
+  SortNodeTest() {
+    func_registry_ = std::make_unique<udf::Registry>("test_registry");
+    auto table_store = std::make_shared<table_store::TableStore>();
+    exec_state_ = std::make_unique<ExecState>(func_registry_.get(), table_store,
+                                              MockResultSinkStubGenerator, MockMetricsStubGenerator,
+                                              MockTraceStubGenerator, sole::uuid4(), nullptr);
+  }
+
+ protected:
+  RowDescriptor input_rd_{
+      {types::DataType::INT64, types::DataType::INT64, types::DataType::STRING}};
+  std::unique_ptr<ExecState> exec_state_;
+  std::unique_ptr<udf::Registry> func_registry_;
+};
+
+TEST_F(SortNodeTest, full_sort) {
+  auto plan_node = PlanNodeFromPbtxt(kSortPlanNode, /*limit*/ 0);
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(
+      *plan_node, input_rd_, {input_rd_}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({3, 1, 2})
+                       .AddColumn<Int64Value>({1, 1, 1})
+                       .AddColumn<StringValue>({"a", "b", "c"})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({1, 0, 3})
+                       .AddColumn<Int64Value>({2, 5, 0})
+                       .AddColumn<StringValue>({"d", "e", "f"})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(input_rd_, 6, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Int64Value>({0, 1, 1, 2, 3, 3})
+                          .AddColumn<Int64Value>({5, 2, 1, 1, 1, 0})
+                          .AddColumn<StringValue>({"e", "d", "b", "c", "a", "f"})
+                          .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, top_k) {
+  auto plan_node = PlanNodeFromPbtxt(kSortPlanNode, /*limit*/ 3);
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(
+      *plan_node, input_rd_, {input_rd_}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({5, 4, 9, 7})
+                       .AddColumn<Int64Value>({0, 0, 0, 0})
+                       .AddColumn<StringValue>({"a", "b", "c", "d"})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Int64Value>({8, 6, 10})
+                       .AddColumn<Int64Value>({0, 0, 0})
+                       .AddColumn<StringValue>({"e", "f", "g"})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd_, 2, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({5, 1})
+                       .AddColumn<Int64Value>({3, 0})
+                       .AddColumn<StringValue>({"h", "i"})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(input_rd_, 3, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Int64Value>({1, 4, 5})
+                          .AddColumn<Int64Value>({0, 0, 3})
+                          .AddColumn<StringValue>({"i", "b", "h"})
+                          .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, top_k_by_string_with_projection) {
+  RowDescriptor output_rd({types::DataType::INT64, types::DataType::INT64});
+  auto plan_node = PlanNodeFromPbtxt(kSortByStringPlanNode, /*limit*/ 2);
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(
+      *plan_node, output_rd, {input_rd_}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 4, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({1, 2, 3, 4})
+                       .AddColumn<Int64Value>({10, 20, 30, 40})
+                       .AddColumn<StringValue>({"pear", "apple", "fig", "banana"})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Int64Value>({20, 40})
+                          .AddColumn<Int64Value>({2, 4})
+                          .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, windows) {
+  auto plan_node = PlanNodeFromPbtxt(kSortPlanNode, /*limit*/ 2);
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(
+      *plan_node, input_rd_, {input_rd_}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 3, /*eow*/ true, /*eos*/ false)
+                       .AddColumn<Int64Value>({3, 1, 2})
+                       .AddColumn<Int64Value>({0, 0, 0})
+                       .AddColumn<StringValue>({"a", "b", "c"})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(input_rd_, 2, /*eow*/ true, /*eos*/ false)
+                          .AddColumn<Int64Value>({1, 2})
+                          .AddColumn<Int64Value>({0, 0})
+                          .AddColumn<StringValue>({"b", "c"})
+                          .get())
+      // The rows of the first window don't show up in the second one.
+      .ConsumeNext(RowBatchBuilder(input_rd_, 2, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({6, 5})
+                       .AddColumn<Int64Value>({0, 0})
+                       .AddColumn<StringValue>({"d", "e"})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(input_rd_, 2, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Int64Value>({5, 6})
+                          .AddColumn<Int64Value>({0, 0})
+                          .AddColumn<StringValue>({"e", "d"})
+                          .get())
+      .Close();
+}
+
+TEST_F(SortNodeTest, empty_input) {
+  auto plan_node = PlanNodeFromPbtxt(kSortPlanNode, /*limit*/ 2);
+  auto tester = exec::ExecNodeTester<SortNode, plan::SortOperator>(
+      *plan_node, input_rd_, {input_rd_}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd_, 0, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Int64Value>({})
+                       .AddColumn<Int64Value>({})
+                       .AddColumn<StringValue>({})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(input_rd_, 0, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Int64Value>({})
+                          .AddColumn<Int64Value>({})
+                          .AddColumn<StringValue>({})
+                          .get())
+      .Close();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/spill.h"
+
+#include <farmhash.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "src/common/base/hash_utils.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/type_utils.h"
+#include "src/table_store/schemapb/schema.pb.h"
+
+DEFINE_int64(carnot_spill_memory_budget,
+             gflags::Int64FromEnv("PL_CARNOT_SPILL_MEMORY_BUDGET", 0),
+             "The number of bytes of state that the blocking aggregates and joins of a query can "
+             "hold in memory before they spill to disk. 0 disables spilling.");
+DEFINE_string(carnot_spill_dir, gflags::StringFromEnv("PL_CARNOT_SPILL_DIR", "/tmp"),
+              "The directory where queries spill to once they exceed their memory budget.");
+DEFINE_int32(carnot_spill_partitions, gflags::Int32FromEnv("PL_CARNOT_SPILL_PARTITIONS", 16),
+             "The number of partitions that spilled state is split into.");
+DEFINE_int32(carnot_spill_max_depth, gflags::Int32FromEnv("PL_CARNOT_SPILL_MAX_DEPTH", 3),
+             "How many times a spilled partition that still exceeds the memory budget is split "
+             "again, before it is processed in memory regardless.");
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+StatusOr<std::unique_ptr<SpillFile>> SpillFile::Create(const std::string& dir) {
+  std::string path = dir + "/carnot_spill_XXXXXX";
+  int fd = mkstemp(path.data());
+  if (fd < 0) {
+    return error::System("Failed to create spill file in $0: $1", dir, std::strerror(errno));
+  }
+  // The file is only ever accessed through the descriptor.
+  unlink(path.c_str());
+  return std::unique_ptr<SpillFile>(new SpillFile(fd));
+}
+
+SpillFile::~SpillFile() { close(fd_); }
+
+namespace {
+
+Status WriteAt(int fd, const char* data, int64_t size, int64_t offset) {
+  while (size > 0) {
+    ssize_t n = pwrite(fd, data, size, offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return error::System("Failed to write spill file: $0", std::strerror(errno));
+    }
+    data += n;
+    size -= n;
+    offset += n;
+  }
+  return Status::OK();
+}
+
+Status ReadAt(int fd, char* data, int64_t size, int64_t offset) {
+  while (size > 0) {
+    ssize_t n = pread(fd, data, size, offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return error::System("Failed to read spill file: $0", std::strerror(errno));
+    }
+    if (n == 0) {
+      return error::Internal("Unexpected end of spill file");
+    }
+    data += n;
+    size -= n;
+    offset += n;
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+// Each batch is stored as its size followed by the serialized RowBatchData.
+StatusOr<int64_t> SpillFile::Write(const RowBatch& rb) {
+  table_store::schemapb::RowBatchData proto;
+  PX_RETURN_IF_ERROR(rb.ToArrowBuffersProto(&proto));
+  std::string bytes;
+  if (!proto.SerializeToString(&bytes)) {
+    return error::Internal("Failed to serialize spilled row batch");
+  }
+  uint64_t size = bytes.size();
+  PX_RETURN_IF_ERROR(
+      WriteAt(fd_, reinterpret_cast<const char*>(&size), sizeof(size), write_offset_));
+  PX_RETURN_IF_ERROR(WriteAt(fd_, bytes.data(), bytes.size(), write_offset_ + sizeof(size)));
+  int64_t written = sizeof(size) + bytes.size();
+  write_offset_ += written;
+  ++num_batches_;
+  return written;
+}
+
+StatusOr<std::unique_ptr<RowBatch>> SpillFile::ReadNext() {
+  if (read_offset_ >= write_offset_) {
+    return std::unique_ptr<RowBatch>();
+  }
+  uint64_t size = 0;
+  PX_RETURN_IF_ERROR(ReadAt(fd_, reinterpret_cast<char*>(&size), sizeof(size), read_offset_));
+  std::string bytes(size, '\0');
+  PX_RETURN_IF_ERROR(ReadAt(fd_, bytes.data(), size, read_offset_ + sizeof(size)));
+  read_offset_ += sizeof(size) + size;
+
+  auto proto = std::make_shared<table_store::schemapb::RowBatchData>();
+  if (!proto->ParseFromString(bytes)) {
+    return error::Internal("Failed to parse spilled row batch");
+  }
+  // The columns alias the buffers of the proto.
+  return RowBatch::FromProto(std::shared_ptr<const table_store::schemapb::RowBatchData>(proto));
+}
+
+bool SpillManager::TryReserve(int64_t bytes) {
+  int64_t reserved = reserved_bytes_.load();
+  do {
+    if (reserved + bytes > memory_budget_) {
+      return false;
+    }
+  } while (!reserved_bytes_.compare_exchange_weak(reserved, reserved + bytes));
+  return true;
+}
+
+void SpillManager::RecordSpilledBytes(int64_t bytes) {
+  spilled_bytes_ += bytes;
+  if (exec_metrics_ != nullptr) {
+    exec_metrics_->spilled_bytes_counter.Increment(bytes);
+  }
+}
+
+void SpillManager::RecordPartitionRecursed() {
+  ++partitions_recursed_;
+  if (exec_metrics_ != nullptr) {
+    exec_metrics_->spill_partitions_recursed_counter.Increment();
+  }
+}
+
+namespace {
+
+template <types::DataType DT>
+void HashKeyColumn(const arrow::Array* col, int64_t num_rows, std::vector<uint64_t>* hashes) {
+  for (int64_t i = 0; i < num_rows; ++i) {
+    uint64_t hash;
+    if constexpr (DT == types::DataType::STRING) {
+      auto val = types::GetStringViewFromArrowArray(col, i);
+      hash = ::util::Hash64(val.data(), val.size());
+    } else {
+      auto val = types::GetValueFromArrowArray<DT>(col, i);
+      hash = ::util::Hash64(reinterpret_cast<const char*>(&val), sizeof(val));
+    }
+    (*hashes)[i] = HashCombine((*hashes)[i], hash);
+  }
+}
+
+}  // namespace
+
+void HashKeyColumns(const RowBatch& rb, const std::vector<int64_t>& key_cols, uint64_t seed,
+                    std::vector<uint64_t>* hashes) {
+  DCHECK(!rb.has_selection());
+  hashes->assign(rb.num_rows(), seed);
+  for (auto col_idx : key_cols) {
+    const auto* col = rb.ColumnAt(col_idx).get();
+#define TYPE_CASE(_dt_) HashKeyColumn<_dt_>(col, rb.num_rows(), hashes);
+    PX_SWITCH_FOREACH_DATATYPE(rb.desc().type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+  }
+}
+
+Status SpillPartitions::Add(const RowBatch& rb) {
+  if (rb.has_selection()) {
+    PX_ASSIGN_OR_RETURN(auto dense_rb, rb.Materialize());
+    return Add(*dense_rb);
+  }
+  HashKeyColumns(rb, key_cols_, static_cast<uint64_t>(depth_) + 1, &hashes_);
+  selections_.resize(files_.size());
+  for (auto& selection : selections_) {
+    selection.clear();
+  }
+  for (int64_t row_idx = 0; row_idx < rb.num_rows(); ++row_idx) {
+    selections_[hashes_[row_idx] % files_.size()].push_back(row_idx);
+  }
+
+  for (size_t i = 0; i < files_.size(); ++i) {
+    if (selections_[i].empty()) {
+      continue;
+    }
+    if (files_[i] == nullptr) {
+      PX_ASSIGN_OR_RETURN(files_[i], spill_manager_->CreateFile());
+    }
+    RowBatch partition_rb = rb;
+    partition_rb.set_eow(false);
+    partition_rb.set_eos(false);
+    if (selections_[i].size() < static_cast<size_t>(rb.num_rows())) {
+      partition_rb.SetSelection(std::make_shared<std::vector<uint32_t>>(selections_[i]));
+    }
+    PX_ASSIGN_OR_RETURN(int64_t bytes, files_[i]->Write(partition_rb));
+    spill_manager_->RecordSpilledBytes(bytes);
+  }
+  return Status::OK();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
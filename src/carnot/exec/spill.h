@@ -0,0 +1,174 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/carnot/exec/exec_metrics.h"
+#include "src/common/base/base.h"
+#include "src/table_store/schema/row_batch.h"
+
+DECLARE_int64(carnot_spill_memory_budget);
+DECLARE_string(carnot_spill_dir);
+DECLARE_int32(carnot_spill_partitions);
+DECLARE_int32(carnot_spill_max_depth);
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * SpillFile is an unnamed temporary file of row batches. The file is unlinked as soon as it is
+ * created, so its space is given back when it's closed, even if the process dies.
+ *
+ * Batches are stored in the Arrow buffers encoding of RowBatchData (the raw Arrow buffers of each
+ * column), so reading them back doesn't need to decode any values.
+ */
+class SpillFile {
+ public:
+  static StatusOr<std::unique_ptr<SpillFile>> Create(const std::string& dir);
+  ~SpillFile();
+
+  /**
+   * Appends the batch to the file.
+   * @return the number of bytes written.
+   */
+  StatusOr<int64_t> Write(const table_store::schema::RowBatch& rb);
+
+  /**
+   * Reads the next batch, in the order they were written.
+   * @return the batch, or nullptr once all of them were read.
+   */
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> ReadNext();
+
+  // Starts reading from the first batch again.
+  void Rewind() { read_offset_ = 0; }
+
+  int64_t bytes() const { return write_offset_; }
+  int64_t num_batches() const { return num_batches_; }
+
+ private:
+  explicit SpillFile(int fd) : fd_(fd) {}
+
+  const int fd_;
+  int64_t write_offset_ = 0;
+  int64_t read_offset_ = 0;
+  int64_t num_batches_ = 0;
+};
+
+/**
+ * SpillManager holds the memory budget that the blocking operators of a query (aggregates and join
+ * build sides) share, and where they spill to once it is exceeded. It's owned by the ExecState.
+ */
+class SpillManager {
+ public:
+  SpillManager(int64_t memory_budget, std::string spill_dir, ExecMetrics* exec_metrics)
+      : memory_budget_(memory_budget),
+        spill_dir_(std::move(spill_dir)),
+        exec_metrics_(exec_metrics) {}
+
+  /**
+   * @return whether the query has a memory budget. Operators don't spill otherwise.
+   */
+  bool enabled() const { return memory_budget_ > 0; }
+
+  /**
+   * Reserves bytes of the budget.
+   * @return false, without reserving anything, if the budget would be exceeded.
+   */
+  bool TryReserve(int64_t bytes);
+  void Release(int64_t bytes) { reserved_bytes_ -= bytes; }
+
+  StatusOr<std::unique_ptr<SpillFile>> CreateFile() const { return SpillFile::Create(spill_dir_); }
+
+  void RecordSpilledBytes(int64_t bytes);
+  void RecordPartitionRecursed();
+
+  int64_t reserved_bytes() const { return reserved_bytes_; }
+  int64_t spilled_bytes() const { return spilled_bytes_; }
+  int64_t partitions_recursed() const { return partitions_recursed_; }
+
+ private:
+  const int64_t memory_budget_;
+  const std::string spill_dir_;
+  ExecMetrics* exec_metrics_;
+
+  // Operators of parallel pipelines share the budget.
+  std::atomic<int64_t> reserved_bytes_ = 0;
+  std::atomic<int64_t> spilled_bytes_ = 0;
+  std::atomic<int64_t> partitions_recursed_ = 0;
+};
+
+/**
+ * Computes a hash of the key columns of every row of the batch. Equal keys hash the same, whichever
+ * batch they come from, as long as the key columns have the same types.
+ * @param seed Gives a different hash function for every level of partitioning.
+ */
+void HashKeyColumns(const table_store::schema::RowBatch& rb, const std::vector<int64_t>& key_cols,
+                    uint64_t seed, std::vector<uint64_t>* hashes);
+
+/**
+ * SpillPartitions splits row batches by the hash of their key columns into a fixed number of
+ * partitions, each written to its own SpillFile. All the rows with the same key end up in the same
+ * partition, so that the partitions can be processed one at a time.
+ */
+class SpillPartitions {
+ public:
+  /**
+   * @param key_cols The key columns of the batches that are added.
+   * @param depth How many times the rows were partitioned before, which picks the hash function.
+   * Partitions that are still too large are split again at depth + 1.
+   */
+  SpillPartitions(SpillManager* spill_manager, std::vector<int64_t> key_cols, int depth,
+                  int num_partitions = FLAGS_carnot_spill_partitions)
+      : spill_manager_(spill_manager),
+        key_cols_(std::move(key_cols)),
+        depth_(depth),
+        files_(num_partitions) {}
+
+  /**
+   * Writes each row of the batch to its partition.
+   */
+  Status Add(const table_store::schema::RowBatch& rb);
+
+  size_t num_partitions() const { return files_.size(); }
+  int depth() const { return depth_; }
+
+  /**
+   * @return the file of the partition, or nullptr if no rows were written to it.
+   */
+  SpillFile* partition(size_t i) const { return files_[i].get(); }
+
+ private:
+  SpillManager* spill_manager_;
+  const std::vector<int64_t> key_cols_;
+  const int depth_;
+  std::vector<std::unique_ptr<SpillFile>> files_;
+
+  std::vector<uint64_t> hashes_;
+  std::vector<std::vector<uint32_t>> selections_;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/spill.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+using table_store::schema::RowDescriptor;
+
+class SpillTest : public ::testing::Test {
+ protected:
+  SpillManager spill_manager_{/*memory_budget*/ 100, "/tmp", /*exec_metrics*/ nullptr};
+  RowDescriptor rd_{{types::DataType::STRING, types::DataType::INT64}};
+};
+
+TEST_F(SpillTest, file_round_trip) {
+  ASSERT_OK_AND_ASSIGN(auto file, spill_manager_.CreateFile());
+
+  auto rb1 = RowBatchBuilder(rd_, 3, /*eow*/ false, /*eos*/ false)
+                 .AddColumn<types::StringValue>({"abc", "", "defgh"})
+                 .AddColumn<types::Int64Value>({1, 2, 3})
+                 .get();
+  auto rb2 = RowBatchBuilder(rd_, 2, /*eow*/ true, /*eos*/ true)
+                 .AddColumn<types::StringValue>({"ijk", "lmn"})
+                 .AddColumn<types::Int64Value>({4, 5})
+                 .get();
+  ASSERT_OK_AND_ASSIGN(int64_t bytes1, file->Write(rb1));
+  ASSERT_OK_AND_ASSIGN(int64_t bytes2, file->Write(rb2));
+  EXPECT_EQ(bytes1 + bytes2, file->bytes());
+  EXPECT_EQ(2, file->num_batches());
+
+  for (int pass = 0; pass < 2; ++pass) {
+    ASSERT_OK_AND_ASSIGN(auto out1, file->ReadNext());
+    ASSERT_NE(nullptr, out1);
+    EXPECT_EQ(rb1.DebugString(), out1->DebugString());
+    ASSERT_OK_AND_ASSIGN(auto out2, file->ReadNext());
+    ASSERT_NE(nullptr, out2);
+    EXPECT_EQ(rb2.DebugString(), out2->DebugString());
+    ASSERT_OK_AND_ASSIGN(auto end, file->ReadNext());
+    EXPECT_EQ(nullptr, end);
+    file->Rewind();
+  }
+}
+
+TEST_F(SpillTest, write_selection) {
+  ASSERT_OK_AND_ASSIGN(auto file, spill_manager_.CreateFile());
+
+  auto rb = RowBatchBuilder(rd_, 4, /*eow*/ false, /*eos*/ false)
+                .AddColumn<types::StringValue>({"a", "b", "c", "d"})
+                .AddColumn<types::Int64Value>({1, 2, 3, 4})
+                .get();
+  rb.SetSelection(std::make_shared<std::vector<uint32_t>>(std::vector<uint32_t>{1, 3}));
+  ASSERT_OK(file->Write(rb));
+
+  auto expected = RowBatchBuilder(rd_, 2, /*eow*/ false, /*eos*/ false)
+                      .AddColumn<types::StringValue>({"b", "d"})
+                      .AddColumn<types::Int64Value>({2, 4})
+                      .get();
+  ASSERT_OK_AND_ASSIGN(auto out, file->ReadNext());
+  ASSERT_NE(nullptr, out);
+  EXPECT_EQ(expected.DebugString(), out->DebugString());
+}
+
+TEST_F(SpillTest, hash_key_columns) {
+  auto rb1 = RowBatchBuilder(rd_, 3, /*eow*/ false, /*eos*/ false)
+                 .AddColumn<types::StringValue>({"abc", "def", "abc"})
+                 .AddColumn<types::Int64Value>({1, 1, 2})
+                 .get();
+  auto rb2 = RowBatchBuilder(rd_, 2, /*eow*/ false, /*eos*/ false)
+                 .AddColumn<types::StringValue>({"def", "abc"})
+                 .AddColumn<types::Int64Value>({1, 2})
+                 .get();
+
+  std::vector<uint64_t> hashes1;
+  std::vector<uint64_t> hashes2;
+  HashKeyColumns(rb1, {0, 1}, /*seed*/ 1, &hashes1);
+  HashKeyColumns(rb2, {0, 1}, /*seed*/ 1, &hashes2);
+  ASSERT_EQ(3, hashes1.size());
+  ASSERT_EQ(2, hashes2.size());
+  EXPECT_EQ(hashes1[1], hashes2[0]);
+  EXPECT_EQ(hashes1[2], hashes2[1]);
+  EXPECT_NE(hashes1[0], hashes1[2]);
+
+  // Only the key columns are hashed.
+  HashKeyColumns(rb1, {0}, /*seed*/ 1, &hashes1);
+  EXPECT_EQ(hashes1[0], hashes1[2]);
+
+  std::vector<uint64_t> reseeded;
+  HashKeyColumns(rb1, {0}, /*seed*/ 2, &reseeded);
+  EXPECT_NE(hashes1[0], reseeded[0]);
+}
+
+TEST_F(SpillTest, partitions_keep_keys_together) {
+  SpillPartitions partitions(&spill_manager_, {0}, /*depth*/ 0, /*num_partitions*/ 4);
+
+  auto rb = RowBatchBuilder(rd_, 6, /*eow*/ true, /*eos*/ true)
+                .AddColumn<types::StringValue>({"a", "b", "c", "a", "b", "c"})
+                .AddColumn<types::Int64Value>({1, 2, 3, 4, 5, 6})
+                .get();
+  ASSERT_OK(partitions.Add(rb));
+  ASSERT_OK(partitions.Add(rb));
+
+  int64_t num_rows = 0;
+  absl::flat_hash_map<std::string, size_t> key_partitions;
+  for (size_t i = 0; i < partitions.num_partitions(); ++i) {
+    auto* file = partitions.partition(i);
+    if (file == nullptr) {
+      continue;
+    }
+    EXPECT_EQ(2, file->num_batches());
+    while (true) {
+      ASSERT_OK_AND_ASSIGN(auto out, file->ReadNext());
+      if (out == nullptr) {
+        break;
+      }
+      // The eow/eos of the input belong to the operator, not to the partitions.
+      EXPECT_FALSE(out->eow());
+      EXPECT_FALSE(out->eos());
+      num_rows += out->num_rows();
+      for (int64_t row = 0; row < out->num_rows(); ++row) {
+        auto key = std::string(types::GetStringViewFromArrowArray(out->ColumnAt(0).get(), row));
+        auto it = key_partitions.emplace(key, i).first;
+        EXPECT_EQ(i, it->second) << key;
+      }
+    }
+  }
+  EXPECT_EQ(12, num_rows);
+  EXPECT_GT(spill_manager_.spilled_bytes(), 0);
+}
+
+TEST_F(SpillTest, manager_budget) {
+  EXPECT_TRUE(spill_manager_.enabled());
+  EXPECT_TRUE(spill_manager_.TryReserve(60));
+  EXPECT_FALSE(spill_manager_.TryReserve(60));
+  EXPECT_EQ(60, spill_manager_.reserved_bytes());
+  EXPECT_TRUE(spill_manager_.TryReserve(40));
+  spill_manager_.Release(100);
+  EXPECT_EQ(0, spill_manager_.reserved_bytes());
+
+  SpillManager disabled(0, "/tmp", nullptr);
+  EXPECT_FALSE(disabled.enabled());
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <queue>
 #include <string>
@@ -430,6 +431,29 @@ class ExecNodeTester {
     return *this;
   }
 
+  /**
+   * Calls fn on the execution node, for nodes that can also send batches outside of ConsumeNext.
+   * @param fn The function to call on the execution node.
+   * @param child_called_times The number of times the mock child's ConsumeNext should be called.
+   * @return the ExecNodeTester, to allow for chaining.
+   */
+  ExecNodeTester& CallOnNode(const std::function<Status(TExecNode*, ExecState*)>& fn,
+                             size_t child_called_times = 1) {
+    auto check_result_batch = [&](ExecState*, const table_store::schema::RowBatch& child_rb,
+                                  int64_t) {
+      current_row_batches_.push(std::make_unique<table_store::schema::RowBatch>(child_rb));
+    };
+
+    EXPECT_CALL(mock_child_, ConsumeNextImpl(::testing::_, ::testing::_, ::testing::_))
+        .Times(child_called_times)
+        .WillRepeatedly(::testing::DoAll(::testing::Invoke(check_result_batch),
+                                         ::testing::Return(Status::OK())));
+    auto s = fn(exec_node_.get(), exec_state_);
+    EXPECT_OK(s) << s.msg();
+
+    return *this;
+  }
+
   /**
    * Checks that the row batch matches the last rowbatch output by ConsumeNext/GenerateNext.
    * @param expected_rb Row batch that should match the last rowbatch output by
@@ -490,6 +514,9 @@ class ExecNodeTester {
     }
     EXPECT_EQ(actual_rb.eow(), expected_rb.eow());
     EXPECT_EQ(actual_rb.eos(), expected_rb.eos());
+    if (expected_rb.watermark().has_value()) {
+      EXPECT_EQ(actual_rb.watermark(), expected_rb.watermark());
+    }
   }
 
   template <px::types::DataType DT>
@@ -0,0 +1,463 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/time_window_agg_node.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/strings/str_cat.h>
+#include <absl/strings/substitute.h>
+#include <magic_enum.hpp>
+
+#include "src/carnot/exec/expression_evaluator.h"
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowBatch;
+
+namespace {
+
+template <types::DataType DT>
+Status AppendKeyToBuilder(arrow::ArrayBuilder* builder, const RowTuple& key, size_t idx) {
+  using ArrowBuilder = typename types::DataTypeTraits<DT>::arrow_builder_type;
+  using ValueType = typename types::DataTypeTraits<DT>::value_type;
+  return static_cast<ArrowBuilder*>(builder)->Append(udf::UnWrap(key.GetValue<ValueType>(idx)));
+}
+
+}  // namespace
+
+std::string TimeWindowAggNode::DebugStringImpl() {
+  return absl::Substitute("Exec::TimeWindowAggNode<$0>", plan_node_->DebugString());
+}
+
+Status TimeWindowAggNode::InitImpl(const plan::Operator& plan_node) {
+  CHECK(plan_node.op_type() == planpb::OperatorType::AGGREGATE_OPERATOR);
+  const auto* agg_plan_node = static_cast<const plan::AggregateOperator*>(&plan_node);
+  plan_node_ = std::make_unique<plan::AggregateOperator>(*agg_plan_node);
+  if (!plan_node_->time_windowed()) {
+    return error::InvalidArgument("TimeWindowAggNode expects a time windowed aggregate");
+  }
+  // Only the aggregate that merges partial aggregates reads several inputs, one per agent.
+  if (input_descriptors_.empty() ||
+      (plan_node_->partial_agg() && input_descriptors_.size() != 1)) {
+    return error::InvalidArgument("Aggregate operator expects a single input relation, got $0",
+                                  input_descriptors_.size());
+  }
+  const auto& input_descriptor = input_descriptors_[0];
+  for (const auto& descriptor : input_descriptors_) {
+    if (!(descriptor == input_descriptor)) {
+      return error::InvalidArgument("Aggregate operator inputs must have the same relation");
+    }
+  }
+  for (const auto& value : plan_node_->values()) {
+    if (value->ExpressionType() != plan::Expression::kAgg) {
+      return error::InvalidArgument("Aggregate operator can only use aggregate expressions");
+    }
+  }
+  size_t values_size = plan_node_->values().size();
+  if (1 + plan_node_->groups().size() + values_size != output_descriptor_->size()) {
+    return error::InvalidArgument("Output size mismatch in aggregate");
+  }
+
+  const auto& window = plan_node_->time_window();
+  time_col_ = window.time_column().index();
+  if (time_col_ >= static_cast<int64_t>(input_descriptor.size()) ||
+      input_descriptor.type(time_col_) != types::TIME64NS) {
+    return error::InvalidArgument("Time window column $0 must be a time column", time_col_);
+  }
+  slide_ns_ = window.slide_ns();
+  // Partial aggregates output their panes, which are windows as long as the slide.
+  window_ns_ = plan_node_->finalize_results() ? window.window_ns() : slide_ns_;
+
+  for (const auto& group : plan_node_->groups()) {
+    DCHECK(group.idx < input_descriptor.size());
+    group_cols_.push_back(group.idx);
+    group_data_types_.push_back(input_descriptor.type(group.idx));
+  }
+  row_key_ = std::make_unique<RowTuple>(&group_data_types_);
+
+  if (!plan_node_->partial_agg()) {
+    // The partial aggregates have their serialized values as the last columns.
+    for (size_t i = 0; i < values_size; ++i) {
+      int64_t col = input_descriptor.size() - values_size + i;
+      if (input_descriptor.type(col) != types::STRING) {
+        return error::InvalidArgument("Expected serialized partial aggregate in column $0", col);
+      }
+      serialized_value_cols_.push_back(col);
+    }
+  }
+  return Status::OK();
+}
+
+Status TimeWindowAggNode::PrepareImpl(ExecState* exec_state) {
+  function_ctx_ = exec_state->CreateFunctionContext();
+  return Status::OK();
+}
+
+Status TimeWindowAggNode::OpenImpl(ExecState* exec_state) {
+  if (!plan_node_->partial_agg()) {
+    PX_RETURN_IF_ERROR(CreateUDAs(exec_state, /*init*/ false, &udas_for_deserialize_));
+  }
+  parent_max_times_.assign(input_descriptors_.size(), std::numeric_limits<int64_t>::min());
+  parent_eos_.assign(input_descriptors_.size(), false);
+  for (size_t i = 0; i < output_descriptor_->size(); ++i) {
+    output_builders_.push_back(
+        types::MakeArrowBuilder(output_descriptor_->type(i), exec_state->exec_mem_pool()));
+  }
+  return Status::OK();
+}
+
+Status TimeWindowAggNode::CloseImpl(ExecState*) {
+  stats()->AddExtraInfo("num_late_rows", absl::StrCat(num_late_rows_));
+  panes_.clear();
+  udas_for_deserialize_.clear();
+  output_builders_.clear();
+  return Status::OK();
+}
+
+Status TimeWindowAggNode::ConsumeNextImpl(ExecState* exec_state, const RowBatch& rb,
+                                          size_t parent_index) {
+  if (rb.num_rows() > 0) {
+    PX_RETURN_IF_ERROR(FindBatchGroups(exec_state, rb, parent_index));
+    if (plan_node_->partial_agg()) {
+      PX_RETURN_IF_ERROR(UpdateBatchGroups(exec_state, rb));
+    } else {
+      PX_RETURN_IF_ERROR(MergeBatchGroups(rb));
+    }
+  }
+  if (rb.watermark().has_value()) {
+    parent_max_times_[parent_index] = std::max(parent_max_times_[parent_index], *rb.watermark());
+  }
+  if (rb.eos()) {
+    parent_eos_[parent_index] = true;
+  }
+  return EmitClosedWindows(exec_state);
+}
+
+int64_t TimeWindowAggNode::PaneStart(int64_t time) const {
+  int64_t pane = time / slide_ns_;
+  if (time % slide_ns_ < 0) {
+    --pane;
+  }
+  return pane * slide_ns_;
+}
+
+Status TimeWindowAggNode::CreateUDAs(ExecState* exec_state, bool init,
+                                     std::vector<UDAInfo>* udas) const {
+  DCHECK(udas->empty());
+  for (const auto& value : plan_node_->values()) {
+    auto def = exec_state->GetUDADefinition(value->uda_id());
+    auto uda = def->Make();
+    // UDAs that partial aggregates are merged into don't need to be initialized, see AggNode.
+    if (init) {
+      std::vector<std::shared_ptr<types::BaseValueType>> init_args;
+      for (const auto& arg : value->init_arguments()) {
+        init_args.push_back(arg.ToBaseValueType());
+      }
+      PX_RETURN_IF_ERROR(def->ExecInit(uda.get(), nullptr, init_args));
+    }
+    udas->emplace_back(std::move(uda), def);
+  }
+  return Status::OK();
+}
+
+Status TimeWindowAggNode::FindBatchGroups(ExecState* exec_state, const RowBatch& rb,
+                                          size_t parent_index) {
+  const auto* times = static_cast<const arrow::Time64Array*>(rb.ColumnAt(time_col_).get());
+  auto extract_key = [&](RowTuple* key, int64_t row) {
+    key->Reset();
+    for (size_t i = 0; i < group_cols_.size(); ++i) {
+      auto* col = rb.ColumnAt(group_cols_[i]).get();
+#define TYPE_CASE(_dt_) ExtractIntoRowTuple<_dt_>(key, col, i, row);
+      PX_SWITCH_FOREACH_DATATYPE(group_data_types_[i], TYPE_CASE);
+#undef TYPE_CASE
+    }
+  };
+
+  int64_t num_rows = rb.num_rows();
+  int64_t& max_time = parent_max_times_[parent_index];
+  batch_groups_.clear();
+  row_batch_groups_.assign(num_rows, -1);
+  // The batch group of each (pane start, group id) with rows in the batch.
+  absl::flat_hash_map<std::pair<int64_t, uint32_t>, int32_t> batch_group_idx;
+  Pane* pane = nullptr;
+  int64_t pane_start = 0;
+  for (int64_t row = 0; row < num_rows; ++row) {
+    int64_t time = times->Value(row);
+    int64_t row_pane_start = PaneStart(time);
+    if (row_pane_start < next_window_start_) {
+      ++num_late_rows_;
+      continue;
+    }
+    max_time = std::max(max_time, time);
+    // The input is ordered by time, so consecutive rows usually share their pane.
+    if (pane == nullptr || row_pane_start != pane_start) {
+      pane_start = row_pane_start;
+      pane = &panes_[pane_start];
+    }
+
+    extract_key(row_key_.get(), row);
+    uint32_t group_id;
+    auto it = pane->group_ids.find(row_key_.get());
+    if (it != pane->group_ids.end()) {
+      group_id = it->second;
+    } else {
+      auto key = std::make_unique<RowTuple>(&group_data_types_);
+      extract_key(key.get(), row);
+      group_id = pane->keys.size();
+      pane->group_ids.emplace(key.get(), group_id);
+      pane->keys.push_back(std::move(key));
+      pane->udas.emplace_back();
+      PX_RETURN_IF_ERROR(CreateUDAs(exec_state, plan_node_->partial_agg(), &pane->udas.back()));
+    }
+
+    auto [bg_it, inserted] =
+        batch_group_idx.try_emplace(std::make_pair(pane_start, group_id), batch_groups_.size());
+    if (inserted) {
+      batch_groups_.push_back(BatchGroup{pane, group_id, 0, 0});
+    }
+    row_batch_groups_[row] = bg_it->second;
+    ++batch_groups_[bg_it->second].count;
+  }
+
+  // Lay the rows of each batch group out next to each other.
+  uint32_t offset = 0;
+  for (auto& batch_group : batch_groups_) {
+    batch_group.offset = offset;
+    offset += batch_group.count;
+    batch_group.count = 0;
+  }
+  batch_selection_.resize(offset);
+  for (int64_t row = 0; row < num_rows; ++row) {
+    if (row_batch_groups_[row] < 0) {
+      continue;
+    }
+    auto& batch_group = batch_groups_[row_batch_groups_[row]];
+    batch_selection_[batch_group.offset + batch_group.count++] = row;
+  }
+  return Status::OK();
+}
+
+Status TimeWindowAggNode::UpdateBatchGroups(ExecState* exec_state, const RowBatch& rb) {
+  const auto& values = plan_node_->values();
+  // The arguments of each value, evaluated once for the whole batch.
+  std::vector<std::shared_ptr<arrow::Array>> arg_arrays;
+  std::vector<std::vector<const arrow::Array*>> value_args(values.size());
+  for (const auto& [i, value] : Enumerate(values)) {
+    for (const auto& arg : value->arg_deps()) {
+      switch (arg->ExpressionType()) {
+        case plan::Expression::kColumn:
+          arg_arrays.push_back(rb.ColumnAt(static_cast<const plan::Column*>(arg.get())->Index()));
+          break;
+        case plan::Expression::kConstant:
+          arg_arrays.push_back(EvalScalarToArrow(
+              exec_state, *static_cast<const plan::ScalarValue*>(arg.get()), rb.num_rows()));
+          break;
+        default:
+          return error::InvalidArgument("Invalid expression type in agg: $0",
+                                        magic_enum::enum_name(arg->ExpressionType()));
+      }
+      value_args[i].push_back(arg_arrays.back().get());
+    }
+  }
+
+  for (const auto& batch_group : batch_groups_) {
+    auto& udas = batch_group.pane->udas[batch_group.group_id];
+    for (size_t i = 0; i < udas.size(); ++i) {
+      PX_RETURN_IF_ERROR(udas[i].def->ExecBatchUpdateArrowSelected(
+          udas[i].uda.get(), nullptr /* ctx */, value_args[i],
+          batch_selection_.data() + batch_group.offset, batch_group.count));
+    }
+  }
+  return Status::OK();
+}
+
+Status TimeWindowAggNode::MergeBatchGroups(const RowBatch& rb) {
+  for (const auto& batch_group : batch_groups_) {
+    auto& udas = batch_group.pane->udas[batch_group.group_id];
+    for (uint32_t i = 0; i < batch_group.count; ++i) {
+      uint32_t row = batch_selection_[batch_group.offset + i];
+      for (size_t uda_idx = 0; uda_idx < udas.size(); ++uda_idx) {
+        auto& deserialize_uda = udas_for_deserialize_[uda_idx];
+        auto serialized = types::GetValueFromArrowArray<types::STRING>(
+            rb.ColumnAt(serialized_value_cols_[uda_idx]).get(), row);
+        PX_RETURN_IF_ERROR(deserialize_uda.def->Deserialize(deserialize_uda.uda.get(),
+                                                            function_ctx_.get(), serialized));
+        PX_RETURN_IF_ERROR(udas[uda_idx].def->Merge(
+            udas[uda_idx].uda.get(), deserialize_uda.uda.get(), function_ctx_.get()));
+      }
+    }
+  }
+  return Status::OK();
+}
+
+std::optional<int64_t> TimeWindowAggNode::InputTime() const {
+  std::optional<int64_t> input_time;
+  for (size_t i = 0; i < parent_max_times_.size(); ++i) {
+    if (!parent_eos_[i]) {
+      input_time = std::min(input_time.value_or(parent_max_times_[i]), parent_max_times_[i]);
+    }
+  }
+  return input_time;
+}
+
+Status TimeWindowAggNode::EmitClosedWindows(ExecState* exec_state) {
+  std::optional<int64_t> input_time = InputTime();
+  bool eos = !input_time.has_value();
+  while (!panes_.empty()) {
+    // Skip the windows that don't cover any of the panes.
+    next_window_start_ =
+        std::max(next_window_start_, panes_.begin()->first - window_ns_ + slide_ns_);
+    // A window is closed once the input is past its end, or at the end of the stream.
+    if (!eos && next_window_start_ + window_ns_ > *input_time) {
+      break;
+    }
+    PX_RETURN_IF_ERROR(AppendWindow(exec_state, next_window_start_));
+    next_window_start_ += slide_ns_;
+    // The later windows don't cover the panes before their start.
+    panes_.erase(panes_.begin(), panes_.lower_bound(next_window_start_));
+  }
+
+  bool forward_watermark = !plan_node_->finalize_results() && !eos;
+  if (forward_watermark && *input_time != std::numeric_limits<int64_t>::min()) {
+    // The panes before the one of the input time are closed, even those without rows.
+    next_window_start_ = std::max(next_window_start_, PaneStart(*input_time));
+  }
+  // Only the panes from next_window_start_ on are output later, which lets the merging aggregate
+  // close its windows without waiting for this one to have rows in a later pane.
+  forward_watermark = forward_watermark && next_window_start_ > sent_watermark_;
+
+  if (output_rows_ == 0 && !eos) {
+    if (!forward_watermark) {
+      return Status::OK();
+    }
+    PX_ASSIGN_OR_RETURN(auto watermark_rb,
+                        RowBatch::WithZeroRows(*output_descriptor_, /*eow*/ false, /*eos*/ false));
+    watermark_rb->set_watermark(next_window_start_);
+    sent_watermark_ = next_window_start_;
+    return SendRowBatchToChildren(exec_state, *watermark_rb);
+  }
+  PX_ASSIGN_OR_RETURN(auto output_rb, FinishOutput());
+  // Each output batch ends with a complete window.
+  output_rb->set_eow(true);
+  output_rb->set_eos(eos);
+  if (forward_watermark) {
+    output_rb->set_watermark(next_window_start_);
+    sent_watermark_ = next_window_start_;
+  }
+  return SendRowBatchToChildren(exec_state, *output_rb);
+}
+
+Status TimeWindowAggNode::AppendWindow(ExecState* exec_state, int64_t window_start) {
+  auto begin = panes_.lower_bound(window_start);
+  auto end = panes_.lower_bound(window_start + window_ns_);
+  if (begin == end) {
+    return Status::OK();
+  }
+
+  std::vector<const RowTuple*> keys;
+  std::vector<std::vector<UDAInfo>*> udas;
+  // A pane that only belongs to this window is output as is, otherwise the panes are merged into
+  // new UDAs, since the later windows still need them.
+  if (window_ns_ == slide_ns_) {
+    DCHECK(std::next(begin) == end);
+    auto& pane = begin->second;
+    for (size_t i = 0; i < pane.keys.size(); ++i) {
+      keys.push_back(pane.keys[i].get());
+      udas.push_back(&pane.udas[i]);
+    }
+    return AppendGroups(window_start, keys, udas);
+  }
+
+  AbslRowTupleHashMap<uint32_t> window_group_ids;
+  std::vector<std::vector<UDAInfo>> window_udas;
+  for (auto it = begin; it != end; ++it) {
+    auto& pane = it->second;
+    for (size_t i = 0; i < pane.keys.size(); ++i) {
+      auto [group_it, inserted] = window_group_ids.try_emplace(pane.keys[i].get(), keys.size());
+      if (inserted) {
+        keys.push_back(pane.keys[i].get());
+        window_udas.emplace_back();
+        PX_RETURN_IF_ERROR(CreateUDAs(exec_state, /*init*/ false, &window_udas.back()));
+      }
+      auto& dst = window_udas[group_it->second];
+      for (size_t uda_idx = 0; uda_idx < dst.size(); ++uda_idx) {
+        PX_RETURN_IF_ERROR(dst[uda_idx].def->Merge(
+            dst[uda_idx].uda.get(), pane.udas[i][uda_idx].uda.get(), function_ctx_.get()));
+      }
+    }
+  }
+  for (auto& window_uda : window_udas) {
+    udas.push_back(&window_uda);
+  }
+  return AppendGroups(window_start, keys, udas);
+}
+
+Status TimeWindowAggNode::AppendGroups(int64_t window_start,
+                                       const std::vector<const RowTuple*>& keys,
+                                       const std::vector<std::vector<UDAInfo>*>& udas) {
+  auto* window_start_builder = static_cast<arrow::Time64Builder*>(output_builders_[0].get());
+  size_t groups_size = group_data_types_.size();
+  for (size_t group = 0; group < keys.size(); ++group) {
+    PX_RETURN_IF_ERROR(window_start_builder->Append(window_start));
+    for (size_t i = 0; i < groups_size; ++i) {
+      auto* builder = output_builders_[1 + i].get();
+#define TYPE_CASE(_dt_) PX_RETURN_IF_ERROR(AppendKeyToBuilder<_dt_>(builder, *keys[group], i));
+      PX_SWITCH_FOREACH_DATATYPE(group_data_types_[i], TYPE_CASE);
+#undef TYPE_CASE
+    }
+    for (size_t i = 0; i < udas[group]->size(); ++i) {
+      const auto& uda_info = (*udas[group])[i];
+      auto* builder = output_builders_[1 + groups_size + i].get();
+      if (plan_node_->finalize_results()) {
+        PX_RETURN_IF_ERROR(
+            uda_info.def->FinalizeArrow(uda_info.uda.get(), function_ctx_.get(), builder));
+      } else {
+        PX_RETURN_IF_ERROR(
+            uda_info.def->SerializeArrow(uda_info.uda.get(), function_ctx_.get(), builder));
+      }
+    }
+  }
+  output_rows_ += keys.size();
+  return Status::OK();
+}
+
+StatusOr<std::unique_ptr<RowBatch>> TimeWindowAggNode::FinishOutput() {
+  auto output_rb = std::make_unique<RowBatch>(*output_descriptor_, output_rows_);
+  // Finish also resets the builders for the next batch.
+  for (const auto& builder : output_builders_) {
+    std::shared_ptr<arrow::Array> arr;
+    PX_RETURN_IF_ERROR(builder->Finish(&arr));
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(arr));
+  }
+  output_rows_ = 0;
+  return output_rb;
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/carnot/exec/agg_node.h"
+#include "src/carnot/exec/exec_node.h"
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/row_tuple.h"
+#include "src/carnot/plan/operators.h"
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/schema/row_batch.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+/**
+ * TimeWindowAggNode aggregates the rows of a streaming input per sliding (or tumbling) window of
+ * its time column, and outputs each window as soon as the input has moved past its end.
+ *
+ * The rows are aggregated into panes as long as the slide of the windows. A window is the merge of
+ * the panes it covers, so each row only updates a single pane, and a pane is dropped once the
+ * last window that covers it is output. The input is expected to be ordered by time: rows that
+ * arrive after their pane was closed are dropped.
+ *
+ * A partial aggregate outputs the serialized groups of each pane when it closes, with the pane
+ * start as the time column, and the aggregate that merges them builds the windows. The merging
+ * aggregate can read the partial aggregates of several agents as separate inputs: each input is
+ * ordered by time, but they are not ordered with each other, so the input time that closes the
+ * windows is the earliest of the latest times of the inputs that are still open. Partial
+ * aggregates also send the start of the next pane they can output as the watermark of their
+ * batches, even when no pane closed, so that an agent without rows in the latest panes doesn't
+ * hold back the windows of the others.
+ */
+class TimeWindowAggNode : public ProcessingNode {
+ public:
+  TimeWindowAggNode() = default;
+  virtual ~TimeWindowAggNode() = default;
+
+  // The number of rows that were dropped because their pane was already closed.
+  int64_t num_late_rows() const { return num_late_rows_; }
+
+ protected:
+  std::string DebugStringImpl() override;
+  Status InitImpl(const plan::Operator& plan_node) override;
+  Status PrepareImpl(ExecState* exec_state) override;
+  Status OpenImpl(ExecState* exec_state) override;
+  Status CloseImpl(ExecState* exec_state) override;
+  Status ConsumeNextImpl(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                         size_t parent_index) override;
+
+ private:
+  // The groups of the rows of a pane.
+  struct Pane {
+    // The group keys, indexed by group id.
+    std::vector<std::unique_ptr<RowTuple>> keys;
+    AbslRowTupleHashMap<uint32_t> group_ids;
+    // The UDAs of each group, indexed by group id.
+    std::vector<std::vector<UDAInfo>> udas;
+  };
+  // A group of a pane that has rows in the current batch.
+  struct BatchGroup {
+    Pane* pane;
+    uint32_t group_id;
+    // The rows of the group, in batch_selection_.
+    uint32_t offset;
+    uint32_t count;
+  };
+
+  int64_t PaneStart(int64_t time) const;
+  Status CreateUDAs(ExecState* exec_state, bool init, std::vector<UDAInfo>* udas) const;
+  // Finds the pane group of every row of the batch, creating the missing ones, and groups the
+  // rows by pane group in batch_selection_.
+  Status FindBatchGroups(ExecState* exec_state, const table_store::schema::RowBatch& rb,
+                         size_t parent_index);
+  Status UpdateBatchGroups(ExecState* exec_state, const table_store::schema::RowBatch& rb);
+  Status MergeBatchGroups(const table_store::schema::RowBatch& rb);
+  // The input time up to which all the inputs have been received, or nullopt when all the inputs
+  // have ended.
+  std::optional<int64_t> InputTime() const;
+  // Outputs the windows (or panes, for partial aggregates) that end before the input time.
+  Status EmitClosedWindows(ExecState* exec_state);
+  // Appends the groups of the window starting at window_start to the output, merged across its
+  // panes.
+  Status AppendWindow(ExecState* exec_state, int64_t window_start);
+  Status AppendGroups(int64_t window_start, const std::vector<const RowTuple*>& keys,
+                      const std::vector<std::vector<UDAInfo>*>& udas);
+  StatusOr<std::unique_ptr<table_store::schema::RowBatch>> FinishOutput();
+
+  std::unique_ptr<plan::AggregateOperator> plan_node_;
+  std::unique_ptr<udf::FunctionContext> function_ctx_;
+
+  int64_t time_col_ = 0;
+  int64_t window_ns_ = 0;
+  int64_t slide_ns_ = 0;
+  std::vector<int64_t> group_cols_;
+  std::vector<types::DataType> group_data_types_;
+  // The input columns of the serialized values, when merging partial aggregates.
+  std::vector<int64_t> serialized_value_cols_;
+
+  // The open panes, by start time.
+  std::map<int64_t, Pane> panes_;
+  // The largest time of each input so far.
+  std::vector<int64_t> parent_max_times_;
+  std::vector<bool> parent_eos_;
+  // The start of the next window to output. Rows of earlier panes are late.
+  int64_t next_window_start_ = std::numeric_limits<int64_t>::min();
+  // The last watermark that a partial aggregate sent, see RowBatch::watermark().
+  int64_t sent_watermark_ = std::numeric_limits<int64_t>::min();
+  int64_t num_late_rows_ = 0;
+
+  // The key of the current row, which is only copied when it starts a new group.
+  std::unique_ptr<RowTuple> row_key_;
+  std::vector<BatchGroup> batch_groups_;
+  // The batch group of each row of the batch, -1 for late rows.
+  std::vector<int32_t> row_batch_groups_;
+  std::vector<uint32_t> batch_selection_;
+  std::vector<UDAInfo> udas_for_deserialize_;
+
+  // The builders of the next output batch.
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> output_builders_;
+  int64_t output_rows_ = 0;
+};
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,355 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/exec/time_window_agg_node.h"
+
+#include <memory>
+#include <string>
+
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_cat.h>
+#include <absl/strings/substitute.h>
+#include <google/protobuf/text_format.h>
+#include <gtest/gtest.h>
+
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/plan/operators.h"
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/testing/testing.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+using table_store::schema::RowDescriptor;
+using types::Int64Value;
+using types::StringValue;
+using types::Time64NSValue;
+
+class SumUDA : public udf::UDA {
+ public:
+  void Update(udf::FunctionContext*, types::Int64Value arg) { sum_ += arg.val; }
+  void Merge(udf::FunctionContext*, const SumUDA& other) { sum_ += other.sum_; }
+  types::Int64Value Finalize(udf::FunctionContext*) { return sum_; }
+  StringValue Serialize(udf::FunctionContext*) { return absl::StrCat(sum_); }
+  Status Deserialize(udf::FunctionContext*, const types::StringValue& serialized) {
+    PX_UNUSED(absl::SimpleAtoi(serialized, &sum_));
+    return Status::OK();
+  }
+
+ protected:
+  int64_t sum_ = 0;
+};
+
+// Sums column $0 per window of column 0, grouped by the columns in $1.
+constexpr char kTimeWindowAggTmpl[] = R"(
+op_type: AGGREGATE_OPERATOR
+agg_op {
+  values {
+    name: "sum"
+    args {
+      column {
+        node: 0
+        index: $0
+      }
+    }
+  }
+  value_names: "sum"
+  $1
+  partial_agg: $2
+  finalize_results: $3
+  time_window {
+    time_column {
+      node: 0
+      index: 0
+    }
+    window_ns: $4
+    slide_ns: $5
+    window_start_name: "window_start"
+  }
+})";
+
+constexpr char kStringGroup[] = R"(
+  groups {
+    node: 0
+    index: 1
+  }
+  group_names: "service")";
+
+std::unique_ptr<plan::Operator> TimeWindowAggFromPbtxt(int64_t value_col, const std::string& groups,
+                                                       bool partial_agg, bool finalize_results,
+                                                       int64_t window_ns, int64_t slide_ns) {
+  planpb::Operator op_pb;
+  EXPECT_TRUE(google::protobuf::TextFormat::MergeFromString(
+      absl::Substitute(kTimeWindowAggTmpl, value_col, groups, partial_agg, finalize_results,
+                       window_ns, slide_ns),
+      &op_pb));
+  return plan::AggregateOperator::FromProto(op_pb, 1);
+}
+
+class TimeWindowAggNodeTest : public ::testing::Test {
+ public:
+  TimeWindowAggNodeTest() {
+    func_registry_ = std::make_unique<udf::Registry>("test");
+    EXPECT_OK(func_registry_->Register<SumUDA>("sum"));
+    exec_state_ = MakeTestExecState(func_registry_.get());
+    EXPECT_OK(exec_state_->AddUDA(0, "sum", {types::INT64}));
+  }
+
+ protected:
+  std::unique_ptr<ExecState> exec_state_;
+  std::unique_ptr<udf::Registry> func_registry_;
+};
+
+TEST_F(TimeWindowAggNodeTest, tumbling_windows) {
+  auto plan_node = TimeWindowAggFromPbtxt(2, kStringGroup, true, true, 10, 10);
+  RowDescriptor input_rd({types::TIME64NS, types::STRING, types::INT64});
+  RowDescriptor output_rd({types::TIME64NS, types::STRING, types::INT64});
+
+  auto tester = exec::ExecNodeTester<TimeWindowAggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Time64NSValue>({1, 2, 11, 12})
+                       .AddColumn<StringValue>({"a", "b", "a", "a"})
+                       .AddColumn<Int64Value>({1, 2, 3, 4})
+                       .get(),
+                   0)
+      // The first window is output as soon as a row of the next one arrives.
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ false)
+                          .AddColumn<Time64NSValue>({0, 0})
+                          .AddColumn<StringValue>({"a", "b"})
+                          .AddColumn<Int64Value>({1, 2})
+                          .get())
+      // The row at time 5 is late, its window was already output.
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Time64NSValue>({5, 25})
+                       .AddColumn<StringValue>({"a", "b"})
+                       .AddColumn<Int64Value>({100, 7})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Time64NSValue>({10, 20})
+                          .AddColumn<StringValue>({"a", "b"})
+                          .AddColumn<Int64Value>({7, 7})
+                          .get())
+      .Close();
+}
+
+TEST_F(TimeWindowAggNodeTest, sliding_windows) {
+  auto plan_node = TimeWindowAggFromPbtxt(1, "", true, true, 20, 10);
+  RowDescriptor input_rd({types::TIME64NS, types::INT64});
+  RowDescriptor output_rd({types::TIME64NS, types::INT64});
+
+  auto tester = exec::ExecNodeTester<TimeWindowAggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Time64NSValue>({1, 11, 21, 35})
+                       .AddColumn<Int64Value>({1, 2, 3, 4})
+                       .get(),
+                   0)
+      // Every window that ends before time 35 is output, each one merges two panes.
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 3, /*eow*/ true, /*eos*/ false)
+                          .AddColumn<Time64NSValue>({-10, 0, 10})
+                          .AddColumn<Int64Value>({1, 3, 5})
+                          .get())
+      .ConsumeNext(RowBatchBuilder(input_rd, 0, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Time64NSValue>({})
+                       .AddColumn<Int64Value>({})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Time64NSValue>({20, 30})
+                          .AddColumn<Int64Value>({7, 4})
+                          .get())
+      .Close();
+}
+
+TEST_F(TimeWindowAggNodeTest, partial_panes) {
+  // The partial aggregate of 20ns windows outputs its 10ns panes.
+  auto plan_node = TimeWindowAggFromPbtxt(1, "", true, false, 20, 10);
+  RowDescriptor input_rd({types::TIME64NS, types::INT64});
+  RowDescriptor output_rd({types::TIME64NS, types::STRING});
+
+  auto tester = exec::ExecNodeTester<TimeWindowAggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 3, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Time64NSValue>({1, 5, 11})
+                       .AddColumn<Int64Value>({1, 2, 3})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Time64NSValue>({0, 10})
+                          .AddColumn<StringValue>({"3", "3"})
+                          .get())
+      .Close();
+}
+
+TEST_F(TimeWindowAggNodeTest, merge_partial_panes) {
+  auto plan_node = TimeWindowAggFromPbtxt(1, "", false, true, 20, 10);
+  RowDescriptor input_rd({types::TIME64NS, types::STRING});
+  RowDescriptor output_rd({types::TIME64NS, types::INT64});
+
+  auto tester = exec::ExecNodeTester<TimeWindowAggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  tester
+      // Panes from two agents.
+      .ConsumeNext(RowBatchBuilder(input_rd, 4, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Time64NSValue>({0, 0, 10, 20})
+                       .AddColumn<StringValue>({"1", "2", "4", "8"})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ false)
+                          .AddColumn<Time64NSValue>({-10, 0})
+                          .AddColumn<Int64Value>({3, 7})
+                          .get())
+      .ConsumeNext(RowBatchBuilder(input_rd, 0, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Time64NSValue>({})
+                       .AddColumn<StringValue>({})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 2, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Time64NSValue>({10, 20})
+                          .AddColumn<Int64Value>({12, 8})
+                          .get())
+      .Close();
+}
+
+TEST_F(TimeWindowAggNodeTest, merge_panes_from_multiple_agents) {
+  auto plan_node = TimeWindowAggFromPbtxt(1, "", false, true, 10, 10);
+  RowDescriptor input_rd({types::TIME64NS, types::STRING});
+  RowDescriptor output_rd({types::TIME64NS, types::INT64});
+
+  auto tester = exec::ExecNodeTester<TimeWindowAggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd, input_rd}, exec_state_.get());
+  tester
+      // Nothing is output until the other agent has sent its panes.
+      .ConsumeNext(RowBatchBuilder(input_rd, 3, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Time64NSValue>({0, 10, 20})
+                       .AddColumn<StringValue>({"1", "2", "4"})
+                       .get(),
+                   0, 0)
+      // The panes of the second agent are behind the first one, but aren't late.
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Time64NSValue>({0, 10})
+                       .AddColumn<StringValue>({"8", "16"})
+                       .get(),
+                   1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, /*eow*/ true, /*eos*/ false)
+                          .AddColumn<Time64NSValue>({0})
+                          .AddColumn<Int64Value>({9})
+                          .get())
+      // Once the second agent ends, the windows only wait for the first one.
+      .ConsumeNext(RowBatchBuilder(input_rd, 0, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Time64NSValue>({})
+                       .AddColumn<StringValue>({})
+                       .get(),
+                   1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, /*eow*/ true, /*eos*/ false)
+                          .AddColumn<Time64NSValue>({10})
+                          .AddColumn<Int64Value>({18})
+                          .get())
+      .ConsumeNext(RowBatchBuilder(input_rd, 0, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Time64NSValue>({})
+                       .AddColumn<StringValue>({})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Time64NSValue>({20})
+                          .AddColumn<Int64Value>({4})
+                          .get())
+      .Close();
+}
+
+TEST_F(TimeWindowAggNodeTest, partial_forwards_watermark) {
+  auto plan_node = TimeWindowAggFromPbtxt(1, "", true, false, 10, 10);
+  RowDescriptor input_rd({types::TIME64NS, types::INT64});
+  RowDescriptor output_rd({types::TIME64NS, types::STRING});
+
+  RowBatchBuilder watermark_0(output_rd, 0, /*eow*/ false, /*eos*/ false);
+  watermark_0.AddColumn<Time64NSValue>({}).AddColumn<StringValue>({}).get().set_watermark(0);
+  RowBatchBuilder pane_0(output_rd, 1, /*eow*/ true, /*eos*/ false);
+  pane_0.AddColumn<Time64NSValue>({0}).AddColumn<StringValue>({"6"}).get().set_watermark(10);
+
+  auto tester = exec::ExecNodeTester<TimeWindowAggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd}, exec_state_.get());
+  tester
+      // No pane is closed yet, but the later panes start at 0 or after.
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Time64NSValue>({1, 5})
+                       .AddColumn<Int64Value>({1, 2})
+                       .get(),
+                   0)
+      .ExpectRowBatch(watermark_0.get())
+      // The watermark didn't move, so there is nothing to send.
+      .ConsumeNext(RowBatchBuilder(input_rd, 1, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Time64NSValue>({7})
+                       .AddColumn<Int64Value>({3})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(input_rd, 1, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Time64NSValue>({12})
+                       .AddColumn<Int64Value>({4})
+                       .get(),
+                   0)
+      .ExpectRowBatch(pane_0.get())
+      .ConsumeNext(RowBatchBuilder(input_rd, 0, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<Time64NSValue>({})
+                       .AddColumn<Int64Value>({})
+                       .get(),
+                   0)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, /*eow*/ true, /*eos*/ true)
+                          .AddColumn<Time64NSValue>({10})
+                          .AddColumn<StringValue>({"4"})
+                          .get())
+      .Close();
+  EXPECT_EQ(0, tester.node()->num_late_rows());
+}
+
+TEST_F(TimeWindowAggNodeTest, merge_advances_on_watermark) {
+  auto plan_node = TimeWindowAggFromPbtxt(1, "", false, true, 10, 10);
+  RowDescriptor input_rd({types::TIME64NS, types::STRING});
+  RowDescriptor output_rd({types::TIME64NS, types::INT64});
+
+  // The second agent has no rows, but its partial aggregate is past the first pane.
+  RowBatchBuilder watermark_10(input_rd, 0, /*eow*/ false, /*eos*/ false);
+  watermark_10.AddColumn<Time64NSValue>({}).AddColumn<StringValue>({}).get().set_watermark(10);
+
+  auto tester = exec::ExecNodeTester<TimeWindowAggNode, plan::AggregateOperator>(
+      *plan_node, output_rd, {input_rd, input_rd}, exec_state_.get());
+  tester
+      .ConsumeNext(RowBatchBuilder(input_rd, 2, /*eow*/ false, /*eos*/ false)
+                       .AddColumn<Time64NSValue>({0, 10})
+                       .AddColumn<StringValue>({"1", "2"})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(watermark_10.get(), 1)
+      .ExpectRowBatch(RowBatchBuilder(output_rd, 1, /*eow*/ true, /*eos*/ false)
+                          .AddColumn<Time64NSValue>({0})
+                          .AddColumn<Int64Value>({1})
+                          .get())
+      .Close();
+}
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
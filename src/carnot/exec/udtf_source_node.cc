@@ -104,7 +104,7 @@ Status UDTFSourceNode::GenerateNextImpl(ExecState* exec_state) {
   std::vector<std::unique_ptr<arrow::ArrayBuilder>> outputs;
 
   for (const auto& r : udtf_def_->output_relation()) {
-    outputs.emplace_back(types::MakeArrowBuilder(r.type(), arrow::default_memory_pool()));
+    outputs.emplace_back(types::MakeArrowBuilder(r.type(), exec_state->exec_mem_pool()));
   }
 
   // TODO(zasgar): Change Exec to take in unique_ptrs.
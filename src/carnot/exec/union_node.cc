@@ -18,11 +18,13 @@
 
 #include "src/carnot/exec/union_node.h"
 
+#include <arrow/array/concatenate.h>
 #include <arrow/memory_pool.h>
 #include <arrow/status.h>
 #include <algorithm>
 #include <cstddef>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <absl/strings/str_join.h>
@@ -56,15 +58,6 @@ Status UnionNode::InitImpl(const plan::Operator& plan_node) {
   return Status::OK();
 }
 
-Status UnionNode::InitializeColumnBuilders() {
-  for (size_t i = 0; i < output_descriptor_->size(); ++i) {
-    column_builders_[i] =
-        MakeArrowBuilder(output_descriptor_->type(i), arrow::default_memory_pool());
-    PX_RETURN_IF_ERROR(column_builders_[i]->Reserve(output_rows_per_batch_));
-  }
-  return Status::OK();
-}
-
 Status UnionNode::PrepareImpl(ExecState*) {
   size_t num_output_cols = output_descriptor_->size();
 
@@ -75,10 +68,9 @@ Status UnionNode::PrepareImpl(ExecState*) {
     parent_row_batches_.resize(num_parents_);
     row_cursors_.resize(num_parents_);
     time_columns_.resize(num_parents_);
-    data_columns_.resize(num_parents_, std::vector<arrow::Array*>(num_output_cols));
-
-    column_builders_.resize(num_output_cols);
-    PX_RETURN_IF_ERROR(InitializeColumnBuilders());
+    data_columns_.resize(num_parents_,
+                         std::vector<std::shared_ptr<arrow::Array>>(num_output_cols));
+    output_slices_.resize(num_output_cols);
   }
 
   return Status::OK();
@@ -111,17 +103,85 @@ types::Time64NSValue UnionNode::GetTimeAtParentCursor(size_t parent_index) const
                                                         row_cursors_[parent_index]);
 }
 
-Status UnionNode::AppendRow(size_t parent) {
-  auto row = row_cursors_[parent];
+bool UnionNode::ParentBefore(size_t parent_a, size_t parent_b) const {
+  bool done_a = flushed_parent_eoses_[parent_a];
+  bool done_b = flushed_parent_eoses_[parent_b];
+  if (done_a || done_b) {
+    return done_a == done_b ? parent_a < parent_b : done_b;
+  }
+  auto time_a = GetTimeAtParentCursor(parent_a);
+  auto time_b = GetTimeAtParentCursor(parent_b);
+  return time_a < time_b || (time_a == time_b && parent_a < parent_b);
+}
+
+void UnionNode::BuildLoserTree() {
+  // The winner of the match played at each node. The leaves are the last num_parents_ nodes.
+  std::vector<size_t> winners(2 * num_parents_);
+  for (size_t parent = 0; parent < num_parents_; ++parent) {
+    winners[num_parents_ + parent] = parent;
+  }
+  loser_tree_.resize(num_parents_);
+  for (size_t node = num_parents_ - 1; node > 0; --node) {
+    size_t left = winners[2 * node];
+    size_t right = winners[2 * node + 1];
+    bool left_wins = ParentBefore(left, right);
+    winners[node] = left_wins ? left : right;
+    loser_tree_[node] = left_wins ? right : left;
+  }
+  loser_tree_[0] = num_parents_ > 1 ? winners[1] : 0;
+}
+
+void UnionNode::ReplayLoserTree(size_t parent) {
+  size_t winner = parent;
+  for (size_t node = (num_parents_ + parent) / 2; node > 0; node /= 2) {
+    if (ParentBefore(loser_tree_[node], winner)) {
+      std::swap(loser_tree_[node], winner);
+    }
+  }
+  loser_tree_[0] = winner;
+}
+
+size_t UnionNode::LoserTreeRunnerUp() const {
+  // The runner-up only lost to the winner, so it's one of the losers on the path of the winner.
+  size_t winner = loser_tree_[0];
+  size_t runner_up = winner;
+  for (size_t node = (num_parents_ + winner) / 2; node > 0; node /= 2) {
+    if (runner_up == winner || ParentBefore(loser_tree_[node], runner_up)) {
+      runner_up = loser_tree_[node];
+    }
+  }
+  return runner_up;
+}
+
+size_t UnionNode::RunEnd(size_t parent, size_t runner_up) const {
+  size_t num_rows = parent_row_batches_[parent][0].num_rows();
+  if (runner_up == parent || flushed_parent_eoses_[runner_up]) {
+    return num_rows;
+  }
+  // The rows of the batch are ordered by time, so the run ends at the first row that sorts after
+  // the runner-up.
+  auto runner_up_time = GetTimeAtParentCursor(runner_up);
+  bool ties_first = parent < runner_up;
+  const arrow::Array* time_col = time_columns_[parent];
+  size_t lo = row_cursors_[parent];
+  size_t hi = num_rows;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    auto time = types::GetValueFromArrowArray<types::TIME64NS>(time_col, mid);
+    if (time < runner_up_time || (ties_first && time == runner_up_time)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+void UnionNode::AppendRun(size_t parent, size_t begin, size_t end) {
   for (size_t i = 0; i < output_descriptor_->size(); ++i) {
-    auto input_col = data_columns_[parent][i];
-#define TYPE_CASE(_dt_)                                    \
-  PX_RETURN_IF_ERROR(table_store::schema::CopyValue<_dt_>( \
-      column_builders_[i].get(), types::GetValueFromArrowArray<_dt_>(input_col, row)));
-    PX_SWITCH_FOREACH_DATATYPE(output_descriptor_->type(i), TYPE_CASE);
-#undef TYPE_CASE
+    output_slices_[i].push_back(data_columns_[parent][i]->Slice(begin, end - begin));
   }
-  return Status::OK();
+  output_rows_ += end - begin;
 }
 
 // Flush the row batch if we have waited too long between row batches.
@@ -139,8 +199,7 @@ Status UnionNode::OptionallyFlushRowBatchIfTimeout(ExecState* exec_state) {
     return Status::OK();
   }
 
-  DCHECK_GT(column_builders_.size(), 0U);
-  if (column_builders_[0]->length()) {
+  if (output_rows_) {
     return FlushBatch(exec_state);
   }
   return Status::OK();
@@ -149,9 +208,7 @@ Status UnionNode::OptionallyFlushRowBatchIfTimeout(ExecState* exec_state) {
 // Flush the row batch if we have reached a certain number of records.
 Status UnionNode::OptionallyFlushRowBatchIfMaxRowsOrEOS(ExecState* exec_state) {
   bool eos = InputsComplete();
-  int64_t output_rows = column_builders_[0]->length();
-
-  if (output_rows < static_cast<int64_t>(output_rows_per_batch_) && !eos) {
+  if (output_rows_ < output_rows_per_batch_ && !eos) {
     return Status::OK();
   }
 
@@ -162,78 +219,73 @@ Status UnionNode::FlushBatch(ExecState* exec_state) {
   DCHECK(!sent_eos_);
 
   bool eos = InputsComplete();
-  PX_ASSIGN_OR_RETURN(auto rb, RowBatch::FromColumnBuilders(*output_descriptor_, /*eow*/ eos,
-                                                            /*eos*/ eos, &column_builders_));
-  PX_RETURN_IF_ERROR(InitializeColumnBuilders());
+  RowBatch rb(*output_descriptor_, output_rows_);
+  rb.set_eow(eos);
+  rb.set_eos(eos);
+  for (size_t i = 0; i < output_descriptor_->size(); ++i) {
+    auto& slices = output_slices_[i];
+    std::shared_ptr<arrow::Array> column;
+    if (slices.size() == 1) {
+      // A batch from a single run doesn't need to be copied at all.
+      column = slices[0];
+    } else if (slices.empty()) {
+      auto builder = types::MakeArrowBuilder(output_descriptor_->type(i),
+                                             exec_state->exec_mem_pool());
+      PX_RETURN_IF_ERROR(builder->Finish(&column));
+    } else {
+      PX_RETURN_IF_ERROR(arrow::Concatenate(slices, exec_state->exec_mem_pool(), &column));
+    }
+    PX_RETURN_IF_ERROR(rb.AddColumn(column));
+    slices.clear();
+  }
+  output_rows_ = 0;
   last_data_flush_time_ = std::chrono::system_clock::now();
-  return SendRowBatchToChildren(exec_state, *rb);
+  return SendRowBatchToChildren(exec_state, rb);
 }
 
 Status UnionNode::MergeData(ExecState* exec_state) {
-  while (!sent_eos_) {
-    // Get the smallest time out of all of the current streams.
-    std::vector<size_t> parent_streams;
-    parent_streams.reserve(row_cursors_.size());
-
-    for (size_t parent = 0; parent < row_cursors_.size(); ++parent) {
-      if (flushed_parent_eoses_[parent]) {
-        continue;
-      }
-      // If we lack necessary data, we can't merge anymore.
-      if (!parent_row_batches_[parent].size()) {
-        return Status::OK();
-      }
-      parent_streams.push_back(parent);
+  if (sent_eos_) {
+    return Status::OK();
+  }
+  // If we lack necessary data, we can't merge anymore.
+  for (size_t parent = 0; parent < num_parents_; ++parent) {
+    if (!flushed_parent_eoses_[parent] && !parent_row_batches_[parent].size()) {
+      return Status::OK();
     }
+  }
 
+  BuildLoserTree();
+  while (!sent_eos_) {
+    size_t parent = loser_tree_[0];
     // If we have reached end of stream for all of our inputs, flush the queue.
-    if (!parent_streams.size()) {
+    if (flushed_parent_eoses_[parent]) {
       return OptionallyFlushRowBatchIfMaxRowsOrEOS(exec_state);
     }
 
-    std::sort(parent_streams.begin(), parent_streams.end(),
-              [this](size_t parent_a, size_t parent_b) {
-                auto time_a = GetTimeAtParentCursor(parent_a);
-                auto time_b = GetTimeAtParentCursor(parent_b);
-                return time_a < time_b || (time_a == time_b && parent_a < parent_b);
-              });
-
-    bool has_limit = parent_streams.size() > 1;
-    size_t parent = parent_streams[0];
-
-    while (parent_row_batches_[parent].size()) {
-      if (has_limit) {
-        size_t next_parent = parent_streams[1];
-        // If this time is greater than another parent stream's earliest time,
-        // or if they are the same but the first parent is at a smaller index, stop merging.
-        // This way rows are always stable with respect to input parent index.
-        if (GetTimeAtParentCursor(parent) > GetTimeAtParentCursor(next_parent) ||
-            (GetTimeAtParentCursor(parent) == GetTimeAtParentCursor(next_parent) &&
-             parent > next_parent)) {
-          break;
-        }
-      }
-
-      PX_RETURN_IF_ERROR(AppendRow(parent));
+    size_t begin = row_cursors_[parent];
+    size_t end = std::min(RunEnd(parent, LoserTreeRunnerUp()),
+                          begin + output_rows_per_batch_ - output_rows_);
+    AppendRun(parent, begin, end);
+    row_cursors_[parent] = end;
 
-      // Mark whether or not we hit the eos for this stream, and whether the row batch needs to be
-      // popped.
-      const auto& rb = parent_row_batches_[parent][0];
-      bool pop_row_batch = ++row_cursors_[parent] == static_cast<size_t>(rb.num_rows());
-      if (pop_row_batch && rb.eos()) {
+    const auto& rb = parent_row_batches_[parent][0];
+    if (end == static_cast<size_t>(rb.num_rows())) {
+      // Delete the top row batch from our buffer and update the cursor.
+      if (rb.eos()) {
         flushed_parent_eoses_[parent] = true;
       }
+      parent_row_batches_[parent].erase(parent_row_batches_[parent].begin());
+      row_cursors_[parent] = 0;
+      CacheNextRowBatch(parent);
+    }
 
-      if (pop_row_batch) {
-        // Delete the top row batch from our buffer and update the cursor.
-        parent_row_batches_[parent].erase(parent_row_batches_[parent].begin());
-        row_cursors_[parent] = 0;
-        CacheNextRowBatch(parent);
-      }
-
-      // Flush the current RowBatch if necessary.
-      PX_RETURN_IF_ERROR(OptionallyFlushRowBatchIfMaxRowsOrEOS(exec_state));
+    // Flush the current RowBatch if necessary.
+    PX_RETURN_IF_ERROR(OptionallyFlushRowBatchIfMaxRowsOrEOS(exec_state));
+    if (!flushed_parent_eoses_[parent] && !parent_row_batches_[parent].size()) {
+      // The next row of this parent isn't known yet, so nothing else can be merged.
+      return Status::OK();
     }
+    ReplayLoserTree(parent);
   }
   return Status::OK();
 }
@@ -253,7 +305,7 @@ void UnionNode::CacheNextRowBatch(size_t parent) {
   time_columns_[parent] = next_rb.ColumnAt(plan_node_->time_column_index(parent)).get();
 
   for (size_t i = 0; i < output_descriptor_->size(); ++i) {
-    data_columns_[parent][i] = GetInputColumn(next_rb, parent, i).get();
+    data_columns_[parent][i] = GetInputColumn(next_rb, parent, i);
   }
 }
 
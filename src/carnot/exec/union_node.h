@@ -43,20 +43,16 @@ constexpr size_t kDefaultDataFlushTimeoutMillis = 1000;
 
 // This node presumes that input streams will always come in ordered by time
 // when there is a time column.
+//
+// In the time ordered case, the parents are merged with a loser tree over their cursors. Each step
+// takes the longest run of rows of the first parent that sort before the cursor of the runner-up,
+// and adds it to the output batch as a slice of the input columns. The slices of a batch are
+// concatenated when it's flushed, so rows are never copied one at a time.
 class UnionNode : public ProcessingNode {
  public:
   UnionNode() = default;
   virtual ~UnionNode() = default;
 
-  // For the time ordered case: A MergeRow represents a row in an input row batch.
-  struct MergeRow {
-    size_t parent_index;
-    size_t row_batch_id;
-    size_t row_number;
-    types::Time64NSValue time;
-    bool end_of_row_batch;
-  };
-
   void disable_data_flush_timeout() { enable_data_flush_timeout_ = false; }
   void set_data_flush_timeout(const std::chrono::milliseconds& data_flush_timeout) {
     enable_data_flush_timeout_ = true;
@@ -89,9 +85,18 @@ class UnionNode : public ProcessingNode {
   // The items below are all for the time-ordered case.
 
   void CacheNextRowBatch(size_t parent);
-  Status InitializeColumnBuilders();
   types::Time64NSValue GetTimeAtParentCursor(size_t parent_index) const;
-  Status AppendRow(size_t parent);
+  // Whether the row at the cursor of parent_a is merged before the one of parent_b. Rows with the
+  // same time are ordered by parent index, and parents that reached their eos sort last.
+  bool ParentBefore(size_t parent_a, size_t parent_b) const;
+  void BuildLoserTree();
+  // Replays the matches of the parent after its cursor moved.
+  void ReplayLoserTree(size_t parent);
+  // The parent that would be merged next if the winner of the tree didn't have any rows left.
+  size_t LoserTreeRunnerUp() const;
+  // The end of the run of rows of the winner parent that are merged before the runner-up's cursor.
+  size_t RunEnd(size_t parent, size_t runner_up) const;
+  void AppendRun(size_t parent, size_t begin, size_t end);
   Status OptionallyFlushRowBatchIfMaxRowsOrEOS(ExecState* exec_state);
   Status OptionallyFlushRowBatchIfTimeout(ExecState* exec_state);
   Status FlushBatch(ExecState* exec_state);
@@ -101,8 +106,14 @@ class UnionNode : public ProcessingNode {
   // we just maintain the original row count to avoid copying the data.
   size_t output_rows_per_batch_;
 
-  // Column builders will flush a batch once they hit output_rows_per_batch_ rows.
-  std::vector<std::unique_ptr<arrow::ArrayBuilder>> column_builders_;
+  // The slices of the input columns that make up the next output batch, per output column. A
+  // batch is flushed once it has output_rows_per_batch_ rows.
+  std::vector<arrow::ArrayVector> output_slices_;
+  size_t output_rows_ = 0;
+
+  // loser_tree_[0] is the parent with the next row to merge, and every other node holds the parent
+  // that lost the match played there. Parent i is the leaf num_parents_ + i.
+  std::vector<size_t> loser_tree_;
 
   // Hold onto the input row batches for every parent until we copy all of their data.
   std::vector<std::vector<table_store::schema::RowBatch>> parent_row_batches_;
@@ -111,7 +122,7 @@ class UnionNode : public ProcessingNode {
   std::vector<size_t> row_cursors_;
   // Cache current working time and data columns for performance reasons.
   std::vector<arrow::Array*> time_columns_;
-  std::vector<std::vector<arrow::Array*>> data_columns_;
+  std::vector<std::vector<std::shared_ptr<arrow::Array>>> data_columns_;
 
   bool enable_data_flush_timeout_ = true;
   // When enable_data_flush_timeout_ is set to true, use this time to decide if we should
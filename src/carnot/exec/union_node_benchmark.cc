@@ -0,0 +1,145 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arrow/memory_pool.h>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <absl/strings/str_cat.h>
+#include <google/protobuf/text_format.h>
+#include <sole.hpp>
+
+#include "src/carnot/exec/exec_state.h"
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/exec/union_node.h"
+#include "src/carnot/udf/registry.h"
+#include "src/common/base/base.h"
+#include "src/datagen/datagen.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/table_store.h"
+
+using px::carnot::exec::ExecState;
+using px::carnot::exec::MockMetricsStubGenerator;
+using px::carnot::exec::MockResultSinkStubGenerator;
+using px::carnot::exec::MockTraceStubGenerator;
+using px::carnot::exec::UnionNode;
+using px::carnot::udf::Registry;
+using px::table_store::schema::RowBatch;
+using px::table_store::schema::RowDescriptor;
+using px::types::DataType;
+using px::types::Int64Value;
+using px::types::StringValue;
+using px::types::Time64NSValue;
+using px::types::ToArrow;
+
+constexpr int64_t kNumRows = 1 << 18;
+constexpr int64_t kBatchSize = 1024;
+
+// Measures the time ordered merge of fan_in parents, whose times interleave in runs of
+// run_length consecutive rows: the smaller the runs, the more often the merge switches parents.
+// NOLINTNEXTLINE : runtime/references.
+void BM_UnionOrderedMerge(benchmark::State& state) {
+  int64_t fan_in = state.range(0);
+  int64_t run_length = state.range(1);
+
+  auto func_registry = std::make_unique<Registry>("test_registry");
+  auto table_store = std::make_shared<px::table_store::TableStore>();
+  auto exec_state = std::make_unique<ExecState>(
+      func_registry.get(), table_store, MockResultSinkStubGenerator, MockMetricsStubGenerator,
+      MockTraceStubGenerator, sole::uuid4(), nullptr);
+
+  RowDescriptor rd({DataType::TIME64NS, DataType::STRING, DataType::INT64});
+  // The times of each parent, where time t goes to parent (t / run_length) % fan_in.
+  std::vector<std::vector<Time64NSValue>> parent_times(fan_in);
+  for (int64_t t = 0; t < kNumRows; ++t) {
+    parent_times[(t / run_length) % fan_in].emplace_back(t);
+  }
+  // The input batches, in the order that they are consumed: one batch of each parent in turn.
+  std::vector<std::pair<RowBatch, int64_t>> input_rbs;
+  int64_t num_batches = (kNumRows / fan_in + kBatchSize - 1) / kBatchSize;
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    for (int64_t parent = 0; parent < fan_in; ++parent) {
+      const auto& times = parent_times[parent];
+      int64_t offset = batch * kBatchSize;
+      int64_t batch_size = std::max<int64_t>(
+          0, std::min<int64_t>(kBatchSize, static_cast<int64_t>(times.size()) - offset));
+      std::vector<Time64NSValue> batch_times(times.begin() + offset,
+                                             times.begin() + offset + batch_size);
+      std::vector<StringValue> strings(batch_size);
+      for (auto& s : strings) {
+        s = px::datagen::RandomString(32);
+      }
+      auto values = px::datagen::CreateLargeData<Int64Value>(batch_size, 0, 1 << 30);
+      RowBatch rb(rd, batch_size);
+      PX_CHECK_OK(rb.AddColumn(ToArrow(batch_times, arrow::default_memory_pool())));
+      PX_CHECK_OK(rb.AddColumn(ToArrow(strings, arrow::default_memory_pool())));
+      PX_CHECK_OK(rb.AddColumn(ToArrow(values, arrow::default_memory_pool())));
+      bool last = batch == num_batches - 1;
+      rb.set_eow(last);
+      rb.set_eos(last);
+      input_rbs.emplace_back(std::move(rb), parent);
+    }
+  }
+
+  std::string union_pb = R"(
+op_type: UNION_OPERATOR
+union_op {
+  rows_per_batch: 1024
+  column_names: "time_"
+  column_names: "str"
+  column_names: "val")";
+  for (int64_t parent = 0; parent < fan_in; ++parent) {
+    absl::StrAppend(&union_pb,
+                    "\n  column_mappings { column_indexes: 0 column_indexes: 1 "
+                    "column_indexes: 2 }");
+  }
+  absl::StrAppend(&union_pb, "\n}");
+  px::carnot::planpb::Operator op_pb;
+  CHECK(google::protobuf::TextFormat::MergeFromString(union_pb, &op_pb));
+  auto plan_node = px::carnot::plan::UnionOperator::FromProto(op_pb, 1);
+  std::vector<RowDescriptor> input_rds(fan_in, rd);
+
+  // NOLINTNEXTLINE : clang-analyzer-deadcode.DeadStores.
+  for (auto _ : state) {
+    UnionNode union_node;
+    union_node.disable_data_flush_timeout();
+    PX_CHECK_OK(union_node.Init(*plan_node, rd, input_rds));
+    PX_CHECK_OK(union_node.Prepare(exec_state.get()));
+    PX_CHECK_OK(union_node.Open(exec_state.get()));
+    for (const auto& [rb, parent] : input_rbs) {
+      PX_CHECK_OK(union_node.ConsumeNext(exec_state.get(), rb, parent));
+    }
+    PX_CHECK_OK(union_node.Close(exec_state.get()));
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kNumRows);
+}
+
+void UnionArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t fan_in : {2, 16, 256}) {
+    for (int64_t run_length : {1, 16, 1024}) {
+      b->Args({fan_in, run_length});
+    }
+  }
+}
+
+BENCHMARK(BM_UnionOrderedMerge)->Apply(UnionArgs);
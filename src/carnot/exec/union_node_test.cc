@@ -19,6 +19,7 @@
 #include "src/carnot/exec/union_node.h"
 
 #include <gmock/gmock.h>
+#include <google/protobuf/text_format.h>
 #include <gtest/gtest.h>
 #include <sole.hpp>
 
@@ -276,6 +277,64 @@ TEST_F(UnionNodeTest, ordered_full_overlap) {
       .Close();
 }
 
+constexpr char kThreeParentsOrderedUnion[] = R"(
+op_type: UNION_OPERATOR
+union_op {
+  rows_per_batch: 4
+  column_names: "abc"
+  column_names: "time_"
+  column_mappings { column_indexes: 0 column_indexes: 1 }
+  column_mappings { column_indexes: 0 column_indexes: 1 }
+  column_mappings { column_indexes: 0 column_indexes: 1 }
+})";
+
+TEST_F(UnionNodeTest, ordered_runs_across_parents) {
+  planpb::Operator op_proto;
+  ASSERT_TRUE(google::protobuf::TextFormat::MergeFromString(kThreeParentsOrderedUnion, &op_proto));
+  plan_node_ = plan::UnionOperator::FromProto(op_proto, /*id*/ 1);
+
+  RowDescriptor rd({types::DataType::STRING, types::DataType::TIME64NS});
+  auto tester = exec::ExecNodeTester<UnionNode, plan::UnionOperator>(
+      *plan_node_, rd, {rd, rd, rd}, exec_state_.get());
+  tester.node()->disable_data_flush_timeout();
+
+  tester
+      .ConsumeNext(RowBatchBuilder(rd, 5, /*eow*/ true, /*eos*/ true)
+                       .AddColumn<types::StringValue>({"a0", "a1", "a2", "a3", "a4"})
+                       .AddColumn<types::Time64NSValue>({0, 1, 2, 10, 11})
+                       .get(),
+                   0, 0)
+      .ConsumeNext(RowBatchBuilder(rd, 4, true, true)
+                       .AddColumn<types::StringValue>({"b0", "b1", "b2", "b3"})
+                       .AddColumn<types::Time64NSValue>({3, 4, 5, 6})
+                       .get(),
+                   1, 0)
+      // Runs of each parent are merged up to the next row of another parent, and rows with the
+      // same time are ordered by parent.
+      .ConsumeNext(RowBatchBuilder(rd, 4, true, true)
+                       .AddColumn<types::StringValue>({"c0", "c1", "c2", "c3"})
+                       .AddColumn<types::Time64NSValue>({2, 7, 8, 20})
+                       .get(),
+                   2, 4)
+      .ExpectRowBatch(RowBatchBuilder(rd, 4, false, false)
+                          .AddColumn<types::StringValue>({"a0", "a1", "a2", "c0"})
+                          .AddColumn<types::Time64NSValue>({0, 1, 2, 2})
+                          .get())
+      .ExpectRowBatch(RowBatchBuilder(rd, 4, false, false)
+                          .AddColumn<types::StringValue>({"b0", "b1", "b2", "b3"})
+                          .AddColumn<types::Time64NSValue>({3, 4, 5, 6})
+                          .get())
+      .ExpectRowBatch(RowBatchBuilder(rd, 4, false, false)
+                          .AddColumn<types::StringValue>({"c1", "c2", "a3", "a4"})
+                          .AddColumn<types::Time64NSValue>({7, 8, 10, 11})
+                          .get())
+      .ExpectRowBatch(RowBatchBuilder(rd, 1, true, true)
+                          .AddColumn<types::StringValue>({"c3"})
+                          .AddColumn<types::Time64NSValue>({20})
+                          .get())
+      .Close();
+}
+
 TEST_F(UnionNodeTest, no_rows_parent) {
   auto op_proto = planpb::testutils::CreateTestUnionOrderedPB();
   plan_node_ = plan::UnionOperator::FromProto(op_proto, /*id*/ 1);
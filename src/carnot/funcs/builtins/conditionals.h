@@ -42,6 +42,13 @@ class SelectUDF : public udf::ScalarUDF {
     }
     return v2;
   }
+  void ExecBatch(FunctionContext*, size_t count, TArg* out, const BoolValue* s, const TArg* v1,
+                 const TArg* v2) {
+    for (size_t i = 0; i < count; ++i) {
+      // Both sides are already evaluated, so this compiles to a blend for the numeric types.
+      out[i] = s[i].val ? v1[i] : v2[i];
+    }
+  }
 
   static udf::InfRuleVec SemanticInferenceRules() {
     // Match the 1st and 2nd arg.
@@ -34,6 +34,24 @@ TEST(ConditionalsTest, SelectUDF) {
   udf_tester.ForInput(true, 20, 21).Expect(20);
 }
 
+TEST(ConditionalsTest, SelectUDFExecBatch) {
+  static_assert(udf::ScalarUDFTraits<SelectUDF<types::Int64Value>>::HasExecBatch());
+  udf::ScalarUDFDefinition def("select");
+  ASSERT_OK(def.Init<SelectUDF<types::Int64Value>>());
+  auto u = def.Make();
+  udf::FunctionContext ctx(nullptr, nullptr);
+
+  types::BoolValueColumnWrapper s({true, false, false, true});
+  types::Int64ValueColumnWrapper v1({1, 2, 3, 4});
+  types::Int64ValueColumnWrapper v2({10, 20, 30, 40});
+  types::Int64ValueColumnWrapper out(s.Size());
+  ASSERT_OK(def.ExecBatch(u.get(), &ctx, {&s, &v1, &v2}, &out, s.Size()));
+  EXPECT_EQ(1, out[0].val);
+  EXPECT_EQ(20, out[1].val);
+  EXPECT_EQ(30, out[2].val);
+  EXPECT_EQ(4, out[3].val);
+}
+
 }  // namespace builtins
 }  // namespace carnot
 }  // namespace px
@@ -35,6 +35,11 @@ template <typename TReturn, typename TArg1 = TReturn, typename TArg2 = TReturn>
 class AddUDF : public udf::ScalarUDF {
  public:
   TReturn Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1.val + b2.val; }
+  void ExecBatch(FunctionContext*, size_t count, TReturn* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = b1[i].val + b2[i].val;
+    }
+  }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::InheritTypeFromArgs<AddUDF>::Create({types::ST_BYTES, types::ST_THROUGHPUT_PER_NS,
@@ -60,6 +65,11 @@ template <typename TReturn, typename TArg1 = TReturn, typename TArg2 = TReturn>
 class SubtractUDF : public udf::ScalarUDF {
  public:
   TReturn Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1.val - b2.val; }
+  void ExecBatch(FunctionContext*, size_t count, TReturn* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = b1[i].val - b2[i].val;
+    }
+  }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::InheritTypeFromArgs<SubtractUDF>::Create({types::ST_BYTES, types::ST_THROUGHPUT_PER_NS,
@@ -88,6 +98,12 @@ class DivideUDF : public udf::ScalarUDF {
   types::Float64Value Exec(FunctionContext*, TArg1 b1, TArg2 b2) {
     return static_cast<double>(b1.val) / static_cast<double>(b2.val);
   }
+  void ExecBatch(FunctionContext*, size_t count, types::Float64Value* out, const TArg1* b1,
+                 const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = static_cast<double>(b1[i].val) / static_cast<double>(b2[i].val);
+    }
+  }
 
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<DivideUDF>(types::ST_THROUGHPUT_PER_NS,
@@ -113,6 +129,11 @@ template <typename TReturn, typename TArg1 = TReturn, typename TArg2 = TReturn>
 class MultiplyUDF : public udf::ScalarUDF {
  public:
   TReturn Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1.val * b2.val; }
+  void ExecBatch(FunctionContext*, size_t count, TReturn* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = b1[i].val * b2[i].val;
+    }
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Multiplies the arguments.")
         .Details("Multiplies the two values together. Accessible using the `*` operator syntax.")
@@ -266,6 +287,12 @@ template <typename TArg1, typename TArg2 = TArg1>
 class LogicalOrUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1.val || b2.val; }
+  void ExecBatch(FunctionContext*, size_t count, BoolValue* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      // Evaluate both sides, the loop vectorizes when it has no branches.
+      out[i] = (b1[i].val != 0) | (b2[i].val != 0);
+    }
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Boolean ORs the passed in values.")
         .Example(R"doc(# Implicit call.
@@ -285,6 +312,11 @@ template <typename TArg1, typename TArg2 = TArg1>
 class LogicalAndUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1.val && b2.val; }
+  void ExecBatch(FunctionContext*, size_t count, BoolValue* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = (b1[i].val != 0) & (b2[i].val != 0);
+    }
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Boolean ANDs the passed in values.")
         .Example(R"doc(# Implicit call.
@@ -302,6 +334,11 @@ template <typename TArg1>
 class LogicalNotUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1) { return !b1.val; }
+  void ExecBatch(FunctionContext*, size_t count, BoolValue* out, const TArg1* b1) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = !b1[i].val;
+    }
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Boolean NOTs the passed in value.")
         .Example(R"doc(# Implicit call.
@@ -318,6 +355,11 @@ template <typename TArg1>
 class NegateUDF : public udf::ScalarUDF {
  public:
   TArg1 Exec(FunctionContext*, TArg1 b1) { return -b1.val; }
+  void ExecBatch(FunctionContext*, size_t count, TArg1* out, const TArg1* b1) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = -b1[i].val;
+    }
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Negates the passed in value.")
         .Example(R"doc(# Implicit call.
@@ -374,6 +416,11 @@ template <typename TArg1, typename TArg2 = TArg1>
 class EqualUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 == b2; }
+  void ExecBatch(FunctionContext*, size_t count, BoolValue* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = b1[i] == b2[i];
+    }
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Returns whether the values are equal.")
         .Details(
@@ -394,6 +441,11 @@ template <typename TArg1, typename TArg2 = TArg1>
 class NotEqualUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 != b2; }
+  void ExecBatch(FunctionContext*, size_t count, BoolValue* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = b1[i] != b2[i];
+    }
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Returns whether the values are not equal.")
         .Details(
@@ -439,6 +491,11 @@ template <typename TArg1, typename TArg2 = TArg1>
 class GreaterThanUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 > b2; }
+  void ExecBatch(FunctionContext*, size_t count, BoolValue* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = b1[i] > b2[i];
+    }
+  }
 
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
@@ -458,6 +515,11 @@ template <typename TArg1, typename TArg2 = TArg1>
 class GreaterThanEqualUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 >= b2; }
+  void ExecBatch(FunctionContext*, size_t count, BoolValue* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = b1[i] >= b2[i];
+    }
+  }
 
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
@@ -478,6 +540,11 @@ template <typename TArg1, typename TArg2 = TArg1>
 class LessThanUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 < b2; }
+  void ExecBatch(FunctionContext*, size_t count, BoolValue* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = b1[i] < b2[i];
+    }
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Returns which value is less than the other.")
         .Example(R"doc(# Implict call.
@@ -494,6 +561,11 @@ template <typename TArg1, typename TArg2 = TArg1>
 class LessThanEqualUDF : public udf::ScalarUDF {
  public:
   BoolValue Exec(FunctionContext*, TArg1 b1, TArg2 b2) { return b1 <= b2; }
+  void ExecBatch(FunctionContext*, size_t count, BoolValue* out, const TArg1* b1, const TArg2* b2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = b1[i] <= b2[i];
+    }
+  }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Returns which value is less than or equal to the the other.")
         .Example(R"doc(
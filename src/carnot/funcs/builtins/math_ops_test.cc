@@ -18,6 +18,7 @@
 
 #include <gtest/gtest.h>
 #include <numeric>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -635,6 +636,62 @@ TEST(MathOps, partial_count_test) {
   auto uda_tester = udf::UDATester<CountUDA<types::Int64Value>>();
   uda_tester.ForInput(3).ForInput(6).ForInput(10).ForInput(5).ForInput(2).Expect(5);
 }
+
+// Checks that the ExecBatch function of the UDF produces the same output as calling Exec per row.
+template <typename TUDF, typename TOutput, typename... TArgs>
+void ExpectExecBatchMatchesExec(const types::ColumnWrapperTmpl<TArgs>&... args) {
+  static_assert(udf::ScalarUDFTraits<TUDF>::HasExecBatch());
+  udf::ScalarUDFDefinition def("test");
+  ASSERT_OK(def.Init<TUDF>());
+  auto u = def.Make();
+  udf::FunctionContext ctx(nullptr, nullptr);
+
+  size_t size = std::get<0>(std::forward_as_tuple(args...)).Size();
+  types::ColumnWrapperTmpl<TOutput> batch_out(size);
+  types::ColumnWrapperTmpl<TOutput> per_row_out(size);
+  ASSERT_OK(def.ExecBatch(u.get(), &ctx, {&args...}, &batch_out, size));
+  ASSERT_OK(def.ExecBatchPerRow(u.get(), &ctx, {&args...}, &per_row_out, size));
+  for (size_t i = 0; i < size; ++i) {
+    EXPECT_TRUE(per_row_out[i] == batch_out[i]) << "row " << i;
+  }
+}
+
+TEST(MathOps, exec_batch_matches_exec) {
+  types::Int64ValueColumnWrapper ints({1, -2, 0, 7, 100, -55, 3});
+  types::Int64ValueColumnWrapper other_ints({5, -2, 1, 0, 99, 12, 3});
+  types::Float64ValueColumnWrapper floats({1.5, -2.0, 0.0, 7.25, 100.0, -55.5, 3.0});
+  types::BoolValueColumnWrapper bools({true, false, true, false, true, false, false});
+  types::BoolValueColumnWrapper other_bools({true, true, false, false, true, true, false});
+  types::StringValueColumnWrapper strs({"a", "b", "abc", "", "z", "b", "c"});
+  types::StringValueColumnWrapper other_strs({"a", "a", "abd", "", "y", "c", "c"});
+
+  ExpectExecBatchMatchesExec<AddUDF<types::Int64Value>, types::Int64Value>(ints, other_ints);
+  ExpectExecBatchMatchesExec<
+      AddUDF<types::Float64Value, types::Float64Value, types::Int64Value>, types::Float64Value>(
+      floats, ints);
+  ExpectExecBatchMatchesExec<SubtractUDF<types::Int64Value>, types::Int64Value>(ints, other_ints);
+  ExpectExecBatchMatchesExec<MultiplyUDF<types::Int64Value>, types::Int64Value>(ints, other_ints);
+  ExpectExecBatchMatchesExec<DivideUDF<types::Float64Value, types::Int64Value>,
+                             types::Float64Value>(floats, other_ints);
+  ExpectExecBatchMatchesExec<NegateUDF<types::Float64Value>, types::Float64Value>(floats);
+
+  ExpectExecBatchMatchesExec<LogicalAndUDF<types::BoolValue>, types::BoolValue>(bools,
+                                                                               other_bools);
+  ExpectExecBatchMatchesExec<LogicalOrUDF<types::Int64Value>, types::BoolValue>(ints, other_ints);
+  ExpectExecBatchMatchesExec<LogicalNotUDF<types::Int64Value>, types::BoolValue>(ints);
+
+  ExpectExecBatchMatchesExec<EqualUDF<types::Int64Value>, types::BoolValue>(ints, other_ints);
+  ExpectExecBatchMatchesExec<EqualUDF<types::StringValue>, types::BoolValue>(strs, other_strs);
+  ExpectExecBatchMatchesExec<NotEqualUDF<types::Int64Value, types::Float64Value>,
+                             types::BoolValue>(ints, floats);
+  ExpectExecBatchMatchesExec<GreaterThanUDF<types::Int64Value>, types::BoolValue>(ints,
+                                                                                 other_ints);
+  ExpectExecBatchMatchesExec<GreaterThanEqualUDF<types::StringValue>, types::BoolValue>(
+      strs, other_strs);
+  ExpectExecBatchMatchesExec<LessThanUDF<types::Float64Value>, types::BoolValue>(floats, floats);
+  ExpectExecBatchMatchesExec<LessThanEqualUDF<types::Int64Value>, types::BoolValue>(ints,
+                                                                                   other_ints);
+}
 }  // namespace builtins
 }  // namespace carnot
 }  // namespace px
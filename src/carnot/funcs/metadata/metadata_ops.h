@@ -57,6 +57,8 @@ inline StatusOr<K8sNameIdentView> K8sName(std::string_view name) {
 
 }  // namespace internal
 
+// The metadata state of a function context is a snapshot that doesn't change while it's in use,
+// so the UDFs that look up their argument in it are Deterministic().
 inline const px::md::AgentMetadataState* GetMetadataState(px::carnot::udf::FunctionContext* ctx) {
   DCHECK(ctx != nullptr);
   auto md = ctx->metadata_state();
@@ -111,6 +113,7 @@ class PodIDToPodNameUDF : public ScalarUDF {
 
     return "";
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<PodIDToPodNameUDF>(types::ST_POD_NAME, {types::ST_NONE})};
   }
@@ -135,6 +138,7 @@ class PodIDToPodLabelsUDF : public ScalarUDF {
     return "";
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get labels of a pod from its pod ID.")
         .Details("Gets the kubernetes pod labels for the pod from its pod ID.")
@@ -151,6 +155,7 @@ class PodNameToPodIDUDF : public ScalarUDF {
     return GetPodID(md, pod_name);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static StringValue GetPodID(const px::md::AgentMetadataState* md, StringValue pod_name) {
     // This UDF expects the pod name to be in the format of "<ns>/<pod-name>".
     PX_ASSIGN_OR(auto pod_name_view, internal::K8sName(pod_name), return "");
@@ -179,6 +184,7 @@ class PodNameToPodIPUDF : public ScalarUDF {
     return pod_info->pod_ip();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the IP address of a pod from its name.")
         .Details("Gets the IP address for the pod from its name.")
@@ -200,6 +206,7 @@ class PodIDToNamespaceUDF : public ScalarUDF {
 
     return "";
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::ExplicitRule::Create<PodIDToNamespaceUDF>(types::ST_NAMESPACE_NAME, {types::ST_NONE})};
@@ -248,6 +255,7 @@ class UPIDToContainerIDUDF : public ScalarUDF {
     return pid->cid();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Kubernetes container ID from a UPID.")
         .Details(
@@ -286,6 +294,7 @@ class UPIDToContainerNameUDF : public ScalarUDF {
     return std::string(container_info->name());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<UPIDToContainerNameUDF>(types::ST_CONTAINER_NAME,
                                                               {types::ST_NONE})};
@@ -328,6 +337,7 @@ class UPIDToNamespaceUDF : public ScalarUDF {
     return pod_info->ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::ExplicitRule::Create<UPIDToNamespaceUDF>(types::ST_NAMESPACE_NAME, {types::ST_NONE})};
@@ -360,6 +370,7 @@ class UPIDToPodIDUDF : public ScalarUDF {
     return std::string(container_info->pod_id());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Kubernetes Pod ID from a UPID.")
         .Details(
@@ -387,6 +398,7 @@ class UPIDToPodNameUDF : public ScalarUDF {
     return absl::Substitute("$0/$1", pod_info->ns(), pod_info->name());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<UPIDToPodNameUDF>(types::ST_POD_NAME, {types::ST_NONE})};
   }
@@ -419,6 +431,7 @@ class ServiceIDToServiceNameUDF : public ScalarUDF {
 
     return "";
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<ServiceIDToServiceNameUDF>(types::ST_SERVICE_NAME,
                                                                  {types::ST_NONE})};
@@ -445,6 +458,7 @@ class ServiceIDToClusterIPUDF : public ScalarUDF {
     }
     return "";
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::ExplicitRule::Create<ServiceIDToClusterIPUDF>(types::ST_IP_ADDRESS, {types::ST_NONE})};
@@ -470,6 +484,7 @@ class ServiceIDToExternalIPsUDF : public ScalarUDF {
     }
     return "";
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
                "Convert the Kubernetes service ID to its external IP addresses.")
@@ -492,6 +507,7 @@ class ServiceNameToServiceIDUDF : public ScalarUDF {
     auto service_id = md->k8s_metadata_state().ServiceIDByName(service_name_view);
     return service_id;
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Convert the service name to the service ID.")
         .Details(
@@ -557,6 +573,7 @@ class UPIDToServiceIDUDF : public ScalarUDF {
     return StringifyVector(running_service_ids);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Service ID from a UPID.")
         .Details(
@@ -598,6 +615,7 @@ class UPIDToServiceNameUDF : public ScalarUDF {
     }
     return StringifyVector(running_service_names);
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::ExplicitRule::Create<UPIDToServiceNameUDF>(types::ST_SERVICE_NAME, {types::ST_NONE})};
@@ -634,6 +652,7 @@ class UPIDToNodeNameUDF : public ScalarUDF {
     std::string foo = std::string(pod_info->node_name());
     return foo;
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<UPIDToNodeNameUDF>(types::ST_NODE_NAME, {types::ST_NONE})};
   }
@@ -807,6 +826,7 @@ class ReplicaSetIDToReplicaSetNameUDF : public ScalarUDF {
     return absl::Substitute("$0/$1", rs_info->ns(), rs_info->name());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Replica Set Name from a Replica Set ID.")
         .Details(
@@ -834,6 +854,7 @@ class ReplicaSetIDToStartTimeUDF : public ScalarUDF {
     return rs_info->start_time_ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the start time of a Replica Set from its ID.")
         .Details(
@@ -858,6 +879,7 @@ class ReplicaSetIDToStopTimeUDF : public ScalarUDF {
     return rs_info->stop_time_ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the stop time of a Replica Set from its ID.")
         .Details(
@@ -882,6 +904,7 @@ class ReplicaSetIDToNamespaceUDF : public ScalarUDF {
     return rs_info->ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the namespace of a Replica Set from its ID.")
         .Details("Gets the namespace of a Replica Set from its ID.")
@@ -911,6 +934,7 @@ class ReplicaSetIDToOwnerReferencesUDF : public ScalarUDF {
     return VectorToStringArray(owner_references);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the owner references of a Replica Set from its ID.")
         .Details("Gets the owner references of a Replica Set from its ID.")
@@ -936,6 +960,7 @@ class ReplicaSetIDToStatusUDF : public ScalarUDF {
     return ReplicaSetInfoToStatus(rs_info);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the status of a Replica Set from its ID.")
         .Details("Gets the status of a Replica Set from its ID.")
@@ -965,6 +990,7 @@ class ReplicaSetIDToDeploymentNameUDF : public ScalarUDF {
     return absl::Substitute("$0/$1", dep_info->ns(), dep_info->name());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Deployment name of a Replica Set from its ID.")
         .Details("Gets the Deployment name of a Replica Set from its ID.")
@@ -995,6 +1021,7 @@ class ReplicaSetIDToDeploymentIDUDF : public ScalarUDF {
     return dep_info->uid();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Deployment ID of a Replica Set from its ID.")
         .Details("Gets the Deployment ID of a Replica Set from its ID.")
@@ -1020,6 +1047,7 @@ class ReplicaSetNameToReplicaSetIDUDF : public ScalarUDF {
     return replica_set_id;
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Replica Set ID from a Replica Set name.")
         .Details(
@@ -1054,6 +1082,7 @@ class ReplicaSetNameToStartTimeUDF : public ScalarUDF {
     return rs_info->start_time_ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the start time of a Replica Set from its name.")
         .Details(
@@ -1085,6 +1114,7 @@ class ReplicaSetNameToStopTimeUDF : public ScalarUDF {
     return rs_info->stop_time_ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the stop time of a Replica Set from its name.")
         .Details(
@@ -1116,6 +1146,7 @@ class ReplicaSetNameToNamespaceUDF : public ScalarUDF {
     return rs_info->ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the namespace of a Replica Set from its name.")
         .Details("Gets the namespace of a Replica Set from its name.")
@@ -1152,6 +1183,7 @@ class ReplicaSetNameToOwnerReferencesUDF : public ScalarUDF {
     return VectorToStringArray(owner_references);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the owner references of a Replica Set from its name.")
         .Details("Gets the owner references of a Replica Set from its name.")
@@ -1183,6 +1215,7 @@ class ReplicaSetNameToStatusUDF : public ScalarUDF {
     return ReplicaSetInfoToStatus(rs_info);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the status of a Replica Set from its name.")
         .Details("Gets the status of a Replica Set from its name.")
@@ -1219,6 +1252,7 @@ class ReplicaSetNameToDeploymentNameUDF : public ScalarUDF {
     return absl::Substitute("$0/$1", dep_info->ns(), dep_info->name());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Deployment name of a Replica Set from its name.")
         .Details("Gets the Deployment name of a Replica Set from its name.")
@@ -1254,6 +1288,7 @@ class ReplicaSetNameToDeploymentIDUDF : public ScalarUDF {
     return dep_info->uid();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Deployment ID of a Replica Set from its name.")
         .Details("Gets the Deployment ID of a Replica Set from its name.")
@@ -1279,6 +1314,7 @@ class DeploymentIDToDeploymentNameUDF : public ScalarUDF {
     return absl::Substitute("$0/$1", dep_info->ns(), dep_info->name());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Deployment Name from a Deployment ID.")
         .Details(
@@ -1306,6 +1342,7 @@ class DeploymentIDToStartTimeUDF : public ScalarUDF {
     return dep_info->start_time_ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the start time of a Deployment from its ID.")
         .Details(
@@ -1330,6 +1367,7 @@ class DeploymentIDToStopTimeUDF : public ScalarUDF {
     return dep_info->stop_time_ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the stop time of a Deployment from its ID.")
         .Details("Gets the stop time (in nanosecond unix time format) of a Deployment from its ID.")
@@ -1353,6 +1391,7 @@ class DeploymentIDToNamespaceUDF : public ScalarUDF {
     return dep_info->ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the namespace of a Deployment from its ID.")
         .Details("Gets the namespace of a Deployment from its ID.")
@@ -1377,6 +1416,7 @@ class DeploymentIDToStatusUDF : public ScalarUDF {
     return DeploymentInfoToStatus(dep_info);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the status of a Deployment from its ID.")
         .Details("Gets the status of a Deployment from its ID.")
@@ -1401,6 +1441,7 @@ class DeploymentNameToDeploymentIDUDF : public ScalarUDF {
     return deployment_id;
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Deployment ID from a Deployment name.")
         .Details(
@@ -1435,6 +1476,7 @@ class DeploymentNameToStartTimeUDF : public ScalarUDF {
     return dep_info->start_time_ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the start time of a Deployment from its name.")
         .Details(
@@ -1466,6 +1508,7 @@ class DeploymentNameToStopTimeUDF : public ScalarUDF {
     return dep_info->stop_time_ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the stop time of a Deployment from its name.")
         .Details(
@@ -1497,6 +1540,7 @@ class DeploymentNameToNamespaceUDF : public ScalarUDF {
     return dep_info->ns();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the namespace of a Deployment from its name.")
         .Details("Gets the namespace of a Deployment from its name.")
@@ -1528,6 +1572,7 @@ class DeploymentNameToStatusUDF : public ScalarUDF {
     return DeploymentInfoToStatus(dep_info);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the status of a Deployment from its name.")
         .Details("Gets the status of a Deployment from its name.")
@@ -1563,6 +1608,7 @@ class UPIDToReplicaSetNameUDF : public ScalarUDF {
     return absl::Substitute("$0/$1", rs_info->ns(), rs_info->name());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Replica Set Name from a UPID.")
         .Details(
@@ -1603,6 +1649,7 @@ class UPIDToReplicaSetIDUDF : public ScalarUDF {
     return rs_info->uid();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Replica Set ID from a UPID.")
         .Details(
@@ -1640,6 +1687,7 @@ class UPIDToReplicaSetStatusUDF : public ScalarUDF {
     return ReplicaSetInfoToStatus(rs_info);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Replica Set Status from a UPID.")
         .Details(
@@ -1687,6 +1735,7 @@ class UPIDToDeploymentNameUDF : public ScalarUDF {
     return absl::Substitute("$0/$1", dep_info->ns(), dep_info->name());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Deployment Name from a UPID.")
         .Details(
@@ -1732,6 +1781,7 @@ class UPIDToDeploymentIDUDF : public ScalarUDF {
     return dep_info->uid();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Deployment ID from a UPID.")
         .Details(
@@ -1762,6 +1812,7 @@ class UPIDToHostnameUDF : public ScalarUDF {
     }
     return pod_info->hostname();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Hostname from a UPID.")
         .Details(
@@ -1803,6 +1854,7 @@ class PodIDToServiceNameUDF : public ScalarUDF {
     }
     return StringifyVector(running_service_names);
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::ExplicitRule::Create<PodIDToServiceNameUDF>(types::ST_SERVICE_NAME, {types::ST_NONE})};
@@ -1844,6 +1896,7 @@ class PodIDToServiceIDUDF : public ScalarUDF {
     }
     return StringifyVector(running_service_ids);
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the service ID for a given pod ID.")
         .Details(
@@ -1874,6 +1927,7 @@ class PodIDToOwnerReferencesUDF : public ScalarUDF {
     }
     return VectorToStringArray(owner_references);
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the owner references for a given pod ID.")
         .Details(
@@ -1905,6 +1959,7 @@ class PodNameToOwnerReferencesUDF : public ScalarUDF {
     }
     return VectorToStringArray(owner_references);
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the owner references for a given pod name.")
         .Details(
@@ -1931,6 +1986,7 @@ class PodIDToNodeNameUDF : public ScalarUDF {
     std::string foo = std::string(pod_info->node_name());
     return foo;
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<PodIDToNodeNameUDF>(types::ST_NODE_NAME, {types::ST_NONE})};
   }
@@ -1966,6 +2022,7 @@ class PodIDToReplicaSetNameUDF : public ScalarUDF {
     return absl::Substitute("$0/$1", rs_info->ns(), rs_info->name());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
                "Get the name of the Replica Set which controls the pod with pod ID.")
@@ -1999,6 +2056,7 @@ class PodIDToReplicaSetIDUDF : public ScalarUDF {
     return rs_info->uid();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
                "Get the ID of the Replica Set which controls the pod with pod ID.")
@@ -2037,6 +2095,7 @@ class PodIDToDeploymentNameUDF : public ScalarUDF {
     return absl::Substitute("$0/$1", dep_info->ns(), dep_info->name());
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
                "Get the name of the Deployment which controls the pod with pod ID.")
@@ -2075,6 +2134,7 @@ class PodIDToDeploymentIDUDF : public ScalarUDF {
     return dep_info->uid();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
                "Get the ID of the Deployment which controls the pod with pod ID.")
@@ -2111,6 +2171,7 @@ class PodNameToReplicaSetNameUDF : public ScalarUDF {
 
     return absl::Substitute("$0/$1", rs_info->ns(), rs_info->name());
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
                "Get the name of the Replica Set which controls the pod with the specified pod "
@@ -2149,6 +2210,7 @@ class PodNameToReplicaSetIDUDF : public ScalarUDF {
 
     return rs_info->uid();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
                "Get the ID of the Replica Set which controls the pod with the specified pod "
@@ -2192,6 +2254,7 @@ class PodNameToDeploymentNameUDF : public ScalarUDF {
 
     return absl::Substitute("$0/$1", dep_info->ns(), dep_info->name());
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
                "Get the name of the Deployment which controls the pod with the specified pod "
@@ -2235,6 +2298,7 @@ class PodNameToDeploymentIDUDF : public ScalarUDF {
 
     return dep_info->uid();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
                "Get the ID of the Deployment which controls the pod with the specified pod "
@@ -2279,6 +2343,7 @@ class PodNameToServiceNameUDF : public ScalarUDF {
     }
     return StringifyVector(running_service_names);
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<PodNameToServiceNameUDF>(types::ST_SERVICE_NAME,
                                                                {types::ST_POD_NAME})};
@@ -2324,6 +2389,7 @@ class PodNameToServiceIDUDF : public ScalarUDF {
     }
     return StringifyVector(running_service_ids);
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the service ID for a given pod name.")
         .Details(
@@ -2405,6 +2471,7 @@ class PodIDToPodStartTimeUDF : public ScalarUDF {
     }
     return pod_info->start_time_ns();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the start time of a pod from its ID.")
         .Details("Gets the start time (in nanosecond unix time format) of a pod from its pod ID.")
@@ -2424,6 +2491,7 @@ class PodIDToPodStopTimeUDF : public ScalarUDF {
     }
     return pod_info->stop_time_ns();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the stop time of a pod from its ID.")
         .Details("Gets the stop time (in nanosecond unix time format) of a pod from its pod ID.")
@@ -2444,6 +2512,7 @@ class PodNameToPodStartTimeUDF : public ScalarUDF {
     }
     return pod_info->start_time_ns();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the start time of a pod from its name.")
         .Details("Gets the start time (in nanosecond unix time format) of a pod from its name.")
@@ -2464,6 +2533,7 @@ class PodNameToPodStopTimeUDF : public ScalarUDF {
     }
     return pod_info->stop_time_ns();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the stop time of a pod from its name.")
         .Details("Gets the stop time (in nanosecond unix time format) of a pod from its name.")
@@ -2480,6 +2550,7 @@ class ContainerNameToContainerIDUDF : public ScalarUDF {
     return md->k8s_metadata_state().ContainerIDByName(container_name);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the id of a container from its name.")
         .Details("Gets the kubernetes ID for the container from its name.")
@@ -2500,6 +2571,7 @@ class ContainerIDToContainerStartTimeUDF : public ScalarUDF {
     }
     return container_info->start_time_ns();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the start time of a container from its ID.")
         .Details(
@@ -2522,6 +2594,7 @@ class ContainerIDToContainerStopTimeUDF : public ScalarUDF {
     }
     return container_info->stop_time_ns();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the stop time of a container from its ID.")
         .Details(
@@ -2545,6 +2618,7 @@ class ContainerNameToContainerStartTimeUDF : public ScalarUDF {
     }
     return container_info->start_time_ns();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the start time of a container from its name.")
         .Details(
@@ -2567,6 +2641,7 @@ class ContainerNameToContainerStopTimeUDF : public ScalarUDF {
     }
     return container_info->stop_time_ns();
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the stop time of a container from its name.")
         .Details(
@@ -2640,6 +2715,7 @@ class PodNameToPodStatusUDF : public ScalarUDF {
     return PodInfoToPodStatus(pod_info);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {
         udf::ExplicitRule::Create<PodNameToPodStatusUDF>(types::ST_POD_STATUS, {types::ST_NONE})};
@@ -2677,6 +2753,7 @@ class PodNameToPodReadyUDF : public ScalarUDF {
     return ready_status->second == md::ConditionStatus::kTrue;
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get readiness information about the given pod.")
         .Details(
@@ -2779,6 +2856,7 @@ class ContainerIDToContainerStatusUDF : public ScalarUDF {
     return sb.GetString();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<ContainerIDToContainerStatusUDF>(types::ST_CONTAINER_STATUS,
                                                                        {types::ST_NONE})};
@@ -2811,6 +2889,7 @@ class UPIDToPodStatusUDF : public ScalarUDF {
     return PodInfoToPodStatus(UPIDtoPod(md, upid_value));
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::InfRuleVec SemanticInferenceRules() {
     return {udf::ExplicitRule::Create<UPIDToPodStatusUDF>(types::ST_POD_STATUS, {types::ST_NONE})};
   }
@@ -2856,6 +2935,7 @@ class UPIDToCmdLineUDF : public ScalarUDF {
     return pid_info->cmdline();
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the command line arguments used to start a UPID.")
         .Details(
@@ -2890,6 +2970,7 @@ class UPIDToPodQoSUDF : public ScalarUDF {
     auto md = GetMetadataState(ctx);
     return PodInfoToPodQoS(UPIDtoPod(md, upid_value));
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Kubernetes QOS class for the UPID.")
         .Details(
@@ -2953,6 +3034,7 @@ class IPToPodIDUDF : public ScalarUDF {
     auto md = GetMetadataState(ctx);
     return md->k8s_metadata_state().PodIDByIP(pod_ip);
   }
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder(
                "Convert IP address to the kubernetes pod ID that runs the backing service.")
@@ -3030,6 +3112,7 @@ class IPToServiceIDUDF : public ScalarUDF {
     return udf.Exec(ctx, pod_id);
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the service ID for a given IP.")
         .Details(
@@ -3271,6 +3354,7 @@ class NamespaceNameToNamespaceIDUDF : public ScalarUDF {
     return namespace_id;
   }
 
+  static constexpr bool Deterministic() { return true; }
   static udf::ScalarUDFDocBuilder Doc() {
     return udf::ScalarUDFDocBuilder("Get the Kubernetes UID of the given namespace name.")
         .Details("Get the Kubernetes UID of the given namespace name.")
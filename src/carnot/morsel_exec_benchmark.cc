@@ -0,0 +1,197 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sole.hpp>
+
+#include "src/carnot/carnot.h"
+#include "src/carnot/exec/exec_graph.h"
+#include "src/carnot/exec/local_grpc_result_server.h"
+#include "src/carnot/exec/test_utils.h"
+#include "src/carnot/funcs/funcs.h"
+#include "src/carnot/udf/udf.h"
+#include "src/common/base/base.h"
+#include "src/common/benchmark/benchmark.h"
+#include "src/common/testing/test_environment.h"
+#include "src/datagen/datagen.h"
+#include "src/table_store/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace exec {
+
+constexpr char kGroupByOneQuery[] = R"pxl(
+import px
+df = px.DataFrame(table='test_table', select=['col0', 'col1'])
+df = df.groupby('col0').agg(sum=('col1', px.sum), mean=('col1', px.mean))
+px.display(df, '$0')
+)pxl";
+
+constexpr char kFilterGroupByOneQuery[] = R"pxl(
+import px
+df = px.DataFrame(table='test_table', select=['col0', 'col1'])
+df.col2 = df.col1 * 2
+df = df[df.col2 > 100]
+df = df.groupby('col0').agg(sum=('col2', px.sum), count=('col2', px.count))
+px.display(df, '$0')
+)pxl";
+
+constexpr char kManyGroupsQuery[] = R"pxl(
+import px
+df = px.DataFrame(table='test_table', select=['col0', 'col1'])
+df = df.groupby('col0').agg(count=('col1', px.count), mean=('col1', px.mean),
+                            sum=('col1', px.sum))
+px.display(df, '$0')
+)pxl";
+
+constexpr char kManyGroupsQuantilesQuery[] = R"pxl(
+import px
+df = px.DataFrame(table='test_table', select=['col0', 'col1'])
+df = df.groupby('col0').agg(quantiles=('col1', px.quantiles))
+px.display(df, '$0')
+)pxl";
+
+std::unique_ptr<Carnot> SetUpCarnot(std::shared_ptr<table_store::TableStore> table_store,
+                                    LocalGRPCResultSinkServer* server) {
+  auto func_registry = std::make_unique<px::carnot::udf::Registry>("default_registry");
+  funcs::RegisterFuncsOrDie(func_registry.get());
+  auto clients_config = std::make_unique<Carnot::ClientsConfig>(Carnot::ClientsConfig{
+      [server](const std::string& address, const std::string&) {
+        return server->StubGenerator(address);
+      },
+      [](grpc::ClientContext*) {},
+  });
+  auto server_config = std::make_unique<Carnot::ServerConfig>();
+  server_config->grpc_server_port = 0;
+
+  return px::carnot::Carnot::Create(sole::uuid4(), std::move(func_registry), table_store,
+                                    std::move(clients_config), std::move(server_config))
+      .ConsumeValueOrDie();
+}
+
+// A table whose first column cycles through num_groups keys, so that every worker of the morsel
+// pipeline ends up with every group, and the merge of their groups is a large part of the query.
+std::shared_ptr<table_store::Table> CreateManyGroupsTable(int64_t num_groups,
+                                                          int64_t rows_per_batch,
+                                                          int64_t num_batches) {
+  table_store::schema::Relation rel({types::DataType::INT64, types::DataType::INT64},
+                                    {"col0", "col1"});
+  auto table = table_store::Table::Create("test_table", rel);
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    std::vector<types::Int64Value> groups;
+    for (int64_t i = 0; i < rows_per_batch; ++i) {
+      groups.push_back((batch * rows_per_batch + i) % num_groups);
+    }
+    auto values = datagen::CreateLargeData<types::Int64Value>(rows_per_batch);
+    table_store::schema::RowBatch rb(table_store::schema::RowDescriptor(rel.col_types()),
+                                     rows_per_batch);
+    PX_CHECK_OK(rb.AddColumn(types::ToArrow(groups, arrow::default_memory_pool())));
+    PX_CHECK_OK(rb.AddColumn(types::ToArrow(values, arrow::default_memory_pool())));
+    PX_CHECK_OK(table->WriteRowBatch(rb));
+  }
+  return table;
+}
+
+// NOLINTNEXTLINE : runtime/references.
+void RunQuery(benchmark::State& state, const std::string& query,
+              std::shared_ptr<table_store::Table> table) {
+  auto table_store = std::make_shared<table_store::TableStore>();
+  auto server = LocalGRPCResultSinkServer();
+
+  auto carnot = SetUpCarnot(table_store, &server);
+  table_store->AddTable("test_table", table);
+
+  int64_t bytes_processed = 0;
+  int i = 0;
+  for (auto _ : state) {
+    auto query_with_table_name = absl::Substitute(query, "results_" + std::to_string(i));
+    auto res = carnot->ExecuteQuery(query_with_table_name, sole::uuid4(), CurrentTimeNS());
+    if (!res.ok()) {
+      LOG(FATAL) << "Morsel benchmark query did not execute successfully.";
+    }
+    bytes_processed += server.exec_stats().ConsumeValueOrDie().execution_stats().bytes_processed();
+    server.ResetQueryResults();
+    ++i;
+  }
+
+  state.SetBytesProcessed(int64_t(bytes_processed));
+}
+
+// Runs the query with state.range(0) rows per batch, on state.range(1) morsel threads.
+// NOLINTNEXTLINE : runtime/references.
+void BM_MorselQuery(benchmark::State& state, const std::string& query, int64_t num_batches) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_morsel_exec_threads, static_cast<int32_t>(state.range(1)));
+  const datagen::DistributionParams* default_params = nullptr;
+  auto table = table_store::CreateTable(
+                   {types::DataType::INT64, types::DataType::INT64},
+                   {datagen::DistributionType::kUniform, datagen::DistributionType::kUniform},
+                   state.range(0), num_batches, default_params, default_params)
+                   .ConsumeValueOrDie();
+  RunQuery(state, query, table);
+}
+
+// Runs the query over state.range(0) groups, on state.range(1) morsel threads. Every thread holds
+// every group, so this measures how the merge of the workers' groups scales with the threads.
+// NOLINTNEXTLINE : runtime/references.
+void BM_MorselMerge(benchmark::State& state, const std::string& query) {
+  PX_SET_FOR_SCOPE(FLAGS_carnot_morsel_exec_threads, static_cast<int32_t>(state.range(1)));
+  RunQuery(state, query,
+           CreateManyGroupsTable(state.range(0), /* rows_per_batch */ 1 << 14,
+                                 /* num_batches */ 64));
+}
+
+void MorselArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t rows_per_batch : {1 << 10, 1 << 14}) {
+    for (int64_t threads : {1, 2, 4, 8}) {
+      b->Args({rows_per_batch, threads});
+    }
+  }
+}
+
+void MorselMergeArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t num_groups : {1 << 12, 1 << 16, 1 << 18}) {
+    for (int64_t threads : {1, 2, 4, 8}) {
+      b->Args({num_groups, threads});
+    }
+  }
+}
+
+BENCHMARK_CAPTURE(BM_MorselQuery, group_by_one, kGroupByOneQuery, 64)
+    ->Apply(MorselArgs)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(BM_MorselQuery, filter_group_by_one, kFilterGroupByOneQuery, 64)
+    ->Apply(MorselArgs)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(BM_MorselMerge, count_mean_sum, kManyGroupsQuery)
+    ->Apply(MorselMergeArgs)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(BM_MorselMerge, quantiles, kManyGroupsQuantilesQuery)
+    ->Apply(MorselMergeArgs)
+    ->UseRealTime();
+
+}  // namespace exec
+}  // namespace carnot
+}  // namespace px
@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 
+#include <absl/strings/str_cat.h>
 #include <absl/strings/str_join.h>
 #include <absl/strings/substitute.h>
 #include <google/protobuf/text_format.h>
@@ -85,6 +86,8 @@ std::unique_ptr<Operator> Operator::FromProto(const planpb::Operator& pb, int64_
       return CreateOperator<EmptySourceOperator>(id, pb.empty_source_op());
     case planpb::OTEL_EXPORT_SINK_OPERATOR:
       return CreateOperator<OTelExportSinkOperator>(id, pb.otel_sink_op());
+    case planpb::SORT_OPERATOR:
+      return CreateOperator<SortOperator>(id, pb.sort_op());
     default:
       LOG(FATAL) << absl::Substitute("Unknown operator type: $0",
                                      magic_enum::enum_name(pb.op_type()));
@@ -221,6 +224,15 @@ Status AggregateOperator::Init(const planpb::AggregateOperator& pb) {
   for (int idx = 0; idx < pb_.groups_size(); ++idx) {
     groups_.emplace_back(GroupInfo{pb_.group_names(idx), pb_.groups(idx).index()});
   }
+  if (time_windowed()) {
+    const auto& window = time_window();
+    if (window.slide_ns() <= 0 || window.window_ns() < window.slide_ns() ||
+        window.window_ns() % window.slide_ns() != 0) {
+      return error::InvalidArgument(
+          "Time window of $0ns must be a positive multiple of its slide of $1ns",
+          window.window_ns(), window.slide_ns());
+    }
+  }
 
   is_initialized_ = true;
   return Status::OK();
@@ -230,17 +242,36 @@ StatusOr<table_store::schema::Relation> AggregateOperator::OutputRelation(
     const table_store::schema::Schema& schema, const PlanState& state,
     const std::vector<int64_t>& input_ids) const {
   DCHECK(is_initialized_) << "Not initialized";
-  if (input_ids.size() != 1) {
+  // The time windowed aggregate that merges partial aggregates reads each agent as an input.
+  bool multiple_inputs = time_windowed() && !partial_agg();
+  if (input_ids.empty() || (!multiple_inputs && input_ids.size() != 1)) {
     return error::InvalidArgument("BlockingAgg operator must have exactly one input");
   }
-  if (!schema.HasRelation(input_ids[0])) {
-    return error::NotFound("Missing relation ($0) for input of BlockingAggregateOperator",
-                           input_ids[0]);
+  for (int64_t input_id : input_ids) {
+    if (!schema.HasRelation(input_id)) {
+      return error::NotFound("Missing relation ($0) for input of BlockingAggregateOperator",
+                             input_id);
+    }
   }
 
   PX_ASSIGN_OR_RETURN(const auto& input_relation, schema.GetRelation(input_ids[0]));
+  for (int64_t input_id : input_ids) {
+    PX_ASSIGN_OR_RETURN(const auto& relation, schema.GetRelation(input_id));
+    if (relation.col_types() != input_relation.col_types()) {
+      return error::InvalidArgument("BlockingAgg operator inputs must have the same relation");
+    }
+  }
   table_store::schema::Relation output_relation;
 
+  if (time_windowed()) {
+    int64_t time_col_idx = time_window().time_column().index();
+    if (time_col_idx >= static_cast<int64_t>(input_relation.NumColumns()) ||
+        input_relation.GetColumnType(time_col_idx) != types::TIME64NS) {
+      return error::InvalidArgument("Time window column $0 must be a time column", time_col_idx);
+    }
+    output_relation.AddColumn(types::TIME64NS, time_window().window_start_name());
+  }
+
   for (int idx = 0; idx < pb_.groups_size(); ++idx) {
     int64_t node_id = pb_.groups(idx).node();
     int64_t col_idx = pb_.groups(idx).index();
@@ -454,6 +485,77 @@ StatusOr<table_store::schema::Relation> LimitOperator::OutputRelation(
   return output_relation;
 }
 
+/**
+ * Sort Operator Implementation.
+ */
+std::string SortOperator::DebugString() const {
+  std::vector<std::string> sort_columns;
+  for (const auto& col : sort_columns_) {
+    sort_columns.push_back(absl::StrCat(col.index, col.descending ? " desc" : ""));
+  }
+  return absl::Substitute("Op:Sort(by: [$0], limit: $1, cols: [$2])",
+                          absl::StrJoin(sort_columns, ","), limit_,
+                          absl::StrJoin(selected_cols_, ","));
+}
+
+Status SortOperator::Init(const planpb::SortOperator& pb) {
+  pb_ = pb;
+  limit_ = pb_.limit();
+  if (pb_.sort_columns_size() == 0) {
+    return error::InvalidArgument("Sort operator must have at least one sort column");
+  }
+  if (limit_ < 0) {
+    return error::InvalidArgument("Sort operator limit must not be negative, got $0", limit_);
+  }
+
+  sort_columns_.reserve(pb_.sort_columns_size());
+  for (const auto& col : pb_.sort_columns()) {
+    sort_columns_.push_back({col.index(), col.descending()});
+  }
+  selected_cols_.reserve(pb_.columns_size());
+  for (const auto& col : pb_.columns()) {
+    selected_cols_.push_back(col.index());
+  }
+
+  is_initialized_ = true;
+  return Status::OK();
+}
+
+StatusOr<table_store::schema::Relation> SortOperator::OutputRelation(
+    const table_store::schema::Schema& schema, const PlanState& /*state*/,
+    const std::vector<int64_t>& input_ids) const {
+  DCHECK(is_initialized_) << "Not initialized";
+
+  if (input_ids.size() != 1) {
+    return error::InvalidArgument("Sort operator must have exactly one input");
+  }
+  if (!schema.HasRelation(input_ids[0])) {
+    return error::NotFound("Missing relation ($0) for input of SortOperator", input_ids[0]);
+  }
+
+  PX_ASSIGN_OR_RETURN(const table_store::schema::Relation& input_relation,
+                      schema.GetRelation(input_ids[0]));
+  auto num_input_cols = static_cast<int64_t>(input_relation.NumColumns());
+  for (const auto& col : sort_columns_) {
+    if (col.index < 0 || col.index >= num_input_cols) {
+      return error::InvalidArgument(
+          "Sort column index $0 is out of bounds, number of columns is $1", col.index,
+          num_input_cols);
+    }
+  }
+  table_store::schema::Relation output_relation;
+  for (auto selected_col_idx : selected_cols_) {
+    if (selected_col_idx < 0 || selected_col_idx >= num_input_cols) {
+      return error::InvalidArgument("Column index $0 is out of bounds, number of columns is $1",
+                                    selected_col_idx, num_input_cols);
+    }
+    output_relation.AddColumn(input_relation.GetColumnType(selected_col_idx),
+                              input_relation.GetColumnName(selected_col_idx),
+                              input_relation.GetColumnDesc(selected_col_idx));
+  }
+  return output_relation;
+}
+
 /**
  * Zip Operator Implementation.
  */
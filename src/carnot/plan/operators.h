@@ -97,6 +97,10 @@ class MemorySourceOperator : public Operator {
   std::vector<int64_t> Columns() const { return column_idxs_; }
   const types::TabletID& Tablet() const { return pb_.tablet(); }
   bool streaming() const { return pb_.streaming(); }
+  const google::protobuf::RepeatedPtrField<planpb::MemorySourceOperator::Predicate>& predicates()
+      const {
+    return pb_.predicates();
+  }
 
  private:
   planpb::MemorySourceOperator pb_;
@@ -146,6 +150,9 @@ class AggregateOperator : public Operator {
   bool windowed() const { return pb_.windowed(); }
   bool partial_agg() const { return pb_.partial_agg(); }
   bool finalize_results() const { return pb_.finalize_results(); }
+  bool time_windowed() const { return pb_.has_time_window(); }
+  const planpb::AggregateOperator::TimeWindow& time_window() const { return pb_.time_window(); }
+  const planpb::AggregateOperator& pb() const { return pb_; }
 
  private:
   std::vector<std::shared_ptr<AggregateExpression>> values_;
@@ -217,6 +224,8 @@ class GRPCSinkOperator : public Operator {
   }
   std::string table_name() const { return pb_.output_table().table_name(); }
 
+  planpb::RowBatchEncoding row_batch_encoding() const { return pb_.row_batch_encoding(); }
+
  private:
   planpb::GRPCSinkOperator pb_;
 };
@@ -264,6 +273,33 @@ class LimitOperator : public Operator {
   planpb::LimitOperator pb_;
 };
 
+class SortOperator : public Operator {
+ public:
+  explicit SortOperator(int64_t id) : Operator(id, planpb::SORT_OPERATOR) {}
+  ~SortOperator() override = default;
+
+  StatusOr<table_store::schema::Relation> OutputRelation(
+      const table_store::schema::Schema& schema, const PlanState& state,
+      const std::vector<int64_t>& input_ids) const override;
+  Status Init(const planpb::SortOperator& pb);
+  std::string DebugString() const override;
+
+  struct SortColumn {
+    int64_t index;
+    bool descending;
+  };
+  const std::vector<SortColumn>& sort_columns() const { return sort_columns_; }
+  const std::vector<int64_t>& selected_cols() const { return selected_cols_; }
+  // The number of rows to output, 0 if all of them are.
+  int64_t limit() const { return limit_; }
+
+ private:
+  std::vector<SortColumn> sort_columns_;
+  std::vector<int64_t> selected_cols_;
+  int64_t limit_ = 0;
+  planpb::SortOperator pb_;
+};
+
 class UnionOperator : public Operator {
  public:
   explicit UnionOperator(int64_t id) : Operator(id, planpb::UNION_OPERATOR) {}
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/plan_cache.h"
+
+#include <functional>
+#include <string>
+
+#include <absl/strings/ascii.h>
+#include <absl/strings/str_cat.h>
+
+DEFINE_int64(carnot_plan_cache_size, gflags::Int64FromEnv("PL_CARNOT_PLAN_CACHE_SIZE", 128),
+             "The number of compiled query plans that Carnot keeps. 0 disables the plan cache.");
+
+namespace px {
+namespace carnot {
+
+std::string PlanCache::NormalizeQuery(std::string_view query) {
+  std::string out;
+  out.reserve(query.size());
+  // The whitespace and newlines since the last character that is kept for sure. They are only
+  // written out if more of the query follows on the same line or a later one.
+  std::string pending;
+  // The quotes that close the string literal being scanned, if any.
+  std::string_view literal_end;
+  bool in_comment = false;
+
+  for (size_t i = 0; i < query.size(); ++i) {
+    const char c = query[i];
+    if (!literal_end.empty()) {
+      out.push_back(c);
+      if (c == '\\' && i + 1 < query.size()) {
+        out.push_back(query[++i]);
+      } else if (query.substr(i, literal_end.size()) == literal_end) {
+        out.append(literal_end.substr(1));
+        i += literal_end.size() - 1;
+        literal_end = {};
+      } else if (c == '\n' && literal_end.size() == 1) {
+        // An unterminated single line literal, let the compiler report it.
+        literal_end = {};
+      }
+      continue;
+    }
+    if (c == '\n') {
+      in_comment = false;
+      pending.erase(pending.find_last_not_of(" \t\r\f\v") + 1);
+      pending.push_back(c);
+      continue;
+    }
+    if (absl::ascii_isspace(static_cast<unsigned char>(c))) {
+      pending.push_back(c);
+      continue;
+    }
+    if (out.empty()) {
+      // Drop the leading blank lines, but keep the indentation of the first line.
+      size_t last_newline = pending.rfind('\n');
+      if (last_newline != std::string::npos) {
+        pending.erase(0, last_newline + 1);
+      }
+    }
+    out.append(pending);
+    pending.clear();
+    out.push_back(c);
+
+    if (in_comment) {
+      continue;
+    }
+    if (c == '#') {
+      in_comment = true;
+    } else if (c == '"' || c == '\'') {
+      std::string_view quotes = query.substr(i, 3);
+      literal_end = quotes == "\"\"\"" || quotes == "'''" ? quotes : query.substr(i, 1);
+      out.append(literal_end.substr(1));
+      i += literal_end.size() - 1;
+    }
+  }
+  return out;
+}
+
+size_t PlanCache::RelationMapFingerprint(
+    const table_store::TableStore::RelationMap& relation_map) {
+  size_t fingerprint = 0;
+  for (const auto& [name, relation] : relation_map) {
+    // The sum doesn't depend on the iteration order of the map.
+    fingerprint += std::hash<std::string>{}(absl::StrCat(name, ":", relation.DebugString()));
+  }
+  return fingerprint;
+}
+
+std::string PlanCache::Key(std::string_view query,
+                           const table_store::TableStore::RelationMap& relation_map) const {
+  return absl::StrCat(RelationMapFingerprint(relation_map), ":", NormalizeQuery(query));
+}
+
+void PlanCache::ShiftRelativeTimes(int64_t shift_ns, planpb::Plan* plan) {
+  for (auto& fragment : *plan->mutable_nodes()) {
+    for (auto& node : *fragment.mutable_nodes()) {
+      if (!node.op().has_mem_source_op()) {
+        continue;
+      }
+      auto* mem_source = node.mutable_op()->mutable_mem_source_op();
+      if (mem_source->start_time_relative()) {
+        auto* start_time = mem_source->mutable_start_time();
+        start_time->set_value(start_time->value() + shift_ns);
+      }
+      if (mem_source->stop_time_relative()) {
+        auto* stop_time = mem_source->mutable_stop_time();
+        stop_time->set_value(stop_time->value() + shift_ns);
+      }
+    }
+  }
+}
+
+std::shared_ptr<const planpb::Plan> PlanCache::Get(const std::string& key, int64_t time_now) {
+  CachedPlan cached;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      ++stats_.misses;
+      return nullptr;
+    }
+    ++stats_.hits;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    cached = it->second->second;
+  }
+  if (cached.time_now == time_now) {
+    return cached.plan;
+  }
+  // Bind the copy outside of the lock, the cached plan itself is never modified.
+  auto plan = std::make_shared<planpb::Plan>(*cached.plan);
+  ShiftRelativeTimes(time_now - cached.time_now, plan.get());
+  return plan;
+}
+
+void PlanCache::Put(const std::string& key, std::shared_ptr<const planpb::Plan> plan,
+                    int64_t time_now) {
+  if (!enabled()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    it->second->second = CachedPlan{std::move(plan), time_now};
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+  lru_.emplace_front(key, CachedPlan{std::move(plan), time_now});
+  entries_[key] = lru_.begin();
+  while (static_cast<int64_t>(lru_.size()) > capacity_) {
+    entries_.erase(lru_.back().first);
+    lru_.pop_back();
+    ++stats_.evictions;
+  }
+}
+
+PlanCache::Stats PlanCache::stats() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return stats_;
+}
+
+size_t PlanCache::size() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return lru_.size();
+}
+
+}  // namespace carnot
+}  // namespace px
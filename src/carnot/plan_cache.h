@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "src/carnot/planpb/plan.pb.h"
+#include "src/common/base/base.h"
+#include "src/table_store/table/table_store.h"
+
+DECLARE_int64(carnot_plan_cache_size);
+
+namespace px {
+namespace carnot {
+
+/**
+ * PlanCache keeps the compiled plans of the most recently executed queries, so that the scripts
+ * that are refreshed every few seconds aren't compiled again on each refresh.
+ *
+ * The plans are keyed by the normalized query and the schema of the tables they were compiled
+ * against. The relative start and stop times of the memory sources (e.g. "-5m") are parameters of
+ * the plan: a hit gets them shifted to the time_now of the query. Plans that use time_now in any
+ * other way (px.now(), px.parse_time("-5m")) must not be cached.
+ *
+ * Only the plan is cached: each query still builds its own execution graph from it.
+ */
+class PlanCache : public NotCopyable {
+ public:
+  struct Stats {
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t evictions = 0;
+  };
+
+  /**
+   * @param capacity the number of plans that are kept. 0 disables the cache.
+   */
+  explicit PlanCache(int64_t capacity) : capacity_(capacity) {}
+
+  bool enabled() const { return capacity_ > 0; }
+
+  /**
+   * Returns the key of the query in the cache.
+   */
+  std::string Key(std::string_view query,
+                  const table_store::TableStore::RelationMap& relation_map) const;
+
+  /**
+   * Returns the plan that was cached for the key, with its relative times bound to time_now, or
+   * nullptr if there isn't one.
+   */
+  std::shared_ptr<const planpb::Plan> Get(const std::string& key, int64_t time_now);
+
+  /**
+   * Adds the plan of the key, compiled at time_now, evicting the least recently used plan if the
+   * cache is full.
+   */
+  void Put(const std::string& key, std::shared_ptr<const planpb::Plan> plan, int64_t time_now);
+
+  Stats stats() const;
+  size_t size() const;
+
+  // Strips the whitespace that doesn't change the meaning of a query: trailing whitespace and
+  // leading and trailing blank lines. Indentation and string literals, including multi-line ones,
+  // are kept as is.
+  static std::string NormalizeQuery(std::string_view query);
+  // A hash of the table names and relations, which doesn't depend on the order of the map.
+  static size_t RelationMapFingerprint(const table_store::TableStore::RelationMap& relation_map);
+  // Shifts the relative start and stop times of the memory sources of the plan by shift_ns.
+  static void ShiftRelativeTimes(int64_t shift_ns, planpb::Plan* plan);
+
+ private:
+  struct CachedPlan {
+    std::shared_ptr<const planpb::Plan> plan;
+    // The time_now that the relative times of the plan were resolved against.
+    int64_t time_now;
+  };
+  using LRUList = std::list<std::pair<std::string, CachedPlan>>;
+
+  const int64_t capacity_;
+
+  mutable std::mutex mu_;
+  // The cached plans, most recently used first.
+  LRUList lru_;
+  absl::flat_hash_map<std::string, LRUList::iterator> entries_;
+  Stats stats_;
+};
+
+}  // namespace carnot
+}  // namespace px
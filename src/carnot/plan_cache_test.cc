@@ -0,0 +1,120 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/plan_cache.h"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace carnot {
+
+using table_store::TableStore;
+using table_store::schema::Relation;
+
+std::shared_ptr<const planpb::Plan> PlanWithID(int64_t id) {
+  auto plan = std::make_shared<planpb::Plan>();
+  plan->add_nodes()->set_id(id);
+  return plan;
+}
+
+TEST(PlanCacheTest, normalize_query) {
+  EXPECT_EQ("import px\n\ndf = px.DataFrame('t')\n  x = 1",
+            PlanCache::NormalizeQuery(
+                "\n  \nimport px  \n\ndf = px.DataFrame('t')\t\n  x = 1\n\n"));
+}
+
+TEST(PlanCacheTest, normalize_query_keeps_literals) {
+  // Whitespace inside string literals is part of the query, quotes in comments don't start one.
+  EXPECT_EQ("s = \"\"\"a  \n  b \n\"\"\"\nt = 'x  ' # it's\nu = \"\\\"  \"",
+            PlanCache::NormalizeQuery(
+                "s = \"\"\"a  \n  b \n\"\"\"  \nt = 'x  ' # it's  \nu = \"\\\"  \"  \n"));
+  EXPECT_NE(PlanCache::NormalizeQuery("s = '''a  \nb'''"),
+            PlanCache::NormalizeQuery("s = '''a\nb'''"));
+}
+
+TEST(PlanCacheTest, key) {
+  TableStore::RelationMap relations;
+  relations.emplace("a", Relation({types::INT64}, {"x"}));
+  PlanCache cache(10);
+
+  std::string key = cache.Key("import px\n", relations);
+  // Whitespace changes share a plan.
+  EXPECT_EQ(key, cache.Key("\nimport px  \n", relations));
+  EXPECT_NE(key, cache.Key("import  px\n", relations));
+
+  relations.emplace("b", Relation({types::STRING}, {"y"}));
+  EXPECT_NE(key, cache.Key("import px\n", relations));
+}
+
+TEST(PlanCacheTest, lru_eviction) {
+  PlanCache cache(2);
+  cache.Put("a", PlanWithID(1), 0);
+  cache.Put("b", PlanWithID(2), 0);
+  // Looking up "a" makes "b" the least recently used plan.
+  ASSERT_NE(nullptr, cache.Get("a", 0));
+  cache.Put("c", PlanWithID(3), 0);
+
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(nullptr, cache.Get("b", 0));
+  auto plan = cache.Get("a", 0);
+  ASSERT_NE(nullptr, plan);
+  EXPECT_EQ(1, plan->nodes(0).id());
+  EXPECT_NE(nullptr, cache.Get("c", 0));
+
+  auto stats = cache.stats();
+  EXPECT_EQ(3, stats.hits);
+  EXPECT_EQ(1, stats.misses);
+  EXPECT_EQ(1, stats.evictions);
+}
+
+TEST(PlanCacheTest, disabled) {
+  PlanCache cache(0);
+  EXPECT_FALSE(cache.enabled());
+  cache.Put("a", PlanWithID(1), 0);
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(nullptr, cache.Get("a", 0));
+}
+
+TEST(PlanCacheTest, binds_relative_times) {
+  auto plan = std::make_shared<planpb::Plan>();
+  auto* mem_source = plan->add_nodes()->add_nodes()->mutable_op()->mutable_mem_source_op();
+  // A DataFrame from "-5" to an absolute stop time, compiled at time 100.
+  mem_source->mutable_start_time()->set_value(95);
+  mem_source->set_start_time_relative(true);
+  mem_source->mutable_stop_time()->set_value(1000);
+
+  PlanCache cache(10);
+  cache.Put("a", plan, 100);
+  EXPECT_EQ(plan, cache.Get("a", 100));
+
+  auto later_plan = cache.Get("a", 130);
+  ASSERT_NE(nullptr, later_plan);
+  const auto& later_mem_source = later_plan->nodes(0).nodes(0).op().mem_source_op();
+  EXPECT_EQ(125, later_mem_source.start_time().value());
+  EXPECT_EQ(1000, later_mem_source.stop_time().value());
+  // The cached plan is left as is.
+  EXPECT_EQ(95, cache.Get("a", 100)->nodes(0).nodes(0).op().mem_source_op().start_time().value());
+}
+
+}  // namespace carnot
+}  // namespace px
@@ -28,6 +28,7 @@
 #include "src/carnot/planner/compiler/analyzer/convert_metadata_rule.h"
 #include "src/carnot/planner/compiler/analyzer/drop_to_map_rule.h"
 #include "src/carnot/planner/compiler/analyzer/merge_group_by_into_group_acceptor_rule.h"
+#include "src/carnot/planner/compiler/analyzer/merge_rolling_into_blocking_agg_rule.h"
 #include "src/carnot/planner/compiler/analyzer/nested_blocking_agg_fn_check_rule.h"
 #include "src/carnot/planner/compiler/analyzer/propagate_expression_annotations_rule.h"
 #include "src/carnot/planner/compiler/analyzer/remove_group_by_rule.h"
@@ -70,6 +71,7 @@ class Analyzer : public RuleExecutor<IR> {
         IRNodeType::kBlockingAgg);
     source_and_metadata_resolution_batch->AddRule<MergeGroupByIntoGroupAcceptorRule>(
         IRNodeType::kRolling);
+    source_and_metadata_resolution_batch->AddRule<MergeRollingIntoBlockingAggRule>();
     source_and_metadata_resolution_batch->AddRule<NestedBlockingAggFnCheckRule>();
     source_and_metadata_resolution_batch->AddRule<ResolveStreamRule>();
   }
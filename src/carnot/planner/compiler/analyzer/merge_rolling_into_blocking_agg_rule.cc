@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <vector>
+
+#include "src/carnot/planner/compiler/analyzer/merge_rolling_into_blocking_agg_rule.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+StatusOr<bool> MergeRollingIntoBlockingAggRule::Apply(IRNode* ir_node) {
+  if (Match(ir_node, Rolling())) {
+    return MergeRolling(static_cast<RollingIR*>(ir_node));
+  }
+  return false;
+}
+
+StatusOr<bool> MergeRollingIntoBlockingAggRule::MergeRolling(RollingIR* rolling) {
+  std::vector<OperatorIR*> children = rolling->Children();
+  if (children.empty()) {
+    return false;
+  }
+  for (OperatorIR* child : children) {
+    if (!Match(child, BlockingAgg())) {
+      return rolling->CreateIRNodeError("'rolling()' should be followed by an 'agg()' not a $0",
+                                        child->type_string());
+    }
+  }
+  for (OperatorIR* child : children) {
+    PX_RETURN_IF_ERROR(MergeRollingIntoAgg(rolling, static_cast<BlockingAggIR*>(child)));
+  }
+
+  auto graph = rolling->graph();
+  auto rolling_id = rolling->id();
+  auto rolling_children = graph->dag().DependenciesOf(rolling_id);
+  PX_RETURN_IF_ERROR(graph->DeleteNode(rolling_id));
+  for (const auto& child_id : rolling_children) {
+    PX_RETURN_IF_ERROR(graph->DeleteOrphansInSubtree(child_id));
+  }
+  return true;
+}
+
+Status MergeRollingIntoBlockingAggRule::MergeRollingIntoAgg(RollingIR* rolling,
+                                                            BlockingAggIR* agg) {
+  IR* graph = rolling->graph();
+  std::vector<ColumnIR*> new_groups(agg->groups());
+  for (ColumnIR* g : rolling->groups()) {
+    ColumnIR* col;
+    if (Match(g, Metadata())) {
+      PX_ASSIGN_OR_RETURN(col, graph->CreateNode<MetadataIR>(g->ast(), g->col_name(),
+                                                             g->container_op_parent_idx()));
+    } else {
+      PX_ASSIGN_OR_RETURN(col, graph->CreateNode<ColumnIR>(g->ast(), g->col_name(),
+                                                           g->container_op_parent_idx()));
+    }
+    new_groups.push_back(col);
+  }
+  PX_RETURN_IF_ERROR(agg->SetGroups(new_groups));
+
+  ColumnIR* window_col = rolling->window_col();
+  PX_ASSIGN_OR_RETURN(ColumnIR * time_col,
+                      graph->CreateNode<ColumnIR>(window_col->ast(), window_col->col_name(),
+                                                  window_col->container_op_parent_idx()));
+  // The windows start where the previous one ends, and keep the name of the window column.
+  PX_RETURN_IF_ERROR(agg->SetTimeWindow(time_col, rolling->window_size(), rolling->window_size(),
+                                        window_col->col_name()));
+
+  DCHECK_EQ(rolling->parents().size(), 1UL);
+  return agg->ReplaceParent(rolling, rolling->parents()[0]);
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
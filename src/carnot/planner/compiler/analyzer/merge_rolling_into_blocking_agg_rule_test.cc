@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/planner/compiler/analyzer/merge_group_by_into_group_acceptor_rule.h"
+#include "src/carnot/planner/compiler/analyzer/merge_rolling_into_blocking_agg_rule.h"
+#include "src/carnot/planner/compiler/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+using ::testing::ElementsAre;
+
+TEST_F(RulesTest, MergeRollingIntoBlockingAggRule) {
+  MemorySourceIR* mem_source = MakeMemSource();
+  GroupByIR* group_by = MakeGroupBy(mem_source, {MakeColumn("col1", 0), MakeColumn("col2", 0)});
+  RollingIR* rolling = MakeRolling(group_by, MakeColumn("time_", 0), 10);
+  int64_t rolling_id = rolling->id();
+  BlockingAggIR* agg =
+      MakeBlockingAgg(rolling, {}, {{"outcount", MakeMeanFunc(MakeColumn("count", 0))}});
+  MakeMemSink(agg, "");
+
+  MergeGroupByIntoGroupAcceptorRule group_by_rule(IRNodeType::kRolling);
+  ASSERT_OK(group_by_rule.Execute(graph.get()));
+  MergeRollingIntoBlockingAggRule rule;
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ConsumeValueOrDie());
+
+  EXPECT_FALSE(graph->HasNode(rolling_id));
+  EXPECT_EQ(graph->FindNodesThatMatch(Rolling()).size(), 0);
+  EXPECT_THAT(agg->parents(), ElementsAre(mem_source));
+
+  std::vector<std::string> actual_group_names;
+  for (ColumnIR* g : agg->groups()) {
+    actual_group_names.push_back(g->col_name());
+  }
+  EXPECT_THAT(actual_group_names, ElementsAre("col1", "col2"));
+
+  ASSERT_TRUE(agg->time_windowed());
+  EXPECT_EQ(agg->time_window_col()->col_name(), "time_");
+  EXPECT_THAT(agg->time_window_col()->ContainingOperators().ConsumeValueOrDie(), ElementsAre(agg));
+  EXPECT_EQ(agg->window_ns(), 10);
+  EXPECT_EQ(agg->slide_ns(), 10);
+  EXPECT_EQ(agg->window_start_name(), "time_");
+}
+
+TEST_F(RulesTest, MergeRollingIntoBlockingAggRule_FailsWithoutAgg) {
+  MemorySourceIR* mem_source = MakeMemSource();
+  RollingIR* rolling = MakeRolling(mem_source, MakeColumn("time_", 0), 10);
+  MakeMemSink(rolling, "");
+
+  MergeRollingIntoBlockingAggRule rule;
+  auto result = rule.Execute(graph.get());
+  ASSERT_NOT_OK(result);
+  EXPECT_THAT(result.status(), HasCompilerError("'rolling.*' should be followed by an 'agg.*'"));
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -2715,6 +2715,38 @@ TEST_F(CompilerTest, DISABLED_RollingCompileTimeExprEvalQuery) {
   EXPECT_THAT(*rolling->resolved_table_type(), IsTableType(rolling_relation));
 }
 
+constexpr char kRollingAggQuery[] = R"pxl(
+import px
+t1 = px.DataFrame(table='http_events', select=['time_', 'remote_port'])
+t1 = t1.groupby('remote_port').rolling('3s').agg(count=('remote_port', px.count))
+px.display(t1)
+)pxl";
+TEST_F(CompilerTest, RollingAggQuery) {
+  auto graph_or_s = compiler_.CompileToIR(kRollingAggQuery, compiler_state_.get());
+  ASSERT_OK(graph_or_s);
+  auto graph = graph_or_s.ConsumeValueOrDie();
+
+  // The rolling() is merged into the aggregate.
+  EXPECT_EQ(graph->FindNodesOfType(IRNodeType::kRolling).size(), 0);
+  std::vector<IRNode*> agg_nodes = graph->FindNodesOfType(IRNodeType::kBlockingAgg);
+  ASSERT_EQ(agg_nodes.size(), 1);
+  auto agg = static_cast<BlockingAggIR*>(agg_nodes[0]);
+  ASSERT_TRUE(agg->time_windowed());
+  Relation agg_relation({types::TIME64NS, types::INT64, types::INT64},
+                        {"time_", "remote_port", "count"});
+  EXPECT_THAT(*agg->resolved_table_type(), IsTableType(agg_relation));
+
+  planpb::Operator pb;
+  ASSERT_OK(agg->ToProto(&pb));
+  const auto& window = pb.agg_op().time_window();
+  EXPECT_EQ(window.time_column().index(), 0);
+  int64_t window_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::seconds(3)).count();
+  EXPECT_EQ(window.window_ns(), window_ns);
+  EXPECT_EQ(window.slide_ns(), window_ns);
+  EXPECT_EQ(window.window_start_name(), "time_");
+}
+
 constexpr char kRollingNonTimeColumn[] = R"pxl(
 import px
 t1 = px.DataFrame(table='cpu', select=['cpu0'])
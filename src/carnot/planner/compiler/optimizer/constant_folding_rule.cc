@@ -0,0 +1,233 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "src/carnot/planner/compiler/optimizer/constant_folding_rule.h"
+
+#include <string>
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+namespace {
+
+bool IsIntLiteral(const ExpressionIR* expr) { return Match(expr, Int()) || Match(expr, Time()); }
+
+bool IsNumericLiteral(const ExpressionIR* expr) {
+  return IsIntLiteral(expr) || Match(expr, Float());
+}
+
+int64_t IntLiteralValue(const ExpressionIR* expr) {
+  if (Match(expr, Int())) {
+    return static_cast<const IntIR*>(expr)->val();
+  }
+  return static_cast<const TimeIR*>(expr)->val();
+}
+
+double FloatLiteralValue(const ExpressionIR* expr) {
+  if (Match(expr, Float())) {
+    return static_cast<const FloatIR*>(expr)->val();
+  }
+  return static_cast<double>(IntLiteralValue(expr));
+}
+
+template <typename T>
+bool Compare(FuncIR::Opcode opcode, const T& lhs, const T& rhs) {
+  switch (opcode) {
+    case FuncIR::eq:
+      return lhs == rhs;
+    case FuncIR::neq:
+      return lhs != rhs;
+    case FuncIR::lt:
+      return lhs < rhs;
+    case FuncIR::lteq:
+      return lhs <= rhs;
+    case FuncIR::gt:
+      return lhs > rhs;
+    case FuncIR::gteq:
+      return lhs >= rhs;
+    default:
+      DCHECK(false) << "Not a comparison";
+      return false;
+  }
+}
+
+// Creates a literal of the type of func with the value of an integer expression.
+StatusOr<ExpressionIR*> MakeIntLiteral(FuncIR* func, int64_t val) {
+  switch (func->EvaluatedDataType()) {
+    case types::INT64: {
+      PX_ASSIGN_OR_RETURN(IntIR * literal, func->graph()->CreateNode<IntIR>(func->ast(), val));
+      return literal;
+    }
+    case types::TIME64NS: {
+      PX_ASSIGN_OR_RETURN(TimeIR * literal, func->graph()->CreateNode<TimeIR>(func->ast(), val));
+      return literal;
+    }
+    case types::FLOAT64: {
+      PX_ASSIGN_OR_RETURN(FloatIR * literal, func->graph()->CreateNode<FloatIR>(
+                                                 func->ast(), static_cast<double>(val)));
+      return literal;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+// Returns the literal that func evaluates to, or nullptr if it can't be folded.
+StatusOr<ExpressionIR*> FoldFunc(FuncIR* func) {
+  const auto& args = func->all_args();
+  IR* graph = func->graph();
+  switch (func->opcode()) {
+    case FuncIR::add:
+    case FuncIR::sub:
+    case FuncIR::mult: {
+      if (args.size() != 2 || !IsNumericLiteral(args[0]) || !IsNumericLiteral(args[1])) {
+        return nullptr;
+      }
+      if (IsIntLiteral(args[0]) && IsIntLiteral(args[1])) {
+        int64_t lhs = IntLiteralValue(args[0]);
+        int64_t rhs = IntLiteralValue(args[1]);
+        int64_t val;
+        bool overflow = func->opcode() == FuncIR::add   ? __builtin_add_overflow(lhs, rhs, &val)
+                        : func->opcode() == FuncIR::sub ? __builtin_sub_overflow(lhs, rhs, &val)
+                                                        : __builtin_mul_overflow(lhs, rhs, &val);
+        if (overflow) {
+          return nullptr;
+        }
+        return MakeIntLiteral(func, val);
+      }
+      if (func->EvaluatedDataType() != types::FLOAT64) {
+        return nullptr;
+      }
+      double lhs = FloatLiteralValue(args[0]);
+      double rhs = FloatLiteralValue(args[1]);
+      double val = func->opcode() == FuncIR::add   ? lhs + rhs
+                   : func->opcode() == FuncIR::sub ? lhs - rhs
+                                                   : lhs * rhs;
+      PX_ASSIGN_OR_RETURN(FloatIR * literal, graph->CreateNode<FloatIR>(func->ast(), val));
+      return literal;
+    }
+    case FuncIR::eq:
+    case FuncIR::neq:
+    case FuncIR::lt:
+    case FuncIR::lteq:
+    case FuncIR::gt:
+    case FuncIR::gteq: {
+      if (args.size() != 2) {
+        return nullptr;
+      }
+      bool val;
+      if (IsIntLiteral(args[0]) && IsIntLiteral(args[1])) {
+        val = Compare(func->opcode(), IntLiteralValue(args[0]), IntLiteralValue(args[1]));
+      } else if (IsNumericLiteral(args[0]) && IsNumericLiteral(args[1])) {
+        val = Compare(func->opcode(), FloatLiteralValue(args[0]), FloatLiteralValue(args[1]));
+      } else if (Match(args[0], String()) && Match(args[1], String())) {
+        val = Compare(func->opcode(), static_cast<StringIR*>(args[0])->str(),
+                      static_cast<StringIR*>(args[1])->str());
+      } else {
+        return nullptr;
+      }
+      PX_ASSIGN_OR_RETURN(BoolIR * literal, graph->CreateNode<BoolIR>(func->ast(), val));
+      return literal;
+    }
+    case FuncIR::logand:
+    case FuncIR::logor: {
+      if (args.size() != 2 || !Match(args[0], Bool()) || !Match(args[1], Bool())) {
+        return nullptr;
+      }
+      bool lhs = static_cast<BoolIR*>(args[0])->val();
+      bool rhs = static_cast<BoolIR*>(args[1])->val();
+      PX_ASSIGN_OR_RETURN(BoolIR * literal,
+                          graph->CreateNode<BoolIR>(func->ast(), func->opcode() == FuncIR::logand
+                                                                     ? lhs && rhs
+                                                                     : lhs || rhs));
+      return literal;
+    }
+    case FuncIR::lognot: {
+      if (args.size() != 1 || !Match(args[0], Bool())) {
+        return nullptr;
+      }
+      bool val = !static_cast<BoolIR*>(args[0])->val();
+      PX_ASSIGN_OR_RETURN(BoolIR * literal, graph->CreateNode<BoolIR>(func->ast(), val));
+      return literal;
+    }
+    case FuncIR::negate: {
+      if (args.size() != 1 || !IsNumericLiteral(args[0])) {
+        return nullptr;
+      }
+      if (IsIntLiteral(args[0])) {
+        int64_t val;
+        if (__builtin_sub_overflow(int64_t{0}, IntLiteralValue(args[0]), &val)) {
+          return nullptr;
+        }
+        return MakeIntLiteral(func, val);
+      }
+      PX_ASSIGN_OR_RETURN(FloatIR * literal,
+                          graph->CreateNode<FloatIR>(func->ast(), -FloatLiteralValue(args[0])));
+      return literal;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+StatusOr<bool> ConstantFoldingRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, Func())) {
+    return false;
+  }
+  FuncIR* func = static_cast<FuncIR*>(ir_node);
+  if (!func->is_type_resolved() || !func->IsDataTypeEvaluated()) {
+    return false;
+  }
+  IR* graph = func->graph();
+  auto parent_ids = graph->dag().ParentsOf(func->id());
+  // Only the expression containers that can swap an expression are updated.
+  for (int64_t parent_id : parent_ids) {
+    IRNode* parent = graph->Get(parent_id);
+    if (!Match(parent, Func()) && !Match(parent, Map()) && !Match(parent, Filter())) {
+      return false;
+    }
+  }
+
+  PX_ASSIGN_OR_RETURN(ExpressionIR * literal, FoldFunc(func));
+  if (literal == nullptr) {
+    return false;
+  }
+  PX_RETURN_IF_ERROR(literal->SetResolvedType(func->resolved_type()));
+
+  for (int64_t parent_id : parent_ids) {
+    IRNode* parent = graph->Get(parent_id);
+    if (Match(parent, Func())) {
+      PX_RETURN_IF_ERROR(static_cast<FuncIR*>(parent)->UpdateArg(func, literal));
+    } else if (Match(parent, Map())) {
+      PX_RETURN_IF_ERROR(static_cast<MapIR*>(parent)->UpdateColExpr(func, literal));
+    } else {
+      PX_RETURN_IF_ERROR(static_cast<FilterIR*>(parent)->SetFilterExpr(literal));
+    }
+  }
+  return true;
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
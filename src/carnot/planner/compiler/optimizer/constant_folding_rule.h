@@ -0,0 +1,51 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#pragma once
+
+#include "src/carnot/planner/rules/rules.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+/**
+ * @brief This rule replaces operator expressions whose arguments are all literals with the
+ * literal they evaluate to, so that they aren't expanded into a full column in every row batch:
+ *
+ * df = df[df.time_ > px.now() - px.parse_duration('5m')]
+ *
+ * becomes a comparison against a single time literal. Only arithmetic, comparisons and logical
+ * operators are folded, UDFs may depend on the state of the agent that runs them. Divisions and
+ * expressions that would overflow are left for Carnot to evaluate.
+ */
+class ConstantFoldingRule : public Rule {
+ public:
+  ConstantFoldingRule()
+      : Rule(nullptr, /*use_topo*/ true, /*reverse_topological_execution*/ true) {}
+
+ protected:
+  StatusOr<bool> Apply(IRNode* ir_node) override;
+};
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
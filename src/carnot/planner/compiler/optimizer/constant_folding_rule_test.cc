@@ -0,0 +1,97 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/planner/compiler/analyzer/resolve_types_rule.h"
+#include "src/carnot/planner/compiler/optimizer/constant_folding_rule.h"
+#include "src/carnot/planner/compiler/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+using ConstantFoldingRuleTest = RulesTest;
+
+TEST_F(ConstantFoldingRuleTest, nested_time_arithmetic) {
+  MemorySourceIR* mem_src = MakeMemSource(MakeRelation());
+  compiler_state_->relation_map()->emplace("table", MakeRelation());
+  // px.now() - 2 * 5
+  MapIR* map =
+      MakeMap(mem_src, {{"t", MakeSubFunc(MakeTime(1000), MakeMultFunc(MakeInt(2), MakeInt(5)))}});
+  MakeMemSink(map, "");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  ConstantFoldingRule rule;
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ConsumeValueOrDie());
+
+  ASSERT_EQ(1, map->col_exprs().size());
+  ExpressionIR* expr = map->col_exprs()[0].node;
+  ASSERT_MATCH(expr, Time());
+  EXPECT_EQ(990, static_cast<TimeIR*>(expr)->val());
+  EXPECT_EQ(types::TIME64NS, expr->EvaluatedDataType());
+}
+
+TEST_F(ConstantFoldingRuleTest, filter_comparison) {
+  MemorySourceIR* mem_src = MakeMemSource(MakeRelation());
+  compiler_state_->relation_map()->emplace("table", MakeRelation());
+  auto eq_func = MakeEqualsFunc(MakeColumn("count", 0), MakeAddFunc(MakeInt(1), MakeInt(2)));
+  FilterIR* filter = MakeFilter(mem_src, eq_func);
+  MakeMemSink(filter, "");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  ConstantFoldingRule rule;
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ConsumeValueOrDie());
+
+  // The column side of the comparison stays.
+  EXPECT_MATCH(filter->filter_expr(), Equals(ColumnNode("count"), Int(3)));
+}
+
+TEST_F(ConstantFoldingRuleTest, no_fold) {
+  MemorySourceIR* mem_src = MakeMemSource(MakeRelation());
+  compiler_state_->relation_map()->emplace("table", MakeRelation());
+  auto max_int = MakeInt(std::numeric_limits<int64_t>::max());
+  MapIR* map = MakeMap(mem_src, {{"col", MakeAddFunc(MakeColumn("count", 0), MakeInt(1))},
+                                 {"overflow", MakeMultFunc(max_int, MakeInt(2))}});
+  MakeMemSink(map, "");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  ConstantFoldingRule rule;
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ConsumeValueOrDie());
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "src/carnot/planner/compiler/optimizer/memory_source_predicate_pushdown_rule.h"
+
+#include <utility>
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+using PredicatePB = planpb::MemorySourceOperator::Predicate;
+
+namespace {
+
+// Returns the predicate op of a comparison opcode, optionally with its operands swapped.
+std::optional<PredicatePB::Op> ComparisonOp(FuncIR::Opcode opcode, bool swap_operands) {
+  switch (opcode) {
+    case FuncIR::Opcode::eq:
+      return PredicatePB::EQUAL;
+    case FuncIR::Opcode::neq:
+      return PredicatePB::NOT_EQUAL;
+    case FuncIR::Opcode::lt:
+      return swap_operands ? PredicatePB::GREATER_THAN : PredicatePB::LESS_THAN;
+    case FuncIR::Opcode::lteq:
+      return swap_operands ? PredicatePB::GREATER_THAN_EQUAL : PredicatePB::LESS_THAN_EQUAL;
+    case FuncIR::Opcode::gt:
+      return swap_operands ? PredicatePB::LESS_THAN : PredicatePB::GREATER_THAN;
+    case FuncIR::Opcode::gteq:
+      return swap_operands ? PredicatePB::LESS_THAN_EQUAL : PredicatePB::GREATER_THAN_EQUAL;
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
+
+std::optional<MemorySourceIR::Predicate> MemorySourcePredicatePushdownRule::ComparisonToPredicate(
+    FuncIR* func) {
+  if (func->all_args().size() != 2) {
+    return std::nullopt;
+  }
+  ExpressionIR* lhs = func->all_args()[0];
+  ExpressionIR* rhs = func->all_args()[1];
+  bool swap_operands = false;
+  if (lhs->IsData() && rhs->IsColumn()) {
+    std::swap(lhs, rhs);
+    swap_operands = true;
+  }
+  if (!lhs->IsColumn() || !rhs->IsData()) {
+    return std::nullopt;
+  }
+  auto op = ComparisonOp(func->opcode(), swap_operands);
+  if (!op.has_value()) {
+    return std::nullopt;
+  }
+  auto col = static_cast<ColumnIR*>(lhs);
+  auto data = static_cast<DataIR*>(rhs);
+  // The table store compares values of the same type only.
+  if (!col->IsDataTypeEvaluated() || col->EvaluatedDataType() != data->EvaluatedDataType()) {
+    return std::nullopt;
+  }
+  MemorySourceIR::Predicate predicate;
+  predicate.column_name = col->col_name();
+  predicate.op = op.value();
+  if (!data->ToProto(&predicate.value).ok()) {
+    return std::nullopt;
+  }
+  return predicate;
+}
+
+void MemorySourcePredicatePushdownRule::CollectPredicates(
+    ExpressionIR* expr, std::vector<MemorySourceIR::Predicate>* predicates) {
+  if (!Match(expr, Func())) {
+    return;
+  }
+  auto func = static_cast<FuncIR*>(expr);
+  if (func->opcode() == FuncIR::Opcode::logand) {
+    // Every row the filter keeps matches each term of a conjunction, so the terms that can't be
+    // pushed down are simply left out.
+    for (ExpressionIR* arg : func->all_args()) {
+      CollectPredicates(arg, predicates);
+    }
+    return;
+  }
+  auto predicate = ComparisonToPredicate(func);
+  if (predicate.has_value()) {
+    predicates->push_back(std::move(predicate.value()));
+  }
+}
+
+StatusOr<bool> MemorySourcePredicatePushdownRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, Filter())) {
+    return false;
+  }
+  auto filter = static_cast<FilterIR*>(ir_node);
+  if (filter->parents().size() != 1 || !Match(filter->parents()[0], MemorySource())) {
+    return false;
+  }
+  auto mem_src = static_cast<MemorySourceIR*>(filter->parents()[0]);
+  // Any other child of the source would miss the rows of the skipped batches.
+  if (mem_src->Children().size() != 1 || !mem_src->predicates().empty()) {
+    return false;
+  }
+
+  std::vector<MemorySourceIR::Predicate> predicates;
+  CollectPredicates(filter->filter_expr(), &predicates);
+  for (auto& predicate : predicates) {
+    mem_src->AddPredicate(std::move(predicate));
+  }
+  return !predicates.empty();
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "src/carnot/planner/rules/rules.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+/**
+ * @brief This rule copies the simple predicates of a filter that directly follows a memory source
+ * into that memory source, so that it can skip the table batches that can't match them:
+ *
+ * df = px.DataFrame('http_events')
+ * df = df[df.resp_status >= 500 and df.req_path == '/foo']
+ *
+ * Only comparisons between a column and a literal are copied, and only the terms of a top-level
+ * conjunction. The filter itself is left in place, since the memory source doesn't filter rows.
+ */
+class MemorySourcePredicatePushdownRule : public Rule {
+ public:
+  MemorySourcePredicatePushdownRule()
+      : Rule(nullptr, /*use_topo*/ false, /*reverse_topological_execution*/ false) {}
+
+ protected:
+  StatusOr<bool> Apply(IRNode* ir_node) override;
+
+ private:
+  static void CollectPredicates(ExpressionIR* expr,
+                                std::vector<MemorySourceIR::Predicate>* predicates);
+  static std::optional<MemorySourceIR::Predicate> ComparisonToPredicate(FuncIR* func);
+};
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
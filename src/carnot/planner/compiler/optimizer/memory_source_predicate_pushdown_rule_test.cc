@@ -0,0 +1,113 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/planner/compiler/analyzer/analyzer.h"
+#include "src/carnot/planner/compiler/optimizer/memory_source_predicate_pushdown_rule.h"
+#include "src/carnot/planner/compiler/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace compiler {
+
+using MemorySourcePredicatePushdownRuleTest = RulesTest;
+
+TEST_F(MemorySourcePredicatePushdownRuleTest, conjunction_of_comparisons) {
+  compiler_state_->relation_map()->emplace("table", MakeRelation());
+  MemorySourceIR* mem_src = MakeMemSource("table", MakeRelation(), {"cpu1", "cpu2", "count"});
+
+  auto count_eq = MakeEqualsFunc(MakeColumn("count", 0), MakeInt(10));
+  // The literal is on the left, so this is pushed down as `cpu1 > 0.5`.
+  auto cpu1_gt = graph
+                     ->CreateNode<FuncIR>(ast, FuncIR::op_map.find("<")->second,
+                                          std::vector<ExpressionIR*>{MakeFloat(0.5),
+                                                                     MakeColumn("cpu1", 0)})
+                     .ConsumeValueOrDie();
+  // Not pushed down: the literal's type doesn't match the column's.
+  auto cpu2_eq = MakeEqualsFunc(MakeColumn("cpu2", 0), MakeInt(1));
+  auto filter = MakeFilter(mem_src, MakeAndFunc(MakeAndFunc(count_eq, cpu1_gt), cpu2_eq));
+  MakeMemSink(filter, "out");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  MemorySourcePredicatePushdownRule rule;
+  ASSERT_OK_AND_ASSIGN(bool changed, rule.Execute(graph.get()));
+  EXPECT_TRUE(changed);
+  EXPECT_TRUE(graph->HasNode(filter->id()));
+
+  ASSERT_EQ(2, mem_src->predicates().size());
+  EXPECT_EQ("count", mem_src->predicates()[0].column_name);
+  EXPECT_EQ(planpb::MemorySourceOperator::Predicate::EQUAL, mem_src->predicates()[0].op);
+  EXPECT_EQ(10, mem_src->predicates()[0].value.int64_value());
+  EXPECT_EQ("cpu1", mem_src->predicates()[1].column_name);
+  EXPECT_EQ(planpb::MemorySourceOperator::Predicate::GREATER_THAN, mem_src->predicates()[1].op);
+  EXPECT_EQ(0.5, mem_src->predicates()[1].value.float64_value());
+
+  // Predicates refer to columns by their index in the table.
+  planpb::Operator op;
+  ASSERT_OK(mem_src->ToProto(&op));
+  ASSERT_EQ(2, op.mem_source_op().predicates_size());
+  EXPECT_EQ(0, op.mem_source_op().predicates(0).column_idx());
+  EXPECT_EQ(2, op.mem_source_op().predicates(1).column_idx());
+}
+
+TEST_F(MemorySourcePredicatePushdownRuleTest, ignores_disjunction) {
+  compiler_state_->relation_map()->emplace("table", MakeRelation());
+  MemorySourceIR* mem_src = MakeMemSource(MakeRelation());
+
+  auto filter = MakeFilter(mem_src, MakeOrFunc(MakeEqualsFunc(MakeColumn("count", 0), MakeInt(1)),
+                                               MakeEqualsFunc(MakeColumn("count", 0), MakeInt(2))));
+  MakeMemSink(filter, "out");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  MemorySourcePredicatePushdownRule rule;
+  ASSERT_OK_AND_ASSIGN(bool changed, rule.Execute(graph.get()));
+  EXPECT_FALSE(changed);
+  EXPECT_TRUE(mem_src->predicates().empty());
+}
+
+TEST_F(MemorySourcePredicatePushdownRuleTest, ignores_shared_source) {
+  compiler_state_->relation_map()->emplace("table", MakeRelation());
+  MemorySourceIR* mem_src = MakeMemSource(MakeRelation());
+
+  auto filter = MakeFilter(mem_src, MakeEqualsFunc(MakeColumn("count", 0), MakeInt(1)));
+  MakeMemSink(filter, "filtered");
+  MakeMemSink(mem_src, "all");
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  MemorySourcePredicatePushdownRule rule;
+  ASSERT_OK_AND_ASSIGN(bool changed, rule.Execute(graph.get()));
+  EXPECT_FALSE(changed);
+  EXPECT_TRUE(mem_src->predicates().empty());
+}
+
+}  // namespace compiler
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -152,6 +152,10 @@ bool MergeNodesRule::CanMerge(OperatorIR* a, OperatorIR* b) {
     if (!DoTimeIntervalsMerge(src_a, src_b)) {
       return false;
     }
+    // Predicates pushed into a source only hold for the rows that its own filter keeps.
+    if (!src_a->predicates().empty() || !src_b->predicates().empty()) {
+      return false;
+    }
 
     return src_a->table_name() == src_b->table_name();
   } else if (Match(a, Map())) {
@@ -23,6 +23,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "src/carnot/planner/compiler/optimizer/constant_folding_rule.h"
+#include "src/carnot/planner/compiler/optimizer/memory_source_predicate_pushdown_rule.h"
 #include "src/carnot/planner/compiler/optimizer/merge_nodes_rule.h"
 #include "src/carnot/planner/compiler/optimizer/prune_unconnected_operators_rule.h"
 #include "src/carnot/planner/compiler/optimizer/prune_unused_columns_rule.h"
@@ -68,11 +70,25 @@ class Optimizer : public RuleExecutor<IR> {
     prune_unused_columns->AddRule<PruneUnusedContainsRule>();
   }
 
+  void CreateConstantFoldingBatch() {
+    RuleBatch* constant_folding = CreateRuleBatch<TryUntilMax>("ConstantFolding", 2);
+    constant_folding->AddRule<ConstantFoldingRule>();
+  }
+
+  void CreateMemorySourcePredicatePushdownBatch() {
+    RuleBatch* predicate_pushdown = CreateRuleBatch<DoOnce>("MemorySourcePredicatePushdown");
+    predicate_pushdown->AddRule<MemorySourcePredicatePushdownRule>();
+  }
+
   Status Init() {
     CreatePruneUnconnectedOpsBatch();
     CreateMergeNodesBatch();
     CreatePruneUnusedColumnsBatch();
     CreatePruneUnusedContainsBatch();
+    // Runs before the predicate pushdown, so that folded comparisons can be pushed to sources.
+    CreateConstantFoldingBatch();
+    // Runs after MergeNodes, since a source with pushed down predicates can't be shared.
+    CreateMemorySourcePredicatePushdownBatch();
     return Status::OK();
   }
 
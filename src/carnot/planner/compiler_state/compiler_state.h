@@ -140,6 +140,10 @@ class CompilerState : public NotCopyable {
   }
   RegistryInfo* registry_info() const { return registry_info_; }
   types::Time64NSValue time_now() const { return time_now_; }
+  // Whether a value of the plan was computed from time_now, other than the relative times of the
+  // memory sources. Such a plan can't be run at another time than time_now.
+  bool time_now_in_plan() const { return time_now_in_plan_; }
+  void set_time_now_in_plan() { time_now_in_plan_ = true; }
   const std::string& result_address() const { return result_address_; }
   const std::string& result_ssl_targetname() const { return result_ssl_targetname_; }
 
@@ -181,6 +185,7 @@ class CompilerState : public NotCopyable {
   SensitiveColumnMap table_names_to_sensitive_columns_;
   RegistryInfo* registry_info_;
   types::Time64NSValue time_now_;
+  bool time_now_in_plan_ = false;
   std::map<IDRegistryKey, int64_t> udf_to_id_map_;
   std::map<IDRegistryKey, int64_t> uda_to_id_map_;
 
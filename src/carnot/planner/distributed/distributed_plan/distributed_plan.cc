@@ -23,6 +23,22 @@ namespace carnot {
 namespace planner {
 namespace distributed {
 
+// Sets the encoding of the sinks that send their row batches to other Carnot instances, so that
+// every agent of the query agrees on it.
+static void SetInternalRowBatchEncoding(planpb::RowBatchEncoding encoding, planpb::Plan* plan) {
+  for (auto& fragment : *plan->mutable_nodes()) {
+    for (auto& node : *fragment.mutable_nodes()) {
+      if (node.op().op_type() != planpb::GRPC_SINK_OPERATOR) {
+        continue;
+      }
+      auto sink = node.mutable_op()->mutable_grpc_sink_op();
+      if (sink->destination_case() == planpb::GRPCSinkOperator::kGrpcSourceId) {
+        sink->set_row_batch_encoding(encoding);
+      }
+    }
+  }
+}
+
 StatusOr<distributedpb::DistributedPlan> DistributedPlan::ToProto() const {
   distributedpb::DistributedPlan physical_plan_pb;
   auto physical_plan_dag = physical_plan_pb.mutable_dag();
@@ -36,6 +52,7 @@ StatusOr<distributedpb::DistributedPlan> DistributedPlan::ToProto() const {
     DCHECK(carnot->plan()) << absl::Substitute("$0 doesn't have a plan set.",
                                                carnot->DebugString());
     PX_ASSIGN_OR_RETURN(auto plan_proto, carnot->PlanProto());
+    SetInternalRowBatchEncoding(plan_options_.internal_row_batch_encoding(), &plan_proto);
     for (int64_t parent_i : dag_.ParentsOf(i)) {
       *(plan_proto.add_incoming_agent_ids()) = Get(parent_i)->carnot_info().agent_id();
     }
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "src/carnot/planner/distributed/grpc_source_conversion.h"
+#include "src/carnot/planner/ir/blocking_agg_ir.h"
 #include "src/carnot/planner/ir/empty_source_ir.h"
 #include "src/carnot/planner/ir/grpc_source_group_ir.h"
 #include "src/carnot/planner/ir/grpc_source_ir.h"
@@ -41,11 +42,36 @@ StatusOr<bool> GRPCSourceGroupConversionRule::Apply(IRNode* ir_node) {
   return false;
 }
 
+namespace {
+
+bool IsTimeWindowedFinalizeAgg(OperatorIR* op) {
+  return Match(op, FinalizeAgg()) && static_cast<BlockingAggIR*>(op)->time_windowed();
+}
+
+}  // namespace
+
 StatusOr<bool> GRPCSourceGroupConversionRule::ExpandGRPCSourceGroup(GRPCSourceGroupIR* group_ir) {
-  // Get the new parent.
-  PX_ASSIGN_OR_RETURN(OperatorIR * new_parent, ConvertGRPCSourceGroup(group_ir));
+  PX_ASSIGN_OR_RETURN(std::vector<OperatorIR*> sources, CreateGRPCSources(group_ir));
+  // The union is only created for the children that need it.
+  OperatorIR* union_op = nullptr;
   for (const auto child : group_ir->Children()) {
+    // Time windowed aggregates keep the progress of each agent apart, since the agents don't send
+    // their panes in order with each other, so they read every source as a separate parent.
+    if (sources.size() > 1 && IsTimeWindowedFinalizeAgg(child)) {
+      PX_RETURN_IF_ERROR(child->ReplaceParent(group_ir, sources[0]));
+      for (size_t i = 1; i < sources.size(); ++i) {
+        PX_RETURN_IF_ERROR(child->AddParent(sources[i]));
+      }
+      continue;
+    }
     // Replace the child node's parent with the new parent.
+    OperatorIR* new_parent = sources[0];
+    if (sources.size() > 1) {
+      if (union_op == nullptr) {
+        PX_ASSIGN_OR_RETURN(union_op, CreateUnion(group_ir, sources));
+      }
+      new_parent = union_op;
+    }
     PX_RETURN_IF_ERROR(child->ReplaceParent(group_ir, new_parent));
   }
   IR* graph = group_ir->graph();
@@ -68,7 +94,7 @@ Status UpdateSink(GRPCSourceIR* source, GRPCSinkIR* sink, int64_t agent_id) {
   return Status::OK();
 }
 
-StatusOr<OperatorIR*> GRPCSourceGroupConversionRule::ConvertGRPCSourceGroup(
+StatusOr<std::vector<OperatorIR*>> GRPCSourceGroupConversionRule::CreateGRPCSources(
     GRPCSourceGroupIR* group_ir) {
   auto ir_graph = group_ir->graph();
   auto sinks = group_ir->dependent_sinks();
@@ -77,14 +103,7 @@ StatusOr<OperatorIR*> GRPCSourceGroupConversionRule::ConvertGRPCSourceGroup(
     PX_ASSIGN_OR_RETURN(
         EmptySourceIR * empty_source,
         ir_graph->CreateNode<EmptySourceIR>(group_ir->ast(), group_ir->resolved_type()));
-    return empty_source;
-  }
-
-  // Don't add an unnecessary union node if there is only one sink.
-  if (sinks.size() == 1 && sinks[0].second.size() == 1) {
-    PX_ASSIGN_OR_RETURN(auto new_grpc_source, CreateGRPCSource(group_ir));
-    PX_RETURN_IF_ERROR(UpdateSink(new_grpc_source, sinks[0].first, *(sinks[0].second.begin())));
-    return new_grpc_source;
+    return std::vector<OperatorIR*>{empty_source};
   }
 
   std::vector<OperatorIR*> grpc_sources;
@@ -96,9 +115,13 @@ StatusOr<OperatorIR*> GRPCSourceGroupConversionRule::ConvertGRPCSourceGroup(
       grpc_sources.push_back(new_grpc_source);
     }
   }
+  return grpc_sources;
+}
 
+StatusOr<OperatorIR*> GRPCSourceGroupConversionRule::CreateUnion(
+    GRPCSourceGroupIR* group_ir, const std::vector<OperatorIR*>& grpc_sources) {
   PX_ASSIGN_OR_RETURN(UnionIR * union_op,
-                      ir_graph->CreateNode<UnionIR>(group_ir->ast(), grpc_sources));
+                      group_ir->graph()->CreateNode<UnionIR>(group_ir->ast(), grpc_sources));
   PX_RETURN_IF_ERROR(union_op->SetResolvedType(grpc_sources[0]->resolved_type()));
   PX_RETURN_IF_ERROR(union_op->SetDefaultColumnMapping());
   return union_op;
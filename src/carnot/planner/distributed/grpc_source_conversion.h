@@ -35,6 +35,7 @@ namespace distributed {
 class GRPCSourceGroupConversionRule : public Rule {
   /**
    * @brief GRPCSourceGroupConversionRule converts GRPCSourceGroups into a union of GRPCGroups.
+   * Time windowed aggregates that merge partial aggregates read the GRPCSources directly instead.
    */
 
  public:
@@ -55,13 +56,19 @@ class GRPCSourceGroupConversionRule : public Rule {
   StatusOr<GRPCSourceIR*> CreateGRPCSource(GRPCSourceGroupIR* group_ir);
 
   /**
-   * @brief Converts the group ir into either a single GRPCSource or a union of GRPPCSources,
-   * depending on how many sinks feed into a group.
+   * @brief Creates a GRPCSource for every sink and agent that feeds into the group ir, or an
+   * EmptySource if there are none.
    *
    * @param group_ir the group ir to feed in.
-   * @return StatusOr<OperatorIR*>: the representative node for the group_ir.
+   * @return StatusOr<std::vector<OperatorIR*>>: the sources that replace the group_ir.
    */
-  StatusOr<OperatorIR*> ConvertGRPCSourceGroup(GRPCSourceGroupIR* group_ir);
+  StatusOr<std::vector<OperatorIR*>> CreateGRPCSources(GRPCSourceGroupIR* group_ir);
+
+  /**
+   * @brief Creates the union of the GRPCSources of the group ir.
+   */
+  StatusOr<OperatorIR*> CreateUnion(GRPCSourceGroupIR* group_ir,
+                                    const std::vector<OperatorIR*>& grpc_sources);
 
   Status RemoveGRPCSourceGroup(GRPCSourceGroupIR* grpc_source_group) const;
 };
@@ -232,6 +232,45 @@ TEST_F(GRPCSourceConversionTest, multiple_grpc_source_groups) {
   EXPECT_EQ(grpc_source2->id(), grpc_sink2_destination);
 }
 
+// Time windowed aggregates that merge partial aggregates read each agent separately.
+TEST_F(GRPCSourceConversionTest, time_windowed_finalize_agg) {
+  int64_t grpc_bridge_id = 123;
+  auto grpc_source_group =
+      MakeGRPCSourceGroup(grpc_bridge_id, TableType::Create(MakeTimeRelation()));
+  grpc_source_group->SetGRPCAddress("1111");
+  auto agg =
+      MakeBlockingAgg(grpc_source_group, {}, {{"mean", MakeMeanFunc(MakeColumn("cpu0", 0))}});
+  agg->SetPartialAgg(false);
+  agg->SetFinalizeResults(true);
+  ASSERT_OK(agg->SetTimeWindow(MakeColumn("time_", 0), 10, 10, "time_"));
+  auto mem_sink = MakeMemSink(grpc_source_group, "out");
+
+  auto grpc_sink1 = MakeGRPCSink(MakeMemSource(MakeTimeRelation()), grpc_bridge_id);
+  auto grpc_sink2 = MakeGRPCSink(MakeMemSource(MakeTimeRelation()), grpc_bridge_id);
+  auto agent_id = 0;
+  EXPECT_OK(grpc_source_group->AddGRPCSink(grpc_sink1, {agent_id}));
+  EXPECT_OK(grpc_source_group->AddGRPCSink(grpc_sink2, {agent_id}));
+
+  GRPCSourceGroupConversionRule rule;
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ConsumeValueOrDie());
+
+  std::vector<int64_t> agg_parent_ids;
+  for (OperatorIR* parent : agg->parents()) {
+    ASSERT_MATCH(parent, GRPCSource());
+    agg_parent_ids.push_back(parent->id());
+  }
+  EXPECT_THAT(agg_parent_ids,
+              UnorderedElementsAreArray({grpc_sink1->agent_id_to_destination_id().at(agent_id),
+                                         grpc_sink2->agent_id_to_destination_id().at(agent_id)}));
+
+  // The other children still read the union of the sources.
+  ASSERT_EQ(mem_sink->parents().size(), 1UL);
+  ASSERT_MATCH(mem_sink->parents()[0], Union());
+  EXPECT_THAT(mem_sink->parents()[0]->parents(), UnorderedElementsAreArray(agg->parents()));
+}
+
 using MergeSameNodeGRPCBridgeRuleTest = GRPCSourceConversionTest;
 TEST_F(MergeSameNodeGRPCBridgeRuleTest, construction_test) {
   int64_t grpc_bridge_id = 123;
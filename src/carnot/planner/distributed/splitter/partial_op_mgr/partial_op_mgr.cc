@@ -44,6 +44,23 @@ StatusOr<OperatorIR*> LimitOperatorMgr::CreateMergeOperator(IR* plan, OperatorIR
   return new_limit;
 }
 
+StatusOr<OperatorIR*> TopKOperatorMgr::CreatePrepareOperator(IR* plan, OperatorIR* op) const {
+  DCHECK(Matches(op));
+  SortIR* sort = static_cast<SortIR*>(op);
+  PX_ASSIGN_OR_RETURN(SortIR * new_sort, plan->CopyNode(sort));
+  PX_RETURN_IF_ERROR(new_sort->CopyParentsFrom(sort));
+  return new_sort;
+}
+
+StatusOr<OperatorIR*> TopKOperatorMgr::CreateMergeOperator(IR* plan, OperatorIR* new_parent,
+                                                           OperatorIR* op) const {
+  DCHECK(Matches(op));
+  SortIR* sort = static_cast<SortIR*>(op);
+  PX_ASSIGN_OR_RETURN(SortIR * new_sort, plan->CopyNode(sort));
+  PX_RETURN_IF_ERROR(new_sort->AddParent(new_parent));
+  return new_sort;
+}
+
 StatusOr<OperatorIR*> AggOperatorMgr::CreatePrepareOperator(IR* plan, OperatorIR* op) const {
   DCHECK(Matches(op));
   BlockingAggIR* agg = static_cast<BlockingAggIR*>(op);
@@ -53,6 +70,11 @@ StatusOr<OperatorIR*> AggOperatorMgr::CreatePrepareOperator(IR* plan, OperatorIR
   new_agg->SetFinalizeResults(false);
 
   auto new_type = TableType::Create();
+  // Time windowed partial aggregates output the start of each pane first.
+  if (agg->time_windowed()) {
+    new_type->AddColumn(agg->window_start_name(),
+                        ValueType::Create(types::TIME64NS, types::ST_NONE));
+  }
   for (ColumnIR* group : agg->groups()) {
     DCHECK(group->is_type_resolved());
     new_type->AddColumn(group->col_name(), group->resolved_type());
@@ -80,6 +102,17 @@ StatusOr<OperatorIR*> AggOperatorMgr::CreateMergeOperator(IR* plan, OperatorIR*
 
   new_agg->SetPartialAgg(false);
   new_agg->SetFinalizeResults(true);
+  // The panes of the partial aggregates are merged by their start.
+  if (agg->time_windowed()) {
+    PX_ASSIGN_OR_RETURN(ColumnIR * pane_start_col,
+                        plan->CreateNode<ColumnIR>(agg->time_window_col()->ast(),
+                                                   agg->window_start_name(),
+                                                   /* parent_op_idx */ 0));
+    PX_RETURN_IF_ERROR(
+        pane_start_col->SetResolvedType(ValueType::Create(types::TIME64NS, types::ST_NONE)));
+    PX_RETURN_IF_ERROR(new_agg->SetTimeWindow(pane_start_col, agg->window_ns(), agg->slide_ns(),
+                                              agg->window_start_name()));
+  }
   DCHECK(Match(new_agg, FinalizeAgg()));
   return new_agg;
 }
@@ -87,6 +87,23 @@ class LimitOperatorMgr : public PartialOperatorMgr {
                                             OperatorIR* op) const override;
 };
 
+/**
+ * @brief TopKOperatorMgr manages splitting sorts with a limit. The Prepare sort keeps the top-k
+ * rows of each agent, so the Merge sort only gets k rows from each of them instead of every row.
+ */
+class TopKOperatorMgr : public PartialOperatorMgr {
+ public:
+  bool Matches(OperatorIR* op) const override {
+    if (!Match(op, Sort())) {
+      return false;
+    }
+    return static_cast<SortIR*>(op)->limit() > 0;
+  }
+  StatusOr<OperatorIR*> CreatePrepareOperator(IR* plan, OperatorIR* op) const override;
+  StatusOr<OperatorIR*> CreateMergeOperator(IR* plan, OperatorIR* new_parent,
+                                            OperatorIR* op) const override;
+};
+
 /**
  * @brief AggOperatorMgr manages splitting aggregates into partial aggregate and the merging node
  * over a network boundary.
@@ -68,6 +68,37 @@ TEST_F(PartialOpMgrTest, limit_test) {
   EXPECT_NE(merge_limit, limit);
 }
 
+TEST_F(PartialOpMgrTest, top_k_test) {
+  auto mem_src = MakeMemSource(MakeRelation());
+  auto sort = MakeSort(mem_src, {"cpu0", "count"}, {false, true}, 10);
+  MakeMemSink(sort, "out");
+
+  TopKOperatorMgr mgr;
+  EXPECT_TRUE(mgr.Matches(sort));
+  ASSERT_OK_AND_ASSIGN(OperatorIR * prepare_sort_uncasted,
+                       mgr.CreatePrepareOperator(graph.get(), sort));
+  ASSERT_MATCH(prepare_sort_uncasted, Sort());
+  SortIR* prepare_sort = static_cast<SortIR*>(prepare_sort_uncasted);
+  EXPECT_EQ(prepare_sort->limit(), 10);
+  EXPECT_THAT(prepare_sort->sort_cols(), ElementsAre("cpu0", "count"));
+  EXPECT_THAT(prepare_sort->ascending(), ElementsAre(false, true));
+  EXPECT_EQ(prepare_sort->parents(), sort->parents());
+  EXPECT_NE(prepare_sort, sort);
+
+  auto mem_src2 = MakeMemSource(MakeRelation());
+  ASSERT_OK_AND_ASSIGN(OperatorIR * merge_sort_uncasted,
+                       mgr.CreateMergeOperator(graph.get(), mem_src2, sort));
+  ASSERT_MATCH(merge_sort_uncasted, Sort());
+  SortIR* merge_sort = static_cast<SortIR*>(merge_sort_uncasted);
+  EXPECT_EQ(merge_sort->limit(), 10);
+  EXPECT_THAT(merge_sort->parents(), ElementsAre(mem_src2));
+  EXPECT_NE(merge_sort, sort);
+
+  // Sorts without a limit need all of the rows, so they aren't split.
+  auto full_sort = MakeSort(mem_src, {"count"}, {true});
+  EXPECT_FALSE(mgr.Matches(full_sort));
+}
+
 TEST_F(PartialOpMgrTest, agg_test) {
   auto relation = MakeRelation();
   relation.AddColumn(types::STRING, "service");
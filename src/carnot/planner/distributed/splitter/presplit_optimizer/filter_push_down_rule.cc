@@ -18,6 +18,8 @@
 
 #include <algorithm>
 #include <queue>
+#include <utility>
+#include <vector>
 
 #include "src/carnot/planner/distributed/splitter/executor_utils.h"
 #include "src/carnot/planner/distributed/splitter/presplit_optimizer/filter_push_down_rule.h"
@@ -135,12 +137,82 @@ Status FilterPushdownRule::UpdateFilter(FilterIR* filter,
   return filter->SetFilterExpr(new_expr);
 }
 
-StatusOr<bool> FilterPushdownRule::Apply(IRNode* ir_node) {
-  if (!Match(ir_node, Filter())) {
+StatusOr<bool> FilterPushdownRule::PushFilterAboveMultiParentOp(FilterIR* filter) {
+  DCHECK_EQ(1U, filter->parents().size());
+  OperatorIR* op = filter->parents()[0];
+  if (op->Children().size() > 1) {
     return false;
   }
+  PX_ASSIGN_OR_RETURN(auto involved_cols, filter->filter_expr()->InputColumnNames());
 
-  FilterIR* filter = static_cast<FilterIR*>(ir_node);
+  // The parents of op that get a copy of the filter, with the name each filter column has there.
+  std::vector<std::pair<int64_t, ColumnNameMapping>> new_locations;
+  if (Match(op, Union())) {
+    // Unions match the columns of their parents by name.
+    ColumnNameMapping column_name_mapping;
+    for (const auto& col : involved_cols) {
+      column_name_mapping[col] = col;
+    }
+    for (int64_t parent_idx = 0; parent_idx < static_cast<int64_t>(op->parents().size());
+         ++parent_idx) {
+      new_locations.emplace_back(parent_idx, column_name_mapping);
+    }
+  } else if (Match(op, Join())) {
+    JoinIR* join = static_cast<JoinIR*>(op);
+    const auto& column_names = join->column_names();
+    ColumnNameMapping column_name_mapping;
+    int64_t parent_idx = -1;
+    // Every column of the filter has to come from the same side of the join.
+    for (const auto& col : involved_cols) {
+      auto it = std::find(column_names.begin(), column_names.end(), col);
+      if (it == column_names.end()) {
+        return false;
+      }
+      ColumnIR* input_col = join->output_columns()[it - column_names.begin()];
+      if (parent_idx != -1 && parent_idx != input_col->container_op_parent_idx()) {
+        return false;
+      }
+      parent_idx = input_col->container_op_parent_idx();
+      column_name_mapping[col] = input_col->col_name();
+    }
+    if (parent_idx == -1) {
+      return false;
+    }
+    // The side that gets nulls for unmatched rows can't be filtered before the join, since the
+    // filter would then keep the unmatched rows of the other side.
+    auto join_type = join->join_type();
+    if (join_type == JoinIR::JoinType::kOuter ||
+        (join_type == JoinIR::JoinType::kLeft && parent_idx != 0) ||
+        (join_type == JoinIR::JoinType::kRight && parent_idx != 1)) {
+      return false;
+    }
+    new_locations.emplace_back(parent_idx, column_name_mapping);
+  } else {
+    return false;
+  }
+
+  auto graph = filter->graph();
+  std::vector<OperatorIR*> op_parents = op->parents();
+  for (const auto& [parent_idx, column_name_mapping] : new_locations) {
+    OperatorIR* op_parent = op_parents[parent_idx];
+    PX_ASSIGN_OR_RETURN(FilterIR * new_filter, graph->CopyNode(filter));
+    PX_RETURN_IF_ERROR(UpdateFilter(new_filter, column_name_mapping));
+    PX_RETURN_IF_ERROR(new_filter->AddParent(op_parent));
+    PX_RETURN_IF_ERROR(op->ReplaceParent(op_parent, new_filter));
+    PX_RETURN_IF_ERROR(new_filter->SetResolvedType(op_parent->resolved_type()));
+    // The copy may keep going up its own branch.
+    PX_RETURN_IF_ERROR(PushFilter(new_filter).status());
+  }
+
+  for (OperatorIR* child : filter->Children()) {
+    PX_RETURN_IF_ERROR(child->ReplaceParent(filter, op));
+  }
+  PX_RETURN_IF_ERROR(filter->RemoveParent(op));
+  PX_RETURN_IF_ERROR(graph->DeleteNode(filter->id()));
+  return true;
+}
+
+StatusOr<bool> FilterPushdownRule::PushFilter(FilterIR* filter) {
   OperatorIR* current_node = filter;
 
   // Tracks the name of each involved column we have in this filter func,
@@ -165,29 +237,42 @@ StatusOr<bool> FilterPushdownRule::Apply(IRNode* ir_node) {
     }
     current_node = next_parent;
   }
-  // If the current_node is filter, that means we could not find a better filter location and will
-  // not change.
-  if (current_node == filter) {
-    return false;
-  }
 
-  PX_RETURN_IF_ERROR(UpdateFilter(filter, column_name_mapping));
+  // If the current_node is filter, that means we could not find a better filter location along
+  // this branch.
+  bool moved = current_node != filter;
+  if (moved) {
+    PX_RETURN_IF_ERROR(UpdateFilter(filter, column_name_mapping));
 
-  // Make the filter's parent its children's new parent.
-  DCHECK_EQ(1U, filter->parents().size());
-  OperatorIR* filter_parent = filter->parents()[0];
+    // Make the filter's parent its children's new parent.
+    DCHECK_EQ(1U, filter->parents().size());
+    OperatorIR* filter_parent = filter->parents()[0];
 
-  for (OperatorIR* child : filter->Children()) {
-    PX_RETURN_IF_ERROR(child->ReplaceParent(filter, filter_parent));
+    for (OperatorIR* child : filter->Children()) {
+      PX_RETURN_IF_ERROR(child->ReplaceParent(filter, filter_parent));
+    }
+    PX_RETURN_IF_ERROR(filter->RemoveParent(filter_parent));
+
+    DCHECK_EQ(1U, current_node->parents().size());
+    auto new_filter_parent = current_node->parents()[0];
+    PX_RETURN_IF_ERROR(filter->AddParent(new_filter_parent));
+    PX_RETURN_IF_ERROR(current_node->ReplaceParent(new_filter_parent, filter));
+    PX_RETURN_IF_ERROR(filter->SetResolvedType(new_filter_parent->resolved_type()));
   }
-  PX_RETURN_IF_ERROR(filter->RemoveParent(filter_parent));
 
-  DCHECK_EQ(1U, current_node->parents().size());
-  auto new_filter_parent = current_node->parents()[0];
-  PX_RETURN_IF_ERROR(filter->AddParent(new_filter_parent));
-  PX_RETURN_IF_ERROR(current_node->ReplaceParent(new_filter_parent, filter));
-  PX_RETURN_IF_ERROR(filter->SetResolvedType(new_filter_parent->resolved_type()));
-  return true;
+  // Kelvin-only filters stay where they are, the branches of a join or union may run on PEMs.
+  if (kelvin_only_filter) {
+    return moved;
+  }
+  PX_ASSIGN_OR_RETURN(bool pushed_above_op, PushFilterAboveMultiParentOp(filter));
+  return moved || pushed_above_op;
+}
+
+StatusOr<bool> FilterPushdownRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, Filter())) {
+    return false;
+  }
+  return PushFilter(static_cast<FilterIR*>(ir_node));
 }
 
 }  // namespace distributed
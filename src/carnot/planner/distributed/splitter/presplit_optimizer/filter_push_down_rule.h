@@ -19,6 +19,7 @@
 #pragma once
 
 #include "src/carnot/planner/ir/blocking_agg_ir.h"
+#include "src/carnot/planner/ir/join_ir.h"
 #include "src/carnot/planner/ir/map_ir.h"
 #include "src/carnot/planner/rules/rules.h"
 
@@ -32,6 +33,8 @@ namespace distributed {
  * It must run after OperatorRelationRule so that it has full context on all of the column
  * names that exist in the IR.
  *
+ * Filters also cross unions, with a copy on each branch, and joins, onto the side their columns
+ * come from, as long as that side doesn't get nulls for unmatched rows.
  */
 class FilterPushdownRule : public Rule {
  public:
@@ -48,6 +51,9 @@ class FilterPushdownRule : public Rule {
   StatusOr<OperatorIR*> NextFilterLocation(OperatorIR* current_node, bool kelvin_only_filter,
                                            ColumnNameMapping* column_name_mapping);
   Status UpdateFilter(FilterIR* expr, const ColumnNameMapping& column_name_mapping);
+  StatusOr<bool> PushFilter(FilterIR* filter);
+  // Replaces a filter whose parent is a union or a join with copies on the parents of that op.
+  StatusOr<bool> PushFilterAboveMultiParentOp(FilterIR* filter);
 };
 
 }  // namespace distributed
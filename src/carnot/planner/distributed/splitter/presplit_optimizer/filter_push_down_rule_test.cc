@@ -479,6 +479,103 @@ TEST_F(FilterPushDownTest, dont_update_col_names_if_not_pushing_down_map) {
                                                  Equals(ColumnNode("renamed"), Int(1))));
 }
 
+TEST_F(FilterPushDownTest, union_branches) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src1 = MakeMemSource("source1", relation);
+  compiler_state_->relation_map()->emplace("source1", relation);
+  MemorySourceIR* src2 = MakeMemSource("source2", relation);
+  compiler_state_->relation_map()->emplace("source2", relation);
+  UnionIR* union_node = MakeUnion({src1, src2});
+  FilterIR* filter = MakeFilter(union_node, MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(2)));
+  int64_t filter_id = filter->id();
+  MemorySinkIR* sink = MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  FilterPushdownRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ValueOrDie());
+
+  EXPECT_FALSE(graph->HasNode(filter_id));
+  EXPECT_THAT(sink->parents(), ElementsAre(union_node));
+  ASSERT_EQ(2, union_node->parents().size());
+  std::vector<OperatorIR*> srcs{src1, src2};
+  for (const auto& [idx, parent] : Enumerate(union_node->parents())) {
+    ASSERT_MATCH(parent, Filter());
+    auto branch_filter = static_cast<FilterIR*>(parent);
+    EXPECT_THAT(branch_filter->parents(), ElementsAre(srcs[idx]));
+    EXPECT_MATCH(branch_filter->filter_expr(), Equals(ColumnNode("abc"), Int(2)));
+  }
+}
+
+TEST_F(FilterPushDownTest, inner_join_side) {
+  Relation relation1({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src1 = MakeMemSource("source1", relation1);
+  compiler_state_->relation_map()->emplace("source1", relation1);
+  Relation relation2({types::DataType::INT64, types::DataType::INT64}, {"abc", "def"});
+  MemorySourceIR* src2 = MakeMemSource("source2", relation2);
+  compiler_state_->relation_map()->emplace("source2", relation2);
+
+  JoinIR* join = MakeJoin({src1, src2}, "inner", relation1, relation2, {"abc"}, {"abc"});
+  ASSERT_OK(join->SetOutputColumns(
+      {"abc", "xyz", "def_right"},
+      {MakeColumn("abc", 0), MakeColumn("xyz", 0), MakeColumn("def", 1)}));
+  FilterIR* filter = MakeFilter(join, MakeEqualsFunc(MakeColumn("def_right", 0), MakeInt(2)));
+  MemorySinkIR* sink = MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  FilterPushdownRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ValueOrDie());
+
+  EXPECT_THAT(sink->parents(), ElementsAre(join));
+  ASSERT_EQ(2, join->parents().size());
+  EXPECT_EQ(src1, join->parents()[0]);
+  ASSERT_MATCH(join->parents()[1], Filter());
+  auto right_filter = static_cast<FilterIR*>(join->parents()[1]);
+  EXPECT_THAT(right_filter->parents(), ElementsAre(src2));
+  EXPECT_MATCH(right_filter->filter_expr(), Equals(ColumnNode("def"), Int(2)));
+}
+
+TEST_F(FilterPushDownTest, left_join_sides) {
+  Relation relation1({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src1 = MakeMemSource("source1", relation1);
+  compiler_state_->relation_map()->emplace("source1", relation1);
+  Relation relation2({types::DataType::INT64, types::DataType::INT64}, {"abc", "def"});
+  MemorySourceIR* src2 = MakeMemSource("source2", relation2);
+  compiler_state_->relation_map()->emplace("source2", relation2);
+
+  JoinIR* join = MakeJoin({src1, src2}, "left", relation1, relation2, {"abc"}, {"abc"});
+  ASSERT_OK(join->SetOutputColumns(
+      {"abc", "xyz", "def"}, {MakeColumn("abc", 0), MakeColumn("xyz", 0), MakeColumn("def", 1)}));
+  // Rows of the left side without a match have nulls for def, so only the xyz filter can move.
+  FilterIR* def_filter = MakeFilter(join, MakeEqualsFunc(MakeColumn("def", 0), MakeInt(2)));
+  FilterIR* xyz_filter = MakeFilter(def_filter, MakeEqualsFunc(MakeColumn("xyz", 0), MakeInt(3)));
+  MemorySinkIR* sink = MakeMemSink(xyz_filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  FilterPushdownRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ValueOrDie());
+
+  EXPECT_THAT(sink->parents(), ElementsAre(def_filter));
+  EXPECT_THAT(def_filter->parents(), ElementsAre(join));
+  ASSERT_EQ(2, join->parents().size());
+  EXPECT_EQ(src2, join->parents()[1]);
+  ASSERT_MATCH(join->parents()[0], Filter());
+  auto left_filter = static_cast<FilterIR*>(join->parents()[0]);
+  EXPECT_THAT(left_filter->parents(), ElementsAre(src1));
+  EXPECT_MATCH(left_filter->filter_expr(), Equals(ColumnNode("xyz"), Int(3)));
+}
+
 }  // namespace distributed
 }  // namespace planner
 }  // namespace carnot
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/order_filters_by_cost_rule.h"
+
+#include <algorithm>
+#include <string>
+
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/predicate_cost.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+Status OrderFiltersByCostRule::AddPredicateColumnsToOutput(FilterIR* filter) {
+  if (!filter->is_type_resolved()) {
+    return Status::OK();
+  }
+  PX_ASSIGN_OR_RETURN(auto predicate_cols, filter->filter_expr()->InputColumnNames());
+  auto output_type = filter->resolved_table_type();
+  if (std::all_of(predicate_cols.begin(), predicate_cols.end(),
+                  [&](const std::string& col) { return output_type->HasColumn(col); })) {
+    return Status::OK();
+  }
+  // Keep the order of the columns in the input, like column pruning does.
+  auto input_type = filter->parents()[0]->resolved_table_type();
+  auto new_type = TableType::Create();
+  for (const auto& [col_name, col_type] : *input_type) {
+    if (output_type->HasColumn(col_name) || predicate_cols.contains(col_name)) {
+      new_type->AddColumn(col_name, col_type->Copy());
+    }
+  }
+  return filter->SetResolvedType(new_type);
+}
+
+StatusOr<bool> OrderFiltersByCostRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, Filter())) {
+    return false;
+  }
+  FilterIR* filter = static_cast<FilterIR*>(ir_node);
+  DCHECK_EQ(1U, filter->parents().size());
+  if (!Match(filter->parents()[0], Filter())) {
+    return false;
+  }
+  FilterIR* parent = static_cast<FilterIR*>(filter->parents()[0]);
+  // Other children of the parent filter rely on it keeping its predicate.
+  if (parent->Children().size() != 1) {
+    return false;
+  }
+
+  // PEM-only UDFs have to run before Kelvin-only UDFs, so those stay after the other filters.
+  PX_ASSIGN_OR_RETURN(bool kelvin_only, HasFuncWithExecutor(compiler_state_, filter->filter_expr(),
+                                                            udfspb::UDFSourceExecutor::UDF_KELVIN));
+  if (kelvin_only) {
+    return false;
+  }
+
+  PX_ASSIGN_OR_RETURN(int64_t cost, PredicateCost(compiler_state_, filter->filter_expr()));
+  PX_ASSIGN_OR_RETURN(int64_t parent_cost, PredicateCost(compiler_state_, parent->filter_expr()));
+  if (parent_cost <= cost) {
+    return false;
+  }
+  // The parent filter only outputs the columns used after it, which may not include the columns
+  // of its own predicate once the columns are pruned. The predicate that moves down needs them.
+  PX_RETURN_IF_ERROR(AddPredicateColumnsToOutput(parent));
+  PX_ASSIGN_OR_RETURN(ExpressionIR * parent_expr,
+                      filter->graph()->CopyNode(parent->filter_expr()));
+  PX_RETURN_IF_ERROR(parent->SetFilterExpr(filter->filter_expr()));
+  PX_RETURN_IF_ERROR(filter->SetFilterExpr(parent_expr));
+  return true;
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
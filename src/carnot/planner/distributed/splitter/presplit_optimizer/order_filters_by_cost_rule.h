@@ -0,0 +1,50 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "src/carnot/planner/rules/rules.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+/**
+ * @brief This rule swaps the predicates of two consecutive filters when the first one costs more
+ * to evaluate than the second one, according to PredicateCost, so that the expensive predicate
+ * only runs on the rows that the cheap one keeps. It runs after FilterPushdownRule, which leaves
+ * the filters that stop at the same place in no particular order.
+ */
+class OrderFiltersByCostRule : public Rule {
+ public:
+  explicit OrderFiltersByCostRule(CompilerState* compiler_state)
+      : Rule(compiler_state, /*use_topo*/ true, /*reverse_topological_execution*/ false) {}
+
+ protected:
+  StatusOr<bool> Apply(IRNode*) override;
+
+ private:
+  // Adds the columns of the filter's predicate to its output, if they were pruned from it.
+  static Status AddPredicateColumnsToOutput(FilterIR* filter);
+};
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
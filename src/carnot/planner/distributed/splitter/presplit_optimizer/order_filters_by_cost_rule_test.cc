@@ -0,0 +1,146 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/planner/compiler/analyzer/resolve_types_rule.h"
+#include "src/carnot/planner/compiler/optimizer/prune_unused_columns_rule.h"
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/order_filters_by_cost_rule.h"
+#include "src/carnot/planner/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+using compiler::ResolveTypesRule;
+using ::testing::ElementsAre;
+
+using OrderFiltersByCostTest = testutils::DistributedRulesTest;
+TEST_F(OrderFiltersByCostTest, expensive_filter_first) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+  FilterIR* filter1 = MakeFilter(src, MakeFunc("pem_only", {}));
+  FilterIR* filter2 = MakeFilter(filter1, MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(2)));
+  MemorySinkIR* sink = MakeMemSink(filter2, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  OrderFiltersByCostRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ValueOrDie());
+
+  EXPECT_THAT(sink->parents(), ElementsAre(filter2));
+  EXPECT_THAT(filter2->parents(), ElementsAre(filter1));
+  EXPECT_THAT(filter1->parents(), ElementsAre(src));
+  EXPECT_MATCH(filter1->filter_expr(), Equals(ColumnNode("abc"), Int(2)));
+  EXPECT_MATCH(filter2->filter_expr(), Func("pem_only"));
+}
+
+TEST_F(OrderFiltersByCostTest, after_column_pruning) {
+  Relation relation({types::DataType::INT64, types::DataType::STRING}, {"abc", "name"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+  FilterIR* filter1 = MakeFilter(
+      src, MakeEqualsFunc(MakeFunc("pem_only", {MakeColumn("name", 0)}), MakeString("pod")));
+  FilterIR* filter2 = MakeFilter(filter1, MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(2)));
+  MakeMemSink(filter2, "foo", {"abc"});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+  compiler::PruneUnusedColumnsRule prune_rule;
+  ASSERT_OK(prune_rule.Execute(graph.get()));
+  // name is only used by the predicate of the first filter.
+  EXPECT_THAT(filter1->resolved_table_type()->ColumnNames(), ElementsAre("abc"));
+
+  OrderFiltersByCostRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ValueOrDie());
+
+  EXPECT_MATCH(filter1->filter_expr(), Equals(ColumnNode("abc"), Int(2)));
+  EXPECT_MATCH(filter2->filter_expr(), Equals(Func("pem_only"), String()));
+  // The predicate that moved down still finds its column in the output of the first filter.
+  EXPECT_THAT(filter1->resolved_table_type()->ColumnNames(), ElementsAre("abc", "name"));
+  planpb::Operator filter1_pb;
+  EXPECT_OK(filter1->ToProto(&filter1_pb));
+  planpb::Operator filter2_pb;
+  EXPECT_OK(filter2->ToProto(&filter2_pb));
+}
+
+TEST_F(OrderFiltersByCostTest, cheap_filter_first_no_op) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+  FilterIR* filter1 = MakeFilter(src, MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(2)));
+  FilterIR* filter2 = MakeFilter(filter1, MakeFunc("pem_only", {}));
+  MakeMemSink(filter2, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  OrderFiltersByCostRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ValueOrDie());
+}
+
+TEST_F(OrderFiltersByCostTest, kelvin_only_stays_after_pem_only) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+  FilterIR* filter1 = MakeFilter(src, MakeFunc("pem_only", {}));
+  FilterIR* filter2 = MakeFilter(filter1, MakeFunc("kelvin_only", {}));
+  MakeMemSink(filter2, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  OrderFiltersByCostRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ValueOrDie());
+  EXPECT_MATCH(filter1->filter_expr(), Func("pem_only"));
+}
+
+TEST_F(OrderFiltersByCostTest, parent_with_other_children_no_op) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+  FilterIR* filter1 = MakeFilter(src, MakeFunc("pem_only", {}));
+  FilterIR* filter2 = MakeFilter(filter1, MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(2)));
+  MakeMemSink(filter2, "foo", {});
+  MakeMemSink(filter1, "bar", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  OrderFiltersByCostRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ValueOrDie());
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "src/carnot/planner/compiler_state/compiler_state.h"
+#include "src/carnot/planner/distributed/splitter/executor_utils.h"
+#include "src/carnot/planner/ir/ir.h"
+#include "src/carnot/planner/ir/pattern_match.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+// Rough costs of evaluating a predicate on a row, used to run the cheap parts of filters first.
+// Calls to a UDF.
+constexpr int64_t kFuncCost = 1;
+// Extra cost for each string argument of a UDF, since strings are compared byte by byte.
+constexpr int64_t kStringArgCost = 2;
+// Extra cost of PEM-only UDFs, which look up agent state like the metadata of a UPID.
+constexpr int64_t kPEMOnlyFuncCost = 50;
+
+inline StatusOr<int64_t> PredicateCost(CompilerState* compiler_state, ExpressionIR* expr) {
+  if (!Match(expr, Func())) {
+    return 0;
+  }
+  auto func = static_cast<FuncIR*>(expr);
+  int64_t cost = kFuncCost;
+  PX_ASSIGN_OR_RETURN(bool pem_only,
+                      IsFuncWithExecutor(compiler_state, func, udfspb::UDFSourceExecutor::UDF_PEM));
+  if (pem_only) {
+    cost += kPEMOnlyFuncCost;
+  }
+  for (ExpressionIR* arg : func->all_args()) {
+    if (arg->IsDataTypeEvaluated() && arg->EvaluatedDataType() == types::STRING) {
+      cost += kStringArgCost;
+    }
+    PX_ASSIGN_OR_RETURN(int64_t arg_cost, PredicateCost(compiler_state, arg));
+    cost += arg_cost;
+  }
+  return cost;
+}
+
+// Appends the terms of the conjunction to conjuncts, or the expression itself if it's not one.
+inline void CollectConjuncts(ExpressionIR* expr, std::vector<ExpressionIR*>* conjuncts) {
+  if (Match(expr, Func()) && static_cast<FuncIR*>(expr)->opcode() == FuncIR::Opcode::logand) {
+    for (ExpressionIR* arg : static_cast<FuncIR*>(expr)->all_args()) {
+      CollectConjuncts(arg, conjuncts);
+    }
+    return;
+  }
+  conjuncts->push_back(expr);
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
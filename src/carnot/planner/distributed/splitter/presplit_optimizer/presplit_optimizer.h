@@ -22,6 +22,9 @@
 #include "src/carnot/planner/compiler_state/compiler_state.h"
 #include "src/carnot/planner/distributed/splitter/presplit_optimizer/filter_push_down_rule.h"
 #include "src/carnot/planner/distributed/splitter/presplit_optimizer/limit_push_down_rule.h"
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/order_filters_by_cost_rule.h"
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/sort_limit_fold_rule.h"
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/split_conjunctive_filters_rule.h"
 #include "src/carnot/planner/rules/rule_executor.h"
 
 namespace px {
@@ -46,6 +49,11 @@ class PreSplitOptimizer : public RuleExecutor<IR> {
  private:
   explicit PreSplitOptimizer(CompilerState* compiler_state) : compiler_state_(compiler_state) {}
 
+  void CreateSortLimitFoldBatch() {
+    RuleBatch* sort_limit_fold = CreateRuleBatch<TryUntilMax>("SortLimitFold", 1);
+    sort_limit_fold->AddRule<SortLimitFoldRule>(compiler_state_);
+  }
+
   void CreateLimitPushdownBatch() {
     // We only run limit pushdown once as it should find all limits that need to be pushed down in a
     // single pass. Otherwise, the Union case will continue pushing Limits up as long as you
@@ -54,15 +62,31 @@ class PreSplitOptimizer : public RuleExecutor<IR> {
     limit_pushdown->AddRule<LimitPushdownRule>(compiler_state_);
   }
 
+  void CreateSplitConjunctiveFiltersBatch() {
+    RuleBatch* split_filters = CreateRuleBatch<DoOnce>("SplitConjunctiveFilters");
+    split_filters->AddRule<SplitConjunctiveFiltersRule>(compiler_state_);
+  }
+
   void CreateFilterPushdownBatch() {
     // Use TryUntilMax here to avoid swapping the positions of "equal" filters endlessly.
     RuleBatch* filter_pushdown = CreateRuleBatch<TryUntilMax>("FilterPushdown", 1);
     filter_pushdown->AddRule<FilterPushdownRule>(compiler_state_);
   }
 
+  void CreateOrderFiltersByCostBatch() {
+    // Each pass moves the cheaper filter of every adjacent pair up by one.
+    RuleBatch* order_filters = CreateRuleBatch<TryUntilMax>("OrderFiltersByCost", 10);
+    order_filters->AddRule<OrderFiltersByCostRule>(compiler_state_);
+  }
+
   Status Init() {
+    // Fold limits into sorts before the limits are pushed to other places.
+    CreateSortLimitFoldBatch();
     CreateLimitPushdownBatch();
+    // Split filters into their terms so that each term can be pushed down on its own.
+    CreateSplitConjunctiveFiltersBatch();
     CreateFilterPushdownBatch();
+    CreateOrderFiltersByCostBatch();
     return Status::OK();
   }
 
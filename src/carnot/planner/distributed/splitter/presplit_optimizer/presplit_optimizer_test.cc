@@ -88,6 +88,33 @@ TEST_F(PreSplitOptimizerTest, filter_pushdown) {
   EXPECT_MATCH(filter->filter_expr(), Equals(ColumnNode("abc"), Int(2)));
 }
 
+TEST_F(PreSplitOptimizerTest, split_filter_pushdown) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+  MapIR* map =
+      MakeMap(src, {{"pod", MakeFunc("pem_only", {})}, {"abc", MakeColumn("abc", 0)}}, false);
+  auto and_func = MakeAndFunc(MakeEqualsFunc(MakeColumn("pod", 0), MakeString("foo")),
+                              MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(2)));
+  FilterIR* filter = MakeFilter(map, and_func);
+  MemorySinkIR* sink = MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  auto optimizer = PreSplitOptimizer::Create(compiler_state_.get()).ConsumeValueOrDie();
+  ASSERT_OK(optimizer->Execute(graph.get()));
+
+  // The abc term runs before the map, the pod term has to stay after it.
+  EXPECT_THAT(sink->parents(), ElementsAre(filter));
+  EXPECT_MATCH(filter->filter_expr(), Equals(ColumnNode("pod"), String("foo")));
+  EXPECT_THAT(filter->parents(), ElementsAre(map));
+  ASSERT_MATCH(map->parents()[0], Filter());
+  auto abc_filter = static_cast<FilterIR*>(map->parents()[0]);
+  EXPECT_MATCH(abc_filter->filter_expr(), Equals(ColumnNode("abc"), Int(2)));
+  EXPECT_THAT(abc_filter->parents(), ElementsAre(src));
+}
+
 }  // namespace distributed
 }  // namespace planner
 }  // namespace carnot
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/sort_limit_fold_rule.h"
+
+#include <algorithm>
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+StatusOr<bool> SortLimitFoldRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, Limit())) {
+    return false;
+  }
+  LimitIR* limit = static_cast<LimitIR*>(ir_node);
+  DCHECK_EQ(1U, limit->parents().size());
+  OperatorIR* parent = limit->parents()[0];
+  // The sort can only take on the limit if nothing else reads all of its rows.
+  if (limit->pem_only() || !Match(parent, Sort()) || parent->Children().size() != 1) {
+    return false;
+  }
+
+  SortIR* sort = static_cast<SortIR*>(parent);
+  int64_t new_limit = limit->limit_value();
+  if (sort->limit() > 0) {
+    new_limit = std::min(new_limit, sort->limit());
+  }
+  // A limit of 0 means no limit to the sort, so that case keeps the limit node.
+  if (new_limit == 0) {
+    return false;
+  }
+  sort->SetLimit(new_limit);
+
+  for (OperatorIR* child : limit->Children()) {
+    PX_RETURN_IF_ERROR(child->ReplaceParent(limit, sort));
+  }
+  PX_RETURN_IF_ERROR(limit->RemoveParent(sort));
+  PX_RETURN_IF_ERROR(ir_node->graph()->DeleteNode(limit->id()));
+  return true;
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/planner/compiler/analyzer/resolve_types_rule.h"
+#include "src/carnot/planner/compiler/test_utils.h"
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/sort_limit_fold_rule.h"
+#include "src/carnot/planner/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+using compiler::ResolveTypesRule;
+using ::testing::ElementsAre;
+
+using SortLimitFoldRuleTest = testutils::DistributedRulesTest;
+TEST_F(SortLimitFoldRuleTest, fold_limit) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+  SortIR* sort = MakeSort(src, {"abc"}, {false});
+  LimitIR* limit = MakeLimit(sort, 10);
+  MemorySinkIR* sink = MakeMemSink(limit, "foo", {});
+  int64_t limit_id = limit->id();
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  SortLimitFoldRule rule(compiler_state_.get());
+  ASSERT_OK_AND_ASSIGN(bool changed, rule.Execute(graph.get()));
+  EXPECT_TRUE(changed);
+
+  EXPECT_EQ(10, sort->limit());
+  EXPECT_THAT(sink->parents(), ElementsAre(sort));
+  EXPECT_FALSE(graph->HasNode(limit_id));
+}
+
+TEST_F(SortLimitFoldRuleTest, keep_smaller_limit) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  SortIR* sort = MakeSort(src, {"abc"}, {true}, /*limit*/ 5);
+  LimitIR* limit = MakeLimit(sort, 10);
+  MakeMemSink(limit, "foo", {});
+
+  SortLimitFoldRule rule(compiler_state_.get());
+  ASSERT_OK_AND_ASSIGN(bool changed, rule.Execute(graph.get()));
+  EXPECT_TRUE(changed);
+  EXPECT_EQ(5, sort->limit());
+}
+
+TEST_F(SortLimitFoldRuleTest, sort_with_other_children) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  SortIR* sort = MakeSort(src, {"abc"}, {true});
+  LimitIR* limit = MakeLimit(sort, 10);
+  MakeMemSink(limit, "foo", {});
+  // This sink needs all of the sorted rows.
+  MakeMemSink(sort, "bar", {});
+
+  SortLimitFoldRule rule(compiler_state_.get());
+  ASSERT_OK_AND_ASSIGN(bool changed, rule.Execute(graph.get()));
+  EXPECT_FALSE(changed);
+  EXPECT_EQ(0, sort->limit());
+}
+
+TEST_F(SortLimitFoldRuleTest, pem_only_limit) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  SortIR* sort = MakeSort(src, {"abc"}, {true});
+  LimitIR* limit = MakeLimit(sort, 10, /*pem_only*/ true);
+  MakeMemSink(limit, "foo", {});
+
+  SortLimitFoldRule rule(compiler_state_.get());
+  ASSERT_OK_AND_ASSIGN(bool changed, rule.Execute(graph.get()));
+  EXPECT_FALSE(changed);
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
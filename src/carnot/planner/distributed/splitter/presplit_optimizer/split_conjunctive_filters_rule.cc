@@ -0,0 +1,75 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/split_conjunctive_filters_rule.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/predicate_cost.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+StatusOr<bool> SplitConjunctiveFiltersRule::Apply(IRNode* ir_node) {
+  if (!Match(ir_node, Filter())) {
+    return false;
+  }
+  FilterIR* filter = static_cast<FilterIR*>(ir_node);
+  std::vector<ExpressionIR*> conjuncts;
+  CollectConjuncts(filter->filter_expr(), &conjuncts);
+  if (conjuncts.size() < 2) {
+    return false;
+  }
+
+  // Terms with Kelvin-only UDFs go last, since PEM-only UDFs have to run before them.
+  std::vector<std::pair<std::pair<bool, int64_t>, ExpressionIR*>> costed_conjuncts;
+  for (ExpressionIR* conjunct : conjuncts) {
+    PX_ASSIGN_OR_RETURN(bool kelvin_only,
+                        HasFuncWithExecutor(compiler_state_, conjunct,
+                                            udfspb::UDFSourceExecutor::UDF_KELVIN));
+    PX_ASSIGN_OR_RETURN(int64_t cost, PredicateCost(compiler_state_, conjunct));
+    costed_conjuncts.push_back({{kelvin_only, cost}, conjunct});
+  }
+  // Ties keep the order of the script.
+  std::stable_sort(costed_conjuncts.begin(), costed_conjuncts.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  DCHECK_EQ(1U, filter->parents().size());
+  OperatorIR* parent = filter->parents()[0];
+  OperatorIR* chain_end = parent;
+  // Every term but the most expensive one gets a new filter, the original filter keeps the last.
+  for (size_t i = 0; i + 1 < costed_conjuncts.size(); ++i) {
+    PX_ASSIGN_OR_RETURN(FilterIR * term_filter,
+                        filter->graph()->CreateNode<FilterIR>(filter->ast(), chain_end,
+                                                              costed_conjuncts[i].second));
+    PX_RETURN_IF_ERROR(term_filter->SetResolvedType(parent->resolved_type()));
+    chain_end = term_filter;
+  }
+  PX_RETURN_IF_ERROR(filter->ReplaceParent(parent, chain_end));
+  PX_RETURN_IF_ERROR(filter->SetFilterExpr(costed_conjuncts.back().second));
+  return true;
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "src/carnot/planner/rules/rules.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+/**
+ * @brief This rule splits a filter on a conjunction into a chain of filters, one per term, so
+ * that FilterPushdownRule can move each term as early as its own columns allow:
+ *
+ * df.pod = df.ctx['pod']
+ * df = df[df.pod == 'foo' and df.resp_status >= 500]
+ *
+ * The status check moves above the map that looks up the pod names, so the lookup only runs on
+ * the rows that pass it. The terms are chained in order of PredicateCost, cheapest first.
+ */
+class SplitConjunctiveFiltersRule : public Rule {
+ public:
+  explicit SplitConjunctiveFiltersRule(CompilerState* compiler_state)
+      : Rule(compiler_state, /*use_topo*/ true, /*reverse_topological_execution*/ false) {}
+
+ protected:
+  StatusOr<bool> Apply(IRNode*) override;
+};
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "src/carnot/planner/compiler/analyzer/resolve_types_rule.h"
+#include "src/carnot/planner/distributed/splitter/presplit_optimizer/split_conjunctive_filters_rule.h"
+#include "src/carnot/planner/test_utils.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+namespace distributed {
+
+using compiler::ResolveTypesRule;
+using ::testing::ElementsAre;
+
+using SplitConjunctiveFiltersTest = testutils::DistributedRulesTest;
+TEST_F(SplitConjunctiveFiltersTest, single_term_no_op) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+  FilterIR* filter = MakeFilter(src, MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(2)));
+  MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  SplitConjunctiveFiltersRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_FALSE(result.ValueOrDie());
+}
+
+TEST_F(SplitConjunctiveFiltersTest, cheap_terms_first) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+  auto and_func =
+      MakeAndFunc(MakeAndFunc(MakeFunc("pem_only", {}),
+                              MakeEqualsFunc(MakeColumn("abc", 0), MakeInt(2))),
+                  MakeEqualsFunc(MakeColumn("xyz", 0), MakeInt(3)));
+  FilterIR* filter = MakeFilter(src, and_func);
+  MemorySinkIR* sink = MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  SplitConjunctiveFiltersRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ValueOrDie());
+
+  // The equal terms keep their order, the PEM-only UDF goes last.
+  EXPECT_THAT(sink->parents(), ElementsAre(filter));
+  EXPECT_MATCH(filter->filter_expr(), Func("pem_only"));
+  ASSERT_MATCH(filter->parents()[0], Filter());
+  auto xyz_filter = static_cast<FilterIR*>(filter->parents()[0]);
+  EXPECT_MATCH(xyz_filter->filter_expr(), Equals(ColumnNode("xyz"), Int(3)));
+  ASSERT_MATCH(xyz_filter->parents()[0], Filter());
+  auto abc_filter = static_cast<FilterIR*>(xyz_filter->parents()[0]);
+  EXPECT_MATCH(abc_filter->filter_expr(), Equals(ColumnNode("abc"), Int(2)));
+  EXPECT_THAT(abc_filter->parents(), ElementsAre(src));
+}
+
+TEST_F(SplitConjunctiveFiltersTest, kelvin_only_terms_last) {
+  Relation relation({types::DataType::INT64, types::DataType::INT64}, {"abc", "xyz"});
+  MemorySourceIR* src = MakeMemSource("source", relation);
+  compiler_state_->relation_map()->emplace("source", relation);
+  auto and_func = MakeAndFunc(MakeFunc("kelvin_only", {}), MakeFunc("pem_only", {}));
+  FilterIR* filter = MakeFilter(src, and_func);
+  MakeMemSink(filter, "foo", {});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+
+  SplitConjunctiveFiltersRule rule(compiler_state_.get());
+  auto result = rule.Execute(graph.get());
+  ASSERT_OK(result);
+  EXPECT_TRUE(result.ValueOrDie());
+
+  // PEM-only UDFs have to run before Kelvin-only ones, whatever they cost.
+  EXPECT_MATCH(filter->filter_expr(), Func("kelvin_only"));
+  ASSERT_MATCH(filter->parents()[0], Filter());
+  auto pem_filter = static_cast<FilterIR*>(filter->parents()[0]);
+  EXPECT_MATCH(pem_filter->filter_expr(), Func("pem_only"));
+  EXPECT_THAT(pem_filter->parents(), ElementsAre(src));
+}
+
+}  // namespace distributed
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
@@ -26,6 +26,7 @@
 #include <pypa/parser/parser.hh>
 
 #include "src/carnot/planner/compiler/analyzer/resolve_types_rule.h"
+#include "src/carnot/planner/compiler/optimizer/prune_unused_columns_rule.h"
 #include "src/carnot/planner/compiler/test_utils.h"
 #include "src/carnot/planner/distributed/splitter/splitter.h"
 #include "src/carnot/planner/ir/ir.h"
@@ -239,6 +240,42 @@ TEST_F(SplitterTest, limit_test) {
   EXPECT_EQ(grpc_sink->destination_id(), grpc_source_group->source_id());
 }
 
+TEST_F(SplitterTest, top_k_with_sort_col_pruned_downstream) {
+  auto mem_src = MakeMemSource("cpu", cpu_relation);
+  auto sort = MakeSort(mem_src, {"cpu0"}, {true}, 10);
+  auto sink = MakeMemSink(sort, "out", {"count"});
+
+  ResolveTypesRule type_rule(compiler_state_.get());
+  ASSERT_OK(type_rule.Execute(graph.get()));
+  compiler::PruneUnusedColumnsRule prune_rule;
+  ASSERT_OK(prune_rule.Execute(graph.get()));
+  // Only the sink uses count, but the sort still outputs the column it sorts by.
+  EXPECT_THAT(sort->resolved_table_type()->ColumnNames(), UnorderedElementsAre("count", "cpu0"));
+
+  auto splitter_or_s = Splitter::Create(compiler_state_.get(), /* perform_partial_agg */ false);
+  ASSERT_OK(splitter_or_s);
+  std::unique_ptr<Splitter> splitter = splitter_or_s.ConsumeValueOrDie();
+  std::unique_ptr<BlockingSplitPlan> split_plan =
+      splitter->SplitKelvinAndAgents(graph.get()).ConsumeValueOrDie();
+
+  MemorySourceIR* new_mem_src = GetEquivalentInNewPlan(split_plan->before_blocking.get(), mem_src);
+  ASSERT_EQ(new_mem_src->Children().size(), 1UL);
+  ASSERT_MATCH(new_mem_src->Children()[0], Sort());
+  auto prepare_sort = static_cast<SortIR*>(new_mem_src->Children()[0]);
+  EXPECT_TRUE(prepare_sort->resolved_table_type()->HasColumn("cpu0"));
+  planpb::Operator prepare_pb;
+  EXPECT_OK(prepare_sort->ToProto(&prepare_pb));
+
+  OperatorIR* sink_parent = GetEquivalentInNewPlan(split_plan->after_blocking.get(), sink)
+                                ->parents()[0];
+  ASSERT_MATCH(sink_parent, Sort());
+  auto merge_sort = static_cast<SortIR*>(sink_parent);
+  ASSERT_MATCH(merge_sort->parents()[0], GRPCSourceGroup());
+  // The merge sorts the rows of the agents again, which needs the sort column from them.
+  planpb::Operator merge_pb;
+  EXPECT_OK(merge_sort->ToProto(&merge_pb));
+}
+
 TEST_F(SplitterTest, limit_test_pem_only) {
   auto mem_src = MakeMemSource("cpu", cpu_relation);
   auto limit = MakeLimit(mem_src, 10, /* pem_only */ true);
@@ -62,6 +62,26 @@ Status BlockingAggIR::SetAggExprs(const ColExpressionVector& agg_exprs) {
   return Status::OK();
 }
 
+Status BlockingAggIR::SetTimeWindow(ColumnIR* time_col, int64_t window_ns, int64_t slide_ns,
+                                    const std::string& window_start_name) {
+  if (slide_ns <= 0 || window_ns < slide_ns || window_ns % slide_ns != 0) {
+    return CreateIRNodeError("Window of $0ns must be a positive multiple of its slide of $1ns",
+                             window_ns, slide_ns);
+  }
+  ColumnIR* old_time_col = time_window_col_;
+  if (old_time_col != nullptr) {
+    PX_RETURN_IF_ERROR(graph()->DeleteEdge(this, old_time_col));
+  }
+  PX_ASSIGN_OR_RETURN(time_window_col_, graph()->OptionallyCloneWithEdge(this, time_col));
+  if (old_time_col != nullptr) {
+    PX_RETURN_IF_ERROR(graph()->DeleteOrphansInSubtree(old_time_col->id()));
+  }
+  window_ns_ = window_ns;
+  slide_ns_ = slide_ns;
+  window_start_name_ = window_start_name;
+  return Status::OK();
+}
+
 StatusOr<std::vector<absl::flat_hash_set<std::string>>> BlockingAggIR::RequiredInputColumns()
     const {
   absl::flat_hash_set<std::string> required;
@@ -72,7 +92,11 @@ StatusOr<std::vector<absl::flat_hash_set<std::string>>> BlockingAggIR::RequiredI
     PX_ASSIGN_OR_RETURN(auto ret, agg_expr.node->InputColumnNames());
     required.insert(ret.begin(), ret.end());
   }
-  return std::vector<absl::flat_hash_set<std::string>>{required};
+  if (time_windowed()) {
+    required.insert(time_window_col_->col_name());
+  }
+  // The aggregate that merges time windowed partial aggregates can have a parent per agent.
+  return std::vector<absl::flat_hash_set<std::string>>(parents().size(), required);
 }
 
 StatusOr<absl::flat_hash_set<std::string>> BlockingAggIR::PruneOutputColumnsToImpl(
@@ -92,6 +116,9 @@ StatusOr<absl::flat_hash_set<std::string>> BlockingAggIR::PruneOutputColumnsToIm
   for (const ColumnIR* group : groups()) {
     kept_columns.insert(group->col_name());
   }
+  if (time_windowed()) {
+    kept_columns.insert(window_start_name_);
+  }
   return kept_columns;
 }
 
@@ -138,6 +165,13 @@ Status BlockingAggIR::ToProto(planpb::Operator* op) const {
   pb->set_windowed(false);
   pb->set_partial_agg(partial_agg_);
   pb->set_finalize_results(finalize_results_);
+  if (time_windowed()) {
+    auto window_pb = pb->mutable_time_window();
+    PX_RETURN_IF_ERROR(time_window_col_->ToProto(window_pb->mutable_time_column()));
+    window_pb->set_window_ns(window_ns_);
+    window_pb->set_slide_ns(slide_ns_);
+    window_pb->set_window_start_name(window_start_name_);
+  }
 
   op->set_op_type(planpb::AGGREGATE_OPERATOR);
   return Status::OK();
@@ -162,6 +196,13 @@ Status BlockingAggIR::CopyFromNodeImpl(
 
   PX_RETURN_IF_ERROR(SetAggExprs(new_agg_exprs));
   PX_RETURN_IF_ERROR(SetGroups(new_groups));
+  if (blocking_agg->time_windowed()) {
+    PX_ASSIGN_OR_RETURN(IRNode * new_time_col,
+                        graph()->CopyNode(blocking_agg->time_window_col_, copied_nodes_map));
+    PX_RETURN_IF_ERROR(SetTimeWindow(static_cast<ColumnIR*>(new_time_col),
+                                     blocking_agg->window_ns_, blocking_agg->slide_ns_,
+                                     blocking_agg->window_start_name_));
+  }
 
   finalize_results_ = blocking_agg->finalize_results_;
   partial_agg_ = blocking_agg->partial_agg_;
@@ -173,6 +214,14 @@ Status BlockingAggIR::CopyFromNodeImpl(
 Status BlockingAggIR::ResolveType(CompilerState* compiler_state) {
   DCHECK_EQ(1U, parent_types().size());
   auto new_table = TableType::Create();
+  if (time_windowed()) {
+    PX_RETURN_IF_ERROR(ResolveExpressionType(time_window_col_, compiler_state, parent_types()));
+    if (time_window_col_->resolved_value_type()->data_type() != types::TIME64NS) {
+      return time_window_col_->CreateIRNodeError("Window column '$0' must be a time column",
+                                                 time_window_col_->col_name());
+    }
+    new_table->AddColumn(window_start_name_, ValueType::Create(types::TIME64NS, types::ST_NONE));
+  }
   for (const auto& group_col : groups()) {
     PX_RETURN_IF_ERROR(ResolveExpressionType(group_col, compiler_state, parent_types()));
     new_table->AddColumn(group_col->col_name(), group_col->resolved_type());
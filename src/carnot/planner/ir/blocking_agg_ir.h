@@ -71,6 +71,19 @@ class BlockingAggIR : public GroupAcceptorIR {
 
   bool partial_agg() const { return partial_agg_; }
   bool finalize_results() const { return finalize_results_; }
+
+  /**
+   * @brief Aggregates the input per window of time_col instead of over the whole input, and
+   * outputs the start of each window as the first column, named window_start_name.
+   */
+  Status SetTimeWindow(ColumnIR* time_col, int64_t window_ns, int64_t slide_ns,
+                       const std::string& window_start_name);
+  bool time_windowed() const { return time_window_col_ != nullptr; }
+  ColumnIR* time_window_col() const { return time_window_col_; }
+  int64_t window_ns() const { return window_ns_; }
+  int64_t slide_ns() const { return slide_ns_; }
+  const std::string& window_start_name() const { return window_start_name_; }
+
   void SetPreSplitProto(const planpb::AggregateOperator& pre_split_proto) {
     pre_split_proto_ = pre_split_proto;
   }
@@ -88,6 +101,11 @@ class BlockingAggIR : public GroupAcceptorIR {
   // Whether this finalizes the result of a partial aggregate.
   bool finalize_results_ = true;
   planpb::AggregateOperator pre_split_proto_;
+  // The time column of the windows, nullptr when the aggregate isn't windowed.
+  ColumnIR* time_window_col_ = nullptr;
+  int64_t window_ns_ = 0;
+  int64_t slide_ns_ = 0;
+  std::string window_start_name_;
 };
 }  // namespace planner
 }  // namespace carnot
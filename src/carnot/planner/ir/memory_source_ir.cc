@@ -51,12 +51,14 @@ Status MemorySourceIR::ToProto(planpb::Operator* op) const {
     auto start_time = new ::google::protobuf::Int64Value();
     start_time->set_value(time_start_ns());
     pb->set_allocated_start_time(start_time);
+    pb->set_start_time_relative(time_start_relative_);
   }
 
   if (IsTimeStopSet()) {
     auto stop_time = new ::google::protobuf::Int64Value();
     stop_time->set_value(time_stop_ns());
     pb->set_allocated_stop_time(stop_time);
+    pb->set_stop_time_relative(time_stop_relative_);
   }
 
   if (HasTablet()) {
@@ -64,6 +66,19 @@ Status MemorySourceIR::ToProto(planpb::Operator* op) const {
   }
 
   pb->set_streaming(streaming());
+
+  const auto& col_names = resolved_table_type()->ColumnNames();
+  for (const auto& predicate : predicates_) {
+    auto it = std::find(col_names.begin(), col_names.end(), predicate.column_name);
+    // Predicates are only hints, so one on a column that was pruned can be dropped.
+    if (it == col_names.end()) {
+      continue;
+    }
+    auto pred_pb = pb->add_predicates();
+    pred_pb->set_column_idx(column_index_map_[std::distance(col_names.begin(), it)]);
+    pred_pb->set_op(predicate.op);
+    *pred_pb->mutable_value() = predicate.value;
+  }
   return Status::OK();
 }
 
@@ -102,10 +117,13 @@ Status MemorySourceIR::CopyFromNodeImpl(const IRNode* node,
   table_name_ = source_ir->table_name_;
   time_start_ns_ = source_ir->time_start_ns_;
   time_stop_ns_ = source_ir->time_stop_ns_;
+  time_start_relative_ = source_ir->time_start_relative_;
+  time_stop_relative_ = source_ir->time_stop_relative_;
   column_names_ = source_ir->column_names_;
   column_index_map_set_ = source_ir->column_index_map_set_;
   column_index_map_ = source_ir->column_index_map_;
   streaming_ = source_ir->streaming_;
+  predicates_ = source_ir->predicates_;
 
   return Status::OK();
 }
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "src/carnot/planner/compiler_state/compiler_state.h"
@@ -42,6 +43,16 @@ namespace planner {
  */
 class MemorySourceIR : public OperatorIR {
  public:
+  /**
+   * @brief A comparison between an output column of the source and a constant, that every row
+   * the source outputs is later filtered by. The source may skip table batches that can't match.
+   */
+  struct Predicate {
+    std::string column_name;
+    planpb::MemorySourceOperator::Predicate::Op op;
+    planpb::ScalarValue value;
+  };
+
   MemorySourceIR() = delete;
   explicit MemorySourceIR(int64_t id) : OperatorIR(id, IRNodeType::kMemorySource) {}
 
@@ -65,6 +76,11 @@ class MemorySourceIR : public OperatorIR {
   void SetTimeStopNS(int64_t time_stop_ns) { time_stop_ns_ = time_stop_ns; }
   bool IsTimeStartSet() const { return time_start_ns_.has_value(); }
   bool IsTimeStopSet() const { return time_stop_ns_.has_value(); }
+  // Marks the start/stop time as resolved against the time_now of the compiler state.
+  void SetTimeStartRelative() { time_start_relative_ = true; }
+  void SetTimeStopRelative() { time_stop_relative_ = true; }
+  bool time_start_relative() const { return time_start_relative_; }
+  bool time_stop_relative() const { return time_stop_relative_; }
 
   std::string DebugString() const override;
 
@@ -82,6 +98,9 @@ class MemorySourceIR : public OperatorIR {
 
   bool select_all() const { return column_names_.size() == 0; }
 
+  const std::vector<Predicate>& predicates() const { return predicates_; }
+  void AddPredicate(Predicate predicate) { predicates_.push_back(std::move(predicate)); }
+
   Status CopyFromNodeImpl(const IRNode* node,
                           absl::flat_hash_map<const IRNode*, IRNode*>* copied_nodes_map) override;
   const std::vector<std::string>& column_names() const { return column_names_; }
@@ -116,6 +135,8 @@ class MemorySourceIR : public OperatorIR {
 
   std::optional<int64_t> time_start_ns_;
   std::optional<int64_t> time_stop_ns_;
+  bool time_start_relative_ = false;
+  bool time_stop_relative_ = false;
 
   // Hold of columns in the order that they are selected.
   std::vector<std::string> column_names_;
@@ -126,6 +147,8 @@ class MemorySourceIR : public OperatorIR {
 
   types::TabletID tablet_value_;
   bool has_tablet_value_ = false;
+
+  std::vector<Predicate> predicates_;
 };
 
 }  // namespace planner
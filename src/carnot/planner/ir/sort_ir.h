@@ -0,0 +1,85 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/carnot/planner/compiler_state/compiler_state.h"
+#include "src/carnot/planner/ir/operator_ir.h"
+#include "src/carnot/planner/types/types.h"
+#include "src/common/base/base.h"
+
+namespace px {
+namespace carnot {
+namespace planner {
+
+/**
+ * @brief The SortIR sorts its input by a list of columns. With a limit, it only keeps the first
+ * limit rows of the sorted order, which lets the splitter run a top-k on each agent before the
+ * merge.
+ */
+class SortIR : public OperatorIR {
+ public:
+  SortIR() = delete;
+  explicit SortIR(int64_t id) : OperatorIR(id, IRNodeType::kSort) {}
+
+  /**
+   * @param sort_cols The columns to sort by, in order of precedence.
+   * @param ascending Whether each of the sort columns is sorted in ascending order.
+   * @param limit The number of rows to keep, 0 keeps all of them.
+   */
+  Status Init(OperatorIR* parent, const std::vector<std::string>& sort_cols,
+              const std::vector<bool>& ascending, int64_t limit = 0);
+
+  Status ToProto(planpb::Operator*) const override;
+
+  const std::vector<std::string>& sort_cols() const { return sort_cols_; }
+  const std::vector<bool>& ascending() const { return ascending_; }
+  int64_t limit() const { return limit_; }
+  void SetLimit(int64_t limit) { limit_ = limit; }
+
+  Status CopyFromNodeImpl(const IRNode* node,
+                          absl::flat_hash_map<const IRNode*, IRNode*>* copied_nodes_map) override;
+  inline bool IsBlocking() const override { return true; }
+
+  StatusOr<std::vector<absl::flat_hash_set<std::string>>> RequiredInputColumns() const override;
+
+  Status ResolveType(CompilerState* compiler_state);
+
+ protected:
+  StatusOr<absl::flat_hash_set<std::string>> PruneOutputColumnsToImpl(
+      const absl::flat_hash_set<std::string>& output_cols) override {
+    // The sort columns are always output: the merge stage of a top-k split sorts the output of
+    // this sort again, even when nothing downstream uses them.
+    auto kept_cols = output_cols;
+    kept_cols.insert(sort_cols_.begin(), sort_cols_.end());
+    return kept_cols;
+  }
+
+ private:
+  std::vector<std::string> sort_cols_;
+  std::vector<bool> ascending_;
+  int64_t limit_ = 0;
+};
+
+}  // namespace planner
+}  // namespace carnot
+}  // namespace px
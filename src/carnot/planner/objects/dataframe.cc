@@ -117,12 +117,18 @@ StatusOr<QLObjectPtr> DataFrameConstructor(CompilerState* compiler_state, IR* gr
     PX_ASSIGN_OR_RETURN(auto start_time_ns,
                         ParseAllTimeFormats(compiler_state->time_now().val, start_time));
     mem_source_op->SetTimeStartNS(start_time_ns);
+    if (IsRelativeTime(start_time)) {
+      mem_source_op->SetTimeStartRelative();
+    }
   }
   if (!NoneObject::IsNoneObject(args.GetArg("end_time"))) {
     PX_ASSIGN_OR_RETURN(ExpressionIR * end_time, GetArgAs<ExpressionIR>(ast, args, "end_time"));
     PX_ASSIGN_OR_RETURN(auto end_time_ns,
                         ParseAllTimeFormats(compiler_state->time_now().val, end_time));
     mem_source_op->SetTimeStopNS(end_time_ns);
+    if (IsRelativeTime(end_time)) {
+      mem_source_op->SetTimeStopRelative();
+    }
   }
   return Dataframe::Create(compiler_state, mem_source_op, visitor);
 }
@@ -270,6 +276,28 @@ StatusOr<QLObjectPtr> LimitHandler(CompilerState* compiler_state, IR* graph, Ope
   return Dataframe::Create(compiler_state, limit_op, visitor);
 }
 
+// Handles the sort_values() DataFrame logic.
+StatusOr<QLObjectPtr> SortHandler(CompilerState* compiler_state, IR* graph, OperatorIR* op,
+                                  const pypa::AstPtr& ast, const ParsedArgs& args,
+                                  ASTVisitor* visitor) {
+  PX_ASSIGN_OR_RETURN(std::vector<std::string> sort_cols,
+                      ParseAsListOfStrings(args.GetArg("by"), "by"));
+  PX_ASSIGN_OR_RETURN(std::vector<BoolIR*> ascending_irs,
+                      ParseAsListOf<BoolIR>(args.GetArg("ascending"), "ascending"));
+  if (ascending_irs.size() != 1 && ascending_irs.size() != sort_cols.size()) {
+    return CreateAstError(ast, "Length of 'ascending' ($0) must match the length of 'by' ($1)",
+                          ascending_irs.size(), sort_cols.size());
+  }
+  // A single ascending value applies to all of the sort columns.
+  std::vector<bool> ascending;
+  for (size_t i = 0; i < sort_cols.size(); ++i) {
+    ascending.push_back(ascending_irs[ascending_irs.size() == 1 ? 0 : i]->val());
+  }
+
+  PX_ASSIGN_OR_RETURN(SortIR * sort_op, graph->CreateNode<SortIR>(ast, op, sort_cols, ascending));
+  return Dataframe::Create(compiler_state, sort_op, visitor);
+}
+
 class SubscriptHandler {
  public:
   /**
@@ -515,6 +543,23 @@ Status Dataframe::Init() {
   PX_RETURN_IF_ERROR(limitfn->SetDocString(kLimitOpDocstring));
   AddMethod(kLimitOpID, limitfn);
 
+  /**
+   * # Equivalent to the python method method syntax:
+   * def sort_values(self, by, ascending=True):
+   *     ...
+   */
+  PX_ASSIGN_OR_RETURN(
+      std::shared_ptr<FuncObject> sortfn,
+      FuncObject::Create(
+          kSortOpID, {"by", "ascending"}, {{"ascending", "True"}},
+          /* has_variable_len_args */ false,
+          /* has_variable_len_kwargs */ false,
+          std::bind(&SortHandler, compiler_state_, graph(), op(), std::placeholders::_1,
+                    std::placeholders::_2, std::placeholders::_3),
+          ast_visitor()));
+  PX_RETURN_IF_ERROR(sortfn->SetDocString(kSortOpDocstring));
+  AddMethod(kSortOpID, sortfn);
+
   /**
    *
    * # Equivalent to the python method method syntax:
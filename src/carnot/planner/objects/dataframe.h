@@ -281,6 +281,31 @@ class Dataframe : public QLObject {
     px.DataFrame: DataFrame with the first n rows.
   )doc";
 
+  inline static constexpr char kSortOpID[] = "sort_values";
+  inline static constexpr char kSortOpDocstring[] = R"doc(
+  Sort the rows by the values of one or more columns.
+
+  Returns a DataFrame with the rows sorted by the passed in columns, in order of precedence.
+  Following the sort with `head()` only keeps the first n rows of each agent before the rows are
+  merged, instead of sending every row.
+
+  :topic: dataframe_ops
+  :opname: Sort
+
+  Examples:
+    df = px.DataFrame('http_events')
+    # Keep the 10 slowest http requests.
+    df = df.sort_values('latency', ascending=False).head(10)
+
+  Args:
+    by (Union[string, List[string]]): The column(s) to sort by.
+    ascending (Union[bool, List[bool]]): Whether to sort in ascending order, either for all of the
+      columns or for each of them. Default is True.
+
+  Returns:
+    px.DataFrame: DataFrame with the sorted rows.
+  )doc";
+
   inline static constexpr char kMergeOpID[] = "merge";
   inline static constexpr char kMergeOpDocstring[] = R"doc(
   Merges the input DataFrame with this one using a database-style join.
@@ -397,8 +422,8 @@ class Dataframe : public QLObject {
     window (px.Duration): the size of the rolling window.
 
   Returns:
-    px.DataFrame: DataFrame grouped into rolling windows. Must apply either a groupby or an aggregate on the
-    returned DataFrame.
+    px.DataFrame: DataFrame grouped into rolling windows. Must apply an aggregate on the returned
+    DataFrame, which outputs the start of each window in the window column.
   )doc";
 
   inline static constexpr char kStreamOpId[] = "stream";
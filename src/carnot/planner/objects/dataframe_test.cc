@@ -234,6 +234,32 @@ TEST_F(DataframeTest, LimitNonIntArgument) {
               HasCompilerError("Expected arg 'n' as type 'Int', received 'String'"));
 }
 
+TEST_F(DataframeTest, CreateSort) {
+  ASSERT_OK(
+      ParseScript(var_table, "sorted = df.sort_values(['service', 'latency'], [True, False])"));
+  auto var = var_table->Lookup("sorted");
+  ASSERT_EQ(var->type_descriptor().type(), QLObjectType::kDataframe);
+  auto sort_obj = std::static_pointer_cast<Dataframe>(var);
+
+  ASSERT_MATCH(sort_obj->op(), Sort());
+  SortIR* sort = static_cast<SortIR*>(sort_obj->op());
+  EXPECT_THAT(sort->sort_cols(), ElementsAre("service", "latency"));
+  EXPECT_THAT(sort->ascending(), ElementsAre(true, false));
+  EXPECT_EQ(sort->limit(), 0);
+}
+
+TEST_F(DataframeTest, SortSingleAscendingValue) {
+  ASSERT_OK(ParseScript(var_table, "sorted = df.sort_values(['service', 'latency'], False)"));
+  auto sort_obj = std::static_pointer_cast<Dataframe>(var_table->Lookup("sorted"));
+  SortIR* sort = static_cast<SortIR*>(sort_obj->op());
+  EXPECT_THAT(sort->ascending(), ElementsAre(false, false));
+}
+
+TEST_F(DataframeTest, SortAscendingLengthMismatch) {
+  EXPECT_THAT(ParseScript(var_table, "df.sort_values(['service', 'latency'], [True])"),
+              HasCompilerError("Length of 'ascending' \\(1\\) must match the length of 'by'"));
+}
+
 TEST_F(DataframeTest, SubscriptFilterRows) {
   ASSERT_OK(ParseScript(var_table, "filter = df[df.service == 'blah']"));
   auto var = var_table->Lookup("filter");
@@ -367,6 +393,24 @@ TEST_F(DataframeTest, ConstructorTest) {
   EXPECT_EQ(mem_src->table_name(), "http_events");
 }
 
+TEST_F(DataframeTest, ConstructorRelativeTimes) {
+  ASSERT_OK_AND_ASSIGN(std::shared_ptr<Dataframe> df,
+                       Dataframe::Create(compiler_state.get(), graph.get(), ast_visitor.get()));
+  var_table->Add("DataFrame", df);
+  ASSERT_OK(
+      ParseScript(var_table, "http = DataFrame('http_events', start_time='-5m', end_time=10)"));
+  auto df_obj = static_cast<Dataframe*>(var_table->Lookup("http").get());
+
+  ASSERT_MATCH(df_obj->op(), MemorySource());
+  MemorySourceIR* mem_src = static_cast<MemorySourceIR*>(df_obj->op());
+  EXPECT_EQ(-5 * 60 * 1000 * 1000 * 1000LL, mem_src->time_start_ns());
+  EXPECT_TRUE(mem_src->time_start_relative());
+  EXPECT_EQ(10, mem_src->time_stop_ns());
+  EXPECT_FALSE(mem_src->time_stop_relative());
+  // The relative times are parameters of the plan, so it can still be run at another time.
+  EXPECT_FALSE(compiler_state->time_now_in_plan());
+}
+
 TEST_F(DataframeTest, StreamTest) {
   ASSERT_OK(ParseScript(var_table, "s = df.stream()"));
   auto var = var_table->Lookup("s");
@@ -407,6 +407,18 @@ TEST_F(PixieModuleTest, parse_time) {
   }
 }
 
+TEST_F(PixieModuleTest, time_now_in_plan) {
+  ASSERT_OK(ParseExpression("px.parse_time(100)"));
+  EXPECT_FALSE(compiler_state_->time_now_in_plan());
+  ASSERT_OK(ParseExpression("px.parse_time('-5m')"));
+  EXPECT_TRUE(compiler_state_->time_now_in_plan());
+}
+
+TEST_F(PixieModuleTest, now_in_plan) {
+  ASSERT_OK(ParseExpression("px.now()"));
+  EXPECT_TRUE(compiler_state_->time_now_in_plan());
+}
+
 TEST_F(PixieModuleTest, plugin_module) {
   EXPECT_COMPILER_ERROR(ParseExpression("px.plugin.start_time"), "No plugin config found");
 }
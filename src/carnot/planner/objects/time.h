@@ -35,6 +35,8 @@ namespace planner {
 namespace compiler {
 
 StatusOr<int64_t> ParseAllTimeFormats(int64_t time_now, ExpressionIR* time_expr);
+// Whether ParseAllTimeFormats resolves the expression relative to time_now, e.g. "-5m".
+bool IsRelativeTime(ExpressionIR* time_expr);
 
 }  // namespace compiler
 }  // namespace planner
@@ -74,6 +74,21 @@ class AnyUDA : public BaseFunc {
  *      Status Init(FunctionContext *ctx, UDFValue... init_args) {}
  *  This function is called once during initialization of each instance (many instances
  *  may exists in a given query). The arguments are as provided by the query.
+ *
+ * It can also _optionally_ implement a batch version of Exec:
+ *      void ExecBatch(FunctionContext *ctx, size_t count, UDFValue* out,
+ *                     const UDFValue*... values) {}
+ *  The arguments and the output are contiguous arrays of count values, with the same types as
+ *  Exec. When present, it is called once per batch instead of calling Exec for every record,
+ *  which lets simple functions run as tight (vectorizable) loops. It must produce the same
+ *  results as Exec.
+ *
+ * A UDF whose Exec only depends on its arguments, at least for the lifetime of a query, can
+ * declare it with:
+ *      static constexpr bool Deterministic() { return true; }
+ *  Single argument deterministic UDFs are run once per distinct value of a batch, and the results
+ *  are copied to the other rows. This is a big win for lookups such as the metadata UDFs, whose
+ *  inputs usually take few values.
  */
 class ScalarUDF : public AnyUDF {
  public:
@@ -167,6 +182,44 @@ struct has_udf_executor_fn<T, std::void_t<decltype(&T::Executor)>> : std::true_t
       "If an executor function exists, it must have the form: UDFSourceExecutor Executor()");
 };
 
+/**
+ * Checks to see if a valid looking ExecBatch function exists. It must match the Exec function of
+ * the UDF, with the arguments and return value passed as arrays.
+ */
+template <typename TExecFn, typename TExecBatchFn>
+static constexpr bool IsValidExecBatchFn(TExecFn, TExecBatchFn) {
+  return false;
+}
+
+template <typename ReturnType, typename TUDF, typename... Types>
+static constexpr bool IsValidExecBatchFn(ReturnType (TUDF::*)(FunctionContext*, Types...),
+                                         void (TUDF::*)(FunctionContext*, size_t, ReturnType*,
+                                                        const Types*...)) {
+  return true;
+}
+
+// SFINAE test for ExecBatch fn.
+template <typename T, typename = void>
+struct has_udf_exec_batch_fn : std::false_type {};
+
+template <typename T>
+struct has_udf_exec_batch_fn<T, std::void_t<decltype(&T::ExecBatch)>> : std::true_type {
+  static_assert(IsValidExecBatchFn(&T::Exec, &T::ExecBatch),
+                "If an ExecBatch function exists, it must have the form: void "
+                "ExecBatch(FunctionContext*, size_t, UDFValue* out, const UDFValue*...)");
+};
+
+// SFINAE test for Deterministic fn.
+template <typename T, typename = void>
+struct has_udf_deterministic_fn : std::false_type {};
+
+template <typename T>
+struct has_udf_deterministic_fn<T, std::void_t<decltype(&T::Deterministic)>> : std::true_type {
+  static_assert(std::is_same_v<decltype(&T::Deterministic), bool (*)()>,
+                "If a deterministic function exists, it must have the form: "
+                "static constexpr bool Deterministic()");
+};
+
 template <typename T, typename = void>
 struct check_executor_fn {};
 
@@ -228,6 +281,24 @@ class ScalarUDFTraits {
    */
   static constexpr bool HasExecutor() { return has_udf_executor_fn<T>::value; }
 
+  /**
+   * Checks if the UDF has an ExecBatch function.
+   * @return true if it has an ExecBatch function.
+   */
+  static constexpr bool HasExecBatch() { return has_udf_exec_batch_fn<T>::value; }
+
+  /**
+   * Checks if the results of the UDF only depend on its arguments.
+   * @return true if it has a Deterministic function which returns true.
+   */
+  static constexpr bool IsDeterministic() {
+    if constexpr (has_udf_deterministic_fn<T>::value) {
+      return T::Deterministic();
+    } else {
+      return false;
+    }
+  }
+
   template <typename Q = T, std::enable_if_t<ScalarUDFTraits<Q>::HasInit(), void>* = nullptr>
   static constexpr auto InitArguments() {
     return GetArgumentTypesHelper(&Q::Init);
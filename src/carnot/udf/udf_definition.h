@@ -94,7 +94,14 @@ class ScalarUDFDefinition : public UDFDefinition {
     auto exec_arguments_array = ScalarUDFTraits<TUDF>::ExecArguments();
     exec_arguments_ = {begin(exec_arguments_array), end(exec_arguments_array)};
     exec_wrapper_fn_ = ScalarUDFWrapper<TUDF>::ExecBatch;
+    exec_per_row_wrapper_fn_ = ScalarUDFWrapper<TUDF>::ExecBatchPerRow;
+    has_exec_batch_ = ScalarUDFTraits<TUDF>::HasExecBatch();
     exec_wrapper_arrow_fn_ = ScalarUDFWrapper<TUDF>::ExecBatchArrow;
+    if constexpr (ScalarUDFTraits<TUDF>::IsDeterministic() &&
+                  ScalarUDFTraits<TUDF>::ExecArguments().size() == 1) {
+      memoized_exec_wrapper_fn_ = ScalarUDFWrapper<TUDF>::ExecBatchMemoized;
+      memoized_exec_wrapper_arrow_fn_ = ScalarUDFWrapper<TUDF>::ExecBatchArrowMemoized;
+    }
     init_wrapper_fn_ = ScalarUDFWrapper<TUDF>::ExecInit;
 
     auto init_arguments_array = ScalarUDFTraits<TUDF>::InitArguments();
@@ -125,12 +132,40 @@ class ScalarUDFDefinition : public UDFDefinition {
     return exec_wrapper_fn_(udf, ctx, inputs, output, count);
   }
 
+  /**
+   * Executes the batch by calling the Exec function of the UDF for each row, bypassing its
+   * ExecBatch function if it has one. Mostly useful to compare the two.
+   */
+  Status ExecBatchPerRow(ScalarUDF* udf, FunctionContext* ctx,
+                         const std::vector<const types::ColumnWrapper*>& inputs,
+                         types::ColumnWrapper* output, int count) {
+    return exec_per_row_wrapper_fn_(udf, ctx, inputs, output, count);
+  }
+
   Status ExecBatchArrow(ScalarUDF* udf, FunctionContext* ctx,
                         const std::vector<arrow::Array*>& inputs, arrow::ArrayBuilder* output,
                         int count) {
     return exec_wrapper_arrow_fn_(udf, ctx, inputs, output, count);
   }
 
+  /**
+   * Executes the batch by calling the Exec function of the UDF once per distinct value of its
+   * argument. Only valid when memoizable() is true.
+   */
+  Status ExecBatchMemoized(ScalarUDF* udf, FunctionContext* ctx,
+                           const std::vector<const types::ColumnWrapper*>& inputs,
+                           types::ColumnWrapper* output, int count) {
+    DCHECK(memoizable());
+    return memoized_exec_wrapper_fn_(udf, ctx, inputs, output, count);
+  }
+
+  Status ExecBatchArrowMemoized(ScalarUDF* udf, FunctionContext* ctx,
+                                const std::vector<arrow::Array*>& inputs,
+                                arrow::ArrayBuilder* output, int count) {
+    DCHECK(memoizable());
+    return memoized_exec_wrapper_arrow_fn_(udf, ctx, inputs, output, count);
+  }
+
   Status ExecInit(ScalarUDF* udf, FunctionContext* ctx,
                   const std::vector<std::shared_ptr<types::BaseValueType>>& inputs) {
     return init_wrapper_fn_(udf, ctx, inputs);
@@ -144,6 +179,11 @@ class ScalarUDFDefinition : public UDFDefinition {
   const std::vector<types::DataType>& exec_arguments() const { return exec_arguments_; }
   const std::vector<types::DataType>& init_arguments() const { return init_arguments_; }
   udfspb::UDFSourceExecutor executor() const { return executor_; }
+  // Whether ExecBatch runs the UDF's own ExecBatch function instead of Exec per row.
+  bool has_exec_batch() const { return has_exec_batch_; }
+  // Whether the UDF is deterministic with a single argument, so it can be run once per distinct
+  // value of a batch.
+  bool memoizable() const { return memoized_exec_wrapper_fn_ != nullptr; }
 
   const std::vector<types::DataType>& RegistryArgTypes() override { return registry_arguments_; }
   size_t Arity() const { return exec_arguments_.size(); }
@@ -155,16 +195,29 @@ class ScalarUDFDefinition : public UDFDefinition {
   std::vector<types::DataType> registry_arguments_;
   types::DataType exec_return_type_;
   udfspb::UDFSourceExecutor executor_;
+  bool has_exec_batch_ = false;
   std::function<std::unique_ptr<ScalarUDF>()> make_fn_;
   std::function<Status(ScalarUDF*, FunctionContext* ctx,
                        const std::vector<const types::ColumnWrapper*>& inputs,
                        types::ColumnWrapper* output, int count)>
       exec_wrapper_fn_;
+  std::function<Status(ScalarUDF*, FunctionContext* ctx,
+                       const std::vector<const types::ColumnWrapper*>& inputs,
+                       types::ColumnWrapper* output, int count)>
+      exec_per_row_wrapper_fn_;
+  std::function<Status(ScalarUDF*, FunctionContext* ctx,
+                       const std::vector<const types::ColumnWrapper*>& inputs,
+                       types::ColumnWrapper* output, int count)>
+      memoized_exec_wrapper_fn_;
 
   std::function<Status(ScalarUDF* udf, FunctionContext* ctx,
                        const std::vector<arrow::Array*>& inputs, arrow::ArrayBuilder* output,
                        int count)>
       exec_wrapper_arrow_fn_;
+  std::function<Status(ScalarUDF* udf, FunctionContext* ctx,
+                       const std::vector<arrow::Array*>& inputs, arrow::ArrayBuilder* output,
+                       int count)>
+      memoized_exec_wrapper_arrow_fn_;
 
   std::function<Status(ScalarUDF* udf, FunctionContext* ctx,
                        const std::vector<std::shared_ptr<types::BaseValueType>>& inputs)>
@@ -196,6 +249,7 @@ class UDADefinition : public UDFDefinition {
     make_fn_ = UDAWrapper<T>::Make;
     exec_batch_update_fn_ = UDAWrapper<T>::ExecBatchUpdate;
     exec_batch_update_arrow_fn_ = UDAWrapper<T>::ExecBatchUpdateArrow;
+    exec_batch_update_arrow_selected_fn_ = UDAWrapper<T>::ExecBatchUpdateArrowSelected;
     init_wrapper_fn_ = UDAWrapper<T>::ExecInit;
 
     auto init_arguments_array = UDATraits<T>::InitArguments();
@@ -235,6 +289,12 @@ class UDADefinition : public UDFDefinition {
                               const std::vector<const arrow::Array*>& inputs) {
     return exec_batch_update_arrow_fn_(uda, ctx, inputs);
   }
+  // Updates the UDA with the rows of the inputs at the `count` indices in selection.
+  Status ExecBatchUpdateArrowSelected(UDA* uda, FunctionContext* ctx,
+                                      const std::vector<const arrow::Array*>& inputs,
+                                      const uint32_t* selection, size_t count) {
+    return exec_batch_update_arrow_selected_fn_(uda, ctx, inputs, selection, count);
+  }
 
   Status ExecInit(UDA* uda, FunctionContext* ctx,
                   const std::vector<std::shared_ptr<types::BaseValueType>>& inputs) {
@@ -271,6 +331,11 @@ class UDADefinition : public UDFDefinition {
                        const std::vector<const arrow::Array*>& inputs)>
       exec_batch_update_arrow_fn_;
 
+  std::function<Status(UDA* uda, FunctionContext* ctx,
+                       const std::vector<const arrow::Array*>& inputs, const uint32_t* selection,
+                       size_t count)>
+      exec_batch_update_arrow_selected_fn_;
+
   std::function<Status(UDA* uda, FunctionContext* ctx, arrow::ArrayBuilder* output)>
       finalize_arrow_fn_;
   std::function<Status(UDA* uda, FunctionContext* ctx, types::BaseValueType* output)>
@@ -52,6 +52,24 @@ class AddUDF : public ScalarUDF {
   }
 };
 
+class BatchAddUDF : public ScalarUDF {
+ public:
+  types::Int64Value Exec(FunctionContext*, types::Int64Value v1, types::Int64Value v2) {
+    ++exec_calls;
+    return v1.val + v2.val;
+  }
+  void ExecBatch(FunctionContext*, size_t count, types::Int64Value* out,
+                 const types::Int64Value* v1, const types::Int64Value* v2) {
+    ++exec_batch_calls;
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = v1[i].val + v2[i].val;
+    }
+  }
+
+  int exec_calls = 0;
+  int exec_batch_calls = 0;
+};
+
 class InitArgUDF : public ScalarUDF {
  public:
   Status Init(FunctionContext*, types::StringValue str, types::Int64Value i) {
@@ -88,6 +106,7 @@ TEST(UDFDefinition, two_args) {
   auto ctx = FunctionContext(nullptr, nullptr);
   ScalarUDFDefinition def("add");
   EXPECT_OK(def.Init<AddUDF>());
+  EXPECT_FALSE(def.has_exec_batch());
 
   types::Int64ValueColumnWrapper v1({1, 2, 3});
   types::Int64ValueColumnWrapper v2({3, 4, 5});
@@ -100,6 +119,34 @@ TEST(UDFDefinition, two_args) {
   EXPECT_EQ(8, out[2].val);
 }
 
+TEST(UDFDefinition, exec_batch) {
+  auto ctx = FunctionContext(nullptr, nullptr);
+  ScalarUDFDefinition def("add");
+  EXPECT_OK(def.Init<BatchAddUDF>());
+  EXPECT_TRUE(def.has_exec_batch());
+
+  types::Int64ValueColumnWrapper v1({1, 2, 3});
+  types::Int64ValueColumnWrapper v2({3, 4, 5});
+  types::Int64ValueColumnWrapper out(v1.Size());
+  auto u = def.Make();
+  auto* udf = static_cast<BatchAddUDF*>(u.get());
+
+  EXPECT_OK(def.ExecBatch(u.get(), &ctx, {&v1, &v2}, &out, v1.Size()));
+  EXPECT_EQ(1, udf->exec_batch_calls);
+  EXPECT_EQ(0, udf->exec_calls);
+  EXPECT_EQ(4, out[0].val);
+  EXPECT_EQ(6, out[1].val);
+  EXPECT_EQ(8, out[2].val);
+
+  types::Int64ValueColumnWrapper per_row_out(v1.Size());
+  EXPECT_OK(def.ExecBatchPerRow(u.get(), &ctx, {&v1, &v2}, &per_row_out, v1.Size()));
+  EXPECT_EQ(1, udf->exec_batch_calls);
+  EXPECT_EQ(3, udf->exec_calls);
+  EXPECT_EQ(4, per_row_out[0].val);
+  EXPECT_EQ(6, per_row_out[1].val);
+  EXPECT_EQ(8, per_row_out[2].val);
+}
+
 TEST(UDFDefinition, str_args) {
   auto ctx = FunctionContext(nullptr, nullptr);
   ScalarUDFDefinition def("substr");
@@ -57,12 +57,25 @@ class AddUDF : public ScalarUDF {
   Int64Value Exec(FunctionContext*, Int64Value v1, Int64Value v2) { return v1.val + v2.val; }
 };
 
+// Same as AddUDF, but executes a whole batch at a time.
+class BatchAddUDF : public ScalarUDF {
+ public:
+  Int64Value Exec(FunctionContext*, Int64Value v1, Int64Value v2) { return v1.val + v2.val; }
+  void ExecBatch(FunctionContext*, size_t count, Int64Value* out, const Int64Value* v1,
+                 const Int64Value* v2) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = v1[i].val + v2[i].val;
+    }
+  }
+};
+
 class SubStrUDF : public ScalarUDF {
  public:
   StringValue Exec(FunctionContext*, StringValue v1) { return v1.substr(1, 2); }
 };
 
 // This benchmark add two columns using Int64ValueVectors.
+template <typename TUDF>
 // NOLINTNEXTLINE : runtime/references.
 static void BM_AddInt64Values(benchmark::State& state) {
   auto vec1 = CreateLargeData<Int64Value>(state.range(0));
@@ -75,7 +88,7 @@ static void BM_AddInt64Values(benchmark::State& state) {
 
   // Create the UDF.
   ScalarUDFDefinition def("add");
-  CHECK(def.template Init<AddUDF>().ok());
+  CHECK(def.template Init<TUDF>().ok());
   auto u = def.Make();
 
   // Loop the test.
@@ -94,6 +107,7 @@ static void BM_AddInt64Values(benchmark::State& state) {
   }
 
   state.SetBytesProcessed(int64_t(state.iterations()) * 2 * vec1.size() * sizeof(int64_t));
+  state.SetItemsProcessed(int64_t(state.iterations()) * vec1.size());
 }
 
 // This benchmark performs a substring on 10 char wide strings,
@@ -246,7 +260,8 @@ static void BM_SubStrArrow(benchmark::State& state) {
 
 BENCHMARK(BM_AddInt64ValueToArrow)->RangeMultiplier(2)->Range(1, 1 << 16);
 BENCHMARK(BM_AddTwoInt64sArrow)->RangeMultiplier(2)->Range(1, 1 << 16);
-BENCHMARK(BM_AddInt64Values)->RangeMultiplier(2)->Range(1, 1 << 16);
+BENCHMARK_TEMPLATE(BM_AddInt64Values, AddUDF)->RangeMultiplier(2)->Range(1, 1 << 16);
+BENCHMARK_TEMPLATE(BM_AddInt64Values, BatchAddUDF)->RangeMultiplier(2)->Range(1, 1 << 16);
 
 BENCHMARK(BM_ConvertToArrowString)->RangeMultiplier(2)->Range(1, 1 << 16);
 BENCHMARK(BM_ConvertToArrowInt64)->RangeMultiplier(2)->Range(1, 1 << 16);
@@ -43,12 +43,20 @@ class ScalarUDF1WithInit : ScalarUDF {
   types::Int64Value Exec(FunctionContext*, types::BoolValue, types::BoolValue) { return 0; }
 };
 
+class DeterministicScalarUDF : ScalarUDF {
+ public:
+  types::Int64Value Exec(FunctionContext*, types::Int64Value) { return 0; }
+  static constexpr bool Deterministic() { return true; }
+};
+
 TEST(ScalarUDF, basic_tests) {
   EXPECT_EQ(types::DataType::INT64, ScalarUDFTraits<ScalarUDF1>::ReturnType());
   EXPECT_THAT(ScalarUDFTraits<ScalarUDF1>::ExecArguments(),
               ElementsAre(types::DataType::BOOLEAN, types::DataType::INT64));
   EXPECT_FALSE(ScalarUDFTraits<ScalarUDF1>::HasInit());
   EXPECT_TRUE(ScalarUDFTraits<ScalarUDF1WithInit>::HasInit());
+  EXPECT_FALSE(ScalarUDFTraits<ScalarUDF1>::IsDeterministic());
+  EXPECT_TRUE(ScalarUDFTraits<DeterministicScalarUDF>::IsDeterministic());
 }
 
 TEST(UDFDataTypes, valid_tests) {
@@ -22,8 +22,12 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include <absl/container/flat_hash_map.h>
+
 #include "src/carnot/udf/udf.h"
 #include "src/carnot/udf/udtf.h"
 #include "src/common/base/base.h"
@@ -69,6 +73,22 @@ Status ExecWrapper(TUDF* udf, FunctionContext* ctx, size_t count, TOutput* out,
   return Status::OK();
 }
 
+/**
+ * This is the inner wrapper for UDFs that implement ExecBatch. The arguments are cast to
+ * arrays of the UDF value types and the ExecBatch function of the UDF is called once for the
+ * whole batch.
+ *
+ * @return Status of execution.
+ */
+template <typename TUDF, typename TOutput, std::size_t... I>
+Status ExecBatchWrapper(TUDF* udf, FunctionContext* ctx, size_t count, TOutput* out,
+                        const std::vector<const types::BaseValueType*>& args,
+                        std::index_sequence<I...>) {
+  [[maybe_unused]] constexpr auto exec_argument_types = ScalarUDFTraits<TUDF>::ExecArguments();
+  udf->ExecBatch(ctx, count, out, CastToUDFValueType<exec_argument_types[I]>(args[I])...);
+  return Status::OK();
+}
+
 template <typename TUDF, std::size_t... I>
 Status InitWrapper(TUDF* udf, FunctionContext* ctx,
                    const std::vector<std::shared_ptr<types::BaseValueType>>& args,
@@ -133,6 +153,106 @@ Status ExecWrapperArrow(TUDF* udf, FunctionContext* ctx, size_t count, TOutput*
   return Status::OK();
 }
 
+// Returns the key that the results of a memoized UDF are stored under for a UDF value. Strings
+// are viewed in place, since the arguments outlive the memo.
+template <typename T>
+inline auto MemoKey(const T& v) {
+  return v.val;
+}
+
+template <>
+inline auto MemoKey<types::StringValue>(const types::StringValue& s) {
+  return std::string_view(s);
+}
+
+// Memoized UDFs stop adding distinct values once they make up more than this fraction of the
+// rows of the batch, since the hash lookups would then cost more than they save.
+constexpr double kMaxMemoizedDistinctFraction = 0.5;
+
+inline size_t MaxMemoizedDistinctValues(size_t count) {
+  return static_cast<size_t>(count * kMaxMemoizedDistinctFraction) + 1;
+}
+
+/**
+ * This is the inner wrapper for deterministic UDFs with a single argument. Exec is called once
+ * for each distinct value of the argument, and the result is copied to the other rows with
+ * that value.
+ *
+ * @return Status of execution.
+ */
+template <typename TUDF, typename TOutput>
+Status ExecMemoizedWrapper(TUDF* udf, FunctionContext* ctx, size_t count, TOutput* out,
+                           const types::BaseValueType* arg) {
+  constexpr auto exec_argument_types = ScalarUDFTraits<TUDF>::ExecArguments();
+  const auto* values = CastToUDFValueType<exec_argument_types[0]>(arg);
+  const size_t max_distinct = MaxMemoizedDistinctValues(count);
+  // The first row of each distinct value, whose output holds the result.
+  absl::flat_hash_map<decltype(MemoKey(values[0])), size_t> first_rows;
+  for (size_t idx = 0; idx < count; ++idx) {
+    if (first_rows.size() < max_distinct) {
+      auto [it, inserted] = first_rows.try_emplace(MemoKey(values[idx]), idx);
+      if (!inserted) {
+        out[idx] = out[it->second];
+        continue;
+      }
+    } else if (auto it = first_rows.find(MemoKey(values[idx])); it != first_rows.end()) {
+      out[idx] = out[it->second];
+      continue;
+    }
+    out[idx] = udf->Exec(ctx, values[idx]);
+  }
+  return Status::OK();
+}
+
+/**
+ * The arrow version of ExecMemoizedWrapper. The distinct results are computed first, so the
+ * exact amount of string data can be reserved before they are appended.
+ *
+ * @return Status of execution.
+ */
+template <typename TUDF, typename TOutput>
+Status ExecMemoizedWrapperArrow(TUDF* udf, FunctionContext* ctx, size_t count, TOutput* out,
+                                arrow::Array* arg) {
+  static constexpr auto exec_argument_types = ScalarUDFTraits<TUDF>::ExecArguments();
+  using TValue =
+      std::decay_t<decltype(types::GetValueFromArrowArray<exec_argument_types[0]>(arg, 0))>;
+  using TResult = std::decay_t<decltype(UnWrap(udf->Exec(ctx, std::declval<TValue>())))>;
+
+  const size_t max_distinct = MaxMemoizedDistinctValues(count);
+  absl::flat_hash_map<TValue, uint32_t> result_idx_by_value;
+  std::vector<TResult> results;
+  // The index in results of the result of each row.
+  std::vector<uint32_t> row_results(count);
+  for (size_t idx = 0; idx < count; ++idx) {
+    auto value = types::GetValueFromArrowArray<exec_argument_types[0]>(arg, idx);
+    auto it = result_idx_by_value.find(value);
+    if (it != result_idx_by_value.end()) {
+      row_results[idx] = it->second;
+      continue;
+    }
+    row_results[idx] = results.size();
+    results.push_back(UnWrap(udf->Exec(ctx, value)));
+    if (result_idx_by_value.size() < max_distinct) {
+      result_idx_by_value.emplace(std::move(value), row_results[idx]);
+    }
+  }
+
+  PX_RETURN_IF_ERROR(out->Reserve(count));
+  // PX_CARNOT_UPDATE_FOR_NEW_TYPES.
+  if constexpr (std::is_same_v<arrow::StringBuilder, TOutput>) {
+    size_t total_size = 0;
+    for (const auto result_idx : row_results) {
+      total_size += results[result_idx].size();
+    }
+    PX_RETURN_IF_ERROR(out->ReserveData(total_size));
+  }
+  for (const auto result_idx : row_results) {
+    // This function is "safe" now because we manually allocated memory.
+    out->UnsafeAppend(results[result_idx]);
+  }
+  return Status::OK();
+}
+
 /**
  * Checks types between column wrapper and array of types::UDFDataTypes.
  * @return true if all types match.
@@ -242,11 +362,77 @@ struct ScalarUDFWrapper {
     // The outer wrapper just casts the output type and UDF type. We then pass in
     // the inputs with a sequence based on the number of arguments to iterate through and
     // cast the inputs.
+    if constexpr (ScalarUDFTraits<TUDF>::HasExecBatch()) {
+      return ExecBatchWrapper<TUDF>(static_cast<TUDF*>(udf), ctx, count, casted_output,
+                                    input_as_base_value,
+                                    std::make_index_sequence<exec_argument_types.size()>{});
+    } else {
+      return ExecWrapper<TUDF>(static_cast<TUDF*>(udf), ctx, count, casted_output,
+                               input_as_base_value,
+                               std::make_index_sequence<exec_argument_types.size()>{});
+    }
+  }
+
+  /**
+   * Same as ExecBatch, but always calls the Exec function of the UDF for each row, even if the
+   * UDF implements ExecBatch.
+   */
+  static Status ExecBatchPerRow(ScalarUDF* udf, FunctionContext* ctx,
+                                const std::vector<const types::ColumnWrapper*>& inputs,
+                                types::ColumnWrapper* output, int count) {
+    DCHECK(output != nullptr);
+    DCHECK(inputs.size() == ScalarUDFTraits<TUDF>::ExecArguments().size());
+
+    constexpr types::DataType return_type = ScalarUDFTraits<TUDF>::ReturnType();
+    auto exec_argument_types = ScalarUDFTraits<TUDF>::ExecArguments();
+    DCHECK(CheckTypes(inputs, exec_argument_types));
+    auto input_as_base_value = ConvertToBaseValue(inputs);
+
+    using output_type = typename types::DataTypeTraits<return_type>::value_type;
+    auto* casted_output = static_cast<output_type*>(output->UnsafeRawData());
     return ExecWrapper<TUDF>(static_cast<TUDF*>(udf), ctx, count, casted_output,
                              input_as_base_value,
                              std::make_index_sequence<exec_argument_types.size()>{});
   }
 
+  /**
+   * Executes a deterministic, single argument UDF on a batch, calling its Exec function once per
+   * distinct value of the argument. Takes the same arguments as ExecBatch.
+   */
+  static Status ExecBatchMemoized(ScalarUDF* udf, FunctionContext* ctx,
+                                  const std::vector<const types::ColumnWrapper*>& inputs,
+                                  types::ColumnWrapper* output, int count) {
+    static_assert(ScalarUDFTraits<TUDF>::ExecArguments().size() == 1,
+                  "Only single argument UDFs can be memoized");
+    DCHECK(output != nullptr);
+    DCHECK(inputs.size() == 1);
+    DCHECK(CheckTypes(inputs, ScalarUDFTraits<TUDF>::ExecArguments()));
+
+    constexpr types::DataType return_type = ScalarUDFTraits<TUDF>::ReturnType();
+    using output_type = typename types::DataTypeTraits<return_type>::value_type;
+    auto* casted_output = static_cast<output_type*>(output->UnsafeRawData());
+    return ExecMemoizedWrapper<TUDF>(static_cast<TUDF*>(udf), ctx, count, casted_output,
+                                     inputs[0]->UnsafeRawData());
+  }
+
+  /**
+   * The arrow version of ExecBatchMemoized. Takes the same arguments as ExecBatchArrow.
+   */
+  static Status ExecBatchArrowMemoized(ScalarUDF* udf, FunctionContext* ctx,
+                                       const std::vector<arrow::Array*>& inputs,
+                                       arrow::ArrayBuilder* output, int count) {
+    static_assert(ScalarUDFTraits<TUDF>::ExecArguments().size() == 1,
+                  "Only single argument UDFs can be memoized");
+    DCHECK(output != nullptr);
+    DCHECK(inputs.size() == 1);
+
+    constexpr types::DataType return_type = ScalarUDFTraits<TUDF>::ReturnType();
+    return ExecMemoizedWrapperArrow<TUDF>(
+        static_cast<TUDF*>(udf), ctx, count,
+        static_cast<typename types::DataTypeTraits<return_type>::arrow_builder_type*>(output),
+        inputs[0]);
+  }
+
   /**
    * Call the UDF's init method.
    *
@@ -310,6 +496,22 @@ Status UpdateWrapperArrow(TUDA* uda, FunctionContext* ctx, size_t count,
   return Status::OK();
 }
 
+/**
+ * Performs an update on the selected records of a batch (arrow).
+ * The selection holds the row indices to update with, in the order they are applied.
+ */
+template <typename TUDA, std::size_t... I>
+Status UpdateWrapperArrowSelected(TUDA* uda, FunctionContext* ctx, const uint32_t* selection,
+                                  size_t count, const std::vector<const arrow::Array*>& args,
+                                  std::index_sequence<I...>) {
+  constexpr auto update_argument_types = UDATraits<TUDA>::UpdateArgumentTypes();
+  for (size_t idx = 0; idx < count; ++idx) {
+    uda->Update(ctx, types::GetValueFromArrowArray<update_argument_types[I]>(args[I],
+                                                                             selection[idx])...);
+  }
+  return Status::OK();
+}
+
 /**
  * Provides a set of static methods that wrap UDAs and allow vectorized execution (for update).
  * @tparam TUDA The UDA class.
@@ -362,6 +564,25 @@ struct UDAWrapper {
                                     std::make_index_sequence<update_argument_types.size()>{});
   }
 
+  /**
+   * Perform a batch update of the passed in UDA with the selected rows of the inputs.
+   * @param uda The UDA instances.
+   * @param ctx The function context.
+   * @param inputs A vector of pointers to arrow arrays.
+   * @param selection The indices of the rows to update with.
+   * @param count The number of indices in the selection.
+   * @return Status of update.
+   */
+  static Status ExecBatchUpdateArrowSelected(UDA* uda, FunctionContext* ctx,
+                                             const std::vector<const arrow::Array*>& inputs,
+                                             const uint32_t* selection, size_t count) {
+    constexpr auto update_argument_types = UDATraits<TUDA>::UpdateArgumentTypes();
+    DCHECK(inputs.size() == update_argument_types.size());
+    return UpdateWrapperArrowSelected<TUDA>(
+        static_cast<TUDA*>(uda), ctx, selection, count, inputs,
+        std::make_index_sequence<update_argument_types.size()>{});
+  }
+
   /**
    * Call the UDA's init method.
    *
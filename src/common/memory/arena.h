@@ -0,0 +1,95 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "src/common/base/base.h"
+
+namespace px {
+
+/**
+ * A bump allocator. Memory is carved out of large blocks and is only returned, all at once, by
+ * Reset() or when the arena is destroyed. Not thread safe.
+ */
+class Arena final : public px::NotCopyable {
+ public:
+  static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+  explicit Arena(size_t block_size = kDefaultBlockSize) : block_size_(block_size) {}
+
+  /**
+   * Allocate returns size bytes of memory with the given alignment, which must be a power of two.
+   */
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    bytes_allocated_ += size;
+    if (size + alignment > block_size_ / 4) {
+      // Large allocations get a block of their own, so that the rest of the current block can
+      // still be used.
+      return AlignUp(NewBlock(size + alignment), alignment);
+    }
+    char* aligned = ptr_ == nullptr ? nullptr : AlignUp(ptr_, alignment);
+    if (aligned == nullptr || aligned + size > end_) {
+      ptr_ = NewBlock(block_size_);
+      end_ = ptr_ + block_size_;
+      aligned = AlignUp(ptr_, alignment);
+    }
+    ptr_ = aligned + size;
+    return aligned;
+  }
+
+  /**
+   * Reset frees all of the memory allocated from the arena.
+   */
+  void Reset() {
+    blocks_.clear();
+    ptr_ = nullptr;
+    end_ = nullptr;
+    bytes_allocated_ = 0;
+    bytes_reserved_ = 0;
+  }
+
+  // The number of bytes handed out by Allocate.
+  size_t bytes_allocated() const { return bytes_allocated_; }
+  // The number of bytes held in blocks.
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+ private:
+  static char* AlignUp(char* ptr, size_t alignment) {
+    auto addr = reinterpret_cast<uintptr_t>(ptr);
+    return reinterpret_cast<char*>((addr + alignment - 1) & ~(alignment - 1));
+  }
+
+  char* NewBlock(size_t size) {
+    blocks_.push_back(std::make_unique<char[]>(size));
+    bytes_reserved_ += size;
+    return blocks_.back().get();
+  }
+
+  const size_t block_size_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* ptr_ = nullptr;
+  char* end_ = nullptr;
+  size_t bytes_allocated_ = 0;
+  size_t bytes_reserved_ = 0;
+};
+
+}  // namespace px
@@ -19,10 +19,12 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <absl/base/internal/spinlock.h>
 #include "src/common/base/base.h"
+#include "src/common/memory/arena.h"
 
 namespace px {
 /**
@@ -55,12 +57,34 @@ class ObjectPool final : public px::NotCopyable {
     return entity;
   }
 
+  /**
+   * Construct an entity in memory owned by the pool. This avoids a heap allocation per object for
+   * pools holding many small objects, the memory is returned all at once by Clear().
+   *
+   * @tparam T The entity type to construct.
+   * @param args The arguments to the constructor of T.
+   * @return The pointer to the entity.
+   */
+  template <typename T, typename... Args>
+  T* Make(Args&&... args) {
+    void* mem;
+    {
+      absl::base_internal::SpinLockHolder lock(&lock_);
+      mem = arena_.Allocate(sizeof(T), alignof(T));
+    }
+    T* entity = new (mem) T(std::forward<Args>(args)...);
+    absl::base_internal::SpinLockHolder lock(&lock_);
+    obj_list_.emplace_back(Entity{entity, [](void* obj) { reinterpret_cast<T*>(obj)->~T(); }});
+    return entity;
+  }
+
   void Clear() {
     absl::base_internal::SpinLockHolder lock(&lock_);
     for (auto& obj : obj_list_) {
       obj.delete_fn(obj.obj);
     }
     obj_list_.clear();
+    arena_.Reset();
   }
 
  private:
@@ -76,6 +100,8 @@ class ObjectPool final : public px::NotCopyable {
   const std::string name_;
   absl::base_internal::SpinLock lock_;
   std::vector<Entity> obj_list_;
+  // Backs the entities created with Make.
+  Arena arena_;
 };
 
 }  // namespace px
@@ -16,6 +16,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "src/common/memory/arena.h"
 #include "src/common/memory/object_pool.h"
 #include <gtest/gtest.h>
 
@@ -79,4 +80,40 @@ TEST(object_pool_test, test_different_objects) {
   EXPECT_EQ(1, count2);
 }
 
+TEST(object_pool_test, test_make) {
+  int count = 0;
+  int count2 = 0;
+  {
+    ObjectPool pool;
+    for (int i = 0; i < 10000; ++i) {
+      pool.Make<TestObject>(&count);
+    }
+    pool.Make<TestObjectTwo>(&count2);
+    pool.Add(new TestObject(&count));
+    EXPECT_EQ(0, count);
+    pool.Clear();
+    EXPECT_EQ(10001, count);
+    EXPECT_EQ(1, count2);
+    pool.Make<TestObject>(&count);
+  }
+  EXPECT_EQ(10002, count);
+}
+
+TEST(arena_test, alignment) {
+  Arena arena(1024);
+  arena.Allocate(1, 1);
+  for (size_t alignment : {8, 16, 64}) {
+    auto addr = reinterpret_cast<uintptr_t>(arena.Allocate(3, alignment));
+    EXPECT_EQ(0, addr % alignment);
+  }
+  // Larger than a block.
+  auto addr = reinterpret_cast<uintptr_t>(arena.Allocate(4096, 64));
+  EXPECT_EQ(0, addr % 64);
+  EXPECT_EQ(1 + 3 * 3 + 4096, arena.bytes_allocated());
+  EXPECT_GE(arena.bytes_reserved(), arena.bytes_allocated());
+  arena.Reset();
+  EXPECT_EQ(0, arena.bytes_allocated());
+  EXPECT_EQ(0, arena.bytes_reserved());
+}
+
 }  // namespace px
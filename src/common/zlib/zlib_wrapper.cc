@@ -60,5 +60,32 @@ StatusOr<std::string> Inflate(std::string_view in, size_t output_block_size) {
   return out;
 }
 
+StatusOr<std::string> Deflate(std::string_view in, int level) {
+  z_stream zs = {};
+
+  if (deflateInit2(&zs, level, Z_DEFLATED, MAX_WBITS + 16, /* memLevel */ 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return error::Internal("deflateInit2 failed while compressing.");
+  }
+
+  std::string out(deflateBound(&zs, in.size()), '\0');
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+  zs.avail_in = in.size();
+  zs.next_out = reinterpret_cast<Bytef*>(out.data());
+  zs.avail_out = out.size();
+
+  // The output buffer is sized by deflateBound, so a single call consumes all the input.
+  int ret = deflate(&zs, Z_FINISH);
+  out.resize(zs.total_out);
+
+  deflateEnd(&zs);
+
+  if (ret != Z_STREAM_END) {
+    return error::Internal("Exception during zlib compression: $0", zs.msg);
+  }
+
+  return out;
+}
+
 }  // namespace zlib
 }  // namespace px
@@ -46,4 +46,14 @@ TEST_F(ZlibTest, inflate_test) {
   EXPECT_OK_AND_EQ(result, GetExpectedResult());
 }
 
+TEST_F(ZlibTest, deflate_test) {
+  ASSERT_OK_AND_ASSIGN(std::string compressed, px::zlib::Deflate(GetExpectedResult()));
+  EXPECT_OK_AND_EQ(px::zlib::Inflate(compressed), GetExpectedResult());
+
+  std::string repetitive(16 * 1024, 'a');
+  ASSERT_OK_AND_ASSIGN(compressed, px::zlib::Deflate(repetitive));
+  EXPECT_LT(compressed.size(), repetitive.size() / 10);
+  EXPECT_OK_AND_EQ(px::zlib::Inflate(compressed), repetitive);
+}
+
 }  // namespace px
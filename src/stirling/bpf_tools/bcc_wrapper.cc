@@ -22,7 +22,9 @@
 #include <sys/mount.h>
 
 #include <iostream>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include <magic_enum.hpp>
 
@@ -401,6 +403,58 @@ void BCCWrapperImpl::ClosePerfBuffers() {
   perf_buffer_specs_.clear();
 }
 
+namespace {
+
+// Calls the perf buffer style callback of the ring buffer spec that is the cookie.
+int HandleRingBufferEvent(void* cb_cookie, void* data, size_t data_size) {
+  auto* spec = static_cast<RingBufferSpec*>(cb_cookie);
+  spec->probe_output_fn(spec->cb_cookie, data, static_cast<int>(data_size));
+  return 0;
+}
+
+}  // namespace
+
+bool BCCWrapper::RingBuffersSupported() {
+  constexpr uint32_t kLinux5p8VersionCode = 329728;
+  return system::GetCachedKernelVersion().code() >= kLinux5p8VersionCode;
+}
+
+Status BCCWrapperImpl::OpenRingBufferWithCallback(std::unique_ptr<RingBufferSpec> ring_buffer,
+                                                  int (*sample_fn)(void*, void*, size_t)) {
+  DCHECK(ring_buffer->cb_cookie != nullptr) << "ring_buffer_spec.cb_cookie must be non-null.";
+  if (!RingBuffersSupported()) {
+    return error::FailedPrecondition(
+        absl::Substitute("Ring buffer $0 requires Linux 5.8+, kernel is $1.", ring_buffer->name,
+                         system::GetCachedKernelVersion().ToString()));
+  }
+  VLOG(1) << absl::Substitute("Opening ring buffer: [$0]", ring_buffer->ToString());
+
+  // All ring buffers of the BPF module share a single epoll instance, so they are polled and
+  // consumed together.
+  PX_RETURN_IF_ERROR(bpf_.open_ring_buffer(ring_buffer->name, sample_fn, ring_buffer.get()));
+  ring_buffer_specs_.push_back(std::move(ring_buffer));
+  ++num_open_ring_buffers_;
+  return Status::OK();
+}
+
+Status BCCWrapperImpl::OpenRingBuffer(const RingBufferSpec& ring_buffer) {
+  return OpenRingBufferWithCallback(std::make_unique<RingBufferSpec>(ring_buffer),
+                                    &HandleRingBufferEvent);
+}
+
+Status BCCWrapperImpl::OpenRingBuffers(const ArrayView<RingBufferSpec>& ring_buffers) {
+  for (const RingBufferSpec& r : ring_buffers) {
+    PX_RETURN_IF_ERROR(OpenRingBuffer(r));
+  }
+  return Status::OK();
+}
+
+void BCCWrapperImpl::CloseRingBuffers() {
+  // The ring buffers are freed along with the BPF module, this only stops polling them.
+  num_open_ring_buffers_ -= ring_buffer_specs_.size();
+  ring_buffer_specs_.clear();
+}
+
 Status BCCWrapperImpl::AttachPerfEvent(const PerfEventSpec& perf_event) {
   VLOG(1) << absl::Substitute("Attaching perf event:\n   type=$0\n   probe_fn=$1",
                               magic_enum::enum_name(perf_event.type), perf_event.probe_fn);
@@ -457,11 +511,29 @@ void BCCWrapperImpl::PollPerfBuffers(const int timeout_ms) {
     const auto s = PollPerfBuffer(spec.name, timeout_ms);
     LOG_IF(ERROR, !s.ok()) << s.msg();
   }
+  ConsumeRingBuffers();
+}
+
+void BCCWrapperImpl::PollRingBuffers(const int timeout_ms) {
+  if (ring_buffer_specs_.empty()) {
+    return;
+  }
+  const int n = bpf_.poll_ring_buffer(timeout_ms);
+  LOG_IF(ERROR, n < 0) << absl::Substitute("Failed to poll ring buffers, error=$0.", n);
+}
+
+void BCCWrapperImpl::ConsumeRingBuffers() {
+  if (ring_buffer_specs_.empty()) {
+    return;
+  }
+  const int n = bpf_.consume_ring_buffer();
+  LOG_IF(ERROR, n < 0) << absl::Substitute("Failed to consume ring buffers, error=$0.", n);
 }
 
 void BCCWrapperImpl::Close() {
   DetachPerfEvents();
   ClosePerfBuffers();
+  CloseRingBuffers();
   DetachKProbes();
   DetachUProbes();
   DetachTracepoints();
@@ -484,6 +556,12 @@ Status RecordingBCCWrapperImpl::OpenPerfBuffer(const PerfBufferSpec& perf_buffer
   return Status::OK();
 }
 
+Status RecordingBCCWrapperImpl::OpenRingBuffer(const RingBufferSpec& ring_buffer_spec) {
+  auto rbs = std::make_unique<RingBufferSpec>(ring_buffer_spec);
+  rbs->recorder = recorder_.get();
+  return OpenRingBufferWithCallback(std::move(rbs), &RecordRingBufferEvent);
+}
+
 std::unique_ptr<BCCWrapper> CreateBCC() { return std::make_unique<BCCWrapperImpl>(); }
 
 std::unique_ptr<WrappedBCCStackTable> WrappedBCCStackTable::Create(bpf_tools::BCCWrapper* bcc,
@@ -146,6 +146,14 @@ class BCCWrapper {
    */
   virtual Status OpenPerfBuffer(const PerfBufferSpec& perf_buffer) = 0;
 
+  /**
+   * Open a ring buffer for reading events.
+   * @param ring_buffer Specifications of the ring buffer (name, callback function, etc.).
+   * @return Error if ring buffer cannot be opened (e.g. ring buffer does not exist, or the kernel
+   *         does not support ring buffers).
+   */
+  virtual Status OpenRingBuffer(const RingBufferSpec& ring_buffer) = 0;
+
   /**
    * Attach a perf event, which runs a probe every time a perf counter reaches a threshold
    * condition.
@@ -194,6 +202,13 @@ class BCCWrapper {
    */
   virtual Status OpenPerfBuffers(const ArrayView<PerfBufferSpec>& perf_buffers) = 0;
 
+  /**
+   * Convenience function that opens multiple ring buffers.
+   * @param ring_buffers Vector of ring buffer descriptors.
+   * @return Error of first failure (remaining ring buffer opens are not attempted).
+   */
+  virtual Status OpenRingBuffers(const ArrayView<RingBufferSpec>& ring_buffers) = 0;
+
   /**
    * Convenience function that opens multiple perf events.
    * @param probes Vector of perf event descriptors.
@@ -230,11 +245,32 @@ class BCCWrapper {
   /**
    * Drains all of the opened perf buffers, calling the handle function that was
    * specified in the PerfBufferSpec when OpenPerfBuffer was called.
+   * The opened ring buffers are then consumed too, so callers can drain every BPF output
+   * regardless of the transport it uses.
    *
    * @param timeout_ms Pass through to PollPerfBuffer()
    */
   virtual void PollPerfBuffers(const int timeout_ms = 0) = 0;
 
+  /**
+   * Drains all of the opened ring buffers, calling the handle function that was
+   * specified in the RingBufferSpec when OpenRingBuffer was called.
+   *
+   * @param timeout_ms If there's no event in any ring buffer, the amount of time to wait for
+   *                   one to arrive before returning.
+   */
+  virtual void PollRingBuffers(const int timeout_ms = 0) = 0;
+
+  /**
+   * Drains all of the opened ring buffers without waiting for events.
+   */
+  virtual void ConsumeRingBuffers() = 0;
+
+  /**
+   * Ring buffers (BPF_RINGBUF_OUTPUT) are only available on Linux 5.8+.
+   */
+  static bool RingBuffersSupported();
+
   /**
    * Detaches all probes, and closes all perf buffers that are open.
    */
@@ -244,6 +280,7 @@ class BCCWrapper {
   // It is meant for verification that we have cleaned-up all resources in tests.
   static size_t num_attached_probes() { return num_attached_kprobes_ + num_attached_uprobes_; }
   static size_t num_open_perf_buffers() { return num_open_perf_buffers_; }
+  static size_t num_open_ring_buffers() { return num_open_ring_buffers_; }
   static size_t num_attached_perf_events() { return num_attached_perf_events_; }
 
   virtual Status ClosePerfBuffer(const PerfBufferSpec& perf_buffer) = 0;
@@ -259,6 +296,7 @@ class BCCWrapper {
   inline static size_t num_attached_uprobes_;
   inline static size_t num_attached_tracepoints_;
   inline static size_t num_open_perf_buffers_;
+  inline static size_t num_open_ring_buffers_;
   inline static size_t num_attached_perf_events_;
 
  private:
@@ -297,6 +335,8 @@ class BCCWrapperImpl : public BCCWrapper {
   Status AttachSamplingProbes(const ArrayView<SamplingProbeSpec>& probes) override;
   Status AttachXDP(const std::string& dev_name, const std::string& fn_name) override;
   Status OpenPerfBuffers(const ArrayView<PerfBufferSpec>& perf_buffers) override;
+  Status OpenRingBuffer(const RingBufferSpec& ring_buffer) override;
+  Status OpenRingBuffers(const ArrayView<RingBufferSpec>& ring_buffers) override;
   Status AttachPerfEvents(const ArrayView<PerfEventSpec>& perf_events) override;
   Status PopulateBPFPerfArray(const std::string& table_name, const uint32_t type,
                               const uint64_t config) override {
@@ -305,6 +345,8 @@ class BCCWrapperImpl : public BCCWrapper {
   }
   void PollPerfBuffers(const int timeout_ms = 0) override;
   Status PollPerfBuffer(const std::string& name, const int timeout_ms = 0) override;
+  void PollRingBuffers(const int timeout_ms = 0) override;
+  void ConsumeRingBuffers() override;
   void Close() override;
 
   Status ClosePerfBuffer(const PerfBufferSpec& perf_buffer) override;
@@ -323,6 +365,7 @@ class BCCWrapperImpl : public BCCWrapper {
   void DetachUProbes();
   void DetachTracepoints();
   void ClosePerfBuffers();
+  void CloseRingBuffers();
   void DetachPerfEvents();
 
   // Returns the name that identifies the target to attach this k-probe.
@@ -334,7 +377,13 @@ class BCCWrapperImpl : public BCCWrapper {
   std::vector<PerfEventSpec> perf_events_;
 
  protected:
+  // Opens the ring buffer with a callback that receives the spec as its cookie.
+  Status OpenRingBufferWithCallback(std::unique_ptr<RingBufferSpec> ring_buffer,
+                                    int (*sample_fn)(void*, void*, size_t));
+
   std::vector<PerfBufferSpec> perf_buffer_specs_;
+  // The ring buffer callbacks point to these specs, so they must not move.
+  std::vector<std::unique_ptr<RingBufferSpec>> ring_buffer_specs_;
 
  private:
   std::string system_headers_include_dir_;
@@ -361,6 +410,7 @@ class RecordingBCCWrapperImpl : public BCCWrapperImpl {
   StatusOr<BPFReplayer*> GetBPFReplayer() const override { return error::Internal("Wrong impl."); }
 
   Status OpenPerfBuffer(const PerfBufferSpec& perf_buffer) override;
+  Status OpenRingBuffer(const RingBufferSpec& ring_buffer) override;
 
   RecordingBCCWrapperImpl() { recorder_ = std::make_unique<BPFRecorder>(); }
 
@@ -434,8 +484,32 @@ class ReplayingBCCWrapperImpl : public BCCWrapper {
     for (const auto& pbs : perf_buffer_specs_) {
       replayer_->ReplayPerfBufferEvents(*pbs);
     }
+    ConsumeRingBuffers();
   };
 
+  Status OpenRingBuffer(const RingBufferSpec& rbs) override {
+    ring_buffer_specs_.push_back(std::make_unique<RingBufferSpec>(rbs));
+    return Status::OK();
+  }
+
+  Status OpenRingBuffers(const ArrayView<RingBufferSpec>& ring_buffer_specs) override {
+    for (const auto& rbs : ring_buffer_specs) {
+      PX_RETURN_IF_ERROR(OpenRingBuffer(rbs));
+    }
+    return Status::OK();
+  }
+
+  void PollRingBuffers(const int timeout_ms = 0) override {
+    PX_UNUSED(timeout_ms);
+    ConsumeRingBuffers();
+  }
+
+  void ConsumeRingBuffers() override {
+    if (!ring_buffer_specs_.empty()) {
+      replayer_->ReplayRingBufferEvents(ring_buffer_specs_);
+    }
+  }
+
   void Close() override{};
 
   Status ClosePerfBuffer(const PerfBufferSpec&) override { return Status::OK(); }
@@ -447,6 +521,7 @@ class ReplayingBCCWrapperImpl : public BCCWrapper {
  private:
   std::unique_ptr<BPFReplayer> replayer_;
   std::vector<std::unique_ptr<PerfBufferSpec>> perf_buffer_specs_;
+  std::vector<std::unique_ptr<RingBufferSpec>> ring_buffer_specs_;
 };
 
 std::unique_ptr<BCCWrapper> CreateBCC();
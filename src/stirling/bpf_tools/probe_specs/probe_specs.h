@@ -195,6 +195,31 @@ struct PerfBufferSpec {
   }
 };
 
+/**
+ * Describes a BPF ring buffer, through which data is returned to user-space.
+ * Unlike a perf buffer, a ring buffer is shared by all CPUs, so its events arrive in the order
+ * they were submitted, and a burst on one CPU can use all of its space.
+ * Ring buffers require Linux 5.8+.
+ */
+struct RingBufferSpec {
+  // Name of the ring buffer.
+  // Must be the same as the ring buffer name declared in the probe code with BPF_RINGBUF_OUTPUT,
+  // which also sets its size.
+  std::string name;
+
+  // Function that will be called for every event in the ring buffer,
+  // when the ring buffer is polled or consumed.
+  perf_reader_raw_cb probe_output_fn;
+
+  // Used to invoke callback.
+  void* cb_cookie;
+
+  // This will be populated and used only if the BPF recording BCC wrapper is used.
+  BPFRecorder* recorder = nullptr;
+
+  std::string ToString() const { return absl::Substitute("name=$0", name); }
+};
+
 /**
  * Describes a perf event to attach.
  * This can be run stand-alone and is not dependent on kProbes.
@@ -18,6 +18,7 @@
 
 #include "src/stirling/bpf_tools/rr/rr.h"
 
+#include <algorithm>
 #include <fstream>
 
 namespace px {
@@ -136,6 +137,28 @@ void RecordPerfBufferLoss(void* cb_cookie, uint64_t lost) {
   pb_spec->probe_loss_fn(pb_spec->cb_cookie, lost);
 }
 
+void BPFRecorder::RecordRingBufferEvent(RingBufferSpec* rb_spec, void const* const data,
+                                        const size_t data_size) {
+  auto event = events_proto_.add_event()->mutable_ring_buffer_event();
+  auto rb_name = event->mutable_name();
+  auto rb_data = event->mutable_data();
+
+  const std::string data_as_string(static_cast<char const*>(data), data_size);
+
+  *rb_name = rb_spec->name;
+  *rb_data = data_as_string;
+}
+
+int RecordRingBufferEvent(void* cb_cookie, void* data, size_t data_size) {
+  RingBufferSpec* rb_spec = static_cast<RingBufferSpec*>(cb_cookie);
+  BPFRecorder* recorder = rb_spec->recorder;
+  ECHECK(recorder != nullptr);
+
+  recorder->RecordRingBufferEvent(rb_spec, data, data_size);
+  rb_spec->probe_output_fn(rb_spec->cb_cookie, data, static_cast<int>(data_size));
+  return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Replay.
@@ -169,6 +192,39 @@ void BPFReplayer::ReplayPerfBufferEvents(const PerfBufferSpec& perf_buffer_spec)
   }
 }
 
+void BPFReplayer::ReplayRingBufferEvents(
+    const std::vector<std::unique_ptr<RingBufferSpec>>& ring_buffer_specs) {
+  if (PlaybackComplete()) {
+    LOG_FIRST_N(INFO, 1) << "BPFReplayer::ReplayRingBufferEvents(), playback complete.";
+    return;
+  }
+
+  const auto n_events = events_proto_.event_size();
+
+  while (playback_event_idx_ < n_events) {
+    const auto event = events_proto_.event(playback_event_idx_);
+    if (!event.has_ring_buffer_event()) {
+      // Return control to calling context. Replay will continue with a different eBPF data
+      // type, e.g. perf buffer or map.
+      break;
+    }
+    const auto ring_buffer_event = event.ring_buffer_event();
+    const auto data = ring_buffer_event.data();
+    const auto name = ring_buffer_event.name();
+    auto spec_it = std::find_if(ring_buffer_specs.begin(), ring_buffer_specs.end(),
+                                [&name](const auto& spec) { return spec->name == name; });
+    if (spec_it == ring_buffer_specs.end()) {
+      LOG_FIRST_N(WARNING, 1) << absl::Substitute(
+          "BPFReplayer::ReplayRingBufferEvents(), ring buffer $0 is not open.", name);
+      break;
+    }
+    const RingBufferSpec& ring_buffer_spec = **spec_it;
+    void* data_ptr = const_cast<void*>(static_cast<const void*>(data.data()));
+    ring_buffer_spec.probe_output_fn(ring_buffer_spec.cb_cookie, data_ptr, data.size());
+    ++playback_event_idx_;
+  }
+}
+
 Status BPFReplayer::ReplayArrayGetValue(const std::string& name, const int32_t idx,
                                         const uint32_t data_size, void* value) {
   if (PlaybackComplete()) {
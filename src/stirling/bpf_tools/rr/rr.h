@@ -19,6 +19,7 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -43,6 +44,8 @@ class BPFRecorder : public NotCopyMoveable {
   void RecordBPFStackTableGetAddrSymbolEvent(const std::string& name, const uint64_t addr,
                                              const uint32_t pid, const std::string symbol);
   void RecordPerfBufferEvent(PerfBufferSpec* pb_spec, void const* const data, const int data_size);
+  void RecordRingBufferEvent(RingBufferSpec* rb_spec, void const* const data,
+                             const size_t data_size);
   void WriteProto(const std::string& proto_buf_file_path);
 
  private:
@@ -53,6 +56,9 @@ class BPFRecorder : public NotCopyMoveable {
 class BPFReplayer : public NotCopyMoveable {
  public:
   void ReplayPerfBufferEvents(const PerfBufferSpec& perf_buffer_spec);
+  // All ring buffers are consumed together, so their events are replayed together too.
+  void ReplayRingBufferEvents(
+      const std::vector<std::unique_ptr<RingBufferSpec>>& ring_buffer_specs);
   Status ReplayArrayGetValue(const std::string& name, const int32_t idx, const uint32_t data_size,
                              void* data);
   Status ReplayMapGetValue(const std::string& name, const uint32_t key_size, void const* const key,
@@ -78,6 +84,7 @@ class BPFReplayer : public NotCopyMoveable {
 
 void RecordPerfBufferEvent(void* cb_cookie, void* data, int data_size);
 void RecordPerfBufferLoss(void* cb_cookie, uint64_t lost);
+int RecordRingBufferEvent(void* cb_cookie, void* data, size_t data_size);
 
 }  // namespace bpf_tools
 }  // namespace stirling
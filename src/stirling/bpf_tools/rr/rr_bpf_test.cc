@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "src/common/testing/testing.h"
@@ -248,6 +249,88 @@ TEST_F(BasicRecorderTest, PerfBufferRRTest) {
   // TODO(jps): add the expectations.
 }
 
+class RingBufferRecorderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (!bpf_tools::BCCWrapper::RingBuffersSupported()) {
+      GTEST_SKIP() << "Ring buffers require Linux 5.8+.";
+    }
+    test::gold_data.clear();
+    test::test_idx = 0;
+
+    recording_bcc_ = std::make_unique<bpf_tools::RecordingBCCWrapperImpl>();
+    replaying_bcc_ = std::make_unique<bpf_tools::ReplayingBCCWrapperImpl>();
+
+    const std::vector<std::string> cflags = {"-DENABLE_RINGBUF=1"};
+    ASSERT_OK(recording_bcc_->InitBPFProgram(rr_test_bcc_script, cflags));
+    ASSERT_OK(replaying_bcc_->InitBPFProgram(rr_test_bcc_script, cflags));
+
+    const auto recording_ring_buffer_specs = MakeArray<bpf_tools::RingBufferSpec>({
+        .name = std::string("ring_buffer"),
+        .probe_output_fn = test::PerfBufferRecordingDataFn,
+        .cb_cookie = this,
+    });
+    const auto replaying_ring_buffer_specs = MakeArray<bpf_tools::RingBufferSpec>({
+        .name = std::string("ring_buffer"),
+        .probe_output_fn = test::PerfBufferReplayingDataFn,
+        .cb_cookie = this,
+    });
+    ASSERT_OK(recording_bcc_->OpenRingBuffers(recording_ring_buffer_specs));
+    ASSERT_OK(replaying_bcc_->OpenRingBuffers(replaying_ring_buffer_specs));
+
+    const int64_t self_pid = getpid();
+    const std::filesystem::path self_path = GetSelfPath().ValueOrDie();
+    ASSERT_OK_AND_ASSIGN(auto elf_reader, ElfReader::Create(self_path.string()));
+    ASSERT_OK_AND_ASSIGN(auto converter, ElfAddressConverter::Create(elf_reader.get(), self_pid));
+
+    const uint64_t foo_virt_addr = reinterpret_cast<uint64_t>(&::test::Foo);
+    const uint64_t foo_bin_addr = converter->VirtualAddrToBinaryAddr(foo_virt_addr);
+    const UProbeSpec kFooUprobe{.binary_path = self_path,
+                                .symbol = {},
+                                .address = foo_bin_addr,
+                                .attach_type = BPFProbeAttachType::kEntry,
+                                .probe_fn = "push_something_into_a_ring_buffer"};
+    ASSERT_OK(recording_bcc_->AttachUProbe(kFooUprobe));
+    ASSERT_OK(replaying_bcc_->AttachUProbe(kFooUprobe));
+  }
+
+  void TearDown() override {
+    if (recording_bcc_ != nullptr) {
+      recording_bcc_->Close();
+      replaying_bcc_->Close();
+    }
+  }
+
+  std::unique_ptr<bpf_tools::RecordingBCCWrapperImpl> recording_bcc_;
+  std::unique_ptr<bpf_tools::ReplayingBCCWrapperImpl> replaying_bcc_;
+};
+
+TEST_F(RingBufferRecorderTest, RingBufferRRTest) {
+  constexpr uint32_t kLoopIters = 16;
+
+  for (uint32_t i = 0; i < kLoopIters; ++i) {
+    PX_UNUSED(::test::Foo(i));
+  }
+
+  const std::string pb_file_name = "ring_buffer_replay_test.pb";
+
+  // Consuming the ring buffers will cause the recording BCC wrapper to record each event.
+  recording_bcc_->ConsumeRingBuffers();
+  ASSERT_EQ(test::gold_data.size(), kLoopIters);
+  for (uint32_t i = 0; i < kLoopIters; ++i) {
+    // A ring buffer is shared by all CPUs, so its events are in submit order.
+    EXPECT_EQ(test::gold_data[i], i);
+  }
+
+  recording_bcc_->WriteProto(pb_file_name);
+  recording_bcc_->Close();
+
+  // Replaying goes through PollPerfBuffers(), which also drains the ring buffers.
+  ASSERT_OK(replaying_bcc_->OpenReplayProtobuf(pb_file_name));
+  replaying_bcc_->PollPerfBuffers();
+  EXPECT_EQ(test::test_idx, test::gold_data.size());
+}
+
 TEST_F(BasicRecorderTest, BPFArrayRRTest) {
   auto recording_bpf_array = WrappedBCCArrayTable<int>::Create(recording_bcc_.get(), "results");
 
@@ -32,6 +32,9 @@ BPF_ARRAY(state, int, 1);
 BPF_ARRAY(results, int, 1024);
 BPF_STACK_TRACE(stack_table, 1024);
 BPF_PERF_OUTPUT(stack_ids);
+#if ENABLE_RINGBUF
+BPF_RINGBUF_OUTPUT(ring_buffer, 8);
+#endif
 
 // A minimal BPF program to:
 // 1. Push something into a perf buffer.
@@ -61,3 +64,12 @@ int sample_a_stack_trace(struct pt_regs* ctx) {
   stack_ids.perf_submit(ctx, &stack_id, sizeof(int));
   return 0;
 }
+
+#if ENABLE_RINGBUF
+// A minimal BPF program to push something into a ring buffer.
+int push_something_into_a_ring_buffer(struct pt_regs* ctx) {
+  int arg_val = PT_REGS_PARM1(ctx);
+  ring_buffer.ringbuf_output(&arg_val, sizeof(int), 0);
+  return 0;
+}
+#endif
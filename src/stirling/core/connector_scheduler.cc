@@ -0,0 +1,326 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "src/stirling/core/connector_scheduler.h"
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <absl/strings/substitute.h>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace stirling {
+
+namespace {
+
+// Returns true if any of the input tables are beyond the threshold.
+bool DataExceedsThreshold(const std::vector<DataTable*>& data_tables) {
+  // Data push threshold, based on percentage of buffer that is filled.
+  constexpr uint32_t kDefaultOccupancyPctThreshold = 100;
+
+  // Data push threshold, based number of records after which a push.
+  constexpr uint32_t kDefaultOccupancyThreshold = 1024;
+
+  for (const auto* data_table : data_tables) {
+    if (static_cast<uint32_t>(100 * data_table->OccupancyPct()) > kDefaultOccupancyPctThreshold) {
+      return true;
+    }
+    if (data_table->Occupancy() > kDefaultOccupancyThreshold) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Lowers the nice value of the calling thread, so that draining the buffers isn't delayed by
+// the workers or the rest of the process.
+void RaiseThreadPriority() {
+  constexpr int kPollThreadNiceValue = -10;
+  const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+  if (setpriority(PRIO_PROCESS, tid, kPollThreadNiceValue) != 0) {
+    LOG(WARNING) << absl::Substitute("Failed to raise the priority of the poll thread: $0",
+                                     std::strerror(errno));
+  }
+}
+
+}  // namespace
+
+ConnectorScheduler::ConnectorScheduler(int num_workers, std::chrono::milliseconds poll_period,
+                                       RunCoreStats* stats)
+    : num_workers_(std::max(num_workers, 0)), poll_period_(poll_period), stats_(stats) {
+  DCHECK(stats_ != nullptr);
+}
+
+ConnectorScheduler::~ConnectorScheduler() { Stop(); }
+
+void ConnectorScheduler::Start() {
+  if (num_workers_ == 0 || !workers_.empty()) {
+    return;
+  }
+  for (int i = 0; i < num_workers_; ++i) {
+    workers_.emplace_back(&ConnectorScheduler::WorkerLoop, this);
+  }
+  if (poll_period_.count() > 0) {
+    poll_thread_ = std::thread(&ConnectorScheduler::PollLoop, this);
+  }
+}
+
+void ConnectorScheduler::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_cv_.notify_all();
+  stop_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  if (poll_thread_.joinable()) {
+    poll_thread_.join();
+  }
+
+  // Drop the tasks that didn't get to run, and apply the ones that did, so that every connector
+  // can be scheduled again after a restart.
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& task : tasks_) {
+    task.state->in_flight = false;
+  }
+  tasks_.clear();
+  for (const auto& completion : completions_) {
+    ApplyCompletion(completion);
+  }
+  completions_.clear();
+  stop_ = false;
+}
+
+void ConnectorScheduler::AddSource(SourceConnector* source) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  states_.push_back(std::make_shared<SourceState>(source));
+}
+
+void ConnectorScheduler::RemoveSource(SourceConnector* source) {
+  std::shared_ptr<SourceState> state;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = std::find_if(states_.begin(), states_.end(),
+                             [source](const auto& s) { return s->source == source; });
+    if (iter == states_.end()) {
+      return;
+    }
+    state = std::move(*iter);
+    states_.erase(iter);
+  }
+  // The queued tasks and the pending completions of the source are skipped from now on.
+  std::lock_guard<std::mutex> run_lock(state->run_mutex);
+  state->removed = true;
+}
+
+void ConnectorScheduler::RunOnSources(const std::function<void(SourceConnector*)>& fn) {
+  std::vector<std::shared_ptr<SourceState>> states;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    states = states_;
+  }
+  for (const auto& state : states) {
+    std::lock_guard<std::mutex> run_lock(state->run_mutex);
+    if (state->removed) {
+      continue;
+    }
+    fn(state->source);
+  }
+}
+
+ConnectorScheduler::time_point ConnectorScheduler::Schedule(
+    const time_point now, const std::chrono::milliseconds run_window,
+    const std::shared_ptr<ConnectorContext>& ctx, const DataPushCallback& push_callback) {
+  std::vector<Completion> completions;
+  std::vector<std::shared_ptr<SourceState>> states;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    completions.swap(completions_);
+    states = states_;
+  }
+  for (const auto& completion : completions) {
+    ApplyCompletion(completion);
+  }
+
+  // Worst case, wake-up every so often.
+  // This is important if there are no subscribed info classes, to avoid sleeping eternally.
+  constexpr std::chrono::milliseconds kMaxSleepDuration{1000};
+  auto wakeup_time = now + kMaxSleepDuration;
+
+  // To batch up work, i.e. to do more work per wakeup, we want to run our data
+  // transfer or push data if its desired run time is anywhere between
+  // time "now" and time "now + window".
+  const auto now_plus_run_window = now + run_window;
+
+  std::vector<Task> tasks;
+  for (auto& state : states) {
+    if (state->in_flight) {
+      continue;
+    }
+    SourceConnector* source = state->source;
+    FrequencyManager& sampling_freq_mgr = source->sampling_freq_mgr();
+
+    Task task;
+    task.transfer = sampling_freq_mgr.Expired(now_plus_run_window);
+    task.push = source->push_freq_mgr().Expired(now_plus_run_window);
+    if (task.transfer || task.push || DataExceedsThreshold(source->data_tables())) {
+      task.state = state;
+      task.ctx = ctx;
+      task.push_callback = push_callback;
+      // The first transfer has no deadline to be late for.
+      task.deadline = sampling_freq_mgr.count() == 0 ? now : sampling_freq_mgr.next();
+
+      if (num_workers_ == 0) {
+        ApplyCompletion(RunTask(task));
+      } else {
+        state->in_flight = true;
+        tasks.push_back(std::move(task));
+        continue;
+      }
+    }
+    wakeup_time = std::min(wakeup_time, sampling_freq_mgr.next());
+    wakeup_time = std::min(wakeup_time, source->push_freq_mgr().next());
+  }
+
+  if (!tasks.empty()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto& task : tasks) {
+        tasks_.push_back(std::move(task));
+      }
+    }
+    task_cv_.notify_all();
+  }
+  return wakeup_time;
+}
+
+void ConnectorScheduler::WaitUntil(const time_point deadline) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  completion_cv_.wait_until(lock, deadline, [this] { return !completions_.empty(); });
+}
+
+ConnectorScheduler::Completion ConnectorScheduler::RunTask(const Task& task) {
+  Completion completion;
+  completion.state = task.state;
+  completion.deadline = task.deadline;
+
+  std::lock_guard<std::mutex> run_lock(task.state->run_mutex);
+  if (task.state->removed) {
+    return completion;
+  }
+  SourceConnector* source = task.state->source;
+
+  completion.start = std::chrono::steady_clock::now();
+  completion.transfer_end = completion.start;
+  if (task.transfer) {
+    source->TransferData(task.ctx.get());
+    completion.transfer = true;
+    completion.transfer_end = std::chrono::steady_clock::now();
+  }
+  // The transfer may have filled up the tables, in which case they're pushed right away.
+  if (task.push || DataExceedsThreshold(source->data_tables())) {
+    std::lock_guard<std::mutex> push_lock(push_mutex_);
+    source->PushData(task.push_callback);
+    completion.push = true;
+  }
+  completion.end = std::chrono::steady_clock::now();
+  return completion;
+}
+
+void ConnectorScheduler::ApplyCompletion(const Completion& completion) {
+  SourceState* state = completion.state.get();
+  state->in_flight = false;
+  if (state->removed) {
+    return;
+  }
+  SourceConnector* source = state->source;
+
+  if (completion.transfer) {
+    source->sampling_freq_mgr().Reset(completion.transfer_end);
+    stats_->IncrementTransferDataCount();
+    // Work that was batched up ahead of its deadline isn't late.
+    const auto lag = std::max(std::chrono::nanoseconds{0},
+                              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  completion.start - completion.deadline));
+    const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        completion.transfer_end - completion.start);
+    stats_->RecordTransferData(source->name(), lag, duration,
+                               source->sampling_freq_mgr().period());
+  }
+  if (completion.push) {
+    source->push_freq_mgr().Reset(completion.end);
+    stats_->IncrementPushDataCount();
+  }
+}
+
+void ConnectorScheduler::WorkerLoop() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (stop_) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    Completion completion = RunTask(task);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      completions_.push_back(std::move(completion));
+    }
+    completion_cv_.notify_all();
+  }
+}
+
+void ConnectorScheduler::PollLoop() {
+  RaiseThreadPriority();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_cv_.wait_for(lock, poll_period_, [this] { return stop_; })) {
+    std::vector<std::shared_ptr<SourceState>> states = states_;
+    lock.unlock();
+
+    for (const auto& state : states) {
+      // A running connector drains its own buffers in TransferData().
+      std::unique_lock<std::mutex> run_lock(state->run_mutex, std::try_to_lock);
+      if (!run_lock.owns_lock() || state->removed) {
+        continue;
+      }
+      state->source->PollBuffers();
+    }
+
+    lock.lock();
+  }
+}
+
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/stirling/core/connector_context.h"
+#include "src/stirling/core/source_connector.h"
+#include "src/stirling/utils/run_core_stats.h"
+
+namespace px {
+namespace stirling {
+
+/**
+ * Runs TransferData() and PushData() of the source connectors on a pool of worker threads,
+ * whenever they are due according to the connectors' FrequencyManagers.
+ *
+ * A connector runs on at most one worker at a time, so a slow connector only delays itself.
+ * A dedicated poll thread, with a raised priority, periodically drains the buffers of the
+ * connectors that are not running (see SourceConnector::PollBuffers()).
+ *
+ * The FrequencyManagers are only read and updated by the thread that calls Schedule(), which
+ * also records the per-connector lag and overruns in RunCoreStats. With zero workers, Schedule()
+ * runs the connectors inline, and there is no poll thread.
+ */
+class ConnectorScheduler {
+  using time_point = std::chrono::steady_clock::time_point;
+
+ public:
+  ConnectorScheduler(int num_workers, std::chrono::milliseconds poll_period, RunCoreStats* stats);
+  ~ConnectorScheduler();
+
+  /**
+   * Starts the worker and poll threads.
+   */
+  void Start();
+
+  /**
+   * Waits for the running connectors to finish, and stops the threads.
+   * Must be called from the thread that calls Schedule().
+   */
+  void Stop();
+
+  void AddSource(SourceConnector* source);
+
+  /**
+   * Waits for the source to finish its current work. It is neither run nor polled afterwards.
+   */
+  void RemoveSource(SourceConnector* source);
+
+  /**
+   * Calls fn on every source, while the source is neither running nor being polled.
+   */
+  void RunOnSources(const std::function<void(SourceConnector*)>& fn);
+
+  /**
+   * Runs, or hands to the workers, the TransferData() and PushData() calls that are due before
+   * now + run_window, for every connector that is not already running.
+   * @return The earliest time at which one of the idle connectors is due.
+   */
+  time_point Schedule(time_point now, std::chrono::milliseconds run_window,
+                      const std::shared_ptr<ConnectorContext>& ctx,
+                      const DataPushCallback& push_callback);
+
+  /**
+   * Sleeps until the deadline, or until a worker finishes running a connector.
+   */
+  void WaitUntil(time_point deadline);
+
+  int num_workers() const { return num_workers_; }
+
+ private:
+  struct SourceState {
+    explicit SourceState(SourceConnector* source) : source(source) {}
+
+    SourceConnector* const source;
+    // Held while the connector runs or gets polled.
+    std::mutex run_mutex;
+    // Whether the connector was handed to a worker. Only accessed by the scheduling thread.
+    bool in_flight = false;
+    std::atomic<bool> removed = false;
+  };
+
+  struct Task {
+    std::shared_ptr<SourceState> state;
+    bool transfer = false;
+    bool push = false;
+    std::shared_ptr<ConnectorContext> ctx;
+    DataPushCallback push_callback;
+    // When the TransferData() call was due.
+    time_point deadline;
+  };
+
+  struct Completion {
+    std::shared_ptr<SourceState> state;
+    bool transfer = false;
+    bool push = false;
+    time_point start;
+    time_point transfer_end;
+    time_point end;
+    time_point deadline;
+  };
+
+  Completion RunTask(const Task& task);
+  void ApplyCompletion(const Completion& completion);
+  void WorkerLoop();
+  void PollLoop();
+
+  const int num_workers_;
+  const std::chrono::milliseconds poll_period_;
+  RunCoreStats* const stats_;
+
+  std::vector<std::thread> workers_;
+  std::thread poll_thread_;
+
+  // Protects the members below.
+  std::mutex mutex_;
+  std::condition_variable task_cv_;
+  std::condition_variable completion_cv_;
+  std::condition_variable stop_cv_;
+  bool stop_ = false;
+  std::vector<std::shared_ptr<SourceState>> states_;
+  std::deque<Task> tasks_;
+  std::vector<Completion> completions_;
+
+  // Serializes the calls to the push callbacks, which don't have to be thread-safe.
+  std::mutex push_mutex_;
+};
+
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "src/stirling/core/connector_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "src/common/testing/testing.h"
+#include "src/stirling/core/data_table.h"
+
+namespace px {
+namespace stirling {
+
+using std::chrono::milliseconds;
+
+// A source connector whose TransferData() takes a fixed amount of time.
+class TestConnector : public SourceConnector {
+ public:
+  static constexpr DataElement kElements[] = {
+      {"time_", "Timestamp when the data record was collected.", types::DataType::TIME64NS,
+       types::SemanticType::ST_NONE, types::PatternType::METRIC_COUNTER},
+  };
+  static constexpr auto kTable = DataTableSchema("test_table", "A test table.", kElements);
+  static constexpr auto kTables = MakeArray(kTable);
+
+  TestConnector(std::string_view name, milliseconds period, milliseconds transfer_duration)
+      : SourceConnector(name, kTables),
+        period_(period),
+        transfer_duration_(transfer_duration),
+        data_table_(/*id*/ 0, kTable) {
+    set_data_tables({&data_table_});
+  }
+
+  int num_transfers() const { return num_transfers_; }
+  int num_polls() const { return num_polls_; }
+  bool polled_while_transferring() const { return polled_while_transferring_; }
+  bool transferring() const { return transferring_; }
+
+ protected:
+  Status InitImpl() override {
+    sampling_freq_mgr_.set_period(period_);
+    push_freq_mgr_.set_period(period_);
+    return Status::OK();
+  }
+
+  void TransferDataImpl(ConnectorContext* /* ctx */) override {
+    transferring_ = true;
+    std::this_thread::sleep_for(transfer_duration_);
+    ++num_transfers_;
+    transferring_ = false;
+  }
+
+  void PollBuffersImpl() override {
+    if (transferring_) {
+      polled_while_transferring_ = true;
+    }
+    ++num_polls_;
+  }
+
+  Status StopImpl() override { return Status::OK(); }
+
+ private:
+  const milliseconds period_;
+  const milliseconds transfer_duration_;
+  DataTable data_table_;
+
+  std::atomic<int> num_transfers_ = 0;
+  std::atomic<int> num_polls_ = 0;
+  std::atomic<bool> transferring_ = false;
+  std::atomic<bool> polled_while_transferring_ = false;
+};
+
+class ConnectorSchedulerTest : public ::testing::Test {
+ protected:
+  // Runs the scheduling loop of StirlingImpl::RunCore() for the given duration.
+  void RunFor(ConnectorScheduler* scheduler, milliseconds duration) {
+    constexpr milliseconds kRunWindow{1};
+    auto now = std::chrono::steady_clock::now();
+    const auto end = now + duration;
+    while (now < end) {
+      const auto wakeup_time = scheduler->Schedule(now, kRunWindow, ctx_, push_callback_);
+      scheduler->WaitUntil(std::min(wakeup_time, end));
+      now = std::chrono::steady_clock::now();
+    }
+  }
+
+  std::shared_ptr<ConnectorContext> ctx_ =
+      std::make_shared<StandaloneContext>(absl::flat_hash_set<md::UPID>{});
+  DataPushCallback push_callback_ = [](uint32_t, types::TabletID,
+                                       std::unique_ptr<types::ColumnWrapperRecordBatch>) {
+    return Status::OK();
+  };
+  RunCoreStats stats_;
+};
+
+TEST_F(ConnectorSchedulerTest, Inline) {
+  TestConnector connector("connector", milliseconds{10}, milliseconds{0});
+  ASSERT_OK(connector.Init());
+
+  ConnectorScheduler scheduler(/*num_workers*/ 0, milliseconds{1}, &stats_);
+  scheduler.AddSource(&connector);
+  scheduler.Start();
+  RunFor(&scheduler, milliseconds{100});
+  scheduler.Stop();
+
+  EXPECT_GE(connector.num_transfers(), 5);
+  EXPECT_EQ(stats_.num_transfer_data(), static_cast<uint64_t>(connector.num_transfers()));
+  EXPECT_GE(stats_.num_push_data(), 5);
+  EXPECT_EQ(stats_.connector_stats().at("connector").num_transfer_data,
+            static_cast<uint64_t>(connector.num_transfers()));
+  // Without workers, nothing polls the buffers between the transfers.
+  EXPECT_EQ(connector.num_polls(), 0);
+}
+
+TEST_F(ConnectorSchedulerTest, SlowConnectorDoesNotDelayOthers) {
+  TestConnector fast("fast", milliseconds{10}, milliseconds{0});
+  TestConnector slow("slow", milliseconds{50}, milliseconds{200});
+  ASSERT_OK(fast.Init());
+  ASSERT_OK(slow.Init());
+
+  ConnectorScheduler scheduler(/*num_workers*/ 2, milliseconds{0}, &stats_);
+  scheduler.AddSource(&slow);
+  scheduler.AddSource(&fast);
+  scheduler.Start();
+  RunFor(&scheduler, milliseconds{500});
+  scheduler.Stop();
+
+  // Run inline, the fast connector would only get a transfer in between those of the slow one.
+  EXPECT_GE(fast.num_transfers(), 10);
+  EXPECT_LE(slow.num_transfers(), 3);
+
+  const auto& slow_stats = stats_.connector_stats().at("slow");
+  EXPECT_EQ(slow_stats.num_transfer_data, static_cast<uint64_t>(slow.num_transfers()));
+  EXPECT_EQ(slow_stats.num_overruns, slow_stats.num_transfer_data);
+  EXPECT_EQ(stats_.connector_stats().at("fast").num_overruns, 0);
+}
+
+TEST_F(ConnectorSchedulerTest, PollsIdleConnectors) {
+  TestConnector connector("connector", milliseconds{20}, milliseconds{20});
+  ASSERT_OK(connector.Init());
+
+  ConnectorScheduler scheduler(/*num_workers*/ 1, milliseconds{1}, &stats_);
+  scheduler.AddSource(&connector);
+  scheduler.Start();
+  RunFor(&scheduler, milliseconds{200});
+  scheduler.Stop();
+
+  EXPECT_GT(connector.num_transfers(), 0);
+  EXPECT_GT(connector.num_polls(), 0);
+  EXPECT_FALSE(connector.polled_while_transferring());
+}
+
+TEST_F(ConnectorSchedulerTest, RemoveSource) {
+  TestConnector connector("connector", milliseconds{10}, milliseconds{5});
+  ASSERT_OK(connector.Init());
+
+  ConnectorScheduler scheduler(/*num_workers*/ 1, milliseconds{1}, &stats_);
+  scheduler.AddSource(&connector);
+  scheduler.Start();
+  RunFor(&scheduler, milliseconds{50});
+
+  scheduler.RemoveSource(&connector);
+  const int num_transfers = connector.num_transfers();
+  const int num_polls = connector.num_polls();
+  EXPECT_GT(num_transfers, 0);
+
+  RunFor(&scheduler, milliseconds{50});
+  scheduler.Stop();
+
+  EXPECT_EQ(connector.num_transfers(), num_transfers);
+  EXPECT_EQ(connector.num_polls(), num_polls);
+}
+
+TEST_F(ConnectorSchedulerTest, RunOnSourcesWaitsForTransfer) {
+  TestConnector connector("connector", milliseconds{5}, milliseconds{5});
+  ASSERT_OK(connector.Init());
+
+  ConnectorScheduler scheduler(/*num_workers*/ 1, milliseconds{1}, &stats_);
+  scheduler.AddSource(&connector);
+  scheduler.Start();
+  std::thread run_core([&] { RunFor(&scheduler, milliseconds{200}); });
+
+  int num_calls = 0;
+  bool called_while_transferring = false;
+  const auto end = std::chrono::steady_clock::now() + milliseconds{150};
+  while (std::chrono::steady_clock::now() < end) {
+    scheduler.RunOnSources([&](SourceConnector* source) {
+      EXPECT_EQ(source, &connector);
+      called_while_transferring |= connector.transferring();
+      ++num_calls;
+    });
+    std::this_thread::sleep_for(milliseconds{1});
+  }
+  run_core.join();
+  scheduler.Stop();
+
+  EXPECT_GT(connector.num_transfers(), 0);
+  EXPECT_GT(num_calls, 0);
+  EXPECT_FALSE(called_while_transferring);
+}
+
+}  // namespace stirling
+}  // namespace px
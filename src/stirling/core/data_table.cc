@@ -21,6 +21,8 @@
 #include <utility>
 #include <vector>
 
+#include <absl/container/flat_hash_set.h>
+
 #include "src/common/base/base.h"
 #include "src/shared/types/type_utils.h"
 #include "src/stirling/core/data_table.h"
@@ -59,6 +61,73 @@ Tablet* DataTable::GetTablet(types::TabletIDView tablet_id) {
   return &tablet;
 }
 
+namespace {
+
+// A record of one of the shards merged by DataTable::MergeShards().
+struct ShardRecord {
+  uint64_t time;
+  Tablet* tablet;
+  size_t idx;
+};
+
+template <types::DataType TDataType>
+void MoveShardRecords(const std::vector<ShardRecord>& records, size_t col_idx,
+                      ColumnWrapper* dst) {
+  using TColumn = types::ColumnWrapperTmpl<typename types::DataTypeTraits<TDataType>::value_type>;
+  auto* dst_col = static_cast<TColumn*>(dst);
+  dst_col->Reserve(dst_col->Size() + records.size());
+  for (const auto& record : records) {
+    auto* src_col = static_cast<TColumn*>(record.tablet->records[col_idx].get());
+    dst_col->Append(std::move((*src_col)[record.idx]));
+  }
+}
+
+}  // namespace
+
+void DataTable::MergeShards(const std::vector<DataTable*>& shards) {
+  absl::flat_hash_set<types::TabletID> tablet_ids;
+  for (const auto* shard : shards) {
+    DCHECK_EQ(shard->table_schema_.name(), table_schema_.name());
+    for (const auto& [tablet_id, tablet] : shard->tablets_) {
+      tablet_ids.insert(tablet_id);
+    }
+  }
+
+  std::vector<ShardRecord> records;
+  for (const auto& tablet_id : tablet_ids) {
+    records.clear();
+    for (auto* shard : shards) {
+      auto iter = shard->tablets_.find(tablet_id);
+      if (iter == shard->tablets_.end()) {
+        continue;
+      }
+      Tablet& shard_tablet = iter->second;
+      for (size_t i = 0; i < shard_tablet.times.size(); ++i) {
+        records.push_back({shard_tablet.times[i], &shard_tablet, i});
+      }
+    }
+    // Stable, so that records of the same time keep the order of the shards.
+    std::stable_sort(records.begin(), records.end(),
+                     [](const ShardRecord& a, const ShardRecord& b) { return a.time < b.time; });
+
+    Tablet* tablet = GetTablet(tablet_id);
+    for (size_t col_idx = 0; col_idx < tablet->records.size(); ++col_idx) {
+      ColumnWrapper* col = tablet->records[col_idx].get();
+#define TYPE_CASE(_dt_) MoveShardRecords<_dt_>(records, col_idx, col);
+      PX_SWITCH_FOREACH_DATATYPE(col->data_type(), TYPE_CASE);
+#undef TYPE_CASE
+    }
+    tablet->times.reserve(tablet->times.size() + records.size());
+    for (const auto& record : records) {
+      tablet->times.push_back(record.time);
+    }
+  }
+
+  for (auto* shard : shards) {
+    shard->tablets_.clear();
+  }
+}
+
 std::vector<TaggedRecordBatch> DataTable::ConsumeRecords() {
   std::vector<TaggedRecordBatch> tablets_out;
   absl::flat_hash_map<types::TabletID, Tablet> carryover_tablets;
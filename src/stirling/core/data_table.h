@@ -83,6 +83,15 @@ class DataTable : public NotCopyable {
     cutoff_time_ = cutoff_time;
   }
 
+  /**
+   * Moves the records of the shards into this table, merged in timestamp order.
+   * The shards are tables of the same schema that were filled concurrently, e.g. by the worker
+   * threads of a source connector. They are left empty.
+   *
+   * @param shards The tables whose records are moved.
+   */
+  void MergeShards(const std::vector<DataTable*>& shards);
+
   /**
    * Return current occupancy of the Data Table.
    *
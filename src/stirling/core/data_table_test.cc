@@ -69,6 +69,36 @@ TEST_F(DataTableTest, ResultIsSorted) {
   }
 }
 
+TEST_F(DataTableTest, MergeShards) {
+  DataTable shard0(/*id*/ 0, kSchema);
+  DataTable shard1(/*id*/ 0, kSchema);
+
+  // Each shard gets every other record, out of order.
+  std::vector<int> time_vals = {30, 0, 50, 10, 20, 40};
+  for (size_t i = 0; i < time_vals.size(); ++i) {
+    DataTable* shard = (i % 2 == 0) ? &shard0 : &shard1;
+    DataTable::RecordBuilder<&kSchema> r(shard, time_vals[i]);
+    r.Append<r.ColIndex("time_")>(time_vals[i]);
+    r.Append<r.ColIndex("x")>(time_vals[i] / 10);
+    r.Append<r.ColIndex("s")>(std::string(1, 'a' + time_vals[i] / 10));
+  }
+
+  data_table_->MergeShards({&shard0, &shard1});
+  EXPECT_EQ(data_table_->Occupancy(), time_vals.size());
+  EXPECT_EQ(shard0.Occupancy(), 0);
+  EXPECT_EQ(shard1.Occupancy(), 0);
+
+  std::vector<TaggedRecordBatch> record_batches = data_table_->ConsumeRecords();
+  ASSERT_EQ(record_batches.size(), 1);
+  types::ColumnWrapperRecordBatch& rb = record_batches[0].records;
+  ASSERT_EQ(rb[0]->Size(), time_vals.size());
+  for (size_t i = 0; i < time_vals.size(); ++i) {
+    EXPECT_EQ(rb[0]->Get<types::Time64NSValue>(i), 10 * static_cast<int>(i));
+    EXPECT_EQ(rb[1]->Get<types::Int64Value>(i), static_cast<int>(i));
+    EXPECT_EQ(rb[2]->Get<types::StringValue>(i), std::string(1, 'a' + i));
+  }
+}
+
 // No time passed to RecordBuilder, so all timestamps should be zero.
 // That means there should never be any expired or carry-over records.
 // Also, nothing should be sorted in any way.
@@ -66,6 +66,13 @@ void SourceConnector::PushData(DataPushCallback agent_callback) {
   }
 }
 
+void SourceConnector::PollBuffers() {
+  if (state_ != State::kActive) {
+    return;
+  }
+  PollBuffersImpl();
+}
+
 Status SourceConnector::Stop() {
   if (state_ != State::kActive) {
     return Status::OK();
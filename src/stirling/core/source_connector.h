@@ -77,6 +77,13 @@ class SourceConnector : public NotCopyable {
    */
   void PushData(DataPushCallback agent_callback);
 
+  /**
+   * Drains the buffers that the kernel fills between calls to TransferData() (e.g. perf buffers),
+   * so they don't overflow. Called from a separate thread, but never concurrently with
+   * TransferData() or PushData(). Does nothing unless the connector is active.
+   */
+  void PollBuffers();
+
   /**
    * Stops the source connector and releases any acquired resources.
    * May only be called after a successful Init().
@@ -143,6 +150,10 @@ class SourceConnector : public NotCopyable {
 
   virtual void TransferDataImpl(ConnectorContext* /* ctx */) = 0;
 
+  // SourceConnectors only need override if they have buffers that can overflow between calls to
+  // TransferData().
+  virtual void PollBuffersImpl() {}
+
   virtual Status StopImpl() = 0;
 
  protected:
@@ -44,9 +44,17 @@ const int32_t kInvalidFD = -1;
 // is reported to user-space. It applies to read and write traffic combined.
 const int kConnStatsDataThreshold = 65536;
 
-// This is the perf buffer for BPF program to export data from kernel to user space.
+// These are the buffers for BPF program to export data from kernel to user space.
+// On Linux 5.8+, socket data and control events go through ring buffers that are shared by all
+// CPUs (USE_RINGBUF), which are sized by user-space with the *_RINGBUF_PAGES defines.
+#if USE_RINGBUF
+BPF_RINGBUF_OUTPUT(socket_data_events, SOCKET_DATA_RINGBUF_PAGES);
+BPF_RINGBUF_OUTPUT(socket_control_events, SOCKET_CONTROL_RINGBUF_PAGES);
+BPF_ARRAY(ringbuf_lost_events, uint64_t, kNumRingBufLostIdxs);
+#else
 BPF_PERF_OUTPUT(socket_data_events);
 BPF_PERF_OUTPUT(socket_control_events);
+#endif
 BPF_PERF_OUTPUT(conn_stats_events);
 
 // This output is used to export notification of processes that have performed an mmap.
@@ -376,6 +384,39 @@ static __inline void read_sockaddr_kernel(struct conn_info_t* conn_info,
   }
 }
 
+#if USE_RINGBUF
+// Ring buffers don't report lost events to user-space, so they are counted here instead.
+static __inline void count_ringbuf_lost_event(int idx) {
+  uint64_t* count = ringbuf_lost_events.lookup(&idx);
+  if (count != NULL) {
+    lock_xadd(count, 1);
+  }
+}
+#endif
+
+static __inline void submit_control_event(struct pt_regs* ctx,
+                                          struct socket_control_event_t* control_event) {
+#if USE_RINGBUF
+  if (socket_control_events.ringbuf_output(control_event, sizeof(struct socket_control_event_t),
+                                           0) != 0) {
+    count_ringbuf_lost_event(kRingBufLostControlIdx);
+  }
+#else
+  socket_control_events.perf_submit(ctx, control_event, sizeof(struct socket_control_event_t));
+#endif
+}
+
+static __inline void submit_data_event(struct pt_regs* ctx, struct socket_data_event_t* event,
+                                       size_t size) {
+#if USE_RINGBUF
+  if (socket_data_events.ringbuf_output(event, size, 0) != 0) {
+    count_ringbuf_lost_event(kRingBufLostDataIdx);
+  }
+#else
+  socket_data_events.perf_submit(ctx, event, size);
+#endif
+}
+
 static __inline void submit_new_conn(struct pt_regs* ctx, uint32_t tgid, int32_t fd,
                                      const struct sockaddr* addr, const struct socket* socket,
                                      enum endpoint_role_t role, enum source_function_t source_fn) {
@@ -407,7 +448,7 @@ static __inline void submit_new_conn(struct pt_regs* ctx, uint32_t tgid, int32_t
   control_event.open.laddr = conn_info.laddr;
   control_event.open.role = conn_info.role;
 
-  socket_control_events.perf_submit(ctx, &control_event, sizeof(struct socket_control_event_t));
+  submit_control_event(ctx, &control_event);
 }
 
 static __inline void submit_close_event(struct pt_regs* ctx, struct conn_info_t* conn_info,
@@ -420,7 +461,7 @@ static __inline void submit_close_event(struct pt_regs* ctx, struct conn_info_t*
   control_event.close.rd_bytes = conn_info->rd_bytes;
   control_event.close.wr_bytes = conn_info->wr_bytes;
 
-  socket_control_events.perf_submit(ctx, &control_event, sizeof(struct socket_control_event_t));
+  submit_control_event(ctx, &control_event);
 }
 
 // Writes the input buf to event, and submits the event to the corresponding perf buffer.
@@ -493,7 +534,7 @@ static __inline void perf_submit_buf(struct pt_regs* ctx, const enum traffic_dir
   // If-statement is redundant, but is required to keep the 4.14 verifier happy.
   if (amount_copied > 0) {
     event->attr.msg_buf_size = amount_copied;
-    socket_data_events.perf_submit(ctx, event, sizeof(event->attr) + amount_copied);
+    submit_data_event(ctx, event, sizeof(event->attr) + amount_copied);
   }
 }
 
@@ -899,7 +940,7 @@ static __inline void process_syscall_sendfile(struct pt_regs* ctx, uint64_t id,
     event->attr.pos = conn_info->wr_bytes;
     event->attr.msg_size = bytes_count;
     event->attr.msg_buf_size = 0;
-    socket_data_events.perf_submit(ctx, event, sizeof(event->attr));
+    submit_data_event(ctx, event, sizeof(event->attr));
   }
 
   update_conn_stats(ctx, conn_info, kEgress, bytes_count);
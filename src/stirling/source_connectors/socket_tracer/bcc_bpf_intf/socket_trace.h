@@ -31,6 +31,16 @@ const char kControlValuesArrayName[] = "control_values";
 
 const int64_t kTraceAllTGIDs = -1;
 
+// When socket events are submitted through ring buffers, the number of events that did not fit is
+// counted in this array, indexed by ringbuf_lost_idx_t.
+const char kRingBufLostEventsArrayName[] = "ringbuf_lost_events";
+
+enum ringbuf_lost_idx_t {
+  kRingBufLostDataIdx = 0,
+  kRingBufLostControlIdx,
+  kNumRingBufLostIdxs,
+};
+
 // Note: A value of 100 results in >4096 BPF instructions, which is too much for older kernels.
 #define CONN_CLEANUP_ITERS 85
 const int kMaxConnMapCleanupItems = CONN_CLEANUP_ITERS;
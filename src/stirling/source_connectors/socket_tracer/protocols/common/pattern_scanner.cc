@@ -0,0 +1,171 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/pattern_scanner.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+
+#include "src/common/base/base.h"
+
+namespace px {
+namespace stirling {
+namespace protocols {
+
+PatternScanner::PatternScanner(const std::vector<std::string_view>& patterns) {
+  for (std::string_view pattern : patterns) {
+    DCHECK(!pattern.empty());
+    patterns_.emplace_back(pattern);
+    first_bytes_[static_cast<uint8_t>(pattern[0])] = true;
+    if (pattern.size() == 1) {
+      prefix_bytes_.push_back(pattern[0]);
+    } else {
+      prefix_pairs_.emplace_back(pattern[0], pattern[1]);
+    }
+  }
+
+  std::sort(prefix_bytes_.begin(), prefix_bytes_.end());
+  prefix_bytes_.erase(std::unique(prefix_bytes_.begin(), prefix_bytes_.end()),
+                      prefix_bytes_.end());
+  // A pair is redundant if its first byte is a prefix on its own.
+  prefix_pairs_.erase(std::remove_if(prefix_pairs_.begin(), prefix_pairs_.end(),
+                                     [this](const std::pair<char, char>& pair) {
+                                       return std::binary_search(prefix_bytes_.begin(),
+                                                                 prefix_bytes_.end(), pair.first);
+                                     }),
+                      prefix_pairs_.end());
+  std::sort(prefix_pairs_.begin(), prefix_pairs_.end());
+  prefix_pairs_.erase(std::unique(prefix_pairs_.begin(), prefix_pairs_.end()),
+                      prefix_pairs_.end());
+
+  use_simd_ = prefix_bytes_.size() + prefix_pairs_.size() <= kMaxSIMDPrefixes;
+}
+
+PatternScanner PatternScanner::AnyOf(std::string_view bytes) {
+  std::vector<std::string_view> patterns;
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    patterns.push_back(bytes.substr(i, 1));
+  }
+  return PatternScanner(patterns);
+}
+
+bool PatternScanner::MatchesAt(std::string_view buf, size_t pos) const {
+  std::string_view tail = buf.substr(pos);
+  for (const std::string& pattern : patterns_) {
+    if (tail.size() >= pattern.size() && tail.compare(0, pattern.size(), pattern) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t PatternScanner::FindScalar(std::string_view buf, size_t pos) const {
+  for (; pos < buf.size(); ++pos) {
+    if (first_bytes_[static_cast<uint8_t>(buf[pos])] && MatchesAt(buf, pos)) {
+      return pos;
+    }
+  }
+  return std::string_view::npos;
+}
+
+#if defined(__x86_64__)
+
+// SSE2 is part of x86-64, so it needs no check. The pair comparisons also load the byte after each
+// block, so the blocks stop one byte before the end of the buffer, and the scalar scan finishes it.
+size_t PatternScanner::FindSSE2(std::string_view buf, size_t pos) const {
+  constexpr size_t kBlockSize = sizeof(__m128i);
+  const char* data = buf.data();
+  for (; pos + kBlockSize < buf.size(); pos += kBlockSize) {
+    const __m128i block0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    const __m128i block1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 1));
+    uint32_t mask = 0;
+    for (char c : prefix_bytes_) {
+      mask |= _mm_movemask_epi8(_mm_cmpeq_epi8(block0, _mm_set1_epi8(c)));
+    }
+    for (const auto& [c0, c1] : prefix_pairs_) {
+      const __m128i match0 = _mm_cmpeq_epi8(block0, _mm_set1_epi8(c0));
+      const __m128i match1 = _mm_cmpeq_epi8(block1, _mm_set1_epi8(c1));
+      mask |= _mm_movemask_epi8(_mm_and_si128(match0, match1));
+    }
+    for (; mask != 0; mask &= mask - 1) {
+      size_t candidate = pos + __builtin_ctz(mask);
+      if (MatchesAt(buf, candidate)) {
+        return candidate;
+      }
+    }
+  }
+  return FindScalar(buf, pos);
+}
+
+__attribute__((target("avx2"))) size_t PatternScanner::FindAVX2(std::string_view buf,
+                                                                  size_t pos) const {
+  constexpr size_t kBlockSize = sizeof(__m256i);
+  const char* data = buf.data();
+  for (; pos + kBlockSize < buf.size(); pos += kBlockSize) {
+    const __m256i block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    const __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos + 1));
+    uint32_t mask = 0;
+    for (char c : prefix_bytes_) {
+      mask |= _mm256_movemask_epi8(_mm256_cmpeq_epi8(block0, _mm256_set1_epi8(c)));
+    }
+    for (const auto& [c0, c1] : prefix_pairs_) {
+      const __m256i match0 = _mm256_cmpeq_epi8(block0, _mm256_set1_epi8(c0));
+      const __m256i match1 = _mm256_cmpeq_epi8(block1, _mm256_set1_epi8(c1));
+      mask |= _mm256_movemask_epi8(_mm256_and_si256(match0, match1));
+    }
+    for (; mask != 0; mask &= mask - 1) {
+      size_t candidate = pos + __builtin_ctz(mask);
+      if (MatchesAt(buf, candidate)) {
+        return candidate;
+      }
+    }
+  }
+  return FindScalar(buf, pos);
+}
+
+size_t PatternScanner::Find(std::string_view buf, size_t pos) const {
+  if (!use_simd_) {
+    return FindScalar(buf, pos);
+  }
+  static const bool kHasAVX2 = __builtin_cpu_supports("avx2");
+  return kHasAVX2 ? FindAVX2(buf, pos) : FindSSE2(buf, pos);
+}
+
+#else
+
+size_t PatternScanner::FindSSE2(std::string_view buf, size_t pos) const {
+  return FindScalar(buf, pos);
+}
+
+size_t PatternScanner::FindAVX2(std::string_view buf, size_t pos) const {
+  return FindScalar(buf, pos);
+}
+
+size_t PatternScanner::Find(std::string_view buf, size_t pos) const {
+  return FindScalar(buf, pos);
+}
+
+#endif
+
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace px {
+namespace stirling {
+namespace protocols {
+
+/**
+ * PatternScanner finds the first occurrence of any of a set of patterns in a buffer. It's used to
+ * search for message boundaries, which may be preceded by a lot of unparseable data when a
+ * connection resyncs in the middle of a stream.
+ *
+ * Instead of searching for every pattern in turn, the buffer is scanned once, 32 (AVX2) or 16
+ * (SSE2) bytes at a time, for the first two bytes of any pattern, and the full patterns are only
+ * compared at those candidate positions. Falls back to a scalar scan of the first bytes when SIMD
+ * is not available, or when there are too many distinct prefixes to compare against.
+ */
+class PatternScanner {
+ public:
+  explicit PatternScanner(const std::vector<std::string_view>& patterns);
+
+  /**
+   * Returns a scanner for any one of the bytes.
+   */
+  static PatternScanner AnyOf(std::string_view bytes);
+
+  /**
+   * Returns the position of the first pattern that starts at or after pos, and fits in the buffer,
+   * or npos if there is none.
+   */
+  size_t Find(std::string_view buf, size_t pos = 0) const;
+
+  /**
+   * Same as Find(), but never uses SIMD. Exposed for tests and benchmarks.
+   */
+  size_t FindScalar(std::string_view buf, size_t pos = 0) const;
+
+ private:
+  // The largest number of distinct pattern prefixes that are compared with SIMD.
+  static constexpr size_t kMaxSIMDPrefixes = 32;
+
+  // Returns true if one of the patterns starts at pos.
+  bool MatchesAt(std::string_view buf, size_t pos) const;
+
+  size_t FindSSE2(std::string_view buf, size_t pos) const;
+  size_t FindAVX2(std::string_view buf, size_t pos) const;
+
+  std::vector<std::string> patterns_;
+  // Whether a pattern starts with each byte.
+  std::array<bool, 256> first_bytes_ = {};
+  // The distinct first two bytes of the patterns, and the first byte of single byte patterns.
+  std::vector<std::pair<char, char>> prefix_pairs_;
+  std::vector<char> prefix_bytes_;
+  bool use_simd_ = false;
+};
+
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
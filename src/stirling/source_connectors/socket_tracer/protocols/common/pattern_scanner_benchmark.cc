@@ -0,0 +1,90 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/common/base/base.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/pattern_scanner.h"
+
+using px::stirling::protocols::PatternScanner;
+
+const std::vector<std::string_view> kHTTPReqStartPatterns = {
+    "GET ", "HEAD ", "POST ", "PUT ", "DELETE ", "CONNECT ", "OPTIONS ", "TRACE ", "PATCH ",
+};
+
+// A stream that resyncs in the middle of a message body: a prefix of garbage, here random
+// printable text, followed by the next request.
+std::string CreateStream(size_t garbage_size) {
+  std::default_random_engine rng(37);
+  std::uniform_int_distribution<int> printable(' ', '~');
+
+  std::string stream(garbage_size, ' ');
+  for (char& c : stream) {
+    c = static_cast<char>(printable(rng));
+  }
+  stream += "GET /index.html HTTP/1.1\r\nHost: www.pixielabs.ai\r\n\r\n";
+  return stream;
+}
+
+// NOLINTNEXTLINE : runtime/references.
+static void BM_string_view_find(benchmark::State& state) {
+  const std::string stream = CreateStream(state.range(0));
+  for (auto _ : state) {
+    size_t pos = std::string_view::npos;
+    for (std::string_view pattern : kHTTPReqStartPatterns) {
+      pos = std::min(pos, std::string_view(stream).find(pattern));
+    }
+    CHECK_EQ(pos, static_cast<size_t>(state.range(0)));
+    benchmark::DoNotOptimize(pos);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+}
+
+// NOLINTNEXTLINE : runtime/references.
+static void BM_pattern_scanner_scalar(benchmark::State& state) {
+  const std::string stream = CreateStream(state.range(0));
+  const PatternScanner scanner(kHTTPReqStartPatterns);
+  for (auto _ : state) {
+    size_t pos = scanner.FindScalar(stream);
+    CHECK_EQ(pos, static_cast<size_t>(state.range(0)));
+    benchmark::DoNotOptimize(pos);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+}
+
+// NOLINTNEXTLINE : runtime/references.
+static void BM_pattern_scanner(benchmark::State& state) {
+  const std::string stream = CreateStream(state.range(0));
+  const PatternScanner scanner(kHTTPReqStartPatterns);
+  for (auto _ : state) {
+    size_t pos = scanner.Find(stream);
+    CHECK_EQ(pos, static_cast<size_t>(state.range(0)));
+    benchmark::DoNotOptimize(pos);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+}
+
+BENCHMARK(BM_string_view_find)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK(BM_pattern_scanner_scalar)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK(BM_pattern_scanner)->RangeMultiplier(8)->Range(64, 1 << 18);
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/pattern_scanner.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <absl/strings/escaping.h>
+
+#include "src/common/testing/testing.h"
+
+namespace px {
+namespace stirling {
+namespace protocols {
+
+constexpr size_t kNPos = std::string_view::npos;
+
+TEST(PatternScannerTest, Find) {
+  PatternScanner scanner({"GET ", "POST ", "PUT "});
+
+  EXPECT_EQ(scanner.Find(""), kNPos);
+  EXPECT_EQ(scanner.Find("GET /"), 0);
+  EXPECT_EQ(scanner.Find("garbage PUT /"), 8);
+  EXPECT_EQ(scanner.Find("GET /, PUT /", 1), 7);
+  EXPECT_EQ(scanner.Find("PUSH POS"), kNPos);
+  // The pattern must fit in the buffer.
+  EXPECT_EQ(scanner.Find("garbage POST"), kNPos);
+
+  // Past the first SIMD blocks.
+  const std::string buf = std::string(100, 'P') + "POST /";
+  EXPECT_EQ(scanner.Find(buf), 100);
+  EXPECT_EQ(scanner.FindScalar(buf), 100);
+}
+
+TEST(PatternScannerTest, AnyOf) {
+  PatternScanner scanner = PatternScanner::AnyOf("+-*");
+
+  EXPECT_EQ(scanner.Find("abc*"), 3);
+  EXPECT_EQ(scanner.Find("-abc*", 1), 4);
+  EXPECT_EQ(scanner.Find(std::string(100, 'a')), kNPos);
+}
+
+// Compares the scanner to a search for each pattern, over random buffers with many partial
+// matches, for both the SIMD and the scalar scan.
+TEST(PatternScannerTest, MatchesStringFind) {
+  std::vector<std::vector<std::string_view>> pattern_sets = {
+      {"GET ", "HEAD ", "POST ", "PUT ", "DELETE ", "CONNECT ", "OPTIONS ", "TRACE ", "PATCH "},
+      {"\r\n\r\n"},
+      {"+", "-", ":", "$", "*"},
+      {"ab", "a", "xy"},
+  };
+  // More prefixes than are compared with SIMD.
+  constexpr std::string_view kManyPrefixes = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJ";
+  std::vector<std::string_view>& many_prefixes = pattern_sets.emplace_back();
+  for (size_t i = 0; i < kManyPrefixes.size(); ++i) {
+    many_prefixes.push_back(kManyPrefixes.substr(i, 1));
+  }
+  constexpr std::string_view kAlphabet = "GETHADPOSUCabxyq \r\n+-:$*";
+
+  std::default_random_engine rng(37);
+  for (const auto& patterns : pattern_sets) {
+    PatternScanner scanner(patterns);
+    for (int i = 0; i < 1000; ++i) {
+      std::string buf(rng() % 200, ' ');
+      for (char& c : buf) {
+        c = kAlphabet[rng() % kAlphabet.size()];
+      }
+      size_t pos = rng() % (buf.size() + 1);
+
+      size_t expected = kNPos;
+      for (std::string_view pattern : patterns) {
+        expected = std::min(expected, std::string_view(buf).find(pattern, pos));
+      }
+      ASSERT_EQ(scanner.Find(buf, pos), expected) << absl::CEscape(buf) << " " << pos;
+      ASSERT_EQ(scanner.FindScalar(buf, pos), expected) << absl::CEscape(buf) << " " << pos;
+    }
+  }
+}
+
+}  // namespace protocols
+}  // namespace stirling
+}  // namespace px
@@ -247,6 +247,17 @@ ParseState ParseChunked(std::string_view* data, size_t body_size_limit_bytes, st
 
 ParseState ParseContent(std::string_view content_len_str, std::string_view* data,
                         size_t body_size_limit_bytes, std::string* result, size_t* body_size) {
+  std::string_view body;
+  ParseState s = ParseContent(content_len_str, data, body_size_limit_bytes, &body, body_size);
+  if (s == ParseState::kSuccess) {
+    *result = body;
+  }
+  return s;
+}
+
+ParseState ParseContent(std::string_view content_len_str, std::string_view* data,
+                        size_t body_size_limit_bytes, std::string_view* result,
+                        size_t* body_size) {
   size_t len;
   if (!absl::SimpleAtoi(content_len_str, &len)) {
     LOG(ERROR) << absl::Substitute("Unable to parse Content-Length: $0", content_len_str);
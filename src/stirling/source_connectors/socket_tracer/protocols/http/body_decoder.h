@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "src/stirling/utils/parse_state.h"
 
@@ -57,6 +58,13 @@ ParseState ParseChunked(std::string_view* buf, size_t body_size_limit_bytes, std
 ParseState ParseContent(std::string_view content_len_str, std::string_view* data,
                         size_t body_size_limit_bytes, std::string* result, size_t* body_size);
 
+/**
+ * Same as above, but the result views into the data buffer instead of copying the body.
+ */
+ParseState ParseContent(std::string_view content_len_str, std::string_view* data,
+                        size_t body_size_limit_bytes, std::string_view* result,
+                        size_t* body_size);
+
 }  // namespace http
 }  // namespace protocols
 }  // namespace stirling
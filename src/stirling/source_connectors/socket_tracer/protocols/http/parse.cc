@@ -18,12 +18,15 @@
 
 #include "src/stirling/source_connectors/socket_tracer/protocols/http/parse.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/http/body_decoder.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/common/pattern_scanner.h"
 
 #include <picohttpparser.h>
 
 #include <algorithm>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 DEFINE_uint32(http_body_limit_bytes,
               gflags::Uint32FromEnv("PX_STIRLING_HTTP_BODY_LIMIT_BYTES", 1024),
@@ -75,19 +78,19 @@ int ParseResponse(std::string_view buf, HTTPResponse* result) {
                             /*last_len*/ 0);
 }
 
-HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t num_headers) {
-  HeadersMap result;
+void GetHTTPHeaderViews(const phr_header* headers, size_t num_headers,
+                        std::vector<HeaderView>* result) {
+  result->clear();
+  result->reserve(num_headers);
   for (size_t i = 0; i < num_headers; i++) {
-    std::string name(headers[i].name, headers[i].name_len);
-    std::string value(headers[i].value, headers[i].value_len);
-    result.emplace(std::move(name), std::move(value));
+    result->push_back({std::string_view(headers[i].name, headers[i].name_len),
+                       std::string_view(headers[i].value, headers[i].value_len)});
   }
-  return result;
 }
 
 }  // namespace pico_wrapper
 
-ParseState ParseRequestBody(std::string_view* buf, Message* result) {
+ParseState ParseRequestBody(std::string_view* buf, MessageView* result) {
   // From https://tools.ietf.org/html/rfc7230:
   //  A sender MUST NOT send a Content-Length header field in any message
   //  that contains a Transfer-Encoding header field.
@@ -102,21 +105,20 @@ ParseState ParseRequestBody(std::string_view* buf, Message* result) {
   //  body.
 
   // Case 1: Content-Length
-  const auto content_length_iter = result->headers.find(kContentLength);
-  if (content_length_iter != result->headers.end()) {
-    std::string_view content_len_str = content_length_iter->second;
-    auto r = ParseContent(content_len_str, buf, FLAGS_http_body_limit_bytes, &result->body,
+  const std::optional<std::string_view> content_len_str = result->FindHeader(kContentLength);
+  if (content_len_str.has_value()) {
+    auto r = ParseContent(*content_len_str, buf, FLAGS_http_body_limit_bytes, &result->body,
                           &result->body_size);
     CTX_DCHECK_LE(result->body.size(), FLAGS_http_body_limit_bytes);
     return r;
   }
 
   // Case 2: Chunked transfer.
-  const auto transfer_encoding_iter = result->headers.find(kTransferEncoding);
-  if (transfer_encoding_iter != result->headers.end() &&
-      transfer_encoding_iter->second == "chunked") {
-    auto s = ParseChunked(buf, FLAGS_http_body_limit_bytes, &result->body, &result->body_size);
-    CTX_DCHECK_LE(result->body.size(), FLAGS_http_body_limit_bytes);
+  if (result->FindHeader(kTransferEncoding) == "chunked") {
+    std::string body;
+    auto s = ParseChunked(buf, FLAGS_http_body_limit_bytes, &body, &result->body_size);
+    CTX_DCHECK_LE(body.size(), FLAGS_http_body_limit_bytes);
+    result->decoded_body = std::move(body);
     return s;
   }
 
@@ -131,7 +133,7 @@ ParseState ParseRequestBody(std::string_view* buf, Message* result) {
   return ParseState::kSuccess;
 }
 
-ParseState ParseResponseBody(std::string_view* buf, Message* result, State* state) {
+ParseState ParseResponseBody(std::string_view* buf, MessageView* result, State* state) {
   // Case 0: Check for a HEAD response with no body.
   // Responses to HEAD requests are special, because they may include Content-Length
   // or Transfer-Encoding, but the body will still be empty.
@@ -152,21 +154,20 @@ ParseState ParseResponseBody(std::string_view* buf, Message* result, State* stat
   }
 
   // Case 1: Content-Length
-  const auto content_length_iter = result->headers.find(kContentLength);
-  if (content_length_iter != result->headers.end()) {
-    std::string_view content_len_str = content_length_iter->second;
-    auto s = ParseContent(content_len_str, buf, FLAGS_http_body_limit_bytes, &result->body,
+  const std::optional<std::string_view> content_len_str = result->FindHeader(kContentLength);
+  if (content_len_str.has_value()) {
+    auto s = ParseContent(*content_len_str, buf, FLAGS_http_body_limit_bytes, &result->body,
                           &result->body_size);
     CTX_DCHECK_LE(result->body.size(), FLAGS_http_body_limit_bytes);
     return s;
   }
 
   // Case 2: Chunked transfer.
-  const auto transfer_encoding_iter = result->headers.find(kTransferEncoding);
-  if (transfer_encoding_iter != result->headers.end() &&
-      transfer_encoding_iter->second == "chunked") {
-    auto s = ParseChunked(buf, FLAGS_http_body_limit_bytes, &result->body, &result->body_size);
-    CTX_DCHECK_LE(result->body.size(), FLAGS_http_body_limit_bytes);
+  if (result->FindHeader(kTransferEncoding) == "chunked") {
+    std::string body;
+    auto s = ParseChunked(buf, FLAGS_http_body_limit_bytes, &body, &result->body_size);
+    CTX_DCHECK_LE(body.size(), FLAGS_http_body_limit_bytes);
+    result->decoded_body = std::move(body);
     return s;
   }
 
@@ -179,8 +180,7 @@ ParseState ParseResponseBody(std::string_view* buf, Message* result, State* stat
 
     // Status 101 is an even more special case.
     if (result->resp_status == 101) {
-      const auto upgrade_iter = result->headers.find(kUpgrade);
-      if (upgrade_iter == result->headers.end()) {
+      if (!result->FindHeader(kUpgrade).has_value()) {
         LOG(WARNING) << "Expected an Upgrade header with HTTP status 101";
       }
 
@@ -211,7 +211,7 @@ ParseState ParseResponseBody(std::string_view* buf, Message* result, State* stat
   return ParseState::kNeedsMoreData;
 }
 
-ParseState ParseRequest(std::string_view* buf, Message* result) {
+ParseState ParseRequest(std::string_view* buf, MessageView* result) {
   pico_wrapper::HTTPRequest req;
   int retval = pico_wrapper::ParseRequest(*buf, &req);
 
@@ -220,9 +220,9 @@ ParseState ParseRequest(std::string_view* buf, Message* result) {
 
     result->type = message_type_t::kRequest;
     result->minor_version = req.minor_version;
-    result->headers = pico_wrapper::GetHTTPHeadersMap(req.headers, req.num_headers);
-    result->req_method = std::string(req.method, req.method_len);
-    result->req_path = std::string(req.path, req.path_len);
+    pico_wrapper::GetHTTPHeaderViews(req.headers, req.num_headers, &result->headers);
+    result->req_method = std::string_view(req.method, req.method_len);
+    result->req_path = std::string_view(req.path, req.path_len);
     result->headers_byte_size = retval;
 
     return ParseRequestBody(buf, result);
@@ -233,7 +233,7 @@ ParseState ParseRequest(std::string_view* buf, Message* result) {
   return ParseState::kInvalid;
 }
 
-ParseState ParseResponse(std::string_view* buf, Message* result, State* state) {
+ParseState ParseResponse(std::string_view* buf, MessageView* result, State* state) {
   pico_wrapper::HTTPResponse resp;
   int retval = pico_wrapper::ParseResponse(*buf, &resp);
 
@@ -242,9 +242,9 @@ ParseState ParseResponse(std::string_view* buf, Message* result, State* state) {
 
     result->type = message_type_t::kResponse;
     result->minor_version = resp.minor_version;
-    result->headers = pico_wrapper::GetHTTPHeadersMap(resp.headers, resp.num_headers);
+    pico_wrapper::GetHTTPHeaderViews(resp.headers, resp.num_headers, &result->headers);
     result->resp_status = resp.status;
-    result->resp_message = std::string(resp.msg, resp.msg_len);
+    result->resp_message = std::string_view(resp.msg, resp.msg_len);
     result->headers_byte_size = retval;
 
     return ParseResponseBody(buf, result, state);
@@ -265,7 +265,8 @@ ParseState ParseResponse(std::string_view* buf, Message* result, State* state) {
  * @param result: A parsed HTTP message, if parse was successful (must consider return value).
  * @return parse state indicating how the parse progressed.
  */
-ParseState ParseFrame(message_type_t type, std::string_view* buf, Message* result, State* state) {
+ParseState ParseFrame(message_type_t type, std::string_view* buf, MessageView* result,
+                      State* state) {
   switch (type) {
     case message_type_t::kRequest:
       return ParseRequest(buf, result);
@@ -276,6 +277,16 @@ ParseState ParseFrame(message_type_t type, std::string_view* buf, Message* resul
   }
 }
 
+ParseState ParseFrame(message_type_t type, std::string_view* buf, Message* result, State* state) {
+  MessageView view;
+  ParseState s = ParseFrame(type, buf, &view, state);
+  // Only complete messages are copied, the others are discarded by the caller.
+  if (s == ParseState::kSuccess || s == ParseState::kEOS) {
+    view.CopyTo(result);
+  }
+  return s;
+}
+
 // TODO(oazizi/yzhao): This function should use is_http_{response,request} inside
 // bcc_bpf/socket_trace.c to check if a sequence of bytes are aligned on HTTP message boundary.
 // ATM, they actually do not share the same logic. As a result, BPF events detected as HTTP traffic,
@@ -284,23 +295,19 @@ ParseState ParseFrame(message_type_t type, std::string_view* buf, Message* resul
 size_t FindFrameBoundary(message_type_t type, std::string_view buf, size_t start_pos) {
   // List of all HTTP request methods. All HTTP requests start with one of these.
   // https://developer.mozilla.org/en-US/docs/Web/HTTP/Methods
-  static constexpr std::string_view kHTTPReqStartPatternArray[] = {
+  static const PatternScanner kHTTPReqStartPatterns({
       "GET ", "HEAD ", "POST ", "PUT ", "DELETE ", "CONNECT ", "OPTIONS ", "TRACE ", "PATCH ",
-  };
+  });
 
   // List of supported HTTP protocol versions. HTTP responses typically start with one of these.
   // https://developer.mozilla.org/en-US/docs/Web/HTTP/Messages
-  static constexpr std::string_view kHTTPRespStartPatternArray[] = {"HTTP/1.1 ", "HTTP/1.0 "};
-
-  static constexpr ArrayView<std::string_view> kHTTPReqStartPatterns =
-      ArrayView<std::string_view>(kHTTPReqStartPatternArray);
-  static constexpr ArrayView<std::string_view> kHTTPRespStartPatterns =
-      ArrayView<std::string_view>(kHTTPRespStartPatternArray);
+  static const PatternScanner kHTTPRespStartPatterns({"HTTP/1.1 ", "HTTP/1.0 "});
 
   static constexpr std::string_view kBoundaryMarker = "\r\n\r\n";
+  static const PatternScanner kBoundaryMarkerScanner({kBoundaryMarker});
 
   // Choose the right set of patterns for request vs response.
-  const ArrayView<std::string_view>* start_patterns = nullptr;
+  const PatternScanner* start_patterns = nullptr;
   switch (type) {
     case message_type_t::kRequest:
       start_patterns = &kHTTPReqStartPatterns;
@@ -319,12 +326,12 @@ size_t FindFrameBoundary(message_type_t type, std::string_view buf, size_t start
   //   headers
   //   \r\n\r\n
   //   body
-  // We first search forwards for \r\n\r\n, then we search backwards from there for HTTP/1.1.
+  // We first search forwards for \r\n\r\n, then we search from there for the last HTTP/1.1.
   //
   // Note that we don't search forwards for HTTP/1.1 directly, because it could result in matches
   // inside the request/response body.
   while (true) {
-    size_t marker_pos = buf.find(kBoundaryMarker, start_pos);
+    size_t marker_pos = kBoundaryMarkerScanner.Find(buf, start_pos);
 
     if (marker_pos == std::string::npos) {
       return std::string::npos;
@@ -332,16 +339,12 @@ size_t FindFrameBoundary(message_type_t type, std::string_view buf, size_t start
 
     std::string_view buf_substr = buf.substr(start_pos, marker_pos - start_pos);
 
+    // We want to return the match that is closest to the marker, so we aren't
+    // matching to something in a previous message's body.
     size_t substr_pos = std::string::npos;
-    for (auto& start_pattern : *start_patterns) {
-      size_t current_substr_pos = buf_substr.rfind(start_pattern);
-      if (current_substr_pos != std::string::npos) {
-        // Found a match. Check if it is closer to the marker than our previous match.
-        // We want to return the match that is closest to the marker, so we aren't
-        // matching to something in a previous message's body.
-        substr_pos = (substr_pos == std::string::npos) ? current_substr_pos
-                                                       : std::max(substr_pos, current_substr_pos);
-      }
+    for (size_t pos = start_patterns->Find(buf_substr); pos != std::string::npos;
+         pos = start_patterns->Find(buf_substr, pos + 1)) {
+      substr_pos = pos;
     }
 
     if (substr_pos != std::string::npos) {
@@ -29,6 +29,20 @@ DECLARE_uint32(http_body_limit_bytes);
 namespace px {
 namespace stirling {
 namespace protocols {
+namespace http {
+
+/**
+ * Parses a single HTTP message from the input string, into a view of it.
+ */
+ParseState ParseFrame(message_type_t type, std::string_view* buf, MessageView* frame,
+                      State* state);
+
+/**
+ * Parses a single HTTP message from the input string, and copies it once it's complete.
+ */
+ParseState ParseFrame(message_type_t type, std::string_view* buf, Message* frame, State* state);
+
+}  // namespace http
 
 /**
  * Parses a single HTTP message from the input string.
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include <string>
+
+#include <absl/strings/str_cat.h>
+#include <benchmark/benchmark.h>
+
+#include "src/common/base/base.h"
+#include "src/stirling/source_connectors/socket_tracer/protocols/http/parse.h"
+
+using px::stirling::ParseState;
+using px::stirling::protocols::http::Message;
+using px::stirling::protocols::http::MessageView;
+using px::stirling::protocols::http::State;
+
+// A response with typical headers, and a body of the given size.
+std::string CreateResponse(size_t body_size) {
+  return absl::StrCat(
+      "HTTP/1.1 200 OK\r\n"
+      "Date: Mon, 27 Jul 2009 12:28:53 GMT\r\n"
+      "Server: Apache/2.2.14 (Win32)\r\n"
+      "Last-Modified: Wed, 22 Jul 2009 19:15:56 GMT\r\n"
+      "Cache-Control: no-cache, no-store, must-revalidate\r\n"
+      "Content-Type: application/json; charset=utf-8\r\n"
+      "X-Request-Id: 8d1c2a54-4d4a-4f4e-9a2c-1b1e2f3a4b5c\r\n"
+      "Connection: keep-alive\r\n"
+      "Content-Length: ",
+      body_size, "\r\n\r\n", std::string(body_size, 'x'));
+}
+
+// Parses the response into a Message, which copies its fields, or a MessageView, which views them.
+// The difference is the cost of the copy that frames pay at the end of the parse.
+template <typename TMessage>
+void ParseResponse(benchmark::State& state) {
+  const std::string resp = CreateResponse(state.range(0));
+  State parse_state;
+
+  for (auto _ : state) {
+    std::string_view buf = resp;
+    TMessage msg;
+    ParseState s = px::stirling::protocols::http::ParseFrame(
+        px::stirling::message_type_t::kResponse, &buf, &msg, &parse_state);
+    CHECK(s == ParseState::kSuccess);
+    benchmark::DoNotOptimize(msg);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * resp.size()));
+}
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_parse_message(benchmark::State& state) { ParseResponse<Message>(state); }
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_parse_message_view(benchmark::State& state) { ParseResponse<MessageView>(state); }
+
+BENCHMARK(BM_parse_message)->Arg(0)->Arg(512)->Arg(16384);
+BENCHMARK(BM_parse_message_view)->Arg(0)->Arg(512)->Arg(16384);
+
+// Parses a response whose body hasn't fully arrived yet, which the parser retries on every transfer
+// of the connection until the rest of the body is there. With eager_copy, the headers are copied
+// into a Message on each attempt, as they were before messages were parsed into views first.
+void ParseIncompleteResponse(benchmark::State& state, bool eager_copy) {
+  const std::string resp = CreateResponse(state.range(0));
+  const std::string_view partial_resp(resp.data(), resp.size() - state.range(0) / 2);
+  State parse_state;
+
+  for (auto _ : state) {
+    std::string_view buf = partial_resp;
+    Message msg;
+    ParseState s;
+    if (eager_copy) {
+      MessageView view;
+      s = px::stirling::protocols::http::ParseFrame(px::stirling::message_type_t::kResponse, &buf,
+                                                    &view, &parse_state);
+      view.CopyTo(&msg);
+    } else {
+      s = px::stirling::protocols::http::ParseFrame(px::stirling::message_type_t::kResponse, &buf,
+                                                    &msg, &parse_state);
+    }
+    CHECK(s == ParseState::kNeedsMoreData);
+    benchmark::DoNotOptimize(msg);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * partial_resp.size()));
+}
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_parse_incomplete_message(benchmark::State& state) {
+  ParseIncompleteResponse(state, /*eager_copy*/ false);
+}
+
+// NOLINTNEXTLINE(runtime/references)
+static void BM_parse_incomplete_message_eager_copy(benchmark::State& state) {
+  ParseIncompleteResponse(state, /*eager_copy*/ true);
+}
+
+BENCHMARK(BM_parse_incomplete_message)->Arg(512)->Arg(16384);
+BENCHMARK(BM_parse_incomplete_message_eager_copy)->Arg(512)->Arg(16384);
@@ -786,6 +786,28 @@ TEST_F(HTTPParserTest, ParseHTTPRequestMultiple) {
               ElementsAre(HTTPGetReq0ExpectedMessage(), HTTPPostReq0ExpectedMessage()));
 }
 
+TEST_F(HTTPParserTest, ParseMessageView) {
+  State state;
+  std::string_view buf = kHTTPPostReq0;
+  MessageView view;
+  ASSERT_EQ(ParseFrame(message_type_t::kRequest, &buf, &view, &state), ParseState::kSuccess);
+  EXPECT_TRUE(buf.empty());
+
+  // The fields view into the parsed buffer.
+  EXPECT_EQ(view.req_path, "/test");
+  EXPECT_EQ(view.req_path.data(), kHTTPPostReq0.data() + kHTTPPostReq0.find("/test"));
+  EXPECT_EQ(view.body, "field1=value1&field2=value2");
+  EXPECT_EQ(view.body.data(), kHTTPPostReq0.data() + kHTTPPostReq0.find("field1"));
+  ASSERT_EQ(view.headers.size(), 3U);
+  EXPECT_EQ(view.headers[1].name, "content-type");
+  EXPECT_EQ(view.FindHeader("Content-Length"), "27");
+  EXPECT_EQ(view.FindHeader("Content-Encoding"), std::nullopt);
+
+  Message message;
+  view.CopyTo(&message);
+  EXPECT_EQ(message, HTTPPostReq0ExpectedMessage());
+}
+
 TEST_P(HTTPParserTest, ParseHTTPRequestsRepeatedly) {
   StateWrapper state{};
   std::string msg = absl::StrCat(kHTTPGetReq0, kHTTPPostReq0);
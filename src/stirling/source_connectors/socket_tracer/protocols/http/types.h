@@ -19,7 +19,12 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include <absl/strings/match.h>
 
 #include "src/common/base/utils.h"
 #include "src/stirling/source_connectors/socket_tracer/protocols/common/event_parser.h"  // For FrameBase
@@ -46,6 +51,10 @@ inline constexpr char kContentType[] = "Content-Type";
 inline constexpr char kTransferEncoding[] = "Transfer-Encoding";
 inline constexpr char kUpgrade[] = "Upgrade";
 
+// Frames own copies of their fields, since the DataStreamBuffer drops the parsed bytes as soon as
+// ParseFrames() returns, while a frame can wait for its pair across many transfers. Holding views
+// into the buffer until the stitcher emits the record would require the buffer to pin the regions
+// of the frames that are still queued, which it doesn't support.
 struct Message : public FrameBase {
   message_type_t type = message_type_t::kUnknown;
 
@@ -79,6 +88,67 @@ struct Message : public FrameBase {
   }
 };
 
+// A header of an HTTP message, viewing into the buffer it was parsed from.
+struct HeaderView {
+  std::string_view name;
+  std::string_view value;
+};
+
+/**
+ * MessageView is an HTTP message whose fields view into the buffer it was parsed from, with its
+ * headers in a flat vector, in the order they were sent. It is only used while parsing: messages
+ * are first parsed into a view, and copied into a Message once they are complete, so that a message
+ * that is still waiting for the rest of its body doesn't copy its headers on every parse attempt.
+ * A view must not outlive the buffer passed to ParseFrame(), so it is never queued as a frame.
+ */
+struct MessageView {
+  message_type_t type = message_type_t::kUnknown;
+
+  int minor_version = -1;
+  std::vector<HeaderView> headers;
+
+  std::string_view req_method = "-";
+  std::string_view req_path = "-";
+
+  int resp_status = -1;
+  std::string_view resp_message = "-";
+
+  // The body, limited to --http_body_limit_bytes. Chunked bodies must be decoded, so they are held
+  // in decoded_body instead.
+  std::string_view body = "-";
+  std::optional<std::string> decoded_body;
+  size_t body_size = 0;
+
+  size_t headers_byte_size = 0;
+
+  // Returns the value of the first header with the name, which is case-insensitive, or nullopt.
+  std::optional<std::string_view> FindHeader(std::string_view name) const {
+    for (const HeaderView& header : headers) {
+      if (absl::EqualsIgnoreCase(header.name, name)) {
+        return header.value;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Copies the message into a Message, which owns its fields.
+  void CopyTo(Message* msg) const {
+    msg->type = type;
+    msg->minor_version = minor_version;
+    msg->headers.clear();
+    for (const HeaderView& header : headers) {
+      msg->headers.emplace(header.name, header.value);
+    }
+    msg->req_method = req_method;
+    msg->req_path = req_path;
+    msg->resp_status = resp_status;
+    msg->resp_message = resp_message;
+    msg->body = decoded_body.has_value() ? *decoded_body : std::string(body);
+    msg->body_size = body_size;
+    msg->headers_byte_size = headers_byte_size;
+  }
+};
+
 //-----------------------------------------------------------------------------
 // Table Store Entry Level Structs
 //-----------------------------------------------------------------------------
@@ -23,9 +23,16 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <utility>
 
+#include <absl/base/internal/spinlock.h>
 #include <absl/container/flat_hash_map.h>
 #include <absl/strings/match.h>
 #include <google/protobuf/text_format.h>
@@ -36,6 +43,7 @@
 #include "src/common/base/base.h"
 #include "src/common/base/utils.h"
 #include "src/common/json/json.h"
+#include "src/common/system/config.h"
 #include "src/common/system/proc_pid_path.h"
 #include "src/common/system/socket_info.h"
 #include "src/shared/metadata/metadata.h"
@@ -132,6 +140,16 @@ DEFINE_uint32(stirling_socket_tracer_target_data_bw_percpu, 100 * 1024 * 1024,
 DEFINE_uint32(stirling_socket_tracer_target_control_bw_percpu, 5 * 1024 * 1024,
               "Target bytes/sec of control events per CPU");
 
+DEFINE_bool(stirling_socket_tracer_use_ringbuf,
+            gflags::BoolFromEnv("PX_STIRLING_SOCKET_TRACER_USE_RINGBUF", true),
+            "If true, socket data and control events are exported through BPF ring buffers that "
+            "are shared by all CPUs, instead of per CPU perf buffers. "
+            "Falls back to perf buffers on kernels older than 5.8.");
+DEFINE_int32(stirling_socket_tracer_transfer_threads,
+             gflags::Int32FromEnv("PX_STIRLING_SOCKET_TRACER_TRANSFER_THREADS", 1),
+             "Number of threads that parse the data of the active connections on each transfer. "
+             "Only used when there are enough connections to keep every thread busy.");
+
 DEFINE_double(
     stirling_socket_tracer_percpu_bw_scaling_factor, 8,
     "Per CPU scaling factor to apply to perf buffers, with the formula "
@@ -356,8 +374,7 @@ using bpf_tools::PerfBufferSizeCategory;
 
 namespace {
 // Resize each category of perf buffers such that it doesn't exceed a maximum size across all cpus.
-template <size_t N>
-void ResizePerfBufferSpecs(std::array<bpf_tools::PerfBufferSpec, N>* perf_buffer_specs,
+void ResizePerfBufferSpecs(std::vector<bpf_tools::PerfBufferSpec>* perf_buffer_specs,
                            const std::map<PerfBufferSizeCategory, size_t>& category_maximums) {
   std::map<PerfBufferSizeCategory, size_t> category_sizes;
   for (const auto& spec : *perf_buffer_specs) {
@@ -393,9 +410,39 @@ void ResizePerfBufferSpecs(std::array<bpf_tools::PerfBufferSpec, N>* perf_buffer
                                   magic_enum::enum_name(category), size * kNCPUs);
   }
 }
+
+double SecondsPerSamplingPeriod(std::chrono::milliseconds sampling_period) {
+  return sampling_period.count() / 1000.0;
+}
+
+// A ring buffer is shared by all CPUs, so unlike the per CPU perf buffers, it only has to absorb
+// the bursts of the few CPUs that submit at once. It is sized for the target bandwidth of (1+x)
+// CPUs, where x is the per CPU scaling factor, and capped by the maximum total bandwidth.
+// The kernel requires a power of 2 number of pages.
+int RingBufferPages(double target_bw_percpu, double max_total_bw,
+                    std::chrono::milliseconds sampling_period) {
+  const double seconds_per_period = SecondsPerSamplingPeriod(sampling_period);
+  const double target_size = target_bw_percpu * seconds_per_period *
+                             (1 + FLAGS_stirling_socket_tracer_percpu_bw_scaling_factor);
+  const double max_size = FLAGS_stirling_socket_tracer_max_total_bw_overprovision_factor *
+                          max_total_bw * seconds_per_period;
+  const int64_t size_bytes = std::max<int64_t>(std::min(target_size, max_size), 1);
+  const int64_t page_size_bytes = system::Config::GetInstance().PageSizeBytes();
+  return static_cast<int>(IntRoundUpToPow2(IntRoundUpDivide(size_bytes, page_size_bytes)));
+}
+
+int DataRingBufferPages(std::chrono::milliseconds sampling_period) {
+  return RingBufferPages(FLAGS_stirling_socket_tracer_target_data_bw_percpu,
+                         FLAGS_stirling_socket_tracer_max_total_data_bw, sampling_period);
+}
+
+int ControlRingBufferPages(std::chrono::milliseconds sampling_period) {
+  return RingBufferPages(FLAGS_stirling_socket_tracer_target_control_bw_percpu,
+                         FLAGS_stirling_socket_tracer_max_total_control_bw, sampling_period);
+}
 }  // namespace
 
-auto SocketTraceConnector::InitPerfBufferSpecs() {
+std::vector<bpf_tools::PerfBufferSpec> SocketTraceConnector::InitPerfBufferSpecs() {
   const size_t ncpus = get_nprocs_conf();
 
   double cpu_scaling_factor = (1 + FLAGS_stirling_socket_tracer_percpu_bw_scaling_factor) /
@@ -403,8 +450,8 @@ auto SocketTraceConnector::InitPerfBufferSpecs() {
   LOG(INFO) << absl::Substitute("Initializing perf buffers with ncpus=$0 and scaling_factor=$1",
                                 ncpus, cpu_scaling_factor);
 
-  const double kSecondsPerPeriod =
-      std::chrono::duration_cast<std::chrono::milliseconds>(kSamplingPeriod).count() / 1000.0;
+  const double kSecondsPerPeriod = SecondsPerSamplingPeriod(
+      std::chrono::duration_cast<std::chrono::milliseconds>(kSamplingPeriod));
   const int kTargetDataBufferSize = static_cast<int>(
       FLAGS_stirling_socket_tracer_target_data_bw_percpu * kSecondsPerPeriod * cpu_scaling_factor);
   const int kTargetControlBufferSize =
@@ -421,7 +468,7 @@ auto SocketTraceConnector::InitPerfBufferSpecs() {
       {{PerfBufferSizeCategory::kData, kMaxTotalDataSize},
        {PerfBufferSizeCategory::kControl, kMaxTotalControlSize}});
 
-  auto specs = MakeArray<bpf_tools::PerfBufferSpec>({
+  std::vector<bpf_tools::PerfBufferSpec> specs({
       // For data events. The order must be consistent with output tables.
       {"socket_data_events", HandleDataEvent, HandleDataEventLoss, this, kTargetDataBufferSize,
        PerfBufferSizeCategory::kData},
@@ -441,10 +488,58 @@ auto SocketTraceConnector::InitPerfBufferSpecs() {
       {"grpc_c_close_events", HandleGrpcCCloseEvent, HandleGrpcCCloseDataLoss, this,
        kTargetDataBufferSize, PerfBufferSizeCategory::kData},
   });
+  if (use_ringbuf_) {
+    // Socket data and control events go through ring buffers instead, see InitRingBufferSpecs().
+    specs.erase(std::remove_if(specs.begin(), specs.end(),
+                               [](const bpf_tools::PerfBufferSpec& spec) {
+                                 return spec.name == "socket_data_events" ||
+                                        spec.name == "socket_control_events";
+                               }),
+                specs.end());
+  }
   ResizePerfBufferSpecs(&specs, category_maximums);
   return specs;
 }
 
+std::vector<bpf_tools::RingBufferSpec> SocketTraceConnector::InitRingBufferSpecs() {
+  if (!use_ringbuf_) {
+    return {};
+  }
+  const auto sampling_period =
+      std::chrono::duration_cast<std::chrono::milliseconds>(kSamplingPeriod);
+  const int page_size_bytes = system::Config::GetInstance().PageSizeBytes();
+  LOG(INFO) << absl::Substitute(
+      "Initializing ring buffers with data_size_bytes=$0 and control_size_bytes=$1",
+      DataRingBufferPages(sampling_period) * page_size_bytes,
+      ControlRingBufferPages(sampling_period) * page_size_bytes);
+
+  return {
+      // The sizes are declared by the BPF code, see the *_RINGBUF_PAGES defines in InitBPF().
+      {"socket_data_events", HandleDataEvent, this},
+      {"socket_control_events", HandleControlEvent, this},
+  };
+}
+
+void SocketTraceConnector::UpdateRingBufferLostEvents() {
+  if (ringbuf_lost_events_ == nullptr) {
+    return;
+  }
+  constexpr std::array<std::pair<ringbuf_lost_idx_t, StatKey>, kNumRingBufLostIdxs> kLossStats = {
+      {{kRingBufLostDataIdx, StatKey::kLossSocketDataEvent},
+       {kRingBufLostControlIdx, StatKey::kLossSocketControlEvent}}};
+  for (const auto& [idx, key] : kLossStats) {
+    auto count_or = ringbuf_lost_events_->GetValue(idx);
+    if (!count_or.ok()) {
+      LOG_FIRST_N(WARNING, 1) << absl::Substitute("Failed to read ring buffer lost events: $0",
+                                                  count_or.msg());
+      continue;
+    }
+    const uint64_t count = count_or.ConsumeValueOrDie();
+    stats_.Increment(key, static_cast<int>(count - ringbuf_lost_counts_[idx]));
+    ringbuf_lost_counts_[idx] = count;
+  }
+}
+
 Status SocketTraceConnector::InitBPF() {
   // set BPF loop limit and chunk limit based on kernel version
   auto kernel = system::GetCachedKernelVersion();
@@ -458,6 +553,16 @@ Status SocketTraceConnector::InitBPF() {
         "to $2",
         kernel.ToString(), FLAGS_stirling_bpf_loop_limit, FLAGS_stirling_bpf_chunk_limit);
   }
+  use_ringbuf_ = FLAGS_stirling_socket_tracer_use_ringbuf &&
+                 bpf_tools::BCCWrapper::RingBuffersSupported();
+  if (FLAGS_stirling_socket_tracer_use_ringbuf && !use_ringbuf_) {
+    LOG(INFO) << absl::Substitute(
+        "Kernel version $0 does not support BPF ring buffers, falling back to perf buffers.",
+        kernel.ToString());
+  }
+  const auto sampling_period =
+      std::chrono::duration_cast<std::chrono::milliseconds>(kSamplingPeriod);
+
   // PROTOCOL_LIST: Requires update on new protocols.
   std::vector<std::string> defines = {
       absl::StrCat("-DENABLE_TLS_DEBUG_SOURCES=", FLAGS_stirling_debug_tls_sources),
@@ -474,6 +579,9 @@ Status SocketTraceConnector::InitBPF() {
       absl::StrCat("-DENABLE_MONGO_TRACING=", protocol_transfer_specs_[kProtocolMongo].enabled),
       absl::StrCat("-DBPF_LOOP_LIMIT=", FLAGS_stirling_bpf_loop_limit),
       absl::StrCat("-DBPF_CHUNK_LIMIT=", FLAGS_stirling_bpf_chunk_limit),
+      absl::StrCat("-DUSE_RINGBUF=", use_ringbuf_),
+      absl::StrCat("-DSOCKET_DATA_RINGBUF_PAGES=", DataRingBufferPages(sampling_period)),
+      absl::StrCat("-DSOCKET_CONTROL_RINGBUF_PAGES=", ControlRingBufferPages(sampling_period)),
   };
   PX_RETURN_IF_ERROR(bcc_->InitBPFProgram(socket_trace_bcc_script, defines));
 
@@ -482,9 +590,19 @@ Status SocketTraceConnector::InitBPF() {
   LOG(INFO) << "Probes successfully deployed.";
 
   const auto perf_buffer_specs = InitPerfBufferSpecs();
-  PX_RETURN_IF_ERROR(bcc_->OpenPerfBuffers(perf_buffer_specs));
+  PX_RETURN_IF_ERROR(bcc_->OpenPerfBuffers(
+      ArrayView<bpf_tools::PerfBufferSpec>(perf_buffer_specs.data(), perf_buffer_specs.size())));
   LOG(INFO) << absl::Substitute("Number of perf buffers opened = $0", perf_buffer_specs.size());
 
+  const auto ring_buffer_specs = InitRingBufferSpecs();
+  PX_RETURN_IF_ERROR(bcc_->OpenRingBuffers(
+      ArrayView<bpf_tools::RingBufferSpec>(ring_buffer_specs.data(), ring_buffer_specs.size())));
+  LOG(INFO) << absl::Substitute("Number of ring buffers opened = $0", ring_buffer_specs.size());
+  if (use_ringbuf_) {
+    ringbuf_lost_events_ =
+        WrappedBCCArrayTable<uint64_t>::Create(bcc_.get(), kRingBufLostEventsArrayName);
+  }
+
   // Set trace role to BPF probes.
   for (const auto& p : magic_enum::enum_values<traffic_protocol_t>()) {
     if (protocol_transfer_specs_[p].enabled) {
@@ -568,6 +686,8 @@ void SocketTraceConnector::InitContextImpl(ConnectorContext* ctx) {
 }
 
 Status SocketTraceConnector::StopImpl() {
+  transfer_pool_.reset();
+
   if (perf_buffer_events_output_stream_ != nullptr) {
     perf_buffer_events_output_stream_->close();
   }
@@ -659,7 +779,9 @@ void SocketTraceConnector::UpdateCommonState(ConnectorContext* ctx) {
   // so raw data will be pushed to connection trackers more aggressively.
   // No data is lost, but this is a side-effect of sorts that affects timing of transfers.
   // It may be worth noting during debug.
+  // The ring buffers are consumed too, when they are used.
   bcc_->PollPerfBuffers();
+  UpdateRingBufferLostEvents();
 
   // Set-up current state for connection inference purposes.
   if (socket_info_mgr_ != nullptr) {
@@ -755,6 +877,12 @@ void SocketTraceConnector::CheckTracerState() {
 using stream_id_t = protocols::http::stream_id_t;
 using message_t = protocols::http::Message;
 
+void SocketTraceConnector::PollBuffersImpl() {
+  // Drains the perf and ring buffers into the connection trackers between transfers, so that
+  // bursts of traffic don't overflow them. The events are processed by the next TransferData().
+  bcc_->PollPerfBuffers();
+}
+
 void SocketTraceConnector::TransferDataImpl(ConnectorContext* ctx) {
   set_iteration_time(now_fn_());
 
@@ -794,13 +922,6 @@ void SocketTraceConnector::TransferDataImpl(ConnectorContext* ctx) {
   }
 
   for (const auto& conn_tracker : conn_trackers_mgr_.active_trackers()) {
-    const auto& transfer_spec = protocol_transfer_specs_[conn_tracker->protocol()];
-
-    DataTable* data_table = nullptr;
-    if (transfer_spec.enabled) {
-      data_table = data_tables_[transfer_spec.table_num];
-    }
-
     UpdateTrackerTraceLevel(conn_tracker);
 
     // Once a known UPID, always a known UPID.
@@ -812,19 +933,15 @@ void SocketTraceConnector::TransferDataImpl(ConnectorContext* ctx) {
       }
     }
 
+    // The connection inference shares the socket info manager, so it's done here rather than
+    // on the transfer threads.
     conn_tracker->IterationPreTick(iteration_time_, cluster_cidrs, proc_parser_.get(),
                                    socket_info_mgr_.get());
+  }
 
-    if (transfer_spec.transfer_fn != nullptr) {
-      transfer_spec.transfer_fn(*this, ctx, conn_tracker, data_table);
-    } else {
-      // If there's no transfer function, then the tracker should not be holding any data.
-      // http::ProtocolTraits is used as a placeholder; the frames deque is expected to be
-      // std::monostate.
-      DCHECK((conn_tracker->send_data().Empty<stream_id_t, message_t>()));
-      DCHECK((conn_tracker->recv_data().Empty<stream_id_t, message_t>()));
-    }
+  TransferStreams(ctx);
 
+  for (const auto& conn_tracker : conn_trackers_mgr_.active_trackers()) {
     conn_tracker->IterationPostTick();
   }
 
@@ -1720,6 +1837,221 @@ void SocketTraceConnector::WriteDataEvent(const SocketDataEvent& event) {
 // TransferData Helpers
 //-----------------------------------------------------------------------------
 
+void SocketTraceConnector::TransferTrackerStreams(ConnectorContext* ctx, ConnTracker* tracker,
+                                                  const std::vector<DataTable*>& data_tables) {
+  const auto& transfer_spec = protocol_transfer_specs_[tracker->protocol()];
+
+  DataTable* data_table = nullptr;
+  if (transfer_spec.enabled) {
+    data_table = data_tables[transfer_spec.table_num];
+  }
+
+  if (transfer_spec.transfer_fn != nullptr) {
+    transfer_spec.transfer_fn(*this, ctx, tracker, data_table);
+  } else {
+    // If there's no transfer function, then the tracker should not be holding any data.
+    // http::ProtocolTraits is used as a placeholder; the frames deque is expected to be
+    // std::monostate.
+    DCHECK((tracker->send_data().Empty<stream_id_t, message_t>()));
+    DCHECK((tracker->recv_data().Empty<stream_id_t, message_t>()));
+  }
+}
+
+namespace {
+
+// The connections handed out to a transfer thread at a time.
+constexpr size_t kTransferChunkSize = 64;
+
+// Fewer connections per thread than this are not worth the threads.
+constexpr size_t kMinTrackersPerTransferThread = 4 * kTransferChunkSize;
+
+// The work of a transfer thread: the chunks of connections it has yet to parse, and the shard of
+// the data tables it appends to.
+struct TransferShard {
+  absl::base_internal::SpinLock chunks_lock;
+  // The [begin, end) ranges of the trackers.
+  std::deque<std::pair<size_t, size_t>> chunks;
+  std::vector<std::unique_ptr<DataTable>> tables;
+  std::vector<DataTable*> table_ptrs;
+};
+
+std::optional<std::pair<size_t, size_t>> PopTransferChunk(TransferShard* shard, bool steal) {
+  absl::base_internal::SpinLockHolder lock(&shard->chunks_lock);
+  if (shard->chunks.empty()) {
+    return std::nullopt;
+  }
+  std::pair<size_t, size_t> chunk;
+  // Owners go through their chunks in order, thieves take the ones the owner would get to last.
+  if (steal) {
+    chunk = shard->chunks.back();
+    shard->chunks.pop_back();
+  } else {
+    chunk = shard->chunks.front();
+    shard->chunks.pop_front();
+  }
+  return chunk;
+}
+
+}  // namespace
+
+// The transfer threads and their shards of the data tables. Both are kept across transfers: the
+// shards are left empty by DataTable::MergeShards(), and the threads wait for the next transfer.
+// The thread calling Run() works on shard 0, so there is one thread less than there are shards.
+class SocketTraceConnector::TransferPool {
+ public:
+  TransferPool(size_t num_shards, const std::vector<DataTable*>& data_tables)
+      : data_tables_(data_tables) {
+    for (size_t s = 0; s < num_shards; ++s) {
+      auto shard = std::make_unique<TransferShard>();
+      for (size_t i = 0; i < data_tables.size(); ++i) {
+        // The conn_stats table is not filled in by the trackers.
+        if (data_tables[i] == nullptr || i == kConnStatsTableNum) {
+          shard->table_ptrs.push_back(nullptr);
+          continue;
+        }
+        shard->tables.push_back(std::make_unique<DataTable>(data_tables[i]->id(), kTables[i]));
+        shard->table_ptrs.push_back(shard->tables.back().get());
+      }
+      shards_.push_back(std::move(shard));
+    }
+    for (size_t s = 1; s < num_shards; ++s) {
+      threads_.emplace_back(&TransferPool::WorkerLoop, this, s);
+    }
+  }
+
+  ~TransferPool() {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  size_t num_shards() const { return shards_.size(); }
+  const std::vector<DataTable*>& data_tables() const { return data_tables_; }
+  TransferShard* shard(size_t idx) { return shards_[idx].get(); }
+
+  // Calls fn with the index of every shard, each on its own thread, and returns once all are done.
+  void Run(const std::function<void(size_t)>& fn) {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      work_ = &fn;
+      ++generation_;
+      num_running_ = threads_.size();
+    }
+    work_cv_.notify_all();
+    fn(0);
+    std::unique_lock<std::mutex> lock(mu_);
+    done_cv_.wait(lock, [this] { return num_running_ == 0; });
+    work_ = nullptr;
+  }
+
+ private:
+  void WorkerLoop(size_t shard_idx) {
+    uint64_t done_generation = 0;
+    std::unique_lock<std::mutex> lock(mu_);
+    while (true) {
+      work_cv_.wait(lock, [&] { return stop_ || generation_ != done_generation; });
+      if (stop_) {
+        return;
+      }
+      done_generation = generation_;
+      const std::function<void(size_t)>* work = work_;
+      lock.unlock();
+      (*work)(shard_idx);
+      lock.lock();
+      if (--num_running_ == 0) {
+        done_cv_.notify_one();
+      }
+    }
+  }
+
+  const std::vector<DataTable*> data_tables_;
+  std::vector<std::unique_ptr<TransferShard>> shards_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mu_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  // The work of the current transfer, and the number of threads that have yet to finish it.
+  const std::function<void(size_t)>* work_ = nullptr;
+  uint64_t generation_ = 0;
+  size_t num_running_ = 0;
+  bool stop_ = false;
+};
+
+SocketTraceConnector::~SocketTraceConnector() = default;
+
+void SocketTraceConnector::TransferStreams(ConnectorContext* ctx) {
+  const auto& active_trackers = conn_trackers_mgr_.active_trackers();
+
+  const size_t max_threads =
+      static_cast<size_t>(std::max(FLAGS_stirling_socket_tracer_transfer_threads, 1));
+  const size_t num_threads =
+      std::min(max_threads, active_trackers.size() / kMinTrackersPerTransferThread);
+  if (num_threads <= 1) {
+    for (const auto& conn_tracker : active_trackers) {
+      TransferTrackerStreams(ctx, conn_tracker, data_tables_);
+    }
+    return;
+  }
+
+  // The pool is sized for the most threads a transfer may use, so that it is only rebuilt when
+  // the flag or the data tables change, not whenever the number of connections does.
+  if (transfer_pool_ == nullptr || transfer_pool_->num_shards() != max_threads ||
+      transfer_pool_->data_tables() != data_tables_) {
+    transfer_pool_.reset();
+    transfer_pool_ = std::make_unique<TransferPool>(max_threads, data_tables_);
+  }
+  TransferPool& pool = *transfer_pool_;
+
+  const std::vector<ConnTracker*> trackers(active_trackers.begin(), active_trackers.end());
+
+  // Each thread starts with a contiguous range of chunks, and steals from the others once it is
+  // done, since the parsing cost varies a lot between connections. Only the first num_threads
+  // shards get chunks; the threads of the others have nothing to do.
+  const size_t num_chunks = IntRoundUpDivide(trackers.size(), kTransferChunkSize);
+  for (size_t c = 0; c < num_chunks; ++c) {
+    TransferShard* shard = pool.shard(c * num_threads / num_chunks);
+    absl::base_internal::SpinLockHolder lock(&shard->chunks_lock);
+    shard->chunks.emplace_back(c * kTransferChunkSize,
+                               std::min((c + 1) * kTransferChunkSize, trackers.size()));
+  }
+
+  pool.Run([&](size_t shard_idx) {
+    if (shard_idx >= num_threads) {
+      return;
+    }
+    TransferShard* shard = pool.shard(shard_idx);
+    for (size_t i = 0; i < num_threads;) {
+      const bool steal = i > 0;
+      std::optional<std::pair<size_t, size_t>> chunk =
+          PopTransferChunk(pool.shard((shard_idx + i) % num_threads), steal);
+      if (!chunk.has_value()) {
+        ++i;
+        continue;
+      }
+      for (size_t t = chunk->first; t < chunk->second; ++t) {
+        TransferTrackerStreams(ctx, trackers[t], shard->table_ptrs);
+      }
+    }
+  });
+
+  for (size_t i = 0; i < data_tables_.size(); ++i) {
+    if (pool.shard(0)->table_ptrs[i] == nullptr) {
+      continue;
+    }
+    std::vector<DataTable*> shard_tables;
+    for (size_t s = 0; s < num_threads; ++s) {
+      shard_tables.push_back(pool.shard(s)->table_ptrs[i]);
+    }
+    data_tables_[i]->MergeShards(shard_tables);
+  }
+}
+
 template <typename TProtocolTraits>
 void SocketTraceConnector::TransferStream(ConnectorContext* ctx, ConnTracker* tracker,
                                           DataTable* data_table) {
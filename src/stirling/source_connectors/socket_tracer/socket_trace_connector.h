@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <array>
 #include <fstream>
 #include <list>
 #include <map>
@@ -71,6 +72,8 @@ DECLARE_string(stirling_role_to_trace);
 
 DECLARE_uint32(stirling_socket_tracer_target_data_bw_percpu);
 DECLARE_uint32(stirling_socket_tracer_target_control_bw_percpu);
+DECLARE_bool(stirling_socket_tracer_use_ringbuf);
+DECLARE_int32(stirling_socket_tracer_transfer_threads);
 
 DECLARE_uint32(messages_expiry_duration_secs);
 DECLARE_uint32(messages_size_limit_bytes);
@@ -119,10 +122,13 @@ class SocketTraceConnector : public BCCSourceConnector {
     return std::unique_ptr<SocketTraceConnector>(new SocketTraceConnector(name));
   }
 
+  ~SocketTraceConnector() override;
+
   Status InitImpl() override;
   Status StopImpl() override;
   void InitContextImpl(ConnectorContext* ctx) override;
   void TransferDataImpl(ConnectorContext* ctx) override;
+  void PollBuffersImpl() override;
 
   void CheckTracerState();
 
@@ -185,7 +191,10 @@ class SocketTraceConnector : public BCCSourceConnector {
 
   explicit SocketTraceConnector(std::string_view source_name);
 
-  auto InitPerfBufferSpecs();
+  std::vector<bpf_tools::PerfBufferSpec> InitPerfBufferSpecs();
+  std::vector<bpf_tools::RingBufferSpec> InitRingBufferSpecs();
+  // Adds the events that did not fit in the ring buffers since the last call to the loss stats.
+  void UpdateRingBufferLostEvents();
   Status InitBPF();
   void InitPerfBufferSpec();
   void InitProtocolTransferSpecs();
@@ -209,6 +218,12 @@ class SocketTraceConnector : public BCCSourceConnector {
       bool outgoing,
       /* OUT */ struct go_grpc_http2_header_event_t* header_event_data_go_style);
 
+  // Parses the data of every active connection into records. With more than one transfer thread,
+  // the connections are shared out among threads that each append to their own shard of the data
+  // tables, and the shards are merged into the data tables in timestamp order.
+  void TransferStreams(ConnectorContext* ctx);
+  void TransferTrackerStreams(ConnectorContext* ctx, ConnTracker* tracker,
+                              const std::vector<DataTable*>& data_tables);
   template <typename TProtocolTraits>
   void TransferStream(ConnectorContext* ctx, ConnTracker* tracker, DataTable* data_table);
   void TransferConnStats(ConnectorContext* ctx, DataTable* data_table);
@@ -238,6 +253,12 @@ class SocketTraceConnector : public BCCSourceConnector {
   ConnStats conn_stats_;
 
   std::unique_ptr<WrappedBCCArrayTable<int>> openssl_trace_state_;
+
+  // Whether socket data and control events are submitted through ring buffers, instead of perf
+  // buffers. Set in InitBPF() from the flag and the kernel version.
+  bool use_ringbuf_ = false;
+  std::unique_ptr<WrappedBCCArrayTable<uint64_t>> ringbuf_lost_events_;
+  std::array<uint64_t, kNumRingBufLostIdxs> ringbuf_lost_counts_ = {};
   std::unique_ptr<WrappedBCCMap<uint32_t, struct openssl_trace_state_debug_t>>
       openssl_trace_state_debug_;
   prometheus::Family<prometheus::Counter>& openssl_trace_mismatched_fds_counter_family_;
@@ -270,6 +291,11 @@ class SocketTraceConnector : public BCCSourceConnector {
   // The transfer_fn defines which function is called to process the data for transfer.
   std::vector<TransferSpec> protocol_transfer_specs_;
 
+  // The threads and data table shards of TransferStreams(); created on the first transfer that
+  // uses more than one thread.
+  class TransferPool;
+  std::unique_ptr<TransferPool> transfer_pool_;
+
   // The time at which TransferDataImpl() begin. Used as a universal timestamp for the iteration,
   // to avoid too many calls to std::chrono::steady_clock::now().
   std::chrono::time_point<std::chrono::steady_clock> iteration_time_;
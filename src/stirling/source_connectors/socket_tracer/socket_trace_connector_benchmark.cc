@@ -397,3 +397,34 @@ BENCHMARK_CAPTURE(BM_SocketTraceConnector, http1_intra_iter_gaps,
                           },
                   })
     ->Unit(benchmark::kMillisecond);
+
+// Benchmark of the transfer of many small connections, varying the number of connections and the
+// number of threads that parse them (--stirling_socket_tracer_transfer_threads).
+// NOLINTNEXTLINE: runtime/references.
+static void BM_SocketTraceConnectorConns(benchmark::State& state) {
+  constexpr uint64_t kSmallRecordSize = 1024;
+  const auto num_conns = static_cast<size_t>(state.range(0));
+  FLAGS_stirling_socket_tracer_transfer_threads = static_cast<int32_t>(state.range(1));
+
+  BM_SocketTraceConnector(
+      state, BenchmarkDataGenerationSpec{
+                 .num_conns = num_conns,
+                 .num_poll_iterations = 2,
+                 .records_per_conn = 4,
+                 .protocol = kProtocolHTTP,
+                 .role = kRoleServer,
+                 .rec_gen_func =
+                     []() { return std::make_unique<HTTP1SingleReqRespGen>(kSmallRecordSize); },
+                 .pos_gen_func = []() { return std::make_unique<NoGapsPosGenerator>(); },
+             });
+}
+
+void ConnsArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t num_conns : {1000, 10000, 50000}) {
+    for (int64_t num_threads : {1, 2, 4, 8}) {
+      b->Args({num_conns, num_threads});
+    }
+  }
+}
+
+BENCHMARK(BM_SocketTraceConnectorConns)->Apply(ConnsArgs)->Unit(benchmark::kMillisecond);
@@ -18,7 +18,9 @@
 
 #include "src/stirling/source_connectors/socket_tracer/socket_trace_connector.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include <absl/functional/bind_front.h>
 #include <gmock/gmock.h>
@@ -378,6 +380,30 @@ TEST_F(SocketTraceConnectorTest, SortedByResponseTime) {
               ElementsAre(R"({"CQL_VERSION":"3.0.1"})", R"({"CQL_VERSION":"3.0.0"})"));
 }
 
+TEST_F(SocketTraceConnectorTest, ParallelTransfer) {
+  PX_SET_FOR_SCOPE(FLAGS_stirling_socket_tracer_transfer_threads, 4);
+
+  // Enough connections for every transfer thread to get a few chunks of trackers.
+  constexpr int kNumConns = 2048;
+  for (int i = 0; i < kNumConns; ++i) {
+    testing::EventGenerator event_gen(&mock_clock_, kPID, kFD + i);
+    source_->AcceptControlEvent(event_gen.InitConn());
+    source_->AcceptDataEvent(event_gen.InitSendEvent<kProtocolHTTP>(kReq0));
+    source_->AcceptDataEvent(event_gen.InitRecvEvent<kProtocolHTTP>(kResp0));
+    source_->AcceptControlEvent(event_gen.InitClose());
+  }
+
+  connector_->TransferData(ctx_.get());
+
+  std::vector<TaggedRecordBatch> tablets = http_table_->ConsumeRecords();
+  ASSERT_NOT_EMPTY_AND_GET_RECORDS(RecordBatch & records, tablets);
+  ASSERT_THAT(records, RecordBatchSizeIs(kNumConns));
+
+  // The records of the transfer threads are merged back in time order.
+  std::vector<int64_t> times = ToIntVector<types::Time64NSValue>(records[kHTTPTimeIdx]);
+  EXPECT_TRUE(std::is_sorted(times.begin(), times.end()));
+}
+
 TEST_F(SocketTraceConnectorTest, UPIDCheck) {
   struct socket_control_event_t conn = event_gen_.InitConn();
   std::unique_ptr<SocketDataEvent> event0_req = event_gen_.InitSendEvent<kProtocolHTTP>(kReq0);
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string_view>
+#include <vector>
+
+#include "src/stirling/bpf_tools/bcc_wrapper.h"
+#include "src/stirling/core/data_table.h"
+#include "src/stirling/source_connectors/socket_tracer/socket_trace_connector.h"
+#include "src/stirling/source_connectors/socket_tracer/testing/client_server_system.h"
+#include "src/stirling/source_connectors/socket_tracer/testing/socket_trace_bpf_test_fixture.h"
+#include "src/stirling/testing/common.h"
+
+namespace px {
+namespace stirling {
+
+using ::px::stirling::testing::FindRecordsMatchingPID;
+using ::px::stirling::testing::RecordBatchSizeIs;
+using ::px::system::TCPSocket;
+using ::px::types::ColumnWrapperRecordBatch;
+using ::testing::HasSubstr;
+
+constexpr std::string_view kHTTPReqMsg =
+    "GET /endpoint HTTP/1.1\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Ubuntu; Linux x86_64; rv:67.0) Gecko/20100101 Firefox/67.0\r\n"
+    "\r\n";
+
+constexpr std::string_view kHTTPRespMsg =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: application/json; msg\r\n"
+    "Content-Length: 0\r\n"
+    "\r\n";
+
+// Deploys the socket tracer BPF program with the events exported through ring buffers, and
+// through perf buffers, since socket_trace.c is compiled differently for each.
+class SocketTraceRingBufferBPFTest
+    : public testing::SocketTraceBPFTestFixture</* TClientSideTracing */ true>,
+      public ::testing::WithParamInterface<bool> {
+ protected:
+  void SetUp() override {
+    use_ringbuf_ = FLAGS_stirling_socket_tracer_use_ringbuf;
+    FLAGS_stirling_socket_tracer_use_ringbuf = GetParam();
+    SocketTraceBPFTestFixture::SetUp();
+  }
+
+  void TearDown() override {
+    SocketTraceBPFTestFixture::TearDown();
+    FLAGS_stirling_socket_tracer_use_ringbuf = use_ringbuf_;
+  }
+
+ private:
+  bool use_ringbuf_ = false;
+};
+
+TEST_P(SocketTraceRingBufferBPFTest, TraceHTTP) {
+  // Kernels without ring buffers fall back to perf buffers.
+  const bool use_ringbuf = GetParam() && bpf_tools::BCCWrapper::RingBuffersSupported();
+  EXPECT_EQ(bpf_tools::BCCWrapper::num_open_ring_buffers(), use_ringbuf ? 2U : 0U);
+
+  ConfigureBPFCapture(kProtocolHTTP, kRoleClient);
+  StartTransferDataThread();
+
+  testing::SendRecvScript script({
+      {{kHTTPReqMsg}, {kHTTPRespMsg}},
+  });
+  testing::ClientServerSystem system;
+  system.RunClientServer<&TCPSocket::Read, &TCPSocket::Write>(script);
+
+  StopTransferDataThread();
+
+  std::vector<TaggedRecordBatch> tablets = ConsumeRecords(kHTTPTableNum);
+  ASSERT_NOT_EMPTY_AND_GET_RECORDS(const types::ColumnWrapperRecordBatch& record_batch, tablets);
+  ColumnWrapperRecordBatch records =
+      FindRecordsMatchingPID(record_batch, kHTTPUPIDIdx, system.ClientPID());
+  ASSERT_THAT(records, RecordBatchSizeIs(1));
+  EXPECT_THAT(records[kHTTPRespHeadersIdx]->Get<types::StringValue>(0), HasSubstr("msg"));
+}
+
+INSTANTIATE_TEST_SUITE_P(UseRingBuf, SocketTraceRingBufferBPFTest, ::testing::Bool());
+
+}  // namespace stirling
+}  // namespace px
@@ -37,6 +37,7 @@
 #include "src/stirling/utils/system_info.h"
 
 #include "src/stirling/bpf_tools/probe_cleaner.h"
+#include "src/stirling/core/connector_scheduler.h"
 #include "src/stirling/core/data_table.h"
 #include "src/stirling/core/pub_sub_manager.h"
 #include "src/stirling/core/source_connector.h"
@@ -65,6 +66,13 @@ DEFINE_string(stirling_sources, gflags::StringFromEnv("PL_STIRLING_SOURCES", "kP
               "Choose sources to enable. [kAll|kProd|kMetrics|kTracers|kProfiler|kTCPStats] or "
               "comma separated list of "
               "sources (find them the header files of source connector classes).");
+DEFINE_int32(stirling_core_num_workers, gflags::Int32FromEnv("PL_STIRLING_CORE_NUM_WORKERS", 2),
+             "Number of threads that run the source connectors. With 0, the connectors run "
+             "one after the other on the main Stirling thread.");
+DEFINE_int32(stirling_core_poll_period_ms,
+             gflags::Int32FromEnv("PL_STIRLING_CORE_POLL_PERIOD_MS", 10),
+             "Period of the high-priority thread that drains the perf buffers of the source "
+             "connectors between their transfers. Only used with worker threads; 0 disables it.");
 
 namespace px {
 namespace stirling {
@@ -184,8 +192,6 @@ std::unique_ptr<SourceRegistry> CreateSourceRegistryFromFlag() {
 }
 
 class StirlingImpl final : public Stirling {
-  using time_point = std::chrono::steady_clock::time_point;
-
  public:
   explicit StirlingImpl(std::unique_ptr<SourceRegistry> registry);
 
@@ -242,9 +248,6 @@ class StirlingImpl final : public Stirling {
   // Main run implementation.
   void RunCore();
 
-  // Computes the amount of time to sleep based on the next source connector that needs to wakeup.
-  std::chrono::milliseconds TimeUntilNextTick(const time_point now);
-
   // Wait for Stirling to stop its main loop.
   void WaitForStop();
 
@@ -291,6 +294,9 @@ class StirlingImpl final : public Stirling {
   // RunCoreStats tracks how much work is accomplished in each run core iteration,
   // and it also keeps a histogram of sleep durations.
   RunCoreStats run_core_stats_;
+
+  // Runs the source connectors when they're due, on its worker threads.
+  ConnectorScheduler scheduler_;
 };
 
 StirlingImpl* g_stirling_ptr = nullptr;
@@ -371,7 +377,9 @@ void UserSignalHandler(int /* signum */, siginfo_t* info, void* /* context */) {
 }
 
 StirlingImpl::StirlingImpl(std::unique_ptr<SourceRegistry> registry)
-    : registry_(std::move(registry)) {}
+    : registry_(std::move(registry)),
+      scheduler_(FLAGS_stirling_core_num_workers,
+                 std::chrono::milliseconds{FLAGS_stirling_core_poll_period_ms}, &run_core_stats_) {}
 
 StirlingImpl::~StirlingImpl() { Stop(); }
 
@@ -443,36 +451,53 @@ Status StirlingImpl::AddSource(std::unique_ptr<SourceConnector> source) {
   }
 
   source->set_data_tables(std::move(data_tables));
+  scheduler_.AddSource(source.get());
   sources_.push_back(std::move(source));
 
   return Status::OK();
 }
 
 Status StirlingImpl::RemoveSource(std::string_view source_name) {
-  absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
-
-  // Find the source.
-  auto source_iter = std::find_if(sources_.begin(), sources_.end(),
-                                  [&source_name](const std::unique_ptr<SourceConnector>& s) {
-                                    return s->name() == source_name;
-                                  });
-  if (source_iter == sources_.end()) {
-    return error::Internal("RemoveSource(): could not find source with name=$0", source_name);
+  SourceConnector* source = nullptr;
+  {
+    absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
+    auto source_iter = std::find_if(sources_.begin(), sources_.end(),
+                                    [&source_name](const std::unique_ptr<SourceConnector>& s) {
+                                      return s->name() == source_name;
+                                    });
+    if (source_iter == sources_.end()) {
+      return error::Internal("RemoveSource(): could not find source with name=$0", source_name);
+    }
+    source = source_iter->get();
   }
-  std::unique_ptr<SourceConnector>& source = *source_iter;
 
-  // Remove all info class managers that point back to the source.
-  info_class_mgrs_.erase(std::remove_if(info_class_mgrs_.begin(), info_class_mgrs_.end(),
-                                        [&source](std::unique_ptr<InfoClassManager>& mgr) {
-                                          return mgr->source() == source.get();
-                                        }),
-                         info_class_mgrs_.end());
+  // Wait for the source to finish its current work, before its data tables go away. This can take
+  // as long as a TransferData() call, so the spin lock isn't held meanwhile.
+  scheduler_.RemoveSource(source);
 
-  // Now perform the removal.
-  PX_RETURN_IF_ERROR(source->Stop());
-  sources_.erase(source_iter);
+  std::unique_ptr<SourceConnector> removed_source;
+  {
+    absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
+    auto source_iter = std::find_if(
+        sources_.begin(), sources_.end(),
+        [source](const std::unique_ptr<SourceConnector>& s) { return s.get() == source; });
+    if (source_iter == sources_.end()) {
+      return error::Internal("RemoveSource(): source with name=$0 was already removed",
+                             source_name);
+    }
 
-  return Status::OK();
+    // Remove all info class managers that point back to the source.
+    info_class_mgrs_.erase(std::remove_if(info_class_mgrs_.begin(), info_class_mgrs_.end(),
+                                          [source](std::unique_ptr<InfoClassManager>& mgr) {
+                                            return mgr->source() == source;
+                                          }),
+                           info_class_mgrs_.end());
+    removed_source = std::move(*source_iter);
+    sources_.erase(source_iter);
+  }
+
+  // Now perform the removal.
+  return removed_source->Stop();
 }
 
 // Returns, but updates the status map in a concurrent-safe way before doing so.
@@ -732,46 +757,6 @@ void StirlingImpl::Run() {
   RunCore();
 }
 
-std::chrono::milliseconds StirlingImpl::TimeUntilNextTick(const time_point now)
-    ABSL_SHARED_LOCKS_REQUIRED(info_class_mgrs_lock_) {
-  // The amount to sleep depends on when the earliest Source needs to be sampled again.
-  // Do this to avoid burning CPU cycles unnecessarily
-
-  // Worst case, wake-up every so often.
-  // This is important if there are no subscribed info classes, to avoid sleeping eternally.
-  constexpr std::chrono::milliseconds kMaxSleepDuration{1000};
-  auto wakeup_time = now + kMaxSleepDuration;
-  for (const auto& source : sources_) {
-    wakeup_time = std::min(wakeup_time, source->sampling_freq_mgr().next());
-    wakeup_time = std::min(wakeup_time, source->push_freq_mgr().next());
-  }
-
-  return std::chrono::duration_cast<std::chrono::milliseconds>(wakeup_time - now);
-}
-
-namespace {
-
-// Returns true if any of the input tables are beyond the threshold.
-bool DataExceedsThreshold(const std::vector<DataTable*>& data_tables) {
-  // Data push threshold, based on percentage of buffer that is filled.
-  constexpr uint32_t kDefaultOccupancyPctThreshold = 100;
-
-  // Data push threshold, based number of records after which a push.
-  constexpr uint32_t kDefaultOccupancyThreshold = 1024;
-
-  for (const auto* data_table : data_tables) {
-    if (static_cast<uint32_t>(100 * data_table->OccupancyPct()) > kDefaultOccupancyPctThreshold) {
-      return true;
-    }
-    if (data_table->Occupancy() > kDefaultOccupancyThreshold) {
-      return true;
-    }
-  }
-  return false;
-}
-
-}  // namespace
-
 // Main Data Collector loop.
 // Poll on Data Source Through connectors, when appropriate, then go to sleep.
 // Must run as a thread, so only call from Run() as a thread.
@@ -806,15 +791,14 @@ void StirlingImpl::RunCore() {
   // The ctx_freq_mgr controls the update period for the k8s context "ctx".
   FrequencyManager ctx_freq_mgr;
   ctx_freq_mgr.set_period(std::chrono::milliseconds{200});
-  std::unique_ptr<ConnectorContext> ctx = GetContext();
+  // The context is shared with the source connectors that are still running on the workers.
+  std::shared_ptr<ConnectorContext> ctx = GetContext();
 
-  while (run_enable_) {
-    // To batch up work, i.e. to do more work per wakeup, we want to run our data
-    // transfer or push data if its desired run time is anywhere between
-    // time "now" and time "now + window".
-    const auto now_plus_run_window = now + kRunWindow;
+  // The source connectors run on the scheduler's workers; this thread only decides when.
+  scheduler_.Start();
 
-    if (ctx_freq_mgr.Expired(now_plus_run_window)) {
+  while (run_enable_) {
+    if (ctx_freq_mgr.Expired(now + kRunWindow)) {
       ctx = GetContext();
       now = std::chrono::steady_clock::now();
       ctx_freq_mgr.Reset(now);
@@ -825,39 +809,26 @@ void StirlingImpl::RunCore() {
       // Needed to avoid race with main thread update info_class_mgrs_ on new subscription.
       absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
 
-      // Run through every SourceConnector and InfoClassManager being managed.
-      for (auto& source : sources_) {
-        // Phase 1: Probe each source for its data.
-        if (source->sampling_freq_mgr().Expired(now_plus_run_window)) {
-          source->TransferData(ctx.get());
-
-          // TransferData() is normally a significant amount of work: update "time now".
-          now = std::chrono::steady_clock::now();
-          source->sampling_freq_mgr().Reset(now);
-          run_core_stats_.IncrementTransferDataCount();
-        }
-        // Phase 2: Push Data upstream.
-        if (source->push_freq_mgr().Expired(now_plus_run_window) ||
-            DataExceedsThreshold(source->data_tables())) {
-          source->PushData(data_push_callback_);
-
-          // PushData() is normally a significant amount of work: update "time now".
-          now = std::chrono::steady_clock::now();
-          source->push_freq_mgr().Reset(now);
-          run_core_stats_.IncrementPushDataCount();
-        }
-      }
+      // Run (or dispatch to the workers) every SourceConnector that is due, and figure the time
+      // remaining until the next required data sample or push data.
+      const auto wakeup_time = scheduler_.Schedule(now, kRunWindow, ctx, data_push_callback_);
 
-      // Figure the time remaining until the next required data sample or push data.
-      time_until_next_tick = TimeUntilNextTick(now);
+      // Without workers, TransferData() and PushData() ran inline, which is normally a significant
+      // amount of work: update "time now".
+      if (scheduler_.num_workers() == 0) {
+        now = std::chrono::steady_clock::now();
+      }
+      time_until_next_tick =
+          std::chrono::duration_cast<std::chrono::milliseconds>(wakeup_time - now);
     }
 
     // Sleep, only if time_until_next_tick exceeds the "run window," i.e. if that time
     // is long enough that Stirling should go to sleep. Otherwise, don't sleep and loop back
     // through the sources, with the expectation that one of the sources triggers a call to
     // either TransferData() or to PushData().
+    // The sleep is cut short when a worker finishes, so that the source gets rescheduled.
     if (time_until_next_tick >= kRunWindow) {
-      std::this_thread::sleep_for(time_until_next_tick);
+      scheduler_.WaitUntil(now + time_until_next_tick);
 
       // Update the histograms in run core stats *and* trigger a periodic printout of the same.
       run_core_stats_.EndIter(time_until_next_tick);
@@ -870,6 +841,9 @@ void StirlingImpl::RunCore() {
       run_core_stats_.EndIter(std::chrono::milliseconds::zero());
     }
   }
+
+  // Wait for the workers to finish, before the source connectors get stopped.
+  scheduler_.Stop();
   running_ = false;
 }
 
@@ -904,26 +878,18 @@ void StirlingImpl::Stop() {
   }
 }
 
+// The sources may be transferring data on the scheduler's workers, so the settings are changed
+// through the scheduler, while each source is idle.
 void StirlingImpl::SetDebugLevel(int level) {
-  // Lock not really required, but compiler is making sure we're safe.
-  absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
-  for (auto& s : sources_) {
-    s->SetDebugLevel(level);
-  }
+  scheduler_.RunOnSources([level](SourceConnector* s) { s->SetDebugLevel(level); });
 }
 
 void StirlingImpl::EnablePIDTrace(int pid) {
-  absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
-  for (auto& s : sources_) {
-    s->EnablePIDTrace(pid);
-  }
+  scheduler_.RunOnSources([pid](SourceConnector* s) { s->EnablePIDTrace(pid); });
 }
 
 void StirlingImpl::DisablePIDTrace(int pid) {
-  absl::base_internal::SpinLockHolder lock(&info_class_mgrs_lock_);
-  for (auto& s : sources_) {
-    s->DisablePIDTrace(pid);
-  }
+  scheduler_.RunOnSources([pid](SourceConnector* s) { s->DisablePIDTrace(pid); });
 }
 
 void StirlingImpl::UpdateDynamicTraceStatus(const sole::uuid& trace_id,
@@ -81,6 +81,19 @@ void RunCoreStats::IncrementPushDataCount() {
   ++push_or_transfer_this_iter_;
 }
 
+void RunCoreStats::RecordTransferData(const std::string& connector,
+                                      const std::chrono::nanoseconds lag,
+                                      const std::chrono::nanoseconds duration,
+                                      const std::chrono::milliseconds period) {
+  ConnectorStats& stats = connector_stats_[connector];
+  ++stats.num_transfer_data;
+  stats.total_lag += lag;
+  stats.max_lag = std::max(stats.max_lag, lag);
+  if (duration > period) {
+    ++stats.num_overruns;
+  }
+}
+
 void RunCoreStats::LogStats() const {
   std::string s = absl::StrJoin(sleep_histo_, ",");
   absl::StrAppend(&s, ",", absl::StrJoin(no_work_histo_, ","));
@@ -89,6 +102,18 @@ void RunCoreStats::LogStats() const {
                                 num_no_work_iters_, (num_main_loop_iters_ - num_no_work_iters_),
                                 (num_transfer_data_ + num_push_data_), num_transfer_data_,
                                 num_push_data_, min_push_or_transfer_, max_push_or_transfer_, s);
+
+  for (const auto& [connector, stats] : connector_stats_) {
+    const auto avg_lag = stats.num_transfer_data == 0
+                             ? std::chrono::nanoseconds{0}
+                             : stats.total_lag / static_cast<int64_t>(stats.num_transfer_data);
+    LOG(INFO) << absl::Substitute(
+        "|connector=$0,transfer=$1,avg_lag_ms=$2,max_lag_ms=$3,overruns=$4", connector,
+        stats.num_transfer_data,
+        std::chrono::duration_cast<std::chrono::milliseconds>(avg_lag).count(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(stats.max_lag).count(),
+        stats.num_overruns);
+  }
 }
 
 void RunCoreStats::EndIter(const std::chrono::milliseconds sleep_duration) {
@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 
+#include <absl/container/btree_map.h>
 #include <absl/strings/str_cat.h>
 #include <absl/strings/str_join.h>
 
@@ -34,14 +35,30 @@ namespace stirling {
 // RunCoreStats tracks the work done in each iteration of StirlingImpl::RunCore.
 // It counts the number of PushData() and TransferData() calls.
 // It also keeps a histogram of sleep durations: total, and those sleeps where no work is done.
+// For each source connector, it tracks how late its TransferData() calls start relative to their
+// deadline, and how many of them overrun their sampling period.
 class RunCoreStats {
  public:
+  struct ConnectorStats {
+    uint64_t num_transfer_data = 0;
+    // The time between the deadline of a TransferData() call and its start.
+    std::chrono::nanoseconds total_lag = {};
+    std::chrono::nanoseconds max_lag = {};
+    // The TransferData() calls that took longer than the sampling period of the connector.
+    uint64_t num_overruns = 0;
+  };
+
   RunCoreStats();
 
   // Increment totals and per iteration counts.
   void IncrementTransferDataCount();
   void IncrementPushDataCount();
 
+  // Records a TransferData() call of a source connector that started lag after its deadline,
+  // and took duration to run.
+  void RecordTransferData(const std::string& connector, std::chrono::nanoseconds lag,
+                          std::chrono::nanoseconds duration, std::chrono::milliseconds period);
+
   // Logs the stats.
   void LogStats() const;
 
@@ -56,6 +73,9 @@ class RunCoreStats {
   uint64_t max_push_or_transfer() const { return max_push_or_transfer_; }
   uint64_t num_no_work_iters() const { return num_no_work_iters_; }
   uint64_t push_or_transfer_this_iter() const { return push_or_transfer_this_iter_; }
+  const absl::btree_map<std::string, ConnectorStats>& connector_stats() const {
+    return connector_stats_;
+  }
 
   // These two accessors give the histogram count based on a duration passed as in input.
   // For now, they are useful only for the test case in run_core_stats_test.cc.
@@ -78,6 +98,7 @@ class RunCoreStats {
   uint64_t push_or_transfer_this_iter_ = 0;
   std::vector<uint64_t> sleep_histo_;
   std::vector<uint64_t> no_work_histo_;
+  absl::btree_map<std::string, ConnectorStats> connector_stats_;
 };
 
 }  // namespace stirling
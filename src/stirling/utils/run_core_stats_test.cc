@@ -67,5 +67,31 @@ TEST(RunCoreStatsTest, RunCoreStatsTest) {
   stats.LogStats();
 }
 
+TEST(RunCoreStatsTest, ConnectorStats) {
+  RunCoreStats stats;
+  const std::chrono::milliseconds kPeriod{100};
+
+  stats.RecordTransferData("socket_tracer", std::chrono::milliseconds{2},
+                           std::chrono::milliseconds{10}, kPeriod);
+  stats.RecordTransferData("socket_tracer", std::chrono::milliseconds{4},
+                           std::chrono::milliseconds{150}, kPeriod);
+  stats.RecordTransferData("perf_profiler", std::chrono::milliseconds{0},
+                           std::chrono::milliseconds{100}, kPeriod);
+
+  ASSERT_EQ(stats.connector_stats().size(), 2);
+  const auto& socket_tracer = stats.connector_stats().at("socket_tracer");
+  EXPECT_EQ(socket_tracer.num_transfer_data, 2);
+  EXPECT_EQ(socket_tracer.total_lag, std::chrono::milliseconds{6});
+  EXPECT_EQ(socket_tracer.max_lag, std::chrono::milliseconds{4});
+  EXPECT_EQ(socket_tracer.num_overruns, 1);
+
+  // A TransferData() call that takes exactly the period is not an overrun.
+  const auto& perf_profiler = stats.connector_stats().at("perf_profiler");
+  EXPECT_EQ(perf_profiler.num_transfer_data, 1);
+  EXPECT_EQ(perf_profiler.num_overruns, 0);
+
+  stats.LogStats();
+}
+
 }  // namespace stirling
 }  // namespace px
@@ -17,12 +17,15 @@
  */
 
 #include <arrow/array.h>
+#include <arrow/buffer.h>
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include <absl/strings/str_format.h>
+#include <absl/strings/str_join.h>
 #include "src/common/base/base.h"
 #include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/type_utils.h"
@@ -58,12 +61,62 @@ std::string RowBatch::DebugString() const {
     return "RowBatch: <empty>";
   }
   std::string debug_string = absl::StrFormat("RowBatch(eow=%d, eos=%d):\n", eow_, eos_);
+  if (has_selection()) {
+    debug_string += absl::StrFormat("  selection: [%s]\n", absl::StrJoin(*selection_, ", "));
+  }
   for (const auto& col : columns_) {
     debug_string += absl::StrFormat("  %s\n", col->ToString());
   }
   return debug_string;
 }
 
+template <DataType T>
+Status TakeRows(const arrow::Array* input_col, const std::vector<uint32_t>& rows,
+                arrow::MemoryPool* mem_pool, std::shared_ptr<arrow::Array>* output_col) {
+  auto builder = types::MakeArrowBuilder(T, mem_pool);
+  auto* typed_builder =
+      static_cast<typename types::DataTypeTraits<T>::arrow_builder_type*>(builder.get());
+  PX_RETURN_IF_ERROR(typed_builder->Reserve(rows.size()));
+  if constexpr (T == DataType::STRING) {
+    const auto* str_col = static_cast<const arrow::StringArray*>(input_col);
+    int64_t data_size = 0;
+    for (uint32_t row : rows) {
+      data_size += str_col->value_length(row);
+    }
+    PX_RETURN_IF_ERROR(typed_builder->ReserveData(data_size));
+    for (uint32_t row : rows) {
+      auto view = str_col->GetView(row);
+      typed_builder->UnsafeAppend(view.data(), static_cast<int32_t>(view.size()));
+    }
+  } else {
+    for (uint32_t row : rows) {
+      typed_builder->UnsafeAppend(types::GetValueFromArrowArray<T>(input_col, row));
+    }
+  }
+  PX_RETURN_IF_ERROR(typed_builder->Finish(output_col));
+  return Status::OK();
+}
+
+StatusOr<std::unique_ptr<RowBatch>> RowBatch::Materialize(arrow::MemoryPool* mem_pool) const {
+  auto output_rb = std::make_unique<RowBatch>(desc_, num_rows());
+  output_rb->set_eow(eow_);
+  output_rb->set_eos(eos_);
+  output_rb->watermark_ = watermark_;
+  for (const auto& [col_idx, col] : Enumerate(columns_)) {
+    if (!has_selection()) {
+      PX_RETURN_IF_ERROR(output_rb->AddColumn(col));
+      continue;
+    }
+    std::shared_ptr<arrow::Array> output_col;
+#define TYPE_CASE(_dt_) \
+  PX_RETURN_IF_ERROR(TakeRows<_dt_>(col.get(), *selection_, mem_pool, &output_col));
+    PX_SWITCH_FOREACH_DATATYPE(desc_.type(col_idx), TYPE_CASE);
+#undef TYPE_CASE
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(output_col));
+  }
+  return output_rb;
+}
+
 int64_t RowBatch::NumBytes() const {
   if (num_rows() == 0) {
     return 0;
@@ -159,9 +212,17 @@ Status CopyFromInputPB(std::shared_ptr<arrow::Array>* output_column,
 }
 
 Status RowBatch::ToProto(table_store::schemapb::RowBatchData* proto) const {
+  if (has_selection()) {
+    PX_ASSIGN_OR_RETURN(auto dense_rb, Materialize());
+    return dense_rb->ToProto(proto);
+  }
   proto->set_num_rows(num_rows_);
   proto->set_eow(eow_);
   proto->set_eos(eos_);
+  if (watermark_.has_value()) {
+    proto->set_has_watermark(true);
+    proto->set_watermark(*watermark_);
+  }
 
   for (auto col_idx = 0; col_idx < num_columns(); ++col_idx) {
     auto input_col = ColumnAt(col_idx).get();
@@ -176,6 +237,177 @@ Status RowBatch::ToProto(table_store::schemapb::RowBatchData* proto) const {
   return Status::OK();
 }
 
+template <DataType T>
+void CopyArrowBuffersIntoOutputPB(table_store::schemapb::ArrowBuffersColumn* output_column,
+                                  const arrow::Array& input_column) {
+  int64_t length = input_column.length();
+  output_column->set_data_type(T);
+  if constexpr (T == DataType::BOOLEAN) {
+    // The values are packed into bits, so they are repacked in case the array starts in the middle
+    // of a byte.
+    const auto& bools = static_cast<const arrow::BooleanArray&>(input_column);
+    std::string* values = output_column->mutable_values();
+    values->assign((length + 7) / 8, '\0');
+    for (int64_t i = 0; i < length; ++i) {
+      (*values)[i / 8] |= static_cast<char>(bools.Value(i) << (i % 8));
+    }
+  } else if constexpr (T == DataType::STRING) {
+    // The offsets are rebased so that the sent values start at the first string of the array.
+    const auto& strings = static_cast<const arrow::StringArray&>(input_column);
+    std::string* offsets = output_column->mutable_offsets();
+    offsets->assign((length + 1) * sizeof(int32_t), '\0');
+    if (length == 0) {
+      return;
+    }
+    const int32_t* input_offsets = strings.raw_value_offsets();
+    int32_t first_offset = input_offsets[0];
+    auto* output_offsets = reinterpret_cast<int32_t*>(offsets->data());
+    for (int64_t i = 0; i <= length; ++i) {
+      output_offsets[i] = input_offsets[i] - first_offset;
+    }
+    if (input_offsets[length] == first_offset) {
+      return;
+    }
+    output_column->set_values(
+        reinterpret_cast<const char*>(strings.value_data()->data()) + first_offset,
+        input_offsets[length] - first_offset);
+  } else {
+    using NativeType = typename types::DataTypeTraits<T>::native_type;
+    const auto* values = input_column.data()->GetValues<NativeType>(1);
+    output_column->set_values(reinterpret_cast<const char*>(values), length * sizeof(NativeType));
+  }
+}
+
+Status RowBatch::ToArrowBuffersProto(table_store::schemapb::RowBatchData* proto) const {
+  if (has_selection()) {
+    PX_ASSIGN_OR_RETURN(auto dense_rb, Materialize());
+    return dense_rb->ToArrowBuffersProto(proto);
+  }
+  proto->set_num_rows(num_rows_);
+  proto->set_eow(eow_);
+  proto->set_eos(eos_);
+  if (watermark_.has_value()) {
+    proto->set_has_watermark(true);
+    proto->set_watermark(*watermark_);
+  }
+
+  for (auto col_idx = 0; col_idx < num_columns(); ++col_idx) {
+    const auto& input_col = *ColumnAt(col_idx);
+    auto output_col_data = proto->add_arrow_cols();
+    auto dt = desc_.type(col_idx);
+
+#define TYPE_CASE(_dt_) CopyArrowBuffersIntoOutputPB<_dt_>(output_col_data, input_col);
+    PX_SWITCH_FOREACH_DATATYPE(dt, TYPE_CASE);
+#undef TYPE_CASE
+  }
+
+  return Status::OK();
+}
+
+// A buffer over the bytes of a proto, which keeps the proto alive.
+class ProtoBytesBuffer : public arrow::Buffer {
+ public:
+  ProtoBytesBuffer(const std::string& bytes, std::shared_ptr<const void> owner)
+      : arrow::Buffer(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()),
+        owner_(std::move(owner)) {}
+
+ private:
+  std::shared_ptr<const void> owner_;
+};
+
+// Returns the bytes as an arrow buffer. They are aliased when there is an owner to keep them alive
+// and they are aligned for the values they hold, otherwise they are copied.
+StatusOr<std::shared_ptr<arrow::Buffer>> BufferFromPBBytes(
+    const std::string& bytes, size_t alignment, const std::shared_ptr<const void>& owner) {
+  if (owner != nullptr && reinterpret_cast<uintptr_t>(bytes.data()) % alignment == 0) {
+    return std::shared_ptr<arrow::Buffer>(std::make_shared<ProtoBytesBuffer>(bytes, owner));
+  }
+  std::shared_ptr<arrow::Buffer> buffer;
+  PX_RETURN_IF_ERROR(arrow::AllocateBuffer(arrow::default_memory_pool(), bytes.size(), &buffer));
+  std::memcpy(buffer->mutable_data(), bytes.data(), bytes.size());
+  return buffer;
+}
+
+template <DataType T>
+Status ArrowBuffersFromInputPB(std::shared_ptr<arrow::Array>* output_column,
+                               const table_store::schemapb::ArrowBuffersColumn& input_column,
+                               int64_t num_rows, const std::shared_ptr<const void>& owner) {
+  auto type = MakeArrowBuilder(T, arrow::default_memory_pool())->type();
+  if constexpr (T == DataType::STRING) {
+    if (input_column.offsets().size() != (num_rows + 1) * sizeof(int32_t)) {
+      return error::InvalidArgument("Expected $0 string offsets, got $1 bytes", num_rows + 1,
+                                    input_column.offsets().size());
+    }
+    PX_ASSIGN_OR_RETURN(auto offsets,
+                        BufferFromPBBytes(input_column.offsets(), alignof(int32_t), owner));
+    PX_ASSIGN_OR_RETURN(auto values, BufferFromPBBytes(input_column.values(), 1, owner));
+    // Arrow doesn't check the offsets, so a malformed batch would read out of bounds.
+    auto offset_data = reinterpret_cast<const int32_t*>(offsets->data());
+    if (offset_data[0] != 0) {
+      return error::InvalidArgument("String offsets must start at 0, got $0", offset_data[0]);
+    }
+    for (int64_t i = 0; i < num_rows; ++i) {
+      if (offset_data[i + 1] < offset_data[i]) {
+        return error::InvalidArgument("String offsets decrease at row $0", i);
+      }
+    }
+    if (static_cast<size_t>(offset_data[num_rows]) != input_column.values().size()) {
+      return error::InvalidArgument("String offsets end at $0, but there are $1 bytes of values",
+                                    offset_data[num_rows], input_column.values().size());
+    }
+    *output_column = arrow::MakeArray(
+        arrow::ArrayData::Make(type, num_rows, {nullptr, offsets, values}, /* null_count */ 0));
+  } else {
+    using NativeType = typename types::DataTypeTraits<T>::native_type;
+    size_t expected_size = T == DataType::BOOLEAN ? static_cast<size_t>(num_rows + 7) / 8
+                                                  : num_rows * sizeof(NativeType);
+    if (input_column.values().size() != expected_size) {
+      return error::InvalidArgument("Expected $0 bytes of values for $1 rows, got $2",
+                                    expected_size, num_rows, input_column.values().size());
+    }
+    PX_ASSIGN_OR_RETURN(auto values,
+                        BufferFromPBBytes(input_column.values(), alignof(NativeType), owner));
+    *output_column = arrow::MakeArray(
+        arrow::ArrayData::Make(type, num_rows, {nullptr, values}, /* null_count */ 0));
+  }
+  return Status::OK();
+}
+
+// Reads a batch sent with the Arrow buffers encoding. If owner is set, it keeps the proto alive
+// and the buffers are aliased.
+StatusOr<std::unique_ptr<RowBatch>> FromArrowBuffersProto(
+    const table_store::schemapb::RowBatchData& proto, const std::shared_ptr<const void>& owner) {
+  if (proto.num_rows() < 0) {
+    return error::InvalidArgument("Invalid number of rows: $0", proto.num_rows());
+  }
+  std::vector<DataType> types(proto.arrow_cols_size());
+  std::vector<std::shared_ptr<arrow::Array>> data_columns(proto.arrow_cols_size());
+
+  for (auto i = 0; i < proto.arrow_cols_size(); ++i) {
+    types[i] = proto.arrow_cols(i).data_type();
+
+#define TYPE_CASE(_dt_)                                                                     \
+  PX_RETURN_IF_ERROR(ArrowBuffersFromInputPB<_dt_>(&data_columns[i], proto.arrow_cols(i), \
+                                                   proto.num_rows(), owner));
+    PX_SWITCH_FOREACH_DATATYPE(types[i], TYPE_CASE);
+#undef TYPE_CASE
+  }
+
+  RowDescriptor desc(types);
+  std::unique_ptr<RowBatch> output_rb = std::make_unique<RowBatch>(desc, proto.num_rows());
+  output_rb->set_eow(proto.eow());
+  output_rb->set_eos(proto.eos());
+  if (proto.has_watermark()) {
+    output_rb->set_watermark(proto.watermark());
+  }
+
+  for (auto i = 0; i < proto.arrow_cols_size(); ++i) {
+    PX_RETURN_IF_ERROR(output_rb->AddColumn(data_columns[i]));
+  }
+
+  return output_rb;
+}
+
 // PX_CARNOT_UPDATE_FOR_NEW_TYPES
 StatusOr<DataType> ProtoDataType(const table_store::schemapb::Column& proto) {
   switch (proto.col_data_case()) {
@@ -199,6 +431,9 @@ StatusOr<DataType> ProtoDataType(const table_store::schemapb::Column& proto) {
 
 StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromProto(
     const table_store::schemapb::RowBatchData& proto) {
+  if (proto.arrow_cols_size() > 0) {
+    return FromArrowBuffersProto(proto, /* owner */ nullptr);
+  }
   std::vector<DataType> types(proto.cols_size());
   std::vector<std::shared_ptr<arrow::Array>> data_columns(proto.cols_size());
 
@@ -215,6 +450,9 @@ StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromProto(
   std::unique_ptr<RowBatch> output_rb = std::make_unique<RowBatch>(desc, proto.num_rows());
   output_rb->set_eow(proto.eow());
   output_rb->set_eos(proto.eos());
+  if (proto.has_watermark()) {
+    output_rb->set_watermark(proto.watermark());
+  }
 
   for (auto i = 0; i < proto.cols_size(); ++i) {
     PX_RETURN_IF_ERROR(output_rb->AddColumn(data_columns[i]));
@@ -223,6 +461,14 @@ StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromProto(
   return output_rb;
 }
 
+StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromProto(
+    std::shared_ptr<const table_store::schemapb::RowBatchData> proto) {
+  if (proto->arrow_cols_size() > 0) {
+    return FromArrowBuffersProto(*proto, proto);
+  }
+  return FromProto(*proto);
+}
+
 StatusOr<std::unique_ptr<RowBatch>> RowBatch::FromColumnBuilders(
     const RowDescriptor& desc, bool eow, bool eos,
     std::vector<std::unique_ptr<arrow::ArrayBuilder>>* builders) {
@@ -257,6 +503,10 @@ StatusOr<std::unique_ptr<RowBatch>> RowBatch::Slice(int64_t offset, int64_t leng
     return error::InvalidArgument("Slice(offset=$0, length=$1) on rowbatch of length $2 is invalid",
                                   offset, length, num_rows());
   }
+  if (has_selection()) {
+    PX_ASSIGN_OR_RETURN(auto dense_rb, Materialize());
+    return dense_rb->Slice(offset, length);
+  }
   std::unique_ptr<RowBatch> output_rb = std::make_unique<RowBatch>(desc(), length);
   for (int64_t input_col_idx = 0; input_col_idx < num_columns(); ++input_col_idx) {
     auto col = ColumnAt(input_col_idx);
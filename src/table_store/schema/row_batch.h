@@ -19,9 +19,11 @@
 #pragma once
 
 #include <arrow/array.h>
+#include <arrow/memory_pool.h>
 #include <arrow/type.h>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -50,8 +52,19 @@ class RowBatch {
   }
 
   Status ToProto(table_store::schemapb::RowBatchData* row_batch_proto) const;
+  /**
+   * @brief Same as ToProto, but copies the Arrow buffers of each column into the proto as they are
+   * (see RowBatchData.arrow_cols), instead of serializing the values one by one.
+   */
+  Status ToArrowBuffersProto(table_store::schemapb::RowBatchData* row_batch_proto) const;
   static StatusOr<std::unique_ptr<RowBatch>> FromProto(
       const table_store::schemapb::RowBatchData& row_batch_proto);
+  /**
+   * @brief Same as FromProto, but columns sent with the Arrow buffers encoding alias the memory of
+   * the proto instead of copying it. The proto is kept alive for as long as those columns are.
+   */
+  static StatusOr<std::unique_ptr<RowBatch>> FromProto(
+      std::shared_ptr<const table_store::schemapb::RowBatchData> row_batch_proto);
 
   static StatusOr<std::unique_ptr<RowBatch>> FromColumnBuilders(
       const RowDescriptor& desc, bool eow, bool eos,
@@ -76,6 +89,35 @@ class RowBatch {
    */
   StatusOr<std::unique_ptr<RowBatch>> Slice(int64_t offset, int64_t length) const;
 
+  /**
+   * Restricts the batch to a subset of the rows of its columns, without copying the columns.
+   *
+   * Once a selection is set, num_rows() is the number of selected rows, while the columns keep
+   * num_column_rows() values. Exec nodes that don't handle selections receive a materialized copy
+   * of the batch instead (see Materialize).
+   *
+   * @param selection The indices of the selected rows, in increasing order.
+   */
+  void SetSelection(std::shared_ptr<const std::vector<uint32_t>> selection) {
+    selection_ = std::move(selection);
+  }
+
+  /**
+   * @ return whether only the rows in selection() are part of the batch.
+   */
+  bool has_selection() const { return selection_ != nullptr; }
+  const std::vector<uint32_t>& selection() const { return *selection_; }
+  const std::shared_ptr<const std::vector<uint32_t>>& shared_selection() const {
+    return selection_;
+  }
+
+  /**
+   * @brief Returns a batch with the same rows as this one, where the selected rows are copied into
+   * new dense columns, allocated from the given pool. eow, eos and the watermark are preserved.
+   */
+  StatusOr<std::unique_ptr<RowBatch>> Materialize(
+      arrow::MemoryPool* mem_pool = arrow::default_memory_pool()) const;
+
   /**
    * Adds the given column to the row batch, given that it correctly fits the schema.
    * param col ptr to the arrow array that should be added to the row batch.
@@ -97,7 +139,14 @@ class RowBatch {
   /**
    * @ return the number of rows that each row batch should contain.
    */
-  int64_t num_rows() const { return num_rows_; }
+  int64_t num_rows() const {
+    return selection_ == nullptr ? num_rows_ : static_cast<int64_t>(selection_->size());
+  }
+
+  /**
+   * @ return the length of the columns, which differs from num_rows() if the batch has a selection.
+   */
+  int64_t num_column_rows() const { return num_rows_; }
 
   /**
    * @ return the number of columns which the row batch should contain.
@@ -110,6 +159,14 @@ class RowBatch {
 
   bool eos() const { return eos_; }
   void set_eos(bool val) { eos_ = val; }
+
+  /**
+   * @ return the time that the later batches of the stream are known to be at or after, if the
+   * sender knows one. Set by the partial time windowed aggregates, so that the aggregate merging
+   * them can close its windows when an agent has nothing to send.
+   */
+  std::optional<int64_t> watermark() const { return watermark_; }
+  void set_watermark(int64_t val) { watermark_ = val; }
   /**
    * @ return the row descriptor which describes the schema of the row batch.
    */
@@ -125,7 +182,10 @@ class RowBatch {
   int64_t num_rows_;
   bool eow_ = false;
   bool eos_ = false;
+  std::optional<int64_t> watermark_;
   std::vector<std::shared_ptr<arrow::Array>> columns_;
+  // Shared, since batches are copied as they are passed around.
+  std::shared_ptr<const std::vector<uint32_t>> selection_;
 };
 
 // Append a scalar value to an arrow::Array.
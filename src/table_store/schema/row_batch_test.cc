@@ -190,6 +190,24 @@ TEST_F(RowBatchTest, with_zero_rows) {
   EXPECT_EQ(eos, rb->eos());
 }
 
+TEST_F(RowBatchTest, watermark_to_from_proto) {
+  auto rb = RowBatch::WithZeroRows(*rd_, /*eow*/ false, /*eos*/ false).ConsumeValueOrDie();
+  table_store::schemapb::RowBatchData no_watermark_proto;
+  EXPECT_OK(rb->ToProto(&no_watermark_proto));
+  EXPECT_FALSE(RowBatch::FromProto(no_watermark_proto).ConsumeValueOrDie()->watermark());
+
+  // 0 is a valid watermark, so it has to survive the round trip.
+  rb->set_watermark(0);
+  table_store::schemapb::RowBatchData proto;
+  EXPECT_OK(rb->ToProto(&proto));
+  EXPECT_EQ(0, RowBatch::FromProto(proto).ConsumeValueOrDie()->watermark());
+
+  rb->set_watermark(100);
+  table_store::schemapb::RowBatchData arrow_buffers_proto;
+  EXPECT_OK(rb->ToArrowBuffersProto(&arrow_buffers_proto));
+  EXPECT_EQ(100, RowBatch::FromProto(arrow_buffers_proto).ConsumeValueOrDie()->watermark());
+}
+
 TEST_F(RowBatchTest, slice) {
   EXPECT_EQ(3, rb_->num_rows());
 
@@ -231,6 +249,141 @@ TEST_F(RowBatchTest, slice) {
   ASSERT_EQ(status2.msg(), "Slice(offset=-1, length=3) on rowbatch of length 3 is invalid");
 }
 
+TEST_F(RowBatchTest, selection) {
+  EXPECT_FALSE(rb_->has_selection());
+  rb_->SetSelection(std::make_shared<std::vector<uint32_t>>(std::vector<uint32_t>{0, 2}));
+  rb_->set_eow(true);
+  EXPECT_TRUE(rb_->has_selection());
+  EXPECT_EQ(2, rb_->num_rows());
+  EXPECT_EQ(3, rb_->num_column_rows());
+  EXPECT_EQ(3, rb_->ColumnAt(0)->length());
+
+  ASSERT_OK_AND_ASSIGN(auto dense_rb, rb_->Materialize());
+  EXPECT_FALSE(dense_rb->has_selection());
+  EXPECT_EQ(2, dense_rb->num_rows());
+  EXPECT_EQ(2, dense_rb->num_column_rows());
+  EXPECT_TRUE(dense_rb->eow());
+  EXPECT_FALSE(dense_rb->eos());
+  EXPECT_EQ(
+      "RowBatch(eow=1, eos=0):\n  [\n  true,\n  true\n]\n  [\n  3,\n  5\n]\n  [\n  "
+      "3.3,\n  5.6\n]\n",
+      dense_rb->DebugString());
+
+  ASSERT_OK_AND_ASSIGN(auto sliced_rb, rb_->Slice(1, 1));
+  EXPECT_EQ("RowBatch(eow=0, eos=0):\n  [\n  true\n]\n  [\n  5\n]\n  [\n  5.6\n]\n",
+            sliced_rb->DebugString());
+
+  table_store::schemapb::RowBatchData pb;
+  EXPECT_OK(rb_->ToProto(&pb));
+  EXPECT_EQ(2, pb.num_rows());
+  ASSERT_OK_AND_ASSIGN(auto rb_from_pb, RowBatch::FromProto(pb));
+  EXPECT_EQ(dense_rb->DebugString(), rb_from_pb->DebugString());
+}
+
+TEST_F(RowBatchTest, materialize_strings) {
+  RowDescriptor rd({types::DataType::STRING, types::DataType::UINT128});
+  RowBatch rb(rd, 4);
+  std::vector<types::StringValue> strs = {"a", "bcd", "", "efgh"};
+  std::vector<types::UInt128Value> ids = {1, 2, 3, 4};
+  EXPECT_OK(rb.AddColumn(types::ToArrow(strs, arrow::default_memory_pool())));
+  EXPECT_OK(rb.AddColumn(types::ToArrow(ids, arrow::default_memory_pool())));
+  rb.SetSelection(std::make_shared<std::vector<uint32_t>>(std::vector<uint32_t>{1, 2, 3}));
+
+  ASSERT_OK_AND_ASSIGN(auto dense_rb, rb.Materialize());
+  ASSERT_EQ(3, dense_rb->num_rows());
+  auto str_col = dense_rb->ColumnAt(0);
+  auto id_col = dense_rb->ColumnAt(1);
+  EXPECT_EQ("bcd", types::GetValueFromArrowArray<types::DataType::STRING>(str_col.get(), 0));
+  EXPECT_EQ("", types::GetValueFromArrowArray<types::DataType::STRING>(str_col.get(), 1));
+  EXPECT_EQ("efgh", types::GetValueFromArrowArray<types::DataType::STRING>(str_col.get(), 2));
+  EXPECT_EQ(absl::uint128(2),
+            types::GetValueFromArrowArray<types::DataType::UINT128>(id_col.get(), 0));
+  EXPECT_EQ(absl::uint128(4),
+            types::GetValueFromArrowArray<types::DataType::UINT128>(id_col.get(), 2));
+}
+
+TEST_F(RowBatchTest, arrow_buffers_proto) {
+  rb_->set_eow(true);
+  table_store::schemapb::RowBatchData pb;
+  EXPECT_OK(rb_->ToArrowBuffersProto(&pb));
+  EXPECT_EQ(0, pb.cols_size());
+  EXPECT_EQ(3, pb.arrow_cols_size());
+
+  ASSERT_OK_AND_ASSIGN(auto copied_rb, RowBatch::FromProto(pb));
+  EXPECT_EQ(rb_->DebugString(), copied_rb->DebugString());
+
+  auto shared_pb = std::make_shared<table_store::schemapb::RowBatchData>(pb);
+  ASSERT_OK_AND_ASSIGN(auto aliased_rb, RowBatch::FromProto(shared_pb));
+  EXPECT_EQ(rb_->DebugString(), aliased_rb->DebugString());
+  // The batch keeps the proto alive.
+  shared_pb.reset();
+  EXPECT_EQ(rb_->DebugString(), aliased_rb->DebugString());
+}
+
+TEST_F(RowBatchTest, arrow_buffers_proto_slice) {
+  RowDescriptor rd({types::DataType::BOOLEAN, types::DataType::STRING, types::DataType::UINT128,
+                    types::DataType::TIME64NS});
+  RowBatch rb(rd, 10);
+  std::vector<types::BoolValue> bools;
+  std::vector<types::StringValue> strs;
+  std::vector<types::UInt128Value> ids;
+  std::vector<types::Time64NSValue> times;
+  for (int i = 0; i < 10; ++i) {
+    bools.push_back(i % 3 == 0);
+    strs.push_back(std::string(i, 'a'));
+    ids.emplace_back(i, i + 1);
+    times.push_back(i * 1000);
+  }
+  EXPECT_OK(rb.AddColumn(types::ToArrow(bools, arrow::default_memory_pool())));
+  EXPECT_OK(rb.AddColumn(types::ToArrow(strs, arrow::default_memory_pool())));
+  EXPECT_OK(rb.AddColumn(types::ToArrow(ids, arrow::default_memory_pool())));
+  EXPECT_OK(rb.AddColumn(types::ToArrow(times, arrow::default_memory_pool())));
+
+  // The slice doesn't start at a byte boundary of the booleans nor at the start of the strings.
+  ASSERT_OK_AND_ASSIGN(auto sliced_rb, rb.Slice(3, 6));
+  auto pb = std::make_shared<table_store::schemapb::RowBatchData>();
+  EXPECT_OK(sliced_rb->ToArrowBuffersProto(pb.get()));
+  ASSERT_OK_AND_ASSIGN(auto rb_from_pb, RowBatch::FromProto(pb));
+  EXPECT_EQ(rd, rb_from_pb->desc());
+  EXPECT_EQ(sliced_rb->DebugString(), rb_from_pb->DebugString());
+}
+
+TEST_F(RowBatchTest, arrow_buffers_proto_invalid) {
+  table_store::schemapb::RowBatchData pb;
+  EXPECT_OK(rb_->ToArrowBuffersProto(&pb));
+  pb.mutable_arrow_cols(1)->mutable_values()->resize(4);
+  EXPECT_NOT_OK(RowBatch::FromProto(pb));
+}
+
+TEST_F(RowBatchTest, arrow_buffers_proto_invalid_string_offsets) {
+  RowDescriptor rd({types::DataType::STRING});
+  RowBatch rb(rd, 3);
+  std::vector<types::StringValue> strs = {"ab", "cde", "f"};
+  EXPECT_OK(rb.AddColumn(types::ToArrow(strs, arrow::default_memory_pool())));
+  table_store::schemapb::RowBatchData pb;
+  EXPECT_OK(rb.ToArrowBuffersProto(&pb));
+  EXPECT_OK(RowBatch::FromProto(pb));
+
+  auto set_offsets = [&pb](std::vector<int32_t> offsets) {
+    pb.mutable_arrow_cols(0)->set_offsets(std::string(reinterpret_cast<const char*>(offsets.data()),
+                                                      offsets.size() * sizeof(int32_t)));
+  };
+  // Doesn't start at 0.
+  set_offsets({1, 2, 5, 6});
+  EXPECT_NOT_OK(RowBatch::FromProto(pb));
+  // Decreasing, the second string would start past the end of the values.
+  set_offsets({0, 7, 5, 6});
+  EXPECT_NOT_OK(RowBatch::FromProto(pb));
+  // Past the end of the values.
+  set_offsets({0, 2, 5, 7});
+  EXPECT_NOT_OK(RowBatch::FromProto(pb));
+  set_offsets({0, 2, 5, 6});
+  EXPECT_OK(RowBatch::FromProto(pb));
+
+  pb.set_num_rows(-1);
+  EXPECT_NOT_OK(RowBatch::FromProto(pb));
+}
+
 }  // namespace schema
 }  // namespace table_store
 }  // namespace px
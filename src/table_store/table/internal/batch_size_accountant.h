@@ -134,6 +134,13 @@ class BatchSizeAccountant {
    * into the cold store via CompactedBatchSpec.
    */
   uint64_t FinishCompactedBatch();
+  /**
+   * FinishCompactedBatch is the same as above, except that the batch takes up `cold_bytes` in the
+   * cold store instead of the bytes it took up in the hot store, e.g. because it was compressed.
+   * @param cold_bytes, the number of bytes the compacted batch takes up in the cold store.
+   * @return Number of rows to remove from the front of the hot store.
+   */
+  uint64_t FinishCompactedBatch(uint64_t cold_bytes);
   /**
    * @return the number of bytes stored in the hot store.
    */
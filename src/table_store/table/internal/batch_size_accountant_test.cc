@@ -201,6 +201,25 @@ TEST_P(BatchSizeAccountantTest, IndexThenCompactWithExpiry) {
   EXPECT_EQ(2 * half_compaction_rb_bytes_, accountant_->ColdBytes());
 }
 
+TEST_P(BatchSizeAccountantTest, CompressedColdBytes) {
+  accountant_->NewHotBatch(
+      BatchSizeAccountant::CalcBatchStats(accountant_->NonMutableState(), *half_compaction_rb_));
+  accountant_->NewHotBatch(
+      BatchSizeAccountant::CalcBatchStats(accountant_->NonMutableState(), *half_compaction_rb_));
+  accountant_->NewHotBatch(
+      BatchSizeAccountant::CalcBatchStats(accountant_->NonMutableState(), *half_compaction_rb_));
+
+  ASSERT_TRUE(accountant_->CompactedBatchReady());
+  // The compacted batch only takes up 10 bytes once it's in the cold store.
+  EXPECT_EQ(0, accountant_->FinishCompactedBatch(10));
+  EXPECT_EQ(half_compaction_rb_bytes_, accountant_->HotBytes());
+  EXPECT_EQ(10, accountant_->ColdBytes());
+
+  accountant_->ExpireColdBatch();
+  EXPECT_EQ(half_compaction_rb_bytes_, accountant_->HotBytes());
+  EXPECT_EQ(0, accountant_->ColdBytes());
+}
+
 INSTANTIATE_RECORD_OR_ROW_BATCH_TESTSUITE(BatchSizeAccountant, BatchSizeAccountantTest,
                                           /*include_mixed*/ true);
 
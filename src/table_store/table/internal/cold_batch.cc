@@ -0,0 +1,424 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "src/table_store/table/internal/cold_batch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <arrow/builder.h>
+#include <absl/container/flat_hash_map.h>
+
+#include "src/common/zlib/zlib_wrapper.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/shared/types/type_utils.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+namespace {
+
+// Bytes held by the buffers of an arrow array that isn't a slice of a larger array.
+int64_t ArrayBytes(const arrow::Array* arr) {
+  int64_t bytes = 0;
+  for (const auto& buffer : arr->data()->buffers) {
+    if (buffer != nullptr) {
+      bytes += buffer->size();
+    }
+  }
+  return bytes;
+}
+
+int64_t Int64Value(types::DataType data_type, const arrow::Array* arr, int64_t idx) {
+  if (data_type == types::DataType::TIME64NS) {
+    return types::GetValueFromArrowArray<types::DataType::TIME64NS>(arr, idx);
+  }
+  return types::GetValueFromArrowArray<types::DataType::INT64>(arr, idx);
+}
+
+}  // namespace
+
+BitPackedInts BitPackedInts::Pack(const std::vector<uint64_t>& values, int bit_width) {
+  BitPackedInts packed;
+  packed.bit_width_ = bit_width;
+  if (bit_width == 0) {
+    return packed;
+  }
+  uint64_t total_bits = static_cast<uint64_t>(values.size()) * bit_width;
+  packed.words_.resize((total_bits + 63) / 64, 0);
+  for (size_t i = 0; i < values.size(); ++i) {
+    uint64_t bit_pos = static_cast<uint64_t>(i) * bit_width;
+    uint64_t word = bit_pos / 64;
+    uint64_t shift = bit_pos % 64;
+    packed.words_[word] |= values[i] << shift;
+    if (shift + bit_width > 64) {
+      packed.words_[word + 1] |= values[i] >> (64 - shift);
+    }
+  }
+  return packed;
+}
+
+int BitPackedInts::BitWidth(uint64_t max_value) {
+  int width = 0;
+  while (max_value != 0) {
+    ++width;
+    max_value >>= 1;
+  }
+  return width;
+}
+
+ColdColumn::ColdColumn(std::shared_ptr<arrow::Array> arr)
+    : data_type_(types::ArrowToDataType(arr->type_id())),
+      encoding_(Encoding::kPlain),
+      length_(arr->length()),
+      array_(std::move(arr)) {}
+
+StatusOr<ColdColumn> ColdColumn::Encode(types::DataType data_type,
+                                        std::shared_ptr<arrow::Array> arr,
+                                        const ColdEncodingOptions& opts) {
+  ColdColumn best(arr);
+  if (arr->null_count() > 0 || arr->offset() != 0 || arr->length() == 0) {
+    return best;
+  }
+  auto consider = [&best](std::optional<ColdColumn> candidate) {
+    if (candidate.has_value() && candidate->bytes() < best.bytes()) {
+      best = std::move(candidate.value());
+    }
+  };
+  switch (data_type) {
+    case types::DataType::INT64:
+    case types::DataType::TIME64NS:
+      consider(EncodeFrameOfReference(data_type, arr.get()));
+      consider(EncodeRunLength(data_type, arr.get()));
+      break;
+    case types::DataType::UINT128:
+      consider(EncodeRunLength(data_type, arr.get()));
+      break;
+    case types::DataType::STRING: {
+      PX_ASSIGN_OR_RETURN(auto dictionary, EncodeDictionary(arr.get()));
+      consider(std::move(dictionary));
+      if (opts.deflate_strings && best.encoding() == Encoding::kPlain) {
+        PX_ASSIGN_OR_RETURN(auto deflated, EncodeDeflate(arr.get()));
+        consider(std::move(deflated));
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return best;
+}
+
+std::optional<ColdColumn> ColdColumn::EncodeFrameOfReference(types::DataType data_type,
+                                                             const arrow::Array* arr) {
+  int64_t min = Int64Value(data_type, arr, 0);
+  int64_t max = min;
+  for (int64_t i = 1; i < arr->length(); ++i) {
+    int64_t val = Int64Value(data_type, arr, i);
+    min = std::min(min, val);
+    max = std::max(max, val);
+  }
+  std::vector<uint64_t> offsets(arr->length());
+  for (int64_t i = 0; i < arr->length(); ++i) {
+    offsets[i] = static_cast<uint64_t>(Int64Value(data_type, arr, i)) - static_cast<uint64_t>(min);
+  }
+  int bit_width = BitPackedInts::BitWidth(static_cast<uint64_t>(max) - static_cast<uint64_t>(min));
+  if (bit_width == 64) {
+    return std::nullopt;
+  }
+  ColdColumn col(data_type, Encoding::kFrameOfReference, arr->length());
+  col.array_ = nullptr;
+  col.base_ = min;
+  col.packed_ = BitPackedInts::Pack(offsets, bit_width);
+  return col;
+}
+
+std::optional<ColdColumn> ColdColumn::EncodeRunLength(types::DataType data_type,
+                                                      const arrow::Array* arr) {
+  ColdColumn col(data_type, Encoding::kRunLength, arr->length());
+  if (data_type == types::DataType::UINT128) {
+    for (int64_t i = 0; i < arr->length(); ++i) {
+      absl::uint128 val = types::GetValueFromArrowArray<types::DataType::UINT128>(arr, i);
+      if (i == 0 || val != col.run_values_128_.back()) {
+        col.run_values_128_.push_back(val);
+        col.run_ends_.push_back(i + 1);
+      } else {
+        col.run_ends_.back() = i + 1;
+      }
+    }
+  } else {
+    for (int64_t i = 0; i < arr->length(); ++i) {
+      int64_t val = Int64Value(data_type, arr, i);
+      if (i == 0 || val != col.run_values_.back()) {
+        col.run_values_.push_back(val);
+        col.run_ends_.push_back(i + 1);
+      } else {
+        col.run_ends_.back() = i + 1;
+      }
+    }
+  }
+  // Not worth it unless the runs are at least a few rows long on average.
+  if (static_cast<int64_t>(col.run_ends_.size()) * 2 > arr->length()) {
+    return std::nullopt;
+  }
+  return col;
+}
+
+StatusOr<std::optional<ColdColumn>> ColdColumn::EncodeDictionary(const arrow::Array* arr) {
+  absl::flat_hash_map<std::string_view, uint64_t> codes;
+  std::vector<std::string_view> dictionary;
+  std::vector<uint64_t> indexes(arr->length());
+  for (int64_t i = 0; i < arr->length(); ++i) {
+    auto val = types::GetStringViewFromArrowArray(arr, i);
+    auto [it, inserted] = codes.try_emplace(val, dictionary.size());
+    if (inserted) {
+      dictionary.push_back(val);
+      // A dictionary this large is unlikely to be smaller than the column itself.
+      if (static_cast<int64_t>(dictionary.size()) * 2 > arr->length()) {
+        return std::optional<ColdColumn>();
+      }
+    }
+    indexes[i] = it->second;
+  }
+
+  arrow::StringBuilder builder;
+  PX_RETURN_IF_ERROR(builder.Reserve(dictionary.size()));
+  for (const auto& val : dictionary) {
+    PX_RETURN_IF_ERROR(builder.Append(val.data(), static_cast<int32_t>(val.size())));
+  }
+  ColdColumn col(types::DataType::STRING, Encoding::kDictionary, arr->length());
+  PX_RETURN_IF_ERROR(builder.Finish(&col.array_));
+  col.packed_ = BitPackedInts::Pack(indexes, BitPackedInts::BitWidth(dictionary.size() - 1));
+  return std::optional<ColdColumn>(std::move(col));
+}
+
+StatusOr<std::optional<ColdColumn>> ColdColumn::EncodeDeflate(const arrow::Array* arr) {
+  const auto& buffers = arr->data()->buffers;
+  if (buffers.size() != 3 || buffers[1] == nullptr || buffers[2] == nullptr) {
+    return std::optional<ColdColumn>();
+  }
+  auto str_arr = static_cast<const arrow::StringArray*>(arr);
+  ColdColumn col(types::DataType::STRING, Encoding::kDeflate, arr->length());
+  col.array_ = nullptr;
+  col.value_offsets_ = arrow::SliceBuffer(buffers[1], arr->offset() * sizeof(int32_t),
+                                          (arr->length() + 1) * sizeof(int32_t));
+  const char* data = reinterpret_cast<const char*>(buffers[2]->data());
+  for (int64_t start = 0; start < arr->length(); start += kDeflateBlockRows) {
+    int64_t end = std::min(start + kDeflateBlockRows, arr->length());
+    int32_t begin_byte = str_arr->value_offset(start);
+    PX_ASSIGN_OR_RETURN(auto block,
+                        zlib::Deflate(std::string_view(data + begin_byte,
+                                                       str_arr->value_offset(end) - begin_byte)));
+    col.deflated_blocks_.push_back(std::move(block));
+  }
+  return std::optional<ColdColumn>(std::move(col));
+}
+
+int64_t ColdColumn::bytes() const {
+  switch (encoding_) {
+    case Encoding::kPlain:
+      return ArrayBytes(array_.get());
+    case Encoding::kFrameOfReference:
+      return packed_.bytes() + sizeof(base_);
+    case Encoding::kRunLength:
+      return run_values_.size() * sizeof(int64_t) + run_values_128_.size() * sizeof(absl::uint128) +
+             run_ends_.size() * sizeof(int64_t);
+    case Encoding::kDictionary:
+      return ArrayBytes(array_.get()) + packed_.bytes();
+    case Encoding::kDeflate: {
+      int64_t bytes = value_offsets_->size();
+      for (const auto& block : deflated_blocks_) {
+        bytes += block.size();
+      }
+      return bytes;
+    }
+  }
+  return 0;
+}
+
+int64_t ColdColumn::RunIndex(int64_t idx) const {
+  return std::distance(run_ends_.begin(),
+                       std::upper_bound(run_ends_.begin(), run_ends_.end(), idx));
+}
+
+int64_t ColdColumn::Int64At(int64_t idx) const {
+  DCHECK(data_type_ == types::DataType::INT64 || data_type_ == types::DataType::TIME64NS);
+  switch (encoding_) {
+    case Encoding::kPlain:
+      return Int64Value(data_type_, array_.get(), idx);
+    case Encoding::kFrameOfReference:
+      return static_cast<int64_t>(static_cast<uint64_t>(base_) + packed_.Get(idx));
+    case Encoding::kRunLength:
+      return run_values_[RunIndex(idx)];
+    default:
+      LOG(DFATAL) << "Int64At called on a non integer column";
+      return 0;
+  }
+}
+
+int64_t ColdColumn::SearchGreaterThanOrEqual(int64_t val) const {
+  int64_t lo = 0;
+  int64_t hi = length_;
+  while (lo < hi) {
+    int64_t mid = lo + (hi - lo) / 2;
+    if (Int64At(mid) < val) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo == length_ ? -1 : lo;
+}
+
+int64_t ColdColumn::SearchLessThanOrEqual(int64_t val) const {
+  int64_t lo = 0;
+  int64_t hi = length_;
+  while (lo < hi) {
+    int64_t mid = lo + (hi - lo) / 2;
+    if (Int64At(mid) <= val) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo - 1;
+}
+
+StatusOr<std::shared_ptr<arrow::Array>> ColdColumn::Decode(int64_t offset, int64_t length,
+                                                           arrow::MemoryPool* pool) const {
+  DCHECK_LE(offset + length, length_);
+  switch (encoding_) {
+    case Encoding::kPlain:
+      return array_->Slice(offset, length);
+    case Encoding::kFrameOfReference:
+    case Encoding::kRunLength:
+      switch (data_type_) {
+        case types::DataType::INT64:
+          return DecodeInts<types::DataType::INT64>(offset, length, pool);
+        case types::DataType::TIME64NS:
+          return DecodeInts<types::DataType::TIME64NS>(offset, length, pool);
+        case types::DataType::UINT128:
+          return DecodeInts<types::DataType::UINT128>(offset, length, pool);
+        default:
+          return error::Internal("Unexpected data type $0 for an integer encoded column",
+                                 types::ToString(data_type_));
+      }
+    case Encoding::kDictionary:
+      return DecodeDictionary(offset, length, pool);
+    case Encoding::kDeflate:
+      return DecodeDeflate(offset, length, pool);
+  }
+  return error::Internal("Unknown cold column encoding");
+}
+
+template <types::DataType TDataType>
+StatusOr<std::shared_ptr<arrow::Array>> ColdColumn::DecodeInts(int64_t offset, int64_t length,
+                                                               arrow::MemoryPool* pool) const {
+  using TBuilder = typename types::DataTypeTraits<TDataType>::arrow_builder_type;
+  auto builder_base = types::MakeArrowBuilder(TDataType, pool);
+  auto builder = static_cast<TBuilder*>(builder_base.get());
+  PX_RETURN_IF_ERROR(builder->Reserve(length));
+  if (encoding_ == Encoding::kFrameOfReference) {
+    for (int64_t i = offset; i < offset + length; ++i) {
+      builder->UnsafeAppend(static_cast<int64_t>(static_cast<uint64_t>(base_) + packed_.Get(i)));
+    }
+  } else {
+    int64_t i = offset;
+    for (int64_t run = RunIndex(offset); i < offset + length; ++run) {
+      int64_t run_end = std::min(run_ends_[run], offset + length);
+      for (; i < run_end; ++i) {
+        if constexpr (TDataType == types::DataType::UINT128) {
+          builder->UnsafeAppend(run_values_128_[run]);
+        } else {
+          builder->UnsafeAppend(run_values_[run]);
+        }
+      }
+    }
+  }
+  std::shared_ptr<arrow::Array> arr;
+  PX_RETURN_IF_ERROR(builder->Finish(&arr));
+  return arr;
+}
+
+StatusOr<std::shared_ptr<arrow::Array>> ColdColumn::DecodeDictionary(
+    int64_t offset, int64_t length, arrow::MemoryPool* pool) const {
+  int64_t data_size = 0;
+  for (int64_t i = offset; i < offset + length; ++i) {
+    data_size += types::GetStringViewFromArrowArray(array_.get(), packed_.Get(i)).size();
+  }
+  arrow::StringBuilder builder(pool);
+  PX_RETURN_IF_ERROR(builder.Reserve(length));
+  PX_RETURN_IF_ERROR(builder.ReserveData(data_size));
+  for (int64_t i = offset; i < offset + length; ++i) {
+    auto val = types::GetStringViewFromArrowArray(array_.get(), packed_.Get(i));
+    builder.UnsafeAppend(val.data(), static_cast<int32_t>(val.size()));
+  }
+  std::shared_ptr<arrow::Array> arr;
+  PX_RETURN_IF_ERROR(builder.Finish(&arr));
+  return arr;
+}
+
+StatusOr<std::shared_ptr<arrow::Array>> ColdColumn::DecodeDeflate(int64_t offset, int64_t length,
+                                                                  arrow::MemoryPool* pool) const {
+  const auto* offsets = reinterpret_cast<const int32_t*>(value_offsets_->data());
+  // Only the blocks that hold the requested rows are inflated.
+  int64_t first_block = offset / kDeflateBlockRows;
+  int64_t end_block = length == 0 ? first_block : (offset + length - 1) / kDeflateBlockRows + 1;
+  int32_t blocks_begin_byte = offsets[first_block * kDeflateBlockRows];
+  std::string data;
+  for (int64_t block = first_block; block < end_block; ++block) {
+    int64_t block_size = offsets[std::min((block + 1) * kDeflateBlockRows, length_)] -
+                         offsets[block * kDeflateBlockRows];
+    PX_ASSIGN_OR_RETURN(std::string inflated, zlib::Inflate(deflated_blocks_[block],
+                                                            std::max<int64_t>(block_size, 1)));
+    if (static_cast<int64_t>(inflated.size()) != block_size) {
+      return error::Internal("Inflated $0 bytes of string data, expected $1", inflated.size(),
+                             block_size);
+    }
+    data.append(inflated);
+  }
+
+  // The decoded array only holds the requested rows, so its offsets are rebased to start at 0.
+  int32_t begin_byte = offsets[offset];
+  int64_t data_size = offsets[offset + length] - begin_byte;
+  std::shared_ptr<arrow::Buffer> offsets_buffer;
+  PX_RETURN_IF_ERROR(arrow::AllocateBuffer(pool, (length + 1) * sizeof(int32_t), &offsets_buffer));
+  auto* out_offsets = reinterpret_cast<int32_t*>(offsets_buffer->mutable_data());
+  for (int64_t i = 0; i <= length; ++i) {
+    out_offsets[i] = offsets[offset + i] - begin_byte;
+  }
+  std::shared_ptr<arrow::Buffer> data_buffer;
+  PX_RETURN_IF_ERROR(arrow::AllocateBuffer(pool, data_size, &data_buffer));
+  std::memcpy(data_buffer->mutable_data(), data.data() + (begin_byte - blocks_begin_byte),
+              data_size);
+  auto array_data = arrow::ArrayData::Make(
+      arrow::utf8(), length, {nullptr, std::move(offsets_buffer), std::move(data_buffer)},
+      /*null_count*/ 0);
+  return arrow::MakeArray(array_data);
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <arrow/array.h>
+#include <arrow/buffer.h>
+#include <arrow/memory_pool.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <absl/numeric/int128.h>
+
+#include "src/common/base/base.h"
+#include "src/shared/types/types.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+/**
+ * BitPackedInts stores a sequence of unsigned integers using a fixed number of bits per value,
+ * while still allowing random access to each value.
+ */
+class BitPackedInts {
+ public:
+  BitPackedInts() = default;
+
+  /**
+   * Pack stores the given values using the given number of bits for each value. All values must
+   * fit in bit_width bits.
+   */
+  static BitPackedInts Pack(const std::vector<uint64_t>& values, int bit_width);
+
+  /**
+   * BitWidth returns the number of bits needed to represent every value up to max_value.
+   */
+  static int BitWidth(uint64_t max_value);
+
+  uint64_t Get(int64_t idx) const {
+    if (bit_width_ == 0) {
+      return 0;
+    }
+    uint64_t bit_pos = static_cast<uint64_t>(idx) * bit_width_;
+    uint64_t word = bit_pos / 64;
+    uint64_t shift = bit_pos % 64;
+    uint64_t val = words_[word] >> shift;
+    if (shift + bit_width_ > 64) {
+      val |= words_[word + 1] << (64 - shift);
+    }
+    return bit_width_ == 64 ? val : val & ((uint64_t{1} << bit_width_) - 1);
+  }
+
+  int bit_width() const { return bit_width_; }
+  int64_t bytes() const { return words_.size() * sizeof(uint64_t); }
+
+ private:
+  int bit_width_ = 0;
+  std::vector<uint64_t> words_;
+};
+
+// Number of rows whose string bytes are compressed together by the kDeflate encoding, so that
+// reading a slice of the column only inflates the blocks it overlaps.
+constexpr int64_t kDeflateBlockRows = 256;
+
+struct ColdEncodingOptions {
+  // Whether to compress the value bytes of STRING columns that don't dictionary encode well.
+  bool deflate_strings = false;
+};
+
+/**
+ * ColdColumn holds a single column of a cold batch, either as the plain arrow array or in one of a
+ * few compressed encodings. Encoded columns are decoded back into arrow arrays only when a cursor
+ * reads them, and only for the rows it reads.
+ */
+class ColdColumn {
+ public:
+  enum class Encoding {
+    // The arrow array, as is.
+    kPlain,
+    // INT64 and TIME64NS: each value stored as its bit-packed difference from the minimum value.
+    kFrameOfReference,
+    // INT64, TIME64NS and UINT128: the value of each run of equal values and where the run ends.
+    kRunLength,
+    // STRING: the distinct values of the column and a bit-packed index into them for each row.
+    kDictionary,
+    // STRING: the value offsets as is, and the value bytes compressed with zlib in blocks of
+    // kDeflateBlockRows rows.
+    kDeflate,
+  };
+
+  // Implicit so that plain columns can be used wherever an arrow array is.
+  ColdColumn(std::shared_ptr<arrow::Array> arr);  // NOLINT(runtime/explicit)
+
+  /**
+   * Encode picks the smallest encoding of the array supported for its data type. Arrays with nulls
+   * are always kept plain.
+   */
+  static StatusOr<ColdColumn> Encode(types::DataType data_type, std::shared_ptr<arrow::Array> arr,
+                                     const ColdEncodingOptions& opts);
+
+  Encoding encoding() const { return encoding_; }
+  int64_t length() const { return length_; }
+
+  /**
+   * bytes returns the number of bytes held by the column in its current encoding.
+   */
+  int64_t bytes() const;
+
+  /**
+   * Int64At returns the value at the given row of an INT64 or TIME64NS column, without decoding
+   * the rest of the column.
+   */
+  int64_t Int64At(int64_t idx) const;
+
+  /**
+   * SearchGreaterThanOrEqual returns the index of the first value greater than or equal to val, or
+   * -1 if there is none. Only valid for sorted INT64 or TIME64NS columns.
+   */
+  int64_t SearchGreaterThanOrEqual(int64_t val) const;
+
+  /**
+   * SearchLessThanOrEqual returns the index of the last value less than or equal to val, or -1 if
+   * there is none. Only valid for sorted INT64 or TIME64NS columns.
+   */
+  int64_t SearchLessThanOrEqual(int64_t val) const;
+
+  /**
+   * Decode returns the given rows of the column as an arrow array. Plain columns are sliced without
+   * copying, other encodings allocate the decoded array from the given pool.
+   */
+  StatusOr<std::shared_ptr<arrow::Array>> Decode(int64_t offset, int64_t length,
+                                                 arrow::MemoryPool* pool) const;
+
+ private:
+  ColdColumn(types::DataType data_type, Encoding encoding, int64_t length)
+      : data_type_(data_type), encoding_(encoding), length_(length) {}
+
+  static std::optional<ColdColumn> EncodeFrameOfReference(types::DataType data_type,
+                                                          const arrow::Array* arr);
+  static std::optional<ColdColumn> EncodeRunLength(types::DataType data_type,
+                                                   const arrow::Array* arr);
+  static StatusOr<std::optional<ColdColumn>> EncodeDictionary(const arrow::Array* arr);
+  static StatusOr<std::optional<ColdColumn>> EncodeDeflate(const arrow::Array* arr);
+
+  int64_t RunIndex(int64_t idx) const;
+
+  template <types::DataType TDataType>
+  StatusOr<std::shared_ptr<arrow::Array>> DecodeInts(int64_t offset, int64_t length,
+                                                     arrow::MemoryPool* pool) const;
+  StatusOr<std::shared_ptr<arrow::Array>> DecodeDictionary(int64_t offset, int64_t length,
+                                                           arrow::MemoryPool* pool) const;
+  StatusOr<std::shared_ptr<arrow::Array>> DecodeDeflate(int64_t offset, int64_t length,
+                                                        arrow::MemoryPool* pool) const;
+
+  types::DataType data_type_ = types::DataType::DATA_TYPE_UNKNOWN;
+  Encoding encoding_ = Encoding::kPlain;
+  int64_t length_ = 0;
+
+  // kPlain: the column itself. kDictionary: the distinct values of the column.
+  std::shared_ptr<arrow::Array> array_;
+  // kFrameOfReference: the offset of each value from base_. kDictionary: the index of each value
+  // in array_.
+  BitPackedInts packed_;
+  int64_t base_ = 0;
+  // kRunLength: the value of each run (in run_values_ or run_values_128_ depending on the data
+  // type), and the index one past the last row of each run.
+  std::vector<int64_t> run_values_;
+  std::vector<absl::uint128> run_values_128_;
+  std::vector<int64_t> run_ends_;
+  // kDeflate: the offsets buffer of the string array, and its value bytes compressed per block.
+  std::shared_ptr<arrow::Buffer> value_offsets_;
+  std::vector<std::string> deflated_blocks_;
+};
+
+/**
+ * ColdBatch is a batch of the cold store, holding one ColdColumn per column of the table. The
+ * columns are shared, so that readers can keep decoding them after the batch is expired.
+ */
+class ColdBatch {
+ public:
+  ColdBatch() = default;
+  explicit ColdBatch(std::vector<ColdColumn> columns) {
+    for (auto& col : columns) {
+      columns_.push_back(std::make_shared<const ColdColumn>(std::move(col)));
+    }
+  }
+  // Implicit so that a batch of plain arrow arrays can be pushed into the cold store as is.
+  ColdBatch(const std::vector<std::shared_ptr<arrow::Array>>& arrays) {  // NOLINT
+    for (const auto& arr : arrays) {
+      columns_.push_back(std::make_shared<const ColdColumn>(arr));
+    }
+  }
+
+  size_t size() const { return columns_.size(); }
+  const ColdColumn& operator[](size_t idx) const { return *columns_[idx]; }
+  const std::shared_ptr<const ColdColumn>& shared_column(size_t idx) const {
+    return columns_[idx];
+  }
+
+  int64_t length() const { return columns_.empty() ? 0 : columns_[0]->length(); }
+
+  int64_t bytes() const {
+    int64_t bytes = 0;
+    for (const auto& col : columns_) {
+      bytes += col->bytes();
+    }
+    return bytes;
+  }
+
+ private:
+  std::vector<std::shared_ptr<const ColdColumn>> columns_;
+};
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
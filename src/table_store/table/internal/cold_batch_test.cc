@@ -0,0 +1,199 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/strings/str_cat.h>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/table/internal/cold_batch.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+using Encoding = ColdColumn::Encoding;
+
+// Checks that every slice of the encoded column decodes to the same values as the original array.
+void ExpectRoundTrip(const ColdColumn& col, const std::shared_ptr<arrow::Array>& arr) {
+  ASSERT_EQ(arr->length(), col.length());
+  for (int64_t offset : {int64_t{0}, int64_t{1}, arr->length() / 2, arr->length() - 1}) {
+    for (int64_t length : {int64_t{1}, arr->length() - offset}) {
+      ASSERT_OK_AND_ASSIGN(auto decoded, col.Decode(offset, length, arrow::default_memory_pool()));
+      EXPECT_TRUE(decoded->Equals(arr->Slice(offset, length)))
+          << "offset " << offset << " length " << length;
+    }
+  }
+}
+
+TEST(BitPackedIntsTest, get) {
+  for (int bit_width : {0, 1, 3, 13, 31, 63, 64}) {
+    std::vector<uint64_t> values;
+    for (uint64_t i = 0; i < 100; ++i) {
+      uint64_t val = i * 0x9E3779B97F4A7C15ULL;
+      values.push_back(bit_width == 64 ? val : val & ((uint64_t{1} << bit_width) - 1));
+    }
+    auto packed = BitPackedInts::Pack(values, bit_width);
+    EXPECT_EQ((100 * bit_width + 63) / 64 * 8, packed.bytes());
+    for (size_t i = 0; i < values.size(); ++i) {
+      EXPECT_EQ(values[i], packed.Get(i)) << "bit width " << bit_width << " index " << i;
+    }
+  }
+}
+
+TEST(BitPackedIntsTest, bit_width) {
+  EXPECT_EQ(0, BitPackedInts::BitWidth(0));
+  EXPECT_EQ(1, BitPackedInts::BitWidth(1));
+  EXPECT_EQ(8, BitPackedInts::BitWidth(255));
+  EXPECT_EQ(9, BitPackedInts::BitWidth(256));
+  EXPECT_EQ(64, BitPackedInts::BitWidth(~uint64_t{0}));
+}
+
+TEST(ColdColumnTest, frame_of_reference_times) {
+  std::vector<types::Time64NSValue> times;
+  for (int64_t i = 0; i < 1000; ++i) {
+    times.push_back(1700000000000000000LL + 37 * i);
+  }
+  auto arr = types::ToArrow(times, arrow::default_memory_pool());
+  ASSERT_OK_AND_ASSIGN(auto col, ColdColumn::Encode(types::DataType::TIME64NS, arr, {}));
+  EXPECT_EQ(Encoding::kFrameOfReference, col.encoding());
+  EXPECT_LT(col.bytes(), 1000 * static_cast<int64_t>(sizeof(int64_t)) / 3);
+  ExpectRoundTrip(col, arr);
+
+  EXPECT_EQ(1700000000000000000LL + 37 * 10, col.Int64At(10));
+  EXPECT_EQ(10, col.SearchGreaterThanOrEqual(1700000000000000000LL + 37 * 10));
+  EXPECT_EQ(11, col.SearchGreaterThanOrEqual(1700000000000000000LL + 37 * 10 + 1));
+  EXPECT_EQ(-1, col.SearchGreaterThanOrEqual(1800000000000000000LL));
+  EXPECT_EQ(10, col.SearchLessThanOrEqual(1700000000000000000LL + 37 * 11 - 1));
+  EXPECT_EQ(-1, col.SearchLessThanOrEqual(0));
+  EXPECT_EQ(999, col.SearchLessThanOrEqual(1800000000000000000LL));
+}
+
+TEST(ColdColumnTest, frame_of_reference_negative_ints) {
+  std::vector<types::Int64Value> ints;
+  for (int64_t i = 0; i < 100; ++i) {
+    ints.push_back(i % 2 == 0 ? -i : i);
+  }
+  auto arr = types::ToArrow(ints, arrow::default_memory_pool());
+  ASSERT_OK_AND_ASSIGN(auto col, ColdColumn::Encode(types::DataType::INT64, arr, {}));
+  EXPECT_EQ(Encoding::kFrameOfReference, col.encoding());
+  ExpectRoundTrip(col, arr);
+  EXPECT_EQ(-98, col.Int64At(98));
+}
+
+TEST(ColdColumnTest, run_length_ints) {
+  std::vector<types::Int64Value> ints;
+  for (int64_t i = 0; i < 1000; ++i) {
+    // Few long runs of values too far apart to frame of reference encode well.
+    ints.push_back((i / 100) * (int64_t{1} << 58));
+  }
+  auto arr = types::ToArrow(ints, arrow::default_memory_pool());
+  ASSERT_OK_AND_ASSIGN(auto col, ColdColumn::Encode(types::DataType::INT64, arr, {}));
+  EXPECT_EQ(Encoding::kRunLength, col.encoding());
+  ExpectRoundTrip(col, arr);
+  EXPECT_EQ(0, col.Int64At(99));
+  EXPECT_EQ(int64_t{1} << 58, col.Int64At(100));
+  EXPECT_EQ(100, col.SearchGreaterThanOrEqual(1));
+}
+
+TEST(ColdColumnTest, run_length_upids) {
+  std::vector<types::UInt128Value> upids;
+  for (int64_t i = 0; i < 1000; ++i) {
+    upids.push_back(types::UInt128Value(0xABCD0000 + i / 300, 123456789));
+  }
+  auto arr = types::ToArrow(upids, arrow::default_memory_pool());
+  ASSERT_OK_AND_ASSIGN(auto col, ColdColumn::Encode(types::DataType::UINT128, arr, {}));
+  EXPECT_EQ(Encoding::kRunLength, col.encoding());
+  EXPECT_LT(col.bytes(), 100);
+  ExpectRoundTrip(col, arr);
+}
+
+TEST(ColdColumnTest, dictionary_strings) {
+  std::vector<types::StringValue> strings;
+  for (int64_t i = 0; i < 1000; ++i) {
+    strings.push_back(absl::StrCat("/api/v1/some/long/endpoint/", i % 10));
+  }
+  auto arr = types::ToArrow(strings, arrow::default_memory_pool());
+  ASSERT_OK_AND_ASSIGN(auto col, ColdColumn::Encode(types::DataType::STRING, arr, {}));
+  EXPECT_EQ(Encoding::kDictionary, col.encoding());
+  EXPECT_LT(col.bytes(), 2000);
+  ExpectRoundTrip(col, arr);
+}
+
+TEST(ColdColumnTest, deflate_strings) {
+  std::vector<types::StringValue> strings;
+  for (int64_t i = 0; i < 1000; ++i) {
+    strings.push_back(absl::StrCat("{\"request_id\": ", i, ", \"status\": \"ok\"}"));
+  }
+  auto arr = types::ToArrow(strings, arrow::default_memory_pool());
+  // The round trips cover slices that start and end in different compressed blocks.
+  ASSERT_GT(arr->length(), 2 * kDeflateBlockRows);
+
+  // Unique strings don't dictionary encode, so they stay plain unless deflate is enabled.
+  ASSERT_OK_AND_ASSIGN(auto plain, ColdColumn::Encode(types::DataType::STRING, arr, {}));
+  EXPECT_EQ(Encoding::kPlain, plain.encoding());
+
+  ColdEncodingOptions opts;
+  opts.deflate_strings = true;
+  ASSERT_OK_AND_ASSIGN(auto col, ColdColumn::Encode(types::DataType::STRING, arr, opts));
+  EXPECT_EQ(Encoding::kDeflate, col.encoding());
+  EXPECT_LT(col.bytes(), plain.bytes());
+  ExpectRoundTrip(col, arr);
+}
+
+TEST(ColdColumnTest, plain_columns) {
+  // Floats have no encoding.
+  std::vector<types::Float64Value> floats = {1.5, 1.5, 1.5, 1.5};
+  auto float_arr = types::ToArrow(floats, arrow::default_memory_pool());
+  ASSERT_OK_AND_ASSIGN(auto float_col,
+                       ColdColumn::Encode(types::DataType::FLOAT64, float_arr, {}));
+  EXPECT_EQ(Encoding::kPlain, float_col.encoding());
+  ExpectRoundTrip(float_col, float_arr);
+
+  // Columns with nulls are kept plain.
+  arrow::Int64Builder builder;
+  for (int64_t i = 0; i < 100; ++i) {
+    ASSERT_TRUE(i == 50 ? builder.AppendNull().ok() : builder.Append(7).ok());
+  }
+  std::shared_ptr<arrow::Array> null_arr;
+  ASSERT_TRUE(builder.Finish(&null_arr).ok());
+  ASSERT_OK_AND_ASSIGN(auto null_col, ColdColumn::Encode(types::DataType::INT64, null_arr, {}));
+  EXPECT_EQ(Encoding::kPlain, null_col.encoding());
+  ExpectRoundTrip(null_col, null_arr);
+}
+
+TEST(ColdBatchTest, bytes) {
+  std::vector<types::Int64Value> ints(100, 42);
+  auto arr = types::ToArrow(ints, arrow::default_memory_pool());
+  ColdBatch plain(std::vector<std::shared_ptr<arrow::Array>>{arr});
+  EXPECT_EQ(100, plain.length());
+  EXPECT_GE(plain.bytes(), 100 * static_cast<int64_t>(sizeof(int64_t)));
+
+  ASSERT_OK_AND_ASSIGN(auto col, ColdColumn::Encode(types::DataType::INT64, arr, {}));
+  ColdBatch encoded(std::vector<ColdColumn>{col});
+  EXPECT_EQ(100, encoded.length());
+  EXPECT_EQ(col.bytes(), encoded.bytes());
+  EXPECT_LT(encoded.bytes(), plain.bytes());
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -53,6 +53,30 @@ void constexpr_else_static_assert_false() {
   static_assert(always_false, "constexpr else block reached");
 }
 
+/**
+ * ColdBatchSlice holds the columns of a cold batch that a cursor reads next, along with the rows to
+ * read. It shares the columns with the store, so it can be decoded without holding the table locks.
+ */
+struct ColdBatchSlice {
+  std::vector<types::DataType> col_types;
+  std::vector<std::shared_ptr<const ColdColumn>> columns;
+  size_t row_offset = 0;
+  size_t batch_size = 0;
+
+  /**
+   * Decode returns the rows of the slice as a row batch, allocating decoded columns from the pool.
+   */
+  StatusOr<std::unique_ptr<schema::RowBatch>> Decode(arrow::MemoryPool* pool) const {
+    auto output_rb =
+        std::make_unique<schema::RowBatch>(schema::RowDescriptor(col_types), batch_size);
+    for (const auto& col : columns) {
+      PX_ASSIGN_OR_RETURN(auto arr, col->Decode(row_offset, batch_size, pool));
+      PX_RETURN_IF_ERROR(output_rb->AddColumn(arr));
+    }
+    return output_rb;
+  }
+};
+
 /**
  * StoreWithRowTimeAccounting stores a deque of batches (hot or cold) and keeps track of the first
  * and last unique RowID's for each batch, as well as the first and last times for each batch (if
@@ -93,50 +117,76 @@ class StoreWithRowTimeAccounting {
   StatusOr<std::unique_ptr<schema::RowBatch>> GetNextRowBatch(
       RowID* last_read_row_id, BatchHints* hints, std::optional<RowID> stop_row_id,
       const std::vector<int64_t>& cols) const {
-    auto start_row_id = *last_read_row_id + 1;
-    if (batches_.empty() || start_row_id < FirstRowID() || start_row_id > LastRowID()) {
+    auto slice = NextSlice(last_read_row_id, hints, stop_row_id);
+    if (!slice.has_value()) {
       return std::unique_ptr<schema::RowBatch>(nullptr);
     }
-    if (DCHECK_IS_ON() && stop_row_id.has_value()) {
-      DCHECK_LT(start_row_id, stop_row_id.value());
-    }
+    auto output_rb = std::make_unique<schema::RowBatch>(schema::RowDescriptor(ColTypes(cols)),
+                                                        slice->batch_size);
+    PX_RETURN_IF_ERROR(AddBatchSliceToRowBatch(GetBatchFromBatchID(slice->batch_id),
+                                               slice->row_offset, slice->batch_size, cols,
+                                               output_rb.get()));
+    return output_rb;
+  }
 
-    BatchID batch_id;
-    if (hints != nullptr && BatchHintValid(*hints, start_row_id)) {
-      batch_id = hints->batch_id;
-    } else {
-      batch_id = FindBatchIDFromRowID(start_row_id);
+  /**
+   * GetNextColdBatchSlice is the same as GetNextRowBatch, except that it returns the columns to
+   * decode instead of decoding them, so that the caller can decode them after releasing its locks.
+   * Only valid for the cold store.
+   * @return the slice to decode, or std::nullopt if there are no more rows in this store that
+   * match the parameters.
+   */
+  std::optional<ColdBatchSlice> GetNextColdBatchSlice(RowID* last_read_row_id, BatchHints* hints,
+                                                      std::optional<RowID> stop_row_id,
+                                                      const std::vector<int64_t>& cols) const {
+    static_assert(std::is_same_v<TBatch, ColdBatch>, "Only the cold store holds cold batches");
+    auto slice = NextSlice(last_read_row_id, hints, stop_row_id);
+    if (!slice.has_value()) {
+      return std::nullopt;
     }
-
-    const auto& batch = GetBatchFromBatchID(batch_id);
-    RowID batch_first_row_id = BatchFirstRowID(batch_id);
-    RowID batch_last_row_id = BatchLastRowID(batch_id);
-    size_t row_offset = start_row_id - batch_first_row_id;
-    size_t batch_size = batch_last_row_id - start_row_id + 1;
-    if (stop_row_id.has_value() && batch_last_row_id >= stop_row_id.value()) {
-      // Reduce batch size if the batch extends past the given stop row.
-      batch_size -= (batch_last_row_id - stop_row_id.value()) + 1;
+    const auto& batch = GetBatchFromBatchID(slice->batch_id);
+    ColdBatchSlice cold_slice;
+    cold_slice.col_types = ColTypes(cols);
+    for (auto col_idx : cols) {
+      cold_slice.columns.push_back(batch.shared_column(col_idx));
     }
+    cold_slice.row_offset = slice->row_offset;
+    cold_slice.batch_size = slice->batch_size;
+    return cold_slice;
+  }
 
-    // Get column types for row descriptor.
-    std::vector<types::DataType> col_types;
-    for (int64_t col_idx : cols) {
-      DCHECK(static_cast<size_t>(col_idx) < rel_.NumColumns());
-      col_types.push_back(rel_.col_types()[col_idx]);
+  /**
+   * SkipBatches advances the given last read RowID past the batches that `skip_batch` rejects,
+   * starting at the batch that holds the next row to read and stopping at the first batch that
+   * isn't rejected.
+   * @param last_read_row_id, pointer to the unique RowID of the last read row, updated to the last
+   * RowID of the last skipped batch.
+   * @param stop_row_id, an optional unique RowID that skipping never moves past.
+   * @param skip_batch, callable taking the index of a batch from the front of the store, returning
+   * true if the batch should be skipped.
+   * @return the number of batches skipped.
+   */
+  template <typename TSkipFn>
+  size_t SkipBatches(RowID* last_read_row_id, std::optional<RowID> stop_row_id,
+                     TSkipFn skip_batch) const {
+    auto start_row_id = *last_read_row_id + 1;
+    if (batches_.empty() || start_row_id < FirstRowID() || start_row_id > LastRowID()) {
+      return 0;
     }
-    auto output_rb =
-        std::make_unique<schema::RowBatch>(schema::RowDescriptor(col_types), batch_size);
-    PX_RETURN_IF_ERROR(
-        AddBatchSliceToRowBatch(batch, row_offset, batch_size, cols, output_rb.get()));
-
-    // Update the ptr to the last read row.
-    *last_read_row_id = start_row_id + batch_size - 1;
-
-    // Set hints to point to the next batch in the current store. It's fine if that batch doesn't
-    // exist, as the next call will ignore the hints if that's the case.
-    hints->batch_id = batch_id + 1;
-    hints->hint_type = TStoreType;
-    return output_rb;
+    size_t num_skipped = 0;
+    for (BatchID batch_id = FindBatchIDFromRowID(start_row_id); batch_id <= LastBatchID();
+         ++batch_id) {
+      if (!skip_batch(static_cast<size_t>(batch_id - first_batch_id_))) {
+        break;
+      }
+      ++num_skipped;
+      if (stop_row_id.has_value() && BatchLastRowID(batch_id) >= stop_row_id.value()) {
+        *last_read_row_id = stop_row_id.value() - 1;
+        break;
+      }
+      *last_read_row_id = BatchLastRowID(batch_id);
+    }
+    return num_skipped;
   }
 
   /**
@@ -323,6 +373,59 @@ class StoreWithRowTimeAccounting {
     return batches_[batch_id - first_batch_id_];
   }
 
+  struct Slice {
+    BatchID batch_id;
+    size_t row_offset;
+    size_t batch_size;
+  };
+
+  // Finds the rows to read after last_read_row_id, and advances last_read_row_id and the hints
+  // past them.
+  std::optional<Slice> NextSlice(RowID* last_read_row_id, BatchHints* hints,
+                                 std::optional<RowID> stop_row_id) const {
+    auto start_row_id = *last_read_row_id + 1;
+    if (batches_.empty() || start_row_id < FirstRowID() || start_row_id > LastRowID()) {
+      return std::nullopt;
+    }
+    if (DCHECK_IS_ON() && stop_row_id.has_value()) {
+      DCHECK_LT(start_row_id, stop_row_id.value());
+    }
+
+    BatchID batch_id;
+    if (hints != nullptr && BatchHintValid(*hints, start_row_id)) {
+      batch_id = hints->batch_id;
+    } else {
+      batch_id = FindBatchIDFromRowID(start_row_id);
+    }
+
+    RowID batch_first_row_id = BatchFirstRowID(batch_id);
+    RowID batch_last_row_id = BatchLastRowID(batch_id);
+    size_t row_offset = start_row_id - batch_first_row_id;
+    size_t batch_size = batch_last_row_id - start_row_id + 1;
+    if (stop_row_id.has_value() && batch_last_row_id >= stop_row_id.value()) {
+      // Reduce batch size if the batch extends past the given stop row.
+      batch_size -= (batch_last_row_id - stop_row_id.value()) + 1;
+    }
+
+    // Update the ptr to the last read row.
+    *last_read_row_id = start_row_id + batch_size - 1;
+
+    // Set hints to point to the next batch in the current store. It's fine if that batch doesn't
+    // exist, as the next call will ignore the hints if that's the case.
+    hints->batch_id = batch_id + 1;
+    hints->hint_type = TStoreType;
+    return Slice{batch_id, row_offset, batch_size};
+  }
+
+  std::vector<types::DataType> ColTypes(const std::vector<int64_t>& cols) const {
+    std::vector<types::DataType> col_types;
+    for (int64_t col_idx : cols) {
+      DCHECK(static_cast<size_t>(col_idx) < rel_.NumColumns());
+      col_types.push_back(rel_.col_types()[col_idx]);
+    }
+    return col_types;
+  }
+
   bool BatchHintValid(const BatchHints& hints, RowID row_id) const {
     if (hints.hint_type != TStoreType) {
       return false;
@@ -342,7 +445,7 @@ class StoreWithRowTimeAccounting {
 
   size_t BatchLength(const TBatch& batch) const {
     if constexpr (std::is_same_v<ColdBatch, TBatch>) {
-      return batch[0]->length();
+      return batch.length();
     } else if constexpr (std::is_same_v<HotBatch, TBatch>) {
       return batch.Length();
     } else {
@@ -352,8 +455,7 @@ class StoreWithRowTimeAccounting {
 
   size_t FindTimeFirstGreaterThanOrEqual(const TBatch& batch, Time time) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
-      return types::SearchArrowArrayGreaterThanOrEqual<types::DataType::TIME64NS>(
-          batch[time_col_idx_].get(), time);
+      return batch[time_col_idx_].SearchGreaterThanOrEqual(time);
     } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
       return batch.FindTimeFirstGreaterThanOrEqual(time_col_idx_, time);
     } else {
@@ -363,9 +465,7 @@ class StoreWithRowTimeAccounting {
 
   size_t FindTimeFirstGreaterThan(const TBatch& batch, Time time) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
-      return types::SearchArrowArrayLessThanOrEqual<types::DataType::TIME64NS>(
-                 batch[time_col_idx_].get(), time) +
-             1;
+      return batch[time_col_idx_].SearchLessThanOrEqual(time) + 1;
     } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
       return batch.FindTimeFirstGreaterThan(time_col_idx_, time);
     } else {
@@ -375,8 +475,7 @@ class StoreWithRowTimeAccounting {
 
   Time GetTimeValue(const TBatch& batch, int64_t row_idx) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
-      return types::GetValueFromArrowArray<types::DataType::TIME64NS>(batch[time_col_idx_].get(),
-                                                                      row_idx);
+      return batch[time_col_idx_].Int64At(row_idx);
     } else if constexpr (std::is_same_v<TBatch, HotBatch>) {
       return batch.GetTimeValue(time_col_idx_, row_idx);
     } else {
@@ -389,7 +488,9 @@ class StoreWithRowTimeAccounting {
                                  schema::RowBatch* output_rb) const {
     if constexpr (std::is_same_v<TBatch, ColdBatch>) {
       for (auto col_idx : cols) {
-        auto arr = batch[col_idx]->Slice(row_offset, batch_size);
+        // Only the columns being read are decoded.
+        PX_ASSIGN_OR_RETURN(auto arr, batch[col_idx].Decode(row_offset, batch_size,
+                                                            arrow::default_memory_pool()));
         PX_RETURN_IF_ERROR(output_rb->AddColumn(arr));
       }
       return Status::OK();
@@ -124,6 +124,58 @@ TEST_F(ColdStoreTest, PushRowBatchesCheckProperties) {
   EXPECT_EQ(4, optional_row_id.value());
 }
 
+TEST_F(ColdStoreTest, SkipBatches) {
+  // Three batches of three rows each, with RowIDs [0, 2], [3, 5] and [6, 8].
+  for (int64_t i = 0; i < 3; ++i) {
+    auto rb = MakeRowBatch({3 * i, 3 * i + 1, 3 * i + 2}, {true, false, true}, {"a", "b", "c"});
+    store_->EmplaceBack(3 * i, rb.columns());
+  }
+  std::vector<size_t> visited;
+  auto skip_first_two = [&visited](size_t batch_idx) {
+    visited.push_back(batch_idx);
+    return batch_idx < 2;
+  };
+
+  RowID last_read_row_id = 0;
+  EXPECT_EQ(2, store_->SkipBatches(&last_read_row_id, std::nullopt, skip_first_two));
+  EXPECT_EQ(5, last_read_row_id);
+  EXPECT_THAT(visited, ::testing::ElementsAre(0, 1, 2));
+
+  // Skipping stops at the stop row.
+  visited.clear();
+  last_read_row_id = -1;
+  EXPECT_EQ(2, store_->SkipBatches(&last_read_row_id, 4, skip_first_two));
+  EXPECT_EQ(3, last_read_row_id);
+  EXPECT_THAT(visited, ::testing::ElementsAre(0, 1));
+
+  // Nothing to skip past the end of the store.
+  last_read_row_id = 8;
+  EXPECT_EQ(0, store_->SkipBatches(&last_read_row_id, std::nullopt, skip_first_two));
+  EXPECT_EQ(8, last_read_row_id);
+}
+
+TEST_F(ColdStoreTest, ColdBatchSliceOutlivesBatch) {
+  auto rb = MakeRowBatch({1, 2, 3}, {true, false, true}, {"a", "b", "c"});
+  store_->EmplaceBack(0, rb.columns());
+
+  RowID last_read_row_id = 0;
+  BatchHints hints = {};
+  auto slice = store_->GetNextColdBatchSlice(&last_read_row_id, &hints, std::nullopt, {2, 0});
+  ASSERT_TRUE(slice.has_value());
+  EXPECT_EQ(2, last_read_row_id);
+
+  // The slice keeps the columns alive after the batch is expired from the store.
+  store_->PopFront();
+  ASSERT_OK_AND_ASSIGN(auto out, slice->Decode(arrow::default_memory_pool()));
+  ASSERT_EQ(2, out->num_columns());
+  EXPECT_EQ(2, out->num_rows());
+  EXPECT_TRUE(out->ColumnAt(0)->Equals(rb.ColumnAt(2)->Slice(1)));
+  EXPECT_TRUE(out->ColumnAt(1)->Equals(rb.ColumnAt(0)->Slice(1)));
+
+  EXPECT_FALSE(
+      store_->GetNextColdBatchSlice(&last_read_row_id, &hints, std::nullopt, {0}).has_value());
+}
+
 TEST_P(HotStoreTest, PushRowBatchesCheckProperties) {
   std::vector<types::Time64NSValue> times = {1, 1, 10, 11};
   std::vector<types::BoolValue> bools = {true, false, true, false};
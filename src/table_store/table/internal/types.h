@@ -29,6 +29,7 @@
 #include "src/shared/types/column_wrapper.h"
 #include "src/shared/types/types.h"
 #include "src/table_store/schema/row_batch.h"
+#include "src/table_store/table/internal/cold_batch.h"
 
 namespace px {
 namespace table_store {
@@ -62,8 +63,6 @@ struct BatchHints {
 
 class RecordOrRowBatch;
 
-using ColdBatch = std::vector<ArrowArrayPtr>;
-
 template <StoreType type>
 struct StoreTypeTraits {};
 template <>
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include "src/table_store/table/internal/zone_map.h"
+
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "src/shared/types/arrow_adapter.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+namespace {
+
+constexpr double kStringBloomFilterErrorRate = 0.01;
+
+template <typename T>
+bool IsNaN(const T& val) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::isnan(val);
+  } else {
+    return false;
+  }
+}
+
+template <types::DataType TDataType, typename TZoneType>
+void ComputeMinMax(const arrow::Array* arr, ColumnZoneMap* zone_map) {
+  if (zone_map->null_count > 0 || arr->length() == 0) {
+    return;
+  }
+  TZoneType min = types::GetValueFromArrowArray<TDataType>(arr, 0);
+  TZoneType max = min;
+  for (int64_t i = 0; i < arr->length(); ++i) {
+    TZoneType val = types::GetValueFromArrowArray<TDataType>(arr, i);
+    if (IsNaN(val)) {
+      return;
+    }
+    if (val < min) min = val;
+    if (max < val) max = val;
+  }
+  zone_map->min = min;
+  zone_map->max = max;
+}
+
+// Returns the shortest string of at most kZoneMapMaxStringBytes that is at least val, or nullopt if
+// there is none, i.e. if the prefix is only made of 0xff bytes.
+std::optional<std::string> StringUpperBound(std::string_view val) {
+  if (val.size() <= kZoneMapMaxStringBytes) {
+    return std::string(val);
+  }
+  std::string bound(val.substr(0, kZoneMapMaxStringBytes));
+  while (!bound.empty()) {
+    auto c = static_cast<unsigned char>(bound.back());
+    if (c != 0xff) {
+      bound.back() = static_cast<char>(c + 1);
+      return bound;
+    }
+    bound.pop_back();
+  }
+  return std::nullopt;
+}
+
+Status ComputeStringZoneMap(const arrow::Array* arr, bool bloom_filter, ColumnZoneMap* zone_map) {
+  if (arr->length() == 0) {
+    return Status::OK();
+  }
+  if (bloom_filter) {
+    PX_ASSIGN_OR_RETURN(zone_map->bloom_filter, bloomfilter::XXHash64BloomFilter::Create(
+                                                    arr->length(), kStringBloomFilterErrorRate));
+  }
+  std::string_view min;
+  std::string_view max;
+  bool has_value = false;
+  for (int64_t i = 0; i < arr->length(); ++i) {
+    if (arr->IsNull(i)) {
+      continue;
+    }
+    auto val = types::GetStringViewFromArrowArray(arr, i);
+    if (zone_map->bloom_filter != nullptr) {
+      zone_map->bloom_filter->Insert(val);
+    }
+    if (!has_value || val < min) min = val;
+    if (!has_value || max < val) max = val;
+    has_value = true;
+  }
+  if (zone_map->null_count > 0) {
+    return Status::OK();
+  }
+  // A prefix of the min is still a lower bound, but the max needs to be rounded up.
+  auto max_bound = StringUpperBound(max);
+  if (!max_bound.has_value()) {
+    return Status::OK();
+  }
+  zone_map->min = std::string(min.substr(0, kZoneMapMaxStringBytes));
+  zone_map->max = std::move(*max_bound);
+  zone_map->min_max_truncated =
+      min.size() > kZoneMapMaxStringBytes || max.size() > kZoneMapMaxStringBytes;
+  return Status::OK();
+}
+
+bool ColumnMayMatch(const ColumnZoneMap& zone_map, const ColumnPredicate& pred) {
+  const auto& val = pred.value;
+  if (std::holds_alternative<std::monostate>(zone_map.min) || val.index() != zone_map.min.index()) {
+    return true;
+  }
+  switch (pred.op) {
+    case ColumnPredicate::Op::kEqual:
+      if (val < zone_map.min || zone_map.max < val) {
+        return false;
+      }
+      if (zone_map.bloom_filter != nullptr) {
+        return zone_map.bloom_filter->Contains(std::get<std::string>(val));
+      }
+      return true;
+    case ColumnPredicate::Op::kNotEqual:
+      return zone_map.min_max_truncated || !(zone_map.min == val && zone_map.max == val);
+    case ColumnPredicate::Op::kLessThan:
+      return zone_map.min < val;
+    case ColumnPredicate::Op::kLessThanEqual:
+      return zone_map.min <= val;
+    case ColumnPredicate::Op::kGreaterThan:
+      return val < zone_map.max;
+    case ColumnPredicate::Op::kGreaterThanEqual:
+      return val <= zone_map.max;
+  }
+  // This return is not necessary but GCC complains without it.
+  return true;
+}
+
+}  // namespace
+
+StatusOr<BatchZoneMap> BuildBatchZoneMap(const schema::Relation& rel,
+                                         const std::vector<ArrowArrayPtr>& batch,
+                                         bool string_bloom_filters) {
+  DCHECK_EQ(rel.NumColumns(), batch.size());
+  BatchZoneMap zone_map(batch.size());
+  for (size_t col_idx = 0; col_idx < batch.size(); ++col_idx) {
+    const arrow::Array* arr = batch[col_idx].get();
+    auto* col_zone_map = &zone_map[col_idx];
+    col_zone_map->num_rows = arr->length();
+    col_zone_map->null_count = arr->null_count();
+    switch (rel.GetColumnType(col_idx)) {
+      case types::DataType::BOOLEAN:
+        ComputeMinMax<types::DataType::BOOLEAN, int64_t>(arr, col_zone_map);
+        break;
+      case types::DataType::INT64:
+        ComputeMinMax<types::DataType::INT64, int64_t>(arr, col_zone_map);
+        break;
+      case types::DataType::TIME64NS:
+        ComputeMinMax<types::DataType::TIME64NS, int64_t>(arr, col_zone_map);
+        break;
+      case types::DataType::FLOAT64:
+        ComputeMinMax<types::DataType::FLOAT64, double>(arr, col_zone_map);
+        break;
+      case types::DataType::UINT128:
+        ComputeMinMax<types::DataType::UINT128, absl::uint128>(arr, col_zone_map);
+        break;
+      case types::DataType::STRING:
+        PX_RETURN_IF_ERROR(ComputeStringZoneMap(arr, string_bloom_filters, col_zone_map));
+        break;
+      default:
+        break;
+    }
+  }
+  return zone_map;
+}
+
+int64_t BatchZoneMapBytes(const BatchZoneMap& zone_map) {
+  int64_t bytes = zone_map.size() * sizeof(ColumnZoneMap);
+  for (const auto& col_zone_map : zone_map) {
+    for (const auto* val : {&col_zone_map.min, &col_zone_map.max}) {
+      if (const auto* str = std::get_if<std::string>(val)) {
+        bytes += str->capacity();
+      }
+    }
+    if (col_zone_map.bloom_filter != nullptr) {
+      bytes += sizeof(*col_zone_map.bloom_filter) + col_zone_map.bloom_filter->buffer_size_bytes();
+    }
+  }
+  return bytes;
+}
+
+bool BatchMayMatch(const BatchZoneMap& zone_map, const std::vector<ColumnPredicate>& predicates) {
+  for (const auto& pred : predicates) {
+    if (pred.col_idx < 0 || static_cast<size_t>(pred.col_idx) >= zone_map.size()) {
+      continue;
+    }
+    if (!ColumnMayMatch(zone_map[pred.col_idx], pred)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <absl/numeric/int128.h>
+
+#include "src/common/base/base.h"
+#include "src/shared/bloomfilter/bloomfilter.h"
+#include "src/shared/types/types.h"
+#include "src/table_store/schema/relation.h"
+#include "src/table_store/table/internal/types.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+/**
+ * ZoneValue holds a single value of a column in the representation used for zone map comparisons.
+ * BOOLEAN, INT64 and TIME64NS values are all held as int64_t. std::monostate means no value.
+ */
+using ZoneValue = std::variant<std::monostate, int64_t, double, absl::uint128, std::string>;
+
+/**
+ * ColumnPredicate is a comparison between a column of the table and a constant, of the form
+ * `column <op> value`.
+ */
+struct ColumnPredicate {
+  enum class Op {
+    kEqual,
+    kNotEqual,
+    kLessThan,
+    kLessThanEqual,
+    kGreaterThan,
+    kGreaterThanEqual,
+  };
+  // Index of the column in the table relation.
+  int64_t col_idx = -1;
+  Op op = Op::kEqual;
+  ZoneValue value;
+};
+
+// The longest STRING min/max kept in a zone map. Longer values are cut to a prefix, so that a batch
+// of long strings (e.g. request bodies) doesn't keep copies of them around.
+constexpr size_t kZoneMapMaxStringBytes = 64;
+
+/**
+ * ColumnZoneMap summarizes the values of one column of a batch. It is only used to prove that no
+ * row of the batch can match a predicate, so every field is allowed to be conservative.
+ */
+struct ColumnZoneMap {
+  int64_t num_rows = 0;
+  int64_t null_count = 0;
+  // Unset (std::monostate) if the column contains a null or NaN value, since a comparison against
+  // those doesn't follow the ordering of the other values.
+  ZoneValue min;
+  ZoneValue max;
+  // Whether the STRING min/max were cut to kZoneMapMaxStringBytes, in which case they are only
+  // bounds of the values rather than values of the column.
+  bool min_max_truncated = false;
+  // Only built for STRING columns, and only if requested when building the zone map.
+  std::unique_ptr<bloomfilter::XXHash64BloomFilter> bloom_filter;
+};
+
+using BatchZoneMap = std::vector<ColumnZoneMap>;
+
+/**
+ * BuildBatchZoneMap computes the zone map of each column of a cold batch.
+ * @param rel, the relation of the table the batch belongs to.
+ * @param batch, the columns of the cold batch to summarize, before they are encoded.
+ * @param string_bloom_filters, whether to build a bloom filter for each STRING column.
+ * @return the zone maps of the batch, in the same order as the columns of the relation.
+ */
+StatusOr<BatchZoneMap> BuildBatchZoneMap(const schema::Relation& rel,
+                                         const std::vector<ArrowArrayPtr>& batch,
+                                         bool string_bloom_filters);
+
+/**
+ * BatchZoneMapBytes returns the memory used by the zone maps of a batch.
+ */
+int64_t BatchZoneMapBytes(const BatchZoneMap& zone_map);
+
+/**
+ * BatchMayMatch returns false only if the zone map proves that no row of the batch satisfies all
+ * the given predicates. Predicates whose value type doesn't match the zone map of their column are
+ * ignored.
+ */
+bool BatchMayMatch(const BatchZoneMap& zone_map, const std::vector<ColumnPredicate>& predicates);
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2018- The Pixie Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#include <string>
+#include <vector>
+
+#include <absl/strings/str_cat.h>
+
+#include "src/common/testing/testing.h"
+#include "src/shared/types/arrow_adapter.h"
+#include "src/table_store/schema/relation.h"
+#include "src/table_store/table/internal/zone_map.h"
+
+namespace px {
+namespace table_store {
+namespace internal {
+
+using Op = ColumnPredicate::Op;
+
+class ZoneMapTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    rel_ = schema::Relation(
+        std::vector<types::DataType>{types::DataType::TIME64NS, types::DataType::INT64,
+                                     types::DataType::FLOAT64, types::DataType::STRING},
+        std::vector<std::string>{"time_", "status", "latency", "path"});
+    std::vector<types::Time64NSValue> times = {10, 11, 12, 13};
+    std::vector<types::Int64Value> status = {200, 404, 200, 302};
+    std::vector<types::Float64Value> latency = {1.5, 0.5, 2.5, 3.0};
+    std::vector<types::StringValue> path = {"/b", "/c", "/b", "/d"};
+    batch_ = std::vector<ArrowArrayPtr>{
+        types::ToArrow(times, arrow::default_memory_pool()),
+        types::ToArrow(status, arrow::default_memory_pool()),
+        types::ToArrow(latency, arrow::default_memory_pool()),
+        types::ToArrow(path, arrow::default_memory_pool()),
+    };
+  }
+
+  schema::Relation rel_;
+  std::vector<ArrowArrayPtr> batch_;
+};
+
+TEST_F(ZoneMapTest, min_max) {
+  ASSERT_OK_AND_ASSIGN(auto zone_map,
+                       BuildBatchZoneMap(rel_, batch_, /* string_bloom_filters */ false));
+  ASSERT_EQ(4, zone_map.size());
+  EXPECT_EQ(ZoneValue(int64_t{10}), zone_map[0].min);
+  EXPECT_EQ(ZoneValue(int64_t{13}), zone_map[0].max);
+  EXPECT_EQ(ZoneValue(int64_t{200}), zone_map[1].min);
+  EXPECT_EQ(ZoneValue(int64_t{404}), zone_map[1].max);
+  EXPECT_EQ(ZoneValue(0.5), zone_map[2].min);
+  EXPECT_EQ(ZoneValue(3.0), zone_map[2].max);
+  EXPECT_EQ(ZoneValue(std::string("/b")), zone_map[3].min);
+  EXPECT_EQ(ZoneValue(std::string("/d")), zone_map[3].max);
+  EXPECT_EQ(0, zone_map[1].null_count);
+  EXPECT_EQ(4, zone_map[1].num_rows);
+  EXPECT_EQ(nullptr, zone_map[3].bloom_filter);
+}
+
+TEST_F(ZoneMapTest, range_predicates) {
+  ASSERT_OK_AND_ASSIGN(auto zone_map,
+                       BuildBatchZoneMap(rel_, batch_, /* string_bloom_filters */ false));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{1, Op::kGreaterThanEqual, int64_t{404}}}));
+  EXPECT_FALSE(BatchMayMatch(zone_map, {{1, Op::kGreaterThanEqual, int64_t{500}}}));
+  EXPECT_FALSE(BatchMayMatch(zone_map, {{1, Op::kGreaterThan, int64_t{404}}}));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{1, Op::kLessThanEqual, int64_t{200}}}));
+  EXPECT_FALSE(BatchMayMatch(zone_map, {{1, Op::kLessThan, int64_t{200}}}));
+  EXPECT_FALSE(BatchMayMatch(zone_map, {{2, Op::kGreaterThan, 3.0}}));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{2, Op::kGreaterThan, 2.9}}));
+  EXPECT_FALSE(BatchMayMatch(zone_map, {{3, Op::kEqual, std::string("/a")}}));
+  EXPECT_FALSE(BatchMayMatch(zone_map, {{3, Op::kEqual, std::string("/e")}}));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{3, Op::kNotEqual, std::string("/b")}}));
+}
+
+TEST_F(ZoneMapTest, conjunction) {
+  ASSERT_OK_AND_ASSIGN(auto zone_map,
+                       BuildBatchZoneMap(rel_, batch_, /* string_bloom_filters */ false));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {}));
+  EXPECT_FALSE(BatchMayMatch(zone_map, {{1, Op::kEqual, int64_t{200}},
+                                        {2, Op::kLessThan, 0.1}}));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{1, Op::kEqual, int64_t{200}},
+                                       {2, Op::kLessThan, 1.0}}));
+}
+
+TEST_F(ZoneMapTest, mismatched_types_are_ignored) {
+  ASSERT_OK_AND_ASSIGN(auto zone_map,
+                       BuildBatchZoneMap(rel_, batch_, /* string_bloom_filters */ false));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{1, Op::kGreaterThan, 1000.0}}));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{10, Op::kGreaterThan, int64_t{1000}}}));
+}
+
+TEST_F(ZoneMapTest, not_equal_single_value) {
+  std::vector<types::Int64Value> status = {200, 200, 200};
+  std::vector<ArrowArrayPtr> batch{types::ToArrow(status, arrow::default_memory_pool())};
+  schema::Relation rel({types::DataType::INT64}, {"status"});
+  ASSERT_OK_AND_ASSIGN(auto zone_map, BuildBatchZoneMap(rel, batch, false));
+  EXPECT_FALSE(BatchMayMatch(zone_map, {{0, Op::kNotEqual, int64_t{200}}}));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{0, Op::kNotEqual, int64_t{404}}}));
+}
+
+TEST_F(ZoneMapTest, string_bloom_filter) {
+  ASSERT_OK_AND_ASSIGN(auto zone_map,
+                       BuildBatchZoneMap(rel_, batch_, /* string_bloom_filters */ true));
+  ASSERT_NE(nullptr, zone_map[3].bloom_filter);
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{3, Op::kEqual, std::string("/b")}}));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{3, Op::kEqual, std::string("/d")}}));
+  // These paths are all within [min, max], so only the bloom filter can rule them out. Allow for
+  // the bloom filter's false positives.
+  int num_skipped = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (!BatchMayMatch(zone_map, {{3, Op::kEqual, absl::StrCat("/b", i)}})) {
+      ++num_skipped;
+    }
+  }
+  EXPECT_GE(num_skipped, 90);
+}
+
+TEST_F(ZoneMapTest, long_strings_are_truncated) {
+  std::string prefix(100, 'a');
+  std::vector<types::StringValue> bodies = {prefix + "x", prefix + "y"};
+  std::vector<ArrowArrayPtr> batch{types::ToArrow(bodies, arrow::default_memory_pool())};
+  schema::Relation rel({types::DataType::STRING}, {"body"});
+  ASSERT_OK_AND_ASSIGN(auto zone_map, BuildBatchZoneMap(rel, batch, false));
+  EXPECT_TRUE(zone_map[0].min_max_truncated);
+  EXPECT_EQ(ZoneValue(std::string(kZoneMapMaxStringBytes, 'a')), zone_map[0].min);
+  // The max is rounded up so that it is still an upper bound of the values.
+  EXPECT_EQ(ZoneValue(std::string(kZoneMapMaxStringBytes - 1, 'a') + "b"), zone_map[0].max);
+
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{0, Op::kEqual, prefix + "x"}}));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{0, Op::kEqual, prefix + "z"}}));
+  EXPECT_FALSE(BatchMayMatch(zone_map, {{0, Op::kEqual, std::string("b")}}));
+  EXPECT_FALSE(BatchMayMatch(zone_map, {{0, Op::kLessThan, std::string("a")}}));
+  // The truncated bounds don't tell whether all the values are equal.
+  EXPECT_TRUE(
+      BatchMayMatch(zone_map, {{0, Op::kNotEqual, std::string(kZoneMapMaxStringBytes, 'a')}}));
+}
+
+TEST_F(ZoneMapTest, string_without_upper_bound) {
+  std::vector<types::StringValue> bodies = {"a", std::string(100, '\xff')};
+  std::vector<ArrowArrayPtr> batch{types::ToArrow(bodies, arrow::default_memory_pool())};
+  schema::Relation rel({types::DataType::STRING}, {"body"});
+  ASSERT_OK_AND_ASSIGN(auto zone_map, BuildBatchZoneMap(rel, batch, false));
+  EXPECT_TRUE(std::holds_alternative<std::monostate>(zone_map[0].min));
+  EXPECT_TRUE(std::holds_alternative<std::monostate>(zone_map[0].max));
+}
+
+TEST_F(ZoneMapTest, bytes) {
+  ASSERT_OK_AND_ASSIGN(auto zone_map, BuildBatchZoneMap(rel_, batch_, false));
+  int64_t bytes = BatchZoneMapBytes(zone_map);
+  EXPECT_GE(bytes, static_cast<int64_t>(4 * sizeof(ColumnZoneMap)));
+
+  ASSERT_OK_AND_ASSIGN(auto zone_map_with_bloom_filters, BuildBatchZoneMap(rel_, batch_, true));
+  EXPECT_GE(BatchZoneMapBytes(zone_map_with_bloom_filters),
+            bytes + static_cast<int64_t>(
+                        zone_map_with_bloom_filters[3].bloom_filter->buffer_size_bytes()));
+}
+
+TEST_F(ZoneMapTest, nan_disables_min_max) {
+  std::vector<types::Float64Value> latency = {1.0, std::nan(""), 2.0};
+  std::vector<ArrowArrayPtr> batch{types::ToArrow(latency, arrow::default_memory_pool())};
+  schema::Relation rel({types::DataType::FLOAT64}, {"latency"});
+  ASSERT_OK_AND_ASSIGN(auto zone_map, BuildBatchZoneMap(rel, batch, false));
+  EXPECT_TRUE(std::holds_alternative<std::monostate>(zone_map[0].min));
+  EXPECT_TRUE(BatchMayMatch(zone_map, {{0, Op::kGreaterThan, 100.0}}));
+}
+
+}  // namespace internal
+}  // namespace table_store
+}  // namespace px
@@ -36,6 +36,7 @@
 #include "src/table_store/table/internal/batch_size_accountant.h"
 #include "src/table_store/table/internal/record_or_row_batch.h"
 #include "src/table_store/table/internal/types.h"
+#include "src/table_store/table/internal/zone_map.h"
 #include "src/table_store/table/table.h"
 
 // Note: this value is not used in most cases.
@@ -44,12 +45,26 @@ DEFINE_int32(table_store_table_size_limit,
              gflags::Int32FromEnv("PL_TABLE_STORE_TABLE_SIZE_LIMIT", 1024 * 1024 * 64),
              "The maximal size a table allows. When the size grows beyond this limit, "
              "old data will be discarded.");
+DEFINE_bool(table_store_zone_map_bloom_filters,
+            gflags::BoolFromEnv("PL_TABLE_STORE_ZONE_MAP_BLOOM_FILTERS", false),
+            "Whether to build a bloom filter of each string column of a cold batch, so that "
+            "equality predicates on strings can skip batches. The filters count towards the "
+            "table size, at about 10 bits per row of each string column.");
+DEFINE_bool(table_store_cold_compression,
+            gflags::BoolFromEnv("PL_TABLE_STORE_COLD_COMPRESSION", true),
+            "Whether to encode the columns of cold batches (frame of reference, run length and "
+            "dictionary encodings) so that they take up less memory.");
+DEFINE_bool(table_store_cold_deflate_strings,
+            gflags::BoolFromEnv("PL_TABLE_STORE_COLD_DEFLATE_STRINGS", false),
+            "Whether to compress string columns of cold batches that don't dictionary encode well "
+            "with zlib. Saves more memory at the cost of inflating them on every read.");
 
 namespace px {
 namespace table_store {
 
-Table::Cursor::Cursor(const Table* table, StartSpec start, StopSpec stop)
-    : table_(table), hints_(internal::BatchHints{}) {
+Table::Cursor::Cursor(const Table* table, StartSpec start, StopSpec stop,
+                      std::vector<ColumnPredicate> predicates)
+    : table_(table), hints_(internal::BatchHints{}), predicates_(std::move(predicates)) {
   AdvanceToStart(start);
   StopStateFromSpec(std::move(stop));
 }
@@ -167,6 +182,20 @@ StatusOr<std::unique_ptr<schema::RowBatch>> Table::Cursor::GetNextRowBatch(
   return table_->GetNextRowBatch(this, cols);
 }
 
+StatusOr<Table::ReservedRowBatch> Table::Cursor::ReserveNextRowBatch(
+    const std::vector<int64_t>& cols) {
+  return table_->ReserveNextRowBatch(this, cols);
+}
+
+StatusOr<std::unique_ptr<schema::RowBatch>> Table::ReservedRowBatch::Decode(
+    arrow::MemoryPool* pool) {
+  if (cold_slice_.has_value()) {
+    return cold_slice_->Decode(pool);
+  }
+  DCHECK(rb_ != nullptr) << "ReservedRowBatch was already decoded";
+  return std::move(rb_);
+}
+
 Table::Table(std::string_view table_name, const schema::Relation& relation, size_t max_table_size,
              size_t compacted_batch_size)
     : metrics_(&(GetMetricsRegistry()), std::string(table_name)),
@@ -211,30 +240,73 @@ Status Table::ToProto(table_store::schemapb::Table* table_proto) const {
 
 StatusOr<std::unique_ptr<schema::RowBatch>> Table::GetNextRowBatch(
     Cursor* cursor, const std::vector<int64_t>& cols) const {
+  PX_ASSIGN_OR_RETURN(auto reserved, ReserveNextRowBatch(cursor, cols));
+  return reserved.Decode();
+}
+
+StatusOr<Table::ReservedRowBatch> Table::ReserveNextRowBatch(
+    Cursor* cursor, const std::vector<int64_t>& cols) const {
   DCHECK(!cursor->Done()) << "Calling GetNextRowBatch on an exhausted Cursor";
-  absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
-  PX_ASSIGN_OR_RETURN(auto rb,
-                      cold_store_->GetNextRowBatch(cursor->LastReadRowID(), cursor->Hints(),
-                                                   cursor->StopRowID(), cols));
-  if (rb == nullptr) {
+  size_t num_skipped = 0;
+  ReservedRowBatch reserved;
+  {
+    absl::base_internal::SpinLockHolder cold_lock(&cold_lock_);
+    if (!cursor->Predicates().empty()) {
+      const auto& zone_maps = cold_zone_maps_;
+      num_skipped = cold_store_->SkipBatches(
+          cursor->LastReadRowID(), cursor->StopRowID(), [&zone_maps, cursor](size_t batch_idx) {
+            return !internal::BatchMayMatch(zone_maps[batch_idx], cursor->Predicates());
+          });
+      cursor->batches_skipped_ += num_skipped;
+      // Cursor::Done() can't be used here since it may take the table locks.
+      auto stop_row_id = cursor->StopRowID();
+      if (num_skipped > 0 && stop_row_id.has_value() &&
+          *cursor->LastReadRowID() + 1 >= stop_row_id.value()) {
+        PX_ASSIGN_OR_RETURN(reserved.rb_, SkippedRowBatch(cols));
+        return reserved;
+      }
+    }
+    // Decoding the cold columns can be expensive, so it is left to ReservedRowBatch::Decode, after
+    // releasing the lock.
+    reserved.cold_slice_ = cold_store_->GetNextColdBatchSlice(
+        cursor->LastReadRowID(), cursor->Hints(), cursor->StopRowID(), cols);
+    if (reserved.cold_slice_.has_value()) {
+      return reserved;
+    }
     absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
-    PX_ASSIGN_OR_RETURN(rb, hot_store_->GetNextRowBatch(cursor->LastReadRowID(), cursor->Hints(),
-                                                        cursor->StopRowID(), cols));
-    if (rb == nullptr && hot_store_->Size() > 0) {
-      // If the cursor was pointing to an expired row batch, update the cursor to point to the start
-      // of the table, then try to get the next row batch.
+    PX_ASSIGN_OR_RETURN(reserved.rb_,
+                        hot_store_->GetNextRowBatch(cursor->LastReadRowID(), cursor->Hints(),
+                                                    cursor->StopRowID(), cols));
+    if (reserved.rb_ == nullptr && hot_store_->Size() > 0) {
+      // If the cursor was pointing to an expired row batch, update the cursor to point to the
+      // start of the table, then try to get the next row batch.
       *cursor->LastReadRowID() = hot_store_->FirstRowID() - 1;
       if (!cursor->Done()) {
-        PX_ASSIGN_OR_RETURN(rb,
+        PX_ASSIGN_OR_RETURN(reserved.rb_,
                             hot_store_->GetNextRowBatch(cursor->LastReadRowID(), cursor->Hints(),
                                                         cursor->StopRowID(), cols));
       }
     }
   }
-  if (rb == nullptr) {
+  if (reserved.rb_ == nullptr) {
+    if (num_skipped > 0) {
+      // The skipped batches were the last ones in the table.
+      PX_ASSIGN_OR_RETURN(reserved.rb_, SkippedRowBatch(cols));
+      return reserved;
+    }
     return error::InvalidArgument("Data after Cursor is not in the table.");
   }
-  return rb;
+  return reserved;
+}
+
+StatusOr<std::unique_ptr<schema::RowBatch>> Table::SkippedRowBatch(
+    const std::vector<int64_t>& cols) const {
+  std::vector<types::DataType> col_types;
+  for (int64_t col_idx : cols) {
+    col_types.push_back(rel_.col_types()[col_idx]);
+  }
+  return schema::RowBatch::WithZeroRows(schema::RowDescriptor(col_types), /* eow */ false,
+                                        /* eos */ false);
 }
 
 Status Table::ExpireRowBatches(int64_t row_batch_size) {
@@ -421,6 +493,22 @@ TableStats Table::GetTableStats() const {
   return info;
 }
 
+StatusOr<internal::ColdBatch> Table::EncodeColdBatch(std::vector<ArrowArrayPtr> columns) const {
+  if (!FLAGS_table_store_cold_compression) {
+    return internal::ColdBatch(columns);
+  }
+  internal::ColdEncodingOptions opts;
+  opts.deflate_strings = FLAGS_table_store_cold_deflate_strings;
+  std::vector<internal::ColdColumn> encoded;
+  encoded.reserve(columns.size());
+  for (const auto& [col_idx, col] : Enumerate(columns)) {
+    PX_ASSIGN_OR_RETURN(auto encoded_col,
+                        internal::ColdColumn::Encode(rel_.GetColumnType(col_idx), col, opts));
+    encoded.push_back(std::move(encoded_col));
+  }
+  return internal::ColdBatch(std::move(encoded));
+}
+
 Status Table::CompactSingleBatchUnlocked(arrow::MemoryPool*) {
   const auto& compaction_spec = batch_size_accountant_->GetNextCompactedBatchSpec();
 
@@ -440,10 +528,17 @@ Status Table::CompactSingleBatchUnlocked(arrow::MemoryPool*) {
   }
 
   PX_ASSIGN_OR_RETURN(std::vector<ArrowArrayPtr> out_columns, compactor_.Finish());
+  PX_ASSIGN_OR_RETURN(
+      auto zone_map,
+      internal::BuildBatchZoneMap(rel_, out_columns, FLAGS_table_store_zone_map_bloom_filters));
 
-  cold_store_->EmplaceBack(first_row_id, out_columns);
+  PX_ASSIGN_OR_RETURN(auto cold_batch, EncodeColdBatch(std::move(out_columns)));
+  // The zone map lives as long as the cold batch, so it counts towards its size.
+  auto cold_bytes = cold_batch.bytes() + internal::BatchZoneMapBytes(zone_map);
+  cold_store_->EmplaceBack(first_row_id, std::move(cold_batch));
+  cold_zone_maps_.push_back(std::move(zone_map));
 
-  auto num_rows_to_remove = batch_size_accountant_->FinishCompactedBatch();
+  auto num_rows_to_remove = batch_size_accountant_->FinishCompactedBatch(cold_bytes);
   if (num_rows_to_remove > 0) {
     hot_store_->RemovePrefix(num_rows_to_remove);
   }
@@ -482,6 +577,7 @@ StatusOr<bool> Table::ExpireCold() {
     return false;
   }
   cold_store_->PopFront();
+  cold_zone_maps_.pop_front();
   absl::base_internal::SpinLockHolder hot_lock(&hot_lock_);
   batch_size_accountant_->ExpireColdBatch();
   return true;
@@ -46,9 +46,13 @@
 #include "src/table_store/table/internal/record_or_row_batch.h"
 #include "src/table_store/table/internal/store_with_row_accounting.h"
 #include "src/table_store/table/internal/types.h"
+#include "src/table_store/table/internal/zone_map.h"
 #include "src/table_store/table/table_metrics.h"
 
 DECLARE_int32(table_store_table_size_limit);
+DECLARE_bool(table_store_zone_map_bloom_filters);
+DECLARE_bool(table_store_cold_compression);
+DECLARE_bool(table_store_cold_deflate_strings);
 
 namespace px {
 namespace table_store {
@@ -100,6 +104,12 @@ struct TableStats {
  * Cursor stores the unique row identifier of the last read row, so
  * that when GetNextRowBatch is called on the cursor it can work out that it needs to return a slice
  * of the batch with the original "second" batch's data.
+ *
+ * Zone Maps:
+ * When a cold batch is created by compaction, the min/max and null count of each of its columns
+ * (and optionally a bloom filter of each string column) are stored alongside it. Cursors created
+ * with predicates use them to skip cold batches that can't contain a matching row. Hot batches are
+ * never skipped.
  */
 class Table : public NotCopyable {
   using RecordBatchPtr = internal::RecordBatchPtr;
@@ -116,6 +126,7 @@ class Table : public NotCopyable {
  public:
   static inline constexpr int64_t kMaxBatchesPerCompactionCall = 256;
   using StopPosition = int64_t;
+  using ColumnPredicate = internal::ColumnPredicate;
   static inline std::shared_ptr<Table> Create(std::string_view table_name,
                                               const schema::Relation& relation) {
     // Create naked pointer, because std::make_shared() cannot access the private ctor.
@@ -123,6 +134,27 @@ class Table : public NotCopyable {
         new Table(table_name, relation, FLAGS_table_store_table_size_limit));
   }
 
+  /**
+   * ReservedRowBatch is the next row batch of a cursor, before its cold columns are decoded.
+   * Reserving it advances the cursor, while decoding it touches neither the cursor nor the table,
+   * so readers that share a cursor only need to serialize the reservations.
+   */
+  class ReservedRowBatch {
+   public:
+    ReservedRowBatch() = default;
+
+    // Returns the row batch, decoding the cold columns from the pool. Can only be called once.
+    StatusOr<std::unique_ptr<schema::RowBatch>> Decode(
+        arrow::MemoryPool* pool = arrow::default_memory_pool());
+
+   private:
+    std::unique_ptr<schema::RowBatch> rb_;
+    // The slice shares ownership of the columns, so the batch may be expired before decoding.
+    std::optional<internal::ColdBatchSlice> cold_slice_;
+
+    friend class Table;
+  };
+
   /**
    * Cursor allows iterating the table, while guaranteeing that no row is returned twice (even when
    * compactions occur between accesses). {Start,Stop}Spec specify what rows the cursor should begin
@@ -174,7 +206,12 @@ class Table : public NotCopyable {
     };
 
     explicit Cursor(const Table* table) : Cursor(table, StartSpec{}, StopSpec{}) {}
-    Cursor(const Table* table, StartSpec start, StopSpec stop);
+    Cursor(const Table* table, StartSpec start, StopSpec stop)
+        : Cursor(table, start, stop, std::vector<ColumnPredicate>{}) {}
+    // The predicates are a hint: batches that provably have no row matching all of them may be
+    // skipped, but batches that are returned aren't filtered.
+    Cursor(const Table* table, StartSpec start, StopSpec stop,
+           std::vector<ColumnPredicate> predicates);
 
     // In the case of StopType == Infinite or StopType == StopAtTime, this returns whether the table
     // has the next batch ready. In the case of StopType == CurrentEndOfTable, this returns !Done().
@@ -184,10 +221,14 @@ class Table : public NotCopyable {
     // is past the stopping condition. In this case `GetNextRowBatch(...)` will return an error.
     bool NextBatchReady();
     StatusOr<std::unique_ptr<schema::RowBatch>> GetNextRowBatch(const std::vector<int64_t>& cols);
+    // Same as GetNextRowBatch, but leaves decoding the batch to the caller.
+    StatusOr<ReservedRowBatch> ReserveNextRowBatch(const std::vector<int64_t>& cols);
     // In the case of StopType == Infinite, this function always returns false.
     bool Done();
     // Change the StopSpec of the cursor.
     void UpdateStopSpec(StopSpec stop);
+    // The number of batches skipped so far because of the cursor's predicates.
+    int64_t batches_skipped() const { return batches_skipped_; }
 
    private:
     void AdvanceToStart(const StartSpec& start);
@@ -198,6 +239,7 @@ class Table : public NotCopyable {
     internal::RowID* LastReadRowID();
     internal::BatchHints* Hints();
     std::optional<internal::RowID> StopRowID() const;
+    const std::vector<ColumnPredicate>& Predicates() const { return predicates_; }
 
     struct StopState {
       StopSpec spec;
@@ -210,6 +252,8 @@ class Table : public NotCopyable {
     internal::BatchHints hints_;
     RowID last_read_row_id_;
     StopState stop_;
+    std::vector<ColumnPredicate> predicates_;
+    int64_t batches_skipped_ = 0;
 
     friend class Table;
   };
@@ -238,6 +282,13 @@ class Table : public NotCopyable {
   StatusOr<std::unique_ptr<schema::RowBatch>> GetNextRowBatch(
       Cursor* cursor, const std::vector<int64_t>& cols) const;
 
+  /**
+   * Advances the cursor past the next row batch, like GetNextRowBatch, but returns the batch before
+   * its cold columns are decoded, which is the expensive part of reading it.
+   */
+  StatusOr<ReservedRowBatch> ReserveNextRowBatch(Cursor* cursor,
+                                                 const std::vector<int64_t>& cols) const;
+
   /**
    * Get the unique identifier of the first row in the table.
    * If all the data is expired from the table, this returns the last row id that was in the table.
@@ -321,6 +372,8 @@ class Table : public NotCopyable {
   std::unique_ptr<internal::StoreWithRowTimeAccounting<internal::StoreType::Cold>> cold_store_
       ABSL_GUARDED_BY(cold_lock_);
   std::deque<int64_t> cold_batch_bytes_ ABSL_GUARDED_BY(cold_lock_);
+  // Zone maps of the batches in cold_store_, in the same order.
+  std::deque<internal::BatchZoneMap> cold_zone_maps_ ABSL_GUARDED_BY(cold_lock_);
 
   // Counter to assign a unique row ID to each row. Synchronized by hot_lock_ since its only
   // accessed on a hot write.
@@ -333,12 +386,18 @@ class Table : public NotCopyable {
   Status ExpireHot();
   StatusOr<bool> ExpireCold();
   Status ExpireRowBatches(int64_t row_batch_size);
+  // Encodes the compacted columns of a new cold batch, according to the cold compression flags.
+  StatusOr<internal::ColdBatch> EncodeColdBatch(std::vector<ArrowArrayPtr> columns) const;
   Status CompactSingleBatchUnlocked(arrow::MemoryPool* mem_pool)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(cold_lock_) ABSL_EXCLUSIVE_LOCKS_REQUIRED(hot_lock_);
   Status UpdateTableMetricGauges();
 
   Time MaxTime() const;
 
+  // Returns the 0-row batch given to a cursor when skipping batches took it to its end.
+  StatusOr<std::unique_ptr<schema::RowBatch>> SkippedRowBatch(
+      const std::vector<int64_t>& cols) const;
+
   std::unique_ptr<internal::BatchSizeAccountant> batch_size_accountant_ ABSL_GUARDED_BY(hot_lock_);
 
   internal::ArrowArrayCompactor compactor_;
@@ -17,14 +17,18 @@
  */
 
 #include <absl/synchronization/barrier.h>
+#include <absl/strings/str_cat.h>
 #include <absl/synchronization/notification.h>
 #include <benchmark/benchmark.h>
 #include <chrono>
 #include <deque>
+#include <functional>
 #include <numeric>
 #include <random>
 #include <thread>
 
+#include "src/common/testing/test_environment.h"
+#include "src/shared/types/arrow_adapter.h"
 #include "src/shared/types/types.h"
 #include "src/table_store/table/table.h"
 
@@ -360,6 +364,104 @@ static void BM_TableThreaded(benchmark::State& state) {
   state.counters["Write"] = benchmark::Counter(write_average_time);
 }
 
+// Fills a cold table shaped like http_events, where the last `error_percent` percent of the rows
+// have `resp_status == 500` (an error burst) and all others have 200.
+static inline std::unique_ptr<Table> MakeHTTPTable(int64_t num_rows, int64_t error_percent) {
+  schema::Relation rel({types::DataType::TIME64NS, types::DataType::INT64, types::DataType::STRING},
+                       {"time_", "resp_status", "req_path"});
+  auto table = std::make_unique<Table>("http_events", rel, 512 * 1024 * 1024, 64 * 1024);
+  const int64_t batch_length = 256;
+  const int64_t first_error_row = num_rows - num_rows * error_percent / 100;
+  for (int64_t start = 0; start < num_rows; start += batch_length) {
+    std::vector<types::Time64NSValue> times(batch_length);
+    std::vector<types::Int64Value> status(batch_length);
+    std::vector<types::StringValue> paths(batch_length);
+    for (int64_t i = 0; i < batch_length; ++i) {
+      times[i] = start + i;
+      status[i] = start + i >= first_error_row ? 500 : 200;
+      paths[i] = absl::StrCat("/api/v1/endpoint", (start + i) % 1000);
+    }
+    schema::RowBatch rb(schema::RowDescriptor(rel.col_types()), batch_length);
+    PX_CHECK_OK(rb.AddColumn(types::ToArrow(times, arrow::default_memory_pool())));
+    PX_CHECK_OK(rb.AddColumn(types::ToArrow(status, arrow::default_memory_pool())));
+    PX_CHECK_OK(rb.AddColumn(types::ToArrow(paths, arrow::default_memory_pool())));
+    PX_CHECK_OK(table->WriteRowBatch(rb));
+    PX_CHECK_OK(table->CompactHotToCold(arrow::default_memory_pool()));
+  }
+  return table;
+}
+
+// Scans the table and evaluates the predicate on every row returned, like a MemorySourceNode
+// followed by a FilterNode. Returns the number of matching rows.
+static inline int64_t ScanAndFilter(Table::Cursor* cursor,
+                                    const std::function<bool(const arrow::Array*, int64_t)>& pred,
+                                    int64_t col_idx) {
+  int64_t num_matches = 0;
+  while (!cursor->Done()) {
+    auto rb = cursor->GetNextRowBatch({0, 1, 2}).ConsumeValueOrDie();
+    auto col = rb->ColumnAt(col_idx).get();
+    for (int64_t i = 0; i < col->length(); ++i) {
+      num_matches += pred(col, i);
+    }
+  }
+  return num_matches;
+}
+
+// Measures a scan of `resp_status >= 500` as a function of the percent of rows that match, with
+// and without pushing the predicate into the cursor.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_TableScanRangePredicate(benchmark::State& state, bool push_down) {
+  const int64_t num_rows = 1024 * 1024;
+  auto table = MakeHTTPTable(num_rows, state.range(0));
+  std::vector<Table::ColumnPredicate> predicates;
+  if (push_down) {
+    predicates.push_back({1, Table::ColumnPredicate::Op::kGreaterThanEqual, int64_t{500}});
+  }
+  auto pred = [](const arrow::Array* col, int64_t i) {
+    return types::GetValueFromArrowArray<types::DataType::INT64>(col, i) >= 500;
+  };
+
+  int64_t num_matches = 0;
+  int64_t batches_skipped = 0;
+  for (auto _ : state) {
+    Table::Cursor cursor(table.get(), Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                         predicates);
+    num_matches = ScanAndFilter(&cursor, pred, 1);
+    batches_skipped = cursor.batches_skipped();
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+  state.counters["matches"] = num_matches;
+  state.counters["batches_skipped"] = batches_skipped;
+}
+
+// Measures a scan of `req_path == <path>` for a path that isn't in the table, which only the string
+// bloom filters can rule out since the path is within every batch's [min, max] range. The bloom
+// filters are opt-in, so they are only built for the pushdown case.
+// NOLINTNEXTLINE : runtime/references.
+static void BM_TableScanStringEquality(benchmark::State& state, bool push_down) {
+  PX_SET_FOR_SCOPE(FLAGS_table_store_zone_map_bloom_filters, push_down);
+  const int64_t num_rows = 1024 * 1024;
+  auto table = MakeHTTPTable(num_rows, 0);
+  const std::string path = "/api/v1/endpoint5000";
+  std::vector<Table::ColumnPredicate> predicates;
+  if (push_down) {
+    predicates.push_back({2, Table::ColumnPredicate::Op::kEqual, path});
+  }
+  auto pred = [&path](const arrow::Array* col, int64_t i) {
+    return types::GetStringViewFromArrowArray(col, i) == path;
+  };
+
+  int64_t batches_skipped = 0;
+  for (auto _ : state) {
+    Table::Cursor cursor(table.get(), Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                         predicates);
+    benchmark::DoNotOptimize(ScanAndFilter(&cursor, pred, 2));
+    batches_skipped = cursor.batches_skipped();
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+  state.counters["batches_skipped"] = batches_skipped;
+}
+
 BENCHMARK(BM_TableReadAllHot);
 BENCHMARK(BM_TableReadAllCold);
 BENCHMARK(BM_TableReadLastBatchAllHot)->Iterations(1000);
@@ -368,5 +470,17 @@ BENCHMARK(BM_TableWriteEmpty);
 BENCHMARK(BM_TableWriteFull);
 BENCHMARK(BM_TableCompaction);
 BENCHMARK(BM_TableThreaded)->UseManualTime()->Iterations(1);
+BENCHMARK_CAPTURE(BM_TableScanRangePredicate, full_scan, /* push_down */ false)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(100);
+BENCHMARK_CAPTURE(BM_TableScanRangePredicate, zone_maps, /* push_down */ true)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(100);
+BENCHMARK_CAPTURE(BM_TableScanStringEquality, full_scan, /* push_down */ false);
+BENCHMARK_CAPTURE(BM_TableScanStringEquality, zone_maps, /* push_down */ true);
 
 }  // namespace px::table_store
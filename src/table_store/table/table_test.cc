@@ -16,6 +16,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <absl/strings/str_cat.h>
 #include <absl/synchronization/notification.h>
 #include <arrow/array.h>
 #include <google/protobuf/text_format.h>
@@ -147,6 +148,8 @@ TEST(TableTest, bytes_test) {
 }
 
 TEST(TableTest, bytes_test_w_compaction) {
+  // The expected sizes below are those of the uncompressed batches.
+  PX_SET_FOR_SCOPE(FLAGS_table_store_cold_compression, false);
   auto rd = schema::RowDescriptor({types::DataType::INT64, types::DataType::STRING});
   schema::Relation rel(rd.types(), {"col1", "col2"});
 
@@ -290,6 +293,8 @@ TEST(TableTest, expiry_test) {
 }
 
 TEST(TableTest, expiry_test_w_compaction) {
+  // The expected sizes below are those of the uncompressed batches.
+  PX_SET_FOR_SCOPE(FLAGS_table_store_cold_compression, false);
   auto rd = schema::RowDescriptor({types::DataType::INT64, types::DataType::STRING});
   schema::Relation rel(rd.types(), {"col1", "col2"});
 
@@ -892,6 +897,135 @@ TEST(TableTest, NextBatch_generation_bug) {
   EXPECT_NOT_OK(cursor.GetNextRowBatch({0, 1}));
 }
 
+namespace {
+// Writes and compacts one cold batch per entry of `batches`.
+std::unique_ptr<Table> ColdBatchesTable(
+    const std::vector<std::vector<types::Int64Value>>& batches) {
+  auto rd = schema::RowDescriptor({types::DataType::INT64});
+  schema::Relation rel(rd.types(), {"col1"});
+  int64_t batch_size = batches[0].size() * sizeof(int64_t);
+  auto table = std::make_unique<Table>("test_table", rel, 128 * 1024, batch_size);
+  for (const auto& batch : batches) {
+    schema::RowBatch rb(rd, batch.size());
+    PX_CHECK_OK(rb.AddColumn(types::ToArrow(batch, arrow::default_memory_pool())));
+    PX_CHECK_OK(table->WriteRowBatch(rb));
+  }
+  PX_CHECK_OK(table->CompactHotToCold(arrow::default_memory_pool()));
+  return table;
+}
+}  // namespace
+
+TEST(TableTest, cursor_predicates_skip_cold_batches) {
+  std::vector<types::Int64Value> hot_batch = {40, 41, 42};
+  auto table = ColdBatchesTable({{1, 2, 3}, {10, 11, 12}, {20, 21, 22}, {30, 31, 32}});
+  schema::RowBatch rb(schema::RowDescriptor({types::DataType::INT64}), 3);
+  EXPECT_OK(rb.AddColumn(types::ToArrow(hot_batch, arrow::default_memory_pool())));
+  EXPECT_OK(table->WriteRowBatch(rb));
+
+  Table::Cursor cursor(table.get(), Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                       {{0, Table::ColumnPredicate::Op::kGreaterThanEqual, int64_t{20}}});
+  ASSERT_OK_AND_ASSIGN(auto rb1, cursor.GetNextRowBatch({0}));
+  std::vector<types::Int64Value> expected = {20, 21, 22};
+  EXPECT_TRUE(rb1->ColumnAt(0)->Equals(types::ToArrow(expected, arrow::default_memory_pool())));
+  EXPECT_EQ(2, cursor.batches_skipped());
+
+  // Batches are only skipped as a whole, the returned batch isn't filtered.
+  ASSERT_OK_AND_ASSIGN(auto rb2, cursor.GetNextRowBatch({0}));
+  expected = {30, 31, 32};
+  EXPECT_TRUE(rb2->ColumnAt(0)->Equals(types::ToArrow(expected, arrow::default_memory_pool())));
+
+  // Hot batches are never skipped.
+  Table::Cursor cursor2(table.get(), Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                        {{0, Table::ColumnPredicate::Op::kGreaterThan, int64_t{100}}});
+  ASSERT_OK_AND_ASSIGN(auto rb3, cursor2.GetNextRowBatch({0}));
+  EXPECT_TRUE(rb3->ColumnAt(0)->Equals(types::ToArrow(hot_batch, arrow::default_memory_pool())));
+  EXPECT_EQ(4, cursor2.batches_skipped());
+  EXPECT_TRUE(cursor2.Done());
+}
+
+TEST(TableTest, cursor_predicates_skip_to_end) {
+  auto table = ColdBatchesTable({{1, 2, 3}, {10, 11, 12}});
+
+  Table::Cursor cursor(table.get(), Table::Cursor::StartSpec{}, Table::Cursor::StopSpec{},
+                       {{0, Table::ColumnPredicate::Op::kEqual, int64_t{5}}});
+  ASSERT_OK_AND_ASSIGN(auto rb, cursor.GetNextRowBatch({0}));
+  EXPECT_EQ(0, rb->num_rows());
+  EXPECT_EQ(2, cursor.batches_skipped());
+  EXPECT_TRUE(cursor.Done());
+}
+
+TEST(TableTest, reserved_row_batches_decode_out_of_order) {
+  auto table = ColdBatchesTable({{1, 2, 3}, {10, 11, 12}});
+  Table::Cursor cursor(table.get());
+  ASSERT_OK_AND_ASSIGN(auto reserved1, cursor.ReserveNextRowBatch({0}));
+  ASSERT_OK_AND_ASSIGN(auto reserved2, cursor.ReserveNextRowBatch({0}));
+  EXPECT_TRUE(cursor.Done());
+
+  // The reservations advanced the cursor, so they can be decoded in any order.
+  ASSERT_OK_AND_ASSIGN(auto rb2, reserved2.Decode());
+  ASSERT_OK_AND_ASSIGN(auto rb1, reserved1.Decode());
+  std::vector<types::Int64Value> expected1 = {1, 2, 3};
+  std::vector<types::Int64Value> expected2 = {10, 11, 12};
+  EXPECT_TRUE(rb1->ColumnAt(0)->Equals(types::ToArrow(expected1, arrow::default_memory_pool())));
+  EXPECT_TRUE(rb2->ColumnAt(0)->Equals(types::ToArrow(expected2, arrow::default_memory_pool())));
+}
+
+class ColdCompressionTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(ColdCompressionTest, compressed_cold_batches_round_trip) {
+  PX_SET_FOR_SCOPE(FLAGS_table_store_cold_deflate_strings, GetParam());
+  schema::Relation rel({types::DataType::TIME64NS, types::DataType::UINT128,
+                        types::DataType::INT64, types::DataType::STRING, types::DataType::STRING},
+                       {"time_", "upid", "status", "path", "body"});
+  int64_t num_rows = 1000;
+  std::vector<types::Time64NSValue> times(num_rows);
+  std::vector<types::UInt128Value> upids(num_rows);
+  std::vector<types::Int64Value> status(num_rows);
+  std::vector<types::StringValue> paths(num_rows);
+  std::vector<types::StringValue> bodies(num_rows);
+  int64_t rb_size = num_rows * (2 * sizeof(int64_t) + sizeof(absl::uint128) + 2 * sizeof(uint32_t));
+  for (int64_t i = 0; i < num_rows; ++i) {
+    times[i] = 1000000 + 10 * i;
+    upids[i] = types::UInt128Value(1, i / 250);
+    status[i] = i % 7 == 0 ? 404 : 200;
+    paths[i] = absl::StrCat("/api/v1/endpoint", i % 5);
+    bodies[i] = absl::StrCat("{\"request\": ", i, ", \"status\": \"ok\"}");
+    rb_size += paths[i].size() + bodies[i].size();
+  }
+  std::vector<ArrowArrayPtr> columns = {
+      types::ToArrow(times, arrow::default_memory_pool()),
+      types::ToArrow(upids, arrow::default_memory_pool()),
+      types::ToArrow(status, arrow::default_memory_pool()),
+      types::ToArrow(paths, arrow::default_memory_pool()),
+      types::ToArrow(bodies, arrow::default_memory_pool()),
+  };
+  schema::RowBatch rb(schema::RowDescriptor(rel.col_types()), num_rows);
+  for (const auto& col : columns) {
+    EXPECT_OK(rb.AddColumn(col));
+  }
+
+  // The whole row batch is compacted into a single cold batch.
+  Table table("test_table", rel, 128 * 1024 * 1024, rb_size);
+  EXPECT_OK(table.WriteRowBatch(rb));
+  EXPECT_EQ(rb_size, table.GetTableStats().bytes);
+  EXPECT_OK(table.CompactHotToCold(arrow::default_memory_pool()));
+  EXPECT_EQ(1, table.GetTableStats().compacted_batches);
+  EXPECT_LT(table.GetTableStats().cold_bytes, rb_size / 2);
+
+  // Reading from the middle of the batch only decodes the rows that are read.
+  Table::Cursor::StartSpec start_spec;
+  start_spec.type = Table::Cursor::StartSpec::StartAtTime;
+  start_spec.start_time = 1000000 + 10 * 500;
+  Table::Cursor cursor(&table, start_spec, Table::Cursor::StopSpec{});
+  ASSERT_OK_AND_ASSIGN(auto out, cursor.GetNextRowBatch({0, 1, 2, 3, 4}));
+  ASSERT_EQ(500, out->num_rows());
+  for (const auto& [col_idx, col] : Enumerate(columns)) {
+    EXPECT_TRUE(out->ColumnAt(col_idx)->Equals(col->Slice(500))) << rel.GetColumnName(col_idx);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(ColdCompression, ColdCompressionTest, ::testing::Bool());
+
 TEST(TableTest, GetNextRowBatch_after_expiry) {
   schema::Relation rel({types::DataType::BOOLEAN, types::DataType::INT64}, {"col1", "col2"});
 
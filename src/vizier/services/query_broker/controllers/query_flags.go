@@ -38,6 +38,14 @@ var defaultQueryFlags = map[string]interface{}{
 	"explain":                   false,
 	"analyze":                   false,
 	"max_output_rows_per_table": 10000,
+	// How row batches are encoded when they are sent between Carnot instances.
+	"internal_row_batch_encoding": "values",
+}
+
+// The values of the internal_row_batch_encoding flag.
+var rowBatchEncodings = map[string]planpb.RowBatchEncoding{
+	"values":        planpb.ROW_BATCH_ENCODING_VALUES,
+	"arrow_buffers": planpb.ROW_BATCH_ENCODING_ARROW_BUFFERS,
 }
 
 // QueryFlags represents a set of Pixie configuration flags.
@@ -109,6 +117,9 @@ func (f *QueryFlags) set(key string, value string) error {
 		if err != nil {
 			return err
 		}
+		if _, ok := rowBatchEncodings[value]; key == "internal_row_batch_encoding" && !ok {
+			return fmt.Errorf("%s is not a valid row batch encoding", value)
+		}
 		f.flags[key] = typedVal
 		return nil
 	}
@@ -119,9 +130,10 @@ func (f *QueryFlags) set(key string, value string) error {
 // GetPlanOptions creates the plan option proto from the specified query flags.
 func (f *QueryFlags) GetPlanOptions() *planpb.PlanOptions {
 	return &planpb.PlanOptions{
-		Explain:               f.GetBool("explain"),
-		Analyze:               f.GetBool("analyze"),
-		MaxOutputRowsPerTable: f.GetInt64("max_output_rows_per_table"),
+		Explain:                  f.GetBool("explain"),
+		Analyze:                  f.GetBool("analyze"),
+		MaxOutputRowsPerTable:    f.GetInt64("max_output_rows_per_table"),
+		InternalRowBatchEncoding: rowBatchEncodings[f.GetString("internal_row_batch_encoding")],
 	}
 }
 
@@ -24,6 +24,7 @@ import (
 	"github.com/stretchr/testify/assert"
 	"github.com/stretchr/testify/require"
 
+	"px.dev/pixie/src/carnot/planpb"
 	"px.dev/pixie/src/vizier/services/query_broker/controllers"
 )
 
@@ -32,6 +33,7 @@ import px
 
 #px:set analyze=true
 #px:set max_output_rows_per_table=9999
+#px:set internal_row_batch_encoding=arrow_buffers
 
 df = px.DataFrame(table='process_stats', start_time='-5s')
 `
@@ -54,6 +56,10 @@ const nonexistentFlag = `
 #px:set ABCD=efgh
 `
 
+const invalidRowBatchEncoding = `
+#px:set internal_row_batch_encoding=protobuf
+`
+
 func TestParseQueryFlags_WithFlag(t *testing.T) {
 	qf, err := controllers.ParseQueryFlags(validQueryWithFlag)
 
@@ -98,6 +104,10 @@ func TestParseQueryFlags_InvalidFlag(t *testing.T) {
 	qf, err = controllers.ParseQueryFlags(nonexistentFlag)
 	assert.Nil(t, qf)
 	assert.NotNil(t, err)
+
+	qf, err = controllers.ParseQueryFlags(invalidRowBatchEncoding)
+	assert.Nil(t, qf)
+	assert.NotNil(t, err)
 }
 
 func TestParseQueryFlags_PlanOptions(t *testing.T) {
@@ -109,4 +119,10 @@ func TestParseQueryFlags_PlanOptions(t *testing.T) {
 	options := qf.GetPlanOptions()
 	assert.Equal(t, options.Explain, false)
 	assert.Equal(t, options.Analyze, true)
+	assert.Equal(t, options.InternalRowBatchEncoding, planpb.ROW_BATCH_ENCODING_ARROW_BUFFERS)
+
+	qf, err = controllers.ParseQueryFlags(validQueryWithoutFlag)
+	require.NoError(t, err)
+	options = qf.GetPlanOptions()
+	assert.Equal(t, options.InternalRowBatchEncoding, planpb.ROW_BATCH_ENCODING_VALUES)
 }